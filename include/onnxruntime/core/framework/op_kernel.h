@@ -116,6 +116,24 @@ class OpKernel {
     return Status::OK();
   }
 
+  // Override this function to use pre-packed buffers that were saved in an ORT format model, instead of packing
+  // the tensor again. Unlike UseSharedPrePackedBuffers(), PrePack() is NOT called before this, so the kernel must also
+  // set up the metadata PrePack() would have derived from the tensor.
+  // The buffers are the ones PrePack() produced for the same kernel and input on a CPU with the same instruction set
+  // features, in the same order. The kernel owns the buffers if it uses them.
+  // @param tensor: The initialized constant tensor
+  // @param input_idx: The input index of the tensor in this kernel
+  // @param prepacked_buffers: The saved pre-packed buffers for the input
+  // @param prepacked_buffer_sizes: The sizes of the saved pre-packed buffers (in bytes)
+  // @param used_saved_buffers: Set it to true if the kernel uses the buffers. If false, PrePack() is called instead.
+  virtual Status UseSavedPrePackedBuffers(const Tensor& /*tensor*/, int /*input_idx*/,
+                                          std::vector<BufferUniquePtr>& /*prepacked_buffers*/,
+                                          const std::vector<size_t>& /*prepacked_buffer_sizes*/,
+                                          /*out*/ bool& used_saved_buffers) {
+    used_saved_buffers = false;
+    return Status::OK();
+  }
+
   const OrtMemoryInfo& Allocator(int id, OrtMemType mem_type) const;
   const OpKernelInfo& Info() const {
     return *op_kernel_info_;
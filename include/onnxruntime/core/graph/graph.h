@@ -393,9 +393,7 @@ class Node {
   ProviderType GetExecutionProviderType() const noexcept { return execution_provider_type_; }
 
   /** Sets the execution ProviderType that this Node will be executed by. */
-  void SetExecutionProviderType(ProviderType execution_provider_type) {
-    execution_provider_type_ = execution_provider_type;
-  }
+  void SetExecutionProviderType(ProviderType execution_provider_type);
 
   /** Sets initialized function body for node. This is called right after function body initialization for a node.
   * or during function inlining when a nested function is encountered.
@@ -883,6 +881,32 @@ class Graph {
   void RemoveEdge(NodeIndex src_node_index, NodeIndex dst_node_index, int src_arg_index, int dst_arg_index);
 #endif
 
+  /** Gets the modification stamp of the Graph.
+  The stamp increases whenever a Node is added, removed or modified. A Node is modified when an edge, attribute or
+  execution provider of it changes, the value of an initializer it consumes is replaced, Resolve infers a different
+  type or shape for one of its outputs, or one of its subgraphs is modified.
+  Code that changes a Node in other ways, e.g. via Node::MutableInputDefs, should call MarkNodeModified. */
+  uint64_t ModificationStamp() const noexcept { return modification_stamp_; }
+
+  /** Records that the Node was modified. This also marks the Node containing this Graph as modified in the parent
+  Graph if this is a subgraph. */
+  void MarkNodeModified(NodeIndex node_index);
+
+  /** Records that all the Nodes may have been modified, e.g. after changes that are not tracked. */
+  void MarkAllNodesModified();
+
+  /** Gets the Nodes that were added or modified after the stamp was taken, plus the Nodes connected to them by an
+  edge, as they may be affected by the change. All Nodes are returned if the Graph inputs or outputs were changed,
+  or MarkAllNodesModified was called, after the stamp was taken. */
+  std::unordered_set<NodeIndex> GetNodesAffectedSince(uint64_t stamp) const;
+
+  /** Gets the modification stamp a visitor of the Graph, e.g. a graph transformer, recorded with SetVisitStamp.
+  @returns false if the visitor didn't record a stamp for this Graph. */
+  bool TryGetVisitStamp(uint64_t visitor_id, uint64_t& stamp) const;
+
+  /** Records the modification stamp of the Graph at the start of the visit of the visitor. */
+  void SetVisitStamp(uint64_t visitor_id, uint64_t stamp) { visit_stamps_[visitor_id] = stamp; }
+
 #if !defined(ORT_MINIMAL_BUILD)
   /**
   Add a control edge between two Nodes in this Graph.
@@ -1176,6 +1200,7 @@ class Graph {
 #if !defined(ORT_MINIMAL_BUILD)
       IOnnxRuntimeOpSchemaCollectionPtr schema_registry,
 #endif
+      bool can_use_flatbuffer_for_initializers,
       const logging::Logger& logger, std::unique_ptr<Graph>& graph);
 
   // deserialize a subgraph
@@ -1423,6 +1448,18 @@ class Graph {
   // or some elements may be merged, etc.
   int num_of_nodes_ = 0;
 
+  // Increases whenever the graph is modified. See ModificationStamp().
+  uint64_t modification_stamp_ = 0;
+
+  // The modification stamp of the last change of each node, indexed by NodeIndex.
+  std::vector<uint64_t> node_modification_stamps_;
+
+  // The modification stamp of the last change that may affect any node, e.g. of the graph inputs or outputs.
+  uint64_t all_nodes_modification_stamp_ = 0;
+
+  // The modification stamps recorded by the visitors of the graph, keyed on the visitor id.
+  std::unordered_map<uint64_t, uint64_t> visit_stamps_;
+
   // A flag indicates whether <*this> graph needs to be resolved.
   bool graph_resolve_needed_ = false;
 
@@ -1497,6 +1534,12 @@ class Graph {
 
   // distinguishes between graph loaded from model file and graph created from scratch
   const bool is_loaded_from_model_file_;
+
+#if defined(ENABLE_ORT_FORMAT_LOAD)
+  // initializers loaded from an ORT format model can refer to the data in the model buffer instead of copying it,
+  // as the buffer outlives the graph
+  bool can_use_flatbuffer_for_initializers_ = false;
+#endif
 };
 
 #if !defined(ORT_MINIMAL_BUILD)
@@ -19,7 +19,7 @@ The interface for in-place transformation of a Graph.
 class GraphTransformer {
  public:
   GraphTransformer(const std::string& name, const std::unordered_set<std::string>& compatible_execution_providers = {})
-      : name_(name), compatible_provider_types_(compatible_execution_providers) {
+      : name_(name), compatible_provider_types_(compatible_execution_providers), id_(NextId()) {
   }
 
   virtual ~GraphTransformer() = default;
@@ -34,6 +34,7 @@ class GraphTransformer {
   }
 
   /** Apply the in-place transformation defined by this transformer to the provided Graph instance.
+  The transformation is skipped if the Graph was not modified since this transformer was last applied to it.
   @param[out] modified Set to true if the Graph was modified.
   @returns Status with success or error information.
   */
@@ -53,9 +54,14 @@ class GraphTransformer {
     return Status::OK();
   }
 
+  /** Gets the id this transformer records its visits of a Graph with. See Graph::SetVisitStamp. */
+  uint64_t Id() const noexcept { return id_; }
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(GraphTransformer);
 
+  static uint64_t NextId();
+
   // Apply the transform to the graph.
   // graph_level is 0 for the main graph, and is incremented when descending into the subgraph of a node.
   // You MUST call Recurse for all valid Nodes in the graph to ensure any subgraphs in control flow nodes
@@ -68,5 +74,6 @@ class GraphTransformer {
 
   const std::string name_;
   const std::unordered_set<std::string> compatible_provider_types_;
+  const uint64_t id_;
 };
 }  // namespace onnxruntime
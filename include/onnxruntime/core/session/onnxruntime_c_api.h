@@ -2570,6 +2570,15 @@ struct OrtApi {
   *  Only relevant if arena strategy is `kNextPowerOfTwo`. Use -1 to allow ORT to choose the default.
   *  Ultimately, the allocation size is determined by the allocation memory request.
   *  Further allocation sizes are governed by the arena extend strategy.
+  * "thread_cache_max_chunks_per_bin": Maximum number of freed chunks of each size class (below 1MB) that
+  *  every thread keeps in a private cache, which lets concurrent Run() calls allocate without taking the
+  *  arena lock. Use 0 to disable the thread caches. Default is 0.
+  * "use_huge_pages": 1 to back the regions of a CPU arena with huge pages (2MB on Linux), which reduces TLB misses
+  *  on large weight and activation buffers. Explicit huge pages are used if the system has reserved any, else
+  *  transparent huge pages. Falls back to regular pages if neither is available. Use 0 or -1 to disable. Default is 0.
+  *  Set "initial_chunk_size_bytes" to a multiple of the huge page size to avoid wasting the tail of the first region.
+  * "numa_node": NUMA node to allocate the regions of a CPU arena on. Use -1 to not bind the memory to a node.
+  *  Default is -1.
   *
   * \param[in] arena_config_keys Keys to configure the arena
   * \param[in] arena_config_values Values to configure the arena
@@ -3024,6 +3033,38 @@ struct OrtApi {
   ORT_API2_STATUS(GetSparseTensorIndices, _In_ const OrtValue* ort_value, enum OrtSparseIndicesFormat indices_format, _Out_ size_t* num_indices, _Outptr_ const void** indices);
 
   /// @}
+
+  // End of Version 9 - DO NOT MODIFY ABOVE (see onnxruntime_c_api.cc for more information)
+
+  // Version 10 - In development
+
+  /// \name OrtSession
+  /// @{
+
+  /** \brief Get the kernel latencies collected by the sampled profiler
+  *
+  * The sampled profiler is enabled with the "session.sampled_profiling_interval" session config entry (see
+  * onnxruntime_session_options_config_keys.h). It aggregates the kernel latencies of the nodes in 1 in N executions of
+  * each graph into a histogram per op type. The histograms accumulate from the creation of the session on.
+  *
+  * The statistics are returned as a JSON object, e.g.
+  * {"sampled_executions" : 10, "op_types" : [{"op_type" : "Conv", "count" : 20, "total_ns" : 123456,
+  *  "bucket_upper_bounds_ns" : [1024, 2048, ...], "buckets" : [0, 3, ...]}]}
+  * The last bucket counts the latencies from the last upper bound on.
+  *
+  * \param[in] session
+  * \param[in] allocator
+  * \param[out] out Null terminated JSON string, allocated using `allocator`. Must be freed using `allocator`.
+  *   Empty if the sampled profiler is not enabled.
+  *
+  * \snippet{doc} snippets.dox OrtStatus Return Value
+  *
+  * \since Version 1.10.
+  */
+  ORT_API2_STATUS(SessionGetSampledProfilingStats, _In_ const OrtSession* session, _Inout_ OrtAllocator* allocator,
+                  _Outptr_ char** out);
+
+  /// @}
 };
 
 /*
@@ -412,6 +412,7 @@ struct Session : Base<OrtSession> {
   char* GetOverridableInitializerName(size_t index, OrtAllocator* allocator) const; ///< Wraps OrtApi::SessionGetOverridableInitializerName
   char* EndProfiling(OrtAllocator* allocator) const; ///< Wraps OrtApi::SessionEndProfiling
   uint64_t GetProfilingStartTimeNs() const; ///< Wraps OrtApi::SessionGetProfilingStartTimeNs
+  char* GetSampledProfilingStats(OrtAllocator* allocator) const; ///< Wraps OrtApi::SessionGetSampledProfilingStats
   ModelMetadata GetModelMetadata() const; ///< Wraps OrtApi::SessionGetModelMetadata
 
   TypeInfo GetInputTypeInfo(size_t index) const; ///< Wraps OrtApi::SessionGetInputTypeInfo
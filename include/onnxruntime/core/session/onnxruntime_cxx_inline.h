@@ -597,6 +597,12 @@ inline uint64_t Session::GetProfilingStartTimeNs() const {
   return out;
 }
 
+inline char* Session::GetSampledProfilingStats(OrtAllocator* allocator) const {
+  char* out;
+  ThrowOnError(GetApi().SessionGetSampledProfilingStats(p_, allocator, &out));
+  return out;
+}
+
 inline ModelMetadata Session::GetModelMetadata() const {
   OrtModelMetadata* out;
   ThrowOnError(GetApi().SessionGetModelMetadata(p_, &out));
@@ -20,6 +20,13 @@
 // If the config value is set to "1" then the prepacking is disabled, otherwise prepacking is enabled (default value)
 static const char* const kOrtSessionOptionsConfigDisablePrepacking = "session.disable_prepacking";
 
+// Key for disabling the parallel session initialization.
+// By default the initializers on CPU are deserialized, and the weights of the CPU kernels are pre-packed, in parallel
+// on the intra-op thread pool when the session is initialized.
+// If the config value is set to "1" then this is done on the thread initializing the session.
+static const char* const kOrtSessionOptionsConfigDisableParallelInitialization =
+    "session.disable_parallel_initialization";
+
 // A value of "1" means allocators registered in the env will be used. "0" means the allocators created in the session
 // will be used. Use this to override the usage of env allocators on a per session level.
 static const char* const kOrtSessionOptionsConfigUseEnvAllocators = "session.use_env_allocators";
@@ -51,6 +58,13 @@ static const char* const kOrtSessionOptionsDisableQuantQDQ = "session.disable_qu
 // GeluApproximation has side effects which may change the inference results. It is disabled by default due to this.
 static const char* const kOrtSessionOptionsEnableGeluApproximation = "optimization.enable_gelu_approximation";
 
+// Maximum size in bytes of an output of a node that is constant folded. Nodes with a larger output are kept, so that
+// constant folding doesn't grow the model by large initializers such as expanded masks. Constant values that are only
+// used by other folded nodes are not added to the model, but are subject to the same limit.
+// "0": no limit. (default)
+static const char* const kOrtSessionOptionsConstantFoldingMaxOutputSize =
+    "optimization.constant_folding_max_output_size_in_bytes";
+
 // Enable or disable using device allocator for allocating initialized tensor memory. "1": enable; "0": disable. The default is "0".
 // Using device allocators means the memory allocation is made using malloc/new.
 static const char* const kOrtSessionOptionsUseDeviceAllocatorForInitializers = "session.use_device_allocator_for_initializers";
@@ -69,6 +83,71 @@ static const char* const kOrtSessionOptionsConfigAllowIntraOpSpinning = "session
 // has to guarantee that the model bytes are valid until the ORT session using the model bytes is destroyed.
 static const char* const kOrtSessionOptionsConfigUseORTModelBytesDirectly = "session.use_ort_model_bytes_directly";
 
+// Serve the transient allocations of each Run (intermediate values that are not covered by a memory pattern and
+// kernel scratch buffers from the temp space allocator) from a per-Run region allocator, which hands out memory by
+// bumping a pointer and releases it all at the end of the Run.
+// "0": disable. (default)
+// "1": enable. This trades a higher peak memory usage per Run for lower allocation overhead, which mostly helps
+// models with dynamic shapes for which memory patterns can't be reused.
+static const char* const kOrtSessionOptionsConfigUseRunRegionAllocator = "session.use_run_region_allocator";
+
+// Share memory patterns between Runs whose input shapes only differ in dims within the same bucket, e.g. different
+// sequence lengths. The value is a comma separated list of ascending bucket upper bounds, e.g. "32,64,128,256".
+// Each symbolic dim of the graph inputs is rounded up to the first upper bound that is not smaller. Dims that are
+// fixed in the model and dims above the last upper bound are used as is. The memory pattern of a bucket is planned
+// for the upper bound shapes when the shapes in the model can be resolved from the input shapes, and is used for all
+// shapes of the bucket. Otherwise a Run with the upper bound shapes generates the pattern of the bucket, and smaller
+// shapes use the patterns of their exact shapes until then.
+// "": disable. Memory patterns are keyed on the exact input shapes. (default)
+static const char* const kOrtSessionOptionsConfigMemoryPatternShapeBuckets = "session.memory_pattern_shape_buckets";
+
+// Maximum number of memory patterns cached by a session. The least recently used pattern is evicted when the limit
+// is exceeded, so that sessions fed with many different input shapes don't grow without bound.
+// "0": no limit. (default)
+static const char* const kOrtSessionOptionsConfigMemoryPatternCacheCapacity = "session.memory_pattern_cache_capacity";
+
+// Configure how nodes run when the execution mode is ORT_PARALLEL.
+// "0": nodes are dispatched to the inter-op thread pool by the parallel executor. (default)
+// "1": nodes are scheduled on the intra-op thread pool as soon as their inputs are ready, so running independent
+// branches and parallelizing the kernels share one set of threads. No inter-op thread pool is created, and the
+// inter-op thread pool options are ignored. This mostly helps models with many wide branches.
+static const char* const kOrtSessionOptionsConfigUseDataflowExecutor = "session.use_dataflow_executor";
+
+// Save the buffers the CPU kernels pre-packed their constant initializers into when saving the model in ORT format.
+// Sessions loading the model use the saved buffers instead of packing the initializers again, if the kernel supports
+// it and the CPU has the same instruction set features as the one that saved the model. Otherwise the initializers
+// are packed as usual. The size of the model grows by the size of the pre-packed buffers.
+// "0": disable. (default)
+// "1": enable.
+static const char* const kOrtSessionOptionsConfigSavePrePackedWeights = "session.save_prepacked_weights";
+
+// Use the data of the initializers of an ORT format model in place instead of copying it into new tensors, for the
+// initializers on CPU whose data is suitably aligned in the model.
+// An ORT format model loaded from a file is memory mapped, so that the processes using the same model share one copy
+// of the initializers in the page cache. If the platform doesn't support memory mapping, the initializers are copied.
+// An ORT format model loaded from a byte array is only used in place if "session.use_ort_model_bytes_directly" is
+// also set to "1", and the caller has to guarantee that the bytes are valid until the session is destroyed.
+// "0": disable. (default)
+// "1": enable.
+static const char* const kOrtSessionOptionsConfigUseOrtFormatInitializersInPlace =
+    "session.use_ort_format_initializers_in_place";
+
+// Save the execution plan of the graphs when saving the model in ORT format. Sessions loading the model use the saved
+// plan instead of planning the allocations again, if they use the same execution mode, execution order and memory
+// reuse setting and have allocators for the saved memory locations. Otherwise the plan is created as usual.
+// If all the inputs of the main graph have fixed shapes, the memory patterns for these shapes are saved too, so the
+// first Run with them doesn't need to trace the allocations.
+// "0": disable. (default)
+// "1": enable.
+static const char* const kOrtSessionOptionsConfigSaveExecutionPlan = "session.save_execution_plan";
+
+// Aggregate the kernel latencies of the nodes into a histogram per op type for 1 in N executions of each graph, where
+// N is the config value. The overhead is bounded by N, and doesn't depend on the profiling started by
+// SessionOptions.enable_profiling, so this can be left enabled in production. The histograms are returned by
+// OrtApi::SessionGetSampledProfilingStats.
+// "0": disable. (default)
+static const char* const kOrtSessionOptionsConfigSampledProfilingInterval = "session.sampled_profiling_interval";
+
 // NNAPI EP keys begin
 // Note: These options should be specified prior to appending the NNAPI EP to the session options object in order for
 // them to take effect.
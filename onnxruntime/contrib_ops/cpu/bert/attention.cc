@@ -55,7 +55,8 @@ ONNX_OPERATOR_TYPED_KERNEL_EX(
     float,
     kCpuExecutionProvider,
     KernelDefBuilder()
-        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .MayInplace(4, 1),  // present reuses past when they share a buffer of the same size
     Attention<float>);
 
 Status AttentionBase::CheckInputs(const TensorShape& input_shape,
@@ -63,7 +64,8 @@ Status AttentionBase::CheckInputs(const TensorShape& input_shape,
                                   const TensorShape& bias_shape,
                                   const Tensor*& mask_index,
                                   const Tensor* past,
-                                  const Tensor* extra_add_qk) const {
+                                  const Tensor* extra_add_qk,
+                                  const Tensor* past_seq_len) const {
   // Input shapes:
   //   input       : (batch_size, sequence_length, input_hidden_size)
   //   weights     : (input_hidden_size, 3 * hidden_size)
@@ -73,7 +75,9 @@ Status AttentionBase::CheckInputs(const TensorShape& input_shape,
   //                 or (batch_size, past_sequence_length + sequence_length)
   //                 or (batch_size, sequence_length, past_sequence_length + sequence_length)
   //   past        : (2, batch_size, num_heads, past_sequence_length, head_size)
+  //                 or (2, batch_size, num_heads, max_sequence_length, head_size) when past and present share a buffer
   //   extra_add_qk: (batch_size, num_heads, sequence_length, sequence_length)
+  //   past_seq_len: (1), only when past and present share a buffer
   //
   // Where hidden_size = num_heads * head_size.
   // When a model is pruned (like some attention heads are removed), hidden_size < input_hidden_size.
@@ -175,6 +179,24 @@ Status AttentionBase::CheckInputs(const TensorShape& input_shape,
     past_sequence_length = static_cast<int>(past_dims[3]);
   }
 
+  if (past_present_share_buffer_) {
+    if (past == nullptr || past_seq_len == nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Inputs 'past' and 'past_sequence_length' are required when past_present_share_buffer is 1");
+    }
+    if (past_seq_len->Shape().Size() != 1) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'past_sequence_length' shall have 1 element");
+    }
+
+    // The past buffer has max_sequence_length rows, of which the first past_sequence_length are valid.
+    const int max_sequence_length = past_sequence_length;
+    past_sequence_length = *past_seq_len->Data<int32_t>();
+    if (past_sequence_length < 0 || past_sequence_length + sequence_length > max_sequence_length) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "past_sequence_length + sequence_length shall not exceed ",
+                             "dimension 3 of input 'past' ", max_sequence_length, ", got ", past_sequence_length);
+    }
+  }
+
   if (mask_index != nullptr) {  // mask_index is optional
     const auto& mask_dims = mask_index->Shape().GetDims();
     if (mask_dims.size() == 1) {
@@ -256,16 +278,23 @@ Tensor* AttentionBase::GetPresent(OpKernelContext* context,
                                   int batch_size,
                                   int head_size,
                                   int sequence_length,
-                                  int& past_sequence_length) const {
+                                  int& past_sequence_length,
+                                  const Tensor* past_seq_len) const {
   // Input and output shapes:
   //   past        : (2, batch_size, num_heads, past_sequence_length, head_size)
   //   present     : (2, batch_size, num_heads, past_sequence_length + sequence_length, head_size)
+  // When past and present share a buffer, both have the shape (2, batch_size, num_heads, max_sequence_length, head_size).
 
   std::vector<int64_t> present_dims{2, batch_size, num_heads_, sequence_length, head_size};
   if (nullptr != past) {
     const auto& past_dims = past->Shape().GetDims();
-    past_sequence_length = static_cast<int>(past_dims[3]);
-    present_dims[3] += past_dims[3];
+    if (past_present_share_buffer_) {
+      past_sequence_length = *past_seq_len->Data<int32_t>();
+      present_dims[3] = past_dims[3];
+    } else {
+      past_sequence_length = static_cast<int>(past_dims[3]);
+      present_dims[3] += past_dims[3];
+    }
   }
 
   TensorShape present_shape(present_dims);
@@ -414,6 +443,7 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
   const Tensor* mask_index = context->Input<Tensor>(3);
   const Tensor* past = context->Input<Tensor>(4);
   const Tensor* extra_add_qk = context->Input<Tensor>(5);
+  const Tensor* past_seq_len = context->Input<Tensor>(6);
 
   const TensorShape& weights_shape = (weights ? weights->Shape() : weight_shape_);
   ORT_RETURN_IF_ERROR(CheckInputs(input->Shape(),
@@ -421,7 +451,8 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
                                   bias->Shape(),
                                   mask_index,
                                   past,
-                                  extra_add_qk));
+                                  extra_add_qk,
+                                  past_seq_len));
 
   const auto& shape = input->Shape().GetDims();
   const int batch_size = static_cast<int>(shape[0]);
@@ -564,7 +595,7 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
   return ApplyAttention(Q, K, V, mask_index, past, output,
                         batch_size, sequence_length,
                         qkv_head_size[0], qkv_head_size[2], v_hidden_size,
-                        extra_add_qk, context);
+                        extra_add_qk, context, past_seq_len);
 }
 }  // namespace contrib
 }  // namespace onnxruntime
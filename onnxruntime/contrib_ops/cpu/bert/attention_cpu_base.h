@@ -30,18 +30,46 @@ class AttentionCPUBase : public AttentionBase {
                         int v_head_size,             // head_size
                         int v_hidden_size,           // hidden_size
                         const Tensor* extra_add_qk,  // extra add in QK. Its size is BxNxSxS
-                        OpKernelContext* context) const {
+                        OpKernelContext* context,
+                        const Tensor* past_seq_len = nullptr) const {  // valid length of past when sharing buffer
     AllocatorPtr allocator;
     ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
 
     auto* tp = context->GetOperatorThreadPool();
 
     int past_sequence_length = 0;
-    Tensor* present = GetPresent(context, past, batch_size, v_head_size, sequence_length, past_sequence_length);
+    Tensor* present = GetPresent(context, past, batch_size, v_head_size, sequence_length, past_sequence_length,
+                                 past_seq_len);
 
     // Total sequence length including that of past state: S* = S' + S
     const int all_sequence_length = past_sequence_length + sequence_length;
 
+    const T* past_data = past != nullptr ? past->template Data<T>() : nullptr;
+    T* present_data = present != nullptr ? present->template MutableData<T>() : nullptr;
+
+    // The fused kernel does not support extra_add_qk, which is rarely used together with long sequences. It skips
+    // the keys excluded by the unidirectional mask rather than adding the -10000 bias to their scores.
+    // Up to one block of keys the attention probs fit in cache, so the fused kernel saves no memory traffic over
+    // the sgemm based path. It is only used for longer sequences, or when past and present share a buffer.
+    if constexpr (std::is_same<T, float>::value) {
+      if (extra_add_qk == nullptr &&
+          (past_present_share_buffer_ || all_sequence_length > kFusedAttentionMinSequenceLength)) {
+        // Number of rows of each head in the present state: S* or max_sequence_length when sharing buffer.
+        const int max_sequence_length =
+            present != nullptr ? static_cast<int>(present->Shape()[3]) : all_sequence_length;
+
+        return ComputeFusedAttention(Q, K, V, mask_index, past_data, present_data, output->template MutableData<T>(),
+                                     batch_size, sequence_length, past_sequence_length, max_sequence_length,
+                                     qk_head_size == 0 ? v_head_size : qk_head_size, v_head_size, v_hidden_size,
+                                     allocator, tp);
+      }
+    }
+
+    if (past_present_share_buffer_) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                             "past_present_share_buffer is not supported with extra_add_qk or types other than float");
+    }
+
     // Compute the attention score. It does 2 things:
     //         I. attention_probs(B, N, S, S*) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, S*, H -> B, N, H, S*) +
     //                                           1 x mask_data(B, N, S, S*)
@@ -62,9 +90,6 @@ class AttentionCPUBase : public AttentionBase {
 
     const int32_t* mask_index_data = mask_index != nullptr ? mask_index->template Data<int32_t>() : nullptr;
     const std::vector<int64_t>* mask_index_dims = mask_index != nullptr ? &(mask_index->Shape().GetDims()) : nullptr;
-    const T* past_data = past != nullptr ? past->template Data<T>() : nullptr;
-    T* present_data = present != nullptr ? present->template MutableData<T>() : nullptr;
-
     const T* extra_add_qk_data = nullptr;
     if (extra_add_qk != nullptr) {
       extra_add_qk_data = extra_add_qk->template Data<T>();
@@ -88,6 +113,122 @@ class AttentionCPUBase : public AttentionBase {
   }
 
  private:
+  // Total sequence length above which the fused MLAS kernel is used. It streams the keys in blocks of this size.
+  static constexpr int kFusedAttentionMinSequenceLength = 128;
+
+  // Computes the attention with the fused MLAS kernel: output(B, S, N, H) = Softmax(1/sqrt(H) x Q x K' + mask) x V.
+  // The keys and values are processed in blocks with an online softmax, so the attention probs (B, N, S, S*)
+  // are never materialized and the scratch memory is linear in the sequence length.
+  Status ComputeFusedAttention(const float* Q,             // Q data. Its size is BxNxSxH
+                               const float* K,             // K data. Its size is BxNxSxH
+                               const float* V,             // V value with size BxNxSxH
+                               const Tensor* mask_index,   // mask index. nullptr if no mask or its size is B
+                               const float* past,          // past state
+                               float* present,             // present state
+                               float* output,              // output buffer with size BxSxNxH
+                               int batch_size,             // batch size
+                               int sequence_length,        // sequence length
+                               int past_sequence_length,   // sequence length of past state
+                               int max_sequence_length,    // number of rows of each head in present state
+                               int qk_head_size,           // head size of Q and K
+                               int v_head_size,            // head size of V
+                               int v_hidden_size,          // hidden size of V
+                               AllocatorPtr allocator,     // allocator for the mask buffer
+                               ThreadPool* tp) const {     // thread pool
+    const int all_sequence_length = past_sequence_length + sequence_length;  // S* = S' + S
+
+    // Convert mask_index to an additive mask. A 3D mask has a row for each query, the other masks have
+    // a single row for each batch that is broadcast to all queries: (B)x1xS*.
+    float* mask_data = nullptr;
+    int mask_rows = 0;
+    if (mask_index != nullptr) {
+      const std::vector<int64_t>& mask_index_dims = mask_index->Shape().GetDims();
+      mask_rows = mask_index_dims.size() == 3 ? sequence_length : 1;
+
+      size_t mask_data_bytes = SafeInt<size_t>(batch_size) * mask_rows * all_sequence_length * sizeof(float);
+      mask_data = static_cast<float*>(allocator->Alloc(mask_data_bytes));
+      memset(mask_data, 0, mask_data_bytes);
+
+      PrepareMask(mask_index->template Data<int32_t>(), &mask_index_dims, mask_data, false,
+                  batch_size, mask_rows, all_sequence_length - mask_rows);
+    }
+    BufferUniquePtr mask_data_buffer(mask_data, BufferDeleter(allocator));
+
+    const int loop_len = batch_size * num_heads_;
+    const size_t k_input_chunk_length = static_cast<size_t>(sequence_length) * qk_head_size;  // S x H
+    const size_t v_input_chunk_length = static_cast<size_t>(sequence_length) * v_head_size;   // S x H
+    size_t k_present_chunk_length = k_input_chunk_length;
+    size_t v_present_chunk_length = v_input_chunk_length;
+
+    // Append K and V to the present state: (BxNx)S'xH, (BxNx)SxH -> (BxNx)S*xH. When past and present share a
+    // buffer of max_sequence_length rows, the past rows are already in place and only the new rows are written.
+    if (nullptr != present) {
+      k_present_chunk_length = static_cast<size_t>(max_sequence_length) * qk_head_size;
+      v_present_chunk_length = static_cast<size_t>(max_sequence_length) * v_head_size;
+
+      const int past_chunk_rows = past_present_share_buffer_ ? max_sequence_length : past_sequence_length;
+      const size_t k_past_chunk_length = static_cast<size_t>(past_chunk_rows) * qk_head_size;
+      const size_t v_past_chunk_length = static_cast<size_t>(past_chunk_rows) * v_head_size;
+      const size_t k_past_valid_length = static_cast<size_t>(past_sequence_length) * qk_head_size;
+      const size_t v_past_valid_length = static_cast<size_t>(past_sequence_length) * v_head_size;
+
+      const float* past_v = past != nullptr ? past + static_cast<size_t>(loop_len) * k_past_chunk_length : nullptr;
+      float* present_v = present + static_cast<size_t>(loop_len) * k_present_chunk_length;
+
+      // The past rows have to be copied unless they are already in the present buffer. A shared buffer that is
+      // not bound to the same memory is copied whole, so present is always past with the new rows written.
+      const bool copy_past = (past != nullptr && past != present);
+
+      const double cost = static_cast<double>(copy_past ? past_chunk_rows + sequence_length : sequence_length) *
+                          (qk_head_size + v_head_size);
+      ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t i = begin; i != end; ++i) {
+          float* k_dest = present + k_present_chunk_length * i;
+          float* v_dest = present_v + v_present_chunk_length * i;
+          if (copy_past) {
+            memcpy(k_dest, past + k_past_chunk_length * i, k_past_chunk_length * sizeof(float));
+            memcpy(v_dest, past_v + v_past_chunk_length * i, v_past_chunk_length * sizeof(float));
+          }
+          memcpy(k_dest + k_past_valid_length, K + k_input_chunk_length * i, k_input_chunk_length * sizeof(float));
+          memcpy(v_dest + v_past_valid_length, V + v_input_chunk_length * i, v_input_chunk_length * sizeof(float));
+        }
+      });
+
+      K = present;
+      V = present_v;
+    }
+
+    std::vector<MLAS_ATTENTION_DATA_PARAMS> data(loop_len);
+    for (int i = 0; i < loop_len; i++) {
+      const int batch_index = i / num_heads_;
+      const int head_index = i % num_heads_;
+
+      data[i].Q = Q + k_input_chunk_length * i;
+      data[i].ldq = qk_head_size;
+      data[i].K = K + k_present_chunk_length * i;
+      data[i].ldk = qk_head_size;
+      data[i].V = V + v_present_chunk_length * i;
+      data[i].ldv = v_head_size;
+
+      // transpose: out(B, S, N, H) is written in place of out_tmp(B, N, S, H)
+      data[i].Output = output + (static_cast<size_t>(batch_index) * sequence_length * num_heads_ + head_index) * v_head_size;
+      data[i].ldo = v_hidden_size;
+
+      if (mask_data != nullptr) {
+        data[i].Mask = mask_data + static_cast<size_t>(batch_index) * mask_rows * all_sequence_length;
+        data[i].ldm = mask_rows == 1 ? 0 : all_sequence_length;
+      }
+    }
+
+    const bool has_unidirectional = (is_unidirectional_ && sequence_length > 1);
+    const float alpha = 1.0f / sqrt(static_cast<float>(qk_head_size));
+
+    MlasFlashAttention(sequence_length, all_sequence_length, qk_head_size, v_head_size, alpha, has_unidirectional,
+                       data.data(), data.size(), tp);
+
+    return Status::OK();
+  }
+
   // Helper function to compute the attention probs. It does 2 things:
   //  I. attention_probs(B, N, S, S*) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, S*, H -> B, N, H, S*) +
   //                                    1 x mask_data(B, N, S, S*)
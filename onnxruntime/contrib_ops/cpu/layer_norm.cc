@@ -5,6 +5,7 @@
 
 #include "core/common/safeint.h"
 #include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 #include "core/util/math_cpuonly.h"
@@ -35,6 +36,29 @@ namespace contrib {
 REGISTER_KERNEL_TYPED(float)
 REGISTER_KERNEL_TYPED(double)
 
+namespace {
+
+// Computes the normalization with MLAS, which reduces each row in a single vectorized pass and skips the optional
+// outputs that are not requested. Returns false if MLAS does not support the type.
+template <typename T>
+bool ComputeLayerNormWithMlas(const T*, const T*, const T*, T*, T*, T*, int64_t, int64_t, float, bool,
+                              concurrency::ThreadPool*) {
+  return false;
+}
+
+template <>
+bool ComputeLayerNormWithMlas<float>(const float* X_data, const float* scale_data, const float* bias_data,
+                                     float* Y_data, float* mean_data, float* inv_std_dev_data, int64_t norm_count,
+                                     int64_t norm_size, float epsilon, bool simplified,
+                                     concurrency::ThreadPool* thread_pool) {
+  MlasComputeLayerNorm(X_data, scale_data, bias_data, Y_data, mean_data, inv_std_dev_data,
+                       static_cast<size_t>(norm_count), static_cast<size_t>(norm_size), epsilon, simplified,
+                       thread_pool);
+  return true;
+}
+
+}  // namespace
+
 template <typename T, bool simplified>
 LayerNorm<T, simplified>::LayerNorm(const OpKernelInfo& op_kernel_info)
     : OpKernel(op_kernel_info) {
@@ -70,16 +94,25 @@ Status LayerNorm<T, simplified>::Compute(OpKernelContext* p_ctx) const {
     }
   }
 
+  int output_index = 1;
+
+  Tensor* mean = simplified ? nullptr : p_ctx->Output(output_index++, TensorShape(mean_inv_std_dev_dim));
+  Tensor* inv_std_dev = p_ctx->Output(output_index, TensorShape(mean_inv_std_dev_dim));
+
+  if (ComputeLayerNormWithMlas(X_data, scale_data, bias_data, Y_data,
+                               mean == nullptr ? nullptr : mean->template MutableData<T>(),
+                               inv_std_dev == nullptr ? nullptr : inv_std_dev->template MutableData<T>(),
+                               norm_count, norm_size, epsilon_, simplified, p_ctx->GetOperatorThreadPool())) {
+    return Status::OK();
+  }
+
   AllocatorPtr alloc;
   ORT_RETURN_IF_ERROR(p_ctx->GetTempSpaceAllocator(&alloc));
 
   T* mean_data = nullptr;
   BufferUniquePtr mean_data_buf_ptr;
 
-  int output_index = 1;
-
   if (!simplified) {
-    Tensor* mean = p_ctx->Output(output_index++, TensorShape(mean_inv_std_dev_dim));
     if (mean != nullptr) {
       mean_data = mean->template MutableData<T>();
     } else {
@@ -92,7 +125,6 @@ Status LayerNorm<T, simplified>::Compute(OpKernelContext* p_ctx) const {
   T* inv_std_dev_data = nullptr;
   BufferUniquePtr inv_std_dev_data_buf_ptr;
 
-  Tensor* inv_std_dev = p_ctx->Output(output_index, TensorShape(mean_inv_std_dev_dim));
   if (inv_std_dev != nullptr) {
     inv_std_dev_data = inv_std_dev->template MutableData<T>();
   } else {
@@ -0,0 +1,212 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/safeint.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// MatMul with a 4-bit block quantized weight. The weight stays 4-bit in the
+// MLAS packed buffer and is dequantized in registers inside the GEMM kernel.
+class MatMulNBits final : public OpKernel {
+ public:
+  MatMulNBits(const OpKernelInfo& info) : OpKernel(info) {
+    int64_t K;
+    int64_t N;
+    int64_t block_size;
+    ORT_ENFORCE(info.GetAttr<int64_t>("K", &K).IsOK());
+    ORT_ENFORCE(info.GetAttr<int64_t>("N", &N).IsOK());
+    ORT_ENFORCE(info.GetAttr<int64_t>("block_size", &block_size).IsOK());
+    int64_t nbits = info.GetAttrOrDefault<int64_t>("bits", 4);
+
+    ORT_ENFORCE(K > 0 && N > 0, "MatMulNBits: K and N must be positive.");
+    ORT_ENFORCE(nbits == 4, "MatMulNBits: only 4 bit quantization is supported, got ", nbits);
+    ORT_ENFORCE(block_size > 0 && MlasQ4GemmIsBlockSizeSupported(static_cast<size_t>(block_size)),
+                "MatMulNBits: block_size must be a power of 2 from 16 to 256, got ", block_size);
+
+    K_ = static_cast<size_t>(K);
+    N_ = static_cast<size_t>(N);
+    block_size_ = static_cast<size_t>(block_size);
+
+    const auto& input_defs = info.node().InputDefs();
+    has_zero_points_ = input_defs.size() > IN_ZERO_POINTS && input_defs[IN_ZERO_POINTS]->Exists();
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
+  enum InputTensors : int {
+    IN_A = 0,
+    IN_B = 1,
+    IN_SCALES = 2,
+    IN_ZERO_POINTS = 3
+  };
+
+ private:
+  Status ValidateQuantParams(const Tensor& b, const Tensor& scales, const Tensor* zero_points) const;
+
+  size_t K_;
+  size_t N_;
+  size_t block_size_;
+  bool has_zero_points_;
+  BufferUniquePtr packed_b_;
+};
+
+Status MatMulNBits::ValidateQuantParams(const Tensor& b, const Tensor& scales, const Tensor* zero_points) const {
+  const size_t block_count_k = (K_ + block_size_ - 1) / block_size_;
+
+  ORT_RETURN_IF_NOT(static_cast<size_t>(b.Shape().Size()) == N_ * block_count_k * (block_size_ / 2),
+                    "MatMulNBits: B has ", b.Shape().Size(), " elements, expected ",
+                    N_ * block_count_k * (block_size_ / 2));
+  ORT_RETURN_IF_NOT(static_cast<size_t>(scales.Shape().Size()) == N_ * block_count_k,
+                    "MatMulNBits: scales has ", scales.Shape().Size(), " elements, expected ",
+                    N_ * block_count_k);
+  if (zero_points != nullptr) {
+    ORT_RETURN_IF_NOT(static_cast<size_t>(zero_points->Shape().Size()) == N_ * ((block_count_k + 1) / 2),
+                      "MatMulNBits: zero_points has ", zero_points->Shape().Size(), " elements, expected ",
+                      N_ * ((block_count_k + 1) / 2));
+  }
+
+  return Status::OK();
+}
+
+Status MatMulNBits::PrePack(const Tensor& tensor, int input_idx, /*out*/ AllocatorPtr alloc,
+                            /*out*/ bool& is_packed,
+                            /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // The scales and zero points are packed next to the quantized weight, so
+  // all of them must be constant to pack B ahead of time.
+  if (input_idx != IN_B) {
+    return Status::OK();
+  }
+
+  const Tensor* scales = nullptr;
+  if (!Info().TryGetConstantInput(IN_SCALES, &scales)) {
+    return Status::OK();
+  }
+
+  const Tensor* zero_points = nullptr;
+  if (has_zero_points_ && !Info().TryGetConstantInput(IN_ZERO_POINTS, &zero_points)) {
+    return Status::OK();
+  }
+
+  ORT_RETURN_IF_ERROR(ValidateQuantParams(tensor, *scales, zero_points));
+
+  const size_t packed_b_size = MlasQ4GemmPackBSize(N_, K_, block_size_);
+  if (packed_b_size == 0) {
+    return Status::OK();
+  }
+
+  auto* packed_b_data = alloc->Alloc(packed_b_size);
+
+  // Zero the padding so the packed buffer hashes consistently when shared.
+  memset(packed_b_data, 0, packed_b_size);
+
+  packed_b_ = BufferUniquePtr(packed_b_data, BufferDeleter(alloc));
+  MlasQ4GemmPackB(N_, K_, block_size_,
+                  tensor.Data<uint8_t>(),
+                  scales->Data<float>(),
+                  zero_points != nullptr ? zero_points->Data<uint8_t>() : nullptr,
+                  packed_b_data);
+
+  is_packed = true;
+
+  bool share_prepacked_weights = (prepacked_weights != nullptr);
+  if (share_prepacked_weights) {
+    prepacked_weights->buffers_.push_back(std::move(packed_b_));
+    prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+  }
+
+  return Status::OK();
+}
+
+Status MatMulNBits::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                              int input_idx,
+                                              /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == IN_B) {
+    used_shared_buffers = true;
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
+Status MatMulNBits::Compute(OpKernelContext* ctx) const {
+  const Tensor* a = ctx->Input<Tensor>(IN_A);
+  const auto& a_shape = a->Shape();
+
+  ORT_RETURN_IF_NOT(a_shape.NumDimensions() >= 1 && static_cast<size_t>(a_shape[a_shape.NumDimensions() - 1]) == K_,
+                    "MatMulNBits: the last dimension of A must be K, A shape: ", a_shape);
+
+  std::vector<int64_t> y_dims(a_shape.GetDims());
+  y_dims.back() = static_cast<int64_t>(N_);
+  Tensor* y = ctx->Output(0, TensorShape(y_dims));
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  const size_t M = static_cast<size_t>(a_shape.SizeToDimension(a_shape.NumDimensions() - 1));
+
+  // Pack B for this run if the quantized weight or its parameters are not
+  // constant initializers.
+  BufferUniquePtr packed_b_holder;
+  const void* packed_b = packed_b_.get();
+
+  if (packed_b == nullptr) {
+    const Tensor* b = ctx->Input<Tensor>(IN_B);
+    const Tensor* scales = ctx->Input<Tensor>(IN_SCALES);
+    const Tensor* zero_points = ctx->Input<Tensor>(IN_ZERO_POINTS);
+    ORT_RETURN_IF_ERROR(ValidateQuantParams(*b, *scales, zero_points));
+
+    AllocatorPtr allocator;
+    ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&allocator));
+
+    const size_t packed_b_size = MlasQ4GemmPackBSize(N_, K_, block_size_);
+    packed_b_holder = BufferUniquePtr(allocator->Alloc(packed_b_size), BufferDeleter(allocator));
+    MlasQ4GemmPackB(N_, K_, block_size_,
+                    b->Data<uint8_t>(),
+                    scales->Data<float>(),
+                    zero_points != nullptr ? zero_points->Data<uint8_t>() : nullptr,
+                    packed_b_holder.get());
+    packed_b = packed_b_holder.get();
+  }
+
+  // B is shared by all rows of A, so the leading dimensions of A are folded
+  // into a single GEMM.
+  MLAS_Q4GEMM_DATA_PARAMS data;
+  data.A = a->Data<float>();
+  data.lda = K_;
+  data.PackedB = packed_b;
+  data.C = y->MutableData<float>();
+  data.ldc = N_;
+
+  MlasQ4GemmBatch(M, N_, K_, block_size_, &data, 1, ctx->GetOperatorThreadPool());
+
+  return Status::OK();
+}
+
+ONNX_OPERATOR_KERNEL_EX(
+    MatMulNBits,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<uint8_t>()),
+    MatMulNBits);
+
+}  // namespace contrib
+}  // namespace onnxruntime
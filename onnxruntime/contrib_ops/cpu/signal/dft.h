@@ -1,13 +1,18 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#pragma once
+
 #ifdef BUILD_MS_EXPERIMENTAL_OPS
 
+#include "fft.h"
+
 namespace onnxruntime {
 namespace contrib {
 
 class DFT final : public OpKernel {
   bool is_onesided_ = true;
+  mutable FFTPlanCache plan_cache_;
  public:
   explicit DFT(const OpKernelInfo& info) : OpKernel(info) {
     is_onesided_ = info.GetAttrOrDefault<int64_t>("onesided", 0);
@@ -16,6 +21,7 @@ class DFT final : public OpKernel {
 };
 
 class IDFT final : public OpKernel {
+  mutable FFTPlanCache plan_cache_;
  public:
   explicit IDFT(const OpKernelInfo& info) : OpKernel(info) {
   }
@@ -24,6 +30,7 @@ class IDFT final : public OpKernel {
 
 class STFT final : public OpKernel {
   bool is_onesided_ = true;
+  mutable FFTPlanCache plan_cache_;
  public:
   explicit STFT(const OpKernelInfo& info) : OpKernel(info) {
     is_onesided_ = info.GetAttrOrDefault<int64_t>("onesided", 1);
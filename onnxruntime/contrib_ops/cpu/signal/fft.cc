@@ -0,0 +1,303 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#ifdef BUILD_MS_EXPERIMENTAL_OPS
+
+#include "fft.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+// exp(-2 * pi * i * numerator / denominator), evaluated in double precision.
+template <typename T>
+std::complex<T> UnitRoot(size_t numerator, size_t denominator) {
+  const double angle = -2.0 * kPi * static_cast<double>(numerator % denominator) / static_cast<double>(denominator);
+  return std::complex<T>(static_cast<T>(std::cos(angle)), static_cast<T>(std::sin(angle)));
+}
+
+// The std::complex operators handle infinities and NaNs in multiplications through a library call, which keeps the
+// butterflies from being vectorized, so they use these plain arithmetic helpers instead.
+template <typename T>
+inline std::complex<T> Multiply(const std::complex<T>& a, const std::complex<T>& b) {
+  return std::complex<T>(a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real());
+}
+
+// Multiplies by -i.
+template <typename T>
+inline std::complex<T> RotateNegative(const std::complex<T>& a) {
+  return std::complex<T>(a.imag(), -a.real());
+}
+
+template <size_t Radix, typename T>
+inline void Butterfly(std::complex<T>* a) {
+  if constexpr (Radix == 2) {
+    const auto a0 = a[0];
+    a[0] = a0 + a[1];
+    a[1] = a0 - a[1];
+  } else if constexpr (Radix == 4) {
+    const auto t0 = a[0] + a[2];
+    const auto t1 = a[0] - a[2];
+    const auto t2 = a[1] + a[3];
+    const auto t3 = RotateNegative(a[1] - a[3]);
+    a[0] = t0 + t2;
+    a[1] = t1 + t3;
+    a[2] = t0 - t2;
+    a[3] = t1 - t3;
+  } else if constexpr (Radix == 3) {
+    const T c = static_cast<T>(-0.5);
+    const T s = static_cast<T>(0.86602540378443864676);  // sin(2 * pi / 3)
+    const auto t1 = a[1] + a[2];
+    const auto t2 = a[1] - a[2];
+    const auto m1 = a[0] + c * t1;
+    const auto m2 = RotateNegative(s * t2);
+    a[0] = a[0] + t1;
+    a[1] = m1 + m2;
+    a[2] = m1 - m2;
+  } else {
+    static_assert(Radix == 5, "Unsupported radix.");
+    const T c1 = static_cast<T>(0.30901699437494742410);   // cos(2 * pi / 5)
+    const T c2 = static_cast<T>(-0.80901699437494742410);  // cos(4 * pi / 5)
+    const T s1 = static_cast<T>(0.95105651629515357212);   // sin(2 * pi / 5)
+    const T s2 = static_cast<T>(0.58778525229247312917);   // sin(4 * pi / 5)
+    const auto t1 = a[1] + a[4];
+    const auto t2 = a[2] + a[3];
+    const auto t3 = a[1] - a[4];
+    const auto t4 = a[2] - a[3];
+    const auto m1 = a[0] + c1 * t1 + c2 * t2;
+    const auto m2 = a[0] + c2 * t1 + c1 * t2;
+    const auto n1 = RotateNegative(s1 * t3 + s2 * t4);
+    const auto n2 = RotateNegative(s2 * t3 - s1 * t4);
+    a[0] = a[0] + t1 + t2;
+    a[1] = m1 + n1;
+    a[2] = m2 + n2;
+    a[3] = m2 - n2;
+    a[4] = m1 - n1;
+  }
+}
+
+// Runs one decimation in frequency Stockham stage: for each group q of the count groups and each of the stride
+// interleaved sub-transforms j, the radix inputs x[j + stride * (q + count * k)] are combined by a butterfly,
+// multiplied by the twiddle factors and written in sorted order to y[j + stride * (radix * q + r)].
+template <size_t Radix, typename T>
+void StockhamStage(const std::complex<T>* x, std::complex<T>* y, size_t count, size_t stride,
+                   const std::complex<T>* twiddles) {
+  for (size_t q = 0; q < count; q++) {
+    const std::complex<T>* w = twiddles + q * (Radix - 1);
+    const std::complex<T>* input = x + stride * q;
+    std::complex<T>* output = y + stride * Radix * q;
+
+    for (size_t j = 0; j < stride; j++) {
+      std::complex<T> a[Radix];
+      for (size_t k = 0; k < Radix; k++) {
+        a[k] = input[j + stride * count * k];
+      }
+
+      Butterfly<Radix>(a);
+
+      output[j] = a[0];
+      for (size_t r = 1; r < Radix; r++) {
+        output[j + stride * r] = Multiply(a[r], w[r - 1]);
+      }
+    }
+  }
+}
+
+size_t NextSmoothSize(size_t size) {
+  for (;; size++) {
+    size_t remaining = size;
+    for (size_t factor : {2, 3, 5}) {
+      while (remaining % factor == 0) {
+        remaining /= factor;
+      }
+    }
+    if (remaining == 1) {
+      return size;
+    }
+  }
+}
+
+}  // namespace
+
+template <typename T>
+FFTPlan<T>::FFTPlan(size_t size) : size_(size) {
+  if (size <= 1) {
+    return;
+  }
+
+  std::vector<size_t> radices;
+  size_t remaining = size;
+  while (remaining % 4 == 0) {
+    radices.push_back(4);
+    remaining /= 4;
+  }
+  for (size_t radix : {2, 3, 5}) {
+    while (remaining % radix == 0) {
+      radices.push_back(radix);
+      remaining /= radix;
+    }
+  }
+
+  if (remaining != 1) {
+    // The convolution has to hold 2 * size - 1 elements to be free of aliasing.
+    const size_t convolution_size = NextSmoothSize(2 * size - 1);
+    convolution_plan_ = std::make_unique<FFTPlan<T>>(convolution_size);
+
+    // k^2 is reduced modulo 2 * size to keep the angle of the chirp accurate for large k.
+    chirp_.resize(size);
+    for (size_t k = 0; k < size; k++) {
+      chirp_[k] = UnitRoot<T>(static_cast<size_t>((static_cast<uint64_t>(k) * k) % (2 * size)), 2 * size);
+    }
+
+    // The 1 / convolution_size scale of the inverse transform is folded into the spectrum.
+    chirp_spectrum_.assign(convolution_size, std::complex<T>());
+    chirp_spectrum_[0] = std::conj(chirp_[0]);
+    for (size_t k = 1; k < size; k++) {
+      chirp_spectrum_[k] = chirp_spectrum_[convolution_size - k] = std::conj(chirp_[k]);
+    }
+
+    std::vector<std::complex<T>> scratch(convolution_plan_->ScratchSize());
+    convolution_plan_->Forward(chirp_spectrum_.data(), scratch.data());
+
+    const T scale = static_cast<T>(1) / static_cast<T>(convolution_size);
+    for (auto& value : chirp_spectrum_) {
+      value *= scale;
+    }
+    return;
+  }
+
+  size_t count = size;
+  size_t stride = 1;
+  for (size_t radix : radices) {
+    const size_t length = count;
+    count /= radix;
+
+    stages_.push_back(Stage{radix, count, stride, twiddles_.size()});
+
+    for (size_t q = 0; q < count; q++) {
+      for (size_t r = 1; r < radix; r++) {
+        twiddles_.push_back(UnitRoot<T>(r * q, length));
+      }
+    }
+
+    stride *= radix;
+  }
+}
+
+template <typename T>
+size_t FFTPlan<T>::ScratchSize() const {
+  if (convolution_plan_ != nullptr) {
+    return convolution_plan_->Size() + convolution_plan_->ScratchSize();
+  }
+  return size_;
+}
+
+template <typename T>
+void FFTPlan<T>::Forward(std::complex<T>* data, std::complex<T>* scratch) const {
+  if (convolution_plan_ != nullptr) {
+    ForwardBluestein(data, scratch);
+  } else {
+    ForwardStockham(data, scratch);
+  }
+}
+
+template <typename T>
+void FFTPlan<T>::ForwardStockham(std::complex<T>* data, std::complex<T>* scratch) const {
+  std::complex<T>* x = data;
+  std::complex<T>* y = scratch;
+
+  for (const auto& stage : stages_) {
+    const std::complex<T>* twiddles = twiddles_.data() + stage.twiddle_offset;
+    switch (stage.radix) {
+      case 2:
+        StockhamStage<2>(x, y, stage.count, stage.stride, twiddles);
+        break;
+      case 3:
+        StockhamStage<3>(x, y, stage.count, stage.stride, twiddles);
+        break;
+      case 4:
+        StockhamStage<4>(x, y, stage.count, stage.stride, twiddles);
+        break;
+      default:
+        StockhamStage<5>(x, y, stage.count, stage.stride, twiddles);
+        break;
+    }
+    std::swap(x, y);
+  }
+
+  if (x != data) {
+    std::copy_n(x, size_, data);
+  }
+}
+
+template <typename T>
+void FFTPlan<T>::ForwardBluestein(std::complex<T>* data, std::complex<T>* scratch) const {
+  const size_t convolution_size = convolution_plan_->Size();
+  std::complex<T>* buffer = scratch;
+  std::complex<T>* convolution_scratch = scratch + convolution_size;
+
+  for (size_t k = 0; k < size_; k++) {
+    buffer[k] = Multiply(data[k], chirp_[k]);
+  }
+  std::fill(buffer + size_, buffer + convolution_size, std::complex<T>());
+
+  convolution_plan_->Forward(buffer, convolution_scratch);
+
+  // The inverse transform of the product is computed as the conjugate of the forward transform of its conjugate.
+  for (size_t k = 0; k < convolution_size; k++) {
+    buffer[k] = std::conj(Multiply(buffer[k], chirp_spectrum_[k]));
+  }
+
+  convolution_plan_->Forward(buffer, convolution_scratch);
+
+  for (size_t k = 0; k < size_; k++) {
+    data[k] = Multiply(std::conj(buffer[k]), chirp_[k]);
+  }
+}
+
+template <typename T>
+RealFFTPlan<T>::RealFFTPlan(size_t size) : size_(size), half_plan_(size / 2) {
+  ORT_ENFORCE(size >= 2 && size % 2 == 0, "The real FFT requires an even size, got ", size);
+
+  twiddles_.resize(size / 2 + 1);
+  for (size_t k = 0; k <= size / 2; k++) {
+    twiddles_[k] = UnitRoot<T>(k, size);
+  }
+}
+
+template <typename T>
+void RealFFTPlan<T>::Forward(std::complex<T>* packed, std::complex<T>* output, std::complex<T>* scratch) const {
+  const size_t half_size = size_ / 2;
+
+  half_plan_.Forward(packed, scratch);
+
+  // Split the spectrum Z of z[k] = x[2k] + i * x[2k + 1] into the spectra of the even and odd samples,
+  // E[k] = (Z[k] + conj(Z[-k])) / 2 and O[k] = -i * (Z[k] - conj(Z[-k])) / 2, and combine them as
+  // X[k] = E[k] + exp(-2 * pi * i * k / size) * O[k].
+  const T half = static_cast<T>(0.5);
+  for (size_t k = 0; k <= half_size; k++) {
+    const auto z = packed[k == half_size ? 0 : k];
+    const auto z_mirror = std::conj(packed[k == 0 ? 0 : half_size - k]);
+    const auto even = half * (z + z_mirror);
+    const auto odd = half * RotateNegative(z - z_mirror);
+    output[k] = even + Multiply(twiddles_[k], odd);
+  }
+}
+
+template class FFTPlan<float>;
+template class FFTPlan<double>;
+template class RealFFTPlan<float>;
+template class RealFFTPlan<double>;
+
+}  // namespace contrib
+}  // namespace onnxruntime
+
+#endif
@@ -0,0 +1,157 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#ifdef BUILD_MS_EXPERIMENTAL_OPS
+
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace onnxruntime {
+namespace contrib {
+
+// Precomputed plan for the unnormalized forward FFT of a fixed size.
+//
+// Sizes whose prime factors are all 2, 3 or 5 run as a mixed radix (4, 2, 3, 5) Stockham FFT, which needs no bit
+// reversal pass. Other sizes use Bluestein's algorithm, which turns the transform into a circular convolution that
+// is computed with a plan for a larger 2/3/5-smooth size.
+template <typename T>
+class FFTPlan {
+ public:
+  explicit FFTPlan(size_t size);
+
+  size_t Size() const { return size_; }
+
+  // Number of complex elements of scratch space required by Forward.
+  size_t ScratchSize() const;
+
+  // Computes the forward transform of the size elements of data in place.
+  void Forward(std::complex<T>* data, std::complex<T>* scratch) const;
+
+ private:
+  struct Stage {
+    size_t radix;
+    size_t count;  // number of butterfly groups, the length of the remaining sub-transforms
+    size_t stride;
+    size_t twiddle_offset;
+  };
+
+  void ForwardStockham(std::complex<T>* data, std::complex<T>* scratch) const;
+  void ForwardBluestein(std::complex<T>* data, std::complex<T>* scratch) const;
+
+  size_t size_;
+
+  std::vector<Stage> stages_;
+  std::vector<std::complex<T>> twiddles_;
+
+  // Bluestein's algorithm state: exp(-i * pi * k^2 / size) and the scaled spectrum of its conjugate.
+  std::unique_ptr<FFTPlan<T>> convolution_plan_;
+  std::vector<std::complex<T>> chirp_;
+  std::vector<std::complex<T>> chirp_spectrum_;
+};
+
+// Precomputed plan for the forward FFT of a real signal of even size. The signal is packed into a complex signal of
+// half the size, which is transformed with a complex plan and then split into the spectrum of the real signal.
+template <typename T>
+class RealFFTPlan {
+ public:
+  explicit RealFFTPlan(size_t size);
+
+  size_t Size() const { return size_; }
+
+  // Number of complex elements of scratch space required by Forward.
+  size_t ScratchSize() const { return half_plan_.ScratchSize(); }
+
+  // Computes the first size / 2 + 1 elements of the spectrum of the real signal. packed holds the size / 2 complex
+  // elements (x[2k], x[2k + 1]) on input and is overwritten. output must not overlap packed.
+  void Forward(std::complex<T>* packed, std::complex<T>* output, std::complex<T>* scratch) const;
+
+ private:
+  size_t size_;
+  FFTPlan<T> half_plan_;
+  std::vector<std::complex<T>> twiddles_;
+};
+
+// Thread safe cache of FFT plans keyed by the transform size, so that kernels only build the plans for a size once.
+// The cache holds the plans of up to kCapacity sizes of each kind, and evicts the least recently used plan when it is
+// full, so that signals of many different lengths don't grow it without bound. Plans stay valid while they are in use
+// after they are evicted.
+class FFTPlanCache {
+ public:
+  static constexpr size_t kCapacity = 16;
+
+  template <typename T>
+  std::shared_ptr<const FFTPlan<T>> GetPlan(size_t size) {
+    return GetOrCreate(GetPlans<T>().complex_plans, size);
+  }
+
+  template <typename T>
+  std::shared_ptr<const RealFFTPlan<T>> GetRealPlan(size_t size) {
+    return GetOrCreate(GetPlans<T>().real_plans, size);
+  }
+
+ private:
+  template <typename TPlan>
+  struct CachedPlan {
+    std::shared_ptr<const TPlan> plan;
+    uint64_t last_use;
+  };
+
+  template <typename TPlan>
+  using PlanMap = std::unordered_map<size_t, CachedPlan<TPlan>>;
+
+  template <typename T>
+  struct Plans {
+    PlanMap<FFTPlan<T>> complex_plans;
+    PlanMap<RealFFTPlan<T>> real_plans;
+  };
+
+  template <typename T>
+  Plans<T>& GetPlans() {
+    static_assert(std::is_same<T, float>::value || std::is_same<T, double>::value, "Unsupported FFT type.");
+    if constexpr (std::is_same<T, float>::value) {
+      return float_plans_;
+    } else {
+      return double_plans_;
+    }
+  }
+
+  template <typename TPlan>
+  std::shared_ptr<const TPlan> GetOrCreate(PlanMap<TPlan>& plans, size_t size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const uint64_t use = ++use_count_;
+
+    auto it = plans.find(size);
+    if (it != plans.end()) {
+      it->second.last_use = use;
+      return it->second.plan;
+    }
+
+    if (plans.size() >= kCapacity) {
+      plans.erase(std::min_element(plans.begin(), plans.end(), [](const auto& a, const auto& b) {
+        return a.second.last_use < b.second.last_use;
+      }));
+    }
+
+    auto plan = std::make_shared<const TPlan>(size);
+    plans.emplace(size, CachedPlan<TPlan>{plan, use});
+    return plan;
+  }
+
+  std::mutex mutex_;
+  uint64_t use_count_ = 0;
+  Plans<float> float_plans_;
+  Plans<double> double_plans_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
+
+#endif
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/util/math_cpuonly.h"
 #include "core/providers/common.h"
 #include "core/platform/threadpool.h"
@@ -24,6 +25,28 @@ namespace contrib {
 REGISTER_KERNEL_TYPED(float)
 REGISTER_KERNEL_TYPED(double)
 
+namespace {
+
+// Computes the normalization with MLAS, which adds the skip and bias rows while reducing them in a single vectorized
+// pass. Returns false if MLAS does not support the type.
+template <typename T>
+bool ComputeSkipLayerNormWithMlas(const T*, const T*, const T*, const T*, const T*, T*, int64_t, int64_t, float,
+                                  concurrency::ThreadPool*) {
+  return false;
+}
+
+template <>
+bool ComputeSkipLayerNormWithMlas<float>(const float* input_data, const float* skip_data, const float* bias_data,
+                                         const float* gamma_data, const float* beta_data, float* output_data,
+                                         int64_t task_count, int64_t hidden_size, float epsilon,
+                                         concurrency::ThreadPool* thread_pool) {
+  MlasComputeSkipLayerNorm(input_data, skip_data, bias_data, gamma_data, beta_data, output_data,
+                           static_cast<size_t>(task_count), static_cast<size_t>(hidden_size), epsilon, thread_pool);
+  return true;
+}
+
+}  // namespace
+
 template <typename T>
 SkipLayerNorm<T>::SkipLayerNorm(const OpKernelInfo& op_kernel_info)
     : OpKernel(op_kernel_info) {
@@ -98,6 +121,11 @@ Status SkipLayerNorm<T>::Compute(OpKernelContext* p_ctx) const {
 
   T* output_data = output->MutableData<T>();
 
+  if (ComputeSkipLayerNormWithMlas(input_data, skip_data, bias_data, gamma_data, beta_data, output_data,
+                                   task_count, hidden_size, epsilon_, p_ctx->GetOperatorThreadPool())) {
+    return Status::OK();
+  }
+
   concurrency::ThreadPool::TryBatchParallelFor(
       p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(task_count),
       [&](ptrdiff_t task_idx) {
@@ -10,6 +10,7 @@
 #include <tuple>
 
 #include "core/common/profiler_common.h"
+#include "core/common/sampled_profiler.h"
 #include "core/common/logging/logging.h"
 #include "core/platform/ort_mutex.h"
 
@@ -109,6 +110,21 @@ class Profiler {
     global_max_num_events_.store(new_max_num_events);
   }
   
+  /*
+  Enables the sampled profiler, which aggregates the kernel latencies of 1 in sampling_interval executions of a graph.
+  It is independent of the event profiling started by StartProfiling.
+  */
+  void EnableSampling(size_t sampling_interval) {
+    sampled_profiler_ = std::make_unique<SampledProfiler>(sampling_interval);
+  }
+
+  /*
+  Returns the sampled profiler, or nullptr if sampling is not enabled.
+  */
+  SampledProfiler* GetSampledProfiler() const {
+    return sampled_profiler_.get();
+  }
+
   void AddEpProfilers(std::unique_ptr<EpProfiler> ep_profiler) {
     if (ep_profiler) {
       ep_profilers_.push_back(std::move(ep_profiler));
@@ -155,6 +171,7 @@ class Profiler {
 #endif
 
   std::vector<std::unique_ptr<EpProfiler>> ep_profilers_;
+  std::unique_ptr<SampledProfiler> sampled_profiler_;
 };
 
 }  // namespace profiling
@@ -0,0 +1,93 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/sampled_profiler.h"
+
+#include <sstream>
+
+namespace onnxruntime {
+namespace profiling {
+
+SampledProfiler::SampledProfiler(size_t sampling_interval) : sampling_interval_(sampling_interval) {
+  ORT_ENFORCE(sampling_interval_ > 0, "The sampling interval must be > 0");
+}
+
+size_t SampledProfiler::RegisterOpType(const std::string& op_type) {
+  auto result = op_type_ids_.emplace(op_type, op_types_.size());
+  if (result.second) {
+    op_types_.push_back(op_type);
+    stats_.emplace_back();
+  }
+
+  return result.first->second;
+}
+
+void SampledProfiler::RecordLatency(size_t op_type_id, uint64_t latency_ns) {
+  if (op_type_id >= stats_.size()) {
+    return;
+  }
+
+  // the index of the highest set bit above the 1024 ns of bucket 0
+  size_t bucket = 0;
+  for (uint64_t value = latency_ns >> 10; value != 0 && bucket < kNumBuckets - 1; value >>= 1) {
+    ++bucket;
+  }
+
+  auto& stats = stats_[op_type_id];
+  stats.count.fetch_add(1, std::memory_order_relaxed);
+  stats.total_ns.fetch_add(latency_ns, std::memory_order_relaxed);
+  stats.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+std::vector<SampledProfiler::OpTypeStats> SampledProfiler::GetStats() const {
+  std::vector<OpTypeStats> result;
+  for (size_t i = 0; i < stats_.size(); ++i) {
+    const auto& stats = stats_[i];
+    const uint64_t count = stats.count.load(std::memory_order_relaxed);
+    if (count == 0) {
+      continue;
+    }
+
+    OpTypeStats op_type_stats{op_types_[i], count, stats.total_ns.load(std::memory_order_relaxed), {}};
+    for (size_t bucket = 0; bucket < kNumBuckets; ++bucket) {
+      op_type_stats.buckets[bucket] = stats.buckets[bucket].load(std::memory_order_relaxed);
+    }
+
+    result.push_back(std::move(op_type_stats));
+  }
+
+  return result;
+}
+
+std::string SampledProfiler::GetStatsAsJson() const {
+  // e.g. {"sampled_executions" : 10, "op_types" : [{"op_type" : "Conv", "count" : 20, "total_ns" : 123456,
+  //       "bucket_upper_bounds_ns" : [1024, ...], "buckets" : [0, ...]}]}
+  // The last bucket has no upper bound and is not listed in bucket_upper_bounds_ns.
+  std::ostringstream json;
+  json << R"({"sampled_executions" : )" << sampled_executions_.load(std::memory_order_relaxed)
+       << R"(, "op_types" : [)";
+
+  bool is_first_op_type = true;
+  for (const auto& stats : GetStats()) {
+    if (!is_first_op_type) json << ", ";
+    json << R"({"op_type" : ")" << stats.op_type << R"(", "count" : )" << stats.count
+         << R"(, "total_ns" : )" << stats.total_ns << R"(, "bucket_upper_bounds_ns" : [)";
+    for (size_t bucket = 0; bucket < kNumBuckets - 1; ++bucket) {
+      json << (bucket == 0 ? "" : ", ") << (uint64_t{1024} << bucket);
+    }
+
+    json << R"(], "buckets" : [)";
+    for (size_t bucket = 0; bucket < kNumBuckets; ++bucket) {
+      json << (bucket == 0 ? "" : ", ") << stats.buckets[bucket];
+    }
+
+    json << "]}";
+    is_first_op_type = false;
+  }
+
+  json << "]}";
+  return json.str();
+}
+
+}  // namespace profiling
+}  // namespace onnxruntime
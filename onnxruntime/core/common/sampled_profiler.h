@@ -0,0 +1,118 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+namespace profiling {
+
+/**
+ * Aggregates the kernel latencies of the nodes into a histogram per op type, for 1 in N executions of a graph.
+ * It is meant to be left enabled in production, so its overhead is bounded by the sampling interval, and recording a
+ * latency only increments atomic counters in buffers allocated up front: no locks, allocations or string formatting.
+ * The op types are registered while the session is initialized, before any graph is executed.
+ */
+class SampledProfiler {
+ public:
+  // Bucket 0 counts the latencies below 1024 ns, bucket i > 0 those in [2^(i + 9), 2^(i + 10)) ns, and the last bucket
+  // all the latencies from 2^(kNumBuckets + 8) ns on.
+  static constexpr size_t kNumBuckets = 32;
+  static constexpr size_t kInvalidOpTypeId = static_cast<size_t>(-1);
+
+  struct OpTypeStats {
+    std::string op_type;
+    uint64_t count;
+    uint64_t total_ns;
+    std::array<uint64_t, kNumBuckets> buckets;
+  };
+
+  /*
+  Samples 1 in sampling_interval executions of a graph. sampling_interval must be > 0.
+  */
+  explicit SampledProfiler(size_t sampling_interval);
+
+  /*
+  Registers an op type and returns its id, or the id it already has.
+  This is not thread-safe, and must not be called once graphs are executed.
+  */
+  size_t RegisterOpType(const std::string& op_type);
+
+  /*
+  Returns the id of a registered op type, or kInvalidOpTypeId.
+  */
+  size_t GetOpTypeId(const std::string& op_type) const {
+    auto it = op_type_ids_.find(op_type);
+    return it == op_type_ids_.cend() ? kInvalidOpTypeId : it->second;
+  }
+
+  /*
+  Decides whether an execution of a graph is sampled. Called once per execution with the counter of the executions of
+  that graph, which it increments. Each graph has its own counter, so that 1 in sampling_interval executions of each
+  graph is sampled however the executions of a graph and its subgraphs interleave.
+  */
+  bool ShouldSample(std::atomic<uint64_t>& graph_executions) {
+    if (graph_executions.fetch_add(1, std::memory_order_relaxed) % sampling_interval_ != 0) {
+      return false;
+    }
+
+    sampled_executions_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /*
+  Records the kernel latency of a node of a registered op type in a sampled execution.
+  */
+  void RecordLatency(size_t op_type_id, uint64_t latency_ns);
+
+  /*
+  Records the time since kernel_begin_time as the kernel latency of a node of a registered op type.
+  */
+  void RecordLatencySince(size_t op_type_id, const TimePoint& kernel_begin_time) {
+    const auto latency = std::chrono::high_resolution_clock::now() - kernel_begin_time;
+    RecordLatency(op_type_id,
+                  static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count()));
+  }
+
+  /*
+  Returns the statistics of the op types with at least one recorded latency. The counters are read while they may
+  still be updated, so the statistics are not a consistent snapshot while graphs are executed.
+  */
+  std::vector<OpTypeStats> GetStats() const;
+
+  /*
+  Returns the statistics as a JSON object, with the number of sampled executions and an entry per op type.
+  */
+  std::string GetStatsAsJson() const;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SampledProfiler);
+
+  struct AtomicOpTypeStats {
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> total_ns{0};
+    std::array<std::atomic<uint64_t>, kNumBuckets> buckets{};
+  };
+
+  const size_t sampling_interval_;
+  std::atomic<uint64_t> sampled_executions_{0};
+
+  std::unordered_map<std::string, size_t> op_type_ids_;
+  std::vector<std::string> op_types_;
+  // a deque doesn't move its elements when growing
+  std::deque<AtomicOpTypeStats> stats_;
+};
+
+}  // namespace profiling
+}  // namespace onnxruntime
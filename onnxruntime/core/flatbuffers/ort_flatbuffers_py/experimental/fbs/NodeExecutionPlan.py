@@ -0,0 +1,28 @@
+# automatically generated by the FlatBuffers compiler, do not modify
+
+# namespace: fbs
+
+import flatbuffers
+from flatbuffers.compat import import_numpy
+np = import_numpy()
+
+class NodeExecutionPlan(object):
+    __slots__ = ['_tab']
+
+    # NodeExecutionPlan
+    def Init(self, buf, pos):
+        self._tab = flatbuffers.table.Table(buf, pos)
+
+    # NodeExecutionPlan
+    def NodeIndex(self): return self._tab.Get(flatbuffers.number_types.Uint32Flags, self._tab.Pos + flatbuffers.number_types.UOffsetTFlags.py_type(0))
+    # NodeExecutionPlan
+    def FreeFromIndex(self): return self._tab.Get(flatbuffers.number_types.Int32Flags, self._tab.Pos + flatbuffers.number_types.UOffsetTFlags.py_type(4))
+    # NodeExecutionPlan
+    def FreeToIndex(self): return self._tab.Get(flatbuffers.number_types.Int32Flags, self._tab.Pos + flatbuffers.number_types.UOffsetTFlags.py_type(8))
+
+def CreateNodeExecutionPlan(builder, nodeIndex, freeFromIndex, freeToIndex):
+    builder.Prep(4, 12)
+    builder.PrependInt32(freeToIndex)
+    builder.PrependInt32(freeFromIndex)
+    builder.PrependUint32(nodeIndex)
+    return builder.Offset()
@@ -60,8 +60,32 @@ class SessionState(object):
         o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(6))
         return o == 0
 
-def SessionStateStart(builder): builder.StartObject(2)
+    # SessionState
+    def PrepackedWeights(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(8))
+        if o != 0:
+            x = self._tab.Indirect(o + self._tab.Pos)
+            from ort_flatbuffers_py.experimental.fbs.PrePackedWeights import PrePackedWeights
+            obj = PrePackedWeights()
+            obj.Init(self._tab.Bytes, x)
+            return obj
+        return None
+
+    # SessionState
+    def ExecutionPlan(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(10))
+        if o != 0:
+            x = self._tab.Indirect(o + self._tab.Pos)
+            from ort_flatbuffers_py.experimental.fbs.ExecutionPlan import ExecutionPlan
+            obj = ExecutionPlan()
+            obj.Init(self._tab.Bytes, x)
+            return obj
+        return None
+
+def SessionStateStart(builder): builder.StartObject(4)
 def SessionStateAddKernels(builder, kernels): builder.PrependUOffsetTRelativeSlot(0, flatbuffers.number_types.UOffsetTFlags.py_type(kernels), 0)
 def SessionStateAddSubGraphSessionStates(builder, subGraphSessionStates): builder.PrependUOffsetTRelativeSlot(1, flatbuffers.number_types.UOffsetTFlags.py_type(subGraphSessionStates), 0)
 def SessionStateStartSubGraphSessionStatesVector(builder, numElems): return builder.StartVector(4, numElems, 4)
+def SessionStateAddPrepackedWeights(builder, prepackedWeights): builder.PrependUOffsetTRelativeSlot(2, flatbuffers.number_types.UOffsetTFlags.py_type(prepackedWeights), 0)
+def SessionStateAddExecutionPlan(builder, executionPlan): builder.PrependUOffsetTRelativeSlot(3, flatbuffers.number_types.UOffsetTFlags.py_type(executionPlan), 0)
 def SessionStateEnd(builder): return builder.EndObject()
@@ -0,0 +1,134 @@
+# automatically generated by the FlatBuffers compiler, do not modify
+
+# namespace: fbs
+
+import flatbuffers
+from flatbuffers.compat import import_numpy
+np = import_numpy()
+
+class ValueAllocationPlan(object):
+    __slots__ = ['_tab']
+
+    @classmethod
+    def GetRootAsValueAllocationPlan(cls, buf, offset):
+        n = flatbuffers.encode.Get(flatbuffers.packer.uoffset, buf, offset)
+        x = ValueAllocationPlan()
+        x.Init(buf, n + offset)
+        return x
+
+    @classmethod
+    def ValueAllocationPlanBufferHasIdentifier(cls, buf, offset, size_prefixed=False):
+        return flatbuffers.util.BufferHasIdentifier(buf, offset, b"\x4F\x52\x54\x4D", size_prefixed=size_prefixed)
+
+    # ValueAllocationPlan
+    def Init(self, buf, pos):
+        self._tab = flatbuffers.table.Table(buf, pos)
+
+    # ValueAllocationPlan
+    def Name(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(4))
+        if o != 0:
+            return self._tab.String(o + self._tab.Pos)
+        return None
+
+    # ValueAllocationPlan
+    def AllocKind(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(6))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Int32Flags, o + self._tab.Pos)
+        return 0
+
+    # ValueAllocationPlan
+    def ValueType(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(8))
+        if o != 0:
+            return self._tab.String(o + self._tab.Pos)
+        return None
+
+    # ValueAllocationPlan
+    def LocationIndex(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(10))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Uint32Flags, o + self._tab.Pos)
+        return 0
+
+    # ValueAllocationPlan
+    def ReusedBuffer(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(12))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Int32Flags, o + self._tab.Pos)
+        return 0
+
+    # ValueAllocationPlan
+    def CreateFenceIfAsync(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(14))
+        if o != 0:
+            return bool(self._tab.Get(flatbuffers.number_types.BoolFlags, o + self._tab.Pos))
+        return False
+
+    # ValueAllocationPlan
+    def ProgramCounterStarts(self, j):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(16))
+        if o != 0:
+            a = self._tab.Vector(o)
+            return self._tab.Get(flatbuffers.number_types.Uint64Flags, a + flatbuffers.number_types.UOffsetTFlags.py_type(j * 8))
+        return 0
+
+    # ValueAllocationPlan
+    def ProgramCounterStartsAsNumpy(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(16))
+        if o != 0:
+            return self._tab.GetVectorAsNumpy(flatbuffers.number_types.Uint64Flags, o)
+        return 0
+
+    # ValueAllocationPlan
+    def ProgramCounterStartsLength(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(16))
+        if o != 0:
+            return self._tab.VectorLen(o)
+        return 0
+
+    # ValueAllocationPlan
+    def ProgramCounterStartsIsNone(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(16))
+        return o == 0
+
+    # ValueAllocationPlan
+    def ProgramCounterEnds(self, j):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(18))
+        if o != 0:
+            a = self._tab.Vector(o)
+            return self._tab.Get(flatbuffers.number_types.Uint64Flags, a + flatbuffers.number_types.UOffsetTFlags.py_type(j * 8))
+        return 0
+
+    # ValueAllocationPlan
+    def ProgramCounterEndsAsNumpy(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(18))
+        if o != 0:
+            return self._tab.GetVectorAsNumpy(flatbuffers.number_types.Uint64Flags, o)
+        return 0
+
+    # ValueAllocationPlan
+    def ProgramCounterEndsLength(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(18))
+        if o != 0:
+            return self._tab.VectorLen(o)
+        return 0
+
+    # ValueAllocationPlan
+    def ProgramCounterEndsIsNone(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(18))
+        return o == 0
+
+def ValueAllocationPlanStart(builder): builder.StartObject(8)
+def ValueAllocationPlanAddName(builder, name): builder.PrependUOffsetTRelativeSlot(0, flatbuffers.number_types.UOffsetTFlags.py_type(name), 0)
+def ValueAllocationPlanAddAllocKind(builder, allocKind): builder.PrependInt32Slot(1, allocKind, 0)
+def ValueAllocationPlanAddValueType(builder, valueType): builder.PrependUOffsetTRelativeSlot(2, flatbuffers.number_types.UOffsetTFlags.py_type(valueType), 0)
+def ValueAllocationPlanAddLocationIndex(builder, locationIndex): builder.PrependUint32Slot(3, locationIndex, 0)
+def ValueAllocationPlanAddReusedBuffer(builder, reusedBuffer): builder.PrependInt32Slot(4, reusedBuffer, 0)
+def ValueAllocationPlanAddCreateFenceIfAsync(builder, createFenceIfAsync): builder.PrependBoolSlot(5, createFenceIfAsync, 0)
+def ValueAllocationPlanAddProgramCounterStarts(builder, programCounterStarts): builder.PrependUOffsetTRelativeSlot(6, flatbuffers.number_types.UOffsetTFlags.py_type(programCounterStarts), 0)
+def ValueAllocationPlanStartProgramCounterStartsVector(builder, numElems): return builder.StartVector(8, numElems, 8)
+def ValueAllocationPlanAddProgramCounterEnds(builder, programCounterEnds): builder.PrependUOffsetTRelativeSlot(7, flatbuffers.number_types.UOffsetTFlags.py_type(programCounterEnds), 0)
+def ValueAllocationPlanStartProgramCounterEndsVector(builder, numElems): return builder.StartVector(8, numElems, 8)
+def ValueAllocationPlanEnd(builder): return builder.EndObject()
@@ -66,6 +66,29 @@ struct ModelBuilder;
 struct KernelCreateInfos;
 struct KernelCreateInfosBuilder;
 
+struct PrePackedBuffer;
+struct PrePackedBufferBuilder;
+
+struct PrePackedWeight;
+struct PrePackedWeightBuilder;
+
+struct PrePackedWeights;
+struct PrePackedWeightsBuilder;
+
+struct MemoryLocation;
+struct MemoryLocationBuilder;
+
+struct ValueAllocationPlan;
+struct ValueAllocationPlanBuilder;
+
+struct NodeExecutionPlan;
+
+struct MemoryPattern;
+struct MemoryPatternBuilder;
+
+struct ExecutionPlan;
+struct ExecutionPlanBuilder;
+
 struct SubGraphSessionState;
 struct SubGraphSessionStateBuilder;
 
@@ -358,6 +381,33 @@ FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(4) EdgeEnd FLATBUFFERS_FINAL_CLASS {
 };
 FLATBUFFERS_STRUCT_END(EdgeEnd, 12);
 
+FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(4) NodeExecutionPlan FLATBUFFERS_FINAL_CLASS {
+ private:
+  uint32_t node_index_;
+  int32_t free_from_index_;
+  int32_t free_to_index_;
+
+ public:
+  NodeExecutionPlan() {
+    memset(static_cast<void *>(this), 0, sizeof(NodeExecutionPlan));
+  }
+  NodeExecutionPlan(uint32_t _node_index, int32_t _free_from_index, int32_t _free_to_index)
+      : node_index_(flatbuffers::EndianScalar(_node_index)),
+        free_from_index_(flatbuffers::EndianScalar(_free_from_index)),
+        free_to_index_(flatbuffers::EndianScalar(_free_to_index)) {
+  }
+  uint32_t node_index() const {
+    return flatbuffers::EndianScalar(node_index_);
+  }
+  int32_t free_from_index() const {
+    return flatbuffers::EndianScalar(free_from_index_);
+  }
+  int32_t free_to_index() const {
+    return flatbuffers::EndianScalar(free_to_index_);
+  }
+};
+FLATBUFFERS_STRUCT_END(NodeExecutionPlan, 12);
+
 struct Shape FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   typedef ShapeBuilder Builder;
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
@@ -2115,6 +2165,737 @@ inline flatbuffers::Offset<KernelCreateInfos> CreateKernelCreateInfosDirect(
       kernel_def_hashes__);
 }
 
+struct PrePackedBuffer FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef PrePackedBufferBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_DATA = 4
+  };
+  const flatbuffers::Vector<uint8_t> *data() const {
+    return GetPointer<const flatbuffers::Vector<uint8_t> *>(VT_DATA);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_DATA) &&
+           verifier.VerifyVector(data()) &&
+           verifier.EndTable();
+  }
+};
+
+struct PrePackedBufferBuilder {
+  typedef PrePackedBuffer Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_data(flatbuffers::Offset<flatbuffers::Vector<uint8_t>> data) {
+    fbb_.AddOffset(PrePackedBuffer::VT_DATA, data);
+  }
+  explicit PrePackedBufferBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  PrePackedBufferBuilder &operator=(const PrePackedBufferBuilder &);
+  flatbuffers::Offset<PrePackedBuffer> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<PrePackedBuffer>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<PrePackedBuffer> CreatePrePackedBuffer(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::Vector<uint8_t>> data = 0) {
+  PrePackedBufferBuilder builder_(_fbb);
+  builder_.add_data(data);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<PrePackedBuffer> CreatePrePackedBufferDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const std::vector<uint8_t> *data = nullptr) {
+  auto data__ = data ? _fbb.CreateVector<uint8_t>(*data) : 0;
+  return onnxruntime::experimental::fbs::CreatePrePackedBuffer(
+      _fbb,
+      data__);
+}
+
+struct PrePackedWeight FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef PrePackedWeightBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_NODE_INDEX = 4,
+    VT_INPUT_INDEX = 6,
+    VT_KERNEL_DEF_HASH = 8,
+    VT_BUFFERS = 10
+  };
+  uint32_t node_index() const {
+    return GetField<uint32_t>(VT_NODE_INDEX, 0);
+  }
+  int32_t input_index() const {
+    return GetField<int32_t>(VT_INPUT_INDEX, 0);
+  }
+  uint64_t kernel_def_hash() const {
+    return GetField<uint64_t>(VT_KERNEL_DEF_HASH, 0);
+  }
+  const flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::PrePackedBuffer>> *buffers() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::PrePackedBuffer>> *>(VT_BUFFERS);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint32_t>(verifier, VT_NODE_INDEX) &&
+           VerifyField<int32_t>(verifier, VT_INPUT_INDEX) &&
+           VerifyField<uint64_t>(verifier, VT_KERNEL_DEF_HASH) &&
+           VerifyOffset(verifier, VT_BUFFERS) &&
+           verifier.VerifyVector(buffers()) &&
+           verifier.VerifyVectorOfTables(buffers()) &&
+           verifier.EndTable();
+  }
+};
+
+struct PrePackedWeightBuilder {
+  typedef PrePackedWeight Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_node_index(uint32_t node_index) {
+    fbb_.AddElement<uint32_t>(PrePackedWeight::VT_NODE_INDEX, node_index, 0);
+  }
+  void add_input_index(int32_t input_index) {
+    fbb_.AddElement<int32_t>(PrePackedWeight::VT_INPUT_INDEX, input_index, 0);
+  }
+  void add_kernel_def_hash(uint64_t kernel_def_hash) {
+    fbb_.AddElement<uint64_t>(PrePackedWeight::VT_KERNEL_DEF_HASH, kernel_def_hash, 0);
+  }
+  void add_buffers(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::PrePackedBuffer>>> buffers) {
+    fbb_.AddOffset(PrePackedWeight::VT_BUFFERS, buffers);
+  }
+  explicit PrePackedWeightBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  PrePackedWeightBuilder &operator=(const PrePackedWeightBuilder &);
+  flatbuffers::Offset<PrePackedWeight> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<PrePackedWeight>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<PrePackedWeight> CreatePrePackedWeight(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint32_t node_index = 0,
+    int32_t input_index = 0,
+    uint64_t kernel_def_hash = 0,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::PrePackedBuffer>>> buffers = 0) {
+  PrePackedWeightBuilder builder_(_fbb);
+  builder_.add_kernel_def_hash(kernel_def_hash);
+  builder_.add_buffers(buffers);
+  builder_.add_input_index(input_index);
+  builder_.add_node_index(node_index);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<PrePackedWeight> CreatePrePackedWeightDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint32_t node_index = 0,
+    int32_t input_index = 0,
+    uint64_t kernel_def_hash = 0,
+    const std::vector<flatbuffers::Offset<onnxruntime::experimental::fbs::PrePackedBuffer>> *buffers = nullptr) {
+  auto buffers__ = buffers ? _fbb.CreateVector<flatbuffers::Offset<onnxruntime::experimental::fbs::PrePackedBuffer>>(*buffers) : 0;
+  return onnxruntime::experimental::fbs::CreatePrePackedWeight(
+      _fbb,
+      node_index,
+      input_index,
+      kernel_def_hash,
+      buffers__);
+}
+
+struct PrePackedWeights FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef PrePackedWeightsBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_ISA_FINGERPRINT = 4,
+    VT_WEIGHTS = 6
+  };
+  const flatbuffers::String *isa_fingerprint() const {
+    return GetPointer<const flatbuffers::String *>(VT_ISA_FINGERPRINT);
+  }
+  const flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::PrePackedWeight>> *weights() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::PrePackedWeight>> *>(VT_WEIGHTS);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_ISA_FINGERPRINT) &&
+           verifier.VerifyString(isa_fingerprint()) &&
+           VerifyOffset(verifier, VT_WEIGHTS) &&
+           verifier.VerifyVector(weights()) &&
+           verifier.VerifyVectorOfTables(weights()) &&
+           verifier.EndTable();
+  }
+};
+
+struct PrePackedWeightsBuilder {
+  typedef PrePackedWeights Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_isa_fingerprint(flatbuffers::Offset<flatbuffers::String> isa_fingerprint) {
+    fbb_.AddOffset(PrePackedWeights::VT_ISA_FINGERPRINT, isa_fingerprint);
+  }
+  void add_weights(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::PrePackedWeight>>> weights) {
+    fbb_.AddOffset(PrePackedWeights::VT_WEIGHTS, weights);
+  }
+  explicit PrePackedWeightsBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  PrePackedWeightsBuilder &operator=(const PrePackedWeightsBuilder &);
+  flatbuffers::Offset<PrePackedWeights> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<PrePackedWeights>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<PrePackedWeights> CreatePrePackedWeights(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::String> isa_fingerprint = 0,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::PrePackedWeight>>> weights = 0) {
+  PrePackedWeightsBuilder builder_(_fbb);
+  builder_.add_weights(weights);
+  builder_.add_isa_fingerprint(isa_fingerprint);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<PrePackedWeights> CreatePrePackedWeightsDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const char *isa_fingerprint = nullptr,
+    const std::vector<flatbuffers::Offset<onnxruntime::experimental::fbs::PrePackedWeight>> *weights = nullptr) {
+  auto isa_fingerprint__ = isa_fingerprint ? _fbb.CreateString(isa_fingerprint) : 0;
+  auto weights__ = weights ? _fbb.CreateVector<flatbuffers::Offset<onnxruntime::experimental::fbs::PrePackedWeight>>(*weights) : 0;
+  return onnxruntime::experimental::fbs::CreatePrePackedWeights(
+      _fbb,
+      isa_fingerprint__,
+      weights__);
+}
+
+struct MemoryLocation FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef MemoryLocationBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_NAME = 4,
+    VT_ID = 6,
+    VT_MEM_TYPE = 8,
+    VT_ALLOC_TYPE = 10
+  };
+  const flatbuffers::String *name() const {
+    return GetPointer<const flatbuffers::String *>(VT_NAME);
+  }
+  int32_t id() const {
+    return GetField<int32_t>(VT_ID, 0);
+  }
+  int32_t mem_type() const {
+    return GetField<int32_t>(VT_MEM_TYPE, 0);
+  }
+  int32_t alloc_type() const {
+    return GetField<int32_t>(VT_ALLOC_TYPE, 0);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_NAME) &&
+           verifier.VerifyString(name()) &&
+           VerifyField<int32_t>(verifier, VT_ID) &&
+           VerifyField<int32_t>(verifier, VT_MEM_TYPE) &&
+           VerifyField<int32_t>(verifier, VT_ALLOC_TYPE) &&
+           verifier.EndTable();
+  }
+};
+
+struct MemoryLocationBuilder {
+  typedef MemoryLocation Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_name(flatbuffers::Offset<flatbuffers::String> name) {
+    fbb_.AddOffset(MemoryLocation::VT_NAME, name);
+  }
+  void add_id(int32_t id) {
+    fbb_.AddElement<int32_t>(MemoryLocation::VT_ID, id, 0);
+  }
+  void add_mem_type(int32_t mem_type) {
+    fbb_.AddElement<int32_t>(MemoryLocation::VT_MEM_TYPE, mem_type, 0);
+  }
+  void add_alloc_type(int32_t alloc_type) {
+    fbb_.AddElement<int32_t>(MemoryLocation::VT_ALLOC_TYPE, alloc_type, 0);
+  }
+  explicit MemoryLocationBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  MemoryLocationBuilder &operator=(const MemoryLocationBuilder &);
+  flatbuffers::Offset<MemoryLocation> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<MemoryLocation>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<MemoryLocation> CreateMemoryLocation(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::String> name = 0,
+    int32_t id = 0,
+    int32_t mem_type = 0,
+    int32_t alloc_type = 0) {
+  MemoryLocationBuilder builder_(_fbb);
+  builder_.add_alloc_type(alloc_type);
+  builder_.add_mem_type(mem_type);
+  builder_.add_id(id);
+  builder_.add_name(name);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<MemoryLocation> CreateMemoryLocationDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const char *name = nullptr,
+    int32_t id = 0,
+    int32_t mem_type = 0,
+    int32_t alloc_type = 0) {
+  auto name__ = name ? _fbb.CreateString(name) : 0;
+  return onnxruntime::experimental::fbs::CreateMemoryLocation(
+      _fbb,
+      name__,
+      id,
+      mem_type,
+      alloc_type);
+}
+
+struct ValueAllocationPlan FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef ValueAllocationPlanBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_NAME = 4,
+    VT_ALLOC_KIND = 6,
+    VT_VALUE_TYPE = 8,
+    VT_LOCATION_INDEX = 10,
+    VT_REUSED_BUFFER = 12,
+    VT_CREATE_FENCE_IF_ASYNC = 14,
+    VT_PROGRAM_COUNTER_STARTS = 16,
+    VT_PROGRAM_COUNTER_ENDS = 18
+  };
+  const flatbuffers::String *name() const {
+    return GetPointer<const flatbuffers::String *>(VT_NAME);
+  }
+  int32_t alloc_kind() const {
+    return GetField<int32_t>(VT_ALLOC_KIND, 0);
+  }
+  const flatbuffers::String *value_type() const {
+    return GetPointer<const flatbuffers::String *>(VT_VALUE_TYPE);
+  }
+  uint32_t location_index() const {
+    return GetField<uint32_t>(VT_LOCATION_INDEX, 0);
+  }
+  int32_t reused_buffer() const {
+    return GetField<int32_t>(VT_REUSED_BUFFER, 0);
+  }
+  bool create_fence_if_async() const {
+    return GetField<uint8_t>(VT_CREATE_FENCE_IF_ASYNC, 0) != 0;
+  }
+  const flatbuffers::Vector<uint64_t> *program_counter_starts() const {
+    return GetPointer<const flatbuffers::Vector<uint64_t> *>(VT_PROGRAM_COUNTER_STARTS);
+  }
+  const flatbuffers::Vector<uint64_t> *program_counter_ends() const {
+    return GetPointer<const flatbuffers::Vector<uint64_t> *>(VT_PROGRAM_COUNTER_ENDS);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_NAME) &&
+           verifier.VerifyString(name()) &&
+           VerifyField<int32_t>(verifier, VT_ALLOC_KIND) &&
+           VerifyOffset(verifier, VT_VALUE_TYPE) &&
+           verifier.VerifyString(value_type()) &&
+           VerifyField<uint32_t>(verifier, VT_LOCATION_INDEX) &&
+           VerifyField<int32_t>(verifier, VT_REUSED_BUFFER) &&
+           VerifyField<uint8_t>(verifier, VT_CREATE_FENCE_IF_ASYNC) &&
+           VerifyOffset(verifier, VT_PROGRAM_COUNTER_STARTS) &&
+           verifier.VerifyVector(program_counter_starts()) &&
+           VerifyOffset(verifier, VT_PROGRAM_COUNTER_ENDS) &&
+           verifier.VerifyVector(program_counter_ends()) &&
+           verifier.EndTable();
+  }
+};
+
+struct ValueAllocationPlanBuilder {
+  typedef ValueAllocationPlan Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_name(flatbuffers::Offset<flatbuffers::String> name) {
+    fbb_.AddOffset(ValueAllocationPlan::VT_NAME, name);
+  }
+  void add_alloc_kind(int32_t alloc_kind) {
+    fbb_.AddElement<int32_t>(ValueAllocationPlan::VT_ALLOC_KIND, alloc_kind, 0);
+  }
+  void add_value_type(flatbuffers::Offset<flatbuffers::String> value_type) {
+    fbb_.AddOffset(ValueAllocationPlan::VT_VALUE_TYPE, value_type);
+  }
+  void add_location_index(uint32_t location_index) {
+    fbb_.AddElement<uint32_t>(ValueAllocationPlan::VT_LOCATION_INDEX, location_index, 0);
+  }
+  void add_reused_buffer(int32_t reused_buffer) {
+    fbb_.AddElement<int32_t>(ValueAllocationPlan::VT_REUSED_BUFFER, reused_buffer, 0);
+  }
+  void add_create_fence_if_async(bool create_fence_if_async) {
+    fbb_.AddElement<uint8_t>(ValueAllocationPlan::VT_CREATE_FENCE_IF_ASYNC, static_cast<uint8_t>(create_fence_if_async), 0);
+  }
+  void add_program_counter_starts(flatbuffers::Offset<flatbuffers::Vector<uint64_t>> program_counter_starts) {
+    fbb_.AddOffset(ValueAllocationPlan::VT_PROGRAM_COUNTER_STARTS, program_counter_starts);
+  }
+  void add_program_counter_ends(flatbuffers::Offset<flatbuffers::Vector<uint64_t>> program_counter_ends) {
+    fbb_.AddOffset(ValueAllocationPlan::VT_PROGRAM_COUNTER_ENDS, program_counter_ends);
+  }
+  explicit ValueAllocationPlanBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  ValueAllocationPlanBuilder &operator=(const ValueAllocationPlanBuilder &);
+  flatbuffers::Offset<ValueAllocationPlan> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<ValueAllocationPlan>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<ValueAllocationPlan> CreateValueAllocationPlan(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::String> name = 0,
+    int32_t alloc_kind = 0,
+    flatbuffers::Offset<flatbuffers::String> value_type = 0,
+    uint32_t location_index = 0,
+    int32_t reused_buffer = 0,
+    bool create_fence_if_async = false,
+    flatbuffers::Offset<flatbuffers::Vector<uint64_t>> program_counter_starts = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint64_t>> program_counter_ends = 0) {
+  ValueAllocationPlanBuilder builder_(_fbb);
+  builder_.add_program_counter_ends(program_counter_ends);
+  builder_.add_program_counter_starts(program_counter_starts);
+  builder_.add_reused_buffer(reused_buffer);
+  builder_.add_location_index(location_index);
+  builder_.add_value_type(value_type);
+  builder_.add_alloc_kind(alloc_kind);
+  builder_.add_name(name);
+  builder_.add_create_fence_if_async(create_fence_if_async);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<ValueAllocationPlan> CreateValueAllocationPlanDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const char *name = nullptr,
+    int32_t alloc_kind = 0,
+    const char *value_type = nullptr,
+    uint32_t location_index = 0,
+    int32_t reused_buffer = 0,
+    bool create_fence_if_async = false,
+    const std::vector<uint64_t> *program_counter_starts = nullptr,
+    const std::vector<uint64_t> *program_counter_ends = nullptr) {
+  auto name__ = name ? _fbb.CreateString(name) : 0;
+  auto value_type__ = value_type ? _fbb.CreateString(value_type) : 0;
+  auto program_counter_starts__ = program_counter_starts ? _fbb.CreateVector<uint64_t>(*program_counter_starts) : 0;
+  auto program_counter_ends__ = program_counter_ends ? _fbb.CreateVector<uint64_t>(*program_counter_ends) : 0;
+  return onnxruntime::experimental::fbs::CreateValueAllocationPlan(
+      _fbb,
+      name__,
+      alloc_kind,
+      value_type__,
+      location_index,
+      reused_buffer,
+      create_fence_if_async,
+      program_counter_starts__,
+      program_counter_ends__);
+}
+
+struct MemoryPattern FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef MemoryPatternBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_LOCATION_INDEX = 4,
+    VT_PEAK_SIZE = 6,
+    VT_VALUE_INDICES = 8,
+    VT_OFFSETS = 10,
+    VT_SIZES = 12
+  };
+  uint32_t location_index() const {
+    return GetField<uint32_t>(VT_LOCATION_INDEX, 0);
+  }
+  uint64_t peak_size() const {
+    return GetField<uint64_t>(VT_PEAK_SIZE, 0);
+  }
+  const flatbuffers::Vector<int32_t> *value_indices() const {
+    return GetPointer<const flatbuffers::Vector<int32_t> *>(VT_VALUE_INDICES);
+  }
+  const flatbuffers::Vector<uint64_t> *offsets() const {
+    return GetPointer<const flatbuffers::Vector<uint64_t> *>(VT_OFFSETS);
+  }
+  const flatbuffers::Vector<uint64_t> *sizes() const {
+    return GetPointer<const flatbuffers::Vector<uint64_t> *>(VT_SIZES);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint32_t>(verifier, VT_LOCATION_INDEX) &&
+           VerifyField<uint64_t>(verifier, VT_PEAK_SIZE) &&
+           VerifyOffset(verifier, VT_VALUE_INDICES) &&
+           verifier.VerifyVector(value_indices()) &&
+           VerifyOffset(verifier, VT_OFFSETS) &&
+           verifier.VerifyVector(offsets()) &&
+           VerifyOffset(verifier, VT_SIZES) &&
+           verifier.VerifyVector(sizes()) &&
+           verifier.EndTable();
+  }
+};
+
+struct MemoryPatternBuilder {
+  typedef MemoryPattern Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_location_index(uint32_t location_index) {
+    fbb_.AddElement<uint32_t>(MemoryPattern::VT_LOCATION_INDEX, location_index, 0);
+  }
+  void add_peak_size(uint64_t peak_size) {
+    fbb_.AddElement<uint64_t>(MemoryPattern::VT_PEAK_SIZE, peak_size, 0);
+  }
+  void add_value_indices(flatbuffers::Offset<flatbuffers::Vector<int32_t>> value_indices) {
+    fbb_.AddOffset(MemoryPattern::VT_VALUE_INDICES, value_indices);
+  }
+  void add_offsets(flatbuffers::Offset<flatbuffers::Vector<uint64_t>> offsets) {
+    fbb_.AddOffset(MemoryPattern::VT_OFFSETS, offsets);
+  }
+  void add_sizes(flatbuffers::Offset<flatbuffers::Vector<uint64_t>> sizes) {
+    fbb_.AddOffset(MemoryPattern::VT_SIZES, sizes);
+  }
+  explicit MemoryPatternBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  MemoryPatternBuilder &operator=(const MemoryPatternBuilder &);
+  flatbuffers::Offset<MemoryPattern> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<MemoryPattern>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<MemoryPattern> CreateMemoryPattern(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint32_t location_index = 0,
+    uint64_t peak_size = 0,
+    flatbuffers::Offset<flatbuffers::Vector<int32_t>> value_indices = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint64_t>> offsets = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint64_t>> sizes = 0) {
+  MemoryPatternBuilder builder_(_fbb);
+  builder_.add_peak_size(peak_size);
+  builder_.add_sizes(sizes);
+  builder_.add_offsets(offsets);
+  builder_.add_value_indices(value_indices);
+  builder_.add_location_index(location_index);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<MemoryPattern> CreateMemoryPatternDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint32_t location_index = 0,
+    uint64_t peak_size = 0,
+    const std::vector<int32_t> *value_indices = nullptr,
+    const std::vector<uint64_t> *offsets = nullptr,
+    const std::vector<uint64_t> *sizes = nullptr) {
+  auto value_indices__ = value_indices ? _fbb.CreateVector<int32_t>(*value_indices) : 0;
+  auto offsets__ = offsets ? _fbb.CreateVector<uint64_t>(*offsets) : 0;
+  auto sizes__ = sizes ? _fbb.CreateVector<uint64_t>(*sizes) : 0;
+  return onnxruntime::experimental::fbs::CreateMemoryPattern(
+      _fbb,
+      location_index,
+      peak_size,
+      value_indices__,
+      offsets__,
+      sizes__);
+}
+
+struct ExecutionPlan FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef ExecutionPlanBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_EXECUTION_MODE = 4,
+    VT_EXECUTION_ORDER = 6,
+    VT_ENABLE_MEM_REUSE = 8,
+    VT_LOCATIONS = 10,
+    VT_ALLOCATION_PLAN = 12,
+    VT_INITIALIZER_ALLOCATION_ORDER = 14,
+    VT_ACTIVATION_ALLOCATION_ORDER = 16,
+    VT_NODE_EXECUTION_PLANS = 18,
+    VT_NODE_HAS_FENCE = 20,
+    VT_TO_BE_FREED = 22,
+    VT_MEMORY_PATTERNS = 24
+  };
+  int32_t execution_mode() const {
+    return GetField<int32_t>(VT_EXECUTION_MODE, 0);
+  }
+  int32_t execution_order() const {
+    return GetField<int32_t>(VT_EXECUTION_ORDER, 0);
+  }
+  bool enable_mem_reuse() const {
+    return GetField<uint8_t>(VT_ENABLE_MEM_REUSE, 0) != 0;
+  }
+  const flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::MemoryLocation>> *locations() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::MemoryLocation>> *>(VT_LOCATIONS);
+  }
+  const flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::ValueAllocationPlan>> *allocation_plan() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::ValueAllocationPlan>> *>(VT_ALLOCATION_PLAN);
+  }
+  const flatbuffers::Vector<int32_t> *initializer_allocation_order() const {
+    return GetPointer<const flatbuffers::Vector<int32_t> *>(VT_INITIALIZER_ALLOCATION_ORDER);
+  }
+  const flatbuffers::Vector<int32_t> *activation_allocation_order() const {
+    return GetPointer<const flatbuffers::Vector<int32_t> *>(VT_ACTIVATION_ALLOCATION_ORDER);
+  }
+  const flatbuffers::Vector<const onnxruntime::experimental::fbs::NodeExecutionPlan *> *node_execution_plans() const {
+    return GetPointer<const flatbuffers::Vector<const onnxruntime::experimental::fbs::NodeExecutionPlan *> *>(VT_NODE_EXECUTION_PLANS);
+  }
+  const flatbuffers::Vector<uint8_t> *node_has_fence() const {
+    return GetPointer<const flatbuffers::Vector<uint8_t> *>(VT_NODE_HAS_FENCE);
+  }
+  const flatbuffers::Vector<int32_t> *to_be_freed() const {
+    return GetPointer<const flatbuffers::Vector<int32_t> *>(VT_TO_BE_FREED);
+  }
+  const flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::MemoryPattern>> *memory_patterns() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::MemoryPattern>> *>(VT_MEMORY_PATTERNS);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<int32_t>(verifier, VT_EXECUTION_MODE) &&
+           VerifyField<int32_t>(verifier, VT_EXECUTION_ORDER) &&
+           VerifyField<uint8_t>(verifier, VT_ENABLE_MEM_REUSE) &&
+           VerifyOffset(verifier, VT_LOCATIONS) &&
+           verifier.VerifyVector(locations()) &&
+           verifier.VerifyVectorOfTables(locations()) &&
+           VerifyOffset(verifier, VT_ALLOCATION_PLAN) &&
+           verifier.VerifyVector(allocation_plan()) &&
+           verifier.VerifyVectorOfTables(allocation_plan()) &&
+           VerifyOffset(verifier, VT_INITIALIZER_ALLOCATION_ORDER) &&
+           verifier.VerifyVector(initializer_allocation_order()) &&
+           VerifyOffset(verifier, VT_ACTIVATION_ALLOCATION_ORDER) &&
+           verifier.VerifyVector(activation_allocation_order()) &&
+           VerifyOffset(verifier, VT_NODE_EXECUTION_PLANS) &&
+           verifier.VerifyVector(node_execution_plans()) &&
+           VerifyOffset(verifier, VT_NODE_HAS_FENCE) &&
+           verifier.VerifyVector(node_has_fence()) &&
+           VerifyOffset(verifier, VT_TO_BE_FREED) &&
+           verifier.VerifyVector(to_be_freed()) &&
+           VerifyOffset(verifier, VT_MEMORY_PATTERNS) &&
+           verifier.VerifyVector(memory_patterns()) &&
+           verifier.VerifyVectorOfTables(memory_patterns()) &&
+           verifier.EndTable();
+  }
+};
+
+struct ExecutionPlanBuilder {
+  typedef ExecutionPlan Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_execution_mode(int32_t execution_mode) {
+    fbb_.AddElement<int32_t>(ExecutionPlan::VT_EXECUTION_MODE, execution_mode, 0);
+  }
+  void add_execution_order(int32_t execution_order) {
+    fbb_.AddElement<int32_t>(ExecutionPlan::VT_EXECUTION_ORDER, execution_order, 0);
+  }
+  void add_enable_mem_reuse(bool enable_mem_reuse) {
+    fbb_.AddElement<uint8_t>(ExecutionPlan::VT_ENABLE_MEM_REUSE, static_cast<uint8_t>(enable_mem_reuse), 0);
+  }
+  void add_locations(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::MemoryLocation>>> locations) {
+    fbb_.AddOffset(ExecutionPlan::VT_LOCATIONS, locations);
+  }
+  void add_allocation_plan(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::ValueAllocationPlan>>> allocation_plan) {
+    fbb_.AddOffset(ExecutionPlan::VT_ALLOCATION_PLAN, allocation_plan);
+  }
+  void add_initializer_allocation_order(flatbuffers::Offset<flatbuffers::Vector<int32_t>> initializer_allocation_order) {
+    fbb_.AddOffset(ExecutionPlan::VT_INITIALIZER_ALLOCATION_ORDER, initializer_allocation_order);
+  }
+  void add_activation_allocation_order(flatbuffers::Offset<flatbuffers::Vector<int32_t>> activation_allocation_order) {
+    fbb_.AddOffset(ExecutionPlan::VT_ACTIVATION_ALLOCATION_ORDER, activation_allocation_order);
+  }
+  void add_node_execution_plans(flatbuffers::Offset<flatbuffers::Vector<const onnxruntime::experimental::fbs::NodeExecutionPlan *>> node_execution_plans) {
+    fbb_.AddOffset(ExecutionPlan::VT_NODE_EXECUTION_PLANS, node_execution_plans);
+  }
+  void add_node_has_fence(flatbuffers::Offset<flatbuffers::Vector<uint8_t>> node_has_fence) {
+    fbb_.AddOffset(ExecutionPlan::VT_NODE_HAS_FENCE, node_has_fence);
+  }
+  void add_to_be_freed(flatbuffers::Offset<flatbuffers::Vector<int32_t>> to_be_freed) {
+    fbb_.AddOffset(ExecutionPlan::VT_TO_BE_FREED, to_be_freed);
+  }
+  void add_memory_patterns(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::MemoryPattern>>> memory_patterns) {
+    fbb_.AddOffset(ExecutionPlan::VT_MEMORY_PATTERNS, memory_patterns);
+  }
+  explicit ExecutionPlanBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  ExecutionPlanBuilder &operator=(const ExecutionPlanBuilder &);
+  flatbuffers::Offset<ExecutionPlan> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<ExecutionPlan>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<ExecutionPlan> CreateExecutionPlan(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    int32_t execution_mode = 0,
+    int32_t execution_order = 0,
+    bool enable_mem_reuse = false,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::MemoryLocation>>> locations = 0,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::ValueAllocationPlan>>> allocation_plan = 0,
+    flatbuffers::Offset<flatbuffers::Vector<int32_t>> initializer_allocation_order = 0,
+    flatbuffers::Offset<flatbuffers::Vector<int32_t>> activation_allocation_order = 0,
+    flatbuffers::Offset<flatbuffers::Vector<const onnxruntime::experimental::fbs::NodeExecutionPlan *>> node_execution_plans = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint8_t>> node_has_fence = 0,
+    flatbuffers::Offset<flatbuffers::Vector<int32_t>> to_be_freed = 0,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::MemoryPattern>>> memory_patterns = 0) {
+  ExecutionPlanBuilder builder_(_fbb);
+  builder_.add_memory_patterns(memory_patterns);
+  builder_.add_to_be_freed(to_be_freed);
+  builder_.add_node_has_fence(node_has_fence);
+  builder_.add_node_execution_plans(node_execution_plans);
+  builder_.add_activation_allocation_order(activation_allocation_order);
+  builder_.add_initializer_allocation_order(initializer_allocation_order);
+  builder_.add_allocation_plan(allocation_plan);
+  builder_.add_locations(locations);
+  builder_.add_execution_order(execution_order);
+  builder_.add_execution_mode(execution_mode);
+  builder_.add_enable_mem_reuse(enable_mem_reuse);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<ExecutionPlan> CreateExecutionPlanDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    int32_t execution_mode = 0,
+    int32_t execution_order = 0,
+    bool enable_mem_reuse = false,
+    const std::vector<flatbuffers::Offset<onnxruntime::experimental::fbs::MemoryLocation>> *locations = nullptr,
+    const std::vector<flatbuffers::Offset<onnxruntime::experimental::fbs::ValueAllocationPlan>> *allocation_plan = nullptr,
+    const std::vector<int32_t> *initializer_allocation_order = nullptr,
+    const std::vector<int32_t> *activation_allocation_order = nullptr,
+    const std::vector<onnxruntime::experimental::fbs::NodeExecutionPlan> *node_execution_plans = nullptr,
+    const std::vector<uint8_t> *node_has_fence = nullptr,
+    const std::vector<int32_t> *to_be_freed = nullptr,
+    const std::vector<flatbuffers::Offset<onnxruntime::experimental::fbs::MemoryPattern>> *memory_patterns = nullptr) {
+  auto locations__ = locations ? _fbb.CreateVector<flatbuffers::Offset<onnxruntime::experimental::fbs::MemoryLocation>>(*locations) : 0;
+  auto allocation_plan__ = allocation_plan ? _fbb.CreateVector<flatbuffers::Offset<onnxruntime::experimental::fbs::ValueAllocationPlan>>(*allocation_plan) : 0;
+  auto initializer_allocation_order__ = initializer_allocation_order ? _fbb.CreateVector<int32_t>(*initializer_allocation_order) : 0;
+  auto activation_allocation_order__ = activation_allocation_order ? _fbb.CreateVector<int32_t>(*activation_allocation_order) : 0;
+  auto node_execution_plans__ = node_execution_plans ? _fbb.CreateVectorOfStructs<onnxruntime::experimental::fbs::NodeExecutionPlan>(*node_execution_plans) : 0;
+  auto node_has_fence__ = node_has_fence ? _fbb.CreateVector<uint8_t>(*node_has_fence) : 0;
+  auto to_be_freed__ = to_be_freed ? _fbb.CreateVector<int32_t>(*to_be_freed) : 0;
+  auto memory_patterns__ = memory_patterns ? _fbb.CreateVector<flatbuffers::Offset<onnxruntime::experimental::fbs::MemoryPattern>>(*memory_patterns) : 0;
+  return onnxruntime::experimental::fbs::CreateExecutionPlan(
+      _fbb,
+      execution_mode,
+      execution_order,
+      enable_mem_reuse,
+      locations__,
+      allocation_plan__,
+      initializer_allocation_order__,
+      activation_allocation_order__,
+      node_execution_plans__,
+      node_has_fence__,
+      to_be_freed__,
+      memory_patterns__);
+}
+
 struct SubGraphSessionState FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   typedef SubGraphSessionStateBuilder Builder;
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
@@ -2191,7 +2972,9 @@ struct SessionState FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   typedef SessionStateBuilder Builder;
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
     VT_KERNELS = 4,
-    VT_SUB_GRAPH_SESSION_STATES = 6
+    VT_SUB_GRAPH_SESSION_STATES = 6,
+    VT_PREPACKED_WEIGHTS = 8,
+    VT_EXECUTION_PLAN = 10
   };
   const onnxruntime::experimental::fbs::KernelCreateInfos *kernels() const {
     return GetPointer<const onnxruntime::experimental::fbs::KernelCreateInfos *>(VT_KERNELS);
@@ -2199,6 +2982,12 @@ struct SessionState FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   const flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::SubGraphSessionState>> *sub_graph_session_states() const {
     return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::SubGraphSessionState>> *>(VT_SUB_GRAPH_SESSION_STATES);
   }
+  const onnxruntime::experimental::fbs::PrePackedWeights *prepacked_weights() const {
+    return GetPointer<const onnxruntime::experimental::fbs::PrePackedWeights *>(VT_PREPACKED_WEIGHTS);
+  }
+  const onnxruntime::experimental::fbs::ExecutionPlan *execution_plan() const {
+    return GetPointer<const onnxruntime::experimental::fbs::ExecutionPlan *>(VT_EXECUTION_PLAN);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyOffset(verifier, VT_KERNELS) &&
@@ -2206,6 +2995,10 @@ struct SessionState FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            VerifyOffset(verifier, VT_SUB_GRAPH_SESSION_STATES) &&
            verifier.VerifyVector(sub_graph_session_states()) &&
            verifier.VerifyVectorOfTables(sub_graph_session_states()) &&
+           VerifyOffset(verifier, VT_PREPACKED_WEIGHTS) &&
+           verifier.VerifyTable(prepacked_weights()) &&
+           VerifyOffset(verifier, VT_EXECUTION_PLAN) &&
+           verifier.VerifyTable(execution_plan()) &&
            verifier.EndTable();
   }
 };
@@ -2220,6 +3013,12 @@ struct SessionStateBuilder {
   void add_sub_graph_session_states(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::SubGraphSessionState>>> sub_graph_session_states) {
     fbb_.AddOffset(SessionState::VT_SUB_GRAPH_SESSION_STATES, sub_graph_session_states);
   }
+  void add_prepacked_weights(flatbuffers::Offset<onnxruntime::experimental::fbs::PrePackedWeights> prepacked_weights) {
+    fbb_.AddOffset(SessionState::VT_PREPACKED_WEIGHTS, prepacked_weights);
+  }
+  void add_execution_plan(flatbuffers::Offset<onnxruntime::experimental::fbs::ExecutionPlan> execution_plan) {
+    fbb_.AddOffset(SessionState::VT_EXECUTION_PLAN, execution_plan);
+  }
   explicit SessionStateBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -2235,8 +3034,12 @@ struct SessionStateBuilder {
 inline flatbuffers::Offset<SessionState> CreateSessionState(
     flatbuffers::FlatBufferBuilder &_fbb,
     flatbuffers::Offset<onnxruntime::experimental::fbs::KernelCreateInfos> kernels = 0,
-    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::SubGraphSessionState>>> sub_graph_session_states = 0) {
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<onnxruntime::experimental::fbs::SubGraphSessionState>>> sub_graph_session_states = 0,
+    flatbuffers::Offset<onnxruntime::experimental::fbs::PrePackedWeights> prepacked_weights = 0,
+    flatbuffers::Offset<onnxruntime::experimental::fbs::ExecutionPlan> execution_plan = 0) {
   SessionStateBuilder builder_(_fbb);
+  builder_.add_execution_plan(execution_plan);
+  builder_.add_prepacked_weights(prepacked_weights);
   builder_.add_sub_graph_session_states(sub_graph_session_states);
   builder_.add_kernels(kernels);
   return builder_.Finish();
@@ -2245,12 +3048,16 @@ inline flatbuffers::Offset<SessionState> CreateSessionState(
 inline flatbuffers::Offset<SessionState> CreateSessionStateDirect(
     flatbuffers::FlatBufferBuilder &_fbb,
     flatbuffers::Offset<onnxruntime::experimental::fbs::KernelCreateInfos> kernels = 0,
-    std::vector<flatbuffers::Offset<onnxruntime::experimental::fbs::SubGraphSessionState>> *sub_graph_session_states = nullptr) {
+    std::vector<flatbuffers::Offset<onnxruntime::experimental::fbs::SubGraphSessionState>> *sub_graph_session_states = nullptr,
+    flatbuffers::Offset<onnxruntime::experimental::fbs::PrePackedWeights> prepacked_weights = 0,
+    flatbuffers::Offset<onnxruntime::experimental::fbs::ExecutionPlan> execution_plan = 0) {
   auto sub_graph_session_states__ = sub_graph_session_states ? _fbb.CreateVectorOfSortedTables<onnxruntime::experimental::fbs::SubGraphSessionState>(sub_graph_session_states) : 0;
   return onnxruntime::experimental::fbs::CreateSessionState(
       _fbb,
       kernels,
-      sub_graph_session_states__);
+      sub_graph_session_states__,
+      prepacked_weights,
+      execution_plan);
 }
 
 struct InferenceSession FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
@@ -3,7 +3,10 @@
 
 #include "core/framework/allocation_planner.h"
 #include <list>
+#include <limits>
+#include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include <algorithm>
 #include <sstream>
 #include "core/common/exceptions.h"
@@ -485,6 +488,150 @@ class PlannerImpl {
     return ci.kernel_def->HasExternalOutputs();
   }
 
+  // Estimates the size in bytes of the tensor of a node arg from its inferred shape. Symbolic and unknown dims
+  // count as 1, so tensors sharing a symbolic dim still compare as expected. Returns 0 if nothing is known.
+  size_t EstimateTensorSize(const onnxruntime::NodeArg& arg) const {
+    if (!arg.Exists() || arg.Type() == nullptr || !arg.TypeAsProto()->has_tensor_type()) return 0;
+    auto p_shape = context_.GetShape(arg);
+    if (nullptr == p_shape) return 0;
+
+    size_t size = GetElementSize(arg.Type());
+    for (const auto& dim : p_shape->dim()) {
+      if (dim.has_dim_value() && dim.dim_value() > 0) {
+        size *= static_cast<size_t>(dim.dim_value());
+      }
+    }
+    return size;
+  }
+
+  // Orders the nodes to keep the estimated size of the tensors alive at the same time small.
+  //
+  // This is a list scheduling of the nodes whose inputs are all produced: the next node is the one that grows the
+  // live tensors the least, counting its outputs as allocated and the inputs it is the last consumer of as freed.
+  // Graph outputs are never freed, so nodes producing them are run as late as possible unless they free memory.
+  // Ties are broken by the default topological order.
+  std::vector<NodeIndex> ComputeMemoryEfficientOrder() const {
+    const auto& default_order = graph_viewer_.GetNodesInTopologicalOrder(ExecutionOrder::DEFAULT);
+    const size_t max_node_index = static_cast<size_t>(graph_viewer_.MaxNodeIndex());
+    constexpr size_t kNotInGraph = std::numeric_limits<size_t>::max();
+
+    std::vector<size_t> default_position(max_node_index, kNotInGraph);
+    for (size_t i = 0; i < default_order.size(); ++i) {
+      default_position[default_order[i]] = i;
+    }
+
+    std::unordered_set<const onnxruntime::NodeArg*> graph_outputs(graph_viewer_.GetOutputs().cbegin(),
+                                                                   graph_viewer_.GetOutputs().cend());
+
+    auto distinct_inputs = [](const Node& node) {
+      std::vector<const onnxruntime::NodeArg*> inputs;
+      auto add_inputs = [&inputs](const ConstPointerContainer<std::vector<NodeArg*>>& defs) {
+        for (const auto* input : defs) {
+          if (input->Exists() && std::find(inputs.cbegin(), inputs.cend(), input) == inputs.cend()) {
+            inputs.push_back(input);
+          }
+        }
+      };
+      add_inputs(node.InputDefs());
+      add_inputs(node.ImplicitInputDefs());
+      return inputs;
+    };
+
+    // sizes and remaining consumers of the values produced by the nodes, which are freed after their last use.
+    // graph outputs are left out as they're never freed.
+    std::unordered_map<const onnxruntime::NodeArg*, size_t> value_sizes;
+    std::unordered_map<const onnxruntime::NodeArg*, int> remaining_uses;
+    std::vector<size_t> pending_inputs(max_node_index, 0);
+    std::vector<NodeIndex> ready;
+
+    for (NodeIndex index : default_order) {
+      const Node& node = *graph_viewer_.GetNode(index);
+      for (const auto* output : node.OutputDefs()) {
+        if (output->Exists() && graph_outputs.count(output) == 0) {
+          value_sizes[output] = EstimateTensorSize(*output);
+        }
+      }
+
+      for (auto it = node.InputEdgesBegin(), end = node.InputEdgesEnd(); it != end; ++it) {
+        if (default_position[it->GetNode().Index()] != kNotInGraph) {
+          ++pending_inputs[index];
+        }
+      }
+
+      if (pending_inputs[index] == 0) {
+        ready.push_back(index);
+      }
+    }
+
+    for (NodeIndex index : default_order) {
+      for (const auto* input : distinct_inputs(*graph_viewer_.GetNode(index))) {
+        if (value_sizes.count(input) != 0) {
+          ++remaining_uses[input];
+        }
+      }
+    }
+
+    std::vector<NodeIndex> order;
+    order.reserve(default_order.size());
+
+    while (!ready.empty()) {
+      size_t best = 0;
+      std::tuple<bool, int64_t, size_t> best_key;
+
+      for (size_t i = 0; i < ready.size(); ++i) {
+        const Node& node = *graph_viewer_.GetNode(ready[i]);
+        int64_t delta = 0;
+        bool produces_graph_output = false;
+
+        for (const auto* output : node.OutputDefs()) {
+          if (!output->Exists()) continue;
+          if (graph_outputs.count(output) != 0) {
+            produces_graph_output = true;
+            delta += static_cast<int64_t>(EstimateTensorSize(*output));
+          } else {
+            delta += static_cast<int64_t>(value_sizes[output]);
+          }
+        }
+
+        for (const auto* input : distinct_inputs(node)) {
+          auto uses = remaining_uses.find(input);
+          if (uses != remaining_uses.end() && uses->second == 1) {
+            delta -= static_cast<int64_t>(value_sizes[input]);
+          }
+        }
+
+        auto key = std::make_tuple(produces_graph_output && delta >= 0, delta, default_position[ready[i]]);
+        if (i == 0 || key < best_key) {
+          best = i;
+          best_key = key;
+        }
+      }
+
+      const NodeIndex index = ready[best];
+      ready[best] = ready.back();
+      ready.pop_back();
+      order.push_back(index);
+
+      const Node& node = *graph_viewer_.GetNode(index);
+      for (const auto* input : distinct_inputs(node)) {
+        auto uses = remaining_uses.find(input);
+        if (uses != remaining_uses.end()) {
+          --uses->second;
+        }
+      }
+
+      for (auto it = node.OutputEdgesBegin(), end = node.OutputEdgesEnd(); it != end; ++it) {
+        const NodeIndex consumer = it->GetNode().Index();
+        if (default_position[consumer] != kNotInGraph && --pending_inputs[consumer] == 0) {
+          ready.push_back(consumer);
+        }
+      }
+    }
+
+    ORT_ENFORCE(order.size() == default_order.size(), "Failed to order all the nodes of the graph.");
+    return order;
+  }
+
   Status ComputeUseCounts() {
     // Note: for every ml-value, its definition must appear before all its uses in a topological sort of a valid model
     std::unordered_set<std::string> graph_inputs;
@@ -1161,14 +1308,20 @@ class PlannerImpl {
 };
 
 Status PlannerImpl::CreatePlan() {
-  auto& p_graph_nodes = graph_viewer_.GetNodesInTopologicalOrder(context_.GetExecutionOrder());
+  std::vector<NodeIndex> memory_efficient_order;
+  if (context_.GetExecutionOrder() == ExecutionOrder::MEMORY_EFFICIENT) {
+    memory_efficient_order = ComputeMemoryEfficientOrder();
+  }
+
+  auto& p_graph_nodes = context_.GetExecutionOrder() == ExecutionOrder::MEMORY_EFFICIENT
+                            ? memory_efficient_order
+                            : graph_viewer_.GetNodesInTopologicalOrder(context_.GetExecutionOrder());
 
   int num_ml_values = ort_value_name_idx_map_.MaxIdx() + 1;
 
   Initialize(p_graph_nodes.size(), static_cast<size_t>(num_ml_values));
 
-  // Determine execution order: we use the default topological sort order for now. We can later
-  // explore more efficient orderings (from a memory usage perspective).
+  // Determine execution order: the topological sort order requested by the execution order setting.
   for (auto n : p_graph_nodes) {
     plan_.execution_plan.emplace_back(n);
   }
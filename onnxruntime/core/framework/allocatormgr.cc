@@ -4,6 +4,7 @@
 #include "core/framework/allocatormgr.h"
 #include "core/framework/bfc_arena.h"
 #include "core/framework/mimalloc_allocator.h"
+#include "core/framework/page_allocator.h"
 #include "core/common/logging/logging.h"
 #include <mutex>
 #include <sstream>
@@ -24,6 +25,19 @@ AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info) {
   auto device_allocator = std::unique_ptr<IAllocator>(info.device_alloc_factory(info.device_id));
 
   if (info.use_arena) {
+    bool use_huge_pages = info.arena_cfg.use_huge_pages == -1 ? false : info.arena_cfg.use_huge_pages != 0;
+    int numa_node = info.arena_cfg.numa_node;
+    if (use_huge_pages || numa_node >= 0) {
+      // the arena regions are mapped from the OS instead of obtained from the device allocator.
+      const auto& memory_info = device_allocator->Info();
+      if (memory_info.device.Type() == OrtDevice::CPU && memory_info.device.MemType() == OrtDevice::MemType::DEFAULT) {
+        device_allocator = std::make_unique<PageAllocator>(memory_info, use_huge_pages, numa_node);
+      } else {
+        LOGS_DEFAULT(WARNING) << "Huge pages and NUMA binding are only supported by CPU arenas. Ignoring them for "
+                              << memory_info.ToString();
+      }
+    }
+
     size_t max_mem = info.arena_cfg.max_mem == 0 ? BFCArena::DEFAULT_MAX_MEM : info.arena_cfg.max_mem;
     int initial_chunk_size_bytes = info.arena_cfg.initial_chunk_size_bytes == -1
                                        ? BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES
@@ -34,6 +48,9 @@ AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info) {
     int initial_growth_chunk_size_bytes = info.arena_cfg.initial_growth_chunk_size_bytes == -1
                                               ? BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES
                                               : info.arena_cfg.initial_growth_chunk_size_bytes;
+    int thread_cache_max_chunks_per_bin = info.arena_cfg.thread_cache_max_chunks_per_bin == -1
+                                              ? BFCArena::DEFAULT_THREAD_CACHE_MAX_CHUNKS_PER_BIN
+                                              : info.arena_cfg.thread_cache_max_chunks_per_bin;
     ArenaExtendStrategy arena_extend_str;
     switch (info.arena_cfg.arena_extend_strategy) {
       case static_cast<int>(ArenaExtendStrategy::kSameAsRequested):
@@ -58,7 +75,8 @@ AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info) {
                                    arena_extend_str,
                                    initial_chunk_size_bytes,
                                    max_dead_bytes_per_chunk,
-                                   initial_growth_chunk_size_bytes));
+                                   initial_growth_chunk_size_bytes,
+                                   thread_cache_max_chunks_per_bin));
 #endif
   }
 
@@ -3,15 +3,31 @@
 
 #include "core/framework/allocator.h"
 #include "core/framework/bfc_arena.h"
+#include <algorithm>
 #include <type_traits>
 
 namespace onnxruntime {
+namespace {
+// Arena ids are never reused so that a thread cache of a destroyed arena is
+// never mistaken for the cache of a new arena.
+std::atomic<int64_t> next_arena_id{0};
+
+// Orders the destruction of an arena and the exit of the threads owning its
+// caches, which are the only times a cache is accessed by both. It's never
+// destroyed, as threads may exit after static destructors have run.
+OrtMutex& ThreadCacheLifetimeMutex() {
+  static OrtMutex* mutex = new OrtMutex();
+  return *mutex;
+}
+}  // namespace
+
 BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
                    size_t total_memory,
                    ArenaExtendStrategy arena_extend_strategy,
                    int initial_chunk_size_bytes,
                    int max_dead_bytes_per_chunk,
-                   int initial_growth_chunk_size_bytes)
+                   int initial_growth_chunk_size_bytes,
+                   int thread_cache_max_chunks_per_bin)
     : IAllocator(OrtMemoryInfo(resource_allocator->Info().name,
                                OrtAllocatorType::OrtArenaAllocator,
                                resource_allocator->Info().device,
@@ -22,13 +38,16 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
       next_allocation_id_(1),
       initial_chunk_size_bytes_(initial_chunk_size_bytes),
       max_dead_bytes_per_chunk_(max_dead_bytes_per_chunk),
-      initial_growth_chunk_size_bytes_(initial_growth_chunk_size_bytes) {
+      initial_growth_chunk_size_bytes_(initial_growth_chunk_size_bytes),
+      thread_cache_max_chunks_per_bin_(thread_cache_max_chunks_per_bin),
+      arena_id_(next_arena_id++) {
   LOGS_DEFAULT(INFO) << "Creating BFCArena for " << device_allocator_->Info().name
                      << " with following configs: initial_chunk_size_bytes: " << initial_chunk_size_bytes_
                      << " max_dead_bytes_per_chunk: " << max_dead_bytes_per_chunk_
                      << " initial_growth_chunk_size_bytes: " << initial_growth_chunk_size_bytes_
                      << " memory limit: " << total_memory
-                     << " arena_extend_strategy: " << static_cast<int32_t>(arena_extend_strategy);
+                     << " arena_extend_strategy: " << static_cast<int32_t>(arena_extend_strategy)
+                     << " thread_cache_max_chunks_per_bin: " << thread_cache_max_chunks_per_bin_;
 
   // static_cast<std::underlying_type_t<ArenaExtendStrategy>>(arena_extend_strategy); doesn't work on this compiler
 
@@ -74,6 +93,25 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
 }
 
 BFCArena::~BFCArena() {
+  // The caches may outlive the arena in the thread local maps of their threads.
+  {
+    std::lock_guard<OrtMutex> lifetime_lock(ThreadCacheLifetimeMutex());
+    for (const auto& cache : thread_caches_) {
+      cache->arena_destroyed = true;
+      std::vector<CachedChunk*> chunks;
+      TakeThreadCacheFreeChunks(cache.get(), chunks);
+      for (const auto& entry : cache->allocated) {
+        chunks.push_back(entry.second);
+      }
+      cache->allocated.clear();
+      // Chunks freed by other threads are still in the allocated map too.
+      cache->remote_frees.store(nullptr);
+      for (CachedChunk* chunk : chunks) {
+        delete chunk;
+      }
+    }
+  }
+
   for (const auto& region : region_manager_.regions()) {
     device_allocator_->Free(region.ptr());
   }
@@ -272,6 +310,11 @@ size_t BFCArena::RequestedSize(const void* ptr) {
   BFCArena::ChunkHandle h = region_manager_.get_handle(ptr);
   ORT_ENFORCE(h != kInvalidChunkHandle);
   BFCArena::Chunk* c = ChunkFromHandle(h);
+  if (c->cached != nullptr) {
+    // The chunk may have been handed out again by its cache without updating
+    // the chunk.
+    return c->cached->requested_size.load(std::memory_order_relaxed);
+  }
   return c->requested_size;
 }
 
@@ -297,10 +340,38 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
   // The BFC allocator tries to find the best fit first.
   BinNum bin_num = BinNumForSize(rounded_bytes);
 
+  ThreadCache* cache = nullptr;
+  if (thread_cache_max_chunks_per_bin_ > 0 && bin_num < kNumThreadCacheBins) {
+    cache = GetThreadCache(true);
+    void* ptr = AllocateFromThreadCache(cache, bin_num, rounded_bytes, num_bytes);
+    if (ptr != nullptr) {
+      return ptr;
+    }
+  }
+
+  // Chunks allocated from the bins for a cacheable size are handed out
+  // through the cache of the calling thread, which later takes them back
+  // when they are freed.
+  auto hand_out = [this, cache, num_bytes](void* chunk_ptr) {
+    if (cache != nullptr) {
+      ChunkHandle h = region_manager_.get_handle(chunk_ptr);
+      Chunk* c = ChunkFromHandle(h);
+      c->cached = new CachedChunk(chunk_ptr, h, c->size, num_bytes, cache);
+      cache->allocated.emplace(chunk_ptr, c->cached);
+    }
+    return chunk_ptr;
+  };
+
   std::lock_guard<OrtMutex> lock(lock_);
   void* ptr = FindChunkPtr(bin_num, rounded_bytes, num_bytes);
+  if (ptr == nullptr && !thread_caches_.empty()) {
+    // Reclaim the chunks held free in thread caches before growing the arena.
+    // Only the calling thread's cache can be flushed right away.
+    FlushThreadCaches();
+    ptr = FindChunkPtr(bin_num, rounded_bytes, num_bytes);
+  }
   if (ptr != nullptr) {
-    return ptr;
+    return hand_out(ptr);
   }
 
   LOGS_DEFAULT(INFO) << "Extending BFCArena for " << device_allocator_->Info().name
@@ -311,7 +382,7 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
   if (status.IsOK()) {
     ptr = FindChunkPtr(bin_num, rounded_bytes, num_bytes);
     if (ptr != nullptr) {
-      return ptr;
+      return hand_out(ptr);
     } else {
       status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
                                "Failed to find a free memory block despite calling Extend. rounded_bytes=",
@@ -334,6 +405,230 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
 void BFCArena::GetStats(AllocatorStats* stats) {
   std::lock_guard<OrtMutex> lock(lock_);
   *stats = stats_;
+  for (const auto& cache : thread_caches_) {
+    stats->num_thread_cache_hits += cache->num_hits.load(std::memory_order_relaxed);
+    stats->num_thread_cache_misses += cache->num_misses.load(std::memory_order_relaxed);
+    stats->bytes_in_thread_caches += cache->bytes_free.load(std::memory_order_relaxed);
+  }
+  // Allocations served by the thread caches do not go through the bins.
+  stats->num_allocs += stats->num_thread_cache_hits;
+}
+
+BFCArena::ThreadCache* BFCArena::GetThreadCache(bool create) {
+  // The caches of the calling thread keyed by arena id. A cache is shared with
+  // its arena, which reclaims the chunks of the cache once the thread exits.
+  struct ThreadCacheMap {
+    std::unordered_map<int64_t, std::shared_ptr<ThreadCache>> caches;
+
+    ~ThreadCacheMap() {
+      std::lock_guard<OrtMutex> lifetime_lock(ThreadCacheLifetimeMutex());
+      for (auto& entry : caches) {
+        ThreadCache* cache = entry.second.get();
+        if (!cache->arena_destroyed) {
+          cache->arena->ReleaseThreadCache(cache);
+        }
+      }
+    }
+  };
+  static thread_local ThreadCacheMap thread_cache_map;
+
+  auto& caches = thread_cache_map.caches;
+  auto it = caches.find(arena_id_);
+  if (it != caches.end()) {
+    return it->second.get();
+  }
+
+  if (!create) {
+    return nullptr;
+  }
+
+  std::lock_guard<OrtMutex> lifetime_lock(ThreadCacheLifetimeMutex());
+
+  // Drop the caches of destroyed arenas.
+  for (auto cur = caches.begin(); cur != caches.end();) {
+    cur = cur->second->arena_destroyed ? caches.erase(cur) : std::next(cur);
+  }
+
+  auto cache = std::make_shared<ThreadCache>(this);
+  {
+    std::lock_guard<OrtMutex> lock(lock_);
+    thread_caches_.push_back(cache);
+  }
+  return caches.emplace(arena_id_, std::move(cache)).first->second.get();
+}
+
+void* BFCArena::AllocateFromThreadCache(ThreadCache* cache, BinNum bin_num, size_t rounded_bytes,
+                                        size_t num_bytes) {
+  HandleThreadCacheRequests(cache);
+
+  auto& free_chunks = cache->free_chunks[bin_num];
+
+  // Prefer the most recently freed chunk, which is most likely still in the
+  // CPU caches. Any chunk of the bin is less than twice the size of the
+  // request, so the arena would not split it either.
+  for (auto it = free_chunks.rbegin(); it != free_chunks.rend(); ++it) {
+    CachedChunk* chunk = *it;
+    if (chunk->size >= rounded_bytes &&
+        static_cast<int64_t>(chunk->size) - static_cast<int64_t>(rounded_bytes) < max_dead_bytes_per_chunk_) {
+      chunk->requested_size.store(num_bytes, std::memory_order_relaxed);
+      cache->allocated.emplace(chunk->ptr, chunk);
+      free_chunks.erase(std::next(it).base());
+      cache->bytes_free.fetch_sub(chunk->size, std::memory_order_relaxed);
+      cache->num_hits.fetch_add(1, std::memory_order_relaxed);
+      return chunk->ptr;
+    }
+  }
+
+  cache->num_misses.fetch_add(1, std::memory_order_relaxed);
+  return nullptr;
+}
+
+bool BFCArena::FreeToThreadCache(void* ptr) {
+  ThreadCache* cache = GetThreadCache(false);
+  if (cache == nullptr) {
+    return false;
+  }
+
+  auto it = cache->allocated.find(ptr);
+  if (it == cache->allocated.end()) {
+    return false;
+  }
+
+  std::vector<CachedChunk*> chunks_to_return;
+  CacheFreedChunk(cache, it->second, chunks_to_return);
+  if (!chunks_to_return.empty()) {
+    std::lock_guard<OrtMutex> lock(lock_);
+    ReturnThreadCacheChunks(chunks_to_return);
+  }
+
+  HandleThreadCacheRequests(cache);
+  return true;
+}
+
+void BFCArena::CacheFreedChunk(ThreadCache* cache, CachedChunk* chunk, std::vector<CachedChunk*>& chunks_to_return) {
+  cache->allocated.erase(chunk->ptr);
+
+  BinNum bin_num = BinNumForSize(chunk->size);
+  if (bin_num >= kNumThreadCacheBins) {
+    // The chunk is larger than the request and too large to be cached.
+    chunks_to_return.push_back(chunk);
+    return;
+  }
+
+  auto& free_chunks = cache->free_chunks[bin_num];
+  free_chunks.push_back(chunk);
+  cache->bytes_free.fetch_add(chunk->size, std::memory_order_relaxed);
+
+  if (++cache->num_frees_since_flush >= kThreadCacheFlushInterval) {
+    // Periodically return all free chunks so that they can be coalesced.
+    TakeThreadCacheFreeChunks(cache, chunks_to_return);
+  } else if (free_chunks.size() > static_cast<size_t>(thread_cache_max_chunks_per_bin_)) {
+    // Return the least recently freed half of the bin.
+    auto end = free_chunks.begin() + (free_chunks.size() + 1) / 2;
+    for (auto it = free_chunks.begin(); it != end; ++it) {
+      cache->bytes_free.fetch_sub((*it)->size, std::memory_order_relaxed);
+    }
+    chunks_to_return.insert(chunks_to_return.end(), free_chunks.begin(), end);
+    free_chunks.erase(free_chunks.begin(), end);
+  }
+}
+
+void BFCArena::HandleThreadCacheRequests(ThreadCache* cache) {
+  std::vector<CachedChunk*> chunks_to_return;
+
+  if (cache->remote_frees.load(std::memory_order_relaxed) != nullptr) {
+    CachedChunk* chunk = cache->remote_frees.exchange(nullptr, std::memory_order_acquire);
+    while (chunk != nullptr) {
+      CachedChunk* next = chunk->next_remote_free;
+      CacheFreedChunk(cache, chunk, chunks_to_return);
+      chunk = next;
+    }
+  }
+
+  if (cache->flush_requested.load(std::memory_order_relaxed) &&
+      cache->flush_requested.exchange(false, std::memory_order_relaxed)) {
+    TakeThreadCacheFreeChunks(cache, chunks_to_return);
+  }
+
+  if (!chunks_to_return.empty()) {
+    std::lock_guard<OrtMutex> lock(lock_);
+    ReturnThreadCacheChunks(chunks_to_return);
+  }
+}
+
+void BFCArena::TakeThreadCacheFreeChunks(ThreadCache* cache, std::vector<CachedChunk*>& chunks_to_return) {
+  for (auto& bin_chunks : cache->free_chunks) {
+    chunks_to_return.insert(chunks_to_return.end(), bin_chunks.begin(), bin_chunks.end());
+    bin_chunks.clear();
+  }
+  cache->bytes_free.store(0, std::memory_order_relaxed);
+  cache->num_frees_since_flush = 0;
+}
+
+void BFCArena::ReturnThreadCacheChunks(const std::vector<CachedChunk*>& chunks) {
+  for (CachedChunk* chunk : chunks) {
+    Chunk* c = ChunkFromHandle(chunk->handle);
+    ORT_ENFORCE(c->ptr == chunk->ptr && c->cached == chunk);
+    c->cached = nullptr;
+    FreeAndMaybeCoalesce(chunk->handle);
+    delete chunk;
+  }
+}
+
+void BFCArena::FlushThreadCaches() {
+  ThreadCache* own_cache = GetThreadCache(false);
+
+  std::vector<CachedChunk*> chunks_to_return;
+  if (own_cache != nullptr) {
+    CachedChunk* chunk = own_cache->remote_frees.exchange(nullptr, std::memory_order_acquire);
+    while (chunk != nullptr) {
+      CachedChunk* next = chunk->next_remote_free;
+      own_cache->allocated.erase(chunk->ptr);
+      chunks_to_return.push_back(chunk);
+      chunk = next;
+    }
+    TakeThreadCacheFreeChunks(own_cache, chunks_to_return);
+    own_cache->flush_requested.store(false, std::memory_order_relaxed);
+  }
+
+  for (const auto& cache : thread_caches_) {
+    if (cache.get() != own_cache) {
+      cache->flush_requested.store(true, std::memory_order_relaxed);
+    }
+  }
+
+  ReturnThreadCacheChunks(chunks_to_return);
+}
+
+void BFCArena::ReleaseThreadCache(ThreadCache* cache) {
+  std::lock_guard<OrtMutex> lock(lock_);
+
+  // Chunks are only pushed onto the remote frees under the arena lock, so
+  // none can be added from here on.
+  std::vector<CachedChunk*> chunks_to_return;
+  CachedChunk* chunk = cache->remote_frees.exchange(nullptr, std::memory_order_acquire);
+  while (chunk != nullptr) {
+    CachedChunk* next = chunk->next_remote_free;
+    cache->allocated.erase(chunk->ptr);
+    chunks_to_return.push_back(chunk);
+    chunk = next;
+  }
+  TakeThreadCacheFreeChunks(cache, chunks_to_return);
+  ReturnThreadCacheChunks(chunks_to_return);
+
+  for (const auto& entry : cache->allocated) {
+    Chunk* c = ChunkFromHandle(entry.second->handle);
+    c->requested_size = entry.second->requested_size.load(std::memory_order_relaxed);
+    c->cached = nullptr;
+    delete entry.second;
+  }
+  cache->allocated.clear();
+
+  stats_.num_thread_cache_hits += cache->num_hits.load(std::memory_order_relaxed);
+  stats_.num_thread_cache_misses += cache->num_misses.load(std::memory_order_relaxed);
+
+  thread_caches_.erase(std::find_if(thread_caches_.begin(), thread_caches_.end(),
+                                    [cache](const std::shared_ptr<ThreadCache>& c) { return c.get() == cache; }));
 }
 
 void* BFCArena::FindChunkPtr(BinNum bin_num, size_t rounded_bytes,
@@ -421,6 +716,9 @@ void BFCArena::Free(void* p) {
   if (p == nullptr) {
     return;
   }
+  if (thread_cache_max_chunks_per_bin_ > 0 && FreeToThreadCache(p)) {
+    return;
+  }
   std::lock_guard<OrtMutex> lock(lock_);
   auto it = reserved_chunks_.find(p);
   if (it != reserved_chunks_.end()) {
@@ -435,6 +733,8 @@ void BFCArena::Free(void* p) {
 
 Status BFCArena::Shrink() {
   std::lock_guard<OrtMutex> lock(lock_);
+  FlushThreadCaches();
+
   auto num_regions = region_manager_.regions().size();
   std::vector<void*> region_ptrs;
   std::vector<size_t> region_sizes;
@@ -502,6 +802,19 @@ void BFCArena::DeallocateRawInternal(void* ptr) {
   BFCArena::ChunkHandle h = region_manager_.get_handle(ptr);
   ORT_ENFORCE(h != kInvalidChunkHandle);
 
+  Chunk* c = ChunkFromHandle(h);
+  if (c->cached != nullptr) {
+    // The chunk was handed out through the cache of another thread, which
+    // takes it back on its next allocation or free.
+    CachedChunk* chunk = c->cached;
+    ThreadCache* cache = chunk->cache;
+    chunk->next_remote_free = cache->remote_frees.load(std::memory_order_relaxed);
+    while (!cache->remote_frees.compare_exchange_weak(chunk->next_remote_free, chunk, std::memory_order_release,
+                                                      std::memory_order_relaxed)) {
+    }
+    return;
+  }
+
   // Consider coalescing it.
   FreeAndMaybeCoalesce(h);
 }
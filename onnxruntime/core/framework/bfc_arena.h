@@ -17,8 +17,11 @@ limitations under the License.
 #pragma once
 #include <array>
 #include <memory>
+#include <atomic>
 #include <mutex>
 #include <sstream>
+#include <unordered_map>
+#include <vector>
 
 #include "onnxruntime_config.h"
 
@@ -57,13 +60,20 @@ class BFCArena : public IAllocator {
   static const int DEFAULT_MAX_DEAD_BYTES_PER_CHUNK = 128 * 1024 * 1024;
   static const int DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES = 2 * 1024 * 1024;
   static const size_t DEFAULT_MAX_MEM = std::numeric_limits<size_t>::max();
+  // Thread caches are disabled by default.
+  static const int DEFAULT_THREAD_CACHE_MAX_CHUNKS_PER_BIN = 0;
 
+  // If thread_cache_max_chunks_per_bin is greater than zero, every thread
+  // allocating from the arena keeps up to that many freed chunks of each small
+  // bin in a private cache, so that repeated allocations of similar sizes from
+  // many concurrent threads do not serialize on the arena lock.
   BFCArena(std::unique_ptr<IAllocator> resource_allocator,
            size_t total_memory,
            ArenaExtendStrategy arena_extend_strategy = DEFAULT_ARENA_EXTEND_STRATEGY,
            int initial_chunk_size_bytes = DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
            int max_dead_bytes_per_chunk = DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
-           int initial_growth_chunk_size_bytes = DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES);
+           int initial_growth_chunk_size_bytes = DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
+           int thread_cache_max_chunks_per_bin = DEFAULT_THREAD_CACHE_MAX_CHUNKS_PER_BIN);
 
   ~BFCArena() override;
 
@@ -76,6 +86,8 @@ class BFCArena : public IAllocator {
   void Free(void* p) override;
 
   // Frees all allocation regions in which no chunk is in use.
+  // The free chunks of the calling thread's cache are returned to the arena
+  // first. Other threads return theirs on their next allocation or free.
   // Does not free any reserved chunks.
   // Resets the size that the arena will grow by in the next allocation to
   // `initial_growth_chunk_size_bytes_` but ultimately all
@@ -109,6 +121,17 @@ class BFCArena : public IAllocator {
   static const int kInvalidBinNum = -1;
   static const int kNumBins = 21;
 
+  // Only chunks of the bins below this one (chunks smaller than 1MB) are
+  // kept in thread caches.
+  static const int kNumThreadCacheBins = 12;
+
+  // A thread cache returns all of its free chunks to the arena after this
+  // many frees, so that idle chunks can be coalesced again.
+  static const size_t kThreadCacheFlushInterval = 1024;
+
+  struct ThreadCache;
+  struct CachedChunk;
+
   // Chunks point to memory.  Their prev/next pointers form a
   // doubly-linked list of addresses sorted by base address that
   // must be contiguous.  Chunks contain information about whether
@@ -143,6 +166,11 @@ class BFCArena : public IAllocator {
     // What bin are we in?
     BinNum bin_num = kInvalidBinNum;
 
+    // If not nullptr, the chunk was handed out through a thread cache and
+    // stays in use from the point of view of the arena until the cache
+    // returns it.
+    CachedChunk* cached = nullptr;
+
     bool in_use() const { return allocation_id != -1; }
 
     std::string DebugString(BFCArena* a, bool recurse) {
@@ -193,6 +221,84 @@ class BFCArena : public IAllocator {
         : bin_size(bs), free_chunks(ChunkComparator(allocator)) {}
   };
 
+  // A chunk owned by a thread cache. It is created when the chunk is taken
+  // from the bins and deleted when the chunk is returned to them.
+  struct CachedChunk {
+    CachedChunk(void* p, ChunkHandle h, size_t s, size_t requested, ThreadCache* c)
+        : ptr(p), handle(h), size(s), requested_size(requested), cache(c) {}
+
+    void* const ptr;
+    const ChunkHandle handle;
+    const size_t size;
+    // Written by the owning thread without the arena lock when the chunk is
+    // handed out again, and read by RequestedSize() on any thread.
+    std::atomic<size_t> requested_size;
+    ThreadCache* const cache;
+    // The next chunk in the remote frees of the cache.
+    CachedChunk* next_remote_free = nullptr;
+  };
+
+  // A per-thread cache of chunks of the small bins. The chunks owned by a
+  // cache are either allocated by the client (allocated) or free and ready to
+  // be handed out again (free_chunks). Both are only accessed by the owning
+  // thread, so cache hits and frees by the owning thread take no lock. Other
+  // threads only push the chunks they free onto remote_frees and set
+  // flush_requested, both of which the owning thread handles on its next
+  // allocation or free. The arena lock is taken when chunks move between the
+  // cache and the bins.
+  struct ThreadCache {
+    explicit ThreadCache(BFCArena* a) : arena(a) {}
+
+    BFCArena* const arena;
+    std::array<std::vector<CachedChunk*>, kNumThreadCacheBins> free_chunks;
+    std::unordered_map<void*, CachedChunk*> allocated;
+    size_t num_frees_since_flush = 0;
+    // A lock-free stack of chunks freed by other threads.
+    std::atomic<CachedChunk*> remote_frees{nullptr};
+    // Set by other threads to have the free chunks returned to the bins.
+    std::atomic<bool> flush_requested{false};
+    // Statistics, written by the owning thread and read by GetStats().
+    std::atomic<int64_t> num_hits{0};
+    std::atomic<int64_t> num_misses{0};
+    std::atomic<int64_t> bytes_free{0};
+    // Set when the arena is destroyed. Guarded by the thread cache lifetime
+    // mutex, which orders the destruction of the arena and the exit of the
+    // owning thread.
+    bool arena_destroyed = false;
+  };
+
+  // Returns the cache of the calling thread, creating it if `create` is true.
+  ThreadCache* GetThreadCache(bool create);
+
+  // Tries to hand out a free chunk of the calling thread's cache.
+  void* AllocateFromThreadCache(ThreadCache* cache, BinNum bin_num, size_t rounded_bytes, size_t num_bytes);
+
+  // Tries to free a chunk that was handed out through the calling thread's
+  // cache. Returns false if the chunk is not owned by the cache.
+  bool FreeToThreadCache(void* ptr);
+
+  // Adds a chunk freed by the client to the free chunks of the calling
+  // thread's cache, or to `chunks_to_return` if it should go back to the bins.
+  void CacheFreedChunk(ThreadCache* cache, CachedChunk* chunk, std::vector<CachedChunk*>& chunks_to_return);
+
+  // Handles the chunks freed by other threads and the flush requests of the
+  // calling thread's cache.
+  void HandleThreadCacheRequests(ThreadCache* cache);
+
+  // Moves all free chunks of the calling thread's cache to `chunks_to_return`.
+  static void TakeThreadCacheFreeChunks(ThreadCache* cache, std::vector<CachedChunk*>& chunks_to_return);
+
+  // Returns chunks taken out of a thread cache to the bins.
+  void ReturnThreadCacheChunks(const std::vector<CachedChunk*>& chunks);
+
+  // Returns the free chunks of the calling thread's cache to the bins and asks
+  // the other threads to return theirs.
+  void FlushThreadCaches();
+
+  // Returns the chunks of the cache of an exiting thread to the bins. Chunks
+  // still allocated by the client become regular in-use chunks.
+  void ReleaseThreadCache(ThreadCache* cache);
+
   static const size_t kMinAllocationBits = 8;
   static const size_t kMinAllocationSize = 1 << kMinAllocationBits;
 
@@ -468,6 +574,14 @@ class BFCArena : public IAllocator {
   const int initial_chunk_size_bytes_;
   const int max_dead_bytes_per_chunk_;
   const int initial_growth_chunk_size_bytes_;
+  const int thread_cache_max_chunks_per_bin_;
+
+  // A unique identifier of the arena which is never reused, used as the key
+  // of the thread local cache map.
+  const int64_t arena_id_;
+
+  // The thread caches created for this arena.
+  std::vector<std::shared_ptr<ThreadCache>> thread_caches_;
 
   // This flag is only relevant if Shrink() is invoked.
   // This is a boolean flag that controls whether the first allocation region
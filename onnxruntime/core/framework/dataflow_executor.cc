@@ -0,0 +1,314 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/dataflow_executor.h"
+
+#include <memory>
+#include <sstream>
+#include <vector>
+#include "core/common/common.h"
+#include "core/common/logging/logging.h"
+#include "core/framework/allocation_planner.h"
+#include "core/framework/execution_frame.h"
+#include "core/framework/session_state.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/framework/utils.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+
+DataflowExecutor::DataflowExecutor(const SessionState& session_state, const bool& terminate_flag)
+    : pending_inputs_(session_state.GetGraphViewer().MaxNodeIndex()),
+      terminate_flag_(terminate_flag),
+      thread_pool_(session_state.GetThreadPool()) {
+  for (const auto& node : session_state.GetGraphViewer().Nodes()) {
+    pending_inputs_[node.Index()].store(node.GetInputEdgesCount(), std::memory_order_relaxed);
+  }
+}
+
+Status DataflowExecutor::Execute(const SessionState& session_state, const std::vector<int>& feed_mlvalue_idxs,
+                                 const std::vector<OrtValue>& feeds, const std::vector<int>& fetch_mlvalue_idxs,
+                                 std::vector<OrtValue>& fetches,
+                                 const std::unordered_map<size_t, CustomAllocator>& fetch_allocators,
+                                 const logging::Logger& logger) {
+  TimePoint tp;
+  const bool is_profiler_enabled = session_state.Profiler().IsEnabled();
+  if (is_profiler_enabled) {
+    tp = session_state.Profiler().Start();
+  }
+
+  auto* sampled_profiler = session_state.Profiler().GetSampledProfiler();
+  is_sampled_ = sampled_profiler != nullptr && session_state.ShouldSampleExecution(*sampled_profiler);
+
+  root_frame_ = std::make_unique<ExecutionFrame>(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches,
+                                                 fetch_allocators, session_state);
+
+  std::vector<NodeIndex> root_nodes;
+  for (auto node_index : session_state.GetGraphViewer().GetRootNodes()) {
+    if (session_state.GetKernel(node_index)) {
+      root_nodes.push_back(node_index);
+    }
+  }
+
+  if (!root_nodes.empty()) {
+    // this thread runs the first chain itself, and waits for the others to finish afterwards.
+    outstanding_chains_.store(1, std::memory_order_relaxed);
+    for (size_t i = 1; i < root_nodes.size(); ++i) {
+      ScheduleNodeChain(root_nodes[i], session_state, logger);
+    }
+    RunNodeChain(root_nodes[0], session_state, logger);
+
+    std::unique_lock<OrtMutex> lock(complete_mutex_);
+    while (!completed_) complete_cv_.wait(lock);
+  }
+
+  if (!errors_.empty()) {
+    Status status;
+    if (errors_.size() == 1) {
+      status = errors_.front();
+    } else {
+      std::stringstream ss;
+      ss << "Multiple errors were found.";
+      for (const auto& s : errors_) {
+        ss << '\n'
+           << s;
+      }
+
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ss.str());
+    }
+
+    LOGS(logger, ERROR) << status;
+    return status;
+  }
+
+  VLOGS(logger, 1) << "Fetching output.";
+  // ExecutionFrame::Finalize will update 'fetches' with the final output
+  ORT_RETURN_IF_ERROR(root_frame_->GetOutputs(fetches));
+  VLOGS(logger, 1) << "Done execution.";
+
+  if (is_profiler_enabled) {
+    session_state.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "DataflowExecutor::Execute", tp);
+  }
+
+  return Status::OK();
+}
+
+void DataflowExecutor::RunNodeChain(NodeIndex node_index, const SessionState& session_state,
+                                    const logging::Logger& logger) {
+  const auto& graph_viewer = session_state.GetGraphViewer();
+
+  auto create_exception_message = [&graph_viewer](NodeIndex index, const std::exception* ex) {
+    const auto* node = graph_viewer.GetNode(index);
+
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exception running nodes starting at ", node->OpType(),
+                           " node '", node->Name(), "'. ",
+                           ex ? ex->what() : "Unknown exception was caught by catch-all handler.");
+  };
+
+  Status status;
+  bool keep_running = true;
+
+  while (keep_running && !failed_.load(std::memory_order_relaxed)) {
+    ORT_TRY {
+      status = RunNode(node_index, session_state, logger);
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = create_exception_message(node_index, &ex);
+      });
+    }
+    ORT_CATCH(...) {
+      // catch node processing failure exceptions here to prevent app crash.
+      status = create_exception_message(node_index, nullptr);
+    }
+
+    if (!status.IsOK()) {
+      break;
+    }
+
+    // the consumers whose last pending input was produced by this node are ready. run the first one next and
+    // schedule the others.
+    keep_running = false;
+    const auto& node = *graph_viewer.GetNode(node_index);
+    for (auto it = node.OutputEdgesBegin(), end = node.OutputEdgesEnd(); it != end; ++it) {
+      auto consumer_index = it->GetNode().Index();
+      if (pending_inputs_[consumer_index].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        if (!keep_running) {
+          node_index = consumer_index;
+          keep_running = true;
+        } else {
+          ScheduleNodeChain(consumer_index, session_state, logger);
+        }
+      }
+    }
+  }
+
+  FinishNodeChain(status);
+}
+
+Status DataflowExecutor::RunNode(NodeIndex node_index, const SessionState& session_state,
+                                 const logging::Logger& logger) {
+  if (terminate_flag_) {
+    LOGS(logger, WARNING) << "Exiting due to terminate flag being set to true.";
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
+  }
+
+  const auto* p_op_kernel = session_state.GetKernel(node_index);
+  const auto& node = *session_state.GetGraphViewer().GetNode(node_index);
+
+  // if a kernel has been added in the session state, it better be NON-null.
+  if (p_op_kernel == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Got nullptr from GetKernel for node: ", node.Name());
+  }
+
+  const SequentialExecutionPlan& exec_plan = *session_state.GetExecutionPlan();
+  const bool f_profiler_enabled = session_state.Profiler().IsEnabled();
+  TimePoint sync_time_begin;
+  TimePoint kernel_begin_time;
+
+  OpKernelContextInternal op_kernel_context(session_state, *root_frame_, *p_op_kernel, logger, terminate_flag_);
+
+  if (f_profiler_enabled) {
+    sync_time_begin = session_state.Profiler().Start();
+  }
+  // sync before compute
+  int queue_id = p_op_kernel->KernelDef().ExecQueueId();
+  if (exec_plan.NodeHasFence(node_index)) {
+    for (int input_index = 0; input_index < op_kernel_context.InputCount(); ++input_index) {
+      Fence_t fence = op_kernel_context.InputFence(input_index);
+      if (fence) {
+        auto execution_provider_type = node.GetExecutionProviderType();
+        if (OrtMemTypeCPUInput == p_op_kernel->KernelDef().InputMemoryType(input_index)) {
+          execution_provider_type = kCpuExecutionProvider;
+        }
+        fence->BeforeUsingAsInput(execution_provider_type, queue_id);
+      }
+    }
+
+    for (int input_index = 0; input_index < op_kernel_context.ImplicitInputCount(); ++input_index) {
+      Fence_t fence = op_kernel_context.ImplicitInputFence(input_index);
+      if (fence) {
+        auto execution_provider_type = node.GetExecutionProviderType();
+        if (OrtMemTypeCPUInput == p_op_kernel->KernelDef().InputMemoryType(input_index)) {
+          execution_provider_type = kCpuExecutionProvider;
+        }
+        fence->BeforeUsingAsInput(execution_provider_type, queue_id);
+      }
+    }
+
+    for (int output_index = 0; output_index < op_kernel_context.OutputCount(); ++output_index) {
+      Fence_t fence = op_kernel_context.OutputFence(output_index);
+      if (fence) {
+        fence->BeforeUsingAsOutput(node.GetExecutionProviderType(), queue_id);
+      }
+    }
+  }
+
+  if (f_profiler_enabled) {
+    session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                   node.Name() + "_fence_before",
+                                                   sync_time_begin,
+                                                   {{"op_name", p_op_kernel->KernelDef().OpName()}});
+    kernel_begin_time = session_state.Profiler().Start();
+  }
+
+  // call compute on the kernel
+  VLOGS(logger, 1) << "Computing kernel: " << node.Name();
+
+#ifdef ENABLE_TRAINING
+  if (p_op_kernel->KernelDef().AllocateInputsContiguously()) {
+    ORT_RETURN_IF_ERROR(utils::VerifyInputTensorsAllocatedContiguously(&op_kernel_context));
+  }
+#endif
+
+  TimePoint sampled_kernel_begin_time;
+  if (is_sampled_) {
+    sampled_kernel_begin_time = std::chrono::high_resolution_clock::now();
+  }
+
+  Status status = p_op_kernel->Compute(&op_kernel_context);
+
+  if (!status.IsOK()) {
+    std::ostringstream ss;
+    ss << "Non-zero status code returned while running " << node.OpType() << " node. Name:'" << node.Name()
+       << "' Status Message: " << status.ErrorMessage();
+    const auto msg_string = ss.str();
+    LOGS(logger, ERROR) << msg_string;
+    return Status(status.Category(), status.Code(), msg_string);
+  }
+
+  if (is_sampled_) {
+    session_state.Profiler().GetSampledProfiler()->RecordLatencySince(session_state.GetSampledOpTypeId(node_index),
+                                                                      sampled_kernel_begin_time);
+  }
+
+  if (f_profiler_enabled) {
+    session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                   node.Name() + "_kernel_time",
+                                                   kernel_begin_time,
+                                                   {{"op_name", p_op_kernel->KernelDef().OpName()},
+                                                    {"provider", p_op_kernel->KernelDef().Provider()}});
+
+    sync_time_begin = session_state.Profiler().Start();
+  }
+
+  // sync after compute for outputs
+  if (exec_plan.NodeHasFence(node_index)) {
+    for (int input_index = 0; input_index < op_kernel_context.InputCount(); ++input_index) {
+      Fence_t fence = op_kernel_context.InputFence(input_index);
+      if (fence) {
+        fence->AfterUsedAsInput(queue_id);
+      }
+    }
+
+    for (int input_index = 0; input_index < op_kernel_context.ImplicitInputCount(); ++input_index) {
+      Fence_t fence = op_kernel_context.ImplicitInputFence(input_index);
+      if (fence) {
+        fence->AfterUsedAsInput(queue_id);
+      }
+    }
+
+    for (int output_index = 0; output_index < op_kernel_context.OutputCount(); ++output_index) {
+      Fence_t fence = op_kernel_context.OutputFence(output_index);
+      if (fence) {
+        fence->AfterUsedAsOutput(queue_id);
+      }
+    }
+  }
+
+  if (f_profiler_enabled) {
+    session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                   node.Name() + "_fence_after",
+                                                   sync_time_begin,
+                                                   {{"op_name", p_op_kernel->KernelDef().OpName()}});
+  }
+
+  return Status::OK();
+}
+
+void DataflowExecutor::ScheduleNodeChain(NodeIndex node_index, const SessionState& session_state,
+                                         const logging::Logger& logger) {
+  // counted before it's scheduled, so the count can't drop to zero while the node is waiting in a queue.
+  outstanding_chains_.fetch_add(1, std::memory_order_relaxed);
+
+  concurrency::ThreadPool::Schedule(thread_pool_, [this, node_index, &session_state, &logger]() {
+    RunNodeChain(node_index, session_state, logger);
+  });
+}
+
+void DataflowExecutor::FinishNodeChain(const Status& status) {
+  if (!status.IsOK()) {
+    failed_.store(true, std::memory_order_relaxed);
+    std::lock_guard<OrtMutex> lock(errors_mutex_);
+    errors_.push_back(status);
+  }
+
+  if (outstanding_chains_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    // Execute returns, and this executor may be destroyed, as soon as completed_ is set. so it's set under the lock
+    // and nothing else is accessed afterwards.
+    std::lock_guard<OrtMutex> lock(complete_mutex_);
+    completed_ = true;
+    complete_cv_.notify_all();
+  }
+}
+}  // namespace onnxruntime
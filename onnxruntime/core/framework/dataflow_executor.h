@@ -0,0 +1,77 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include "core/common/common.h"
+#include "core/common/status.h"
+#include "core/common/logging/logging.h"
+#include "core/framework/iexecutor.h"
+#include "core/framework/framework_common.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/session_state.h"
+#include "core/graph/graph_viewer.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+class ExecutionFrame;
+
+// Executes the nodes of the graph as soon as all their inputs are produced, on the intra-op thread pool.
+//
+// Every node has an atomic counter of the nodes producing its inputs that haven't run yet. The thread that
+// completes a node decrements the counters of its consumers, keeps running one of the consumers that became
+// ready and schedules the others on the thread pool, so no lock is taken on the scheduling path.
+// As the nodes run on the same work-stealing pool that kernels use to parallelize their loops, the threads are
+// shared between running independent branches and parallelizing the nodes themselves, instead of being split
+// between an inter-op and an intra-op pool.
+class DataflowExecutor : public IExecutor {
+ public:
+  DataflowExecutor(const SessionState& session_state, const bool& terminate_flag = false);
+
+  common::Status Execute(const SessionState& session_state, const std::vector<int>& feed_mlvalue_idxs,
+                         const std::vector<OrtValue>& feeds, const std::vector<int>& fetch_mlvalue_idxs,
+                         std::vector<OrtValue>& fetches,
+                         const std::unordered_map<size_t, CustomAllocator>& fetch_allocators,
+                         const logging::Logger& logger) override;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(DataflowExecutor);
+
+  // Runs the node and then the consumers it makes ready, one at a time, on the current thread.
+  // Any other consumer that becomes ready is scheduled on the thread pool.
+  void RunNodeChain(NodeIndex node_index, const SessionState& session_state, const logging::Logger& logger);
+
+  Status RunNode(NodeIndex node_index, const SessionState& session_state, const logging::Logger& logger);
+
+  void ScheduleNodeChain(NodeIndex node_index, const SessionState& session_state, const logging::Logger& logger);
+
+  void FinishNodeChain(const Status& status);
+
+  std::unique_ptr<ExecutionFrame> root_frame_;
+
+  // number of nodes producing inputs of each node that haven't run yet.
+  std::vector<std::atomic<size_t>> pending_inputs_;
+
+  // number of node chains that are running or scheduled.
+  std::atomic<int> outstanding_chains_{0};
+
+  // set once a node failed, to stop starting new nodes.
+  std::atomic<bool> failed_{false};
+
+  // whether the sampled profiler records the latencies of the nodes of this execution.
+  bool is_sampled_ = false;
+
+  OrtMutex errors_mutex_;
+  std::vector<Status> errors_;  // protected by errors_mutex_
+
+  OrtMutex complete_mutex_;
+  OrtCondVar complete_cv_;
+  bool completed_ = false;  // protected by complete_mutex_
+
+  const bool& terminate_flag_;
+  concurrency::ThreadPool* const thread_pool_;
+};
+}  // namespace onnxruntime
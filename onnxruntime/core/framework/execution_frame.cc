@@ -9,6 +9,7 @@
 #include "core/framework/execution_plan_base.h"
 #include "core/framework/sequential_execution_plan.h"
 #include "core/framework/ort_value_pattern_planner.h"
+#include "core/framework/region_allocator.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/sparse_utils.h"
 #include "core/framework/node_index_info.h"
@@ -183,6 +184,10 @@ AllocatorPtr IExecutionFrame::GetAllocator(const OrtMemoryInfo& info) const {
   return GetAllocatorImpl(info);
 }
 
+AllocatorPtr IExecutionFrame::GetTempSpaceAllocator(const OrtMemoryInfo& info) const {
+  return GetTempSpaceAllocatorImpl(info);
+}
+
 Status IExecutionFrame::ReleaseMLValue(int ort_value_idx) { return ReleaseMLValueImpl(ort_value_idx); }
 
 Status IExecutionFrame::ReleaseMLValueImpl(int ort_value_idx) {
@@ -329,8 +334,8 @@ ExecutionFrame::ExecutionFrame(const std::vector<int>& feed_mlvalue_idxs, const
                                const SessionState& session_state)
     : IExecutionFrame(session_state.GetOrtValueNameIdxMap(), session_state.GetNodeIndexInfo(), fetch_mlvalue_idxs),
       session_state_(session_state),
-      mem_patterns_(nullptr),
-      planner_(nullptr) {
+      planner_(nullptr),
+      use_run_region_allocator_(session_state.GetUseRunRegionAllocator()) {
   Init(
       feed_mlvalue_idxs, feeds, session_state.GetInitializedTensors(),
 #if !defined(DISABLE_SPARSE_TENSORS)
@@ -451,7 +456,14 @@ ExecutionFrame::ExecutionFrame(const std::vector<int>& feed_mlvalue_idxs, const
   }
 }
 
-ExecutionFrame::~ExecutionFrame() = default;
+ExecutionFrame::~ExecutionFrame() {
+  // Size the regions of the next Runs so that they usually need a single block.
+  // The blocks are released once the last tensor allocated from a region is released,
+  // which is normally when the values of the frame are destroyed.
+  for (const auto& entry : run_region_allocators_) {
+    session_state_.UpdateRunRegionBlockSize(entry.first, entry.second->PeakBytesInUse());
+  }
+}
 
 Status ExecutionFrame::CopyTensor(const Tensor& src, Tensor& dest) const {
   return session_state_.GetDataTransferMgr().CopyTensor(src, dest);
@@ -514,8 +526,9 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
       if (block) {
         auto it = buffers_.find(location);
         if (it != buffers_.end()) {
-          // if the block is not correct, log message then fall back to default behavior
-          if (block->size_ == size) {
+          // the block may be larger if the pattern was generated for larger input shapes in the same shape bucket.
+          // if the block is too small, log message then fall back to default behavior
+          if (size <= block->size_) {
             void* buffer = it->second.get();
             auto status = AllocateTensorWithPreAllocateBufferHelper(
                 ort_value, static_cast<void*>(static_cast<char*>(buffer) + block->offset_), element_type, location,
@@ -524,8 +537,6 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
           } else {
             // the block size may vary especially if the model has NonZero ops, or different sequence lengths are
             // fed in, so use VERBOSE as the log level as it's expected.
-            // TODO: Should we re-use the block if the size is large enough? Would probably need to allow it
-            // to be freed if the size difference was too large so our memory usage doesn't stick at a high water mark
             LOGS(session_state_.Logger(), VERBOSE) << "For ort_value with index: " << ort_value_index
                                                    << ", block in memory pattern size is: " << block->size_
                                                    << " but the actually size is: " << size
@@ -538,7 +549,12 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
   }
 
   //no memory pattern, or the pattern is not correct.
-  if (!alloc) alloc = GetAllocator(location);
+  if (use_run_region_allocator_ && per_alloc_plan.alloc_kind == AllocKind::kAllocate && !IsOutput(ort_value_index)) {
+    // the value is released before the end of the Run.
+    alloc = GetRunRegionAllocator(location);
+  } else if (!alloc) {
+    alloc = GetAllocator(location);
+  }
   Tensor::InitOrtValue(element_type, shape, std::move(alloc), ort_value);
 
   // trace the memory allocation.
@@ -740,6 +756,23 @@ AllocatorPtr ExecutionFrame::GetAllocatorImpl(const OrtMemoryInfo& info) const {
   return session_state_.GetAllocator(info);
 }
 
+AllocatorPtr ExecutionFrame::GetTempSpaceAllocatorImpl(const OrtMemoryInfo& info) const {
+  return use_run_region_allocator_ ? GetRunRegionAllocator(info) : GetAllocatorImpl(info);
+}
+
+AllocatorPtr ExecutionFrame::GetRunRegionAllocator(const OrtMemoryInfo& location) const {
+  std::lock_guard<std::mutex> lock(run_region_allocators_mutex_);
+  auto& region = run_region_allocators_[location];
+  if (!region) {
+    AllocatorPtr alloc = session_state_.GetAllocator(location);
+    if (!alloc) {
+      return nullptr;
+    }
+    region = std::make_shared<RegionAllocator>(std::move(alloc), session_state_.GetRunRegionBlockSize(location));
+  }
+  return region;
+}
+
 // This method is not thread safe!
 // Return S_OK and nullptr if index map to an value that is an unused optional input/output
 Status ExecutionFrame::CreateNodeOutputMLValueImpl(OrtValue& ort_value, int ort_value_idx, const TensorShape* shape) {
@@ -23,6 +23,7 @@ class DataTransferManager;
 class SessionState;
 class OrtValueNameIdxMap;
 class OrtValuePatternPlanner;
+class RegionAllocator;
 struct MemoryPatternGroup;
 class NodeIndexInfo;
 
@@ -79,6 +80,9 @@ class IExecutionFrame {
 
   AllocatorPtr GetAllocator(const OrtMemoryInfo& info) const;
 
+  // Get the allocator for kernel scratch buffers that are released before the end of the Run.
+  AllocatorPtr GetTempSpaceAllocator(const OrtMemoryInfo& info) const;
+
   Status ReleaseMLValue(int ort_value_idx);
 
  protected:
@@ -106,6 +110,8 @@ class IExecutionFrame {
 
   virtual AllocatorPtr GetAllocatorImpl(const OrtMemoryInfo& info) const = 0;
 
+  virtual AllocatorPtr GetTempSpaceAllocatorImpl(const OrtMemoryInfo& info) const { return GetAllocatorImpl(info); }
+
   virtual Status CreateNodeOutputMLValueImpl(OrtValue& ort_value, int ort_value_idx, const TensorShape* shape) = 0;
 
   virtual Status CopyTensor(const Tensor& src, Tensor& dest) const = 0;
@@ -184,6 +190,7 @@ class ExecutionFrame final : public IExecutionFrame {
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ExecutionFrame);
 
   AllocatorPtr GetAllocatorImpl(const OrtMemoryInfo& info) const override;
+  AllocatorPtr GetTempSpaceAllocatorImpl(const OrtMemoryInfo& info) const override;
   Status ReleaseMLValueImpl(int ort_value_idx) override;
   Status CreateNodeOutputMLValueImpl(OrtValue& ort_value, int ort_value_idx, const TensorShape* shape) override;
   void VerifyOutputSizes(int output_index, const Node& node, const TensorShape& output_shape) override;
@@ -204,6 +211,9 @@ class ExecutionFrame final : public IExecutionFrame {
 
   const AllocPlanPerValue& GetAllocationPlan(int ort_value_idx);
 
+  // Get the Run region allocator for the location, creating it on first use.
+  AllocatorPtr GetRunRegionAllocator(const OrtMemoryInfo& location) const;
+
   const SessionState& session_state_;
 
   // map of index to custom allocator
@@ -212,7 +222,7 @@ class ExecutionFrame final : public IExecutionFrame {
   // If we already have cached memory pattern on these input shapes
   // Use this mem pattern that create a big chunk for all the internal
   // kernel's input/output tensors.
-  const MemoryPatternGroup* mem_patterns_;
+  std::shared_ptr<const MemoryPatternGroup> mem_patterns_;
 
   // If no cached memory pattern, and we enable the memory pattern optimization
   // use this planner_ to trace the memory allocation in current executor.
@@ -221,6 +231,12 @@ class ExecutionFrame final : public IExecutionFrame {
   // Big chunks on different locations that will be used by mem_pattern.
   std::map<OrtMemoryInfo, BufferUniquePtr> buffers_;
 
+  // If the session enables the Run region allocator, the transient allocations of this Run
+  // on each location are served by a RegionAllocator and released together with the frame.
+  const bool use_run_region_allocator_;
+  mutable std::mutex run_region_allocators_mutex_;
+  mutable std::map<OrtMemoryInfo, std::shared_ptr<RegionAllocator>> run_region_allocators_;
+
   // Given the input shapes of the executed graph, ExecutionFrame tries inferring
   // all symbolic shapes. inferred_shapes_[i] is the shape of OrtValue indexed
   // by i, if the key i exists.
@@ -19,6 +19,8 @@ struct MemoryBlock {
 
 class MemoryPattern {
   friend class MemPatternPlanner;
+  // restores the memory patterns saved in ORT format models
+  friend class SessionState;
 
  public:
   MemoryPattern() = default;
@@ -13,7 +13,7 @@ OrtValuePatternPlanner::OrtValuePatternPlanner(const ExecutionPlanBase& executio
   }
 }
 
-#ifdef ENABLE_TRAINING
+#if !defined(ORT_MINIMAL_BUILD) || defined(ENABLE_TRAINING)
 common::Status OrtValuePatternPlanner::TraceAllocation(int ort_value_idx,
                                                        const AllocPlanPerValue::ProgramCounter& counter,
                                                        size_t size) {
@@ -0,0 +1,48 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/page_allocator.h"
+
+#include "core/platform/env.h"
+
+namespace onnxruntime {
+
+PageAllocator::PageAllocator(const OrtMemoryInfo& memory_info, bool use_huge_pages, int numa_node)
+    : IAllocator(memory_info), use_huge_pages_(use_huge_pages), numa_node_(numa_node) {
+}
+
+PageAllocator::~PageAllocator() {
+  for (const auto& allocation : mapped_sizes_) {
+    Env::Default().FreePages(allocation.first, allocation.second);
+  }
+}
+
+void* PageAllocator::Alloc(size_t size) {
+  void* p = Env::Default().AllocatePages(size, use_huge_pages_, numa_node_);
+  if (p == nullptr) {
+    return nullptr;
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  mapped_sizes_[p] = size;
+  return p;
+}
+
+void PageAllocator::Free(void* p) {
+  if (p == nullptr) {
+    return;
+  }
+
+  size_t size;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto it = mapped_sizes_.find(p);
+    ORT_ENFORCE(it != mapped_sizes_.end(), "Freeing memory that was not allocated by this allocator");
+    size = it->second;
+    mapped_sizes_.erase(it);
+  }
+
+  Env::Default().FreePages(p, size);
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,39 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <unordered_map>
+
+#include "core/common/common.h"
+#include "core/framework/allocator.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+// A CPU allocator that maps memory directly from the OS, optionally backed by huge pages and bound to a NUMA node.
+// Every allocation is rounded up to whole pages, so it's meant to be the device allocator of an arena, which
+// requests few large regions.
+class PageAllocator : public IAllocator {
+ public:
+  // numa_node is -1 to use the default memory policy.
+  PageAllocator(const OrtMemoryInfo& memory_info, bool use_huge_pages, int numa_node);
+
+  ~PageAllocator() override;
+
+  void* Alloc(size_t size) override;
+
+  void Free(void* p) override;
+
+ private:
+  const bool use_huge_pages_;
+  const int numa_node_;
+
+  OrtMutex mutex_;
+  // mapped size of each allocation.
+  std::unordered_map<void*, size_t> mapped_sizes_;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PageAllocator);
+};
+
+}  // namespace onnxruntime
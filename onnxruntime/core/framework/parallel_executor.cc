@@ -38,6 +38,9 @@ Status ParallelExecutor::Execute(const SessionState& session_state, const std::v
     tp = session_state.Profiler().Start();
   }
 
+  auto* sampled_profiler = session_state.Profiler().GetSampledProfiler();
+  is_sampled_ = sampled_profiler != nullptr && session_state.ShouldSampleExecution(*sampled_profiler);
+
   root_frame_ = std::make_unique<ExecutionFrame>(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches,
                                                          fetch_allocators, session_state);
   //std::cout << "start nodes:" << std::endl;
@@ -96,7 +99,8 @@ Status ParallelExecutor::Execute(const SessionState& session_state, const std::v
     if (all_tensors) {
       auto mem_patterns = std::make_unique<MemoryPatternGroup>();
       ORT_RETURN_IF_ERROR(root_frame_->GeneratePatterns(mem_patterns.get()));
-      ORT_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(input_shapes, std::move(mem_patterns)));
+      ORT_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(input_shapes, feed_mlvalue_idxs,
+                                                                        std::move(mem_patterns)));
     }
   }
 
@@ -189,6 +193,11 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
     // call compute on the kernel
     VLOGS(logger, 1) << "Computing kernel: " << node.Name();
 
+    TimePoint sampled_kernel_begin_time;
+    if (is_sampled_) {
+      sampled_kernel_begin_time = std::chrono::high_resolution_clock::now();
+    }
+
     // Execute the kernel.
     ORT_TRY {
 #ifdef ENABLE_TRAINING
@@ -215,6 +224,11 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
       break;
     }
 
+    if (is_sampled_) {
+      session_state.Profiler().GetSampledProfiler()->RecordLatencySince(session_state.GetSampledOpTypeId(node_index),
+                                                                        sampled_kernel_begin_time);
+    }
+
     if (f_profiler_enabled) {
       session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
                                                      node.Name() + "_kernel_time",
@@ -60,6 +60,8 @@ class ParallelExecutor : public IExecutor {
   std::vector<Status> errors_;
 
   const bool& terminate_flag_;
+  // whether the sampled profiler records the latencies of the nodes of this execution
+  bool is_sampled_{false};
   // TODO: Temporary threadpool for the executor.  This is a costly way to handle the problem.
   onnxruntime::concurrency::ThreadPool* const executor_pool_{};
 };
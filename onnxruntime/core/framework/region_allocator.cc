@@ -0,0 +1,88 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/region_allocator.h"
+
+#include <algorithm>
+
+namespace onnxruntime {
+
+RegionAllocator::RegionAllocator(AllocatorPtr allocator, size_t initial_block_size)
+    : IAllocator(allocator->Info()),
+      allocator_(std::move(allocator)),
+      next_block_size_(std::max(initial_block_size, kAllocAlignment)) {
+}
+
+RegionAllocator::~RegionAllocator() {
+  for (const auto& block : blocks_) {
+    allocator_->Free(block.ptr);
+  }
+}
+
+void* RegionAllocator::Alloc(size_t size) {
+  if (size == 0) {
+    return nullptr;
+  }
+
+  // Keep the alignment guaranteed by the arena.
+  size_t rounded_size;
+  ORT_ENFORCE(CalcMemSizeForArrayWithAlignment<kAllocAlignment>(size, 1, &rounded_size),
+              "Size overflow allocating ", size, " bytes");
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+
+  if (blocks_.empty() || blocks_.back().size - offset_ < rounded_size) {
+    const size_t block_size = std::max(next_block_size_, rounded_size);
+    char* block = static_cast<char*>(allocator_->Alloc(block_size));
+    ORT_ENFORCE(block != nullptr, "Failed to allocate a region block of ", block_size, " bytes");
+
+    if (!blocks_.empty()) {
+      full_blocks_size_ += blocks_.back().size;
+    }
+    blocks_.push_back({block, block_size});
+    offset_ = 0;
+    next_block_size_ = block_size * 2;
+  }
+
+  void* p = blocks_.back().ptr + offset_;
+  last_allocation_ = p;
+  last_allocation_offset_ = offset_;
+  offset_ += rounded_size;
+  peak_bytes_in_use_ = std::max(peak_bytes_in_use_, full_blocks_size_ + offset_);
+
+  return p;
+}
+
+void RegionAllocator::Free(void* p) {
+  if (p == nullptr) {
+    return;
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+
+  if (p == last_allocation_) {
+    offset_ = last_allocation_offset_;
+    last_allocation_ = nullptr;
+  } else if (!IsInRegion(p)) {
+    // Memory from Reserve().
+    allocator_->Free(p);
+  }
+}
+
+void* RegionAllocator::Reserve(size_t size) {
+  return allocator_->Reserve(size);
+}
+
+size_t RegionAllocator::PeakBytesInUse() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return peak_bytes_in_use_;
+}
+
+bool RegionAllocator::IsInRegion(const void* p) const {
+  const char* c = static_cast<const char*>(p);
+  return std::any_of(blocks_.begin(), blocks_.end(), [c](const Block& block) {
+    return c >= block.ptr && c < block.ptr + block.size;
+  });
+}
+
+}  // namespace onnxruntime
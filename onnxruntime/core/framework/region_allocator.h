@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/allocator.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+// An allocator that hands out memory from a few large blocks, obtained from an
+// underlying allocator, by bumping a pointer.
+//
+// Memory handed out is not reused when freed, except for the most recent
+// allocation so that scoped scratch buffers do not grow the region. All blocks
+// are returned to the underlying allocator at once when the region allocator
+// is destroyed. It is meant for transient allocations that all end by the end
+// of a single Run. As each allocation holds a reference to the region, memory
+// that escapes the Run keeps the region alive instead of dangling.
+//
+// This class is thread-safe.
+class RegionAllocator : public IAllocator {
+ public:
+  // initial_block_size is the size of the first block. Every further block is
+  // twice the size of the previous one, or the size of the request if larger.
+  RegionAllocator(AllocatorPtr allocator, size_t initial_block_size);
+
+  ~RegionAllocator() override;
+
+  void* Alloc(size_t size) override;
+
+  void Free(void* p) override;
+
+  // Allocations that bypass the region are freed individually.
+  void* Reserve(size_t size) override;
+
+  FencePtr CreateFence(const SessionState* session_state) override {
+    return allocator_->CreateFence(session_state);
+  }
+
+  // Returns the maximum number of bytes of the blocks in use at any time.
+  // A region with an initial block of this size serves the same allocations
+  // from a single block.
+  size_t PeakBytesInUse() const;
+
+  static constexpr size_t kDefaultInitialBlockSize = 1024 * 1024;
+
+ private:
+  struct Block {
+    char* ptr;
+    size_t size;
+  };
+
+  bool IsInRegion(const void* p) const;
+
+  AllocatorPtr allocator_;
+
+  mutable OrtMutex mutex_;
+  std::vector<Block> blocks_;
+  // Offset of the next allocation in the last block.
+  size_t offset_ = 0;
+  size_t next_block_size_;
+  // The most recent allocation, which is rolled back when freed.
+  void* last_allocation_ = nullptr;
+  size_t last_allocation_offset_ = 0;
+  // Size of all blocks but the last one, whose unused tails are wasted.
+  size_t full_blocks_size_ = 0;
+  size_t peak_bytes_in_use_ = 0;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RegionAllocator);
+};
+
+}  // namespace onnxruntime
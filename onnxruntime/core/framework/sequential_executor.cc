@@ -139,6 +139,10 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
     tp = session_state.Profiler().Start();
   }
 
+  auto* const sampled_profiler = session_state.Profiler().GetSampledProfiler();
+  const bool is_sampled = sampled_profiler != nullptr && session_state.ShouldSampleExecution(*sampled_profiler);
+  TimePoint sampled_kernel_begin_time;
+
   ExecutionFrame frame{feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches, fetch_allocators, session_state};
 
 #if !defined(ORT_MINIMAL_BUILD)
@@ -303,6 +307,10 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
                                input_activation_sizes, input_parameter_sizes, node_name_for_profiling);
     }
 
+    if (is_sampled) {
+      sampled_kernel_begin_time = std::chrono::high_resolution_clock::now();
+    }
+
     Status compute_status;
     {
 #ifdef CONCURRENCY_VISUALIZER
@@ -347,6 +355,10 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
       return Status(compute_status.Category(), compute_status.Code(), msg_string);
     }
 
+    if (is_sampled) {
+      sampled_profiler->RecordLatencySince(session_state.GetSampledOpTypeId(node_index), sampled_kernel_begin_time);
+    }
+
     if (is_profiler_enabled) {
       // Calculate total output sizes for this operation.
       CalculateTotalOutputSizes(&op_kernel_context, total_output_sizes, node_name_for_profiling);
@@ -476,7 +488,8 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
     if (all_tensors) {
       auto mem_patterns = std::make_unique<MemoryPatternGroup>();
       ORT_RETURN_IF_ERROR(frame.GeneratePatterns(mem_patterns.get()));
-      ORT_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(input_shapes, std::move(mem_patterns)));
+      ORT_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(input_shapes, feed_mlvalue_idxs,
+                                                                        std::move(mem_patterns)));
     }
   }
 
@@ -13,8 +13,9 @@
 namespace onnxruntime {
 
 enum class ExecutionOrder {
-  DEFAULT = 0,        // default topological sort
-  PRIORITY_BASED = 1  // priority-based topological sort
+  DEFAULT = 0,          // default topological sort
+  PRIORITY_BASED = 1,   // priority-based topological sort
+  MEMORY_EFFICIENT = 2  // topological sort that keeps the estimated peak size of the live tensors small
 };
 
 enum class FreeDimensionOverrideType {
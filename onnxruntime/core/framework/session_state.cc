@@ -7,12 +7,15 @@
 
 #include "core/platform/ort_mutex.h"
 #include "core/common/logging/logging.h"
+#include "core/common/parse_string.h"
+#include "core/common/string_utils.h"
 #include "core/common/safeint.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
 #include "core/framework/allocator.h"
 #include "core/framework/node_index_info.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/ort_value_pattern_planner.h"
+#include "core/framework/region_allocator.h"
 #include "core/framework/session_state_flatbuffers_utils.h"
 #include "core/framework/session_state_utils.h"
 #include "core/framework/utils.h"
@@ -296,118 +299,254 @@ static std::string GenerateKeyForPrepackedWeightsMap(const std::string& op_type,
   return ss_1.str();
 }
 
-Status SessionState::PrepackConstantInitializedTensors(std::unordered_map<std::string, size_t>& constant_initializers_use_count,
-                                                       const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map) {
-  auto prepacked_constant_weights = [this, &constant_initializers_use_count, &initializers_to_share_map](
-                                        bool should_cache_prepacked_weights_for_shared_initializers) -> Status {
-    for (auto& node : GetGraphViewer().Nodes()) {
-      auto kernel = GetMutableKernel(node.Index());
-      int input_idx = 0;
-      for (auto& input_def : node.InputDefs()) {
-        if (input_def->Exists()) {
-          const std::string& input_name = input_def->Name();
-          SessionState* st = this;
-          // subgraph can use the value from outer scope,
-          // so it needs to check if current node uses constant initialized tensor from current and outer graphs
-          do {
-            int ort_value_idx;
-            if (st->GetOrtValueNameIdxMap().GetIdx(input_name, ort_value_idx).IsOK()) {
-              std::unordered_map<int, OrtValue>& constant_initialized_tensors = st->constant_initialized_tensors_;
-
-              if (constant_initialized_tensors.count(ort_value_idx)) {
-                bool is_packed = false;
-                const Tensor& const_initialized_tensor = constant_initialized_tensors[ort_value_idx].Get<Tensor>();
-
-                auto iter = initializers_to_share_map.find(input_name);
-                bool is_shared_initializer = (iter != initializers_to_share_map.end());
+Status SessionState::UseSavedPrePackedWeights(const Node& node, int input_idx, OpKernel& kernel, const Tensor& tensor,
+                                              /*out*/ bool& is_packed) const {
+  is_packed = false;
 
-                // Caching pre-packed weights is limited to shared initializers associated with the CPU EP for now
-                if (is_shared_initializer && should_cache_prepacked_weights_for_shared_initializers &&
-                    node.GetExecutionProviderType() == kCpuExecutionProvider) {  // caching of pre-packed weights' turned ON
+  // a model being saved keeps the weights pre-packed from the initializers, so they can be saved again
+  if (save_prepacked_weights_) {
+    return Status::OK();
+  }
+
+  auto entry = saved_prepacked_weights_.find({node.Index(), input_idx});
+  if (entry == saved_prepacked_weights_.end()) {
+    return Status::OK();
+  }
 
-                  AllocatorPtr allocator_for_caching = prepacked_weights_container_->GetOrCreateAllocator(CPU);
-                  ORT_ENFORCE(allocator_for_caching.get() != nullptr);
+  const auto& fbs_prepacked_weight = *entry->second;
+  const auto* fbs_buffers = fbs_prepacked_weight.buffers();
 
-                  PrePackedWeights weights_to_be_filled_in;
-                  // The reason we invoke PrePack() before looking into the container for any pre-packed weight
-                  // cached by another instance of the same op_type (for the same constant initializer) is because
-                  // to truly know if we can use a cached pre-packed weight, we would have to compare the cached pre-packed
-                  // weight with the pre-packed weight generated by this instance of the same op_type because other static
-                  // properties of the node like node attributes could play a role in the pre-packed weights' contents.
-                  ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, allocator_for_caching,
-                                                      is_packed,
-                                                      &weights_to_be_filled_in));
+  // the buffers are only valid for the kernel that produced them
+  if (fbs_buffers == nullptr ||
+      fbs_prepacked_weight.kernel_def_hash() != GetNodeKernelCreateInfo(node.Index()).kernel_def->GetHash()) {
+    return Status::OK();
+  }
 
-                  if (is_packed) {
-                    // BUG CHECK: Ensure that the kernel has filled in the pre-packed weight to be cached if the weight was pre-packed
-                    ORT_ENFORCE(weights_to_be_filled_in.buffers_.size() > 0, "The kernel corresponding to the node ", node.Name(),
-                                " doesn't have an implementation that can cache computed pre-packed weights");
+  AllocatorPtr session_cpu_alloc = kernel.Info().GetAllocator(0, OrtMemType::OrtMemTypeDefault);
 
-                    const auto& op_type = node.OpType();
+  std::vector<BufferUniquePtr> prepacked_buffers;
+  std::vector<size_t> prepacked_buffer_sizes;
+  prepacked_buffers.reserve(fbs_buffers->size());
+  prepacked_buffer_sizes.reserve(fbs_buffers->size());
+
+  for (const auto* fbs_buffer : *fbs_buffers) {
+    const auto* data = fbs_buffer->data();
+    const size_t size = data ? data->size() : 0;
+    if (size == 0) {
+      prepacked_buffers.emplace_back(nullptr, BufferDeleter(nullptr));
+    } else {
+      // copy to memory from the session allocator, as the kernels expect the alignment it provides
+      void* buffer = session_cpu_alloc->Alloc(size);
+      ORT_RETURN_IF(buffer == nullptr, "Failed to allocate ", size,
+                    " bytes for the saved pre-packed weights of node ", node.Name());
+      prepacked_buffers.emplace_back(buffer, BufferDeleter(session_cpu_alloc));
+      memcpy(buffer, data->data(), size);
+    }
+    prepacked_buffer_sizes.push_back(size);
+  }
+
+  ORT_RETURN_IF_ERROR(kernel.UseSavedPrePackedBuffers(tensor, input_idx, prepacked_buffers, prepacked_buffer_sizes,
+                                                      is_packed));
+
+  return Status::OK();
+}
+
+Status SessionState::PrepackConstantInitializedTensors(std::unordered_map<std::string, size_t>& constant_initializers_use_count,
+                                                       const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map,
+                                                       bool parallel) {
+  // the constant initialized tensors, use counts and counters are shared by the nodes, so they are only accessed with
+  // the lock held. the kernels pack their weights without it, so that nodes can be pre-packed in parallel.
+  OrtMutex prepack_mutex;
+
+  auto prepack_node_constant_weights = [this, &constant_initializers_use_count, &initializers_to_share_map,
+                                        &prepack_mutex](const Node& node,
+                                                        bool should_cache_prepacked_weights_for_shared_initializers)
+      -> Status {
+    auto kernel = GetMutableKernel(node.Index());
+    int input_idx = 0;
+    for (auto& input_def : node.InputDefs()) {
+      if (input_def->Exists()) {
+        const std::string& input_name = input_def->Name();
+        SessionState* st = this;
+        // subgraph can use the value from outer scope,
+        // so it needs to check if current node uses constant initialized tensor from current and outer graphs
+        do {
+          int ort_value_idx;
+          if (st->GetOrtValueNameIdxMap().GetIdx(input_name, ort_value_idx).IsOK()) {
+            std::unordered_map<int, OrtValue>& constant_initialized_tensors = st->constant_initialized_tensors_;
+
+            std::unique_lock<OrtMutex> lock(prepack_mutex);
+            auto const_initialized_entry = constant_initialized_tensors.find(ort_value_idx);
+            if (const_initialized_entry != constant_initialized_tensors.end()) {
+              bool is_packed = false;
+              // the copy keeps the tensor alive if another node releases it while this one is packed
+              const OrtValue const_initialized_value = const_initialized_entry->second;
+              const Tensor& const_initialized_tensor = const_initialized_value.Get<Tensor>();
+              lock.unlock();
+
+              // use the pre-packed weight saved in the ORT format model if there is one
+              ORT_RETURN_IF_ERROR(UseSavedPrePackedWeights(node, input_idx, *kernel, const_initialized_tensor,
+                                                           is_packed));
+
+              auto iter = initializers_to_share_map.find(input_name);
+              bool is_shared_initializer = (iter != initializers_to_share_map.end());
+
+              if (is_packed) {
+                LOGS(logger_, VERBOSE) << "Using saved pre-packed weight for constant initializer: " << input_name
+                                       << " used in the node: " << node.Name();
+                lock.lock();
+                ++used_saved_pre_packed_weights_counter_;
+                lock.unlock();
+              } else if (is_shared_initializer && should_cache_prepacked_weights_for_shared_initializers &&
+                         node.GetExecutionProviderType() == kCpuExecutionProvider) {  // caching of pre-packed weights' turned ON
+                // Caching pre-packed weights is limited to shared initializers associated with the CPU EP for now
+
+                AllocatorPtr allocator_for_caching = prepacked_weights_container_->GetOrCreateAllocator(CPU);
+                ORT_ENFORCE(allocator_for_caching.get() != nullptr);
+
+                PrePackedWeights weights_to_be_filled_in;
+                // The reason we invoke PrePack() before looking into the container for any pre-packed weight
+                // cached by another instance of the same op_type (for the same constant initializer) is because
+                // to truly know if we can use a cached pre-packed weight, we would have to compare the cached pre-packed
+                // weight with the pre-packed weight generated by this instance of the same op_type because other static
+                // properties of the node like node attributes could play a role in the pre-packed weights' contents.
+                ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, allocator_for_caching,
+                                                    is_packed,
+                                                    &weights_to_be_filled_in));
+
+                if (is_packed) {
+                  // BUG CHECK: Ensure that the kernel has filled in the pre-packed weight to be cached if the weight was pre-packed
+                  ORT_ENFORCE(weights_to_be_filled_in.buffers_.size() > 0, "The kernel corresponding to the node ", node.Name(),
+                              " doesn't have an implementation that can cache computed pre-packed weights");
 
-                    // Sanity check
-                    // TODO: Check if some version of the ONNX IR allows op_type to be empty
-                    ORT_ENFORCE(!op_type.empty(), "The op type of a node cannot be empty");
+                  const auto& op_type = node.OpType();
 
-                    // The key for the pre-packed weights container lookup is the op_type + hash of the prepacked-weight
-                    // that we just got by invoking PrePack() on this kernel.
+                  // Sanity check
+                  // TODO: Check if some version of the ONNX IR allows op_type to be empty
+                  ORT_ENFORCE(!op_type.empty(), "The op type of a node cannot be empty");
 
-                    const std::string& prepacked_weights_container_key = GenerateKeyForPrepackedWeightsMap(op_type,
-                                                                                                           weights_to_be_filled_in);
+                  // The key for the pre-packed weights container lookup is the op_type + hash of the prepacked-weight
+                  // that we just got by invoking PrePack() on this kernel.
 
-                    bool container_contains_packed_weight = prepacked_weights_container_->HasWeight(prepacked_weights_container_key);
+                  const std::string& prepacked_weights_container_key = GenerateKeyForPrepackedWeightsMap(op_type,
+                                                                                                         weights_to_be_filled_in);
 
-                    if (container_contains_packed_weight) {
-                      LOGS(logger_, INFO) << "Using cached version of pre-packed weight for constant initializer: " << input_name
-                                          << " used in the node: " << node.Name() << " which is of op type: " << node.OpType();
+                  bool container_contains_packed_weight = prepacked_weights_container_->HasWeight(prepacked_weights_container_key);
 
-                      ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
-                                                                          prepacked_weights_container_->GetWeight(prepacked_weights_container_key),
-                                                                          node.Name()));
+                  if (container_contains_packed_weight) {
+                    LOGS(logger_, INFO) << "Using cached version of pre-packed weight for constant initializer: " << input_name
+                                        << " used in the node: " << node.Name() << " which is of op type: " << node.OpType();
 
-                      ++used_shared_pre_packed_weights_counter_;
-                    } else {  // container doesn't contain the pre-packed weight - so write into it for sharing across kernel instances
+                    ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
+                                                                        prepacked_weights_container_->GetWeight(prepacked_weights_container_key),
+                                                                        node.Name()));
 
-                      if (!prepacked_weights_container_->WriteWeight(prepacked_weights_container_key, std::move(weights_to_be_filled_in))) {
-                        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Unable to write the provided PrePackedWeights instance into the container");
-                      }
+                    lock.lock();
+                    ++used_shared_pre_packed_weights_counter_;
+                    lock.unlock();
+                  } else {  // container doesn't contain the pre-packed weight - so write into it for sharing across kernel instances
 
-                      ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
-                                                                          prepacked_weights_container_->GetWeight(prepacked_weights_container_key),
-                                                                          node.Name()));
+                    if (!prepacked_weights_container_->WriteWeight(prepacked_weights_container_key, std::move(weights_to_be_filled_in))) {
+                      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Unable to write the provided PrePackedWeights instance into the container");
                     }
-                  }
 
-                } else {  // caching of pre-packed weights' turned OFF
-                  AllocatorPtr session_cpu_alloc = kernel->Info().GetAllocator(0, OrtMemType::OrtMemTypeDefault);
-                  ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx,
-                                                      session_cpu_alloc,  // use allocator tied to this session
-                                                      is_packed,
-                                                      nullptr  // no caching required
-                                                      ));
+                    ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
+                                                                        prepacked_weights_container_->GetWeight(prepacked_weights_container_key),
+                                                                        node.Name()));
+                  }
                 }
-                if (is_packed) {
-                  ++number_of_prepacks_counter_;
 
-                  if (constant_initializers_use_count.count(input_name) && --constant_initializers_use_count[input_name] == 0) {
-                    // release the constant initialized tensor
-                    st->initialized_tensors_.erase(ort_value_idx);
-                    constant_initialized_tensors.erase(ort_value_idx);
-                  }
+              } else {  // caching of pre-packed weights' turned OFF
+                AllocatorPtr session_cpu_alloc = kernel->Info().GetAllocator(0, OrtMemType::OrtMemTypeDefault);
+
+                // keep the pre-packed weights if they are to be saved in the ORT format model
+                const bool save_prepacked_weights = save_prepacked_weights_ &&
+                                                    node.GetExecutionProviderType() == kCpuExecutionProvider;
+                PrePackedWeights weights_to_save;
+
+                ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx,
+                                                    session_cpu_alloc,  // use allocator tied to this session
+                                                    is_packed,
+                                                    save_prepacked_weights ? &weights_to_save : nullptr));
+
+                // kernels that don't support caching keep the buffers themselves, and they aren't saved
+                if (is_packed && !weights_to_save.buffers_.empty()) {
+                  ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx, weights_to_save,
+                                                                      node.Name()));
+                  lock.lock();
+                  prepacked_weights_to_save_.emplace(std::make_pair(node.Index(), input_idx),
+                                                     std::move(weights_to_save));
+                  lock.unlock();
                 }
               }
-              // stop searching in 2 cases:
-              // 1. value is not from OuterScope
-              // 2. value is from OuterScope and the current OuterScope has the value
-              if (st != this || !st->graph_.IsOuterScopeValue(input_name)) {
-                break;
+              if (is_packed) {
+                lock.lock();
+                ++number_of_prepacks_counter_;
+
+                if (constant_initializers_use_count.count(input_name) && --constant_initializers_use_count[input_name] == 0) {
+                  // release the constant initialized tensor
+                  st->initialized_tensors_.erase(ort_value_idx);
+                  constant_initialized_tensors.erase(ort_value_idx);
+                }
+                lock.unlock();
               }
             }
-            st = st->Parent();
-          } while (st);
-        }
-        input_idx++;
+            if (lock.owns_lock()) {
+              lock.unlock();
+            }
+            // stop searching in 2 cases:
+            // 1. value is not from OuterScope
+            // 2. value is from OuterScope and the current OuterScope has the value
+            if (st != this || !st->graph_.IsOuterScopeValue(input_name)) {
+              break;
+            }
+          }
+          st = st->Parent();
+        } while (st);
       }
+      input_idx++;
+    }
+
+    return Status::OK();
+  };
+
+  auto prepacked_constant_weights = [this, &prepack_node_constant_weights, parallel](
+                                        bool should_cache_prepacked_weights_for_shared_initializers) -> Status {
+    // the CPU kernels pack their weights independently of each other, so they are pre-packed in parallel.
+    // the kernels of other EPs are pre-packed one after the other, as they may use the device, and so are all
+    // kernels if the weights are cached in the container shared between sessions.
+    std::vector<const Node*> nodes_to_prepack_in_parallel;
+    for (auto& node : GetGraphViewer().Nodes()) {
+      if (parallel && !should_cache_prepacked_weights_for_shared_initializers &&
+          node.GetExecutionProviderType() == kCpuExecutionProvider) {
+        nodes_to_prepack_in_parallel.push_back(&node);
+      } else {
+        ORT_RETURN_IF_ERROR(prepack_node_constant_weights(node, should_cache_prepacked_weights_for_shared_initializers));
+      }
+    }
+
+    if (nodes_to_prepack_in_parallel.empty()) {
+      return Status::OK();
+    }
+
+    std::vector<Status> statuses(nodes_to_prepack_in_parallel.size());
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        thread_pool_, static_cast<std::ptrdiff_t>(nodes_to_prepack_in_parallel.size()),
+        [&](std::ptrdiff_t i) {
+          const Node& node = *nodes_to_prepack_in_parallel[i];
+          ORT_TRY {
+            statuses[i] = prepack_node_constant_weights(node, should_cache_prepacked_weights_for_shared_initializers);
+          }
+          ORT_CATCH(const std::exception& ex) {
+            ORT_HANDLE_EXCEPTION([&]() {
+              statuses[i] = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Pre-packing the weights of node '", node.Name(),
+                                            "' failed: ", ex.what());
+            });
+          }
+        });
+
+    for (const auto& status : statuses) {
+      ORT_RETURN_IF_ERROR(status);
     }
 
     return Status::OK();
@@ -415,25 +554,76 @@ Status SessionState::PrepackConstantInitializedTensors(std::unordered_map<std::s
 
   bool should_cache_prepacked_weights_for_shared_initializers = (prepacked_weights_container_ != nullptr);
 
+  Status status;
   if (should_cache_prepacked_weights_for_shared_initializers) {
     // serialize calls to the method that looks up the container, calls UseCachedPrePackedWeight/PrePack
     // and writes pre-packed weights to the container
     std::lock_guard<onnxruntime::OrtMutex> l(prepacked_weights_container_->mutex_);
-    return prepacked_constant_weights(true);
+    status = prepacked_constant_weights(true);
   } else {
-    return prepacked_constant_weights(false);
+    status = prepacked_constant_weights(false);
   }
+
+  // the saved pre-packed weights point into the model bytes, which aren't kept after initialization
+  saved_prepacked_weights_.clear();
+
+  return status;
 }
 
-static int64_t CalculateMemoryPatternsKey(const std::vector<std::reference_wrapper<const TensorShape>>& shapes) {
-  int64_t key = 0;
-  for (auto shape : shapes) {
-    for (auto dim : shape.get().GetDims()) key ^= dim;
+// Returns the fixed dims of the i-th feed if its symbolic dims are rounded up to the shape buckets, or nullptr if the
+// feed is keyed on its exact shape. Dims beyond the returned vector are symbolic.
+static const std::vector<bool>* GetBucketedFeedFixedDims(size_t i, const std::vector<int>& feed_mlvalue_idxs,
+                                                         const std::unordered_map<int, std::vector<bool>>& fixed_input_dims,
+                                                         const std::vector<int64_t>& shape_buckets) {
+  if (shape_buckets.empty() || i >= feed_mlvalue_idxs.size()) {
+    return nullptr;
   }
-  return key;
+
+  auto it = fixed_input_dims.find(feed_mlvalue_idxs[i]);
+  return it != fixed_input_dims.cend() ? &it->second : nullptr;
 }
 
-#ifdef ENABLE_TRAINING
+// Returns the upper bound of the bucket of dim, or dim if it is above the last bucket.
+static int64_t RoundUpToShapeBucket(int64_t dim, const std::vector<int64_t>& shape_buckets) {
+  auto bucket = std::lower_bound(shape_buckets.cbegin(), shape_buckets.cend(), dim);
+  return bucket != shape_buckets.cend() ? *bucket : dim;
+}
+
+// Each dim that is symbolic in the graph input is rounded up to the upper bound of its bucket in shape_buckets, so
+// that all input shapes in the same buckets share a key. Dims above the last bucket, dims that are fixed in the model
+// and the dims of feeds that aren't graph inputs are kept.
+// is_bucket_upper_bound is set if no dim had to be rounded.
+static int64_t CalculateMemoryPatternsKey(const std::vector<std::reference_wrapper<const TensorShape>>& shapes,
+                                          const std::vector<int>& feed_mlvalue_idxs,
+                                          const std::unordered_map<int, std::vector<bool>>& fixed_input_dims,
+                                          const std::vector<int64_t>& shape_buckets,
+                                          bool& is_bucket_upper_bound) {
+  // combine the dims in order, so that transposed or swapped shapes don't share a key.
+  uint64_t key = shapes.size();
+  is_bucket_upper_bound = true;
+  for (size_t i = 0; i < shapes.size(); ++i) {
+    const auto& shape = shapes[i].get();
+    const auto* fixed_dims = GetBucketedFeedFixedDims(i, feed_mlvalue_idxs, fixed_input_dims, shape_buckets);
+
+    key = key * 31 + shape.NumDimensions();
+    for (size_t d = 0; d < shape.NumDimensions(); ++d) {
+      int64_t dim = shape[d];
+      if (fixed_dims != nullptr && (d >= fixed_dims->size() || !(*fixed_dims)[d])) {
+        dim = RoundUpToShapeBucket(dim, shape_buckets);
+        is_bucket_upper_bound = is_bucket_upper_bound && dim == shape[d];
+      }
+      key ^= static_cast<uint64_t>(dim) + 0x9e3779b97f4a7c15ULL + (key << 6) + (key >> 2);
+    }
+  }
+  return static_cast<int64_t>(key);
+}
+
+static int64_t CalculateMemoryPatternsKey(const std::vector<std::reference_wrapper<const TensorShape>>& shapes) {
+  bool is_bucket_upper_bound;
+  return CalculateMemoryPatternsKey(shapes, {}, {}, {}, is_bucket_upper_bound);
+}
+
+#if !defined(ORT_MINIMAL_BUILD) || defined(ENABLE_TRAINING)
 namespace {
 Status ResolveDimParams(const GraphViewer& graph,
                         const std::map<std::string, TensorShape>& feeds,
@@ -503,6 +693,29 @@ Status TryResolveShape(
   return Status::OK();
 }
 
+// Returns the input shapes with their symbolic dims rounded up to the shape buckets, as CalculateMemoryPatternsKey
+// rounds them.
+std::vector<TensorShape> RoundUpToShapeBuckets(const std::vector<std::reference_wrapper<const TensorShape>>& shapes,
+                                               const std::vector<int>& feed_mlvalue_idxs,
+                                               const std::unordered_map<int, std::vector<bool>>& fixed_input_dims,
+                                               const std::vector<int64_t>& shape_buckets) {
+  std::vector<TensorShape> rounded_shapes(shapes.cbegin(), shapes.cend());
+  for (size_t i = 0; i < rounded_shapes.size(); ++i) {
+    const auto* fixed_dims = GetBucketedFeedFixedDims(i, feed_mlvalue_idxs, fixed_input_dims, shape_buckets);
+    if (fixed_dims == nullptr) {
+      continue;
+    }
+
+    auto& shape = rounded_shapes[i];
+    for (size_t d = 0; d < shape.NumDimensions(); ++d) {
+      if (d >= fixed_dims->size() || !(*fixed_dims)[d]) {
+        shape[d] = RoundUpToShapeBucket(shape[d], shape_buckets);
+      }
+    }
+  }
+  return rounded_shapes;
+}
+
 void TryCalculateSizeFromResolvedShape(int ml_value_idx, std::unordered_map<int, TensorShape>& resolved_shapes, size_t& size) {
   size = 0;
   auto shape = resolved_shapes.find(ml_value_idx);
@@ -652,32 +865,92 @@ Status SessionState::GeneratePatternGroupCache(const std::vector<std::reference_
 }
 #endif
 
-const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes,
-                                                              const std::vector<int>& feed_mlvalue_idxs,
-                                                              std::unordered_map<int, TensorShape>& inferred_shapes) const {
-  int64_t key = CalculateMemoryPatternsKey(input_shapes);
-
-  std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
+SessionState::CachedMemoryPattern* SessionState::FindCachedMemoryPattern(int64_t key) const {
   auto it = mem_patterns_.find(key);
   if (it == mem_patterns_.end()) {
+    return nullptr;
+  }
+
+  mem_patterns_lru_.splice(mem_patterns_lru_.begin(), mem_patterns_lru_, it->second.lru_position);
+  return &it->second;
+}
+
+void SessionState::CacheMemoryPattern(int64_t key, CachedMemoryPattern entry) const {
+  auto it = mem_patterns_.find(key);
+  if (it != mem_patterns_.end()) {
+    mem_patterns_lru_.erase(it->second.lru_position);
+    mem_patterns_.erase(it);
+  }
+
+  mem_patterns_lru_.push_front(key);
+  entry.lru_position = mem_patterns_lru_.begin();
+  mem_patterns_.emplace(key, std::move(entry));
+
+  // frames that are using an evicted pattern keep it alive.
+  while (mem_patterns_capacity_ > 0 && mem_patterns_.size() > mem_patterns_capacity_) {
+    mem_patterns_.erase(mem_patterns_lru_.back());
+    mem_patterns_lru_.pop_back();
+  }
+}
+
+std::shared_ptr<const MemoryPatternGroup> SessionState::GetMemoryPatternGroup(
+    const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes,
+    const std::vector<int>& feed_mlvalue_idxs,
+    std::unordered_map<int, TensorShape>& inferred_shapes) const {
+  bool is_bucket_upper_bound;
+  int64_t key = CalculateMemoryPatternsKey(input_shapes, feed_mlvalue_idxs, memory_pattern_fixed_input_dims_,
+                                           memory_pattern_shape_buckets_, is_bucket_upper_bound);
+  const int64_t input_shapes_key = CalculateMemoryPatternsKey(input_shapes);
+
+  std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
+  auto* entry = FindCachedMemoryPattern(key);
+  if (entry == nullptr && !is_bucket_upper_bound) {
+#if !defined(ORT_MINIMAL_BUILD) || defined(ENABLE_TRAINING)
+    // the pattern of a bucket is planned for its upper bound, so that it fits every input shape in the bucket.
+    if (!mem_patterns_bucket_planning_failed_) {
+      const auto upper_bound_shapes = RoundUpToShapeBuckets(input_shapes, feed_mlvalue_idxs,
+                                                            memory_pattern_fixed_input_dims_,
+                                                            memory_pattern_shape_buckets_);
+      const std::vector<std::reference_wrapper<const TensorShape>> upper_bound_shape_refs(upper_bound_shapes.cbegin(),
+                                                                                          upper_bound_shapes.cend());
+      auto mem_patterns = std::make_shared<MemoryPatternGroup>();
+      std::unordered_map<int, TensorShape> resolved_shapes;
+      const auto status = GeneratePatternGroupCache(upper_bound_shape_refs, feed_mlvalue_idxs, mem_patterns.get(),
+                                                    resolved_shapes);
+      if (status.IsOK()) {
+        CacheMemoryPattern(key, {mem_patterns, std::move(resolved_shapes),
+                                 CalculateMemoryPatternsKey(upper_bound_shape_refs), {}});
+        return mem_patterns;
+      }
+
+      // whether the shapes in the graph can be resolved from the input shapes doesn't depend on the bucket.
+      LOGS(logger_, INFO) << "The memory patterns can't be planned for the shape bucket upper bounds, "
+                          << "they are traced for each input shape instead. " << status.ErrorMessage();
+      mem_patterns_bucket_planning_failed_ = true;
+    }
+#endif
+    // a pattern traced for smaller shapes of the bucket doesn't fit the larger ones, so it is keyed on the exact
+    // input shapes.
+    key = input_shapes_key;
+    entry = FindCachedMemoryPattern(key);
+  }
+
+  if (entry == nullptr) {
 #ifdef ENABLE_TRAINING
-    auto mem_patterns = std::make_unique<MemoryPatternGroup>();
+    auto mem_patterns = std::make_shared<MemoryPatternGroup>();
     if (GeneratePatternGroupCache(input_shapes, feed_mlvalue_idxs, mem_patterns.get(), inferred_shapes).IsOK()) {
-      key = CalculateMemoryPatternsKey(input_shapes);
-      auto ptr = mem_patterns.get();
-      mem_patterns_[key] = std::move(mem_patterns);
-      shape_patterns_[key] = inferred_shapes;
-      return ptr;
+      CacheMemoryPattern(key, {mem_patterns, inferred_shapes, input_shapes_key, {}});
+      return mem_patterns;
     }
-    return nullptr;
-#else
-    ORT_UNUSED_PARAMETER(feed_mlvalue_idxs);
-    return nullptr;
 #endif
+    return nullptr;
   }
 
-  inferred_shapes = shape_patterns_[key];
-  return it->second.get();
+  // the inferred shapes only hold for the input shapes the pattern was generated with.
+  if (entry->input_shapes_key == input_shapes_key) {
+    inferred_shapes = entry->inferred_shapes;
+  }
+  return entry->mem_patterns;
 }
 
 void SessionState::ResolveMemoryPatternFlag() {
@@ -692,13 +965,21 @@ void SessionState::ResolveMemoryPatternFlag() {
 }
 
 Status SessionState::UpdateMemoryPatternGroupCache(const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes,
+                                                   const std::vector<int>& feed_mlvalue_idxs,
                                                    std::unique_ptr<MemoryPatternGroup> mem_patterns) const {
-  int64_t key = CalculateMemoryPatternsKey(input_shapes);
+  bool is_bucket_upper_bound;
+  int64_t key = CalculateMemoryPatternsKey(input_shapes, feed_mlvalue_idxs, memory_pattern_fixed_input_dims_,
+                                           memory_pattern_shape_buckets_, is_bucket_upper_bound);
+
+  const int64_t input_shapes_key = CalculateMemoryPatternsKey(input_shapes);
+  // only a pattern traced for the upper bound of a bucket fits all of its input shapes.
+  if (!is_bucket_upper_bound) {
+    key = input_shapes_key;
+  }
 
   std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
-  auto it = mem_patterns_.find(key);
-  if (it == mem_patterns_.end()) {
-    mem_patterns_[key] = std::move(mem_patterns);
+  if (FindCachedMemoryPattern(key) == nullptr) {
+    CacheMemoryPattern(key, {std::move(mem_patterns), {}, input_shapes_key, {}});
   }
 
   return Status::OK();
@@ -708,6 +989,31 @@ bool SessionState::GetEnableMemoryPattern() const { return enable_mem_pattern_;
 
 bool SessionState::GetEnableMemoryReuse() const { return enable_mem_reuse_; }
 
+size_t SessionState::GetRunRegionBlockSize(const OrtMemoryInfo& location) const {
+  std::lock_guard<OrtMutex> lock(run_region_block_sizes_lock_);
+  auto it = run_region_block_sizes_.find(location);
+  return it != run_region_block_sizes_.end() ? it->second : RegionAllocator::kDefaultInitialBlockSize;
+}
+
+void SessionState::UpdateRunRegionBlockSize(const OrtMemoryInfo& location, size_t peak_bytes_in_use) const {
+  std::lock_guard<OrtMutex> lock(run_region_block_sizes_lock_);
+  auto& block_size = run_region_block_sizes_[location];
+  block_size = std::max(block_size, peak_bytes_in_use);
+}
+
+void SessionState::RegisterOpTypesForSampling(profiling::SampledProfiler& sampled_profiler) {
+  sampled_op_type_ids_.assign(graph_viewer_->MaxNodeIndex(), profiling::SampledProfiler::kInvalidOpTypeId);
+  for (const auto& node : graph_viewer_->Nodes()) {
+    sampled_op_type_ids_[node.Index()] = sampled_profiler.RegisterOpType(node.OpType());
+  }
+
+  for (auto& node_to_subgraphs : subgraph_session_states_) {
+    for (auto& name_to_subgraph : node_to_subgraphs.second) {
+      name_to_subgraph.second->RegisterOpTypesForSampling(sampled_profiler);
+    }
+  }
+}
+
 common::Status SessionState::AddInputNameToNodeInfoMapping(const std::string& input_name, const NodeInfo& node_info) {
   // Graph partitioning should ensure an input is only consumed from one device. Copy nodes should have been inserted
   // to handle a scenario where an input is required on different devices by different nodes. Validate that.
@@ -833,6 +1139,39 @@ const NodeIndexInfo& SessionState::GetNodeIndexInfo() const {
   return *node_index_info_;
 }
 
+#if !defined(ORT_MINIMAL_BUILD) || defined(ENABLE_ORT_FORMAT_LOAD)
+// Gets the shapes and OrtValue indexes of the graph inputs if all the shapes are fixed.
+// The memory patterns saved in ORT format models are keyed on the input shapes in this order.
+static bool GetFixedGraphInputShapes(const GraphViewer& graph_viewer, const OrtValueNameIdxMap& ort_value_name_idx_map,
+                                     std::vector<TensorShape>& input_shapes, std::vector<int>& input_idxs) {
+  for (const auto* input : graph_viewer.GetInputs()) {
+    const auto* shape = input->Shape();
+    if (shape == nullptr) {
+      return false;
+    }
+
+    std::vector<int64_t> dims;
+    dims.reserve(shape->dim_size());
+    for (const auto& dim : shape->dim()) {
+      if (!dim.has_dim_value() || dim.dim_value() < 0) {
+        return false;
+      }
+      dims.push_back(dim.dim_value());
+    }
+
+    int idx;
+    if (!ort_value_name_idx_map.GetIdx(input->Name(), idx).IsOK()) {
+      return false;
+    }
+
+    input_shapes.emplace_back(std::move(dims));
+    input_idxs.push_back(idx);
+  }
+
+  return true;
+}
+#endif
+
 #if !defined(ORT_MINIMAL_BUILD)
 void SessionState::UpdateToBeExecutedNodes(const std::vector<int>& fetch_mlvalue_idxs) {
   std::vector<int> sorted_idxs = fetch_mlvalue_idxs;
@@ -890,6 +1229,109 @@ static Status GetSubGraphSessionStatesOrtFormat(
   return Status::OK();
 }
 
+Status SessionState::SaveExecutionPlanToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
+                                                  flatbuffers::Offset<fbs::ExecutionPlan>& fbs_execution_plan) const {
+  ORT_RETURN_IF(p_seq_exec_plan_ == nullptr, "The execution plan has not been created.");
+  const auto& plan = *p_seq_exec_plan_;
+
+  // the locations are saved once and referred to by their index
+  std::vector<OrtMemoryInfo> locations;
+  const auto get_location_index = [&locations](const OrtMemoryInfo& location) {
+    auto it = std::find(locations.cbegin(), locations.cend(), location);
+    if (it == locations.cend()) {
+      it = locations.insert(locations.cend(), location);
+    }
+    return gsl::narrow<uint32_t>(it - locations.cbegin());
+  };
+
+  std::vector<flatbuffers::Offset<fbs::ValueAllocationPlan>> fbs_allocation_plan;
+  fbs_allocation_plan.reserve(plan.allocation_plan.size());
+  std::string name;
+  for (size_t idx = 0; idx < plan.allocation_plan.size(); ++idx) {
+    const auto& value_plan = plan.allocation_plan[idx];
+    ORT_RETURN_IF_ERROR(ort_value_name_idx_map_.GetName(gsl::narrow<int>(idx), name));
+
+    flatbuffers::Offset<flatbuffers::String> fbs_value_type = 0;
+    if (value_plan.value_type != nullptr) {
+      const std::string value_type = DataTypeImpl::ToString(value_plan.value_type);
+      ORT_RETURN_IF_NOT(value_plan.value_type->GetTypeProto() != nullptr &&
+                            DataTypeImpl::GetDataType(value_type) == value_plan.value_type,
+                        "The type of '", name, "' can't be saved.");
+      fbs_value_type = builder.CreateString(value_type);
+    }
+
+    const auto& starts = value_plan.program_counter.Starts();
+    const auto& ends = value_plan.program_counter.Ends();
+    const auto fbs_starts = builder.CreateVector(std::vector<uint64_t>(starts.cbegin(), starts.cend()));
+    const auto fbs_ends = builder.CreateVector(std::vector<uint64_t>(ends.cbegin(), ends.cend()));
+
+    fbs_allocation_plan.push_back(
+        fbs::CreateValueAllocationPlan(builder, builder.CreateString(name), static_cast<int32_t>(value_plan.alloc_kind),
+                                       fbs_value_type, get_location_index(value_plan.location),
+                                       value_plan.reused_buffer, value_plan.create_fence_if_async,
+                                       fbs_starts, fbs_ends));
+  }
+
+  std::vector<fbs::NodeExecutionPlan> node_execution_plans;
+  node_execution_plans.reserve(plan.execution_plan.size());
+  for (const auto& node_plan : plan.execution_plan) {
+    node_execution_plans.emplace_back(gsl::narrow<uint32_t>(node_plan.node_index),
+                                      node_plan.free_from_index, node_plan.free_to_index);
+  }
+
+  const std::vector<uint8_t> node_has_fence(plan.node_has_fence.cbegin(), plan.node_has_fence.cend());
+
+  // the memory patterns only depend on the shapes of the graph inputs, so they are known up front if those are fixed.
+  // they are generated from the program counters of the values, which requires sequential execution.
+  std::vector<flatbuffers::Offset<fbs::MemoryPattern>> fbs_memory_patterns;
+  std::vector<TensorShape> input_shapes;
+  std::vector<int> input_idxs;
+  if (parent_ == nullptr && plan_execution_mode_ == ExecutionMode::ORT_SEQUENTIAL &&
+      GetFixedGraphInputShapes(*graph_viewer_, ort_value_name_idx_map_, input_shapes, input_idxs)) {
+    const std::vector<std::reference_wrapper<const TensorShape>> input_shape_refs(input_shapes.cbegin(),
+                                                                                  input_shapes.cend());
+    MemoryPatternGroup mem_patterns;
+    std::unordered_map<int, TensorShape> resolved_shapes;
+    const auto status = GeneratePatternGroupCache(input_shape_refs, input_idxs, &mem_patterns, resolved_shapes);
+    if (status.IsOK()) {
+      for (size_t i = 0; i < mem_patterns.locations.size(); ++i) {
+        const auto& pattern = mem_patterns.patterns[i];
+        std::vector<int32_t> value_indices;
+        std::vector<uint64_t> offsets;
+        std::vector<uint64_t> sizes;
+        for (const auto& [value_idx, block] : pattern.GetPatternsMap()) {
+          value_indices.push_back(value_idx);
+          offsets.push_back(block.offset_);
+          sizes.push_back(block.size_);
+        }
+
+        fbs_memory_patterns.push_back(
+            fbs::CreateMemoryPatternDirect(builder, get_location_index(mem_patterns.locations[i]),
+                                           pattern.PeakSize(), &value_indices, &offsets, &sizes));
+      }
+    } else {
+      LOGS(logger_, INFO) << "The memory patterns for the fixed input shapes can't be saved. "
+                          << status.ErrorMessage();
+    }
+  }
+
+  std::vector<flatbuffers::Offset<fbs::MemoryLocation>> fbs_locations;
+  fbs_locations.reserve(locations.size());
+  for (const auto& location : locations) {
+    fbs_locations.push_back(fbs::CreateMemoryLocationDirect(builder, location.name, location.id,
+                                                            static_cast<int32_t>(location.mem_type),
+                                                            static_cast<int32_t>(location.alloc_type)));
+  }
+
+  fbs_execution_plan = fbs::CreateExecutionPlanDirect(
+      builder, static_cast<int32_t>(plan_execution_mode_), static_cast<int32_t>(plan_execution_order_),
+      plan_enable_mem_reuse_, &fbs_locations, &fbs_allocation_plan, &plan.initializer_allocation_order,
+      &plan.activation_allocation_order, &node_execution_plans, &node_has_fence, &plan.to_be_freed,
+      &fbs_memory_patterns);
+
+  return Status::OK();
+}
+
 Status SessionState::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
                                      flatbuffers::Offset<fbs::SessionState>& fbs_session_state) const {
   size_t size = kernel_create_info_map_.size();
@@ -909,7 +1351,44 @@ Status SessionState::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
   ORT_RETURN_IF_ERROR(
       GetSubGraphSessionStatesOrtFormat(builder, subgraph_session_states_, sub_graph_session_states));
 
-  fbs_session_state = fbs::CreateSessionStateDirect(builder, kernels, &sub_graph_session_states);
+  // Pre-packed weights
+  flatbuffers::Offset<fbs::PrePackedWeights> prepacked_weights = 0;
+  if (!prepacked_weights_to_save_.empty()) {
+    std::vector<flatbuffers::Offset<fbs::PrePackedWeight>> fbs_prepacked_weights;
+    fbs_prepacked_weights.reserve(prepacked_weights_to_save_.size());
+    for (const auto& [node_and_input_idx, weights] : prepacked_weights_to_save_) {
+      std::vector<flatbuffers::Offset<fbs::PrePackedBuffer>> fbs_buffers;
+      fbs_buffers.reserve(weights.buffers_.size());
+      for (size_t i = 0; i < weights.buffers_.size(); ++i) {
+        // some kernels use a null placeholder buffer, which is saved as an empty one
+        const auto* data = static_cast<const uint8_t*>(weights.buffers_[i].get());
+        auto fbs_data = data ? builder.CreateVector(data, weights.buffer_sizes_[i])
+                             : builder.CreateVector(std::vector<uint8_t>());
+        fbs_buffers.push_back(fbs::CreatePrePackedBuffer(builder, fbs_data));
+      }
+
+      const auto node_idx = node_and_input_idx.first;
+      fbs_prepacked_weights.push_back(
+          fbs::CreatePrePackedWeightDirect(builder, gsl::narrow<uint32_t>(node_idx), node_and_input_idx.second,
+                                           GetNodeKernelCreateInfo(node_idx).kernel_def->GetHash(), &fbs_buffers));
+    }
+
+    const auto isa_fingerprint = experimental::utils::GetPrePackedWeightsIsaFingerprint();
+    prepacked_weights = fbs::CreatePrePackedWeightsDirect(builder, isa_fingerprint.c_str(), &fbs_prepacked_weights);
+  }
+
+  // Execution plan
+  flatbuffers::Offset<fbs::ExecutionPlan> execution_plan = 0;
+  if (save_execution_plan_) {
+    const auto status = SaveExecutionPlanToOrtFormat(builder, execution_plan);
+    if (!status.IsOK()) {
+      LOGS(logger_, WARNING) << "The execution plan can't be saved in the ORT format model. " << status.ErrorMessage();
+      execution_plan = 0;
+    }
+  }
+
+  fbs_session_state = fbs::CreateSessionStateDirect(builder, kernels, &sub_graph_session_states, prepacked_weights,
+                                                    execution_plan);
   return Status::OK();
 }
 
@@ -998,6 +1477,29 @@ Status SessionState::LoadFromOrtFormat(const fbs::SessionState& fbs_session_stat
     }
   }
 
+  // the pre-packed weights are used when the kernels are created, if the runtime and the CPU match the ones that
+  // saved them
+  const auto* fbs_prepacked_weights = fbs_session_state.prepacked_weights();
+  if (fbs_prepacked_weights != nullptr && fbs_prepacked_weights->weights() != nullptr) {
+    const auto isa_fingerprint = experimental::utils::GetPrePackedWeightsIsaFingerprint();
+    const auto* saved_isa_fingerprint = fbs_prepacked_weights->isa_fingerprint();
+    if (saved_isa_fingerprint != nullptr && saved_isa_fingerprint->str() == isa_fingerprint) {
+      for (const auto* fbs_prepacked_weight : *fbs_prepacked_weights->weights()) {
+        saved_prepacked_weights_.emplace(
+            std::make_pair(static_cast<NodeIndex>(fbs_prepacked_weight->node_index()),
+                           fbs_prepacked_weight->input_index()),
+            fbs_prepacked_weight);
+      }
+    } else {
+      LOGS(logger_, INFO) << "The pre-packed weights in the ORT format model were saved by a different "
+                          << "ONNX Runtime version or on a CPU with different features (" << (saved_isa_fingerprint ? saved_isa_fingerprint->str() : "")
+                          << " vs. " << isa_fingerprint << "). The weights will be pre-packed again.";
+    }
+  }
+
+  // the execution plan is used when the session state is finalized, if it matches the graph and the session options
+  saved_execution_plan_ = fbs_session_state.execution_plan();
+
   if (!subgraph_session_states_.empty()) {
     for (const auto& [node_idx, session_states] : subgraph_session_states_) {
       for (const auto& [attr_name, subgraph_session_state] : session_states) {
@@ -1011,6 +1513,182 @@ Status SessionState::LoadFromOrtFormat(const fbs::SessionState& fbs_session_stat
 
   return Status::OK();
 }
+
+Status SessionState::LoadExecutionPlanFromOrtFormat(const fbs::ExecutionPlan& fbs_execution_plan,
+                                                    const SessionOptions& session_options) {
+  ORT_RETURN_IF_NOT(fbs_execution_plan.execution_mode() == static_cast<int32_t>(session_options.execution_mode) &&
+                        fbs_execution_plan.execution_order() ==
+                            static_cast<int32_t>(session_options.execution_order) &&
+                        fbs_execution_plan.enable_mem_reuse() == session_options.enable_mem_reuse,
+                    "It was created with different session options.");
+
+  const auto* fbs_locations = fbs_execution_plan.locations();
+  const auto* fbs_allocation_plan = fbs_execution_plan.allocation_plan();
+  const auto* fbs_node_plans = fbs_execution_plan.node_execution_plans();
+  const auto* fbs_node_has_fence = fbs_execution_plan.node_has_fence();
+  ORT_RETURN_IF(fbs_locations == nullptr || fbs_allocation_plan == nullptr || fbs_node_plans == nullptr ||
+                    fbs_node_has_fence == nullptr,
+                "It is incomplete.");
+
+  // use the memory info of the allocators of this session, as the saved names don't outlive the model bytes
+  const OrtMemoryInfo default_location = AllocPlanPerValue().location;
+  std::vector<OrtMemoryInfo> locations;
+  locations.reserve(fbs_locations->size());
+  for (const auto* fbs_location : *fbs_locations) {
+    ORT_RETURN_IF(fbs_location->name() == nullptr, "A memory location has no name.");
+    const OrtMemoryInfo location(fbs_location->name()->c_str(),
+                                 static_cast<OrtAllocatorType>(fbs_location->alloc_type()), OrtDevice(),
+                                 fbs_location->id(), static_cast<OrtMemType>(fbs_location->mem_type()));
+    if (location == default_location) {
+      locations.push_back(default_location);
+      continue;
+    }
+
+    const auto entry = allocators_.find(location);
+    ORT_RETURN_IF(entry == allocators_.cend(), "There is no allocator for ", location.ToString());
+    OrtMemoryInfo session_location = entry->first;
+    session_location.alloc_type = location.alloc_type;
+    locations.push_back(session_location);
+  }
+
+  const size_t num_values = gsl::narrow<size_t>(ort_value_name_idx_map_.MaxIdx() + 1);
+  const auto is_valid_value_idx = [num_values](int32_t idx) {
+    return idx >= 0 && static_cast<size_t>(idx) < num_values;
+  };
+
+  ORT_RETURN_IF_NOT(fbs_allocation_plan->size() == num_values, "The number of values doesn't match.");
+  auto plan = std::make_unique<SequentialExecutionPlan>();
+  plan->allocation_plan.resize(num_values);
+  std::string name;
+  for (size_t idx = 0; idx < num_values; ++idx) {
+    const auto& fbs_value_plan = *fbs_allocation_plan->Get(gsl::narrow<flatbuffers::uoffset_t>(idx));
+    ORT_RETURN_IF_ERROR(ort_value_name_idx_map_.GetName(gsl::narrow<int>(idx), name));
+    ORT_RETURN_IF(fbs_value_plan.name() == nullptr || fbs_value_plan.name()->str() != name,
+                  "The value with index ", idx, " is not '", name, "'.");
+
+    const auto alloc_kind = fbs_value_plan.alloc_kind();
+    ORT_RETURN_IF_NOT(alloc_kind >= static_cast<int32_t>(AllocKind::kNotSet) &&
+                          alloc_kind <= static_cast<int32_t>(AllocKind::kAllocatedExternally) &&
+                          fbs_value_plan.location_index() < locations.size() &&
+                          is_valid_value_idx(fbs_value_plan.reused_buffer()),
+                      "The plan of '", name, "' is invalid.");
+
+    auto& value_plan = plan->allocation_plan[idx];
+    value_plan.alloc_kind = static_cast<AllocKind>(alloc_kind);
+    if (fbs_value_plan.value_type() != nullptr) {
+      value_plan.value_type = DataTypeImpl::GetDataType(fbs_value_plan.value_type()->str());
+      ORT_RETURN_IF(value_plan.value_type == nullptr,
+                    "The type of '", name, "' is unknown: ", fbs_value_plan.value_type()->str());
+    }
+    value_plan.location = locations[fbs_value_plan.location_index()];
+    value_plan.reused_buffer = fbs_value_plan.reused_buffer();
+    value_plan.create_fence_if_async = fbs_value_plan.create_fence_if_async();
+
+    // check the ordering ProgramCounter enforces, so an invalid model fails here instead of throwing
+    const auto* starts = fbs_value_plan.program_counter_starts();
+    const auto* ends = fbs_value_plan.program_counter_ends();
+    if (starts != nullptr || ends != nullptr) {
+      ORT_RETURN_IF_NOT(starts != nullptr && ends != nullptr && starts->size() == ends->size(),
+                        "The program counter of '", name, "' is invalid.");
+      for (flatbuffers::uoffset_t i = 0; i < starts->size(); ++i) {
+        ORT_RETURN_IF_NOT((i == 0 || starts->Get(i) > ends->Get(i - 1)) && ends->Get(i) >= starts->Get(i),
+                          "The program counter of '", name, "' is invalid.");
+        value_plan.program_counter.AddStart(gsl::narrow<size_t>(starts->Get(i)));
+        value_plan.program_counter.AddEnd(gsl::narrow<size_t>(ends->Get(i)));
+      }
+    }
+  }
+
+  const auto load_value_idxs = [&is_valid_value_idx](const flatbuffers::Vector<int32_t>* fbs_idxs,
+                                                     std::vector<OrtValueIndex>& idxs) {
+    if (fbs_idxs != nullptr) {
+      idxs.reserve(fbs_idxs->size());
+      for (const auto idx : *fbs_idxs) {
+        ORT_RETURN_IF_NOT(is_valid_value_idx(idx), "Invalid value index ", idx);
+        idxs.push_back(idx);
+      }
+    }
+
+    return Status::OK();
+  };
+
+  ORT_RETURN_IF_ERROR(load_value_idxs(fbs_execution_plan.initializer_allocation_order(),
+                                      plan->initializer_allocation_order));
+  ORT_RETURN_IF_ERROR(load_value_idxs(fbs_execution_plan.activation_allocation_order(),
+                                      plan->activation_allocation_order));
+  ORT_RETURN_IF_ERROR(load_value_idxs(fbs_execution_plan.to_be_freed(), plan->to_be_freed));
+
+  // every node of the graph has to be executed once
+  ORT_RETURN_IF_NOT(fbs_node_plans->size() == static_cast<size_t>(graph_viewer_->NumberOfNodes()) &&
+                        fbs_node_has_fence->size() == static_cast<size_t>(graph_viewer_->MaxNodeIndex()),
+                    "The number of nodes doesn't match.");
+  std::vector<bool> node_planned(graph_viewer_->MaxNodeIndex(), false);
+  const int num_to_be_freed = gsl::narrow<int>(plan->to_be_freed.size());
+  plan->execution_plan.reserve(fbs_node_plans->size());
+  for (const auto* fbs_node_plan : *fbs_node_plans) {
+    const NodeIndex node_index = fbs_node_plan->node_index();
+    ORT_RETURN_IF(node_index >= node_planned.size() || graph_viewer_->GetNode(node_index) == nullptr ||
+                      node_planned[node_index],
+                  "Node ", node_index, " doesn't exist or is planned more than once.");
+    node_planned[node_index] = true;
+
+    const int free_from_index = fbs_node_plan->free_from_index();
+    const int free_to_index = fbs_node_plan->free_to_index();
+    ORT_RETURN_IF_NOT(free_from_index > free_to_index ||
+                          (free_from_index >= 0 && free_to_index < num_to_be_freed),
+                      "The values to free after node ", node_index, " are invalid.");
+
+    plan->execution_plan.emplace_back(node_index);
+    plan->execution_plan.back().free_from_index = free_from_index;
+    plan->execution_plan.back().free_to_index = free_to_index;
+  }
+
+  plan->node_has_fence.assign(fbs_node_has_fence->begin(), fbs_node_has_fence->end());
+
+  // the memory patterns are keyed on the fixed shapes of the graph inputs, which the saved ones were generated for
+  std::unique_ptr<MemoryPatternGroup> mem_patterns;
+  std::vector<TensorShape> input_shapes;
+  std::vector<int> input_idxs;
+  const auto* fbs_memory_patterns = fbs_execution_plan.memory_patterns();
+  if (fbs_memory_patterns != nullptr && fbs_memory_patterns->size() > 0 && enable_mem_pattern_ &&
+      GetFixedGraphInputShapes(*graph_viewer_, ort_value_name_idx_map_, input_shapes, input_idxs)) {
+    mem_patterns = std::make_unique<MemoryPatternGroup>();
+    for (const auto* fbs_pattern : *fbs_memory_patterns) {
+      const auto* value_idxs = fbs_pattern->value_indices();
+      const auto* offsets = fbs_pattern->offsets();
+      const auto* sizes = fbs_pattern->sizes();
+      ORT_RETURN_IF_NOT(fbs_pattern->location_index() < locations.size() && value_idxs != nullptr &&
+                            offsets != nullptr && sizes != nullptr && value_idxs->size() == offsets->size() &&
+                            value_idxs->size() == sizes->size(),
+                        "A memory pattern is invalid.");
+
+      MemoryPattern pattern;
+      pattern.peak_size_ = gsl::narrow<size_t>(fbs_pattern->peak_size());
+      for (flatbuffers::uoffset_t i = 0; i < value_idxs->size(); ++i) {
+        const auto value_idx = value_idxs->Get(i);
+        const auto offset = offsets->Get(i);
+        const auto size = sizes->Get(i);
+        ORT_RETURN_IF_NOT(is_valid_value_idx(value_idx) && offset <= pattern.peak_size_ &&
+                              size <= pattern.peak_size_ - offset,
+                          "The memory block of value ", value_idx, " is invalid.");
+        pattern.patterns_.emplace(value_idx, MemoryBlock(gsl::narrow<size_t>(offset), gsl::narrow<size_t>(size)));
+      }
+
+      mem_patterns->locations.push_back(locations[fbs_pattern->location_index()]);
+      mem_patterns->patterns.push_back(std::move(pattern));
+    }
+  }
+
+  p_seq_exec_plan_ = std::move(plan);
+
+  if (mem_patterns) {
+    const std::vector<std::reference_wrapper<const TensorShape>> input_shape_refs(input_shapes.cbegin(),
+                                                                                  input_shapes.cend());
+    ORT_RETURN_IF_ERROR(UpdateMemoryPatternGroupCache(input_shape_refs, input_idxs, std::move(mem_patterns)));
+  }
+
+  return Status::OK();
+}
 #endif
 
 // Calculate the use count of a constant initialized tensor, including the use in subgraph.
@@ -1051,6 +1729,13 @@ Status SessionState::FinalizeSessionState(const std::basic_string<PATH_CHAR_TYPE
   // so also do it recursively when calling PopulateKernelCreateInfo for consistency.
   ORT_RETURN_IF_ERROR(CreateSubgraphSessionState());
 
+  save_prepacked_weights_ =
+      saving_ort_format &&
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigSavePrePackedWeights, "0") == "1";
+  save_execution_plan_ =
+      saving_ort_format &&
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigSaveExecutionPlan, "0") == "1";
+
   if (serialized_session_state) {
 #if defined(ENABLE_ORT_FORMAT_LOAD)
     ORT_RETURN_IF_ERROR(LoadFromOrtFormat(*serialized_session_state, kernel_registry_manager));
@@ -1230,15 +1915,78 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
                   });
   }
 
+  use_run_region_allocator_ =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseRunRegionAllocator, "0") == "1";
+  use_dataflow_executor_ =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseDataflowExecutor, "0") == "1";
+
+  const std::string shape_buckets =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemoryPatternShapeBuckets, "");
+  memory_pattern_shape_buckets_.clear();
+  for (const auto& bucket_str : utils::SplitString(shape_buckets, ",")) {
+    int64_t bucket;
+    ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(std::string{bucket_str}, bucket) && bucket > 0 &&
+                          (memory_pattern_shape_buckets_.empty() || bucket > memory_pattern_shape_buckets_.back()),
+                      "Invalid value for ", kOrtSessionOptionsConfigMemoryPatternShapeBuckets, ": '", shape_buckets,
+                      "'. Expected a comma separated list of ascending positive integers.");
+    memory_pattern_shape_buckets_.push_back(bucket);
+  }
+
+  // record which dims of the graph inputs are fixed in the model, as only the symbolic dims are rounded to the
+  // shape buckets. the dims of an input without a shape are all symbolic.
+  memory_pattern_fixed_input_dims_.clear();
+  if (!memory_pattern_shape_buckets_.empty()) {
+    for (const auto* input : graph_viewer_->GetInputs()) {
+      int idx;
+      if (!ort_value_name_idx_map_.GetIdx(input->Name(), idx).IsOK()) {
+        continue;
+      }
+
+      auto& fixed_dims = memory_pattern_fixed_input_dims_[idx];
+      if (const auto* shape = input->Shape()) {
+        for (const auto& dim : shape->dim()) {
+          fixed_dims.push_back(dim.has_dim_value());
+        }
+      }
+    }
+  }
+
+  ORT_RETURN_IF_NOT(
+      TryParseStringWithClassicLocale(
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemoryPatternCacheCapacity, "0"),
+          mem_patterns_capacity_),
+      "Invalid value for ", kOrtSessionOptionsConfigMemoryPatternCacheCapacity);
+
   SubgraphsKernelCreateInfoMaps subgraphs_kernel_create_info_maps;
   AccumulateAllNestedSubgraphsInfo(*this, "", 0, subgraphs_kernel_create_info_maps);
 
-  SequentialPlannerContext context(session_options.execution_mode, session_options.execution_order, session_options.enable_mem_reuse);
-  ORT_RETURN_IF_ERROR(SequentialPlanner::CreatePlan(parent_node, *graph_viewer_, valid_outer_scope_node_args,
-                                                    execution_providers_, kernel_create_info_map_,
-                                                    subgraphs_kernel_create_info_maps,
-                                                    outer_scope_node_arg_to_location_map,
-                                                    ort_value_name_idx_map_, context, p_seq_exec_plan_));
+  used_saved_execution_plan_ = false;
+#if defined(ENABLE_ORT_FORMAT_LOAD) && !defined(ORT_MEMORY_PROFILE)
+  // the memory profiler needs the life intervals of the values, which aren't saved
+  if (saved_execution_plan_ != nullptr) {
+    const auto status = LoadExecutionPlanFromOrtFormat(*saved_execution_plan_, session_options);
+    used_saved_execution_plan_ = status.IsOK();
+    if (!used_saved_execution_plan_) {
+      LOGS(logger_, INFO) << "The execution plan in the ORT format model can't be used and will be created again. "
+                          << status.ErrorMessage();
+    }
+  }
+#endif
+  saved_execution_plan_ = nullptr;
+
+  if (!used_saved_execution_plan_) {
+    SequentialPlannerContext context(session_options.execution_mode, session_options.execution_order,
+                                     session_options.enable_mem_reuse);
+    ORT_RETURN_IF_ERROR(SequentialPlanner::CreatePlan(parent_node, *graph_viewer_, valid_outer_scope_node_args,
+                                                      execution_providers_, kernel_create_info_map_,
+                                                      subgraphs_kernel_create_info_maps,
+                                                      outer_scope_node_arg_to_location_map,
+                                                      ort_value_name_idx_map_, context, p_seq_exec_plan_));
+  }
+
+  plan_execution_mode_ = session_options.execution_mode;
+  plan_execution_order_ = session_options.execution_order;
+  plan_enable_mem_reuse_ = session_options.enable_mem_reuse;
   //Record the allocation plan
 
   // Uncomment the below to dump the allocation plan to std::cout
@@ -1271,6 +2019,11 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
 
   const auto& initializer_allocation_order = p_seq_exec_plan_->initializer_allocation_order;
 
+  // the intra-op thread pool is idle while the session is initialized, so independent work is spread over it
+  const bool parallel_initialization =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDisableParallelInitialization,
+                                                        "0") != "1";
+
   // move initializers from TensorProto instances in Graph to OrtValue instances in SessionState
   ORT_RETURN_IF_ERROR(
       session_state_utils::SaveInitializedTensors(
@@ -1280,7 +2033,8 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
           [this](int idx, const OrtValue& value, const OrtCallback& d, bool constant, bool sparse) -> Status {
             return AddInitializedTensor(idx, value, &d, constant, sparse);
           },
-          logger_, data_transfer_mgr_, *p_seq_exec_plan_.get(), session_options));
+          logger_, data_transfer_mgr_, *p_seq_exec_plan_.get(), session_options,
+          parallel_initialization ? thread_pool_ : nullptr));
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   //Record Weight allocation info on device
   MemoryInfo::RecordInitializerAllocInfo(GetInitializedTensors());
@@ -1301,7 +2055,8 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
 
   if (disable_prepacking != "1") {
     ORT_RETURN_IF_ERROR(PrepackConstantInitializedTensors(constant_initializers_use_count,
-                                                          session_options.initializers_to_share_map));
+                                                          session_options.initializers_to_share_map,
+                                                          parallel_initialization));
   }
 #endif
 
@@ -1327,6 +2082,8 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
                   "' OpType:", node.OpType(), " Index:", node.Index(), " Attribute:", attr_name);
 
       SessionState& subgraph_session_state = *entry->second;
+      subgraph_session_state.save_prepacked_weights_ = save_prepacked_weights_;
+      subgraph_session_state.save_execution_plan_ = save_execution_plan_;
 
       // recurse
 
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <list>
 #include <memory>
 #include <map>
 #include <unordered_map>
@@ -47,6 +48,8 @@ namespace onnxruntime {
 namespace experimental {
 namespace fbs {
 struct SessionState;
+struct PrePackedWeight;
+struct ExecutionPlan;
 }  // namespace fbs
 }  // namespace experimental
 
@@ -208,18 +211,45 @@ class SessionState {
   profiling::Profiler& Profiler() const noexcept { return profiler_; }
 
   /**
-  Get cached memory pattern based on input shapes
+  Register the op types of the nodes of the graph and its subgraphs with the sampled profiler, and keep their ids.
   */
-  const MemoryPatternGroup* GetMemoryPatternGroup(
+  void RegisterOpTypesForSampling(profiling::SampledProfiler& sampled_profiler);
+
+  /**
+  Decide whether the sampled profiler samples an execution of the graph. 1 in N executions of this graph is sampled,
+  independently of the executions of the other graphs that share the profiler.
+  */
+  bool ShouldSampleExecution(profiling::SampledProfiler& sampled_profiler) const {
+    return sampled_profiler.ShouldSample(sampled_executions_count_);
+  }
+
+  /**
+  Get the id of the op type of a node in the sampled profiler, or SampledProfiler::kInvalidOpTypeId if the op types
+  were not registered.
+  */
+  size_t GetSampledOpTypeId(NodeIndex node_index) const {
+    return node_index < sampled_op_type_ids_.size() ? sampled_op_type_ids_[node_index]
+                                                    : profiling::SampledProfiler::kInvalidOpTypeId;
+  }
+
+  /**
+  Get cached memory pattern based on input shapes.
+  If memory pattern shape buckets are configured, the pattern may have been generated for larger input shapes in
+  the same bucket, in which case inferred_shapes is left empty.
+  The returned pattern stays valid after it's evicted from the cache.
+  */
+  std::shared_ptr<const MemoryPatternGroup> GetMemoryPatternGroup(
       const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes,
       const std::vector<int>& feed_mlvalue_idxs,
       std::unordered_map<int, TensorShape>& inferred_shapes) const;
 
   /**
   Set generated memory pattern with a given input shapes.
+  A pattern traced for shapes below the upper bound of their shape bucket is cached under the exact shapes only.
   Const as it's an internal cache update only.
   */
   Status UpdateMemoryPatternGroupCache(const std::vector<std::reference_wrapper<const TensorShape>>& input_shape,
+                                       const std::vector<int>& feed_mlvalue_idxs,
                                        std::unique_ptr<MemoryPatternGroup> mem_patterns) const;
 
   bool GetUseDeterministicCompute() const { return use_deterministic_compute_; }
@@ -235,6 +265,28 @@ class SessionState {
 
   bool GetEnableMemoryReuse() const;
 
+  /**
+  Get whether transient allocations of each Run are served by a region allocator owned by the ExecutionFrame.
+  */
+  bool GetUseRunRegionAllocator() const { return use_run_region_allocator_; }
+
+  /**
+  Get whether the nodes are run by the DataflowExecutor on the intra-op thread pool in parallel execution mode.
+  */
+  bool GetUseDataflowExecutor() const { return use_dataflow_executor_; }
+
+  /**
+  Get the initial block size of the Run region allocator for the given location. This is the peak usage of
+  the regions of previous Runs, so that a Run typically needs a single block.
+  */
+  size_t GetRunRegionBlockSize(const OrtMemoryInfo& location) const;
+
+  /**
+  Record the peak usage of a Run region allocator for the given location.
+  Const as it's an internal cache update only.
+  */
+  void UpdateRunRegionBlockSize(const OrtMemoryInfo& location, size_t peak_bytes_in_use) const;
+
   /**
   Update enable_mem_pattern_ flag according to the presence of graph inputs' shape
   If any one of the graph input is shapeless, enable_mem_pattern_ will be set to false
@@ -325,6 +377,14 @@ class SessionState {
     return used_shared_pre_packed_weights_counter_;
   }
 
+  size_t GetUsedSavedPrePackedWeightCounter() const {
+    return used_saved_pre_packed_weights_counter_;
+  }
+
+  bool UsedSavedExecutionPlan() const {
+    return used_saved_execution_plan_;
+  }
+
   const KernelCreateInfoMap& GetKernelCreateInfoMap() const {
     return kernel_create_info_map_;
   }
@@ -361,9 +421,16 @@ class SessionState {
   /**
   * Prepack the constant initialized tensors for better performance.
   * The original constant initialized tensors will be removed to save memory.
+  * If parallel is true, the CPU kernels are pre-packed in parallel on the intra-op thread pool.
   */
   Status PrepackConstantInitializedTensors(std::unordered_map<std::string, size_t>& constant_initializers_use_count,
-                                           const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map);
+                                           const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map,
+                                           bool parallel);
+
+  // Hands the pre-packed buffers saved in the ORT format model for the input of the node to the kernel.
+  // is_packed is false if there are none or the kernel can't use them.
+  Status UseSavedPrePackedWeights(const Node& node, int input_idx, OpKernel& kernel, const Tensor& tensor,
+                                  /*out*/ bool& is_packed) const;
 
   SessionState* GetMutableSubgraphSessionState(onnxruntime::NodeIndex index, const std::string& attribute_name);
 
@@ -385,7 +452,20 @@ class SessionState {
                                   const std::unordered_map<OrtValueName, OrtMemoryInfo>& outer_scope_node_arg_to_location_map = {},
                                   bool graph_info_already_created = false);
 
-#ifdef ENABLE_TRAINING
+#if !defined(ORT_MINIMAL_BUILD)
+  Status SaveExecutionPlanToOrtFormat(
+      flatbuffers::FlatBufferBuilder& builder,
+      flatbuffers::Offset<onnxruntime::experimental::fbs::ExecutionPlan>& fbs_execution_plan) const;
+#endif
+
+#if defined(ENABLE_ORT_FORMAT_LOAD)
+  // Sets the execution plan and caches the memory patterns saved in the ORT format model.
+  // Fails if they don't match the graph or the session options, in which case nothing is set.
+  Status LoadExecutionPlanFromOrtFormat(const onnxruntime::experimental::fbs::ExecutionPlan& fbs_execution_plan,
+                                        const SessionOptions& session_options);
+#endif
+
+#if !defined(ORT_MINIMAL_BUILD) || defined(ENABLE_TRAINING)
   Status GeneratePatternGroupCache(
       const std::vector<std::reference_wrapper<const TensorShape>>& input_shape,
       const std::vector<int>& feed_mlvalue_idxs,
@@ -470,15 +550,67 @@ class SessionState {
   const logging::Logger& logger_;
   profiling::Profiler& profiler_;
 
+  // the number of executions of the graph, to sample 1 in N of them with the sampled profiler.
+  mutable std::atomic<uint64_t> sampled_executions_count_{0};
+
+  // the id of the op type of each node in the sampled profiler, indexed by NodeIndex.
+  std::vector<size_t> sampled_op_type_ids_;
+
   // switch for enable memory pattern optimization or not.
   bool enable_mem_pattern_;
 
   // lock for the mem_patterns_
   mutable OrtMutex mem_patterns_lock_;
 
-  // cache for the generated mem_patterns. key is calculated based on input shapes.
-  mutable std::map<int64_t, std::unique_ptr<MemoryPatternGroup>> mem_patterns_;
-  mutable std::map<int64_t, std::unordered_map<int, TensorShape>> shape_patterns_;
+  struct CachedMemoryPattern {
+    std::shared_ptr<const MemoryPatternGroup> mem_patterns;
+    // the shapes inferred from the input shapes the pattern was generated with.
+    std::unordered_map<int, TensorShape> inferred_shapes;
+    // key of the input shapes the pattern was generated with.
+    int64_t input_shapes_key;
+    // position in mem_patterns_lru_.
+    std::list<int64_t>::iterator lru_position;
+  };
+
+  // look up the cache entry for key and mark it as most recently used. mem_patterns_lock_ must be held.
+  CachedMemoryPattern* FindCachedMemoryPattern(int64_t key) const;
+
+  // insert or replace the cache entry for key, evicting the least recently used entries over the capacity.
+  // mem_patterns_lock_ must be held.
+  void CacheMemoryPattern(int64_t key, CachedMemoryPattern entry) const;
+
+  // cache for the generated mem_patterns. key is calculated based on input shapes, rounded up to the
+  // memory_pattern_shape_buckets_ for the patterns that fit all input shapes in the buckets.
+  mutable std::map<int64_t, CachedMemoryPattern> mem_patterns_;
+
+  // keys of mem_patterns_, most recently used first.
+  mutable std::list<int64_t> mem_patterns_lru_;
+
+  // maximum number of entries in mem_patterns_. 0 is unlimited.
+  size_t mem_patterns_capacity_ = 0;
+
+  // ascending upper bounds of the buckets input dims are rounded up to, so that a single memory pattern is
+  // shared by all input shapes in a bucket. empty to key memory patterns on the exact input shapes.
+  std::vector<int64_t> memory_pattern_shape_buckets_;
+
+  // for each graph input OrtValue index, whether each of its dims is fixed in the model. only the symbolic dims are
+  // rounded up to the memory_pattern_shape_buckets_.
+  std::unordered_map<int, std::vector<bool>> memory_pattern_fixed_input_dims_;
+
+  // set once the memory patterns can't be planned for the shape bucket upper bounds. mem_patterns_lock_ must be held.
+  mutable bool mem_patterns_bucket_planning_failed_ = false;
+
+  // switch for serving the transient allocations of each Run from a region allocator.
+  bool use_run_region_allocator_ = false;
+
+  // switch for running the nodes on the intra-op thread pool in parallel execution mode.
+  bool use_dataflow_executor_ = false;
+
+  // lock for the run_region_block_sizes_
+  mutable OrtMutex run_region_block_sizes_lock_;
+
+  // peak usage of the Run region allocators per location.
+  mutable std::map<OrtMemoryInfo, size_t> run_region_block_sizes_;
 
   NameNodeInfoMapType input_names_to_nodeinfo_mapping_;
   NameNodeInfoMapType output_names_to_nodeinfo_mapping_;
@@ -529,6 +661,36 @@ class SessionState {
   // a constant initialized weight was used by the session state
   size_t used_shared_pre_packed_weights_counter_ = 0;
 
+  // Counter for number of times the pre-packed weight saved in the ORT format model was used instead of
+  // pre-packing the constant initialized weight
+  size_t used_saved_pre_packed_weights_counter_ = 0;
+
+  // switch for keeping the pre-packed weights of the CPU kernels so SaveToOrtFormat() can save them.
+  bool save_prepacked_weights_ = false;
+
+  // pre-packed weights to save, keyed by node index and input index.
+  // the kernels use the buffers, but don't own them.
+  std::map<std::pair<NodeIndex, int>, PrePackedWeights> prepacked_weights_to_save_;
+
+  // pre-packed weights saved in the ORT format model being loaded, keyed by node index and input index.
+  // only set while the constant initialized weights are pre-packed, as they point into the model bytes.
+  std::map<std::pair<NodeIndex, int>, const onnxruntime::experimental::fbs::PrePackedWeight*> saved_prepacked_weights_;
+
+  // switch for saving the execution plan, and the memory patterns if possible, in SaveToOrtFormat().
+  bool save_execution_plan_ = false;
+
+  // the options the execution plan was created with, which are saved with it.
+  ExecutionMode plan_execution_mode_ = ExecutionMode::ORT_SEQUENTIAL;
+  ExecutionOrder plan_execution_order_ = ExecutionOrder::DEFAULT;
+  bool plan_enable_mem_reuse_ = true;
+
+  // execution plan saved in the ORT format model being loaded.
+  // only set until the session state is finalized, as it points into the model bytes.
+  const onnxruntime::experimental::fbs::ExecutionPlan* saved_execution_plan_ = nullptr;
+
+  // whether the execution plan saved in the ORT format model was used instead of creating it
+  bool used_saved_execution_plan_ = false;
+
 #ifdef DEBUG_NODE_INPUTS_OUTPUTS
   // Counter for number of times the session graph has been executed
   size_t graph_executions_counter_ = 0;
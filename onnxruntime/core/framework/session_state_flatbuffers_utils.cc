@@ -3,12 +3,54 @@
 
 #include "core/framework/session_state_flatbuffers_utils.h"
 
+#include "core/common/cpuid_info.h"
+#include "onnxruntime_config.h"
+
 namespace onnxruntime::experimental::utils {
 
 std::string GetSubgraphId(const NodeIndex node_idx, const std::string& attr_name) {
   return std::to_string(node_idx) + "_" + attr_name;
 }
 
+std::string GetPrePackedWeightsIsaFingerprint() {
+  // the pre-packed layouts of the kernels aren't versioned, so the weights are only used by the release that
+  // saved them
+  std::string fingerprint = "ort" ORT_VERSION ",";
+
+#if defined(_M_AMD64) || defined(__x86_64__)
+  fingerprint += "x86_64";
+#elif defined(_M_IX86) || defined(__i386__)
+  fingerprint += "x86";
+#elif defined(_M_ARM64) || defined(__aarch64__)
+  fingerprint += "arm64";
+#elif defined(_M_ARM) || defined(__arm__)
+  fingerprint += "arm";
+#else
+  fingerprint += "unknown";
+#endif
+
+  const auto& cpuid_info = CPUIDInfo::GetCPUIDInfo();
+  const std::pair<bool, const char*> features[] = {
+      {cpuid_info.HasSSE3(), "sse3"},
+      {cpuid_info.HasSSE4_1(), "sse4_1"},
+      {cpuid_info.HasAVX(), "avx"},
+      {cpuid_info.HasAVX2(), "avx2"},
+      {cpuid_info.HasF16C(), "f16c"},
+      {cpuid_info.HasAVX512f(), "avx512f"},
+      {cpuid_info.HasAVX512Skylake(), "avx512_skylake"},
+      {cpuid_info.HasArmNeonDot(), "neon_dot"},
+  };
+
+  for (const auto& feature : features) {
+    if (feature.first) {
+      fingerprint += ",";
+      fingerprint += feature.second;
+    }
+  }
+
+  return fingerprint;
+}
+
 FbsSessionStateViewer::FbsSessionStateViewer(const fbs::SessionState& fbs_session_state)
     : fbs_session_state_{fbs_session_state} {
 }
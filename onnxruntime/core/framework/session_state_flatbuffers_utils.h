@@ -20,6 +20,15 @@ namespace onnxruntime::experimental::utils {
  */
 std::string GetSubgraphId(const NodeIndex node_idx, const std::string& attr_name);
 
+/**
+ * Gets a fingerprint of the ONNX Runtime version, the CPU architecture and the instruction set features kernels
+ * select their pre-packed weight layouts by. Pre-packed weights saved in an ORT format model are only used if the
+ * fingerprint of the runtime loading the model matches.
+ *
+ * @return The fingerprint.
+ */
+std::string GetPrePackedWeightsIsaFingerprint();
+
 /**
  * Provides read-only helper functions for a fbs::SessionState instance.
  */
@@ -25,6 +25,7 @@
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/framework/mem_buffer.h"
 #include "core/framework/tensor_allocator.h"
+#include "core/platform/threadpool.h"
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
 #include "core/framework/memory_info.h"
 #endif
@@ -54,11 +55,10 @@ static common::Status AllocateBufferUsingDeviceAllocatorFromShapeAndType(const T
   return Status::OK();
 }
 
-static common::Status DeserializeTensorProto(const Env& env, const std::basic_string<PATH_CHAR_TYPE>& proto_path,
-                                             const ONNX_NAMESPACE::TensorProto& tensor_proto, const MemBuffer* m,
-                                             const AllocatorPtr& alloc, const AllocatorPtr& default_cpu_alloc,
-                                             OrtValue& ort_value, const DataTransferManager& data_transfer_mgr,
-                                             bool use_device_allocator_for_initializers = false) {
+// Allocates the tensor a TensorProto is deserialized into, either on the pre-allocated buffer or using the allocator.
+static common::Status AllocateTensorForTensorProto(const ONNX_NAMESPACE::TensorProto& tensor_proto, const MemBuffer* m,
+                                                   const AllocatorPtr& alloc, std::unique_ptr<Tensor>& p_tensor,
+                                                   bool use_device_allocator_for_initializers = false) {
   if (bool(alloc) == (m != nullptr)) {
     return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
                   "DeserializeTensorProto() takes either pre-allocated buffer or an allocator!");
@@ -67,7 +67,6 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
   // Get shape and type of the tensor, and allocate the empty tensor
   TensorShape tensor_shape{utils::GetTensorShapeFromTensorProto(tensor_proto)};
   const DataTypeImpl* const type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType();
-  std::unique_ptr<Tensor> p_tensor;
   if (m != nullptr) {
     p_tensor = std::make_unique<Tensor>(type, tensor_shape, m->GetBuffer(), m->GetAllocInfo());
     if (m->GetLen() < p_tensor->SizeInBytes()) {
@@ -87,15 +86,27 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
     }
   }
 
-  if (strcmp(p_tensor->Location().name, CPU) == 0) {
+  return common::Status::OK();
+}
+
+// Deserializes a TensorProto into the allocated tensor. A tensor that is not on CPU is deserialized to CPU first,
+// and then copied.
+static common::Status DeserializeTensorProto(const Env& env, const std::basic_string<PATH_CHAR_TYPE>& proto_path,
+                                             const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                             const AllocatorPtr& default_cpu_alloc, Tensor& tensor,
+                                             const DataTransferManager& data_transfer_mgr,
+                                             bool use_device_allocator_for_initializers = false) {
+  if (strcmp(tensor.Location().name, CPU) == 0) {
     // deserialize directly to CPU tensor
-    ORT_RETURN_IF_ERROR(utils::TensorProtoToTensor(env, proto_path.c_str(), tensor_proto, *p_tensor));
+    ORT_RETURN_IF_ERROR(utils::TensorProtoToTensor(env, proto_path.c_str(), tensor_proto, tensor));
   } else {  // non-cpu tensor
     if (tensor_proto.data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
       return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "string tensor is not supported for copying between allocators");
     }
 
     // deserialize to CPU first for non-CPU allocator, then copy
+    const TensorShape& tensor_shape = tensor.Shape();
+    const DataTypeImpl* const type = tensor.DataType();
     std::unique_ptr<Tensor> p_deserialize_tensor;
     if (use_device_allocator_for_initializers) {
       void* tensor_buffer = nullptr;
@@ -111,19 +122,17 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
     ORT_RETURN_IF_ERROR(utils::TensorProtoToTensor(env, proto_path.c_str(), tensor_proto, *p_deserialize_tensor));
     // TODO!! Need a temp buffer allocator for non-escape buffers that maybe too big for stack allocation.
 
-    Status copy_status = data_transfer_mgr.CopyTensor(*p_deserialize_tensor, *p_tensor);
+    Status copy_status = data_transfer_mgr.CopyTensor(*p_deserialize_tensor, tensor);
     if (!copy_status.IsOK()) {
       if (copy_status.ErrorMessage().empty()) {
         // The windows execution provider does not return any error message today for CopyTensor since it is
         // not implemented yet. That's the reason we're adding our own error message so that we can debug better.
         return Status(copy_status.Category(), copy_status.Code(),
-                      "Failed to copy tensor to " + p_tensor->Location().ToString());
+                      "Failed to copy tensor to " + tensor.Location().ToString());
       }
       return copy_status;
     }
   }
-  auto ml_tensor = DataTypeImpl::GetType<Tensor>();
-  ort_value.Init(p_tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
   return common::Status::OK();
 }
 
@@ -136,7 +145,8 @@ common::Status SaveInitializedTensors(
     const SaveTensorFunction& save_tensor_func,
     const logging::Logger& logger, const DataTransferManager& data_transfer_mgr,
     const ExecutionPlanBase& exec_plan,
-    const SessionOptions& session_options) {
+    const SessionOptions& session_options,
+    concurrency::ThreadPool* thread_pool) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
   ORT_ENFORCE(ort_value_name_idx_map.MaxIdx() > -1, "OrtValue indexes should have been populated.");
 
@@ -169,15 +179,33 @@ common::Status SaveInitializedTensors(
     return retval;
   };
 
+  // Determine if an initializer can use its data in place. This is the case for the initializers of an ORT format
+  // model that refer to the data in the model bytes, if they are planned to be on CPU.
+  auto use_initializer_data_in_place =
+      [&exec_plan](const ONNX_NAMESPACE::TensorProto& tensor_proto, int ort_value_index) -> bool {
+    const void* data = nullptr;
+    size_t data_length = 0;
+    if (!utils::GetExternalDataInMemory(tensor_proto, data, data_length)) {
+      return false;
+    }
+
+    const auto& planned_mem_info = exec_plan.GetLocation(ort_value_index);
+    return planned_mem_info.device.Type() == OrtDevice::CPU &&
+           planned_mem_info.device.MemType() == OrtDevice::MemType::DEFAULT;
+  };
+
   //1. first plan the memory
   const onnxruntime::InitializedTensorSet& initialized_tensor_set = graph.GetAllInitializedTensors();
   std::unordered_map<int, const ONNX_NAMESPACE::TensorProto*> id_to_initialized_tensor;
   std::set<int> user_supplied_initializer_ids;  // set containing the ort value ids of all user supplied initializers
+  std::set<int> in_place_initializer_ids;       // set containing the ort value ids of initializers using data in place
   for (const auto& entry : initialized_tensor_set) {
     int ort_value_index;
     ORT_RETURN_IF_ERROR(ort_value_name_idx_map.GetIdx(entry.first, ort_value_index));
     if (use_user_supplied_initializer(entry.first)) {
       user_supplied_initializer_ids.insert(ort_value_index);
+    } else if (use_initializer_data_in_place(*entry.second, ort_value_index)) {
+      in_place_initializer_ids.insert(ort_value_index);
     }
     id_to_initialized_tensor[ort_value_index] = entry.second;
   }
@@ -188,13 +216,17 @@ common::Status SaveInitializedTensors(
     const auto entry = initialized_tensors_to_allocate.find(ort_value_index);
     // can not trace string tensor
     ORT_ENFORCE(entry != initialized_tensors_to_allocate.end() && entry->second->data_type() != ONNX_NAMESPACE::TensorProto_DataType_STRING);
-    ORT_RETURN_IF_ERROR(planner.Trace(entry->first, entry->second));
+    if (in_place_initializer_ids.find(entry->first) == in_place_initializer_ids.end()) {
+      ORT_RETURN_IF_ERROR(planner.Trace(entry->first, entry->second));
+    }
     initialized_tensors_to_allocate.erase(entry);
   }
 
   for (const auto& entry : initialized_tensors_to_allocate) {
-    // We don't want to trace shared initializers since their memory is provided by the user
-    if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
+    // We don't want to trace shared initializers since their memory is provided by the user,
+    // nor initializers using their data in place
+    if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end() ||
+        in_place_initializer_ids.find(entry.first) != in_place_initializer_ids.end()) {
       continue;
     }
     if (entry.second->data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
@@ -222,7 +254,20 @@ common::Status SaveInitializedTensors(
 
   OrtCallback deleter{nullptr, nullptr};
 
+  const bool use_device_allocator_for_initializers =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
+
+  // the initializers deserialized on CPU, which is done in parallel once all the tensors are allocated
+  struct CpuInitializer {
+    const ONNX_NAMESPACE::TensorProto* tensor_proto;
+    Tensor* tensor;
+    const char* name;
+  };
+  std::vector<CpuInitializer> cpu_initializers;
+
   //3. create weight tensors based on weights buffer
+  std::vector<std::pair<int, OrtValue>> ort_values;
+  ort_values.reserve(id_to_initialized_tensor.size());
   for (const auto& entry : id_to_initialized_tensor) {
     int ort_value_index = entry.first;
     const char* name = (entry.second->name().empty()) ? "" : entry.second->name().c_str();
@@ -231,6 +276,25 @@ common::Status SaveInitializedTensors(
     if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
       ort_value = *(session_options.initializers_to_share_map.at(name));
       LOGS(logger, INFO) << "Using user supplied initializer with name (" << name << ").";
+    } else if (in_place_initializer_ids.find(entry.first) != in_place_initializer_ids.end()) {
+      // create the tensor on top of the data, which stays valid for the lifetime of the session
+      const ONNX_NAMESPACE::TensorProto& tensor_proto = *(entry.second);
+      const void* data = nullptr;
+      size_t data_length = 0;
+      utils::GetExternalDataInMemory(tensor_proto, data, data_length);
+
+      TensorShape tensor_shape{utils::GetTensorShapeFromTensorProto(tensor_proto)};
+      const DataTypeImpl* const type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType();
+      auto p_tensor = std::make_unique<Tensor>(type, tensor_shape, const_cast<void*>(data),
+                                               exec_plan.GetLocation(ort_value_index));
+      if (p_tensor->SizeInBytes() != data_length) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Deserialize tensor ", name, " failed. Expected ",
+                               p_tensor->SizeInBytes(), " bytes of data, got ", data_length);
+      }
+
+      auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+      ort_value.Init(p_tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+      VLOGS(logger, 1) << "Using the data of initializer with name (" << name << ") in place.";
     } else {
       const ONNX_NAMESPACE::TensorProto& tensor_proto = *(entry.second);
 
@@ -238,26 +302,73 @@ common::Status SaveInitializedTensors(
       AllocatorPtr alloc;
       // TODO: if the tensor need be copied, does it have enough room?
       ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(ort_value_index, name, m, alloc));
-      bool use_device_allocator_for_initializers =
-          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
 
-      Status st = DeserializeTensorProto(env, graph_loc, tensor_proto, m.get(), alloc, default_cpu_alloc, ort_value,
-                                         data_transfer_mgr, use_device_allocator_for_initializers);
+      // the tensors are allocated in order, so that the layout of the memory doesn't depend on the thread timing
+      std::unique_ptr<Tensor> p_tensor;
+      Status st = AllocateTensorForTensorProto(tensor_proto, m.get(), alloc, p_tensor,
+                                               use_device_allocator_for_initializers);
+      if (st.IsOK()) {
+        if (strcmp(p_tensor->Location().name, CPU) == 0) {
+          cpu_initializers.push_back({&tensor_proto, p_tensor.get(), name});
+        } else {
+          st = DeserializeTensorProto(env, graph_loc, tensor_proto, default_cpu_alloc, *p_tensor, data_transfer_mgr,
+                                      use_device_allocator_for_initializers);
+        }
+      }
+
       if (!st.IsOK()) {
         std::ostringstream oss;
         oss << "Deserialize tensor " << name << " failed." << st.ErrorMessage();
         return Status(st.Category(), st.Code(), oss.str());
       }
+
+      auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+      ort_value.Init(p_tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
     }
 
+    ort_values.emplace_back(ort_value_index, std::move(ort_value));
+  }
+
+  //4. deserialize the initializers on CPU, which are independent of each other
+  std::vector<Status> statuses(cpu_initializers.size());
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(cpu_initializers.size()),
+      [&](std::ptrdiff_t i) {
+        const auto& initializer = cpu_initializers[i];
+        ORT_TRY {
+          statuses[i] = utils::TensorProtoToTensor(env, graph_loc.c_str(), *initializer.tensor_proto,
+                                                   *initializer.tensor);
+        }
+        ORT_CATCH(const std::exception& ex) {
+          ORT_HANDLE_EXCEPTION([&]() {
+            statuses[i] = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+          });
+        }
+      });
+
+  for (size_t i = 0; i < cpu_initializers.size(); ++i) {
+    const auto& st = statuses[i];
+    if (!st.IsOK()) {
+      std::ostringstream oss;
+      oss << "Deserialize tensor " << cpu_initializers[i].name << " failed." << st.ErrorMessage();
+      return Status(st.Category(), st.Code(), oss.str());
+    }
+  }
+
+  //5. save the weight tensors
+  for (const auto& entry : ort_values) {
+    const int ort_value_index = entry.first;
+    const auto& tensor_proto = *id_to_initialized_tensor.at(ort_value_index);
+    const char* name = tensor_proto.name().empty() ? "" : tensor_proto.name().c_str();
+
     // any outer scope value is shadowed by a local value and can't override it.
     // due to that check_outer_scope is false
     const bool constant = graph.IsConstantInitializer(name, /* check_outer_scope */ false);
 #if !defined(DISABLE_SPARSE_TENSORS)
     const bool sparse = graph.GetGraph().IsSparseInitializer(name);
-    ORT_RETURN_IF_ERROR(save_tensor_func(ort_value_index, ort_value, deleter, constant, sparse));
+    ORT_RETURN_IF_ERROR(save_tensor_func(ort_value_index, entry.second, deleter, constant, sparse));
 #else
-    ORT_RETURN_IF_ERROR(save_tensor_func(ort_value_index, ort_value, deleter, constant, false));
+    ORT_RETURN_IF_ERROR(save_tensor_func(ort_value_index, entry.second, deleter, constant, false));
 #endif
 
     VLOGS(logger, 1) << "Added weight with name : " << name << " with index: " << ort_value_index;
@@ -3,6 +3,7 @@
 
 #include "tensor_external_data_info.h"
 #include "core/common/common.h"
+#include "core/framework/tensorprotoutils.h"
 #include "core/platform/path_lib.h"
 
 #ifdef _WIN32
@@ -23,6 +24,11 @@ Status ExternalDataInfo::Create(const RepeatedPtrField<StringStringEntryProto>&
     if (!stringmap.has_value())
       return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "model format error! Need a value for the external data info");
     if (stringmap.key() == "location" && !stringmap.value().empty()) {
+      // the in-memory location is reserved for data ORT holds in memory, which isn't read from a file
+      if (stringmap.value() == utils::kTensorProtoMemoryAddressTag) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "model format error! The external data location '",
+                               stringmap.value(), "' is reserved");
+      }
       out->rel_path_ = ToWideString(stringmap.value());
     } else if (stringmap.key() == "offset" && !stringmap.value().empty()) {
       char* end;
@@ -3,6 +3,7 @@
 
 #include "core/framework/tensorprotoutils.h"
 
+#include <cstdlib>
 #include <memory>
 #include <algorithm>
 #include <limits>
@@ -17,6 +18,7 @@
 #include "core/framework/allocator.h"
 #include "core/framework/callback.h"
 #include "core/framework/data_types.h"
+#include "core/platform/ort_mutex.h"
 #include "core/platform/path_lib.h"
 #include "core/session/ort_apis.h"
 #include "onnx/defs/tensor_proto_util.h"
@@ -156,6 +158,14 @@ static Status GetExternalDataInfo(const ONNX_NAMESPACE::TensorProto& tensor_prot
 static Status ReadExternalDataForTensor(const ONNX_NAMESPACE::TensorProto& tensor_proto,
                                         const ORTCHAR_T* tensor_proto_dir,
                                         std::vector<uint8_t>& unpacked_tensor) {
+  const void* data_in_memory = nullptr;
+  size_t data_in_memory_length = 0;
+  if (onnxruntime::utils::GetExternalDataInMemory(tensor_proto, data_in_memory, data_in_memory_length)) {
+    const auto* data_begin = static_cast<const uint8_t*>(data_in_memory);
+    unpacked_tensor.assign(data_begin, data_begin + data_in_memory_length);
+    return Status::OK();
+  }
+
   std::basic_string<ORTCHAR_T> external_file_path;
   onnxruntime::FileOffsetType file_offset;
   SafeInt<size_t> tensor_byte_size;
@@ -401,6 +411,12 @@ Status UnpackTensor(const ONNX_NAMESPACE::TensorProto& tensor, const void* raw_d
 template <typename T>
 Status UnpackTensor(const ONNX_NAMESPACE::TensorProto& tensor, const Path& model_path,
                     /*out*/ T* p_data, size_t expected_num_elements) {
+  const void* data_in_memory = nullptr;
+  size_t data_in_memory_length = 0;
+  if (GetExternalDataInMemory(tensor, data_in_memory, data_in_memory_length)) {
+    return UnpackTensor(tensor, data_in_memory, data_in_memory_length, p_data, expected_num_elements);
+  }
+
 #if !defined(ORT_MINIMAL_BUILD)
   if (HasExternalData(tensor)) {
     return UnpackTensorWithExternalData(
@@ -614,7 +630,13 @@ Status TensorProtoToTensor(const Env& env, const ORTCHAR_T* model_path,
   SafeInt<size_t> raw_data_len = 0;
   AutoDelete deleter_for_file_data;
 
-  if (utils::HasExternalData(tensor_proto)) {
+  const void* data_in_memory = nullptr;
+  size_t data_in_memory_length = 0;
+
+  if (utils::GetExternalDataInMemory(tensor_proto, data_in_memory, data_in_memory_length)) {
+    raw_data = const_cast<void*>(data_in_memory);
+    raw_data_len = data_in_memory_length;
+  } else if (utils::HasExternalData(tensor_proto)) {
     // Get the external data info
     std::basic_string<ORTCHAR_T> external_data_file_path;
     FileOffsetType file_offset;
@@ -847,6 +869,102 @@ common::Status ConstantNodeProtoToTensorProto(const ONNX_NAMESPACE::NodeProto& n
   return ConstantNodeProtoToTensorProto(node, model_path, tensor, node.output(0));
 }
 
+void SetExternalDataInMemory(ONNX_NAMESPACE::TensorProto& tensor_proto, const void* data, size_t data_length) {
+  tensor_proto.clear_raw_data();
+  tensor_proto.clear_external_data();
+  tensor_proto.set_data_location(TensorProto_DataLocation_EXTERNAL);
+
+  auto add_entry = [&tensor_proto](const char* key, const std::string& value) {
+    auto* entry = tensor_proto.add_external_data();
+    entry->set_key(key);
+    entry->set_value(value);
+  };
+
+  add_entry("location", kTensorProtoMemoryAddressTag);
+  add_entry("offset", std::to_string(reinterpret_cast<uintptr_t>(data)));
+  add_entry("length", std::to_string(data_length));
+}
+
+namespace {
+// The [begin, end) address ranges registered by the live ExternalDataInMemoryRange instances.
+struct ExternalDataInMemoryRanges {
+  OrtMutex mutex;
+  std::vector<std::pair<uintptr_t, uintptr_t>> ranges;
+};
+
+ExternalDataInMemoryRanges& GetExternalDataInMemoryRanges() {
+  // never destroyed, as sessions may be released during static destruction
+  static auto* ranges = new ExternalDataInMemoryRanges();
+  return *ranges;
+}
+
+bool IsRegisteredExternalDataInMemory(uintptr_t address, size_t length) {
+  auto& registry = GetExternalDataInMemoryRanges();
+  std::lock_guard<OrtMutex> lock(registry.mutex);
+  return std::any_of(registry.ranges.cbegin(), registry.ranges.cend(),
+                     [address, length](const std::pair<uintptr_t, uintptr_t>& range) {
+                       return address >= range.first && address <= range.second &&
+                              length <= range.second - address;
+                     });
+}
+}  // namespace
+
+ExternalDataInMemoryRange::ExternalDataInMemoryRange(const void* data, size_t data_length)
+    : begin_(reinterpret_cast<uintptr_t>(data)), end_(begin_ + data_length) {
+  auto& registry = GetExternalDataInMemoryRanges();
+  std::lock_guard<OrtMutex> lock(registry.mutex);
+  registry.ranges.emplace_back(begin_, end_);
+}
+
+ExternalDataInMemoryRange::~ExternalDataInMemoryRange() {
+  auto& registry = GetExternalDataInMemoryRanges();
+  std::lock_guard<OrtMutex> lock(registry.mutex);
+  auto it = std::find(registry.ranges.begin(), registry.ranges.end(), std::make_pair(begin_, end_));
+  if (it != registry.ranges.end()) {
+    registry.ranges.erase(it);
+  }
+}
+
+bool HasExternalDataInMemory(const ONNX_NAMESPACE::TensorProto& tensor_proto) {
+  if (!HasExternalData(tensor_proto)) {
+    return false;
+  }
+
+  return std::any_of(tensor_proto.external_data().cbegin(), tensor_proto.external_data().cend(),
+                     [](const ONNX_NAMESPACE::StringStringEntryProto& entry) {
+                       return entry.key() == "location" && entry.value() == kTensorProtoMemoryAddressTag;
+                     });
+}
+
+bool GetExternalDataInMemory(const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                             const void*& data, size_t& data_length) {
+  if (!HasExternalData(tensor_proto)) {
+    return false;
+  }
+
+  bool in_memory = false;
+  uintptr_t address = 0;
+  size_t length = 0;
+  for (const auto& entry : tensor_proto.external_data()) {
+    if (entry.key() == "location") {
+      in_memory = entry.value() == kTensorProtoMemoryAddressTag;
+    } else if (entry.key() == "offset") {
+      address = static_cast<uintptr_t>(std::strtoull(entry.value().c_str(), nullptr, 10));
+    } else if (entry.key() == "length") {
+      length = static_cast<size_t>(std::strtoull(entry.value().c_str(), nullptr, 10));
+    }
+  }
+
+  // the location is only trusted for the memory ORT registered, as it may come from a model.
+  if (!in_memory || !IsRegisteredExternalDataInMemory(address, length)) {
+    return false;
+  }
+
+  data = reinterpret_cast<const void*>(address);
+  data_length = length;
+  return true;
+}
+
 #if !defined(DISABLE_SPARSE_TENSORS)
 static Status CopySparseData(size_t n_sparse_elements,
                              const ONNX_NAMESPACE::TensorProto& indices,
@@ -973,6 +1091,10 @@ common::Status SparseTensorProtoToDenseTensorProto(const ONNX_NAMESPACE::SparseT
                                                    ONNX_NAMESPACE::TensorProto& dense) {
   Status status = Status::OK();
 
+  // ORT only holds the data of dense initializers in memory, so the location comes from the model.
+  ORT_RETURN_IF(HasExternalDataInMemory(sparse.values()) || HasExternalDataInMemory(sparse.indices()),
+                "The external data location of sparse tensor '", sparse.values().name(), "' is not valid.");
+
   const auto& sparse_values = sparse.values();
   auto type = sparse_values.data_type();
   dense.set_data_type(type);
@@ -1299,7 +1421,10 @@ Status UnpackInitializerData(const onnx::TensorProto& initializer,
 
 Status UnpackInitializerData(const ONNX_NAMESPACE::TensorProto& initializer,
                              std::vector<uint8_t>& unpacked_tensor) {
-  ORT_RETURN_IF(initializer.data_location() == TensorProto_DataLocation_EXTERNAL,
+  const void* data_in_memory = nullptr;
+  size_t data_in_memory_length = 0;
+  ORT_RETURN_IF(initializer.data_location() == TensorProto_DataLocation_EXTERNAL &&
+                    !GetExternalDataInMemory(initializer, data_in_memory, data_in_memory_length),
                 "The given initializer contains external data");
   return UnpackInitializerData(initializer, Path(), unpacked_tensor);
 }
@@ -90,6 +90,40 @@ common::Status ConstantNodeProtoToTensorProto(const ONNX_NAMESPACE::NodeProto& n
                                               const Path& model_path,
                                               ONNX_NAMESPACE::TensorProto& tensor);
 
+// The location of the external data of a TensorProto whose data is held in memory instead of in a file, e.g. in the
+// buffer of a loaded ORT format model. The offset of the external data is the address of the data in that case.
+constexpr const char* kTensorProtoMemoryAddressTag = "*/_ORT_MEM_ADDR_/*";
+
+// Registers data_length bytes at the address data as memory that the external data of a TensorProto can be held in,
+// e.g. the buffer of an ORT format model whose initializers use their data in place, for the lifetime of the object.
+// The in-memory location is only honoured for data within a registered range, so a model can't make ORT read
+// arbitrary memory by setting it.
+class ExternalDataInMemoryRange {
+ public:
+  ExternalDataInMemoryRange(const void* data, size_t data_length);
+  ~ExternalDataInMemoryRange();
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ExternalDataInMemoryRange);
+
+  uintptr_t begin_;
+  uintptr_t end_;
+};
+
+// Make the external data of tensor_proto refer to data_length bytes at the address data, instead of holding a copy.
+// The memory has to be within a registered ExternalDataInMemoryRange, and stay valid for as long as tensor_proto or
+// any tensor created from it in place is used.
+void SetExternalDataInMemory(ONNX_NAMESPACE::TensorProto& tensor_proto, const void* data, size_t data_length);
+
+// Check if the external data location of tensor_proto is kTensorProtoMemoryAddressTag, whether or not the data is
+// within a registered ExternalDataInMemoryRange. Only ORT sets that location, so a model using it is invalid.
+bool HasExternalDataInMemory(const ONNX_NAMESPACE::TensorProto& tensor_proto);
+
+// Check if the external data of tensor_proto is held in memory within a registered ExternalDataInMemoryRange, and if
+// so return its address and length.
+bool GetExternalDataInMemory(const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                             const void*& data, size_t& data_length);
+
 #if !defined(DISABLE_SPARSE_TENSORS)
 // Convert a SparseTensorProto to a dense TensorProto
 // If the SparseTensorProto contains external data then it loads the data and converts to dense tensor proto
@@ -7,6 +7,7 @@
 
 #include "core/graph/graph_viewer.h"
 #include "core/framework/data_transfer_manager.h"
+#include "core/framework/dataflow_executor.h"
 #include "core/framework/execution_frame.h"
 #include "core/framework/execution_providers.h"
 #include "core/framework/feeds_fetches_manager.h"
@@ -583,6 +584,13 @@ static common::Status ExecuteGraphImpl(const SessionState& session_state,
   std::unique_ptr<IExecutor> p_exec;
   if (execution_mode == ExecutionMode::ORT_SEQUENTIAL) {
     p_exec = std::unique_ptr<IExecutor>(new SequentialExecutor(terminate_flag, only_execute_path_to_fetches));
+  } else if (execution_mode == ExecutionMode::ORT_PARALLEL && session_state.GetUseDataflowExecutor()) {
+    if (!concurrency::ThreadPool::ShouldParallelize(session_state.GetThreadPool())) {
+      LOGS(logger, WARNING) << "Only one thread was configured for parallel execution. Hence will use sequential execution.";
+      p_exec = std::unique_ptr<IExecutor>(new SequentialExecutor(terminate_flag, only_execute_path_to_fetches));
+    } else {
+      p_exec = std::unique_ptr<IExecutor>(new DataflowExecutor(session_state, terminate_flag));
+    }
   } else if (execution_mode == ExecutionMode::ORT_PARALLEL) {
     auto* p_inter_op_thread_pool = session_state.GetInterOpThreadPool();
     if (!p_inter_op_thread_pool) {
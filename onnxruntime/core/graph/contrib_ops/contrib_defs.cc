@@ -510,7 +510,10 @@ void AttentionTypeAndShapeInference(ONNX_NAMESPACE::InferenceContext& ctx, int p
           fail_shape_inference("Inputs 4 shall be 5 dimensions");
         }
 
-        if (past_dims[3].has_dim_value() && input_dims[1].has_dim_value()) {
+        // When past and present share a buffer, present has the same shape as past.
+        if (getAttribute(ctx, "past_present_share_buffer", 0) != 0) {
+          propagateShapeFromInputToOutput(ctx, past_input_index, 1);
+        } else if (past_dims[3].has_dim_value() && input_dims[1].has_dim_value()) {
           auto all_sequence_length = past_shape.dim(3).dim_value() + input_shape.dim(1).dim_value();
 
           ONNX_NAMESPACE::TensorShapeProto present_shape;
@@ -536,6 +539,9 @@ where value of each element is the end position, or valid length of actual seque
 left-side padding, mask_index has shape (2 * batch_size), where the values are the exclusive end positions followed by
 the inclusive start positions. When unidirectional is 1, and each token only attend to previous tokens. For GPT-2, both past
 and present state are optional. Present state could appear in output even when past state is not in input.
+When past_present_share_buffer is 1, past and present have the shape (2, batch_size, num_heads, max_sequence_length, head_size)
+and are expected to be bound to the same buffer. The first past_sequence_length rows of each head are valid, and the key and
+value of the current tokens are written in place after them, so the cache is not copied for every step.
 )DOC";
 
   ONNX_CONTRIB_OPERATOR_SCHEMA(Attention)
@@ -551,6 +557,10 @@ and present state are optional. Present state could appear in output even when p
             "Hidden layer sizes of Q, K, V paths in Attention",
             AttributeProto::INTS,
             OPTIONAL_VALUE)
+      .Attr("past_present_share_buffer",
+            "Whether past and present share a buffer of max_sequence_length rows. Default value is 0.",
+            AttributeProto::INT,
+            static_cast<int64_t>(0))
       .Input(0, "input", "3D input tensor with shape (batch_size, sequence_length, input_hidden_size)", "T")
       .Input(1, "weight", "2D input tensor with shape (input_hidden_size, 3 * hidden_size), where hidden_size = num_heads * head_size", "T")
       .Input(2, "bias", "1D input tensor with shape (3 * hidden_size)", "T")
@@ -558,6 +568,7 @@ and present state are optional. Present state could appear in output even when p
                 "or (batch_size, sequence_length, past_sequence_length + sequence_length), or index with shape (batch_size) or (2 * batch_size).", "M", OpSchema::Optional)
       .Input(4, "past", "past state for key and value with shape (2, batch_size, num_heads, past_sequence_length, head_size).", "T", OpSchema::Optional)
       .Input(5, "extra_add", "additional add to QxK' with shape (batch_size, num_heads, sequence_length, sequence_length).", "T", OpSchema::Optional)
+      .Input(6, "past_sequence_length", "Number of valid rows in past with shape (1). Required when past_present_share_buffer is 1.", "M", OpSchema::Optional)
       .Output(0, "output", "3D output tensor with shape (batch_size, append_length, hidden_size)", "T")
       .Output(1, "present", "present state for key and value with shape (2, batch_size, num_heads, past_sequence_length + sequence_length, head_size)", "T", OpSchema::Optional)
       .TypeConstraint("T", {"tensor(float)", "tensor(float16)"}, "Constrain input and output types to float tensors.")
@@ -428,6 +428,58 @@ C (int32) = (A - A_zero_point) * (B - B_zero_point)
         ONNX_NAMESPACE::matmulShapeInference(ctx, 0, 1);
       });
 
+  ONNX_CONTRIB_OPERATOR_SCHEMA(MatMulNBits)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(
+MatMul with a block-wise quantized weight matrix B of shape [K, N].
+Each column of B is split into blocks of `block_size` rows along K, and each block has its own scale and
+zero point. B is dequantized as (quantized_value - zero_point) * scale.
+B is stored column by column: input 'B' has shape [N, ceil(K / block_size), block_size * bits / 8] and
+for 4 bits the element with the even row index within a block is in the low nibble of its byte.
+)DOC")
+      .Input(0, "A", "The input tensor, not quantized. Its last dimension is K.", "T1")
+      .Input(1, "B", "1 or 2 dimensional data blob of the quantized weight.", "T2")
+      .Input(2,
+             "scales",
+             "Per block scaling factors of B, with shape [N * ceil(K / block_size)].",
+             "T1")
+      .Input(3,
+             "zero_points",
+             "Per block zero points of B, packed like B with shape [N * ceil(ceil(K / block_size) * bits / 8)]. "
+             "It's optional and the default value is 2^(bits - 1).",
+             "T2",
+             OpSchema::Optional)
+      .Output(0, "Y", "Tensor with the same leading dimensions as A and a last dimension of N.", "T1")
+      .Attr("K", "Size of the K dimension of B.", AttributeProto::INT)
+      .Attr("N", "Size of the N dimension of B.", AttributeProto::INT)
+      .Attr("bits", "Number of bits of a quantized element of B. Only 4 is supported.", AttributeProto::INT,
+            static_cast<int64_t>(4))
+      .Attr("block_size",
+            "Number of rows of B along K sharing a scale and zero point. "
+            "It must be a power of 2 from 16 to 256.",
+            AttributeProto::INT)
+      .TypeConstraint("T1", {"tensor(float)"}, "Constrain input A, scales and output Y to float tensors.")
+      .TypeConstraint("T2", {"tensor(uint8)"}, "Constrain quantized weight and zero point types to uint8 tensors.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        if (!hasInputShape(ctx, 0)) {
+          return;
+        }
+
+        const auto& a_shape = ctx.getInputType(0)->tensor_type().shape();
+        if (a_shape.dim_size() == 0) {
+          fail_shape_inference("Input A of MatMulNBits must have at least 1 dimension");
+        }
+
+        ONNX_NAMESPACE::TensorShapeProto y_shape;
+        for (int i = 0; i < a_shape.dim_size() - 1; i++) {
+          *y_shape.add_dim() = a_shape.dim(i);
+        }
+        y_shape.add_dim()->set_dim_value(getAttribute(ctx, "N", 0));
+        updateOutputShape(ctx, 0, y_shape);
+      });
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(QLinearAdd)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
@@ -468,6 +468,14 @@ void Node::SetPriority(int priority) noexcept {
   priority_ = priority;
 }
 
+void Node::SetExecutionProviderType(ProviderType execution_provider_type) {
+  if (execution_provider_type_ != execution_provider_type) {
+    graph_->MarkNodeModified(index_);
+  }
+
+  execution_provider_type_ = execution_provider_type;
+}
+
 const Path& Node::ModelPath() const noexcept {
   return graph_->ModelPath();
 }
@@ -781,6 +789,7 @@ void Node::CreateSubgraph(const std::string& attr_name) {
 void Node::AddAttribute(const std::string& attr_name, const AttributeProto& value) {
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
+  graph_->MarkNodeModified(index_);
   attributes_[attr_name] = value;
 }
 
@@ -788,6 +797,7 @@ void Node::AddAttribute(const std::string& attr_name, const AttributeProto& valu
   void Node::AddAttribute(const std::string& attr_name, const type& value) { \
     graph_->SetGraphResolveNeeded();                                         \
     graph_->SetGraphProtoSyncNeeded();                                       \
+    graph_->MarkNodeModified(index_);                                        \
     AttributeProto a;                                                        \
     a.set_name(attr_name);                                                   \
     a.set_type(enumType);                                                    \
@@ -799,6 +809,7 @@ void Node::AddAttribute(const std::string& attr_name, const AttributeProto& valu
   void Node::AddAttribute(const std::string& attr_name, const type& value) { \
     graph_->SetGraphResolveNeeded();                                         \
     graph_->SetGraphProtoSyncNeeded();                                       \
+    graph_->MarkNodeModified(index_);                                        \
     AttributeProto a;                                                        \
     a.set_name(attr_name);                                                   \
     a.set_type(enumType);                                                    \
@@ -811,6 +822,7 @@ void Node::AddAttribute(const std::string& attr_name, const AttributeProto& valu
                           const std::vector<type>& values) { \
     graph_->SetGraphResolveNeeded();                         \
     graph_->SetGraphProtoSyncNeeded();                       \
+    graph_->MarkNodeModified(index_);                        \
     AttributeProto a;                                        \
     a.set_name(attr_name);                                   \
     a.set_type(enumType);                                    \
@@ -823,6 +835,7 @@ void Node::AddAttribute(const std::string& attr_name, const AttributeProto& valu
 void Node::AddAttribute(const std::string& attr_name, const GraphProto& value) {
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
+  graph_->MarkNodeModified(index_);
   AttributeProto a;
   a.set_name(attr_name);
   a.set_type(AttributeProto_AttributeType::AttributeProto_AttributeType_GRAPH);
@@ -855,6 +868,7 @@ ADD_LIST_ATTR_IMPL(SparseTensorProto, AttributeProto_AttributeType::AttributePro
 bool Node::ClearAttribute(const std::string& attr_name) {
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
+  graph_->MarkNodeModified(index_);
   return attributes_.erase(attr_name) > 0;
 }
 
@@ -1113,6 +1127,12 @@ Graph::Graph(const Model& owning_model,
       p.first->second = &tensor;
     }
 
+    // only initializers loaded from an ORT format model can refer to data in memory
+    if (utils::HasExternalDataInMemory(tensor)) {
+      ORT_THROW("This is an invalid model. The external data location of initializer '", tensor.name(),
+                "' is not valid.");
+    }
+
     NodeArg* matching_graph_input = GetNodeArg(tensor.name());
     TypeProto t{TypeProtoFromTensorProto(tensor)};
 
@@ -1380,8 +1400,14 @@ void Graph::AddEdge(NodeIndex src_node_index, NodeIndex dst_node_index, int src_
     *dst_arg_pointer = src_arg;
   }
 
-  nodes_[src_node_index]->MutableRelationships().output_edges.insert(Node::EdgeEnd(*nodes_[dst_node_index], src_arg_slot, dst_arg_slot));
-  nodes_[dst_node_index]->MutableRelationships().input_edges.insert(Node::EdgeEnd(*nodes_[src_node_index], src_arg_slot, dst_arg_slot));
+  bool added = nodes_[src_node_index]->MutableRelationships().output_edges.insert(Node::EdgeEnd(*nodes_[dst_node_index], src_arg_slot, dst_arg_slot)).second;
+  added = nodes_[dst_node_index]->MutableRelationships().input_edges.insert(Node::EdgeEnd(*nodes_[src_node_index], src_arg_slot, dst_arg_slot)).second || added;
+
+  // Resolve adds the existing edges again, which doesn't change anything
+  if (added) {
+    MarkNodeModified(src_node_index);
+    MarkNodeModified(dst_node_index);
+  }
 }
 
 void Graph::RemoveEdge(NodeIndex src_node_index, NodeIndex dst_node_index, int src_arg_slot, int dst_arg_slot) {
@@ -1422,9 +1448,74 @@ void Graph::RemoveEdge(NodeIndex src_node_index, NodeIndex dst_node_index, int s
 
   nodes_[dst_node_index]->MutableRelationships().input_edges.erase(Node::EdgeEnd(*nodes_[src_node_index], src_arg_slot, dst_arg_slot));
   nodes_[src_node_index]->MutableRelationships().output_edges.erase(Node::EdgeEnd(*nodes_[dst_node_index], src_arg_slot, dst_arg_slot));
+
+  MarkNodeModified(src_node_index);
+  MarkNodeModified(dst_node_index);
 }
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
+void Graph::MarkNodeModified(NodeIndex node_index) {
+  ++modification_stamp_;
+  if (node_modification_stamps_.size() <= node_index) {
+    node_modification_stamps_.resize(std::max(nodes_.size(), node_index + 1), 0);
+  }
+
+  node_modification_stamps_[node_index] = modification_stamp_;
+
+  if (parent_graph_ != nullptr && parent_node_ != nullptr) {
+    parent_graph_->MarkNodeModified(parent_node_->Index());
+  }
+}
+
+void Graph::MarkAllNodesModified() {
+  ++modification_stamp_;
+  all_nodes_modification_stamp_ = modification_stamp_;
+
+  if (parent_graph_ != nullptr && parent_node_ != nullptr) {
+    parent_graph_->MarkNodeModified(parent_node_->Index());
+  }
+}
+
+std::unordered_set<NodeIndex> Graph::GetNodesAffectedSince(uint64_t stamp) const {
+  std::unordered_set<NodeIndex> affected_nodes;
+
+  if (all_nodes_modification_stamp_ > stamp) {
+    for (const auto& node : Nodes()) {
+      affected_nodes.insert(node.Index());
+    }
+
+    return affected_nodes;
+  }
+
+  for (NodeIndex i = 0, end = node_modification_stamps_.size(); i < end; ++i) {
+    if (node_modification_stamps_[i] <= stamp || nodes_[i] == nullptr) {
+      continue;
+    }
+
+    const Node& node = *nodes_[i];
+    affected_nodes.insert(i);
+    for (auto it = node.InputNodesBegin(), it_end = node.InputNodesEnd(); it != it_end; ++it) {
+      affected_nodes.insert(it->Index());
+    }
+
+    for (auto it = node.OutputNodesBegin(), it_end = node.OutputNodesEnd(); it != it_end; ++it) {
+      affected_nodes.insert(it->Index());
+    }
+  }
+
+  return affected_nodes;
+}
+
+bool Graph::TryGetVisitStamp(uint64_t visitor_id, uint64_t& stamp) const {
+  auto entry = visit_stamps_.find(visitor_id);
+  if (entry == visit_stamps_.cend()) {
+    return false;
+  }
+
+  stamp = entry->second;
+  return true;
+}
+
 #if !defined(ORT_MINIMAL_BUILD)
 GSL_SUPPRESS(es .84)  // ignoring return value from unordered_map::insert causes noisy complaint
 Status Graph::BuildConnections(std::unordered_set<std::string>& outer_scope_node_args_consumed) {
@@ -2083,6 +2174,25 @@ Status Graph::UpdateShapeInference(Node& node) {
   return InferAndVerifyTypeMatch(node, *node.Op(), {});
 }
 
+// Checks if the shapes are the same, including the symbolic and unknown dims
+static bool ShapesAreIdentical(const TensorShapeProto& shape1, const TensorShapeProto& shape2) {
+  if (shape1.dim_size() != shape2.dim_size()) {
+    return false;
+  }
+
+  for (int i = 0, end = shape1.dim_size(); i < end; ++i) {
+    const auto& dim1 = shape1.dim(i);
+    const auto& dim2 = shape2.dim(i);
+    if (dim1.value_case() != dim2.value_case() ||
+        (utils::HasDimValue(dim1) && dim1.dim_value() != dim2.dim_value()) ||
+        (utils::HasDimParam(dim1) && dim1.dim_param() != dim2.dim_param())) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 // Implementation of type-inference and type-checking for a single node
 GSL_SUPPRESS(f .23)  // spurious warning about inferred_type never being checked for null
 Status Graph::InferAndVerifyTypeMatch(Node& node, const OpSchema& op, const ResolveOptions& options) {
@@ -2195,6 +2305,8 @@ Status Graph::InferAndVerifyTypeMatch(Node& node, const OpSchema& op, const Reso
   const auto& onnx_inferred_types(context.InferredOutputTypes());
 
   // Infer and verify node output arg type information.
+  // The node is marked as modified if the type or shape of an output changes, as that may affect its consumers.
+  bool outputs_changed = false;
   int i = -1;
   for (auto& output_def : node.MutableDefinitions().output_defs) {
     ++i;
@@ -2252,6 +2364,8 @@ Status Graph::InferAndVerifyTypeMatch(Node& node, const OpSchema& op, const Reso
         } else {
           output_def->SetType(inferred_type);
         }
+
+        outputs_changed = true;
       } else
         return Status(ONNXRUNTIME, FAIL,
                       "Type Error: Type (" + *existing_type + ") of output arg (" +
@@ -2259,8 +2373,10 @@ Status Graph::InferAndVerifyTypeMatch(Node& node, const OpSchema& op, const Reso
                           ") does not match expected type (" + *inferred_type + ").");
     }
 
-    if (existing_type == nullptr)
+    if (existing_type == nullptr) {
       output_def->SetType(inferred_type);
+      outputs_changed = true;
+    }
 
     // Update output-shape if it was inferred:
     // HasShape()/GetShape() work for tensor types
@@ -2268,6 +2384,7 @@ Status Graph::InferAndVerifyTypeMatch(Node& node, const OpSchema& op, const Reso
     if (utils::HasShape(onnx_inferred_type)) {
       if (output_def->Shape() == nullptr) {
         output_def->SetShape(utils::GetShape(onnx_inferred_type));
+        outputs_changed = true;
       } else {
         // we need to merge the shapes as a subgraph may have placeholder dimensions to represent the rank
         // that have no values.
@@ -2285,14 +2402,23 @@ Status Graph::InferAndVerifyTypeMatch(Node& node, const OpSchema& op, const Reso
           return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Node:", node_name, " ", status.ErrorMessage());
         }
         // we may have cleared the shape if there was a mismatch so handle that
-        if (utils::HasShape(merge_target))
-          output_def->SetShape(utils::GetShape(merge_target));
-        else
+        if (utils::HasShape(merge_target)) {
+          if (!ShapesAreIdentical(utils::GetShape(merge_target), *output_def->Shape())) {
+            output_def->SetShape(utils::GetShape(merge_target));
+            outputs_changed = true;
+          }
+        } else {
           output_def->ClearShape();
+          outputs_changed = true;
+        }
       }
     }
   }
 
+  if (outputs_changed) {
+    MarkNodeModified(node.Index());
+  }
+
   return Status::OK();
 }
 
@@ -2831,6 +2957,13 @@ Status Graph::ReplaceInitializedTensor(const ONNX_NAMESPACE::TensorProto& new_in
 
   **existing_entry = new_initializer;
 
+  auto consumers = node_arg_to_consumer_nodes_.find(initializer_name);
+  if (consumers != node_arg_to_consumer_nodes_.end()) {
+    for (NodeIndex consumer : consumers->second) {
+      MarkNodeModified(consumer);
+    }
+  }
+
   return Status::OK();
 }
 #endif  // !defined(ORT_MINIMAL_BUILD)
@@ -3182,6 +3315,8 @@ bool Graph::AddControlEdge(NodeIndex src_node_index, NodeIndex dst_node_index) {
     nodes_[dst_node_index]->MutableRelationships().control_inputs.insert(nodes_[src_node_index]->Name());
   }
 
+  MarkNodeModified(src_node_index);
+  MarkNodeModified(dst_node_index);
   return true;
 }
 
@@ -3659,6 +3794,7 @@ gsl::not_null<Node*> Graph::AllocateNode() {
   nodes_.push_back(std::move(new_node));
   ++num_of_nodes_;
   GraphResolveNeeded(true);
+  MarkNodeModified(node->Index());
 
   return gsl::not_null<Node*>{node};
 }
@@ -3675,6 +3811,7 @@ bool Graph::ReleaseNode(NodeIndex index) {
     --num_of_nodes_;
     GraphProtoSyncNeeded(true);
     GraphResolveNeeded(true);
+    MarkNodeModified(index);
   }
 
   return true;
@@ -3963,6 +4100,7 @@ void Graph::SetInputs(const std::vector<const NodeArg*>& inputs) {
   graph_inputs_manually_set_ = true;
   GraphProtoSyncNeeded(true);
   GraphResolveNeeded(true);
+  MarkAllNodesModified();
 }
 
 void Graph::SetOutputs(const std::vector<const NodeArg*>& outputs) {
@@ -3971,6 +4109,7 @@ void Graph::SetOutputs(const std::vector<const NodeArg*>& outputs) {
   graph_outputs_manually_set_ = true;
   GraphProtoSyncNeeded(true);
   GraphResolveNeeded(true);
+  MarkAllNodesModified();
 }
 
 void Graph::SetNodeArgType(NodeArg& arg, const ONNX_NAMESPACE::TypeProto& type_proto) {
@@ -4024,6 +4163,7 @@ Status Graph::LoadFromOrtFormat(const onnxruntime::experimental::fbs::Graph& fbs
 #if !defined(ORT_MINIMAL_BUILD)
                                 IOnnxRuntimeOpSchemaCollectionPtr schema_registry,
 #endif
+                                bool can_use_flatbuffer_for_initializers,
                                 const logging::Logger& logger, std::unique_ptr<Graph>& graph) {
   // can't use make_unique as we're calling a private ctor
   graph.reset(new Graph(owning_model, domain_to_version,
@@ -4032,6 +4172,7 @@ Status Graph::LoadFromOrtFormat(const onnxruntime::experimental::fbs::Graph& fbs
 #endif
                         nullptr, nullptr, logger));
 
+  graph->can_use_flatbuffer_for_initializers_ = can_use_flatbuffer_for_initializers;
   ORT_RETURN_IF_ERROR(graph->LoadFromOrtFormat(fbs_graph));
 
 #if !defined(ORT_MINIMAL_BUILD)
@@ -4058,6 +4199,7 @@ Status Graph::LoadFromOrtFormat(const onnxruntime::experimental::fbs::Graph& fbs
                         &parent_graph, &parent_node,
                         logger));
 
+  graph->can_use_flatbuffer_for_initializers_ = parent_graph.can_use_flatbuffer_for_initializers_;
   return graph->LoadFromOrtFormat(fbs_graph);
 }
 
@@ -4110,7 +4252,8 @@ common::Status Graph::LoadFromOrtFormat(const onnxruntime::experimental::fbs::Gr
     for (const auto* fbs_tensor : *fbs_initializers) {
       ORT_RETURN_IF(nullptr == fbs_tensor, "Initializer tensor is missing. Invalid ORT format model.");
       TensorProto* initializer = deserialized_proto_data_.add_initializer();
-      ORT_RETURN_IF_ERROR(experimental::utils::LoadInitializerOrtFormat(*fbs_tensor, *initializer));
+      ORT_RETURN_IF_ERROR(experimental::utils::LoadInitializerOrtFormat(*fbs_tensor, *initializer,
+                                                                        can_use_flatbuffer_for_initializers_));
       auto p = name_to_initial_tensor_.emplace(initializer->name(), initializer);
       if (!p.second) {
         LOGS(logger_, WARNING) << "Duplicate initializer (dense or ConstantNode): '" << initializer->name()
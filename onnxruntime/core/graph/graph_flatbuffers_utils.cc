@@ -47,6 +47,8 @@ Status SaveInitializerOrtFormat(flatbuffers::FlatBufferBuilder& builder,
     std::vector<uint8_t> unpacked_tensor;
     ORT_RETURN_IF_ERROR(
         onnxruntime::utils::UnpackInitializerData(initializer, model_path, unpacked_tensor));
+    // align the data so it can be used in place when the model is loaded from a suitably aligned buffer
+    builder.ForceVectorAlignment(unpacked_tensor.size(), sizeof(uint8_t), kInitializerRawDataAlignment);
     raw_data = builder.CreateVector(unpacked_tensor.data(), unpacked_tensor.size());
   }
 
@@ -177,7 +179,8 @@ Status SaveAttributeOrtFormat(flatbuffers::FlatBufferBuilder& builder,
 #if defined(ENABLE_ORT_FORMAT_LOAD)
 
 Status LoadInitializerOrtFormat(const fbs::Tensor& fbs_tensor,
-                                TensorProto& initializer) {
+                                TensorProto& initializer,
+                                bool can_use_flatbuffer_for_initializers) {
   initializer.Clear();
 
   LOAD_STR_FROM_ORT_FORMAT(initializer, name, fbs_tensor.name());
@@ -202,7 +205,13 @@ Status LoadInitializerOrtFormat(const fbs::Tensor& fbs_tensor,
     ORT_RETURN_IF(nullptr == fbs_raw_data, "Missing raw data for initializer. Invalid ORT format model.");
 
     // fbs_raw_data is uint8_t vector, so the size is byte size
-    initializer.set_raw_data(fbs_raw_data->Data(), fbs_raw_data->size());
+    const auto* raw_data_ptr = fbs_raw_data->Data();
+    if (can_use_flatbuffer_for_initializers && fbs_raw_data->size() > 0 &&
+        reinterpret_cast<uintptr_t>(raw_data_ptr) % kInitializerRawDataAlignment == 0) {
+      onnxruntime::utils::SetExternalDataInMemory(initializer, raw_data_ptr, fbs_raw_data->size());
+    } else {
+      initializer.set_raw_data(raw_data_ptr, fbs_raw_data->size());
+    }
   }
 
   return Status::OK();
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 namespace ONNX_NAMESPACE {
 class TensorProto;
 class SparseTensorProto;
@@ -34,6 +36,10 @@ struct Tensor;
 
 namespace utils {
 
+// The raw_data of the initializers is aligned to this within the ORT format model buffer, so that when the buffer is
+// suitably aligned, e.g. when the model file is memory mapped, tensors can use the data in place.
+constexpr size_t kInitializerRawDataAlignment = 64;
+
 // TODO, add ORT_MUST_USE_RESULT when it is moved to a different header
 onnxruntime::common::Status SaveInitializerOrtFormat(
     flatbuffers::FlatBufferBuilder& builder, const ONNX_NAMESPACE::TensorProto& initializer,
@@ -54,8 +60,12 @@ onnxruntime::common::Status SaveAttributeOrtFormat(
 
 #if defined(ENABLE_ORT_FORMAT_LOAD)
 
+// If can_use_flatbuffer_for_initializers is true, an initializer whose raw data is aligned to
+// kInitializerRawDataAlignment refers to the raw data in the flatbuffer as in memory external data instead of copying
+// it. The caller has to keep the flatbuffer alive for as long as the initializer is used in that case.
 onnxruntime::common::Status LoadInitializerOrtFormat(
-    const fbs::Tensor& fbs_tensor, ONNX_NAMESPACE::TensorProto& initializer);
+    const fbs::Tensor& fbs_tensor, ONNX_NAMESPACE::TensorProto& initializer,
+    bool can_use_flatbuffer_for_initializers = false);
 
 onnxruntime::common::Status LoadSparseInitializerOrtFormat(const fbs::SparseTensor& fbs_sparse_tensor,
                                                            ONNX_NAMESPACE::SparseTensorProto& initializer);
@@ -412,7 +412,7 @@ bool ReplaceNodeWithInitializer(Graph& graph, Node& node, NodeArg& replacement)
 
     // Replace outgoing node's input.
     auto& output_node = *graph.GetNode(output_edge.dst_node);
-    ReplaceNodeInput(output_node, output_edge.dst_arg_index, replacement);
+    ReplaceNodeInput(graph, output_node, output_edge.dst_arg_index, replacement);
   }
 
   return true;
@@ -570,7 +570,7 @@ void ReplaceDownstreamNodeInput(Graph& graph, Node& node, int output_idx, Node&
   }
 }
 
-void ReplaceNodeInput(Node& target, int target_input_idx, NodeArg& new_input) {
+void ReplaceNodeInput(Graph& graph, Node& target, int target_input_idx, NodeArg& new_input) {
   size_t dst_arg_idx = static_cast<size_t>(target_input_idx);
   auto num_explicit_inputs = target.InputDefs().size();
 
@@ -585,9 +585,11 @@ void ReplaceNodeInput(Node& target, int target_input_idx, NodeArg& new_input) {
               " ExplicitInputs:", num_explicit_inputs,
               " ImplicitInputs:", target.ImplicitInputDefs().size());
   }
+
+  graph.MarkNodeModified(target.Index());
 }
 
-void AddNodeInput(Node& target, int target_input_idx, NodeArg& new_input) {
+void AddNodeInput(Graph& graph, Node& target, int target_input_idx, NodeArg& new_input) {
   auto num_explicit_inputs = target.InputDefs().size();
   ORT_ENFORCE(num_explicit_inputs == static_cast<size_t>(target_input_idx),
               "Can only add a new input at the end of the current ones.");
@@ -595,6 +597,8 @@ void AddNodeInput(Node& target, int target_input_idx, NodeArg& new_input) {
   target.MutableInputDefs().push_back(&new_input);
   assert(target.MutableInputArgsCount().size() > static_cast<size_t>(target_input_idx));  // expect existing entry for all possible inputs
   target.MutableInputArgsCount()[target_input_idx] = 1;
+
+  graph.MarkNodeModified(target.Index());
 }
 
 void FinalizeNodeFusion(Graph& graph, Node& first_node, Node& second_node) {
@@ -172,7 +172,7 @@ void ReplaceDownstreamNodeInput(Graph& graph, Node& node, int output_idx, Node&
          as typically this function is used to replace an input with an initializer or graph input
          (there is no edge between an initializer or graph input and a Node).
 */
-void ReplaceNodeInput(Node& target, int target_input_idx, NodeArg& new_input);
+void ReplaceNodeInput(Graph& graph, Node& target, int target_input_idx, NodeArg& new_input);
 
 /** Add an input to a node with a NodeArg for an initializer or graph input.
 @remarks target_input_idx must be the next input slot.
@@ -180,7 +180,7 @@ void ReplaceNodeInput(Node& target, int target_input_idx, NodeArg& new_input);
          There is no edge between an initializer or graph input and a Node, so the replacement only updates the
          node's input definition and does not create any new edges.
 */
-void AddNodeInput(Node& target, int target_input_idx, NodeArg& new_input);
+void AddNodeInput(Graph& graph, Node& target, int target_input_idx, NodeArg& new_input);
 
 /** Finalize the fusion of second_node into first_node.
     The output definitions and edges from the second_node are moved to first_node. second_node is deleted.
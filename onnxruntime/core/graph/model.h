@@ -264,10 +264,13 @@ class Model {
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 #if defined(ENABLE_ORT_FORMAT_LOAD)
+  // If can_use_flatbuffer_for_initializers is true, the initializers may refer to the data in the buffer of
+  // fbs_model instead of copying it, so the buffer has to outlive the model.
   static common::Status LoadFromOrtFormat(const onnxruntime::experimental::fbs::Model& fbs_model,
 #if !defined(ORT_MINIMAL_BUILD)
                                           const IOnnxRuntimeOpSchemaRegistryList* local_registries,
 #endif
+                                          bool can_use_flatbuffer_for_initializers,
                                           const logging::Logger& logger,
                                           std::unique_ptr<Model>& model);
 #endif
@@ -622,6 +622,231 @@ MlasGemmPackB(
     void* PackedB
     );
 
+//
+// Single precision matrix/matrix multiply routines with a half precision
+// matrix B. The elements of matrix B are converted to single precision inside
+// the kernel, so matrix B stays half precision in memory (and in the packed
+// buffer).
+//
+
+/**
+ * @brief Supply matrices data information to half precision B gemm functions
+ */
+struct MLAS_HALF_GEMM_DATA_PARAMS {
+    const float* A = nullptr;   /**< Supplies the address of matrix A */
+    size_t lda = 0;             /**< Supplies the first dimension of matrix A. */
+    const void* B = nullptr;    /**< Supplies the address of half precision matrix B or packed B */
+    size_t ldb = 0;             /**< Supplies the first dimension of matrix B. */
+    float* C = nullptr;         /**< Supplies the address of matrix C */
+    size_t ldc = 0;             /**< Supplies the first dimension of matrix C. */
+    float alpha = 1.0f;         /**< Supplies the scalar alpha multiplier (see SGEMM definition) */
+    float beta = 0.0f;          /**< Supplies the scalar beta multiplier (see SGEMM definition) */
+    bool BIsPacked = false;     /**< Whether B is pre-packed by MlasHalfGemmPackB */
+};
+
+/**
+ * @brief  Batched single precision matrix/matrix multiply operation with a
+ *         half precision matrix B
+ *
+ * @param TransA     Supplies the transpose operation for matrix A.
+ * @param TransB     Supplies the transpose operation for matrix B. Ignored
+                     when B is pre-packed.
+ * @param M          Supplies the number of rows of matrix A and matrix C.
+ * @param N          Supplies the number of columns of matrix B and matrix C.
+ * @param K          Supplies the number of columns of matrix A and the number
+                     of rows of matrix B.
+ * @param Data       A array of matrices data parameters
+ * @param BatchSize  Supplies number of multiplications in this batch
+ * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
+                     base library threading support should be used.
+ */
+void
+MLASCALL
+MlasHalfGemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_HALF_GEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+size_t
+MLASCALL
+MlasHalfGemmPackBSize(
+    size_t N,
+    size_t K
+    );
+
+void
+MLASCALL
+MlasHalfGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const uint16_t* B,
+    size_t ldb,
+    void* PackedB
+    );
+
+//
+// Single precision matrix/matrix multiply routines with a 4-bit block
+// quantized matrix B. Each column of matrix B is split into blocks of
+// BlockSize rows that share a scale and a 4-bit zero point. The packed matrix
+// B is dequantized in registers inside the kernel.
+//
+// The quantized matrix B is stored column by column as [N][BlockCountK]
+// [BlockSize / 2] bytes, with BlockCountK = (K + BlockSize - 1) / BlockSize.
+// Row k of a column is in the low nibble of its byte if k is even, else in the
+// high nibble. The scales are stored as [N][BlockCountK] floats and the
+// optional zero points as [N][(BlockCountK + 1) / 2] bytes with the same
+// nibble order. A missing zero point defaults to 8.
+//
+
+/**
+ * @brief Supply matrices data information to 4-bit quantized B gemm functions
+ */
+struct MLAS_Q4GEMM_DATA_PARAMS {
+    const float* A = nullptr;           /**< Supplies the address of matrix A */
+    size_t lda = 0;                     /**< Supplies the first dimension of matrix A. */
+    const void* PackedB = nullptr;      /**< Supplies the address of matrix B packed by MlasQ4GemmPackB */
+    float* C = nullptr;                 /**< Supplies the address of matrix C */
+    size_t ldc = 0;                     /**< Supplies the first dimension of matrix C. */
+    const float* Bias = nullptr;        /**< Supplies the optional bias vector of N elements */
+};
+
+/**
+ * @brief Check whether a block size is supported by the 4-bit quantized B
+ *        gemm functions. The block size must be a power of two from 16 to
+ *        256.
+ */
+bool
+MLASCALL
+MlasQ4GemmIsBlockSizeSupported(
+    size_t BlockSize
+    );
+
+/**
+ * @brief  Compute the size in bytes of the packed 4-bit matrix B
+ *
+ * @param N          Supplies the number of columns of matrix B.
+ * @param K          Supplies the number of rows of matrix B.
+ * @param BlockSize  Supplies the number of rows sharing a scale and zero point.
+ */
+size_t
+MLASCALL
+MlasQ4GemmPackBSize(
+    size_t N,
+    size_t K,
+    size_t BlockSize
+    );
+
+/**
+ * @brief  Pack the 4-bit quantized matrix B together with its scales and zero
+ *         points
+ *
+ * @param N           Supplies the number of columns of matrix B.
+ * @param K           Supplies the number of rows of matrix B.
+ * @param BlockSize   Supplies the number of rows sharing a scale and zero point.
+ * @param QuantB      Supplies the quantized matrix B.
+ * @param Scales      Supplies the per block scales.
+ * @param ZeroPoints  Supplies the per block 4-bit zero points, or nullptr to
+                      use the default zero point of 8.
+ * @param PackedB     Supplies the output buffer of MlasQ4GemmPackBSize bytes.
+ */
+void
+MLASCALL
+MlasQ4GemmPackB(
+    size_t N,
+    size_t K,
+    size_t BlockSize,
+    const uint8_t* QuantB,
+    const float* Scales,
+    const uint8_t* ZeroPoints,
+    void* PackedB
+    );
+
+/**
+ * @brief  Batched single precision matrix/matrix multiply operation with a
+ *         packed 4-bit quantized matrix B: C = A * B + Bias
+ *
+ * @param M          Supplies the number of rows of matrix A and matrix C.
+ * @param N          Supplies the number of columns of matrix B and matrix C.
+ * @param K          Supplies the number of columns of matrix A and the number
+                     of rows of matrix B.
+ * @param BlockSize  Supplies the block size used to pack matrix B.
+ * @param Data       A array of matrices data parameters
+ * @param BatchSize  Supplies number of multiplications in this batch
+ * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
+                     base library threading support should be used.
+ */
+void
+MLASCALL
+MlasQ4GemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BlockSize,
+    const MLAS_Q4GEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Fused scaled dot product attention routines. The softmax is computed online
+// over blocks of keys, so the SequenceLength x KVSequenceLength attention
+// probabilities are never materialized.
+//
+
+/**
+ * @brief Supply the data of one attention head to the fused attention function
+ */
+struct MLAS_ATTENTION_DATA_PARAMS {
+    const float* Q = nullptr;           /**< Supplies the address of the queries, SequenceLength x HeadSizeQK */
+    size_t ldq = 0;                     /**< Supplies the first dimension of Q */
+    const float* K = nullptr;           /**< Supplies the address of the keys, KVSequenceLength x HeadSizeQK */
+    size_t ldk = 0;                     /**< Supplies the first dimension of K */
+    const float* V = nullptr;           /**< Supplies the address of the values, KVSequenceLength x HeadSizeV */
+    size_t ldv = 0;                     /**< Supplies the first dimension of V */
+    float* Output = nullptr;            /**< Supplies the address of the output, SequenceLength x HeadSizeV */
+    size_t ldo = 0;                     /**< Supplies the first dimension of Output */
+    const float* Mask = nullptr;        /**< Supplies the optional additive mask, SequenceLength x KVSequenceLength */
+    size_t ldm = 0;                     /**< Supplies the first dimension of Mask, 0 to broadcast a single row */
+};
+
+/**
+ * @brief  Batched fused attention: Output = Softmax(Scale * Q * K^T + Mask) * V
+ *
+ * @param SequenceLength    Supplies the number of queries.
+ * @param KVSequenceLength  Supplies the number of keys and values.
+ * @param HeadSizeQK        Supplies the number of columns of Q and K.
+ * @param HeadSizeV         Supplies the number of columns of V and Output.
+ * @param Scale             Supplies the scale applied to Q * K^T.
+ * @param Causal            Supplies true if query i can only attend to the keys
+                            up to KVSequenceLength - SequenceLength + i. The
+                            keys after it are skipped.
+ * @param Data              A array of attention heads data parameters
+ * @param BatchSize         Supplies number of attention heads in this batch
+ * @param ThreadPool        Supplies the thread pool object to use, else nullptr
+                            if the base library threading support should be
+                            used.
+ */
+void
+MLASCALL
+MlasFlashAttention(
+    size_t SequenceLength,
+    size_t KVSequenceLength,
+    size_t HeadSizeQK,
+    size_t HeadSizeV,
+    float Scale,
+    bool Causal,
+    const MLAS_ATTENTION_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 //
 // Convolution routines.
 //
@@ -785,6 +1010,37 @@ MlasComputeSoftmax(
     MLAS_THREADPOOL* ThreadPool
     );
 
+void
+MLASCALL
+MlasComputeLayerNorm(
+    const float* Input,
+    const float* Scale,
+    const float* Bias,
+    float* Output,
+    float* Mean,
+    float* InvStdDev,
+    size_t N,
+    size_t D,
+    float Epsilon,
+    bool Simplified,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MLASCALL
+MlasComputeSkipLayerNorm(
+    const float* Input,
+    const float* Skip,
+    const float* SkipBias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    size_t N,
+    size_t D,
+    float Epsilon,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 void
 MLASCALL
 MlasComputeTanh(
@@ -806,6 +1062,54 @@ MlasConvertHalfToFloatBuffer(
     size_t Count
     );
 
+void
+MLASCALL
+MlasConvertFloatToHalfBuffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    );
+
+//
+// BFloat16 floating-point routines.
+//
+
+void
+MLASCALL
+MlasConvertBFloat16ToFloatBuffer(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    );
+
+void
+MLASCALL
+MlasConvertFloatToBFloat16Buffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    );
+
+//
+// Integer and floating-point conversion routines.
+//
+
+void
+MLASCALL
+MlasConvertInt32ToFloatBuffer(
+    const int32_t* Source,
+    float* Destination,
+    size_t Count
+    );
+
+void
+MLASCALL
+MlasConvertFloatToInt32Buffer(
+    const float* Source,
+    int32_t* Destination,
+    size_t Count
+    );
+
 //
 // Transpose routines.
 //
@@ -837,6 +1141,39 @@ MlasTranspose(
     size_t N
     );
 
+void
+MLASCALL
+MlasTranspose(
+    const uint8_t* Input,
+    size_t ldInput,
+    uint8_t* Output,
+    size_t ldOutput,
+    size_t M,
+    size_t N
+    );
+
+void
+MLASCALL
+MlasTranspose(
+    const uint32_t* Input,
+    size_t ldInput,
+    uint32_t* Output,
+    size_t ldOutput,
+    size_t M,
+    size_t N
+    );
+
+void
+MLASCALL
+MlasTranspose(
+    const float* Input,
+    size_t ldInput,
+    float* Output,
+    size_t ldOutput,
+    size_t M,
+    size_t N
+    );
+
 //
 // Buffer reordering routines.
 //
@@ -0,0 +1,417 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    cast.cpp
+
+Abstract:
+
+    This module implements the routines to convert buffers of single
+    precision floating point values to and from half precision, bfloat16 and
+    32-bit integer values.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasCastF16ToF32Kernel(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a buffer of half precision floating point values to
+    single precision.
+
+Arguments:
+
+    Source - Supplies the buffer of half precision values.
+
+    Destination - Supplies the buffer of single precision values.
+
+    Count - Supplies the number of values to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MlasHalfToFloat(Source[i]);
+    }
+}
+
+void
+MLASCALL
+MlasCastF32ToF16Kernel(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a buffer of single precision floating point values to
+    half precision, rounding to nearest even.
+
+Arguments:
+
+    Source - Supplies the buffer of single precision values.
+
+    Destination - Supplies the buffer of half precision values.
+
+    Count - Supplies the number of values to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MlasFloatToHalf(Source[i]);
+    }
+}
+
+#if !(defined(MLAS_TARGET_AMD64) && defined(_MSC_VER))
+
+//
+// The Windows x64 build implements this routine in assembly.
+//
+
+void
+MLASCALL
+MlasConvertHalfToFloatBuffer(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+#if defined(MLAS_TARGET_AMD64)
+    MlasPlatform.CastF16ToF32Kernel(Source, Destination, Count);
+#else
+    MlasCastF16ToF32Kernel(Source, Destination, Count);
+#endif
+}
+
+#endif
+
+void
+MLASCALL
+MlasConvertFloatToHalfBuffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a buffer of single precision floating point values to
+    half precision, rounding to nearest even.
+
+Arguments:
+
+    Source - Supplies the buffer of single precision values.
+
+    Destination - Supplies the buffer of half precision values.
+
+    Count - Supplies the number of values to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    MlasPlatform.CastF32ToF16Kernel(Source, Destination, Count);
+#else
+    MlasCastF32ToF16Kernel(Source, Destination, Count);
+#endif
+}
+
+void
+MLASCALL
+MlasConvertBFloat16ToFloatBuffer(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a buffer of bfloat16 floating point values to single
+    precision.
+
+Arguments:
+
+    Source - Supplies the buffer of bfloat16 values.
+
+    Destination - Supplies the buffer of single precision values.
+
+    Count - Supplies the number of values to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_SSE2_INTRINSICS)
+
+    const __m128i ZeroVector = _mm_setzero_si128();
+
+    while (Count >= 8) {
+
+        __m128i Elements = _mm_loadu_si128((const __m128i*)Source);
+
+        _mm_storeu_ps(Destination, _mm_castsi128_ps(_mm_unpacklo_epi16(ZeroVector, Elements)));
+        _mm_storeu_ps(Destination + 4, _mm_castsi128_ps(_mm_unpackhi_epi16(ZeroVector, Elements)));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+#elif defined(MLAS_NEON_INTRINSICS)
+
+    while (Count >= 8) {
+
+        uint16x8_t Elements = vld1q_u16(Source);
+
+        vst1q_f32(Destination, vreinterpretq_f32_u32(vshll_n_u16(vget_low_u16(Elements), 16)));
+        vst1q_f32(Destination + 4, vreinterpretq_f32_u32(vshll_n_u16(vget_high_u16(Elements), 16)));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+#endif
+
+    while (Count > 0) {
+
+        *Destination++ = MlasBFloat16ToFloat(*Source++);
+        Count -= 1;
+    }
+}
+
+#if defined(MLAS_SSE2_INTRINSICS)
+
+MLAS_FORCEINLINE
+__m128i
+MlasFloatToBFloat16x4Sse(
+    __m128 Vector
+    )
+/*++
+
+Routine Description:
+
+    This routine rounds four single precision values to bfloat16. The bfloat16
+    values are returned sign extended in the 32-bit lanes, so the lanes of two
+    vectors can be narrowed with a signed saturating pack without saturating.
+
+--*/
+{
+    __m128i Bits = _mm_castps_si128(Vector);
+
+    __m128i RoundingBias = _mm_and_si128(_mm_srli_epi32(Bits, 16), _mm_set1_epi32(1));
+    RoundingBias = _mm_add_epi32(RoundingBias, _mm_set1_epi32(0x7FFF));
+    __m128i Rounded = _mm_add_epi32(Bits, RoundingBias);
+
+    __m128i IsNaN = _mm_castps_si128(_mm_cmpunord_ps(Vector, Vector));
+    __m128i QuietNaN = _mm_or_si128(_mm_and_si128(Bits, _mm_set1_epi32(int32_t(0x80000000))),
+        _mm_set1_epi32(0x7FC00000));
+    Rounded = _mm_or_si128(_mm_and_si128(IsNaN, QuietNaN), _mm_andnot_si128(IsNaN, Rounded));
+
+    return _mm_srai_epi32(Rounded, 16);
+}
+
+#elif defined(MLAS_NEON_INTRINSICS)
+
+MLAS_FORCEINLINE
+uint16x4_t
+MlasFloatToBFloat16x4Neon(
+    float32x4_t Vector
+    )
+{
+    uint32x4_t Bits = vreinterpretq_u32_f32(Vector);
+
+    uint32x4_t RoundingBias = vandq_u32(vshrq_n_u32(Bits, 16), vdupq_n_u32(1));
+    RoundingBias = vaddq_u32(RoundingBias, vdupq_n_u32(0x7FFF));
+    uint32x4_t Rounded = vaddq_u32(Bits, RoundingBias);
+
+    uint32x4_t IsNumber = vceqq_f32(Vector, Vector);
+    uint32x4_t QuietNaN = vorrq_u32(vandq_u32(Bits, vdupq_n_u32(0x80000000)), vdupq_n_u32(0x7FC00000));
+    Rounded = vbslq_u32(IsNumber, Rounded, QuietNaN);
+
+    return vshrn_n_u32(Rounded, 16);
+}
+
+#endif
+
+void
+MLASCALL
+MlasConvertFloatToBFloat16Buffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a buffer of single precision floating point values to
+    bfloat16, rounding to nearest even.
+
+Arguments:
+
+    Source - Supplies the buffer of single precision values.
+
+    Destination - Supplies the buffer of bfloat16 values.
+
+    Count - Supplies the number of values to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_SSE2_INTRINSICS)
+
+    while (Count >= 8) {
+
+        __m128i Elements0 = MlasFloatToBFloat16x4Sse(_mm_loadu_ps(Source));
+        __m128i Elements1 = MlasFloatToBFloat16x4Sse(_mm_loadu_ps(Source + 4));
+
+        _mm_storeu_si128((__m128i*)Destination, _mm_packs_epi32(Elements0, Elements1));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+#elif defined(MLAS_NEON_INTRINSICS)
+
+    while (Count >= 8) {
+
+        uint16x4_t Elements0 = MlasFloatToBFloat16x4Neon(vld1q_f32(Source));
+        uint16x4_t Elements1 = MlasFloatToBFloat16x4Neon(vld1q_f32(Source + 4));
+
+        vst1q_u16(Destination, vcombine_u16(Elements0, Elements1));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+#endif
+
+    while (Count > 0) {
+
+        *Destination++ = MlasFloatToBFloat16(*Source++);
+        Count -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasConvertInt32ToFloatBuffer(
+    const int32_t* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a buffer of 32-bit integer values to single precision
+    floating point values.
+
+Arguments:
+
+    Source - Supplies the buffer of integer values.
+
+    Destination - Supplies the buffer of single precision values.
+
+    Count - Supplies the number of values to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (Count >= 4) {
+
+        MlasStoreFloat32x4(Destination, MlasCastToFloat32x4(MlasLoadInt32x4(Source)));
+
+        Source += 4;
+        Destination += 4;
+        Count -= 4;
+    }
+
+    while (Count > 0) {
+
+        *Destination++ = float(*Source++);
+        Count -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasConvertFloatToInt32Buffer(
+    const float* Source,
+    int32_t* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a buffer of single precision floating point values to
+    32-bit integer values, truncating toward zero.
+
+Arguments:
+
+    Source - Supplies the buffer of single precision values.
+
+    Destination - Supplies the buffer of integer values.
+
+    Count - Supplies the number of values to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (Count >= 4) {
+
+        MlasStoreInt32x4(Destination, MlasCastToInt32x4(MlasLoadFloat32x4(Source)));
+
+        Source += 4;
+        Destination += 4;
+        Count -= 4;
+    }
+
+    while (Count > 0) {
+
+        *Destination++ = int32_t(*Source++);
+        Count -= 1;
+    }
+}
@@ -0,0 +1,322 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    flashattn.cpp
+
+Abstract:
+
+    This module implements the fused scaled dot product attention operation.
+
+    The queries are processed in blocks of rows and the keys and values are
+    streamed in blocks. The softmax is computed online: the running maximum
+    and sum of each query row are updated for every block of keys and the
+    partial output is rescaled accordingly. The working set per query block is
+    a single tile of scores, so the memory traffic per head is linear in the
+    sequence length instead of quadratic.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the number of query rows processed together. The rows share each
+// block of keys and values loaded from memory.
+//
+
+#define MLAS_FLASH_ATTENTION_QUERY_BLOCK            32
+
+//
+// Define the number of keys and values processed together. The tile of
+// scores of a query block fits in the L1 cache.
+//
+
+#define MLAS_FLASH_ATTENTION_KV_BLOCK               128
+
+void
+MlasFlashAttentionQueryBlock(
+    size_t SequenceLength,
+    size_t KVSequenceLength,
+    size_t HeadSizeQK,
+    size_t HeadSizeV,
+    float Scale,
+    bool Causal,
+    const MLAS_ATTENTION_DATA_PARAMS* Data,
+    size_t QueryStart,
+    size_t QueryCount
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the attention output for a block of query rows of
+    one attention head.
+
+Arguments:
+
+    SequenceLength - Supplies the number of queries.
+
+    KVSequenceLength - Supplies the number of keys and values.
+
+    HeadSizeQK - Supplies the number of columns of the queries and keys.
+
+    HeadSizeV - Supplies the number of columns of the values and the output.
+
+    Scale - Supplies the scale applied to the query/key dot products.
+
+    Causal - Supplies true if a query can only attend to the keys up to its
+        position in the key sequence.
+
+    Data - Supplies the attention head data parameters.
+
+    QueryStart - Supplies the first query row to process.
+
+    QueryCount - Supplies the number of query rows to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(float Scores[MLAS_FLASH_ATTENTION_QUERY_BLOCK * MLAS_FLASH_ATTENTION_KV_BLOCK], 64);
+    float RowMaximum[MLAS_FLASH_ATTENTION_QUERY_BLOCK];
+    float RowSum[MLAS_FLASH_ATTENTION_QUERY_BLOCK];
+
+    const float* Q = Data->Q + QueryStart * Data->ldq;
+    float* Output = Data->Output + QueryStart * Data->ldo;
+
+    //
+    // The queries are aligned to the end of the key sequence, so query i
+    // attends to the keys up to PastLength + i when causal.
+    //
+
+    const size_t PastLength = KVSequenceLength - SequenceLength;
+
+    size_t KVLimit = KVSequenceLength;
+
+    if (Causal) {
+        KVLimit = std::min(KVSequenceLength, PastLength + QueryStart + QueryCount);
+    }
+
+    for (size_t r = 0; r < QueryCount; r++) {
+        RowMaximum[r] = std::numeric_limits<float>::lowest();
+        RowSum[r] = 0.0f;
+        std::fill_n(Output + r * Data->ldo, HeadSizeV, 0.0f);
+    }
+
+    for (size_t kv = 0; kv < KVLimit; kv += MLAS_FLASH_ATTENTION_KV_BLOCK) {
+
+        const size_t CountKV = std::min(KVLimit - kv, size_t(MLAS_FLASH_ATTENTION_KV_BLOCK));
+
+        //
+        // Compute the scores of the query block against the block of keys.
+        //
+
+        MlasGemm(CblasNoTrans, CblasTrans, QueryCount, CountKV, HeadSizeQK, Scale,
+            Q, Data->ldq, Data->K + kv * Data->ldk, Data->ldk, 0.0f, Scores, CountKV,
+            nullptr);
+
+        //
+        // Update the online softmax state of each row and replace the scores
+        // with the unnormalized probabilities.
+        //
+
+        for (size_t r = 0; r < QueryCount; r++) {
+
+            float* s = Scores + r * CountKV;
+            size_t RowCountKV = CountKV;
+
+            if (Causal) {
+                const size_t RowLimit = PastLength + QueryStart + r + 1;
+                RowCountKV = (RowLimit > kv) ? std::min(CountKV, RowLimit - kv) : 0;
+            }
+
+            std::fill(s + RowCountKV, s + CountKV, 0.0f);
+
+            if (RowCountKV == 0) {
+                continue;
+            }
+
+            if (Data->Mask != nullptr) {
+                const float* m = Data->Mask + (QueryStart + r) * Data->ldm + kv;
+                for (size_t j = 0; j < RowCountKV; j++) {
+                    s[j] += m[j];
+                }
+            }
+
+#if defined(MLAS_TARGET_AMD64)
+            float Maximum = MlasPlatform.ReduceMaximumF32Kernel(s, RowCountKV);
+#else
+            float Maximum = MlasReduceMaximumF32Kernel(s, RowCountKV);
+#endif
+
+            if (Maximum < RowMaximum[r]) {
+                Maximum = RowMaximum[r];
+            }
+
+            float NegativeMaximum = -Maximum;
+
+#if defined(MLAS_TARGET_AMD64)
+            float Accumulation = MlasPlatform.ComputeSumExpF32Kernel(s, s, RowCountKV, &NegativeMaximum);
+#else
+            float Accumulation = MlasComputeSumExpF32Kernel(s, s, RowCountKV, &NegativeMaximum);
+#endif
+
+            //
+            // Rescale the partial output of the row if the running maximum
+            // has changed.
+            //
+
+            if (Maximum != RowMaximum[r]) {
+
+                const float Correction = std::exp(RowMaximum[r] - Maximum);
+
+                float* o = Output + r * Data->ldo;
+
+                for (size_t h = 0; h < HeadSizeV; h++) {
+                    o[h] *= Correction;
+                }
+
+                RowSum[r] *= Correction;
+                RowMaximum[r] = Maximum;
+            }
+
+            RowSum[r] += Accumulation;
+        }
+
+        //
+        // Accumulate the probabilities times the block of values.
+        //
+
+        MlasGemm(CblasNoTrans, CblasNoTrans, QueryCount, HeadSizeV, CountKV, 1.0f,
+            Scores, CountKV, Data->V + kv * Data->ldv, Data->ldv, 1.0f, Output, Data->ldo,
+            nullptr);
+    }
+
+    //
+    // Normalize the output rows by the softmax denominators.
+    //
+
+    for (size_t r = 0; r < QueryCount; r++) {
+
+        if (RowSum[r] == 0.0f) {
+            continue;
+        }
+
+        const float ReciprocalSum = 1.0f / RowSum[r];
+
+        float* o = Output + r * Data->ldo;
+
+        for (size_t h = 0; h < HeadSizeV; h++) {
+            o[h] *= ReciprocalSum;
+        }
+    }
+}
+
+void
+MLASCALL
+MlasFlashAttention(
+    size_t SequenceLength,
+    size_t KVSequenceLength,
+    size_t HeadSizeQK,
+    size_t HeadSizeV,
+    float Scale,
+    bool Causal,
+    const MLAS_ATTENTION_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the batched fused attention operation.
+
+Arguments:
+
+    SequenceLength - Supplies the number of queries.
+
+    KVSequenceLength - Supplies the number of keys and values. The queries
+        are aligned to the end of the key sequence.
+
+    HeadSizeQK - Supplies the number of columns of the queries and keys.
+
+    HeadSizeV - Supplies the number of columns of the values and the output.
+
+    Scale - Supplies the scale applied to the query/key dot products.
+
+    Causal - Supplies true if a query can only attend to the keys up to its
+        position in the key sequence.
+
+    Data - Supplies an array of attention head data parameters.
+
+    BatchSize - Supplies the number of attention heads.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (SequenceLength == 0 || BatchSize == 0) {
+        return;
+    }
+
+    const size_t QueryBlockCount = (SequenceLength + MLAS_FLASH_ATTENTION_QUERY_BLOCK - 1) /
+        MLAS_FLASH_ATTENTION_QUERY_BLOCK;
+    const size_t WorkCount = QueryBlockCount * BatchSize;
+
+    //
+    // Compute the number of target threads given the complexity of the
+    // operation. Small requests should run using the single threaded path.
+    //
+
+    const double Complexity = double(BatchSize) * double(SequenceLength) *
+        double(KVSequenceLength) * double(HeadSizeQK + HeadSizeV);
+
+    ptrdiff_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MlasPlatform.MaximumThreadCount)) {
+        TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MlasPlatform.MaximumThreadCount;
+    }
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (size_t(TargetThreadCount) >= WorkCount) {
+        TargetThreadCount = ptrdiff_t(WorkCount);
+    }
+
+    //
+    // Distribute the query blocks round robin across the threads. With a
+    // causal mask the later query blocks attend to more keys, so interleaving
+    // balances the work better than contiguous ranges.
+    //
+
+    MlasTrySimpleParallel(ThreadPool, TargetThreadCount, [&](ptrdiff_t tid) {
+
+        for (size_t WorkIndex = size_t(tid); WorkIndex < WorkCount; WorkIndex += size_t(TargetThreadCount)) {
+
+            const size_t HeadIndex = WorkIndex / QueryBlockCount;
+            const size_t QueryStart = (WorkIndex % QueryBlockCount) * MLAS_FLASH_ATTENTION_QUERY_BLOCK;
+            const size_t QueryCount = std::min(SequenceLength - QueryStart,
+                size_t(MLAS_FLASH_ATTENTION_QUERY_BLOCK));
+
+            MlasFlashAttentionQueryBlock(SequenceLength, KVSequenceLength, HeadSizeQK,
+                HeadSizeV, Scale, Causal, &Data[HeadIndex], QueryStart, QueryCount);
+        }
+    });
+}
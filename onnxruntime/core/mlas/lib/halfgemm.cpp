@@ -0,0 +1,835 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm.cpp
+
+Abstract:
+
+    This module implements the single precision matrix/matrix multiply
+    operation with a half precision matrix B.
+
+    Matrix B is kept in half precision format in the packed buffers and is
+    converted to single precision inside the kernels, which halves the memory
+    footprint and bandwidth required for the weights of a model.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the default strides to step through slices of the input matrices.
+//
+
+#define MLAS_HALF_GEMM_STRIDEN                      128
+#define MLAS_HALF_GEMM_STRIDEK                      128
+#define MLAS_HALF_GEMM_PACKED_STRIDEN               128
+#define MLAS_HALF_GEMM_PACKED_STRIDEK               256
+
+//
+// Define the number of rows from matrix A to transpose to a local buffer.
+//
+
+#define MLAS_HALF_GEMM_TRANSA_ROWS                  12
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernelRows(
+    const float* A,
+    const uint16_t* B,
+    float* C,
+    size_t CountK,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    float alpha,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute matrix multiplication for a
+    set of rows using portable C++ code.
+
+Arguments:
+
+    A - Supplies the address of matrix A.
+
+    B - Supplies the address of matrix B. The matrix data has been packed
+        using MlasHalfGemmCopyPackB or MlasHalfGemmTransposePackB.
+
+    C - Supplies the address of matrix C.
+
+    CountK - Supplies the number of columns from matrix A and the number of
+        rows from matrix B to iterate over.
+
+    CountN - Supplies the number of columns from matrix B and matrix C to
+        iterate over.
+
+    lda - Supplies the first dimension of matrix A.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    alpha - Supplies the scalar multiplier (see SGEMM definition).
+
+    ZeroMode - Supplies true if the output matrix must be zero initialized,
+        else false if the output matrix is accumulated into.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (CountN > 0) {
+
+        float Accumulators[RowCount][16];
+
+        for (size_t r = 0; r < RowCount; r++) {
+            std::fill_n(Accumulators[r], 16, 0.0f);
+        }
+
+        for (size_t k = 0; k < CountK; k++) {
+
+            float BlockB[16];
+
+            for (size_t n = 0; n < 16; n++) {
+                BlockB[n] = MlasHalfToFloat(B[n]);
+            }
+
+            for (size_t r = 0; r < RowCount; r++) {
+
+                const float ElementA = A[r * lda + k];
+
+                for (size_t n = 0; n < 16; n++) {
+                    Accumulators[r][n] += ElementA * BlockB[n];
+                }
+            }
+
+            B += 16;
+        }
+
+        const size_t CountBlockN = std::min(CountN, size_t(16));
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            float* c = C + r * ldc;
+
+            for (size_t n = 0; n < CountBlockN; n++) {
+                float Value = Accumulators[r][n] * alpha;
+                if (!ZeroMode) {
+                    Value += c[n];
+                }
+                c[n] = Value;
+            }
+        }
+
+        C += 16;
+        CountN -= CountBlockN;
+    }
+}
+
+size_t
+MLASCALL
+MlasHalfGemmKernel(
+    const float* A,
+    const uint16_t* B,
+    float* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    float alpha,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute matrix multiplication for a
+    set of rows using portable C++ code.
+
+Arguments:
+
+    A - Supplies the address of matrix A.
+
+    B - Supplies the address of matrix B. The matrix data has been packed
+        using MlasHalfGemmCopyPackB or MlasHalfGemmTransposePackB.
+
+    C - Supplies the address of matrix C.
+
+    CountK - Supplies the number of columns from matrix A and the number of
+        rows from matrix B to iterate over.
+
+    CountM - Supplies the maximum number of rows that can be processed for
+        matrix A and matrix C. The actual number of rows handled for this
+        invocation depends on the kernel implementation.
+
+    CountN - Supplies the number of columns from matrix B and matrix C to
+        iterate over.
+
+    lda - Supplies the first dimension of matrix A.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    alpha - Supplies the scalar multiplier (see SGEMM definition).
+
+    ZeroMode - Supplies true if the output matrix must be zero initialized,
+        else false if the output matrix is accumulated into.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    if (CountM >= 4) {
+        MlasHalfGemmKernelRows<4>(A, B, C, CountK, CountN, lda, ldc, alpha, ZeroMode);
+        return 4;
+    }
+
+    switch (CountM) {
+        case 3:
+            MlasHalfGemmKernelRows<3>(A, B, C, CountK, CountN, lda, ldc, alpha, ZeroMode);
+            break;
+        case 2:
+            MlasHalfGemmKernelRows<2>(A, B, C, CountK, CountN, lda, ldc, alpha, ZeroMode);
+            break;
+        default:
+            MlasHalfGemmKernelRows<1>(A, B, C, CountK, CountN, lda, ldc, alpha, ZeroMode);
+            break;
+    }
+
+    return CountM;
+}
+
+void
+MlasHalfGemmCopyPackB(
+    uint16_t* D,
+    const uint16_t* B,
+    size_t ldb,
+    size_t CountX,
+    size_t CountY
+    )
+/*++
+
+Routine Description:
+
+    This routine copies elements from the source matrix to the destination
+    packed buffer.
+
+    Columns of 16 elements from the source matrix are unrolled to be physically
+    contiguous for better locality inside the kernels. Any remaining columns
+    less than 16 elements wide are zero-padded.
+
+Arguments:
+
+    D - Supplies the address of the destination packed buffer.
+
+    B - Supplies the address of the source matrix.
+
+    ldb - Supplies the number of elements per row of the source matrix.
+
+    CountX - Supplies the number of columns of the source matrix to copy.
+
+    CountY - Supplies the number of rows of the source matrix to copy.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (CountX > 0) {
+
+        const size_t CountBlockX = std::min(CountX, size_t(16));
+        const uint16_t* b = B;
+
+        for (size_t y = 0; y < CountY; y++) {
+
+            std::copy_n(b, CountBlockX, D);
+            std::fill_n(D + CountBlockX, 16 - CountBlockX, uint16_t(0));
+
+            D += 16;
+            b += ldb;
+        }
+
+        B += 16;
+        CountX -= CountBlockX;
+    }
+}
+
+void
+MlasHalfGemmTransposePackB(
+    uint16_t* D,
+    const uint16_t* B,
+    size_t ldb,
+    size_t CountY,
+    size_t CountX
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes elements from the source matrix to the destination
+    packed buffer.
+
+    Columns of 16 elements from the source matrix are unrolled to be physically
+    contiguous for better locality inside the kernels. Any remaining columns
+    less than 16 elements wide are zero-padded.
+
+Arguments:
+
+    D - Supplies the address of the destination packed buffer.
+
+    B - Supplies the address of the source matrix.
+
+    ldb - Supplies the number of elements per row of the source matrix.
+
+    CountY - Supplies the number of rows of the source matrix to transpose.
+
+    CountX - Supplies the number of columns of the source matrix to transpose.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (CountY > 0) {
+
+        const size_t CountBlockY = std::min(CountY, size_t(16));
+
+        for (size_t y = 0; y < 16; y++) {
+
+            uint16_t* d = D + y;
+
+            if (y < CountBlockY) {
+
+                const uint16_t* b = B + y * ldb;
+
+                for (size_t x = 0; x < CountX; x++) {
+                    d[x * 16] = b[x];
+                }
+
+            } else {
+
+                for (size_t x = 0; x < CountX; x++) {
+                    d[x * 16] = 0;
+                }
+            }
+        }
+
+        D += 16 * CountX;
+        B += 16 * ldb;
+        CountY -= CountBlockY;
+    }
+}
+
+MLAS_FORCEINLINE
+float*
+MlasHalfGemmKernelLoop(
+    const float* A,
+    const uint16_t* B,
+    float* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    float alpha,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine steps through the rows of the input and output matrices calling
+    the kernel until all rows have been processed.
+
+Arguments:
+
+    A - Supplies the address of matrix A.
+
+    B - Supplies the address of matrix B. The matrix data has been packed using
+        MlasHalfGemmCopyPackB or MlasHalfGemmTransposePackB.
+
+    C - Supplies the address of matrix C.
+
+    CountK - Supplies the number of columns from matrix A and the number of rows
+        from matrix B to iterate over.
+
+    CountM - Supplies the number of rows from matrix A and matrix C to iterate
+        over.
+
+    CountN - Supplies the number of columns from matrix B and matrix C to
+        iterate over.
+
+    lda - Supplies the first dimension of matrix A.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
+
+    ZeroMode - Supplies true if the output matrix must be zero initialized,
+        else false if the output matrix is accumulated into.
+
+Return Value:
+
+    Returns the next address of matrix C.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_HALF_GEMM_KERNEL* HalfGemmKernel = MlasPlatform.HalfGemmKernel;
+#else
+    MLAS_HALF_GEMM_KERNEL* HalfGemmKernel = MlasHalfGemmKernel;
+#endif
+
+    while (CountM > 0) {
+
+        size_t RowsHandled = HalfGemmKernel(A, B, C, CountK, CountM, CountN, lda, ldc, alpha, ZeroMode);
+
+        C += ldc * RowsHandled;
+        A += lda * RowsHandled;
+        CountM -= RowsHandled;
+    }
+
+    return C;
+}
+
+void
+MlasHalfGemmOperation(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t RangeStartN,
+    size_t RangeCountN,
+    size_t K,
+    const MLAS_HALF_GEMM_DATA_PARAMS* DataParams,
+    size_t AlignedN,
+    const float* A,
+    float* C
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation with a half precision matrix B for a range of columns.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    RangeStartN - Supplies the starting column from matrix B.
+
+    RangeCountN - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    DataParams - Supplies the data position and layout of the matrices.
+
+    AlignedN - Supplies the total number of aligned columns for packed matrix B.
+
+    A - Supplies the address of the first row of matrix A to process.
+
+    C - Supplies the address of the first element of matrix C to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float PanelA[MLAS_HALF_GEMM_TRANSA_ROWS * MLAS_HALF_GEMM_PACKED_STRIDEK];
+    MLAS_DECLSPEC_ALIGN(uint16_t PanelB[MLAS_HALF_GEMM_STRIDEN * MLAS_HALF_GEMM_STRIDEK], 64);
+
+    const size_t lda = DataParams->lda;
+    const size_t ldb = DataParams->ldb;
+    const size_t ldc = DataParams->ldc;
+    const float alpha = DataParams->alpha;
+    const float beta = DataParams->beta;
+    const bool BIsPacked = DataParams->BIsPacked;
+    const uint16_t* B = static_cast<const uint16_t*>(DataParams->B);
+
+    //
+    // Handle the special case of K equals zero. Apply the beta multiplier to
+    // the output matrix and exit.
+    //
+
+    if (K == 0) {
+        MlasSgemmMultiplyBeta(C, M, RangeCountN, ldc, beta);
+        return;
+    }
+
+    const size_t StrideN = BIsPacked ? MLAS_HALF_GEMM_PACKED_STRIDEN : MLAS_HALF_GEMM_STRIDEN;
+    const size_t StrideK = BIsPacked ? MLAS_HALF_GEMM_PACKED_STRIDEK : MLAS_HALF_GEMM_STRIDEK;
+
+    //
+    // Step through each slice of matrix B along the N dimension.
+    //
+
+    size_t CountN;
+
+    for (size_t n = 0; n < RangeCountN; n += CountN) {
+
+        const size_t SliceStartN = RangeStartN + n;
+
+        CountN = std::min(RangeCountN - n, StrideN);
+
+        //
+        // Multiply the output matrix by beta as needed.
+        //
+
+        if (beta != 0.0f && beta != 1.0f) {
+            MlasSgemmMultiplyBeta(C + n, M, CountN, ldc, beta);
+        }
+
+        //
+        // Step through each slice of matrix B along the K dimension.
+        //
+
+        size_t CountK;
+        bool ZeroMode = (beta == 0.0f);
+
+        for (size_t k = 0; k < K; k += CountK) {
+
+            CountK = std::min(K - k, StrideK);
+
+            //
+            // Reference the packed matrix B directly or copy a panel of
+            // matrix B to a local packed buffer.
+            //
+
+            const uint16_t* pb;
+
+            if (BIsPacked) {
+
+                pb = B + AlignedN * k + CountK * SliceStartN;
+
+            } else {
+
+                if (TransB == CblasNoTrans) {
+                    MlasHalfGemmCopyPackB(PanelB, B + SliceStartN + k * ldb, ldb, CountN, CountK);
+                } else {
+                    MlasHalfGemmTransposePackB(PanelB, B + k + SliceStartN * ldb, ldb, CountN, CountK);
+                }
+
+                pb = PanelB;
+            }
+
+            //
+            // Step through each slice of matrix A along the M dimension.
+            //
+
+            float* c = C + n;
+
+            if (TransA == CblasNoTrans) {
+
+                MlasHalfGemmKernelLoop(A + k, pb, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode);
+
+            } else {
+
+                const float* a = A + k * lda;
+                size_t RowsRemaining = M;
+
+                while (RowsRemaining > 0) {
+
+                    //
+                    // Transpose elements from matrix A into a local buffer.
+                    //
+
+                    size_t RowsTransposed = std::min(RowsRemaining, size_t(MLAS_HALF_GEMM_TRANSA_ROWS));
+
+                    MlasSgemmTransposeA(PanelA, a, lda, RowsTransposed, CountK);
+
+                    RowsRemaining -= RowsTransposed;
+                    a += RowsTransposed;
+
+                    //
+                    // Step through the rows of the local buffer.
+                    //
+
+                    c = MlasHalfGemmKernelLoop(PanelA, pb, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode);
+                }
+            }
+
+            ZeroMode = false;
+        }
+    }
+}
+
+void
+MlasHalfGemmThreaded(
+    const ptrdiff_t ThreadCountM,
+    const ptrdiff_t ThreadCountN,
+    const CBLAS_TRANSPOSE TransA,
+    const CBLAS_TRANSPOSE TransB,
+    const size_t M,
+    const size_t N,
+    const size_t K,
+    const MLAS_HALF_GEMM_DATA_PARAMS* DataParams,
+    ptrdiff_t ThreadId
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    half precision B GEMM operation.
+
+Arguments:
+
+    ThreadCountM - Supplies the total thread partition on the M dimension.
+
+    ThreadCountN - Supplies the total thread partition on the N dimension.
+
+    TransA - Supplies the transpose operation on A matrix
+
+    TransB - Supplies the transpose operation on B matrix
+
+    M, N, K - Supplies the shape of the multiplication
+
+    DataParams - Supplies the data position and layout of the matrices
+
+    ThreadId - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const ptrdiff_t ThreadIdM = ThreadId / ThreadCountN;
+    const ptrdiff_t ThreadIdN = ThreadId % ThreadCountN;
+
+    //
+    // Partition the operation along the M dimension.
+    //
+
+    size_t RangeStartM;
+    size_t RangeCountM;
+
+    MlasPartitionWork(ThreadIdM, ThreadCountM, M, &RangeStartM, &RangeCountM);
+
+    //
+    // Partition the operation along the N dimension.
+    //
+
+    size_t RangeStartN;
+    size_t RangeCountN;
+
+    const size_t BlockedN = (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) /
+        MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+
+    MlasPartitionWork(ThreadIdN, ThreadCountN, BlockedN, &RangeStartN,
+        &RangeCountN);
+
+    RangeStartN *= MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+    RangeCountN *= MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+
+    RangeCountN = std::min(N - RangeStartN, RangeCountN);
+
+    //
+    // Dispatch the partitioned operation.
+    //
+
+    const float* A = DataParams->A + RangeStartM * ((TransA == CblasNoTrans) ? DataParams->lda : 1);
+    float* C = DataParams->C + RangeStartM * DataParams->ldc + RangeStartN;
+
+    MlasHalfGemmOperation(TransA, TransB, RangeCountM, RangeStartN, RangeCountN, K,
+        DataParams, BlockedN * MLAS_SGEMM_STRIDEN_THREAD_ALIGN, A, C);
+}
+
+void
+MLASCALL
+MlasHalfGemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_HALF_GEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    //
+    // Compute the number of target threads given the complexity of the
+    // operation. Small requests should run using the single threaded path.
+    //
+
+    const double Complexity = double(M) * double(N) * double(K);
+
+    ptrdiff_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MlasPlatform.MaximumThreadCount)) {
+        TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MlasPlatform.MaximumThreadCount;
+    }
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    //
+    // Segment the operation across multiple threads.
+    //
+
+    ptrdiff_t ThreadsPerGemm = (TargetThreadCount + BatchSize - 1) / BatchSize;
+    ptrdiff_t ThreadCountM;
+    ptrdiff_t ThreadCountN;
+
+    if (N > M) {
+
+        const size_t BlockedN = (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) /
+            MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+
+        if (size_t(ThreadsPerGemm) > BlockedN) {
+            ThreadsPerGemm = ptrdiff_t(BlockedN);
+        }
+
+        ThreadCountM = 1;
+        ThreadCountN = ThreadsPerGemm;
+
+    } else {
+
+        if (size_t(ThreadsPerGemm) > M) {
+            ThreadsPerGemm = ptrdiff_t(M);
+        }
+
+        ThreadCountM = ThreadsPerGemm;
+        ThreadCountN = 1;
+    }
+
+    MlasTrySimpleParallel(ThreadPool,
+        ThreadsPerGemm * static_cast<ptrdiff_t>(BatchSize),
+        [=](ptrdiff_t tid)
+    {
+        ptrdiff_t GemmIdx = tid / ThreadsPerGemm;
+        ptrdiff_t ThreadIdx = tid % ThreadsPerGemm;
+        MlasHalfGemmThreaded(ThreadCountM, ThreadCountN,
+            TransA, TransB, M, N, K, &(Data[GemmIdx]), ThreadIdx);
+    });
+}
+
+size_t
+MLASCALL
+MlasHalfGemmPackBSize(
+    size_t N,
+    size_t K
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the length in bytes for the packed half precision
+    matrix B buffer.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+Return Value:
+
+    Returns the size in bytes for the packed matrix B buffer.
+
+--*/
+{
+    //
+    // Compute the number of bytes required to hold the packed buffer.
+    //
+
+    const size_t AlignedN =
+        (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+    const size_t BytesRequired = AlignedN * K * sizeof(uint16_t);
+    const size_t BufferAlignment = MlasGetPreferredBufferAlignment();
+    const size_t AlignedBytesRequired = (BytesRequired + BufferAlignment - 1) &
+        ~(BufferAlignment - 1);
+
+    return AlignedBytesRequired;
+}
+
+void
+MLASCALL
+MlasHalfGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const uint16_t* B,
+    size_t ldb,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine packs the contents of the half precision matrix B to the
+    destination buffer. The destination buffer should be sized based on
+    MlasHalfGemmPackBSize(). For best performance, the destination buffer
+    should be aligned to the value returned from
+    MlasGetPreferredBufferAlignment().
+
+Arguments:
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    PackedB - Supplies the address of packed matrix B.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t AlignedN =
+        (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+    uint16_t* D = static_cast<uint16_t*>(PackedB);
+
+    //
+    // Step through each slice of matrix B along the K dimension.
+    //
+
+    size_t CountK;
+
+    for (size_t k = 0; k < K; k += CountK) {
+
+        CountK = std::min(K - k, size_t(MLAS_HALF_GEMM_PACKED_STRIDEK));
+
+        if (TransB == CblasNoTrans) {
+            MlasHalfGemmCopyPackB(D, B + k * ldb, ldb, N, CountK);
+        } else {
+            MlasHalfGemmTransposePackB(D, B + k, ldb, N, CountK);
+        }
+
+        D += AlignedN * CountK;
+    }
+}
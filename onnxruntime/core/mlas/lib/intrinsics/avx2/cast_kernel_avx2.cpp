@@ -0,0 +1,111 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    cast_kernel_avx2.cpp
+
+Abstract:
+
+    This module implements the kernels to convert buffers between single and
+    half precision floating point values using F16C instructions.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasCastF16ToF32KernelAvx2(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 16) {
+
+        __m256 Elements0 = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)&Source[0]));
+        __m256 Elements1 = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)&Source[8]));
+
+        _mm256_storeu_ps(&Destination[0], Elements0);
+        _mm256_storeu_ps(&Destination[8], Elements1);
+
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    if (Count >= 8) {
+
+        _mm256_storeu_ps(Destination, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)Source)));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+    if (Count >= 4) {
+
+        _mm_storeu_ps(Destination, _mm_cvtph_ps(_mm_loadl_epi64((const __m128i*)Source)));
+
+        Source += 4;
+        Destination += 4;
+        Count -= 4;
+    }
+
+    while (Count > 0) {
+
+        *Destination++ = MlasHalfToFloat(*Source++);
+        Count -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasCastF32ToF16KernelAvx2(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 16) {
+
+        __m128i Elements0 = _mm256_cvtps_ph(_mm256_loadu_ps(&Source[0]), _MM_FROUND_TO_NEAREST_INT);
+        __m128i Elements1 = _mm256_cvtps_ph(_mm256_loadu_ps(&Source[8]), _MM_FROUND_TO_NEAREST_INT);
+
+        _mm_storeu_si128((__m128i*)&Destination[0], Elements0);
+        _mm_storeu_si128((__m128i*)&Destination[8], Elements1);
+
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    if (Count >= 8) {
+
+        _mm_storeu_si128((__m128i*)Destination,
+            _mm256_cvtps_ph(_mm256_loadu_ps(Source), _MM_FROUND_TO_NEAREST_INT));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+    if (Count >= 4) {
+
+        _mm_storel_epi64((__m128i*)Destination, _mm_cvtps_ph(_mm_loadu_ps(Source), _MM_FROUND_TO_NEAREST_INT));
+
+        Source += 4;
+        Destination += 4;
+        Count -= 4;
+    }
+
+    while (Count > 0) {
+
+        *Destination++ = MlasFloatToHalf(*Source++);
+        Count -= 1;
+    }
+}
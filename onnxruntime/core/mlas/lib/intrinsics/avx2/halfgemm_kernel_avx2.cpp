@@ -0,0 +1,183 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm_kernel_avx2.cpp
+
+Abstract:
+
+    This module implements the kernel for the single precision matrix/matrix
+    multiply operation with a half precision matrix B using AVX2, FMA3 and F16C
+    instructions.
+
+    Each row of a 16 column block of the packed matrix B is loaded as half
+    precision and converted to single precision in registers, so matrix B is
+    never expanded to single precision in memory.
+
+--*/
+
+#include "mlasi.h"
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernelAvx2Rows(
+    const float* A,
+    const uint16_t* B,
+    float* C,
+    size_t CountK,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    float alpha,
+    bool ZeroMode
+    )
+{
+    const __m256 AlphaBroadcast = _mm256_set1_ps(alpha);
+
+    while (CountN > 0) {
+
+        __m256 Accumulators0[RowCount];
+        __m256 Accumulators1[RowCount];
+
+        for (size_t r = 0; r < RowCount; r++) {
+            Accumulators0[r] = _mm256_setzero_ps();
+            Accumulators1[r] = _mm256_setzero_ps();
+        }
+
+        const float* a = A;
+
+        for (size_t k = 0; k < CountK; k++) {
+
+            __m256 ElementsB0 = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)&B[0]));
+            __m256 ElementsB1 = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)&B[8]));
+
+            for (size_t r = 0; r < RowCount; r++) {
+                __m256 ElementA = _mm256_broadcast_ss(&a[r * lda]);
+                Accumulators0[r] = _mm256_fmadd_ps(ElementA, ElementsB0, Accumulators0[r]);
+                Accumulators1[r] = _mm256_fmadd_ps(ElementA, ElementsB1, Accumulators1[r]);
+            }
+
+            a += 1;
+            B += 16;
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            Accumulators0[r] = _mm256_mul_ps(Accumulators0[r], AlphaBroadcast);
+            Accumulators1[r] = _mm256_mul_ps(Accumulators1[r], AlphaBroadcast);
+
+            float* c = C + r * ldc;
+
+            if (CountN >= 16) {
+
+                if (!ZeroMode) {
+                    Accumulators0[r] = _mm256_add_ps(Accumulators0[r], _mm256_loadu_ps(&c[0]));
+                    Accumulators1[r] = _mm256_add_ps(Accumulators1[r], _mm256_loadu_ps(&c[8]));
+                }
+
+                _mm256_storeu_ps(&c[0], Accumulators0[r]);
+                _mm256_storeu_ps(&c[8], Accumulators1[r]);
+
+            } else {
+
+                float Output[16];
+
+                _mm256_storeu_ps(&Output[0], Accumulators0[r]);
+                _mm256_storeu_ps(&Output[8], Accumulators1[r]);
+
+                for (size_t n = 0; n < CountN; n++) {
+                    c[n] = ZeroMode ? Output[n] : Output[n] + c[n];
+                }
+            }
+        }
+
+        C += 16;
+        CountN -= std::min(CountN, size_t(16));
+    }
+}
+
+size_t
+MLASCALL
+MlasHalfGemmKernelAvx2(
+    const float* A,
+    const uint16_t* B,
+    float* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    float alpha,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute matrix multiplication for a
+    set of rows.
+
+Arguments:
+
+    A - Supplies the address of matrix A.
+
+    B - Supplies the address of matrix B. The matrix data has been packed
+        using MlasHalfGemmCopyPackB or MlasHalfGemmTransposePackB.
+
+    C - Supplies the address of matrix C.
+
+    CountK - Supplies the number of columns from matrix A and the number of
+        rows from matrix B to iterate over.
+
+    CountM - Supplies the maximum number of rows that can be processed for
+        matrix A and matrix C. The actual number of rows handled for this
+        invocation depends on the kernel implementation.
+
+    CountN - Supplies the number of columns from matrix B and matrix C to
+        iterate over.
+
+    lda - Supplies the first dimension of matrix A.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    alpha - Supplies the scalar multiplier (see SGEMM definition).
+
+    ZeroMode - Supplies true if the output matrix must be zero initialized,
+        else false if the output matrix is accumulated into.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    if (CountM >= 6) {
+        MlasHalfGemmKernelAvx2Rows<6>(A, B, C, CountK, CountN, lda, ldc, alpha, ZeroMode);
+        return 6;
+    }
+
+    switch (CountM) {
+        case 5:
+            MlasHalfGemmKernelAvx2Rows<5>(A, B, C, CountK, CountN, lda, ldc, alpha, ZeroMode);
+            break;
+        case 4:
+            MlasHalfGemmKernelAvx2Rows<4>(A, B, C, CountK, CountN, lda, ldc, alpha, ZeroMode);
+            break;
+        case 3:
+            MlasHalfGemmKernelAvx2Rows<3>(A, B, C, CountK, CountN, lda, ldc, alpha, ZeroMode);
+            break;
+        case 2:
+            MlasHalfGemmKernelAvx2Rows<2>(A, B, C, CountK, CountN, lda, ldc, alpha, ZeroMode);
+            break;
+        default:
+            MlasHalfGemmKernelAvx2Rows<1>(A, B, C, CountK, CountN, lda, ldc, alpha, ZeroMode);
+            break;
+    }
+
+    return CountM;
+}
@@ -0,0 +1,222 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm_kernel_avx2.cpp
+
+Abstract:
+
+    This module implements the kernels for the layer normalization operations
+    using AVX2 and FMA3 instructions.
+
+--*/
+
+#include "mlasi.h"
+
+MLAS_FORCEINLINE
+float
+MlasReduceAddFloat32x8(
+    __m256 Vector
+    )
+{
+    __m128 Sum128 = _mm_add_ps(_mm256_castps256_ps128(Vector), _mm256_extractf128_ps(Vector, 1));
+
+    return MlasReduceAddFloat32x4(Sum128);
+}
+
+template<bool HasSkip, bool HasSkipBias>
+MLAS_FORCEINLINE
+__m256
+MlasLoadLayerNormInputFma3(
+    const float* Input,
+    const float* Skip,
+    const float* SkipBias,
+    float* Output,
+    size_t Offset
+    )
+{
+    __m256 Vector = _mm256_loadu_ps(Input + Offset);
+
+    if (HasSkip) {
+
+        Vector = _mm256_add_ps(Vector, _mm256_loadu_ps(Skip + Offset));
+
+        if (HasSkipBias) {
+            Vector = _mm256_add_ps(Vector, _mm256_loadu_ps(SkipBias + Offset));
+        }
+
+        _mm256_storeu_ps(Output + Offset, Vector);
+    }
+
+    return Vector;
+}
+
+template<bool HasSkip, bool HasSkipBias>
+MLAS_FORCEINLINE
+void
+MlasComputeSumSquareFma3(
+    const float* Input,
+    const float* Skip,
+    const float* SkipBias,
+    float* Output,
+    size_t N,
+    float Shift,
+    float* Sums
+    )
+{
+    const __m256 ShiftVector = _mm256_set1_ps(Shift);
+
+    __m256 SumVector0 = _mm256_setzero_ps();
+    __m256 SumVector1 = _mm256_setzero_ps();
+    __m256 SumSquareVector0 = _mm256_setzero_ps();
+    __m256 SumSquareVector1 = _mm256_setzero_ps();
+
+    size_t Offset = 0;
+
+    while (Offset + 16 <= N) {
+
+        __m256 Vector0 = MlasLoadLayerNormInputFma3<HasSkip, HasSkipBias>(Input, Skip, SkipBias,
+            Output, Offset);
+        __m256 Vector1 = MlasLoadLayerNormInputFma3<HasSkip, HasSkipBias>(Input, Skip, SkipBias,
+            Output, Offset + 8);
+
+        Vector0 = _mm256_sub_ps(Vector0, ShiftVector);
+        Vector1 = _mm256_sub_ps(Vector1, ShiftVector);
+
+        SumVector0 = _mm256_add_ps(SumVector0, Vector0);
+        SumVector1 = _mm256_add_ps(SumVector1, Vector1);
+        SumSquareVector0 = _mm256_fmadd_ps(Vector0, Vector0, SumSquareVector0);
+        SumSquareVector1 = _mm256_fmadd_ps(Vector1, Vector1, SumSquareVector1);
+
+        Offset += 16;
+    }
+
+    if (Offset + 8 <= N) {
+
+        __m256 Vector0 = MlasLoadLayerNormInputFma3<HasSkip, HasSkipBias>(Input, Skip, SkipBias,
+            Output, Offset);
+
+        Vector0 = _mm256_sub_ps(Vector0, ShiftVector);
+
+        SumVector0 = _mm256_add_ps(SumVector0, Vector0);
+        SumSquareVector0 = _mm256_fmadd_ps(Vector0, Vector0, SumSquareVector0);
+
+        Offset += 8;
+    }
+
+    float Sum = MlasReduceAddFloat32x8(_mm256_add_ps(SumVector0, SumVector1));
+    float SumSquare = MlasReduceAddFloat32x8(_mm256_add_ps(SumSquareVector0, SumSquareVector1));
+
+    for (; Offset < N; Offset++) {
+
+        float Value = Input[Offset];
+
+        if (HasSkip) {
+
+            Value += Skip[Offset];
+
+            if (HasSkipBias) {
+                Value += SkipBias[Offset];
+            }
+
+            Output[Offset] = Value;
+        }
+
+        Value -= Shift;
+
+        Sum += Value;
+        SumSquare += Value * Value;
+    }
+
+    Sums[0] = Sum;
+    Sums[1] = SumSquare;
+}
+
+void
+MLASCALL
+MlasComputeSumSquareF32KernelFma3(
+    const float* Input,
+    const float* Skip,
+    const float* SkipBias,
+    float* Output,
+    size_t N,
+    float Shift,
+    float* Sums
+    )
+{
+    if (Skip == nullptr) {
+        MlasComputeSumSquareFma3<false, false>(Input, nullptr, nullptr, nullptr, N, Shift, Sums);
+    } else if (SkipBias == nullptr) {
+        MlasComputeSumSquareFma3<true, false>(Input, Skip, nullptr, Output, N, Shift, Sums);
+    } else {
+        MlasComputeSumSquareFma3<true, true>(Input, Skip, SkipBias, Output, N, Shift, Sums);
+    }
+}
+
+template<bool HasBias>
+MLAS_FORCEINLINE
+void
+MlasComputeLayerNormOutputFma3(
+    const float* Input,
+    const float* Scale,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    const float* Parameters
+    )
+{
+    const float Mean = Parameters[0];
+    const float InvStdDev = Parameters[1];
+
+    const __m256 MeanVector = _mm256_set1_ps(Mean);
+    const __m256 InvStdDevVector = _mm256_set1_ps(InvStdDev);
+
+    size_t Offset = 0;
+
+    for (; Offset + 8 <= N; Offset += 8) {
+
+        __m256 Vector = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(Input + Offset), MeanVector),
+            InvStdDevVector);
+
+        if (HasBias) {
+            Vector = _mm256_fmadd_ps(Vector, _mm256_loadu_ps(Scale + Offset), _mm256_loadu_ps(Bias + Offset));
+        } else {
+            Vector = _mm256_mul_ps(Vector, _mm256_loadu_ps(Scale + Offset));
+        }
+
+        _mm256_storeu_ps(Output + Offset, Vector);
+    }
+
+    for (; Offset < N; Offset++) {
+
+        float Value = (Input[Offset] - Mean) * InvStdDev * Scale[Offset];
+
+        if (HasBias) {
+            Value += Bias[Offset];
+        }
+
+        Output[Offset] = Value;
+    }
+}
+
+void
+MLASCALL
+MlasComputeLayerNormOutputF32KernelFma3(
+    const float* Input,
+    const float* Scale,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    const float* Parameters
+    )
+{
+    if (Bias == nullptr) {
+        MlasComputeLayerNormOutputFma3<false>(Input, Scale, nullptr, Output, N, Parameters);
+    } else {
+        MlasComputeLayerNormOutputFma3<true>(Input, Scale, Bias, Output, N, Parameters);
+    }
+}
@@ -0,0 +1,211 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    q4gemm_kernel_avx2.cpp
+
+Abstract:
+
+    This module implements the kernel for the single precision matrix/matrix
+    multiply operation with a 4-bit block quantized matrix B using AVX2 and
+    FMA3 instructions.
+
+    Each row of a 16 column block of the packed matrix B is loaded as 8 bytes
+    of 4-bit values and dequantized in registers with the scales and zero
+    points of the block.
+
+--*/
+
+#include "mlasi.h"
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasQ4GemmKernelAvx2Rows(
+    const float* A,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockSize,
+    size_t lda,
+    size_t ldc,
+    const float* Bias
+    )
+{
+    const size_t BlockStride = MlasQ4GemmPackedBlockStride(BlockSize);
+    const size_t BlockCountK = (CountK + BlockSize - 1) / BlockSize;
+    const __m128i LowMask = _mm_set1_epi8(0x0F);
+
+    while (CountN > 0) {
+
+        __m256 Accumulators0[RowCount];
+        __m256 Accumulators1[RowCount];
+
+        for (size_t r = 0; r < RowCount; r++) {
+            Accumulators0[r] = _mm256_setzero_ps();
+            Accumulators1[r] = _mm256_setzero_ps();
+        }
+
+        const uint8_t* b = PackedB;
+
+        for (size_t k = 0; k < CountK; k += BlockSize) {
+
+            const float* Params = reinterpret_cast<const float*>(b);
+            const __m256 Scale0 = _mm256_loadu_ps(&Params[0]);
+            const __m256 Scale1 = _mm256_loadu_ps(&Params[8]);
+            const __m256 ZeroBias0 = _mm256_loadu_ps(&Params[16]);
+            const __m256 ZeroBias1 = _mm256_loadu_ps(&Params[24]);
+
+            const uint8_t* QuantB = b + 2 * 16 * sizeof(float);
+            const float* a = A + k;
+
+            const size_t CountBlockK = std::min(CountK - k, BlockSize);
+
+            for (size_t kk = 0; kk < CountBlockK; kk++) {
+
+                __m128i Bytes = _mm_loadl_epi64((const __m128i*)QuantB);
+                __m128i Low = _mm_and_si128(Bytes, LowMask);
+                __m128i High = _mm_and_si128(_mm_srli_epi16(Bytes, 4), LowMask);
+
+                __m256 ElementsB0 = _mm256_fmadd_ps(
+                    _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(Low)), Scale0, ZeroBias0);
+                __m256 ElementsB1 = _mm256_fmadd_ps(
+                    _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(High)), Scale1, ZeroBias1);
+
+                for (size_t r = 0; r < RowCount; r++) {
+                    __m256 ElementA = _mm256_broadcast_ss(&a[r * lda]);
+                    Accumulators0[r] = _mm256_fmadd_ps(ElementA, ElementsB0, Accumulators0[r]);
+                    Accumulators1[r] = _mm256_fmadd_ps(ElementA, ElementsB1, Accumulators1[r]);
+                }
+
+                a += 1;
+                QuantB += 8;
+            }
+
+            b += BlockStride;
+        }
+
+        if (CountN >= 16) {
+
+            if (Bias != nullptr) {
+                const __m256 Bias0 = _mm256_loadu_ps(&Bias[0]);
+                const __m256 Bias1 = _mm256_loadu_ps(&Bias[8]);
+
+                for (size_t r = 0; r < RowCount; r++) {
+                    Accumulators0[r] = _mm256_add_ps(Accumulators0[r], Bias0);
+                    Accumulators1[r] = _mm256_add_ps(Accumulators1[r], Bias1);
+                }
+            }
+
+            for (size_t r = 0; r < RowCount; r++) {
+                _mm256_storeu_ps(&C[r * ldc + 0], Accumulators0[r]);
+                _mm256_storeu_ps(&C[r * ldc + 8], Accumulators1[r]);
+            }
+
+        } else {
+
+            for (size_t r = 0; r < RowCount; r++) {
+
+                float Output[16];
+
+                _mm256_storeu_ps(&Output[0], Accumulators0[r]);
+                _mm256_storeu_ps(&Output[8], Accumulators1[r]);
+
+                float* c = C + r * ldc;
+
+                for (size_t n = 0; n < CountN; n++) {
+                    c[n] = (Bias != nullptr) ? Output[n] + Bias[n] : Output[n];
+                }
+            }
+        }
+
+        PackedB += BlockCountK * BlockStride;
+        C += 16;
+
+        if (Bias != nullptr) {
+            Bias += 16;
+        }
+
+        CountN -= std::min(CountN, size_t(16));
+    }
+}
+
+size_t
+MLASCALL
+MlasQ4GemmKernelAvx2(
+    const float* A,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockSize,
+    size_t lda,
+    size_t ldc,
+    const float* Bias
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute matrix multiplication for a
+    set of rows.
+
+Arguments:
+
+    A - Supplies the address of matrix A.
+
+    PackedB - Supplies the address of matrix B. The matrix data has been
+        packed using MlasQ4GemmPackB.
+
+    C - Supplies the address of matrix C.
+
+    CountM - Supplies the maximum number of rows that can be processed for
+        matrix A and matrix C. The actual number of rows handled for this
+        invocation depends on the kernel implementation.
+
+    CountN - Supplies the number of columns from matrix B and matrix C to
+        iterate over.
+
+    CountK - Supplies the number of columns from matrix A and the number of
+        rows from matrix B to iterate over.
+
+    BlockSize - Supplies the number of rows of matrix B sharing a scale and
+        zero point.
+
+    lda - Supplies the first dimension of matrix A.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    Bias - Supplies the optional bias vector for the columns of matrix C.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    if (CountM >= 4) {
+        MlasQ4GemmKernelAvx2Rows<4>(A, PackedB, C, CountN, CountK, BlockSize, lda, ldc, Bias);
+        return 4;
+    }
+
+    switch (CountM) {
+        case 3:
+            MlasQ4GemmKernelAvx2Rows<3>(A, PackedB, C, CountN, CountK, BlockSize, lda, ldc, Bias);
+            break;
+        case 2:
+            MlasQ4GemmKernelAvx2Rows<2>(A, PackedB, C, CountN, CountK, BlockSize, lda, ldc, Bias);
+            break;
+        default:
+            MlasQ4GemmKernelAvx2Rows<1>(A, PackedB, C, CountN, CountK, BlockSize, lda, ldc, Bias);
+            break;
+    }
+
+    return CountM;
+}
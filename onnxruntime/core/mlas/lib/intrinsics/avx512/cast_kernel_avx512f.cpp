@@ -0,0 +1,111 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    cast_kernel_avx512f.cpp
+
+Abstract:
+
+    This module implements the kernels to convert buffers between single and
+    half precision floating point values using AVX512F instructions.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasCastF16ToF32KernelAvx512F(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 32) {
+
+        __m512 Elements0 = _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)&Source[0]));
+        __m512 Elements1 = _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)&Source[16]));
+
+        _mm512_storeu_ps(&Destination[0], Elements0);
+        _mm512_storeu_ps(&Destination[16], Elements1);
+
+        Source += 32;
+        Destination += 32;
+        Count -= 32;
+    }
+
+    while (Count >= 16) {
+
+        _mm512_storeu_ps(Destination, _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)Source)));
+
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    if (Count > 0) {
+
+        //
+        // Convert the remaining values through a local buffer, as the masked
+        // loads and stores of 16-bit elements require AVX512BW.
+        //
+
+        MLAS_DECLSPEC_ALIGN(uint16_t Buffer[16], 32) = {};
+        std::copy_n(Source, Count, Buffer);
+
+        __mmask16 StoreMask = __mmask16((1u << Count) - 1);
+        _mm512_mask_storeu_ps(Destination, StoreMask, _mm512_cvtph_ps(_mm256_load_si256((const __m256i*)Buffer)));
+    }
+}
+
+void
+MLASCALL
+MlasCastF32ToF16KernelAvx512F(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 32) {
+
+        __m256i Elements0 = _mm512_cvtps_ph(_mm512_loadu_ps(&Source[0]), _MM_FROUND_TO_NEAREST_INT);
+        __m256i Elements1 = _mm512_cvtps_ph(_mm512_loadu_ps(&Source[16]), _MM_FROUND_TO_NEAREST_INT);
+
+        _mm256_storeu_si256((__m256i*)&Destination[0], Elements0);
+        _mm256_storeu_si256((__m256i*)&Destination[16], Elements1);
+
+        Source += 32;
+        Destination += 32;
+        Count -= 32;
+    }
+
+    while (Count >= 16) {
+
+        _mm256_storeu_si256((__m256i*)Destination,
+            _mm512_cvtps_ph(_mm512_loadu_ps(Source), _MM_FROUND_TO_NEAREST_INT));
+
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    if (Count > 0) {
+
+        //
+        // Convert the remaining values through a local buffer, as the masked
+        // stores of 16-bit elements require AVX512BW.
+        //
+
+        MLAS_DECLSPEC_ALIGN(uint16_t Buffer[16], 32);
+
+        __mmask16 LoadMask = __mmask16((1u << Count) - 1);
+        __m512 Elements = _mm512_maskz_loadu_ps(LoadMask, Source);
+        _mm256_store_si256((__m256i*)Buffer, _mm512_cvtps_ph(Elements, _MM_FROUND_TO_NEAREST_INT));
+
+        std::copy_n(Buffer, Count, Destination);
+    }
+}
@@ -0,0 +1,168 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm_kernel_avx512f.cpp
+
+Abstract:
+
+    This module implements the kernel for the single precision matrix/matrix
+    multiply operation with a half precision matrix B using AVX512F
+    instructions.
+
+    Each row of a 16 column block of the packed matrix B is loaded as half
+    precision and converted to single precision in registers, so matrix B is
+    never expanded to single precision in memory.
+
+--*/
+
+#include "mlasi.h"
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernelAvx512FRows(
+    const float* A,
+    const uint16_t* B,
+    float* C,
+    size_t CountK,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    float alpha,
+    bool ZeroMode
+    )
+{
+    const __m512 AlphaBroadcast = _mm512_set1_ps(alpha);
+
+    while (CountN > 0) {
+
+        __m512 Accumulators[RowCount];
+
+        for (size_t r = 0; r < RowCount; r++) {
+            Accumulators[r] = _mm512_setzero_ps();
+        }
+
+        const float* a = A;
+
+        for (size_t k = 0; k < CountK; k++) {
+
+            __m512 ElementsB = _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)B));
+
+            for (size_t r = 0; r < RowCount; r++) {
+                Accumulators[r] = _mm512_fmadd_ps(_mm512_set1_ps(a[r * lda]), ElementsB, Accumulators[r]);
+            }
+
+            a += 1;
+            B += 16;
+        }
+
+        const __mmask16 StoreMask = (CountN >= 16) ? __mmask16(0xFFFF) :
+            __mmask16((uint32_t(1) << CountN) - uint32_t(1));
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            float* c = C + r * ldc;
+
+            Accumulators[r] = _mm512_mul_ps(Accumulators[r], AlphaBroadcast);
+
+            if (!ZeroMode) {
+                Accumulators[r] = _mm512_add_ps(Accumulators[r], _mm512_maskz_loadu_ps(StoreMask, c));
+            }
+
+            _mm512_mask_storeu_ps(c, StoreMask, Accumulators[r]);
+        }
+
+        C += 16;
+        CountN -= std::min(CountN, size_t(16));
+    }
+}
+
+size_t
+MLASCALL
+MlasHalfGemmKernelAvx512F(
+    const float* A,
+    const uint16_t* B,
+    float* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    float alpha,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute matrix multiplication for a
+    set of rows.
+
+Arguments:
+
+    A - Supplies the address of matrix A.
+
+    B - Supplies the address of matrix B. The matrix data has been packed
+        using MlasHalfGemmCopyPackB or MlasHalfGemmTransposePackB.
+
+    C - Supplies the address of matrix C.
+
+    CountK - Supplies the number of columns from matrix A and the number of
+        rows from matrix B to iterate over.
+
+    CountM - Supplies the maximum number of rows that can be processed for
+        matrix A and matrix C. The actual number of rows handled for this
+        invocation depends on the kernel implementation.
+
+    CountN - Supplies the number of columns from matrix B and matrix C to
+        iterate over.
+
+    lda - Supplies the first dimension of matrix A.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    alpha - Supplies the scalar multiplier (see SGEMM definition).
+
+    ZeroMode - Supplies true if the output matrix must be zero initialized,
+        else false if the output matrix is accumulated into.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    if (CountM >= 12) {
+        MlasHalfGemmKernelAvx512FRows<12>(A, B, C, CountK, CountN, lda, ldc, alpha, ZeroMode);
+        return 12;
+    }
+
+    if (CountM >= 8) {
+        MlasHalfGemmKernelAvx512FRows<8>(A, B, C, CountK, CountN, lda, ldc, alpha, ZeroMode);
+        return 8;
+    }
+
+    if (CountM >= 4) {
+        MlasHalfGemmKernelAvx512FRows<4>(A, B, C, CountK, CountN, lda, ldc, alpha, ZeroMode);
+        return 4;
+    }
+
+    switch (CountM) {
+        case 3:
+            MlasHalfGemmKernelAvx512FRows<3>(A, B, C, CountK, CountN, lda, ldc, alpha, ZeroMode);
+            break;
+        case 2:
+            MlasHalfGemmKernelAvx512FRows<2>(A, B, C, CountK, CountN, lda, ldc, alpha, ZeroMode);
+            break;
+        default:
+            MlasHalfGemmKernelAvx512FRows<1>(A, B, C, CountK, CountN, lda, ldc, alpha, ZeroMode);
+            break;
+    }
+
+    return CountM;
+}
@@ -0,0 +1,198 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm_kernel_avx512f.cpp
+
+Abstract:
+
+    This module implements the kernels for the layer normalization operations
+    using AVX512F instructions.
+
+--*/
+
+#include "mlasi.h"
+
+MLAS_FORCEINLINE
+float
+MlasReduceAddFloat32x16(
+    __m512 Vector
+    )
+{
+    __m256 Low = _mm512_castps512_ps256(Vector);
+    __m256 High = _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(Vector), 1));
+    __m256 Sum256 = _mm256_add_ps(Low, High);
+    __m128 Sum128 = _mm_add_ps(_mm256_castps256_ps128(Sum256), _mm256_extractf128_ps(Sum256, 1));
+
+    return MlasReduceAddFloat32x4(Sum128);
+}
+
+template<bool HasSkip, bool HasSkipBias>
+MLAS_FORCEINLINE
+__m512
+MlasLoadLayerNormInputAvx512F(
+    const float* Input,
+    const float* Skip,
+    const float* SkipBias,
+    float* Output,
+    size_t Offset,
+    __mmask16 Mask
+    )
+{
+    __m512 Vector = _mm512_maskz_loadu_ps(Mask, Input + Offset);
+
+    if (HasSkip) {
+
+        Vector = _mm512_add_ps(Vector, _mm512_maskz_loadu_ps(Mask, Skip + Offset));
+
+        if (HasSkipBias) {
+            Vector = _mm512_add_ps(Vector, _mm512_maskz_loadu_ps(Mask, SkipBias + Offset));
+        }
+
+        _mm512_mask_storeu_ps(Output + Offset, Mask, Vector);
+    }
+
+    return Vector;
+}
+
+template<bool HasSkip, bool HasSkipBias>
+MLAS_FORCEINLINE
+void
+MlasComputeSumSquareAvx512F(
+    const float* Input,
+    const float* Skip,
+    const float* SkipBias,
+    float* Output,
+    size_t N,
+    float Shift,
+    float* Sums
+    )
+{
+    const __m512 ShiftVector = _mm512_set1_ps(Shift);
+
+    __m512 SumVector0 = _mm512_setzero_ps();
+    __m512 SumVector1 = _mm512_setzero_ps();
+    __m512 SumSquareVector0 = _mm512_setzero_ps();
+    __m512 SumSquareVector1 = _mm512_setzero_ps();
+
+    size_t Offset = 0;
+
+    while (Offset + 32 <= N) {
+
+        __m512 Vector0 = MlasLoadLayerNormInputAvx512F<HasSkip, HasSkipBias>(Input, Skip, SkipBias,
+            Output, Offset, __mmask16(0xFFFF));
+        __m512 Vector1 = MlasLoadLayerNormInputAvx512F<HasSkip, HasSkipBias>(Input, Skip, SkipBias,
+            Output, Offset + 16, __mmask16(0xFFFF));
+
+        Vector0 = _mm512_sub_ps(Vector0, ShiftVector);
+        Vector1 = _mm512_sub_ps(Vector1, ShiftVector);
+
+        SumVector0 = _mm512_add_ps(SumVector0, Vector0);
+        SumVector1 = _mm512_add_ps(SumVector1, Vector1);
+        SumSquareVector0 = _mm512_fmadd_ps(Vector0, Vector0, SumSquareVector0);
+        SumSquareVector1 = _mm512_fmadd_ps(Vector1, Vector1, SumSquareVector1);
+
+        Offset += 32;
+    }
+
+    while (Offset < N) {
+
+        //
+        // Process the remaining elements with masked operations, which leave
+        // the inactive lanes zero so that the accumulators are not disturbed.
+        //
+
+        const size_t Remaining = N - Offset;
+        __mmask16 Mask = (Remaining >= 16) ? __mmask16(0xFFFF) : __mmask16((1u << Remaining) - 1);
+
+        __m512 Vector0 = MlasLoadLayerNormInputAvx512F<HasSkip, HasSkipBias>(Input, Skip, SkipBias,
+            Output, Offset, Mask);
+
+        Vector0 = _mm512_maskz_sub_ps(Mask, Vector0, ShiftVector);
+
+        SumVector0 = _mm512_add_ps(SumVector0, Vector0);
+        SumSquareVector0 = _mm512_fmadd_ps(Vector0, Vector0, SumSquareVector0);
+
+        Offset += 16;
+    }
+
+    Sums[0] = MlasReduceAddFloat32x16(_mm512_add_ps(SumVector0, SumVector1));
+    Sums[1] = MlasReduceAddFloat32x16(_mm512_add_ps(SumSquareVector0, SumSquareVector1));
+}
+
+void
+MLASCALL
+MlasComputeSumSquareF32KernelAvx512F(
+    const float* Input,
+    const float* Skip,
+    const float* SkipBias,
+    float* Output,
+    size_t N,
+    float Shift,
+    float* Sums
+    )
+{
+    if (Skip == nullptr) {
+        MlasComputeSumSquareAvx512F<false, false>(Input, nullptr, nullptr, nullptr, N, Shift, Sums);
+    } else if (SkipBias == nullptr) {
+        MlasComputeSumSquareAvx512F<true, false>(Input, Skip, nullptr, Output, N, Shift, Sums);
+    } else {
+        MlasComputeSumSquareAvx512F<true, true>(Input, Skip, SkipBias, Output, N, Shift, Sums);
+    }
+}
+
+template<bool HasBias>
+MLAS_FORCEINLINE
+void
+MlasComputeLayerNormOutputAvx512F(
+    const float* Input,
+    const float* Scale,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    const float* Parameters
+    )
+{
+    const __m512 MeanVector = _mm512_set1_ps(Parameters[0]);
+    const __m512 InvStdDevVector = _mm512_set1_ps(Parameters[1]);
+
+    for (size_t Offset = 0; Offset < N; Offset += 16) {
+
+        const size_t Remaining = N - Offset;
+        __mmask16 Mask = (Remaining >= 16) ? __mmask16(0xFFFF) : __mmask16((1u << Remaining) - 1);
+
+        __m512 Vector = _mm512_mul_ps(_mm512_sub_ps(_mm512_maskz_loadu_ps(Mask, Input + Offset), MeanVector),
+            InvStdDevVector);
+
+        if (HasBias) {
+            Vector = _mm512_fmadd_ps(Vector, _mm512_maskz_loadu_ps(Mask, Scale + Offset),
+                _mm512_maskz_loadu_ps(Mask, Bias + Offset));
+        } else {
+            Vector = _mm512_mul_ps(Vector, _mm512_maskz_loadu_ps(Mask, Scale + Offset));
+        }
+
+        _mm512_mask_storeu_ps(Output + Offset, Mask, Vector);
+    }
+}
+
+void
+MLASCALL
+MlasComputeLayerNormOutputF32KernelAvx512F(
+    const float* Input,
+    const float* Scale,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    const float* Parameters
+    )
+{
+    if (Bias == nullptr) {
+        MlasComputeLayerNormOutputAvx512F<false>(Input, Scale, nullptr, Output, N, Parameters);
+    } else {
+        MlasComputeLayerNormOutputAvx512F<true>(Input, Scale, Bias, Output, N, Parameters);
+    }
+}
@@ -0,0 +1,195 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    q4gemm_kernel_avx512f.cpp
+
+Abstract:
+
+    This module implements the kernel for the single precision matrix/matrix
+    multiply operation with a 4-bit block quantized matrix B using AVX512F
+    instructions.
+
+    Each row of a 16 column block of the packed matrix B is loaded as 8 bytes
+    of 4-bit values and dequantized in registers with the scales and zero
+    points of the block.
+
+--*/
+
+#include "mlasi.h"
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasQ4GemmKernelAvx512FRows(
+    const float* A,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockSize,
+    size_t lda,
+    size_t ldc,
+    const float* Bias
+    )
+{
+    const size_t BlockStride = MlasQ4GemmPackedBlockStride(BlockSize);
+    const size_t BlockCountK = (CountK + BlockSize - 1) / BlockSize;
+    const __m128i LowMask = _mm_set1_epi8(0x0F);
+
+    while (CountN > 0) {
+
+        __m512 Accumulators[RowCount];
+
+        for (size_t r = 0; r < RowCount; r++) {
+            Accumulators[r] = _mm512_setzero_ps();
+        }
+
+        const uint8_t* b = PackedB;
+
+        for (size_t k = 0; k < CountK; k += BlockSize) {
+
+            const float* Params = reinterpret_cast<const float*>(b);
+            const __m512 Scale = _mm512_loadu_ps(&Params[0]);
+            const __m512 ZeroBias = _mm512_loadu_ps(&Params[16]);
+
+            const uint8_t* QuantB = b + 2 * 16 * sizeof(float);
+            const float* a = A + k;
+
+            const size_t CountBlockK = std::min(CountK - k, BlockSize);
+
+            for (size_t kk = 0; kk < CountBlockK; kk++) {
+
+                __m128i Bytes = _mm_loadl_epi64((const __m128i*)QuantB);
+                __m128i Low = _mm_and_si128(Bytes, LowMask);
+                __m128i High = _mm_and_si128(_mm_srli_epi16(Bytes, 4), LowMask);
+                __m128i Nibbles = _mm_unpacklo_epi64(Low, High);
+
+                __m512 ElementsB = _mm512_fmadd_ps(
+                    _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(Nibbles)), Scale, ZeroBias);
+
+                for (size_t r = 0; r < RowCount; r++) {
+                    Accumulators[r] = _mm512_fmadd_ps(_mm512_set1_ps(a[r * lda]), ElementsB, Accumulators[r]);
+                }
+
+                a += 1;
+                QuantB += 8;
+            }
+
+            b += BlockStride;
+        }
+
+        const __mmask16 StoreMask = (CountN >= 16) ? __mmask16(0xFFFF) :
+            __mmask16((uint32_t(1) << CountN) - uint32_t(1));
+
+        if (Bias != nullptr) {
+            const __m512 BiasBroadcast = _mm512_maskz_loadu_ps(StoreMask, Bias);
+
+            for (size_t r = 0; r < RowCount; r++) {
+                Accumulators[r] = _mm512_add_ps(Accumulators[r], BiasBroadcast);
+            }
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            _mm512_mask_storeu_ps(C + r * ldc, StoreMask, Accumulators[r]);
+        }
+
+        PackedB += BlockCountK * BlockStride;
+        C += 16;
+
+        if (Bias != nullptr) {
+            Bias += 16;
+        }
+
+        CountN -= std::min(CountN, size_t(16));
+    }
+}
+
+size_t
+MLASCALL
+MlasQ4GemmKernelAvx512F(
+    const float* A,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockSize,
+    size_t lda,
+    size_t ldc,
+    const float* Bias
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute matrix multiplication for a
+    set of rows.
+
+Arguments:
+
+    A - Supplies the address of matrix A.
+
+    PackedB - Supplies the address of matrix B. The matrix data has been
+        packed using MlasQ4GemmPackB.
+
+    C - Supplies the address of matrix C.
+
+    CountM - Supplies the maximum number of rows that can be processed for
+        matrix A and matrix C. The actual number of rows handled for this
+        invocation depends on the kernel implementation.
+
+    CountN - Supplies the number of columns from matrix B and matrix C to
+        iterate over.
+
+    CountK - Supplies the number of columns from matrix A and the number of
+        rows from matrix B to iterate over.
+
+    BlockSize - Supplies the number of rows of matrix B sharing a scale and
+        zero point.
+
+    lda - Supplies the first dimension of matrix A.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    Bias - Supplies the optional bias vector for the columns of matrix C.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    if (CountM >= 12) {
+        MlasQ4GemmKernelAvx512FRows<12>(A, PackedB, C, CountN, CountK, BlockSize, lda, ldc, Bias);
+        return 12;
+    }
+
+    if (CountM >= 8) {
+        MlasQ4GemmKernelAvx512FRows<8>(A, PackedB, C, CountN, CountK, BlockSize, lda, ldc, Bias);
+        return 8;
+    }
+
+    if (CountM >= 4) {
+        MlasQ4GemmKernelAvx512FRows<4>(A, PackedB, C, CountN, CountK, BlockSize, lda, ldc, Bias);
+        return 4;
+    }
+
+    switch (CountM) {
+        case 3:
+            MlasQ4GemmKernelAvx512FRows<3>(A, PackedB, C, CountN, CountK, BlockSize, lda, ldc, Bias);
+            break;
+        case 2:
+            MlasQ4GemmKernelAvx512FRows<2>(A, PackedB, C, CountN, CountK, BlockSize, lda, ldc, Bias);
+            break;
+        default:
+            MlasQ4GemmKernelAvx512FRows<1>(A, PackedB, C, CountN, CountK, BlockSize, lda, ldc, Bias);
+            break;
+    }
+
+    return CountM;
+}
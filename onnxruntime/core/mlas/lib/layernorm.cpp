@@ -0,0 +1,670 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm.cpp
+
+Abstract:
+
+    This module implements routines to compute the layer normalization, the
+    simplified (root mean square) layer normalization and the skip layer
+    normalization operations.
+
+    Each row is reduced in a single pass that accumulates both the sum and the
+    sum of squares of the elements, and then a second pass produces the
+    normalized output. The elements are shifted by the first element of the
+    row before they are accumulated, which bounds the cancellation error of
+    the variance when the mean of the row is large relative to its standard
+    deviation.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the parameters to execute segments of a layer normalization
+// operation on worker threads.
+//
+
+struct MLAS_LAYERNORM_WORK_BLOCK {
+    ptrdiff_t ThreadCountN;
+    const float* Input;
+    const float* Skip;
+    const float* SkipBias;
+    const float* Scale;
+    const float* Bias;
+    float* Output;
+    float* Mean;
+    float* InvStdDev;
+    size_t N;
+    size_t D;
+    float Epsilon;
+    bool Simplified;
+};
+
+template<bool HasSkip, bool HasSkipBias>
+MLAS_FORCEINLINE
+void
+MlasComputeSumSquareF32KernelImpl(
+    const float* Input,
+    const float* Skip,
+    const float* SkipBias,
+    float* Output,
+    size_t N,
+    float Shift,
+    float* Sums
+    )
+{
+    const MLAS_FLOAT32X4 ShiftVector = MlasBroadcastFloat32x4(Shift);
+
+    MLAS_FLOAT32X4 SumVector0 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 SumVector1 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 SumSquareVector0 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 SumSquareVector1 = MlasZeroFloat32x4();
+
+    while (N >= 8) {
+
+        MLAS_FLOAT32X4 Vector0 = MlasLoadFloat32x4(Input);
+        MLAS_FLOAT32X4 Vector1 = MlasLoadFloat32x4(Input + 4);
+
+        if (HasSkip) {
+
+            Vector0 = MlasAddFloat32x4(Vector0, MlasLoadFloat32x4(Skip));
+            Vector1 = MlasAddFloat32x4(Vector1, MlasLoadFloat32x4(Skip + 4));
+
+            if (HasSkipBias) {
+                Vector0 = MlasAddFloat32x4(Vector0, MlasLoadFloat32x4(SkipBias));
+                Vector1 = MlasAddFloat32x4(Vector1, MlasLoadFloat32x4(SkipBias + 4));
+                SkipBias += 8;
+            }
+
+            MlasStoreFloat32x4(Output, Vector0);
+            MlasStoreFloat32x4(Output + 4, Vector1);
+
+            Skip += 8;
+            Output += 8;
+        }
+
+        Vector0 = MlasSubtractFloat32x4(Vector0, ShiftVector);
+        Vector1 = MlasSubtractFloat32x4(Vector1, ShiftVector);
+
+        SumVector0 = MlasAddFloat32x4(SumVector0, Vector0);
+        SumVector1 = MlasAddFloat32x4(SumVector1, Vector1);
+        SumSquareVector0 = MlasMultiplyAddFloat32x4(Vector0, Vector0, SumSquareVector0);
+        SumSquareVector1 = MlasMultiplyAddFloat32x4(Vector1, Vector1, SumSquareVector1);
+
+        Input += 8;
+        N -= 8;
+    }
+
+    if (N >= 4) {
+
+        MLAS_FLOAT32X4 Vector0 = MlasLoadFloat32x4(Input);
+
+        if (HasSkip) {
+
+            Vector0 = MlasAddFloat32x4(Vector0, MlasLoadFloat32x4(Skip));
+
+            if (HasSkipBias) {
+                Vector0 = MlasAddFloat32x4(Vector0, MlasLoadFloat32x4(SkipBias));
+                SkipBias += 4;
+            }
+
+            MlasStoreFloat32x4(Output, Vector0);
+
+            Skip += 4;
+            Output += 4;
+        }
+
+        Vector0 = MlasSubtractFloat32x4(Vector0, ShiftVector);
+
+        SumVector0 = MlasAddFloat32x4(SumVector0, Vector0);
+        SumSquareVector0 = MlasMultiplyAddFloat32x4(Vector0, Vector0, SumSquareVector0);
+
+        Input += 4;
+        N -= 4;
+    }
+
+    float Sum = MlasReduceAddFloat32x4(MlasAddFloat32x4(SumVector0, SumVector1));
+    float SumSquare = MlasReduceAddFloat32x4(MlasAddFloat32x4(SumSquareVector0, SumSquareVector1));
+
+    while (N > 0) {
+
+        float Value = *Input++;
+
+        if (HasSkip) {
+
+            Value += *Skip++;
+
+            if (HasSkipBias) {
+                Value += *SkipBias++;
+            }
+
+            *Output++ = Value;
+        }
+
+        Value -= Shift;
+
+        Sum += Value;
+        SumSquare += Value * Value;
+
+        N -= 1;
+    }
+
+    Sums[0] = Sum;
+    Sums[1] = SumSquare;
+}
+
+void
+MLASCALL
+MlasComputeSumSquareF32Kernel(
+    const float* Input,
+    const float* Skip,
+    const float* SkipBias,
+    float* Output,
+    size_t N,
+    float Shift,
+    float* Sums
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to compute the sum and the sum
+    of squares of a row of elements, after subtracting a shift value from each
+    element.
+
+    If a skip buffer is supplied, the reduced elements are the sum of the
+    input, the skip and the optional skip bias buffers, and these elements
+    are also written to the output buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Skip - Optionally supplies the skip buffer.
+
+    SkipBias - Optionally supplies the bias buffer to add to the skip buffer.
+        Ignored if Skip is nullptr.
+
+    Output - Supplies the output buffer. Ignored if Skip is nullptr.
+
+    N - Supplies the number of elements to process.
+
+    Shift - Supplies the value to subtract from each element before it is
+        accumulated.
+
+    Sums - Receives the sum and the sum of squares of the shifted elements.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (Skip == nullptr) {
+        MlasComputeSumSquareF32KernelImpl<false, false>(Input, nullptr, nullptr, nullptr, N, Shift, Sums);
+    } else if (SkipBias == nullptr) {
+        MlasComputeSumSquareF32KernelImpl<true, false>(Input, Skip, nullptr, Output, N, Shift, Sums);
+    } else {
+        MlasComputeSumSquareF32KernelImpl<true, true>(Input, Skip, SkipBias, Output, N, Shift, Sums);
+    }
+}
+
+template<bool HasBias>
+MLAS_FORCEINLINE
+void
+MlasComputeLayerNormOutputF32KernelImpl(
+    const float* Input,
+    const float* Scale,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    float Mean,
+    float InvStdDev
+    )
+{
+    const MLAS_FLOAT32X4 MeanVector = MlasBroadcastFloat32x4(Mean);
+    const MLAS_FLOAT32X4 InvStdDevVector = MlasBroadcastFloat32x4(InvStdDev);
+
+    while (N >= 8) {
+
+        MLAS_FLOAT32X4 Vector0 = MlasMultiplyFloat32x4(MlasSubtractFloat32x4(MlasLoadFloat32x4(Input),
+            MeanVector), InvStdDevVector);
+        MLAS_FLOAT32X4 Vector1 = MlasMultiplyFloat32x4(MlasSubtractFloat32x4(MlasLoadFloat32x4(Input + 4),
+            MeanVector), InvStdDevVector);
+
+        if (HasBias) {
+            Vector0 = MlasMultiplyAddFloat32x4(Vector0, MlasLoadFloat32x4(Scale), MlasLoadFloat32x4(Bias));
+            Vector1 = MlasMultiplyAddFloat32x4(Vector1, MlasLoadFloat32x4(Scale + 4), MlasLoadFloat32x4(Bias + 4));
+            Bias += 8;
+        } else {
+            Vector0 = MlasMultiplyFloat32x4(Vector0, MlasLoadFloat32x4(Scale));
+            Vector1 = MlasMultiplyFloat32x4(Vector1, MlasLoadFloat32x4(Scale + 4));
+        }
+
+        MlasStoreFloat32x4(Output, Vector0);
+        MlasStoreFloat32x4(Output + 4, Vector1);
+
+        Input += 8;
+        Scale += 8;
+        Output += 8;
+        N -= 8;
+    }
+
+    if (N >= 4) {
+
+        MLAS_FLOAT32X4 Vector0 = MlasMultiplyFloat32x4(MlasSubtractFloat32x4(MlasLoadFloat32x4(Input),
+            MeanVector), InvStdDevVector);
+
+        if (HasBias) {
+            Vector0 = MlasMultiplyAddFloat32x4(Vector0, MlasLoadFloat32x4(Scale), MlasLoadFloat32x4(Bias));
+            Bias += 4;
+        } else {
+            Vector0 = MlasMultiplyFloat32x4(Vector0, MlasLoadFloat32x4(Scale));
+        }
+
+        MlasStoreFloat32x4(Output, Vector0);
+
+        Input += 4;
+        Scale += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        float Value = (*Input++ - Mean) * InvStdDev * *Scale++;
+
+        if (HasBias) {
+            Value += *Bias++;
+        }
+
+        *Output++ = Value;
+
+        N -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasComputeLayerNormOutputF32Kernel(
+    const float* Input,
+    const float* Scale,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    const float* Parameters
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to produce the normalized output
+    for the layer normalization operation.
+
+    N.B. This implementation supports in place updates of the output buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Scale - Supplies the scale buffer.
+
+    Bias - Optionally supplies the bias buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+    Parameters - Supplies an array containing the mean and the inverse of the
+        standard deviation of the row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (Bias == nullptr) {
+        MlasComputeLayerNormOutputF32KernelImpl<false>(Input, Scale, nullptr, Output, N,
+            Parameters[0], Parameters[1]);
+    } else {
+        MlasComputeLayerNormOutputF32KernelImpl<true>(Input, Scale, Bias, Output, N,
+            Parameters[0], Parameters[1]);
+    }
+}
+
+void
+MlasComputeLayerNormThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    layer normalization operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    ThreadId - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_LAYERNORM_WORK_BLOCK*)Context;
+
+    //
+    // Partition the operation along the N dimension.
+    //
+
+    size_t n;
+    size_t CountN;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCountN, WorkBlock->N, &n, &CountN);
+
+    const size_t D = WorkBlock->D;
+    const bool Simplified = WorkBlock->Simplified;
+    const float Epsilon = WorkBlock->Epsilon;
+
+    const float* Input = WorkBlock->Input + n * D;
+    const float* Skip = (WorkBlock->Skip != nullptr) ? WorkBlock->Skip + n * D : nullptr;
+    float* Output = WorkBlock->Output + n * D;
+
+    for (size_t i = n; i < n + CountN; i++) {
+
+        //
+        // Compute the sum and the sum of squares of the row in a single pass.
+        // For the skip layer normalization, this also writes the sum of the
+        // input, skip and bias rows to the output buffer, which becomes the
+        // input to the normalization pass.
+        //
+        // The root mean square of the simplified layer normalization must be
+        // computed from the unshifted elements.
+        //
+
+        float Shift = 0.0f;
+
+        if (!Simplified && D > 0) {
+            Shift = Input[0];
+            if (Skip != nullptr) {
+                Shift += Skip[0];
+                if (WorkBlock->SkipBias != nullptr) {
+                    Shift += WorkBlock->SkipBias[0];
+                }
+            }
+        }
+
+        float Sums[2];
+
+#if defined(MLAS_TARGET_AMD64)
+        MlasPlatform.ComputeSumSquareF32Kernel(Input, Skip, WorkBlock->SkipBias, Output, D, Shift, Sums);
+#else
+        MlasComputeSumSquareF32Kernel(Input, Skip, WorkBlock->SkipBias, Output, D, Shift, Sums);
+#endif
+
+        const float* NormalizeInput = (Skip != nullptr) ? Output : Input;
+
+        float Mean;
+        float Variance;
+
+        if (Simplified) {
+            Mean = 0.0f;
+            Variance = Sums[1] / float(D);
+        } else {
+            const float ShiftedMean = Sums[0] / float(D);
+            Mean = Shift + ShiftedMean;
+            Variance = std::max(Sums[1] / float(D) - ShiftedMean * ShiftedMean, 0.0f);
+        }
+
+        const float InvStdDev = 1.0f / std::sqrt(Variance + Epsilon);
+
+        //
+        // Produce the normalized output.
+        //
+
+        float Parameters[] = { Mean, InvStdDev };
+
+#if defined(MLAS_TARGET_AMD64)
+        MlasPlatform.ComputeLayerNormOutputF32Kernel(NormalizeInput, WorkBlock->Scale, WorkBlock->Bias,
+            Output, D, Parameters);
+#else
+        MlasComputeLayerNormOutputF32Kernel(NormalizeInput, WorkBlock->Scale, WorkBlock->Bias,
+            Output, D, Parameters);
+#endif
+
+        if (WorkBlock->Mean != nullptr) {
+            WorkBlock->Mean[i] = Mean;
+        }
+
+        if (WorkBlock->InvStdDev != nullptr) {
+            WorkBlock->InvStdDev[i] = InvStdDev;
+        }
+
+        Input += D;
+        if (Skip != nullptr) {
+            Skip += D;
+        }
+        Output += D;
+    }
+}
+
+void
+MlasExecuteLayerNorm(
+    MLAS_LAYERNORM_WORK_BLOCK* WorkBlock,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine partitions a layer normalization operation across the thread
+    pool.
+
+Arguments:
+
+    WorkBlock - Supplies the structure containing the operation parameters.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t N = WorkBlock->N;
+    const size_t D = WorkBlock->D;
+
+    //
+    // Compute the number of target threads given the complexity of the
+    // operation. Limit the number of threads to the number of rows and try to
+    // keep each thread processing a minimum number of elements before using
+    // another thread.
+    //
+
+    ptrdiff_t ThreadCountN = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(ThreadCountN) > N) {
+        ThreadCountN = ptrdiff_t(N);
+    }
+
+    constexpr size_t MinimumElementsPerThread = 16384;
+
+    size_t BlockCount = ((N * D) / MinimumElementsPerThread) + 1;
+
+    if (size_t(ThreadCountN) > BlockCount) {
+        ThreadCountN = ptrdiff_t(BlockCount);
+    }
+
+    WorkBlock->ThreadCountN = ThreadCountN;
+
+    MlasExecuteThreaded(MlasComputeLayerNormThreaded, WorkBlock, ThreadCountN, ThreadPool);
+}
+
+void
+MLASCALL
+MlasComputeLayerNorm(
+    const float* Input,
+    const float* Scale,
+    const float* Bias,
+    float* Output,
+    float* Mean,
+    float* InvStdDev,
+    size_t N,
+    size_t D,
+    float Epsilon,
+    bool Simplified,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the layer normalization or the simplified layer
+    normalization of each row of the input buffer.
+
+    The layer normalization computes (x - mean) / sqrt(variance + epsilon) *
+    scale + bias. The simplified layer normalization computes
+    x / sqrt(mean(x * x) + epsilon) * scale.
+
+    N.B. This implementation supports in place updates of the output buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Scale - Supplies the scale buffer of D elements.
+
+    Bias - Optionally supplies the bias buffer of D elements. Must be nullptr
+        for the simplified layer normalization.
+
+    Output - Supplies the output buffer.
+
+    Mean - Optionally receives the mean of each row. Receives zero for the
+        simplified layer normalization.
+
+    InvStdDev - Optionally receives the inverse of the standard deviation (or
+        of the root mean square) of each row.
+
+    N - Supplies the number of rows to process.
+
+    D - Supplies the number of columns per row to process.
+
+    Epsilon - Supplies the value added to the variance to avoid division by
+        zero.
+
+    Simplified - Supplies true if this is a simplified layer normalization,
+        else false.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_LAYERNORM_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Input = Input;
+    WorkBlock.Skip = nullptr;
+    WorkBlock.SkipBias = nullptr;
+    WorkBlock.Scale = Scale;
+    WorkBlock.Bias = Simplified ? nullptr : Bias;
+    WorkBlock.Output = Output;
+    WorkBlock.Mean = Mean;
+    WorkBlock.InvStdDev = InvStdDev;
+    WorkBlock.N = N;
+    WorkBlock.D = D;
+    WorkBlock.Epsilon = Epsilon;
+    WorkBlock.Simplified = Simplified;
+
+    MlasExecuteLayerNorm(&WorkBlock, ThreadPool);
+}
+
+void
+MLASCALL
+MlasComputeSkipLayerNorm(
+    const float* Input,
+    const float* Skip,
+    const float* SkipBias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    size_t N,
+    size_t D,
+    float Epsilon,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the layer normalization of the sum of the input,
+    skip and optional bias buffers.
+
+    N.B. The output buffer must not overlap the input or skip buffers.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Skip - Supplies the skip buffer.
+
+    SkipBias - Optionally supplies the bias buffer of D elements to add to
+        the input.
+
+    Gamma - Supplies the scale buffer of D elements.
+
+    Beta - Optionally supplies the bias buffer of D elements to add to the
+        normalized output.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of rows to process.
+
+    D - Supplies the number of columns per row to process.
+
+    Epsilon - Supplies the value added to the variance to avoid division by
+        zero.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_LAYERNORM_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Input = Input;
+    WorkBlock.Skip = Skip;
+    WorkBlock.SkipBias = SkipBias;
+    WorkBlock.Scale = Gamma;
+    WorkBlock.Bias = Beta;
+    WorkBlock.Output = Output;
+    WorkBlock.Mean = nullptr;
+    WorkBlock.InvStdDev = nullptr;
+    WorkBlock.N = N;
+    WorkBlock.D = D;
+    WorkBlock.Epsilon = Epsilon;
+    WorkBlock.Simplified = false;
+
+    MlasExecuteLayerNorm(&WorkBlock, ThreadPool);
+}
@@ -239,6 +239,68 @@ void
     size_t ldb
     );
 
+typedef
+size_t
+(MLASCALL MLAS_HALF_GEMM_KERNEL)(
+    const float* A,
+    const uint16_t* B,
+    float* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    float alpha,
+    bool ZeroMode
+    );
+
+typedef
+void
+(MLASCALL MLAS_CAST_F16_TO_F32_KERNEL)(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    );
+
+typedef
+void
+(MLASCALL MLAS_CAST_F32_TO_F16_KERNEL)(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    );
+
+typedef
+size_t
+(MLASCALL MLAS_Q4GEMM_KERNEL)(
+    const float* A,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockSize,
+    size_t lda,
+    size_t ldc,
+    const float* Bias
+    );
+
+//
+// Each block of the packed 4-bit matrix B covers 16 columns and BlockSize
+// rows: 16 scales, 16 negated zero point times scale terms, then one 8 byte
+// row of 4-bit values for each row of the block. Byte j of a row holds column
+// j in the low nibble and column j + 8 in the high nibble.
+//
+
+MLAS_FORCEINLINE
+size_t
+MlasQ4GemmPackedBlockStride(
+    size_t BlockSize
+    )
+{
+    return 2 * 16 * sizeof(float) + BlockSize * 8;
+}
+
 typedef
 size_t
 (MLASCALL MLAS_GEMM_U8S8_KERNEL)(
@@ -413,6 +475,29 @@ void
     size_t N
     );
 
+typedef
+void
+(MLASCALL MLAS_COMPUTE_SUM_SQUARE_FLOAT_KERNEL)(
+    const float* Input,
+    const float* Skip,
+    const float* SkipBias,
+    float* Output,
+    size_t N,
+    float Shift,
+    float* Sums
+    );
+
+typedef
+void
+(MLASCALL MLAS_COMPUTE_LAYERNORM_OUTPUT_FLOAT_KERNEL)(
+    const float* Input,
+    const float* Scale,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    const float* Parameters
+    );
+
 typedef
 void
 (MLASCALL MLAS_QLINEAR_BINARY_OP_S8_KERNEL)(
@@ -517,6 +602,27 @@ extern "C" {
     MLAS_SGEMM_TRANSPOSE_PACKB_BLOCK_ROUTINE MlasSgemmTransposePackB16x4Avx;
 #endif
 
+    MLAS_HALF_GEMM_KERNEL MlasHalfGemmKernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_HALF_GEMM_KERNEL MlasHalfGemmKernelAvx2;
+    MLAS_HALF_GEMM_KERNEL MlasHalfGemmKernelAvx512F;
+#endif
+
+    MLAS_Q4GEMM_KERNEL MlasQ4GemmKernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_Q4GEMM_KERNEL MlasQ4GemmKernelAvx2;
+    MLAS_Q4GEMM_KERNEL MlasQ4GemmKernelAvx512F;
+#endif
+
+    MLAS_CAST_F16_TO_F32_KERNEL MlasCastF16ToF32Kernel;
+    MLAS_CAST_F32_TO_F16_KERNEL MlasCastF32ToF16Kernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_CAST_F16_TO_F32_KERNEL MlasCastF16ToF32KernelAvx2;
+    MLAS_CAST_F32_TO_F16_KERNEL MlasCastF32ToF16KernelAvx2;
+    MLAS_CAST_F16_TO_F32_KERNEL MlasCastF16ToF32KernelAvx512F;
+    MLAS_CAST_F32_TO_F16_KERNEL MlasCastF32ToF16KernelAvx512F;
+#endif
+
 #if defined(MLAS_TARGET_AMD64)
     MLAS_GEMM_U8S8_KERNEL MlasGemmU8S8KernelAvx2;
     MLAS_GEMV_U8S8_KERNEL MlasGemvU8S8KernelAvx2;
@@ -600,6 +706,15 @@ extern "C" {
     MLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL MlasReduceMinimumMaximumF32KernelAvx;
 #endif
 
+    MLAS_COMPUTE_SUM_SQUARE_FLOAT_KERNEL MlasComputeSumSquareF32Kernel;
+    MLAS_COMPUTE_LAYERNORM_OUTPUT_FLOAT_KERNEL MlasComputeLayerNormOutputF32Kernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_COMPUTE_SUM_SQUARE_FLOAT_KERNEL MlasComputeSumSquareF32KernelFma3;
+    MLAS_COMPUTE_SUM_SQUARE_FLOAT_KERNEL MlasComputeSumSquareF32KernelAvx512F;
+    MLAS_COMPUTE_LAYERNORM_OUTPUT_FLOAT_KERNEL MlasComputeLayerNormOutputF32KernelFma3;
+    MLAS_COMPUTE_LAYERNORM_OUTPUT_FLOAT_KERNEL MlasComputeLayerNormOutputF32KernelAvx512F;
+#endif
+
 }
 
 //
@@ -649,6 +764,24 @@ MlasSgemmOperation(
     size_t ldc
     );
 
+void
+MlasSgemmMultiplyBeta(
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    float beta
+    );
+
+void
+MlasSgemmTransposeA(
+    float* D,
+    const float* A,
+    size_t lda,
+    size_t CountY,
+    size_t CountX
+    );
+
 //
 // Quantized integer matrix/matrix dispatch structure.
 //
@@ -716,6 +849,10 @@ struct MLAS_PLATFORM {
     MLAS_SGEMM_KERNEL_M1_ROUTINE* KernelM1TransposeBRoutine;
     MLAS_SGEMM_TRANSPOSE_PACKB_BLOCK_ROUTINE* TransposePackB16x4Routine;
     MLAS_GEMM_DOUBLE_KERNEL* GemmDoubleKernel;
+    MLAS_HALF_GEMM_KERNEL* HalfGemmKernel;
+    MLAS_Q4GEMM_KERNEL* Q4GemmKernel;
+    MLAS_CAST_F16_TO_F32_KERNEL* CastF16ToF32Kernel;
+    MLAS_CAST_F32_TO_F16_KERNEL* CastF32ToF16Kernel;
     MLAS_GEMM_U8S8_KERNEL* GemmU8S8Kernel;
     MLAS_GEMV_U8S8_KERNEL* GemvU8S8Kernel;
     MLAS_GEMM_U8U8_KERNEL* GemmU8U8Kernel;
@@ -737,6 +874,8 @@ struct MLAS_PLATFORM {
     MLAS_COMPUTE_LOGSOFTMAX_OUTPUT_FLOAT_KERNEL* ComputeLogSoftmaxOutputF32Kernel;
     MLAS_REDUCE_MAXIMUM_FLOAT_KERNEL* ReduceMaximumF32Kernel;
     MLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL* ReduceMinimumMaximumF32Kernel;
+    MLAS_COMPUTE_SUM_SQUARE_FLOAT_KERNEL* ComputeSumSquareF32Kernel;
+    MLAS_COMPUTE_LAYERNORM_OUTPUT_FLOAT_KERNEL* ComputeLayerNormOutputF32Kernel;
     MLAS_QUANTIZE_LINEAR_S8_KERNEL* QuantizeLinearS8Kernel;
     MLAS_QUANTIZE_LINEAR_U8_KERNEL* QuantizeLinearU8Kernel;
     uint32_t NchwcBlockSize;
@@ -868,6 +1007,129 @@ MlasFp32FromBits(
     return u.FloatValue;
 }
 
+//
+// Helper to convert a half precision floating point value to single precision.
+//
+
+MLAS_FORCEINLINE
+float
+MlasHalfToFloat(
+    uint16_t HalfValue
+    )
+{
+    constexpr uint32_t ShiftedExponent = 0x7C00 << 13;
+
+    uint32_t Bits = uint32_t(HalfValue & 0x7FFF) << 13;
+    const uint32_t Exponent = Bits & ShiftedExponent;
+
+    Bits += (127 - 15) << 23;
+
+    if (Exponent == ShiftedExponent) {
+
+        //
+        // Infinity or NaN: extend the exponent to the single precision range.
+        //
+
+        Bits += (128 - 16) << 23;
+
+    } else if (Exponent == 0) {
+
+        //
+        // Zero or denormal: renormalize using the floating point unit.
+        //
+
+        Bits += 1 << 23;
+        Bits = MlasBitsOfFp32(MlasFp32FromBits(Bits) - MlasFp32FromBits(113 << 23));
+    }
+
+    Bits |= uint32_t(HalfValue & 0x8000) << 16;
+
+    return MlasFp32FromBits(Bits);
+}
+
+//
+// Helper to convert a single precision floating point value to half precision
+// with rounding to nearest even.
+//
+
+MLAS_FORCEINLINE
+uint16_t
+MlasFloatToHalf(
+    float FloatValue
+    )
+{
+    constexpr uint32_t Fp32Infinity = 255 << 23;
+    constexpr uint32_t Fp16Maximum = (127 + 16) << 23;
+    constexpr uint32_t DenormalMagic = ((127 - 15) + (23 - 10) + 1) << 23;
+
+    uint32_t Bits = MlasBitsOfFp32(FloatValue);
+    const uint32_t Sign = Bits & 0x80000000;
+    Bits ^= Sign;
+
+    uint16_t HalfValue;
+
+    if (Bits >= Fp16Maximum) {
+
+        //
+        // Overflow to infinity, or NaN.
+        //
+
+        HalfValue = (Bits > Fp32Infinity) ? 0x7E00 : 0x7C00;
+
+    } else if (Bits < (113 << 23)) {
+
+        //
+        // Zero or denormal: let the floating point unit round the mantissa.
+        //
+
+        Bits = MlasBitsOfFp32(MlasFp32FromBits(Bits) + MlasFp32FromBits(DenormalMagic));
+        HalfValue = uint16_t(Bits - DenormalMagic);
+
+    } else {
+
+        //
+        // Normal: rebias the exponent and round the mantissa to nearest even.
+        //
+
+        const uint32_t MantissaOdd = (Bits >> 13) & 1;
+        Bits -= (127 - 15) << 23;
+        Bits += 0xFFF + MantissaOdd;
+        HalfValue = uint16_t(Bits >> 13);
+    }
+
+    return uint16_t(HalfValue | (Sign >> 16));
+}
+
+//
+// Helpers to convert between single precision and bfloat16 floating point
+// values, rounding to nearest even.
+//
+
+MLAS_FORCEINLINE
+float
+MlasBFloat16ToFloat(
+    uint16_t BFloat16Value
+    )
+{
+    return MlasFp32FromBits(uint32_t(BFloat16Value) << 16);
+}
+
+MLAS_FORCEINLINE
+uint16_t
+MlasFloatToBFloat16(
+    float FloatValue
+    )
+{
+    uint32_t Bits = MlasBitsOfFp32(FloatValue);
+
+    if ((Bits & 0x7FFFFFFF) > 0x7F800000) {
+        return uint16_t(((Bits >> 16) & 0x8000) | 0x7FC0);
+    }
+
+    Bits += 0x7FFF + ((Bits >> 16) & 1);
+
+    return uint16_t(Bits >> 16);
+}
 
 #if defined(MLAS_TARGET_WASM_SCALAR)
 
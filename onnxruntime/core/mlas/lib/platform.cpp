@@ -137,6 +137,10 @@ Return Value:
 
     this->TransposePackB16x4Routine = MlasSgemmTransposePackB16x4Sse;
     this->GemmDoubleKernel = MlasGemmDoubleKernelSse;
+    this->HalfGemmKernel = MlasHalfGemmKernel;
+    this->Q4GemmKernel = MlasQ4GemmKernel;
+    this->CastF16ToF32Kernel = MlasCastF16ToF32Kernel;
+    this->CastF32ToF16Kernel = MlasCastF32ToF16Kernel;
     this->ConvNchwFloatKernel = MlasConvNchwFloatKernelSse;
     this->ConvNchwcFloatKernel = MlasConvNchwcFloatKernelSse;
     this->ConvDepthwiseFloatKernel = MlasConvDepthwiseFloatKernelSse;
@@ -153,6 +157,8 @@ Return Value:
     this->ComputeLogSoftmaxOutputF32Kernel = MlasComputeLogSoftmaxOutputF32Kernel;
     this->ReduceMaximumF32Kernel = MlasReduceMaximumF32Kernel;
     this->ReduceMinimumMaximumF32Kernel = MlasReduceMinimumMaximumF32Kernel;
+    this->ComputeSumSquareF32Kernel = MlasComputeSumSquareF32Kernel;
+    this->ComputeLayerNormOutputF32Kernel = MlasComputeLayerNormOutputF32Kernel;
     this->QLinearAddS8Kernel = MlasQLinearAddS8Kernel;
     this->QLinearAddU8Kernel = MlasQLinearAddU8Kernel;
     this->QuantizeLinearS8Kernel = MlasQuantizeLinearS8Kernel;
@@ -254,6 +260,20 @@ Return Value:
                 this->ConvDepthwiseU8S8Kernel = MlasConvDepthwiseKernelAvx2<int8_t>;
                 this->ConvDepthwiseU8U8Kernel = MlasConvDepthwiseKernelAvx2<uint8_t>;
                 this->ComputeSumExpF32Kernel = MlasComputeSumExpF32KernelFma3;
+                this->ComputeSumSquareF32Kernel = MlasComputeSumSquareF32KernelFma3;
+                this->ComputeLayerNormOutputF32Kernel = MlasComputeLayerNormOutputF32KernelFma3;
+                this->Q4GemmKernel = MlasQ4GemmKernelAvx2;
+
+                //
+                // Check if the processor supports the F16C half precision
+                // conversion instructions.
+                //
+
+                if ((Cpuid1[2] & 0x20000000) != 0) {
+                    this->HalfGemmKernel = MlasHalfGemmKernelAvx2;
+                    this->CastF16ToF32Kernel = MlasCastF16ToF32KernelAvx2;
+                    this->CastF32ToF16Kernel = MlasCastF32ToF16KernelAvx2;
+                }
 
                 //
                 // Check if the processor supports Hybrid core architecture.
@@ -292,6 +312,10 @@ Return Value:
 
                     this->GemmFloatKernel = MlasGemmFloatKernelAvx512F;
                     this->GemmDoubleKernel = MlasGemmDoubleKernelAvx512F;
+                    this->HalfGemmKernel = MlasHalfGemmKernelAvx512F;
+                    this->Q4GemmKernel = MlasQ4GemmKernelAvx512F;
+                    this->CastF16ToF32Kernel = MlasCastF16ToF32KernelAvx512F;
+                    this->CastF32ToF16Kernel = MlasCastF32ToF16KernelAvx512F;
                     this->ConvNchwFloatKernel = MlasConvNchwFloatKernelAvx512F;
                     this->ConvNchwcFloatKernel = MlasConvNchwcFloatKernelAvx512F;
                     this->ConvDepthwiseFloatKernel = MlasConvDepthwiseFloatKernelAvx512F;
@@ -301,6 +325,8 @@ Return Value:
                     this->PoolFloatKernel[MlasAveragePoolingIncludePad] = MlasPoolAverageIncludePadFloatKernelAvx512F;
                     this->ComputeExpF32Kernel = MlasComputeExpF32KernelAvx512F;
                     this->ComputeSumExpF32Kernel = MlasComputeSumExpF32KernelAvx512F;
+                    this->ComputeSumSquareF32Kernel = MlasComputeSumSquareF32KernelAvx512F;
+                    this->ComputeLayerNormOutputF32Kernel = MlasComputeLayerNormOutputF32KernelAvx512F;
                     this->QuantizeLinearS8Kernel = MlasQuantizeLinearS8KernelAvx512F;
                     this->QuantizeLinearU8Kernel = MlasQuantizeLinearU8KernelAvx512F;
                     this->NchwcBlockSize = 16;
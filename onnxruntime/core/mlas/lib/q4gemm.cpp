@@ -0,0 +1,636 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    q4gemm.cpp
+
+Abstract:
+
+    This module implements the single precision matrix/matrix multiply
+    operation with a 4-bit block quantized matrix B.
+
+    Each block of BlockSize rows of a column of matrix B shares a scale and a
+    zero point. The packed buffer keeps matrix B in 4-bit form next to the
+    block quantization parameters and the kernels dequantize it in registers,
+    so the memory bandwidth for the weights is an eighth of a single
+    precision matrix.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the number of columns of matrix B to step through for a slice of
+// matrix A, which keeps the packed slice of matrix B resident in the cache
+// while the rows of matrix A are processed.
+//
+
+#define MLAS_Q4GEMM_STRIDEN                         64
+
+//
+// Define the range of supported block sizes.
+//
+
+#define MLAS_Q4GEMM_MINIMUM_BLOCK_SIZE              16
+#define MLAS_Q4GEMM_MAXIMUM_BLOCK_SIZE              256
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasQ4GemmKernelRows(
+    const float* A,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockSize,
+    size_t lda,
+    size_t ldc,
+    const float* Bias
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute matrix multiplication for a
+    set of rows using portable C++ code.
+
+Arguments:
+
+    A - Supplies the address of matrix A.
+
+    PackedB - Supplies the address of matrix B. The matrix data has been
+        packed using MlasQ4GemmPackB.
+
+    C - Supplies the address of matrix C.
+
+    CountN - Supplies the number of columns from matrix B and matrix C to
+        iterate over.
+
+    CountK - Supplies the number of columns from matrix A and the number of
+        rows from matrix B to iterate over.
+
+    BlockSize - Supplies the number of rows of matrix B sharing a scale and
+        zero point.
+
+    lda - Supplies the first dimension of matrix A.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    Bias - Supplies the optional bias vector for the columns of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BlockStride = MlasQ4GemmPackedBlockStride(BlockSize);
+    const size_t BlockCountK = (CountK + BlockSize - 1) / BlockSize;
+
+    while (CountN > 0) {
+
+        float Accumulators[RowCount][16];
+
+        for (size_t r = 0; r < RowCount; r++) {
+            std::fill_n(Accumulators[r], 16, 0.0f);
+        }
+
+        const uint8_t* b = PackedB;
+
+        for (size_t k = 0; k < CountK; k += BlockSize) {
+
+            const float* Scale = reinterpret_cast<const float*>(b);
+            const float* ZeroBias = Scale + 16;
+            const uint8_t* QuantB = b + 2 * 16 * sizeof(float);
+
+            const size_t CountBlockK = std::min(CountK - k, BlockSize);
+
+            for (size_t kk = 0; kk < CountBlockK; kk++) {
+
+                float BlockB[16];
+
+                for (size_t n = 0; n < 8; n++) {
+                    BlockB[n] = float(QuantB[n] & 0x0F) * Scale[n] + ZeroBias[n];
+                    BlockB[n + 8] = float(QuantB[n] >> 4) * Scale[n + 8] + ZeroBias[n + 8];
+                }
+
+                for (size_t r = 0; r < RowCount; r++) {
+
+                    const float ElementA = A[r * lda + k + kk];
+
+                    for (size_t n = 0; n < 16; n++) {
+                        Accumulators[r][n] += ElementA * BlockB[n];
+                    }
+                }
+
+                QuantB += 8;
+            }
+
+            b += BlockStride;
+        }
+
+        const size_t CountBlockN = std::min(CountN, size_t(16));
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            float* c = C + r * ldc;
+
+            for (size_t n = 0; n < CountBlockN; n++) {
+                c[n] = (Bias != nullptr) ? Accumulators[r][n] + Bias[n] : Accumulators[r][n];
+            }
+        }
+
+        PackedB += BlockCountK * BlockStride;
+        C += 16;
+
+        if (Bias != nullptr) {
+            Bias += 16;
+        }
+
+        CountN -= CountBlockN;
+    }
+}
+
+size_t
+MLASCALL
+MlasQ4GemmKernel(
+    const float* A,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockSize,
+    size_t lda,
+    size_t ldc,
+    const float* Bias
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute matrix multiplication for a
+    set of rows.
+
+Arguments:
+
+    A - Supplies the address of matrix A.
+
+    PackedB - Supplies the address of matrix B. The matrix data has been
+        packed using MlasQ4GemmPackB.
+
+    C - Supplies the address of matrix C.
+
+    CountM - Supplies the maximum number of rows that can be processed for
+        matrix A and matrix C. The actual number of rows handled for this
+        invocation depends on the kernel implementation.
+
+    CountN - Supplies the number of columns from matrix B and matrix C to
+        iterate over.
+
+    CountK - Supplies the number of columns from matrix A and the number of
+        rows from matrix B to iterate over.
+
+    BlockSize - Supplies the number of rows of matrix B sharing a scale and
+        zero point.
+
+    lda - Supplies the first dimension of matrix A.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    Bias - Supplies the optional bias vector for the columns of matrix C.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    if (CountM >= 4) {
+        MlasQ4GemmKernelRows<4>(A, PackedB, C, CountN, CountK, BlockSize, lda, ldc, Bias);
+        return 4;
+    }
+
+    switch (CountM) {
+        case 3:
+            MlasQ4GemmKernelRows<3>(A, PackedB, C, CountN, CountK, BlockSize, lda, ldc, Bias);
+            break;
+        case 2:
+            MlasQ4GemmKernelRows<2>(A, PackedB, C, CountN, CountK, BlockSize, lda, ldc, Bias);
+            break;
+        default:
+            MlasQ4GemmKernelRows<1>(A, PackedB, C, CountN, CountK, BlockSize, lda, ldc, Bias);
+            break;
+    }
+
+    return CountM;
+}
+
+void
+MlasQ4GemmOperation(
+    size_t M,
+    size_t RangeStartN,
+    size_t RangeCountN,
+    size_t K,
+    size_t BlockSize,
+    const MLAS_Q4GEMM_DATA_PARAMS* DataParams,
+    const float* A,
+    float* C
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation with a packed 4-bit matrix B for a range of columns.
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    RangeStartN - Supplies the starting column from packed matrix B. This is
+        a multiple of 16.
+
+    RangeCountN - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    BlockSize - Supplies the number of rows of matrix B sharing a scale and
+        zero point.
+
+    DataParams - Supplies the data position and layout of the matrices.
+
+    A - Supplies the address of the first row of matrix A for this range.
+
+    C - Supplies the address of the first element of matrix C for this range.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_Q4GEMM_KERNEL* Q4GemmKernel = MlasPlatform.Q4GemmKernel;
+#else
+    MLAS_Q4GEMM_KERNEL* Q4GemmKernel = MlasQ4GemmKernel;
+#endif
+
+    const size_t lda = DataParams->lda;
+    const size_t ldc = DataParams->ldc;
+
+    const size_t BlockCountK = (K + BlockSize - 1) / BlockSize;
+    const size_t PanelStride = BlockCountK * MlasQ4GemmPackedBlockStride(BlockSize);
+
+    const uint8_t* PackedB = static_cast<const uint8_t*>(DataParams->PackedB) +
+        (RangeStartN / 16) * PanelStride;
+    const float* Bias = (DataParams->Bias != nullptr) ? DataParams->Bias + RangeStartN : nullptr;
+
+    //
+    // Step through each slice of matrix B along the N dimension. All rows of
+    // matrix A are processed against a slice before moving to the next slice.
+    //
+
+    size_t CountN;
+
+    for (size_t n = 0; n < RangeCountN; n += CountN) {
+
+        CountN = std::min(RangeCountN - n, size_t(MLAS_Q4GEMM_STRIDEN));
+
+        const float* a = A;
+        float* c = C + n;
+        size_t RowsRemaining = M;
+
+        while (RowsRemaining > 0) {
+
+            size_t RowsHandled = Q4GemmKernel(a, PackedB, c, RowsRemaining, CountN, K,
+                BlockSize, lda, ldc, Bias);
+
+            a += lda * RowsHandled;
+            c += ldc * RowsHandled;
+            RowsRemaining -= RowsHandled;
+        }
+
+        PackedB += (MLAS_Q4GEMM_STRIDEN / 16) * PanelStride;
+
+        if (Bias != nullptr) {
+            Bias += MLAS_Q4GEMM_STRIDEN;
+        }
+    }
+}
+
+void
+MlasQ4GemmThreaded(
+    const ptrdiff_t ThreadCountM,
+    const ptrdiff_t ThreadCountN,
+    const size_t M,
+    const size_t N,
+    const size_t K,
+    const size_t BlockSize,
+    const MLAS_Q4GEMM_DATA_PARAMS* DataParams,
+    ptrdiff_t ThreadId
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    4-bit quantized B GEMM operation.
+
+Arguments:
+
+    ThreadCountM - Supplies the total thread partition on the M dimension.
+
+    ThreadCountN - Supplies the total thread partition on the N dimension.
+
+    M, N, K - Supplies the shape of the multiplication
+
+    BlockSize - Supplies the number of rows of matrix B sharing a scale and
+        zero point.
+
+    DataParams - Supplies the data position and layout of the matrices
+
+    ThreadId - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const ptrdiff_t ThreadIdM = ThreadId / ThreadCountN;
+    const ptrdiff_t ThreadIdN = ThreadId % ThreadCountN;
+
+    //
+    // Partition the operation along the M dimension.
+    //
+
+    size_t RangeStartM;
+    size_t RangeCountM;
+
+    MlasPartitionWork(ThreadIdM, ThreadCountM, M, &RangeStartM, &RangeCountM);
+
+    //
+    // Partition the operation along the N dimension.
+    //
+
+    size_t RangeStartN;
+    size_t RangeCountN;
+
+    const size_t BlockedN = (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) /
+        MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+
+    MlasPartitionWork(ThreadIdN, ThreadCountN, BlockedN, &RangeStartN,
+        &RangeCountN);
+
+    RangeStartN *= MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+    RangeCountN *= MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+
+    RangeCountN = std::min(N - RangeStartN, RangeCountN);
+
+    //
+    // Dispatch the partitioned operation.
+    //
+
+    const float* A = DataParams->A + RangeStartM * DataParams->lda;
+    float* C = DataParams->C + RangeStartM * DataParams->ldc + RangeStartN;
+
+    MlasQ4GemmOperation(RangeCountM, RangeStartN, RangeCountN, K, BlockSize,
+        DataParams, A, C);
+}
+
+void
+MLASCALL
+MlasQ4GemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BlockSize,
+    const MLAS_Q4GEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    //
+    // Compute the number of target threads given the complexity of the
+    // operation. Small requests should run using the single threaded path.
+    //
+
+    const double Complexity = double(M) * double(N) * double(K);
+
+    ptrdiff_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MlasPlatform.MaximumThreadCount)) {
+        TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MlasPlatform.MaximumThreadCount;
+    }
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    //
+    // Segment the operation across multiple threads. Splitting along the N
+    // dimension is preferred as each thread then streams a disjoint part of
+    // the packed matrix B, which dominates the memory traffic.
+    //
+
+    ptrdiff_t ThreadsPerGemm = (TargetThreadCount + BatchSize - 1) / BatchSize;
+    ptrdiff_t ThreadCountM;
+    ptrdiff_t ThreadCountN;
+
+    const size_t BlockedN = (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) /
+        MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+
+    if (BlockedN >= size_t(ThreadsPerGemm) || BlockedN >= M) {
+
+        if (size_t(ThreadsPerGemm) > BlockedN) {
+            ThreadsPerGemm = ptrdiff_t(BlockedN);
+        }
+
+        ThreadCountM = 1;
+        ThreadCountN = ThreadsPerGemm;
+
+    } else {
+
+        if (size_t(ThreadsPerGemm) > M) {
+            ThreadsPerGemm = ptrdiff_t(M);
+        }
+
+        ThreadCountM = ThreadsPerGemm;
+        ThreadCountN = 1;
+    }
+
+    MlasTrySimpleParallel(ThreadPool,
+        ThreadsPerGemm * static_cast<ptrdiff_t>(BatchSize),
+        [=](ptrdiff_t tid)
+    {
+        ptrdiff_t GemmIdx = tid / ThreadsPerGemm;
+        ptrdiff_t ThreadIdx = tid % ThreadsPerGemm;
+        MlasQ4GemmThreaded(ThreadCountM, ThreadCountN,
+            M, N, K, BlockSize, &(Data[GemmIdx]), ThreadIdx);
+    });
+}
+
+bool
+MLASCALL
+MlasQ4GemmIsBlockSizeSupported(
+    size_t BlockSize
+    )
+{
+    return BlockSize >= MLAS_Q4GEMM_MINIMUM_BLOCK_SIZE &&
+        BlockSize <= MLAS_Q4GEMM_MAXIMUM_BLOCK_SIZE &&
+        (BlockSize & (BlockSize - 1)) == 0;
+}
+
+size_t
+MLASCALL
+MlasQ4GemmPackBSize(
+    size_t N,
+    size_t K,
+    size_t BlockSize
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the length in bytes for the packed 4-bit matrix B
+    buffer.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    BlockSize - Supplies the number of rows of matrix B sharing a scale and
+        zero point.
+
+Return Value:
+
+    Returns the size in bytes for the packed matrix B buffer, or zero if the
+    block size is not supported.
+
+--*/
+{
+    if (!MlasQ4GemmIsBlockSizeSupported(BlockSize)) {
+        return 0;
+    }
+
+    const size_t BlockCountN = (N + 15) / 16;
+    const size_t BlockCountK = (K + BlockSize - 1) / BlockSize;
+
+    const size_t BytesRequired = BlockCountN * BlockCountK * MlasQ4GemmPackedBlockStride(BlockSize);
+    const size_t BufferAlignment = MlasGetPreferredBufferAlignment();
+    const size_t AlignedBytesRequired = (BytesRequired + BufferAlignment - 1) &
+        ~(BufferAlignment - 1);
+
+    return AlignedBytesRequired;
+}
+
+void
+MLASCALL
+MlasQ4GemmPackB(
+    size_t N,
+    size_t K,
+    size_t BlockSize,
+    const uint8_t* QuantB,
+    const float* Scales,
+    const uint8_t* ZeroPoints,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine packs the 4-bit quantized matrix B and its block quantization
+    parameters into the layout consumed by the kernels.
+
+    Each packed block starts with the 16 scales of its columns, followed by
+    the 16 products of the negated zero points and the scales, so that a value
+    is dequantized with a single multiply-add. The 4-bit values of the block
+    follow with 8 bytes per row: byte j holds column j in the low nibble and
+    column j + 8 in the high nibble. Columns beyond N dequantize to zero.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    BlockSize - Supplies the number of rows of matrix B sharing a scale and
+        zero point.
+
+    QuantB - Supplies the quantized matrix B (see MLAS_Q4GEMM_DATA_PARAMS).
+
+    Scales - Supplies the per block scales.
+
+    ZeroPoints - Supplies the optional per block 4-bit zero points.
+
+    PackedB - Supplies the address of packed matrix B.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BlockCountK = (K + BlockSize - 1) / BlockSize;
+    const size_t BlockStride = MlasQ4GemmPackedBlockStride(BlockSize);
+    const size_t QuantBlockBytes = BlockSize / 2;
+    const size_t ZeroPointStride = (BlockCountK + 1) / 2;
+
+    uint8_t* D = static_cast<uint8_t*>(PackedB);
+
+    for (size_t n = 0; n < N; n += 16) {
+
+        const size_t CountN = std::min(N - n, size_t(16));
+
+        for (size_t kb = 0; kb < BlockCountK; kb++) {
+
+            float* Scale = reinterpret_cast<float*>(D);
+            float* ZeroBias = Scale + 16;
+            uint8_t* q = D + 2 * 16 * sizeof(float);
+
+            std::fill_n(Scale, 2 * 16, 0.0f);
+            std::fill_n(q, BlockSize * 8, uint8_t(0));
+
+            const size_t CountK = std::min(K - kb * BlockSize, BlockSize);
+
+            for (size_t j = 0; j < CountN; j++) {
+
+                const size_t Column = n + j;
+                const float ScaleValue = Scales[Column * BlockCountK + kb];
+
+                uint8_t ZeroPoint = 8;
+
+                if (ZeroPoints != nullptr) {
+                    const uint8_t PackedZeroPoints = ZeroPoints[Column * ZeroPointStride + kb / 2];
+                    ZeroPoint = (kb & 1) ? (PackedZeroPoints >> 4) : (PackedZeroPoints & 0x0F);
+                }
+
+                Scale[j] = ScaleValue;
+                ZeroBias[j] = -float(ZeroPoint) * ScaleValue;
+
+                const uint8_t* s = QuantB + (Column * BlockCountK + kb) * QuantBlockBytes;
+                const unsigned Shift = (j < 8) ? 0 : 4;
+
+                for (size_t k = 0; k < CountK; k++) {
+                    const uint8_t Value = (k & 1) ? (s[k / 2] >> 4) : (s[k / 2] & 0x0F);
+                    q[k * 8 + (j & 7)] |= uint8_t(Value << Shift);
+                }
+            }
+
+            D += BlockStride;
+        }
+    }
+}
@@ -209,7 +209,9 @@ void
 MLASCALL
 MlasTranspose(
     const uint32_t* Input,
+    size_t ldInput,
     uint32_t* Output,
+    size_t ldOutput,
     size_t M,
     size_t N
     )
@@ -218,14 +220,21 @@ MlasTranspose(
 Routine Description:
 
     This routine transposes the input matrix (M rows by N columns) to the
-    output matrix (N rows by M columns).
+    output matrix (N rows by M columns), where the rows of either matrix may
+    be part of a larger matrix.
 
 Arguments:
 
     Input - Supplies the input buffer.
 
+    ldInput - Supplies the number of elements between the rows of the input
+        matrix.
+
     Output - Supplies the output buffer.
 
+    ldOutput - Supplies the number of elements between the rows of the output
+        matrix.
+
     M - Supplies the number of rows for the input matrix and the number of
         columns for the output matrix.
 
@@ -255,9 +264,9 @@ Return Value:
 
         while (m >= 4) {
 
-            MlasTranspose4x4Block(s, N, d, M);
+            MlasTranspose4x4Block(s, ldInput, d, ldOutput);
 
-            s += N * 4;
+            s += ldInput * 4;
             d += 4;
             m -= 4;
         }
@@ -266,15 +275,15 @@ Return Value:
 
         while (m > 0) {
 
-            MlasTranspose4xNVector(s, 1, d, M);
+            MlasTranspose4xNVector(s, 1, d, ldOutput);
 
-            s += N;
+            s += ldInput;
             d += 1;
             m -= 1;
         }
 
         Input += 4;
-        Output += M * 4;
+        Output += ldOutput * 4;
         n -= 4;
     }
 
@@ -291,9 +300,9 @@ Return Value:
 
         while (m >= 4) {
 
-            MlasTranspose4xNVector(s, N, d, 1);
+            MlasTranspose4xNVector(s, ldInput, d, 1);
 
-            s += N * 4;
+            s += ldInput * 4;
             d += 4;
             m -= 4;
         }
@@ -302,17 +311,73 @@ Return Value:
 
             d[0] = s[0];
 
-            s += N;
+            s += ldInput;
             d += 1;
             m -= 1;
         }
 
         Input += 1;
-        Output += M;
+        Output += ldOutput;
         n -= 1;
     }
 }
 
+void
+MLASCALL
+MlasTranspose(
+    const uint32_t* Input,
+    uint32_t* Output,
+    size_t M,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes the input matrix (M rows by N columns) to the
+    output matrix (N rows by M columns).
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    M - Supplies the number of rows for the input matrix and the number of
+        columns for the output matrix.
+
+    N - Supplies the number of columns for the input matrix and the number of
+        rows for the output matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasTranspose(Input, N, Output, M, M, N);
+}
+
+void
+MLASCALL
+MlasTranspose(
+    const float* Input,
+    size_t ldInput,
+    float* Output,
+    size_t ldOutput,
+    size_t M,
+    size_t N
+    )
+{
+    MlasTranspose(
+        reinterpret_cast<const uint32_t*>(Input),
+        ldInput,
+        reinterpret_cast<uint32_t*>(Output),
+        ldOutput,
+        M,
+        N);
+}
+
 void
 MLASCALL
 MlasTranspose(
@@ -333,7 +398,9 @@ void
 MLASCALL
 MlasTranspose(
     const uint8_t* Input,
+    size_t ldInput,
     uint8_t* Output,
+    size_t ldOutput,
     size_t M,
     size_t N
     )
@@ -342,14 +409,21 @@ MlasTranspose(
 Routine Description:
 
     This routine transposes the input matrix (M rows by N columns) to the
-    output matrix (N rows by M columns).
+    output matrix (N rows by M columns), where the rows of either matrix may
+    be part of a larger matrix.
 
 Arguments:
 
     Input - Supplies the input buffer.
 
+    ldInput - Supplies the number of elements between the rows of the input
+        matrix.
+
     Output - Supplies the output buffer.
 
+    ldOutput - Supplies the number of elements between the rows of the output
+        matrix.
+
     M - Supplies the number of rows for the input matrix and the number of
         columns for the output matrix.
 
@@ -379,9 +453,9 @@ Return Value:
 
         while (m >= 8) {
 
-            MlasTranspose8x8Block(s, N, d, M);
+            MlasTranspose8x8Block(s, ldInput, d, ldOutput);
 
-            s += N * 8;
+            s += ldInput * 8;
             d += 8;
             m -= 8;
         }
@@ -390,15 +464,15 @@ Return Value:
 
         while (m > 0) {
 
-            MlasTranspose8xNVector(s, 1, d, M);
+            MlasTranspose8xNVector(s, 1, d, ldOutput);
 
-            s += N;
+            s += ldInput;
             d += 1;
             m -= 1;
         }
 
         Input += 8;
-        Output += M * 8;
+        Output += ldOutput * 8;
         n -= 8;
     }
 
@@ -415,9 +489,9 @@ Return Value:
 
         while (m >= 8) {
 
-            MlasTranspose8xNVector(s, N, d, 1);
+            MlasTranspose8xNVector(s, ldInput, d, 1);
 
-            s += N * 8;
+            s += ldInput * 8;
             d += 8;
             m -= 8;
         }
@@ -426,13 +500,49 @@ Return Value:
 
             d[0] = s[0];
 
-            s += N;
+            s += ldInput;
             d += 1;
             m -= 1;
         }
 
         Input += 1;
-        Output += M;
+        Output += ldOutput;
         n -= 1;
     }
 }
+
+void
+MLASCALL
+MlasTranspose(
+    const uint8_t* Input,
+    uint8_t* Output,
+    size_t M,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes the input matrix (M rows by N columns) to the
+    output matrix (N rows by M columns).
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    M - Supplies the number of rows for the input matrix and the number of
+        columns for the output matrix.
+
+    N - Supplies the number of columns for the input matrix and the number of
+        rows for the output matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasTranspose(Input, N, Output, M, M, N);
+}
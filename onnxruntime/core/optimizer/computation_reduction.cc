@@ -112,7 +112,7 @@ static Status SwapGatherNDWithTargetNode(Graph& graph, Node& gathernd_node, Node
     graph.AddEdge(target_node_input_node->Index(), gathernd_node.Index(), output_index, 0);
   } else {
     // new_input_arg_for_gathernd is graph input
-    graph_utils::ReplaceNodeInput(gathernd_node, 0, *new_input_arg_for_gathernd);
+    graph_utils::ReplaceNodeInput(graph, gathernd_node, 0, *new_input_arg_for_gathernd);
   }
 
   graph_utils::ReplaceDownstreamNodeInput(graph, gathernd_node, 0 /*output_idx*/,
@@ -239,7 +239,7 @@ bool ConcatSliceElimination::FuseConcatSliceSubgraph(Node& concat, Graph& graph,
   for (auto slice_node : concat_outputs) {
     Node& op_node = *graph.GetNode(slice_node->OutputNodesBegin()->Index());
     graph_utils::RemoveNodeOutputEdges(graph, *slice_node);
-    graph_utils::ReplaceNodeInput(op_node, 1, *(concat_inputs[replace_cnt]));
+    graph_utils::ReplaceNodeInput(graph, op_node, 1, *(concat_inputs[replace_cnt]));
     replace_cnt++;
   }
   if (replace_cnt == 3) {
@@ -1,9 +1,11 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <limits>
 
 #include "core/optimizer/constant_folding.h"
+#include "core/optimizer/initializer.h"
 #include "core/optimizer/utils.h"
 #include "core/graph/graph_utils.h"
 #include "core/optimizer/optimizer_execution_frame.h"
@@ -17,23 +19,27 @@ namespace onnxruntime {
 ConstantFolding::ConstantFolding(const IExecutionProvider& execution_provider,
                                  bool skip_dequantize_linear,
                                  const std::unordered_set<std::string>& compatible_execution_providers,
-                                 const std::unordered_set<std::string>& excluded_initializers) noexcept
+                                 const std::unordered_set<std::string>& excluded_initializers,
+                                 size_t max_output_size_in_bytes) noexcept
     : GraphTransformer("ConstantFolding", compatible_execution_providers),
       skip_dequantize_linear_(skip_dequantize_linear),
       excluded_initializers_(excluded_initializers),
-      execution_provider_(execution_provider) {
+      execution_provider_(execution_provider),
+      max_output_size_in_bytes_(max_output_size_in_bytes) {
 }
 
-// We need to handle a Shape node separately as the input doesn't need to be a constant initializer for
-// Shape to be able to be constant folded.
-static bool ConstantFoldShapeNode(Graph& graph, Node& node) {
-  // Opset-15 Shape supports slicing using a 'start' and 'end' attribute
-  const auto& shape_attributes = node.GetAttributes();
+// Gets the slice [start, end) of the dims of its input a Shape node produces, given the 'start' and 'end' attributes
+// of opset-15 Shape. Returns nullptr if the rank of the input is not known.
+static const ONNX_NAMESPACE::TensorShapeProto* GetShapeNodeSlice(const Node& node, int64_t& start, int64_t& end) {
+  const auto* shape = node.InputDefs()[0]->Shape();
+  if (shape == nullptr) {
+    return nullptr;
+  }
 
-  int64_t start = 0;
-  int64_t end = std::numeric_limits<int64_t>::max();
+  start = 0;
+  end = std::numeric_limits<int64_t>::max();
 
-  for (const auto& attr : shape_attributes) {
+  for (const auto& attr : node.GetAttributes()) {
     if (attr.first == "start") {
       start = attr.second.i();
     } else if (attr.first == "end") {
@@ -41,52 +47,141 @@ static bool ConstantFoldShapeNode(Graph& graph, Node& node) {
     }
   }
 
-  auto shape = node.MutableInputDefs()[0]->Shape();
-  bool is_concrete_shape = true;
+  const int64_t rank = static_cast<int64_t>(shape->dim_size());
+
+  // Deal with negatives and clamp
+  start = start < 0 ? start + rank : start;
+  start = start < 0 ? 0 : ((start > rank) ? rank : start);
+
+  end = end < 0 ? end + rank : end;
+  end = end < 0 ? 0 : ((end > rank) ? rank : end);
+
+  end = std::max(start, end);
+  return shape;
+}
+
+// Adds an int64 initializer with the given dims and values for the output of a node.
+static void AddInt64InitializerForOutput(Graph& graph, NodeArg& output, const std::vector<int64_t>& dims,
+                                         const std::vector<int64_t>& values) {
+  ONNX_NAMESPACE::TensorProto constant;
+  constant.set_name(output.Name());
+  constant.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_INT64);
+  ONNX_NAMESPACE::TensorShapeProto result_shape;
+  for (int64_t dim : dims) {
+    constant.add_dims(dim);
+    result_shape.add_dim()->set_dim_value(dim);
+  }
+
+  constant.set_raw_data(values.data(), values.size() * sizeof(int64_t));
+  output.SetShape(result_shape);
+  graph.AddInitializedTensor(constant);
+}
+
+// We need to handle a Shape node separately as the input doesn't need to be a constant initializer for
+// Shape to be able to be constant folded. Only the dims in the slice the node produces need to be known.
+static bool ConstantFoldShapeNode(Graph& graph, Node& node) {
+  int64_t start = 0;
+  int64_t end = 0;
+  const auto* shape = GetShapeNodeSlice(node, start, end);
+  if (shape == nullptr) {
+    return false;
+  }
+
   std::vector<int64_t> dim_values;
-  if (shape != nullptr) {
-    for (int dim_index = 0; dim_index < shape->dim_size(); dim_index++) {
-      auto dim = shape->dim(dim_index);
-      if (!utils::HasDimValue(dim)) {
-        is_concrete_shape = false;
-        break;
-      }
-      dim_values.push_back(dim.dim_value());
+  for (int64_t dim_index = start; dim_index < end; ++dim_index) {
+    const auto& dim = shape->dim(static_cast<int>(dim_index));
+    if (!utils::HasDimValue(dim)) {
+      return false;
     }
+
+    dim_values.push_back(dim.dim_value());
+  }
+
+  AddInt64InitializerForOutput(graph, *node.MutableOutputDefs()[0], {static_cast<int64_t>(dim_values.size())},
+                               dim_values);
+  return true;  // convert to constant
+}
+
+// A Gather from the output of a Shape node can be constant folded if the dims it selects are known, even if other
+// dims of the shape are symbolic, e.g. Gather(Shape(X), 1) for an input X with the shape {batch, 256}.
+static bool ConstantFoldGatherOfShapeNode(Graph& graph, Node& node,
+                                          const std::unordered_set<std::string>& excluded_initializers) {
+  const Node* shape_node = graph_utils::GetInputNode(node, 0);
+  if (shape_node == nullptr || shape_node->OpType() != "Shape") {
+    return false;
+  }
+
+  // the output of Shape is 1-D so the axis can only be 0 or -1
+  const auto* axis = graph_utils::GetNodeAttribute(node, "axis");
+  if (axis != nullptr && axis->i() != 0 && axis->i() != -1) {
+    return false;
+  }
+
+  const auto& indices_name = node.InputDefs()[1]->Name();
+  const auto* indices_proto = graph_utils::GetConstantInitializer(graph, indices_name, true);
+  if (indices_proto == nullptr || excluded_initializers.count(indices_name) > 0) {
+    return false;
+  }
+
+  int64_t start = 0;
+  int64_t end = 0;
+  const auto* shape = GetShapeNodeSlice(*shape_node, start, end);
+  if (shape == nullptr) {
+    return false;
+  }
+
+  Initializer indices{*indices_proto, graph.ModelPath()};
+  std::vector<int64_t> index_values;
+  if (indices.data_type() == ONNX_NAMESPACE::TensorProto_DataType_INT64) {
+    const int64_t* data = indices.data<int64_t>();
+    index_values.assign(data, data + indices.size());
+  } else if (indices.data_type() == ONNX_NAMESPACE::TensorProto_DataType_INT32) {
+    const int32_t* data = indices.data<int32_t>();
+    index_values.assign(data, data + indices.size());
   } else {
-    is_concrete_shape = false;
+    return false;
   }
 
-  if (is_concrete_shape) {
-    int64_t rank = static_cast<int64_t>(dim_values.size());
-
-    // We ascertain the "true" starts/ends (if they were provided)
-    // Opset-15 Shape op supports slicing shape values
-
-    // Deal with negatives and clamp
-    start = start < 0 ? start + rank : start;
-    start = start < 0 ? 0 : ((start > rank) ? rank : start);
-
-    end = end < 0 ? end + rank : end;
-    end = end < 0 ? 0 : ((end > rank) ? rank : end);
-
-    int64_t slice_length = end - start;
-    size_t clamped_slice_length = slice_length < 0 ? 0 : static_cast<size_t>(slice_length);
-
-    ONNX_NAMESPACE::TensorProto shape_constant;
-    auto* constant_arg_out = node.MutableOutputDefs()[0];
-    shape_constant.set_name(constant_arg_out->Name());
-    shape_constant.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_INT64);
-    shape_constant.add_dims(clamped_slice_length);
-    shape_constant.set_raw_data(dim_values.data() + start,
-                                clamped_slice_length * sizeof(int64_t));
-    ONNX_NAMESPACE::TensorShapeProto result_shape;
-    result_shape.add_dim()->set_dim_value(clamped_slice_length);
-    constant_arg_out->SetShape(result_shape);
-    graph.AddInitializedTensor(shape_constant);
+  const int64_t slice_length = end - start;
+  std::vector<int64_t> dim_values;
+  dim_values.reserve(index_values.size());
+  for (int64_t index : index_values) {
+    index = index < 0 ? index + slice_length : index;
+    if (index < 0 || index >= slice_length) {
+      return false;
+    }
+
+    const auto& dim = shape->dim(static_cast<int>(start + index));
+    if (!utils::HasDimValue(dim)) {
+      return false;
+    }
+
+    dim_values.push_back(dim.dim_value());
   }
 
-  return is_concrete_shape;  // convert to constant if this is true
+  AddInt64InitializerForOutput(graph, *node.MutableOutputDefs()[0],
+                               std::vector<int64_t>(indices_proto->dims().begin(), indices_proto->dims().end()),
+                               dim_values);
+  return true;
+}
+
+// Checks if the size of the output is known from its inferred shape, and is larger than the limit.
+static bool OutputIsKnownToExceedSize(const NodeArg& output, size_t max_size_in_bytes) {
+  const auto* type = output.TypeAsProto();
+  const auto* shape = output.Shape();
+  if (type == nullptr || shape == nullptr ||
+      !utils::HasTensorType(*type) || !utils::HasElemType(type->tensor_type())) {
+    return false;
+  }
+
+  // the size is negative if some dims are not known
+  const int64_t size = utils::GetTensorShapeFromTensorShapeProto(*shape).Size();
+  if (size < 0) {
+    return false;
+  }
+
+  const auto* element_type = DataTypeImpl::TensorTypeFromONNXEnum(type->tensor_type().elem_type())->GetElementType();
+  return static_cast<uint64_t>(size) * element_type->Size() > max_size_in_bytes;
 }
 
 Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
@@ -100,6 +195,57 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
   };
 #endif
 
+  // The values of the constant initializers and of the outputs of the folded nodes, by name.
+  // An initializer is deserialized once however many nodes consume it, and the outputs of a folded node are passed to
+  // the folded nodes consuming them in memory. Once all the nodes were visited, the outputs that are still consumed by
+  // other nodes become initializers, so a constant subgraph is folded without turning its intermediate values into
+  // initializers.
+  std::unordered_map<std::string, OrtValue> constant_values;
+
+  // The folded nodes in topological order. They are removed once all the nodes were visited.
+  std::vector<NodeIndex> folded_nodes;
+
+  const AllocatorPtr cpu_allocator = execution_provider_.GetAllocator(0, OrtMemTypeDefault);
+  const auto model_path = graph.ModelPath().ToPathString();
+
+  // Checks if all the inputs of the node are constant, and adds the values of the initializers among them to
+  // constant_values if they aren't there yet.
+  auto all_inputs_are_constant = [&](const Node& node, bool& is_constant) -> Status {
+    is_constant = false;
+    for (const auto* input_def : node.InputDefs()) {
+      const auto& name = input_def->Name();
+      if (constant_values.find(name) != constant_values.cend()) {
+        continue;
+      }
+
+      // Important note: when an initializer appears in the graph's input, this input will not be considered constant,
+      // because it can be overridden by the user at runtime. For constant folding to be applied, the initializer
+      // should not appear in the graph's inputs (that is the only way to guarantee it will always be constant).
+      if (graph_utils::GetConstantInitializer(graph, name, true) == nullptr ||
+          excluded_initializers_.find(name) != excluded_initializers_.cend()) {
+        return Status::OK();
+      }
+    }
+
+    for (const auto* input_def : node.InputDefs()) {
+      const auto& name = input_def->Name();
+      if (constant_values.find(name) != constant_values.cend()) {
+        continue;
+      }
+
+      const auto& initializer = *graph_utils::GetConstantInitializer(graph, name, true);
+      OrtValue value;
+      Tensor::InitOrtValue(DataTypeImpl::TensorTypeFromONNXEnum(initializer.data_type())->GetElementType(),
+                           TensorShape(utils::GetTensorShapeFromTensorProto(initializer)), cpu_allocator, value);
+      ORT_RETURN_IF_ERROR(utils::TensorProtoToTensor(Env::Default(), model_path.empty() ? nullptr : model_path.c_str(),
+                                                     initializer, *value.GetMutable<Tensor>()));
+      constant_values.emplace(name, std::move(value));
+    }
+
+    is_constant = true;
+    return Status::OK();
+  };
+
   for (NodeIndex i : order) {
     auto* node = graph.GetNode(i);
     if (!node) {
@@ -124,9 +270,10 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
     bool converted_to_constant = false;
     if (node->OpType().compare("Shape") == 0) {
       converted_to_constant = ConstantFoldShapeNode(graph, *node);
+    } else if (node->OpType().compare("Gather") == 0 &&
+               ConstantFoldGatherOfShapeNode(graph, *node, excluded_initializers_)) {
+      converted_to_constant = true;
     } else {
-      InitializedTensorSet constant_inputs;
-
       // we currently constant fold using the CPU EP only.
       // if the node is assigned to a different EP we can run it if it's an ONNX op as we have CPU based
       // implementations for all ONNX ops. If the node/op is from a different op domain or if the CPU implementation
@@ -144,17 +291,33 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
           // constant folding does not support executing a node that includes subgraphs (control flow operators,
           // such as If/Loop/Scan, fall into this category). individual nodes in the subgraph will be processed
           // by the Recurse call above
-          node->ContainsSubgraph() || !graph_utils::AllNodeInputsAreConstant(graph, *node, constant_inputs, excluded_initializers_)) {
+          node->ContainsSubgraph()) {
+        continue;
+      }
+
+      bool inputs_are_constant = false;
+      ORT_RETURN_IF_ERROR(all_inputs_are_constant(*node, inputs_are_constant));
+      if (!inputs_are_constant) {
+        continue;
+      }
+
+      // don't compute outputs that are known to be too large to fold from their inferred shapes
+      if (max_output_size_in_bytes_ > 0 &&
+          std::any_of(node->OutputDefs().cbegin(), node->OutputDefs().cend(), [this](const NodeArg* output) {
+            return OutputIsKnownToExceedSize(*output, max_output_size_in_bytes_);
+          })) {
+        LOGS(logger, VERBOSE) << "Not constant folding " << node->OpType() << " node '" << node->Name()
+                              << "' as an output is larger than " << max_output_size_in_bytes_ << " bytes";
         continue;
       }
 
 #if !defined(DISABLE_SPARSE_TENSORS)
       // Create execution frame for executing constant nodes.
-      OptimizerExecutionFrame::Info info({node}, constant_inputs, graph.ModelPath(), execution_provider_,
+      OptimizerExecutionFrame::Info info({node}, constant_values, graph.ModelPath(), execution_provider_,
                                          is_sparse_initializer_check);
 #else
       // Create execution frame for executing constant nodes.
-      OptimizerExecutionFrame::Info info({node}, constant_inputs, graph.ModelPath(), execution_provider_,
+      OptimizerExecutionFrame::Info info({node}, constant_values, graph.ModelPath(), execution_provider_,
                                          [](std::string const&) { return false; });
 #endif
 
@@ -191,28 +354,31 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
       std::vector<OrtValue> fetches;
       ORT_RETURN_IF_ERROR(frame.GetOutputs(fetches));
 
-      // Go over all output node args and substitute them with the newly computed tensors, which will be
-      // added to the graph as initializers.
+      // The outputs of the node will be replaced by the computed tensors.
       ORT_ENFORCE(fetches.size() == node->OutputDefs().size());
-      converted_to_constant = true;
+      bool can_fold = true;
       for (size_t fetch_idx = 0; fetch_idx < fetches.size(); ++fetch_idx) {
         OrtValue& ort_value = fetches[fetch_idx];
         // XXX: Add support for SparseTensors outputs when we have sparse outputs
         if (!ort_value.IsTensor()) {
           LOGS(logger, WARNING) << "Unsupported output type of " << ort_value.Type()
                                 << ". Can't constant fold " << node->OpType() << " node '" << node->Name() << "'";
-          converted_to_constant = false;
+          can_fold = false;
+          break;
+        }
+
+        if (max_output_size_in_bytes_ > 0 && ort_value.Get<Tensor>().SizeInBytes() > max_output_size_in_bytes_) {
+          LOGS(logger, VERBOSE) << "Not constant folding " << node->OpType() << " node '" << node->Name()
+                                << "' as an output is larger than " << max_output_size_in_bytes_ << " bytes";
+          can_fold = false;
           break;
         }
       }
 
-      if (converted_to_constant) {
+      if (can_fold) {
         for (size_t fetch_idx = 0; fetch_idx < fetches.size(); ++fetch_idx) {
-          OrtValue& ort_value = fetches[fetch_idx];
-          // Build the TensorProto that corresponds to the computed OrtValue and add it as initializer to the graph.
           auto* constant_arg_out = node->MutableOutputDefs()[fetch_idx];
-          const Tensor& out_tensor = ort_value.Get<Tensor>();
-          ONNX_NAMESPACE::TensorProto out_tensorproto = utils::TensorToTensorProto(out_tensor, constant_arg_out->Name());
+          const Tensor& out_tensor = fetches[fetch_idx].Get<Tensor>();
 
           ONNX_NAMESPACE::TensorShapeProto result_shape;
           for (auto& dim : out_tensor.Shape().GetDims()) {
@@ -220,8 +386,11 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
           }
 
           constant_arg_out->SetShape(result_shape);
-          graph.AddInitializedTensor(out_tensorproto);
+          constant_values[constant_arg_out->Name()] = fetches[fetch_idx];
         }
+
+        folded_nodes.push_back(node->Index());
+        have_updated_nodes = true;
       }
     }
 
@@ -245,6 +414,41 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
     }
   }
 
+  // Replace the outputs of the folded nodes that are consumed by the remaining nodes, or are graph outputs, with
+  // initializers, and remove the folded nodes. As they are visited in reverse topological order, the folded nodes
+  // consuming the outputs of a folded node were already removed when it is reached.
+  for (auto folded_node = folded_nodes.crbegin(), end = folded_nodes.crend(); folded_node != end; ++folded_node) {
+    auto* node = graph.GetNode(*folded_node);
+    // the node may have been removed with the inputs of a folded Shape node
+    if (!node) {
+      continue;
+    }
+
+    for (size_t output_idx = 0, num_outputs = node->OutputDefs().size(); output_idx < num_outputs; ++output_idx) {
+      const auto* output_def = node->OutputDefs()[output_idx];
+      if (!output_def->Exists()) {
+        continue;
+      }
+
+      bool is_consumed = graph.IsOutput(output_def);
+      for (auto edge = node->OutputEdgesBegin(), edge_end = node->OutputEdgesEnd();
+           !is_consumed && edge != edge_end; ++edge) {
+        is_consumed = static_cast<size_t>(edge->GetSrcArgIndex()) == output_idx;
+      }
+
+      if (is_consumed) {
+        // Build the TensorProto that corresponds to the computed OrtValue and add it as initializer to the graph.
+        const Tensor& out_tensor = constant_values.at(output_def->Name()).Get<Tensor>();
+        graph.AddInitializedTensor(utils::TensorToTensorProto(out_tensor, output_def->Name()));
+      }
+    }
+
+    // Remove the output edges of the constant node and then remove the node itself.
+    graph_utils::RemoveNodeOutputEdges(graph, *node);
+    graph.RemoveNode(node->Index());
+    modified = true;
+  }
+
   return Status::OK();
 }
 }  // namespace onnxruntime
@@ -15,17 +15,24 @@ namespace onnxruntime {
 
 Transformer that traverses the graph top-down and performs constant folding, i.e.,
 it statically computes parts of the graph that rely only on constant initializers.
+The values computed for a constant subgraph are passed between its nodes in memory, and only the values that are
+consumed by the rest of the graph are turned into initializers.
+Shape nodes, and Gather nodes selecting dims from their output, are folded when the dims they produce are known,
+even if other dims of the shape are symbolic.
 */
 class ConstantFolding : public GraphTransformer {
  public:
   /*! Constant folding will not be applied to nodes that have one of initializers from excluded_initializers as input.
       For pre-training, the trainable weights are those initializers to be excluded.
       \param execution_provider Execution provider instance to execute constant folding.
+      \param max_output_size_in_bytes Constant folding will not be applied to nodes with an output larger than this,
+      so that the folded initializers don't grow the model too much. 0 means no limit.
   */
   ConstantFolding(const IExecutionProvider& execution_provider,
                   bool skip_dequantize_linear,
                   const std::unordered_set<std::string>& compatible_execution_providers = {},
-                  const std::unordered_set<std::string>& excluded_initializers = {}) noexcept;
+                  const std::unordered_set<std::string>& excluded_initializers = {},
+                  size_t max_output_size_in_bytes = 0) noexcept;
 
  private:
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
@@ -33,6 +40,7 @@ class ConstantFolding : public GraphTransformer {
   bool skip_dequantize_linear_;
   const std::unordered_set<std::string> excluded_initializers_;
   const IExecutionProvider& execution_provider_;
+  const size_t max_output_size_in_bytes_;
 };
 
 }  // namespace onnxruntime
@@ -80,7 +80,7 @@ Status ConvAddFusion::Apply(Graph& graph, Node& node, RewriteRuleEffect& modifie
     new_conv_B_tensor_proto.set_name(new_name);
 
     NodeArg& new_conv_B_node_arg = graph_utils::AddInitializer(graph, new_conv_B_tensor_proto);
-    graph_utils::ReplaceNodeInput(node, 2, new_conv_B_node_arg);
+    graph_utils::ReplaceNodeInput(graph, node, 2, new_conv_B_node_arg);
 
   } else {
     // Create new tensor proto and update shape
@@ -93,7 +93,7 @@ Status ConvAddFusion::Apply(Graph& graph, Node& node, RewriteRuleEffect& modifie
     new_conv_B_tensor_proto.set_name(new_name);
 
     NodeArg& new_add_B_node_arg = graph_utils::AddInitializer(graph, new_conv_B_tensor_proto);
-    graph_utils::AddNodeInput(node, 2, new_add_B_node_arg);
+    graph_utils::AddNodeInput(graph, node, 2, new_add_B_node_arg);
   }
 
   // move the output definition and edges from the add_node to the conv_node and delete the add_node
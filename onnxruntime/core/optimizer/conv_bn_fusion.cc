@@ -121,14 +121,14 @@ Status ConvBNFusion::Apply(Graph& graph, Node& node, RewriteRuleEffect& rule_eff
   new_conv_B_tensor_proto.set_name(new_B_name);
 
   NodeArg& new_conv_W_node_arg = graph_utils::AddInitializer(graph, new_conv_W_tensor_proto);
-  graph_utils::ReplaceNodeInput(node, 1, new_conv_W_node_arg);
+  graph_utils::ReplaceNodeInput(graph, node, 1, new_conv_W_node_arg);
 
   auto& new_conv_B_node_arg = graph_utils::AddInitializer(graph, new_conv_B_tensor_proto);
 
   if (conv_inputs.size() == 3) {
-    graph_utils::ReplaceNodeInput(node, 2, new_conv_B_node_arg);
+    graph_utils::ReplaceNodeInput(graph, node, 2, new_conv_B_node_arg);
   } else {
-    graph_utils::AddNodeInput(node, 2, new_conv_B_node_arg);
+    graph_utils::AddNodeInput(graph, node, 2, new_conv_B_node_arg);
   }
 
   // trim off any output defs that are optional in the bn_node before we finalize fusion, as we copy the '
@@ -91,7 +91,7 @@ Status ConvMulFusion::Apply(Graph& graph, Node& node, RewriteRuleEffect& rule_ef
 
   // Replace initializers of conv node
   NodeArg& new_conv_W_node_arg = graph_utils::AddInitializer(graph, new_conv_W_tensor_proto);
-  graph_utils::ReplaceNodeInput(conv_node, 1, new_conv_W_node_arg);
+  graph_utils::ReplaceNodeInput(graph, conv_node, 1, new_conv_W_node_arg);
 
   if (is_3d) {
     ONNX_NAMESPACE::TensorProto new_conv_B_tensor_proto(*conv_B_tensor_proto);
@@ -101,7 +101,7 @@ Status ConvMulFusion::Apply(Graph& graph, Node& node, RewriteRuleEffect& rule_ef
     new_conv_B_tensor_proto.set_name(new_B_name);
 
     NodeArg& new_conv_B_node_arg = graph_utils::AddInitializer(graph, new_conv_B_tensor_proto);
-    graph_utils::ReplaceNodeInput(conv_node, 2, new_conv_B_node_arg);
+    graph_utils::ReplaceNodeInput(graph, conv_node, 2, new_conv_B_node_arg);
   }
 
   // Move output name and edges from Mul node to Conv node and remove Mul node.
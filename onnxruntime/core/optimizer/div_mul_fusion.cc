@@ -90,7 +90,7 @@ Status DivMulFusion::Apply(Graph& graph, Node& node, RewriteRuleEffect& rule_eff
   //get other input of mul
   auto& mul_other_input = mul_inputs[0] == div_output[0] ? mul_inputs[1] : mul_inputs[0];
 
-  graph_utils::ReplaceNodeInput(div_node, 0, *mul_other_input);
+  graph_utils::ReplaceNodeInput(graph, div_node, 0, *mul_other_input);
   // move the output definition and edges from the mul_node to the div_node and delete the mul_node
   graph_utils::FinalizeNodeFusion(graph, div_node, mul_node);
 
@@ -3,6 +3,8 @@
 
 #include "core/optimizer/graph_transformer.h"
 
+#include <atomic>
+
 using namespace ::onnxruntime::common;
 
 namespace onnxruntime {
@@ -11,9 +13,23 @@ Status GraphTransformer::Apply(Graph& graph, bool& modified, const logging::Logg
   // the Graph should be in a good state prior this being called, so there should be no need to call Resolve here
   // ORT_RETURN_IF_ERROR(graph.Resolve());
 
+  // nothing to do if the graph is the same as when this transformer was last applied to it
+  const uint64_t stamp = graph.ModificationStamp();
+  uint64_t last_stamp = 0;
+  if (graph.TryGetVisitStamp(Id(), last_stamp) && last_stamp == stamp) {
+    return Status::OK();
+  }
+
   auto status = ApplyImpl(graph, modified, 0, logger);
   ORT_RETURN_IF_ERROR(status);
 
+  // the changes made in ways the graph doesn't track may affect any node
+  if (modified && graph.ModificationStamp() == stamp) {
+    graph.MarkAllNodesModified();
+  }
+
+  graph.SetVisitStamp(Id(), stamp);
+
 #if !defined(ORT_MINIMAL_BUILD)
   // At least currently, some transformers (InsertCastTransformer and MemcpyTransformer) need this to be called
   // after they complete to put the graph back into a valid state for the next transformer.
@@ -25,4 +41,9 @@ Status GraphTransformer::Apply(Graph& graph, bool& modified, const logging::Logg
   return status;
 }
 
+uint64_t GraphTransformer::NextId() {
+  static std::atomic<uint64_t> next_id{0};
+  return next_id++;
+}
+
 }  // namespace onnxruntime
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/optimizer/graph_transformer_utils.h"
+#include "core/common/parse_string.h"
 
 #include "core/mlas/inc/mlas.h"
 #include "core/optimizer/attention_fusion.h"
@@ -39,6 +40,7 @@
 #include "core/optimizer/rule_based_graph_transformer.h"
 #include "core/optimizer/skip_layer_norm_fusion.h"
 #include "core/optimizer/slice_elimination.h"
+#include "core/optimizer/transpose_sinking.h"
 #include "core/optimizer/unsqueeze_elimination.h"
 #include "core/optimizer/qdq_transformer/qdq_propagation.h"
 #include "core/optimizer/qdq_transformer/qdq_s8_to_u8.h"
@@ -142,9 +144,19 @@ std::vector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
     case TransformerLevel::Level1: {
       // no filtering on execution provider for L1 optimizations as they only use official ONNX operators
       transformers.emplace_back(std::make_unique<CommonSubexpressionElimination>());
-      transformers.emplace_back(std::make_unique<ConstantFolding>(execution_provider, !disable_quant_qdq));
+      size_t constant_folding_max_output_size = 0;
+      ORT_ENFORCE(TryParseStringWithClassicLocale(
+                      session_options.config_options.GetConfigOrDefault(
+                          kOrtSessionOptionsConstantFoldingMaxOutputSize, "0"),
+                      constant_folding_max_output_size),
+                  "Invalid value for ", kOrtSessionOptionsConstantFoldingMaxOutputSize);
+      transformers.emplace_back(std::make_unique<ConstantFolding>(execution_provider, !disable_quant_qdq,
+                                                                  std::unordered_set<std::string>{},
+                                                                  std::unordered_set<std::string>{},
+                                                                  constant_folding_max_output_size));
       transformers.emplace_back(std::make_unique<MatMulAddFusion>());
       transformers.emplace_back(std::make_unique<ReshapeFusion>());
+      transformers.emplace_back(std::make_unique<TransposeSinking>());
       transformers.emplace_back(std::make_unique<FreeDimensionOverrideTransformer>(
           session_options.free_dimension_overrides));
 
@@ -18,6 +18,14 @@ Status Initializer::ReadExternalRawData(
           tensor_proto.data_type() != ONNX_NAMESPACE::TensorProto_DataType_STRING,
       "External data type must not be UNDEFINED or STRING.");
 
+  const void* data_in_memory = nullptr;
+  size_t data_in_memory_length = 0;
+  if (utils::GetExternalDataInMemory(tensor_proto, data_in_memory, data_in_memory_length)) {
+    const auto* data_begin = static_cast<const char*>(data_in_memory);
+    raw_data.assign(data_begin, data_begin + data_in_memory_length);
+    return Status::OK();
+  }
+
   ORT_RETURN_IF(
       model_path.IsEmpty(),
       "model_path must not be empty. Ensure that a path is provided when the model is created or loaded.");
@@ -289,7 +289,7 @@ class RemoveDuplicateCastTransformer : public GraphTransformer {
 
                 // replace the input of the downstream nodes with the initializer
                 Node& mutable_target = *graph.GetNode(edge->GetNode().Index());
-                graph_utils::ReplaceNodeInput(mutable_target, dst_idx, input);
+                graph_utils::ReplaceNodeInput(graph, mutable_target, dst_idx, input);
               }
 
               graph.RemoveNode(node_idx);
@@ -98,7 +98,7 @@ Status NotWhereFusion::Apply(Graph& graph, Node& node, RewriteRuleEffect& rule_e
     std::vector<NodeArg*> where_inputs = where_node.MutableInputDefs();
 
     if (!not_input_node) { // not's input is graph input/initializer.
-      graph_utils::ReplaceNodeInput(where_node, 0, *not_input);
+      graph_utils::ReplaceNodeInput(graph, where_node, 0, *not_input);
     }
 
     const Node* where_input1_node = graph_utils::GetInputNode(where_node, 1);
@@ -115,8 +115,8 @@ Status NotWhereFusion::Apply(Graph& graph, Node& node, RewriteRuleEffect& rule_e
       graph.RemoveEdge(where_input2_node->Index(), where_node.Index(), output2_idx, 2);
     }
 
-    graph_utils::ReplaceNodeInput(where_node, 1, *where_inputs[2]);
-    graph_utils::ReplaceNodeInput(where_node, 2, *where_inputs[1]);
+    graph_utils::ReplaceNodeInput(graph, where_node, 1, *where_inputs[2]);
+    graph_utils::ReplaceNodeInput(graph, where_node, 2, *where_inputs[1]);
 
     if (where_input1_node) {
       graph.AddEdge(where_input1_node->Index(), where_node.Index(), output1_idx, 2);
@@ -40,10 +40,31 @@ Status RuleBasedGraphTransformer::ApplyRulesOnNode(Graph& graph, Node& node,
 }
 
 Status RuleBasedGraphTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  // If the rules were applied to this graph before, a rule can only match a node now if the node or one of its
+  // neighbors was modified since then, as the rules look at the node and its direct producers and consumers.
+  // The other nodes are skipped. Changes to a subgraph mark the node containing it as modified.
+  const uint64_t stamp = graph.ModificationStamp();
+  uint64_t last_stamp = 0;
+  const bool incremental = graph.TryGetVisitStamp(Id(), last_stamp);
+  graph.SetVisitStamp(Id(), stamp);
+
+  std::unordered_set<NodeIndex> affected_nodes;
+  if (incremental) {
+    affected_nodes = graph.GetNodesAffectedSince(last_stamp);
+    if (affected_nodes.empty()) {
+      return Status::OK();
+    }
+  }
+
   GraphViewer graph_viewer(graph);
   auto& order = graph_viewer.GetNodesInTopologicalOrder();
+  bool graph_modified = false;
 
   for (NodeIndex i : order) {
+    if (incremental && affected_nodes.count(i) == 0) {
+      continue;
+    }
+
     auto* node = graph.GetNode(i);
     // A node might not be found as it might have already been deleted from one of the rules.
     if (!node) {
@@ -78,6 +99,7 @@ Status RuleBasedGraphTransformer::ApplyImpl(Graph& graph, bool& modified, int gr
     // Update the modified field of the rule-based transformer.
     if (rule_effect != RuleEffect::kNone) {
       modified = true;
+      graph_modified = true;
     }
 
     if (rule_effect != RuleEffect::kRemovedCurrentNode) {
@@ -85,6 +107,11 @@ Status RuleBasedGraphTransformer::ApplyImpl(Graph& graph, bool& modified, int gr
     }
   }
 
+  // the changes made by a rule in ways the graph doesn't track may affect any node
+  if (graph_modified && graph.ModificationStamp() == stamp) {
+    graph.MarkAllNodesModified();
+  }
+
   return Status::OK();
 }
 
@@ -0,0 +1,556 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/transpose_sinking.h"
+
+#include <algorithm>
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+namespace onnxruntime {
+
+namespace {
+
+// How the layout dependent parts of a node are updated when a Transpose is pushed through it.
+enum class SinkKind {
+  Unary,      // input 0 is transposed, other inputs are layout independent (e.g. Clip min/max)
+  Broadcast,  // all inputs are transposed, with numpy style broadcasting
+  Concat,     // all inputs are transposed, 'axis' attribute
+  Reduce,     // input 0 is transposed, 'axes' and 'keepdims' attributes
+  Pad,        // input 0 is transposed, 'pads' attribute or input
+  Slice,      // input 0 is transposed, 'axes' input
+};
+
+const std::unordered_map<std::string, SinkKind>& SinkableOps() {
+  static const std::unordered_map<std::string, SinkKind> sinkable_ops = {
+      {"Abs", SinkKind::Unary},
+      {"Acos", SinkKind::Unary},
+      {"Acosh", SinkKind::Unary},
+      {"Asin", SinkKind::Unary},
+      {"Asinh", SinkKind::Unary},
+      {"Atan", SinkKind::Unary},
+      {"Atanh", SinkKind::Unary},
+      {"Cast", SinkKind::Unary},
+      {"Ceil", SinkKind::Unary},
+      {"Clip", SinkKind::Unary},
+      {"Cos", SinkKind::Unary},
+      {"Cosh", SinkKind::Unary},
+      {"Elu", SinkKind::Unary},
+      {"Erf", SinkKind::Unary},
+      {"Exp", SinkKind::Unary},
+      {"Floor", SinkKind::Unary},
+      {"HardSigmoid", SinkKind::Unary},
+      {"HardSwish", SinkKind::Unary},
+      {"Identity", SinkKind::Unary},
+      {"IsInf", SinkKind::Unary},
+      {"IsNaN", SinkKind::Unary},
+      {"LeakyRelu", SinkKind::Unary},
+      {"Log", SinkKind::Unary},
+      {"Neg", SinkKind::Unary},
+      {"Not", SinkKind::Unary},
+      {"Reciprocal", SinkKind::Unary},
+      {"Relu", SinkKind::Unary},
+      {"Round", SinkKind::Unary},
+      {"Selu", SinkKind::Unary},
+      {"Sigmoid", SinkKind::Unary},
+      {"Sign", SinkKind::Unary},
+      {"Sin", SinkKind::Unary},
+      {"Sinh", SinkKind::Unary},
+      {"Softplus", SinkKind::Unary},
+      {"Softsign", SinkKind::Unary},
+      {"Sqrt", SinkKind::Unary},
+      {"Tan", SinkKind::Unary},
+      {"Tanh", SinkKind::Unary},
+      {"ThresholdedRelu", SinkKind::Unary},
+      {"Add", SinkKind::Broadcast},
+      {"And", SinkKind::Broadcast},
+      {"Div", SinkKind::Broadcast},
+      {"Equal", SinkKind::Broadcast},
+      {"Greater", SinkKind::Broadcast},
+      {"GreaterOrEqual", SinkKind::Broadcast},
+      {"Less", SinkKind::Broadcast},
+      {"LessOrEqual", SinkKind::Broadcast},
+      {"Max", SinkKind::Broadcast},
+      {"Mean", SinkKind::Broadcast},
+      {"Min", SinkKind::Broadcast},
+      {"Mod", SinkKind::Broadcast},
+      {"Mul", SinkKind::Broadcast},
+      {"Or", SinkKind::Broadcast},
+      {"Pow", SinkKind::Broadcast},
+      {"PRelu", SinkKind::Broadcast},
+      {"Sub", SinkKind::Broadcast},
+      {"Sum", SinkKind::Broadcast},
+      {"Where", SinkKind::Broadcast},
+      {"Xor", SinkKind::Broadcast},
+      {"Concat", SinkKind::Concat},
+      {"ReduceL1", SinkKind::Reduce},
+      {"ReduceL2", SinkKind::Reduce},
+      {"ReduceLogSum", SinkKind::Reduce},
+      {"ReduceLogSumExp", SinkKind::Reduce},
+      {"ReduceMax", SinkKind::Reduce},
+      {"ReduceMean", SinkKind::Reduce},
+      {"ReduceMin", SinkKind::Reduce},
+      {"ReduceProd", SinkKind::Reduce},
+      {"ReduceSum", SinkKind::Reduce},
+      {"ReduceSumSquare", SinkKind::Reduce},
+      {"Pad", SinkKind::Pad},
+      {"Slice", SinkKind::Slice},
+  };
+  return sinkable_ops;
+}
+
+bool IsTranspose(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Transpose", {1, 13});
+}
+
+// The perm of a Transpose. A missing perm reverses the dims, which needs the rank, so it isn't handled.
+bool GetPerm(const Node& transpose, std::vector<int64_t>& perm) {
+  if (!graph_utils::GetRepeatedNodeAttributeValues(transpose, "perm", perm) || perm.empty()) {
+    return false;
+  }
+
+  std::vector<bool> seen(perm.size(), false);
+  for (int64_t p : perm) {
+    if (p < 0 || p >= static_cast<int64_t>(perm.size()) || seen[static_cast<size_t>(p)]) {
+      return false;
+    }
+    seen[static_cast<size_t>(p)] = true;
+  }
+  return true;
+}
+
+std::vector<int64_t> InvertPerm(const std::vector<int64_t>& perm) {
+  std::vector<int64_t> inverse(perm.size());
+  for (size_t i = 0; i < perm.size(); ++i) {
+    inverse[static_cast<size_t>(perm[i])] = static_cast<int64_t>(i);
+  }
+  return inverse;
+}
+
+bool IsIdentityPerm(const std::vector<int64_t>& perm) {
+  for (size_t i = 0; i < perm.size(); ++i) {
+    if (perm[i] != static_cast<int64_t>(i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool NormalizeAxis(int64_t& axis, int64_t rank) {
+  if (axis < 0) {
+    axis += rank;
+  }
+  return axis >= 0 && axis < rank;
+}
+
+// Returns the Transpose with the given perm producing input 'input_index' of 'node', if 'node' is its only consumer.
+Node* GetSinkableTranspose(Graph& graph, const Node& node, int input_index, const std::vector<int64_t>& perm) {
+  const Node* input_node = graph_utils::GetInputNode(node, input_index);
+  if (input_node == nullptr || !IsTranspose(*input_node) ||
+      !optimizer_utils::CheckOutputEdges(graph, *input_node, 1)) {
+    return nullptr;
+  }
+
+  std::vector<int64_t> input_perm;
+  if (!GetPerm(*input_node, input_perm) || input_perm != perm) {
+    return nullptr;
+  }
+
+  return graph.GetNode(input_node->Index());
+}
+
+// Makes 'node' consume the input of 'transpose' instead of its output at 'input_index'.
+void BypassTranspose(Graph& graph, Node& node, int input_index, Node& transpose) {
+  graph.RemoveEdge(transpose.Index(), node.Index(), 0, input_index);
+  node.MutableInputDefs()[input_index] = transpose.MutableInputDefs()[0];
+
+  const Node::EdgeEnd* input_edge = graph_utils::GetInputEdge(transpose, 0);
+  if (input_edge != nullptr) {
+    const NodeIndex producer = input_edge->GetNode().Index();
+    const int producer_output_index = input_edge->GetSrcArgIndex();
+    graph.RemoveEdge(producer, transpose.Index(), producer_output_index, 0);
+    graph.AddEdge(producer, node.Index(), producer_output_index, input_index);
+  }
+}
+
+// Adds a 1-D initializer for the new axes or pads of a node.
+NodeArg& AddIndicesInitializer(Graph& graph, const std::string& base_name, const std::vector<int64_t>& values,
+                               TensorProto_DataType data_type) {
+  TensorProto tensor_proto;
+  tensor_proto.set_name(graph.GenerateNodeArgName(base_name));
+  tensor_proto.set_data_type(data_type);
+  tensor_proto.add_dims(static_cast<int64_t>(values.size()));
+  if (data_type == TensorProto_DataType_INT32) {
+    std::vector<int32_t> values_32;
+    values_32.reserve(values.size());
+    for (int64_t value : values) {
+      values_32.push_back(static_cast<int32_t>(value));
+    }
+    tensor_proto.set_raw_data(values_32.data(), values_32.size() * sizeof(int32_t));
+  } else {
+    tensor_proto.set_raw_data(values.data(), values.size() * sizeof(int64_t));
+  }
+
+  return graph_utils::AddInitializer(graph, tensor_proto);
+}
+
+// A constant input of a node a Transpose is pushed through, which needs to be transposed the other way.
+struct ConstantInput {
+  int input_index;
+  const TensorProto* tensor_proto;
+};
+
+// Pushes 'transpose' down through its only consumer 'node', reusing it as the Transpose of the output of 'node'.
+// Returns false, leaving the graph unchanged, if 'node' isn't supported.
+bool SinkTranspose(Graph& graph, Node& transpose, Node& node, const std::vector<int64_t>& perm) {
+  const auto sinkable_op = SinkableOps().find(node.OpType());
+  if (sinkable_op == SinkableOps().end() || !graph_utils::MatchesOpSetDomain(node, kOnnxDomain) ||
+      node.OutputDefs().size() != 1 || transpose.OutputEdgesBegin()->GetSrcArgIndex() != 0) {
+    return false;
+  }
+
+  const SinkKind kind = sinkable_op->second;
+  const int transposed_input = transpose.OutputEdgesBegin()->GetDstArgIndex();
+  const int64_t rank = static_cast<int64_t>(perm.size());
+  const auto& input_defs = node.InputDefs();
+  const bool all_inputs_transposed = kind == SinkKind::Broadcast || kind == SinkKind::Concat;
+
+  if (!all_inputs_transposed && transposed_input != 0) {
+    return false;
+  }
+
+  // check every layout dependent input before changing anything
+  std::vector<std::pair<int, Node*>> transposed_inputs;
+  std::vector<ConstantInput> constant_inputs;
+  const int num_layout_inputs = all_inputs_transposed ? static_cast<int>(input_defs.size()) : 1;
+  for (int i = 0; i < num_layout_inputs; ++i) {
+    if (!input_defs[i]->Exists()) {
+      continue;
+    }
+
+    if (i == transposed_input) {
+      transposed_inputs.emplace_back(i, &transpose);
+      continue;
+    }
+
+    Node* input_transpose = GetSinkableTranspose(graph, node, i, perm);
+    if (input_transpose != nullptr) {
+      transposed_inputs.emplace_back(i, input_transpose);
+      continue;
+    }
+
+    const TensorProto* tensor_proto = graph_utils::GetConstantInitializer(graph, input_defs[i]->Name());
+    if (tensor_proto == nullptr || tensor_proto->dims_size() > rank ||
+        (kind == SinkKind::Concat && tensor_proto->dims_size() != rank)) {
+      return false;
+    }
+
+    // a constant that broadcasts to the same value everywhere doesn't depend on the layout
+    const bool is_scalar = std::all_of(tensor_proto->dims().begin(), tensor_proto->dims().end(),
+                                       [](int64_t dim) { return dim == 1; });
+    if (!is_scalar || kind == SinkKind::Concat) {
+      constant_inputs.push_back({i, tensor_proto});
+    }
+  }
+
+  // the layout dependent attributes and inputs for the untransposed input, and the perm of the output
+  std::vector<int64_t> output_perm = perm;
+  std::vector<int64_t> new_values;
+  TensorProto_DataType new_values_type = TensorProto_DataType_INT64;
+
+  switch (kind) {
+    case SinkKind::Unary:
+    case SinkKind::Broadcast:
+      break;
+
+    case SinkKind::Concat: {
+      const auto* axis_attr = graph_utils::GetNodeAttribute(node, "axis");
+      if (axis_attr == nullptr || !utils::HasInt(*axis_attr)) {
+        return false;
+      }
+      int64_t axis = axis_attr->i();
+      if (!NormalizeAxis(axis, rank)) {
+        return false;
+      }
+      new_values = {perm[static_cast<size_t>(axis)]};
+      break;
+    }
+
+    case SinkKind::Reduce: {
+      // ReduceSum from opset 13 takes the axes as an input
+      std::vector<int64_t> axes;
+      if (input_defs.size() != 1 || !graph_utils::GetRepeatedNodeAttributeValues(node, "axes", axes) ||
+          axes.empty()) {
+        return false;
+      }
+
+      std::vector<bool> reduced(static_cast<size_t>(rank), false);
+      for (int64_t axis : axes) {
+        if (!NormalizeAxis(axis, rank)) {
+          return false;
+        }
+        reduced[static_cast<size_t>(axis)] = true;
+      }
+
+      std::vector<bool> new_reduced(static_cast<size_t>(rank), false);
+      for (int64_t i = 0; i < rank; ++i) {
+        if (reduced[static_cast<size_t>(i)]) {
+          new_values.push_back(perm[static_cast<size_t>(i)]);
+          new_reduced[static_cast<size_t>(perm[static_cast<size_t>(i)])] = true;
+        }
+      }
+      std::sort(new_values.begin(), new_values.end());
+
+      const auto* keepdims_attr = graph_utils::GetNodeAttribute(node, "keepdims");
+      if (keepdims_attr != nullptr && utils::HasInt(*keepdims_attr) && keepdims_attr->i() == 0) {
+        // the reduced dims are dropped, so the output perm only covers the remaining dims, renumbered.
+        output_perm.clear();
+        for (int64_t i = 0; i < rank; ++i) {
+          if (!reduced[static_cast<size_t>(i)]) {
+            const int64_t source = perm[static_cast<size_t>(i)];
+            output_perm.push_back(source - std::count(new_reduced.begin(), new_reduced.begin() + source, true));
+          }
+        }
+        if (output_perm.empty()) {
+          return false;
+        }
+      }
+      break;
+    }
+
+    case SinkKind::Pad: {
+      std::vector<int64_t> pads;
+      if (node.SinceVersion() < 11) {
+        if (!graph_utils::GetRepeatedNodeAttributeValues(node, "pads", pads)) {
+          return false;
+        }
+      } else if (input_defs.size() < 2 || !optimizer_utils::AppendTensorFromInitializer(graph, *input_defs[1], pads)) {
+        return false;
+      }
+
+      if (static_cast<int64_t>(pads.size()) != 2 * rank) {
+        return false;
+      }
+
+      new_values.resize(pads.size());
+      for (size_t i = 0; i < perm.size(); ++i) {
+        new_values[static_cast<size_t>(perm[i])] = pads[i];
+        new_values[static_cast<size_t>(perm[i] + rank)] = pads[i + perm.size()];
+      }
+      break;
+    }
+
+    case SinkKind::Slice: {
+      // Slice from opset 10 takes the axes as an optional input. without it the axes are the leading dims.
+      if (node.SinceVersion() < 10 || input_defs.size() < 4 || !input_defs[3]->Exists()) {
+        return false;
+      }
+
+      std::vector<int64_t> axes;
+      const TensorProto* axes_proto = graph_utils::GetConstantInitializer(graph, input_defs[3]->Name());
+      if (axes_proto == nullptr || !optimizer_utils::AppendTensorFromInitializer(graph, *input_defs[3], axes)) {
+        return false;
+      }
+
+      for (int64_t axis : axes) {
+        if (!NormalizeAxis(axis, rank)) {
+          return false;
+        }
+        new_values.push_back(perm[static_cast<size_t>(axis)]);
+      }
+      new_values_type = static_cast<TensorProto_DataType>(axes_proto->data_type());
+      break;
+    }
+  }
+
+  // move the Transposes of the inputs to the output
+  for (const auto& transposed : transposed_inputs) {
+    Node& input_transpose = *transposed.second;
+    BypassTranspose(graph, node, transposed.first, input_transpose);
+    if (&input_transpose != &transpose) {
+      graph.RemoveNode(input_transpose.Index());
+    }
+  }
+
+  const std::vector<int64_t> inverse_perm = InvertPerm(perm);
+  for (const auto& constant : constant_inputs) {
+    NodeArg* constant_arg = node.MutableInputDefs()[constant.input_index];
+
+    // broadcasting aligns the trailing dims, so add the leading dims of size 1 the Transpose needs
+    if (constant.tensor_proto->dims_size() < rank) {
+      TensorProto expanded(*constant.tensor_proto);
+      expanded.set_name(graph.GenerateNodeArgName(constant_arg->Name()));
+      expanded.clear_dims();
+      for (int64_t i = constant.tensor_proto->dims_size(); i < rank; ++i) {
+        expanded.add_dims(1);
+      }
+      for (int64_t dim : constant.tensor_proto->dims()) {
+        expanded.add_dims(dim);
+      }
+      constant_arg = &graph_utils::AddInitializer(graph, expanded);
+    }
+
+    NodeArg& transposed_arg = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(constant_arg->Name()), nullptr);
+    Node& constant_transpose = graph.AddNode(graph.GenerateNodeName(transpose.Name()),
+                                             "Transpose",
+                                             "Transpose of a constant input for TransposeSinking",
+                                             {constant_arg},
+                                             {&transposed_arg});
+    constant_transpose.AddAttribute("perm", inverse_perm);
+    constant_transpose.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    node.MutableInputDefs()[constant.input_index] = &transposed_arg;
+    graph.AddEdge(constant_transpose.Index(), node.Index(), 0, constant.input_index);
+  }
+
+  switch (kind) {
+    case SinkKind::Concat:
+      node.AddAttribute("axis", new_values[0]);
+      break;
+    case SinkKind::Reduce:
+      node.AddAttribute("axes", new_values);
+      break;
+    case SinkKind::Pad:
+      if (node.SinceVersion() < 11) {
+        node.AddAttribute("pads", new_values);
+      } else {
+        node.MutableInputDefs()[1] = &AddIndicesInitializer(graph, input_defs[1]->Name(), new_values,
+                                                            TensorProto_DataType_INT64);
+      }
+      break;
+    case SinkKind::Slice:
+      node.MutableInputDefs()[3] = &AddIndicesInitializer(graph, input_defs[3]->Name(), new_values, new_values_type);
+      break;
+    default:
+      break;
+  }
+
+  // the Transpose now produces the original output of the node
+  auto output_edges = graph_utils::GraphEdge::GetNodeOutputEdges(node);
+  graph_utils::GraphEdge::RemoveGraphEdges(graph, output_edges);
+
+  NodeArg& untransposed_output = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(node.OutputDefs()[0]->Name()),
+                                                          nullptr);
+  transpose.MutableInputDefs()[0] = &untransposed_output;
+  transpose.MutableOutputDefs()[0] = node.MutableOutputDefs()[0];
+  node.MutableOutputDefs()[0] = &untransposed_output;
+  transpose.AddAttribute("perm", output_perm);
+
+  graph.AddEdge(node.Index(), transpose.Index(), 0, 0);
+  for (const auto& output_edge : output_edges) {
+    graph.AddEdge(transpose.Index(), output_edge.dst_node, 0, output_edge.dst_arg_index);
+  }
+
+  return true;
+}
+
+// Removes a Transpose that doesn't move anything. If it produces a graph output, the node producing its input
+// produces the graph output instead. Returns false if it can't be removed.
+bool RemoveIdentityTranspose(Graph& graph, Node& transpose, const logging::Logger& logger) {
+  if (graph_utils::CanRemoveNode(graph, transpose, logger)) {
+    return graph_utils::RemoveNode(graph, transpose);
+  }
+
+  const Node::EdgeEnd* input_edge = graph_utils::GetInputEdge(transpose, 0);
+  if (input_edge == nullptr) {
+    return false;
+  }
+
+  Node& producer = *graph.GetNode(input_edge->GetNode().Index());
+  const int output_index = input_edge->GetSrcArgIndex();
+  if (graph.IsOutput(producer.OutputDefs()[output_index]) ||
+      graph_utils::GraphEdge::GetNodeOutputEdges(producer, output_index).size() != 1) {
+    return false;
+  }
+
+  auto output_edges = graph_utils::GraphEdge::GetNodeOutputEdges(transpose);
+  graph_utils::GraphEdge::RemoveGraphEdges(graph, output_edges);
+  graph.RemoveEdge(producer.Index(), transpose.Index(), output_index, 0);
+
+  producer.MutableOutputDefs()[output_index] = transpose.MutableOutputDefs()[0];
+  for (const auto& output_edge : output_edges) {
+    graph.AddEdge(producer.Index(), output_edge.dst_node, output_index, output_edge.dst_arg_index);
+  }
+
+  return graph.RemoveNode(transpose.Index());
+}
+
+// Makes 'transpose' read the input of the Transpose producing its input, composing the perms.
+// Returns true if 'transpose' was removed as the perms cancel out.
+bool MergeWithInputTranspose(Graph& graph, Node& input_transpose, Node& transpose,
+                             const std::vector<int64_t>& input_perm, const logging::Logger& logger) {
+  std::vector<int64_t> perm;
+  if (!GetPerm(transpose, perm) || perm.size() != input_perm.size()) {
+    return false;
+  }
+
+  // output dim i of 'transpose' is input dim perm[i] of it, which is dim input_perm[perm[i]] of 'input_transpose'.
+  std::vector<int64_t> merged_perm(perm.size());
+  for (size_t i = 0; i < perm.size(); ++i) {
+    merged_perm[i] = input_perm[static_cast<size_t>(perm[i])];
+  }
+
+  BypassTranspose(graph, transpose, 0, input_transpose);
+  transpose.AddAttribute("perm", merged_perm);
+  graph.RemoveNode(input_transpose.Index());
+
+  return IsIdentityPerm(merged_perm) && RemoveIdentityTranspose(graph, transpose, logger);
+}
+
+}  // namespace
+
+Status TransposeSinking::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (node_ptr == nullptr)
+      continue;  // node removed as part of an earlier sinking
+
+    Node& transpose = *node_ptr;
+    ORT_RETURN_IF_ERROR(Recurse(transpose, modified, graph_level, logger));
+
+    if (!IsTranspose(transpose) || !graph_utils::IsSupportedProvider(transpose, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    // Transposes of constants are left to constant folding
+    if (graph_utils::IsConstantInitializer(graph, transpose.InputDefs()[0]->Name())) {
+      continue;
+    }
+
+    // keep pushing the Transpose down until it reaches a node it can't go through
+    std::vector<int64_t> perm;
+    while (GetPerm(transpose, perm) && optimizer_utils::CheckOutputEdges(graph, transpose, 1)) {
+      Node& next_node = *graph.GetNode(transpose.OutputNodesBegin()->Index());
+      if (!graph_utils::IsSupportedProvider(next_node, GetCompatibleExecutionProviders())) {
+        break;
+      }
+
+      if (IsTranspose(next_node)) {
+        MergeWithInputTranspose(graph, transpose, next_node, perm, logger);
+        modified = true;
+        break;
+      }
+
+      if (!SinkTranspose(graph, transpose, next_node, perm)) {
+        break;
+      }
+
+      modified = true;
+
+      // a reduction dropping dims may leave a Transpose that doesn't move anything
+      if (GetPerm(transpose, perm) && IsIdentityPerm(perm) && RemoveIdentityTranspose(graph, transpose, logger)) {
+        break;
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
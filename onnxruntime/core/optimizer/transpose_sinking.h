@@ -0,0 +1,32 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class TransposeSinking
+
+Pushes Transpose nodes down the graph through the nodes that don't depend on the layout of their inputs:
+elementwise ops, reductions, Concat, Pad and Slice. The attributes and constant inputs of those nodes are updated
+for the untransposed layout. Transposes that meet on the way are merged, and removed if they cancel out.
+
+A Transpose is only moved if the other layout dependent inputs of the node are constant or are produced by
+Transposes with the same perm, so the number of Transposes on the data path never grows. Constant inputs get a
+Transpose that is folded by constant folding.
+
+Models converted from channels-last frameworks wrap most of these nodes in Transpose pairs, which this removes.
+*/
+class TransposeSinking : public GraphTransformer {
+ public:
+  TransposeSinking(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("TransposeSinking", compatible_execution_providers) {}
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
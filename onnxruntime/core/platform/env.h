@@ -155,6 +155,24 @@ class Env {
   virtual common::Status MapFileIntoMemory(_In_z_ const ORTCHAR_T* file_path, FileOffsetType offset, size_t length,
                                            MappedMemoryPtr& mapped_memory) const = 0;
 
+  /**
+   * Allocates zero-initialized memory directly from the OS in whole pages.
+   * This is meant for large, long-lived buffers such as the regions of an arena.
+   * @param[in,out] size The number of bytes to allocate. On success, it's set to the number of bytes mapped,
+   *                which must be passed to FreePages.
+   * @param use_huge_pages Back the memory with huge pages if the OS supports them, falling back to regular pages.
+   * @param numa_node The NUMA node to bind the memory to, or -1 to use the default memory policy.
+   * @return The page aligned memory, or nullptr on failure.
+   */
+  virtual void* AllocatePages(size_t& size, bool use_huge_pages, int numa_node) const = 0;
+
+  /**
+   * Frees memory allocated by AllocatePages.
+   * @param p The memory returned by AllocatePages.
+   * @param size The size returned by AllocatePages.
+   */
+  virtual void FreePages(void* p, size_t size) const = 0;
+
 #ifdef _WIN32
   /// \brief Returns true if the directory exists.
   virtual bool FolderExists(const std::wstring& path) const = 0;
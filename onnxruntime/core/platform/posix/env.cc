@@ -23,6 +23,7 @@ limitations under the License.
 #include <fcntl.h>
 #include <stdlib.h>
 #include <sys/mman.h>
+#include <sys/syscall.h>
 #include <fcntl.h>
 #include <dlfcn.h>
 #include <ftw.h>
@@ -83,6 +84,64 @@ static void UnmapFile(void* param) noexcept {
   delete p;
 }
 
+// The size of the huge pages used by AllocatePages. This is the default huge page size on x86-64 and arm64 Linux.
+constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+
+size_t RoundUpToMultiple(size_t size, size_t multiple) {
+  return (size + multiple - 1) / multiple * multiple;
+}
+
+void* MapAnonymousPages(size_t size, int extra_flags) {
+  void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | extra_flags, -1, 0);
+  return p == MAP_FAILED ? nullptr : p;
+}
+
+#if defined(__linux__)
+// Maps size bytes aligned to kHugePageSize and asks for transparent huge pages to back them. Only the huge page
+// aligned part of a mapping can be backed by huge pages, so the mapping is over-allocated and trimmed on both ends.
+void* MapTransparentHugePages(size_t size) {
+  char* base = static_cast<char*>(MapAnonymousPages(size + kHugePageSize, 0));
+  if (base == nullptr) {
+    return nullptr;
+  }
+
+  char* aligned = reinterpret_cast<char*>(RoundUpToMultiple(reinterpret_cast<uintptr_t>(base), kHugePageSize));
+  const size_t head = aligned - base;
+  const size_t tail = kHugePageSize - head;
+  if (head != 0) {
+    munmap(base, head);
+  }
+  if (tail != 0) {
+    munmap(aligned + size, tail);
+  }
+
+#if defined(MADV_HUGEPAGE)
+  // failure only means the memory stays backed by regular pages, e.g. if transparent huge pages are disabled.
+  madvise(aligned, size, MADV_HUGEPAGE);
+#endif
+  return aligned;
+}
+
+// Sets the memory policy of the pages in [p, p + size) to allocate them on numa_node.
+// This goes through the system call so that libnuma isn't required.
+bool BindToNumaNode(void* p, size_t size, int numa_node) {
+#if defined(SYS_mbind)
+  constexpr int kMpolBind = 2;  // MPOL_BIND from <linux/mempolicy.h>
+  constexpr size_t kBitsPerWord = sizeof(unsigned long) * 8;
+  std::vector<unsigned long> node_mask(static_cast<size_t>(numa_node) / kBitsPerWord + 1);
+  node_mask.back() |= 1UL << (static_cast<size_t>(numa_node) % kBitsPerWord);
+  // the kernel ignores the last bit of maxnode.
+  return syscall(SYS_mbind, p, size, kMpolBind, node_mask.data(), node_mask.size() * kBitsPerWord + 1, 0) == 0;
+#else
+  ORT_UNUSED_PARAMETER(p);
+  ORT_UNUSED_PARAMETER(size);
+  ORT_UNUSED_PARAMETER(numa_node);
+  errno = ENOSYS;
+  return false;
+#endif
+}
+#endif
+
 struct FileDescriptorTraits {
   using Handle = int;
   static Handle GetInvalidHandleValue() { return -1; }
@@ -358,6 +417,64 @@ class PosixEnv : public Env {
     return Status::OK();
   }
 
+  void* AllocatePages(size_t& size, bool use_huge_pages, int numa_node) const override {
+    static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    if (size == 0) {
+      return nullptr;
+    }
+
+    void* p = nullptr;
+    size_t mapped_size = 0;
+
+#if defined(__linux__)
+    if (use_huge_pages) {
+      // explicit huge pages are only available if the administrator reserved some, so fall back to transparent ones.
+      mapped_size = RoundUpToMultiple(size, kHugePageSize);
+      p = MapAnonymousPages(mapped_size, MAP_HUGETLB);
+      if (p == nullptr) {
+        p = MapTransparentHugePages(mapped_size);
+      }
+    }
+#else
+    ORT_UNUSED_PARAMETER(use_huge_pages);
+#endif
+
+    if (p == nullptr) {
+      mapped_size = RoundUpToMultiple(size, page_size);
+      p = MapAnonymousPages(mapped_size, 0);
+    }
+
+    if (p == nullptr) {
+      auto[err_no, err_msg] = GetSystemError();
+      LOGS_DEFAULT(ERROR) << "mmap of " << size << " bytes failed. error code: " << err_no
+                          << " error msg: " << err_msg;
+      return nullptr;
+    }
+
+    if (numa_node >= 0) {
+#if defined(__linux__)
+      // none of the pages is touched yet, so all of them will be allocated on the node.
+      if (!BindToNumaNode(p, mapped_size, numa_node)) {
+        auto[err_no, err_msg] = GetSystemError();
+        LOGS_DEFAULT(WARNING) << "Failed to bind memory to NUMA node " << numa_node << ". error code: " << err_no
+                              << " error msg: " << err_msg;
+      }
+#else
+      LOGS_DEFAULT(WARNING) << "Binding memory to a NUMA node is not supported on this platform.";
+#endif
+    }
+
+    size = mapped_size;
+    return p;
+  }
+
+  void FreePages(void* p, size_t size) const override {
+    if (p != nullptr && munmap(p, size) != 0) {
+      auto[err_no, err_msg] = GetSystemError();
+      LOGS_DEFAULT(ERROR) << "munmap failed. error code: " << err_no << " error msg: " << err_msg;
+    }
+  }
+
   static common::Status ReportSystemError(const char* operation_name, const std::string& path) {
     auto[err_no, err_msg] = GetSystemError();
     std::ostringstream oss;
@@ -290,6 +290,56 @@ class WindowsEnv : public Env {
     return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "MapFileIntoMemory is not implemented on Windows.");
   }
 
+  void* AllocatePages(size_t& size, bool use_huge_pages, int numa_node) const override {
+    if (size == 0) {
+      return nullptr;
+    }
+
+    void* p = nullptr;
+    size_t mapped_size = 0;
+
+#if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP)
+    const DWORD preferred_node = numa_node >= 0 ? static_cast<DWORD>(numa_node) : NUMA_NO_PREFERRED_NODE;
+
+    // large pages need the SeLockMemoryPrivilege, so fall back to regular pages without it.
+    const size_t large_page_size = GetLargePageMinimum();
+    if (use_huge_pages && large_page_size != 0) {
+      mapped_size = (size + large_page_size - 1) / large_page_size * large_page_size;
+      p = VirtualAllocExNuma(GetCurrentProcess(), nullptr, mapped_size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES,
+                             PAGE_READWRITE, preferred_node);
+    }
+
+    if (p == nullptr) {
+      mapped_size = size;
+      p = VirtualAllocExNuma(GetCurrentProcess(), nullptr, mapped_size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE,
+                             preferred_node);
+    }
+#else
+    ORT_UNUSED_PARAMETER(use_huge_pages);
+    if (numa_node >= 0) {
+      LOGS_DEFAULT(WARNING) << "Binding memory to a NUMA node is not supported on this platform.";
+    }
+    mapped_size = size;
+    p = VirtualAlloc(nullptr, mapped_size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#endif
+
+    if (p == nullptr) {
+      const auto error_code = GetLastError();
+      LOGS_DEFAULT(ERROR) << "VirtualAlloc of " << size << " bytes failed. error code: " << error_code;
+      return nullptr;
+    }
+
+    size = mapped_size;
+    return p;
+  }
+
+  void FreePages(void* p, size_t /*size*/) const override {
+    if (p != nullptr && !VirtualFree(p, 0, MEM_RELEASE)) {
+      const auto error_code = GetLastError();
+      LOGS_DEFAULT(ERROR) << "VirtualFree failed. error code: " << error_code;
+    }
+  }
+
   bool FolderExists(const std::wstring& path) const override {
     DWORD attributes = GetFileAttributesW(path.c_str());
     return (attributes != INVALID_FILE_ATTRIBUTES) && (attributes & FILE_ATTRIBUTE_DIRECTORY);
@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/math/gemm.h"
 #include "core/providers/cpu/math/gemm_matmul_common.h"
+#include "core/common/safeint.h"
 #include "core/util/math_cpuonly.h"
 #include "gemm_helper.h"
 #include "core/mlas/inc/mlas.h"
@@ -23,6 +24,13 @@ ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     double,
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()),
     Gemm<double>);
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    Gemm,
+    7,
+    8,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Gemm<MLFloat16>);
 
 // opset 9 added support for additional types (int32, uint32, int64, uint64), however we haven't enabled those yet.
 ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
@@ -39,6 +47,13 @@ ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     double,
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()),
     Gemm<double>);
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    Gemm,
+    9,
+    10,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Gemm<MLFloat16>);
 
 // opset 11 made bias input 'C' optional
 ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
@@ -55,6 +70,13 @@ ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     double,
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()),
     Gemm<double>);
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    Gemm,
+    11,
+    12,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Gemm<MLFloat16>);
 
 // opset 13 Adds BFloat16 support but we are not supporting it yet
 ONNX_CPU_OPERATOR_TYPED_KERNEL(
@@ -69,6 +91,12 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
     double,
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()),
     Gemm<double>);
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    Gemm,
+    13,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    Gemm<MLFloat16>);
 
 bool GemmPackBFp32(AllocatorPtr& alloc,
                    const Tensor& tensor_b,
@@ -108,6 +136,76 @@ bool GemmPackBFp32(AllocatorPtr& alloc,
   return true;
 }
 
+bool GemmUseSavedPackedBFp32(const Tensor& tensor_b,
+                             bool trans_b,
+                             std::vector<BufferUniquePtr>& prepacked_buffers,
+                             const std::vector<size_t>& prepacked_buffer_sizes,
+                             BufferUniquePtr& packed_b,
+                             TensorShape& b_shape) {
+  const auto& shape = tensor_b.Shape();
+  if (shape.NumDimensions() != 2 || prepacked_buffers.size() != 1) {
+    return false;
+  }
+
+  const size_t K = trans_b ? static_cast<size_t>(shape[1]) : static_cast<size_t>(shape[0]);
+  const size_t N = trans_b ? static_cast<size_t>(shape[0]) : static_cast<size_t>(shape[1]);
+
+  const size_t packed_b_size = MlasGemmPackBSize(N, K);
+  if (packed_b_size == 0 || packed_b_size != prepacked_buffer_sizes[0]) {
+    return false;
+  }
+
+  b_shape = shape;
+  packed_b = std::move(prepacked_buffers[0]);
+  return true;
+}
+
+bool GemmPackBFp16(AllocatorPtr& alloc,
+                   const Tensor& tensor_b,
+                   bool trans_b,
+                   BufferUniquePtr& packed_b,
+                   size_t& packed_b_size,
+                   TensorShape& b_shape) {
+  if (tensor_b.Shape().NumDimensions() != 2) {
+    return false;
+  }
+  b_shape = tensor_b.Shape();
+
+  const size_t K = trans_b ? static_cast<size_t>(b_shape[1]) : static_cast<size_t>(b_shape[0]);
+  const size_t N = trans_b ? static_cast<size_t>(b_shape[0]) : static_cast<size_t>(b_shape[1]);
+
+  packed_b_size = MlasHalfGemmPackBSize(N, K);
+  if (packed_b_size == 0) {
+    return false;
+  }
+
+  auto* packed_b_data = alloc->Alloc(packed_b_size);
+
+  // Zero the padding so the packed buffer hashes consistently when shared.
+  memset(packed_b_data, 0, packed_b_size);
+
+  packed_b = BufferUniquePtr(packed_b_data, BufferDeleter(alloc));
+  MlasHalfGemmPackB(trans_b ? CblasTrans : CblasNoTrans,
+                    N,
+                    K,
+                    reinterpret_cast<const uint16_t*>(tensor_b.Data<MLFloat16>()),
+                    trans_b ? K : N,
+                    packed_b_data);
+  return true;
+}
+
+void GemmConvertHalfToFloat(const MLFloat16* src, float* dst, size_t count) {
+  const auto size = static_cast<Eigen::Index>(count);
+  EigenVectorMap<float>(dst, size) =
+      ConstEigenVectorMap<Eigen::half>(reinterpret_cast<const Eigen::half*>(src), size).cast<float>();
+}
+
+void GemmConvertFloatToHalf(const float* src, MLFloat16* dst, size_t count) {
+  const auto size = static_cast<Eigen::Index>(count);
+  EigenVectorMap<Eigen::half>(reinterpret_cast<Eigen::half*>(dst), size) =
+      ConstEigenVectorMap<float>(src, size).cast<Eigen::half>();
+}
+
 template <typename T>
 void Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
                           int64_t M, int64_t N, int64_t K,
@@ -172,6 +270,25 @@ Status Gemm<float>::PrePack(const Tensor& tensor, int input_idx,
   return Status::OK();
 }
 
+template <>
+Status Gemm<MLFloat16>::PrePack(const Tensor& tensor, int input_idx,
+                                AllocatorPtr alloc, /*out*/ bool& is_packed,
+                                /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // only pack Matrix B
+  if (input_idx == 1) {
+    size_t packed_b_size;
+    is_packed = GemmPackBFp16(alloc, tensor, trans_B_ != CblasNoTrans, packed_b_, packed_b_size, b_shape_);
+    bool share_prepacked_weights = (prepacked_weights != nullptr);
+    if (is_packed && share_prepacked_weights) {
+      prepacked_weights->buffers_.push_back(std::move(packed_b_));
+      prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+    }
+  }
+  return Status::OK();
+}
+
 template <typename T>
 Status Gemm<T>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& /*prepacked_buffers*/,
                                           int /*input_idx*/,
@@ -193,6 +310,42 @@ Status Gemm<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prep
   return Status::OK();
 }
 
+template <>
+Status Gemm<MLFloat16>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                  int input_idx,
+                                                  /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+  return Status::OK();
+}
+
+template <typename T>
+Status Gemm<T>::UseSavedPrePackedBuffers(const Tensor& /*tensor*/, int /*input_idx*/,
+                                         std::vector<BufferUniquePtr>& /*prepacked_buffers*/,
+                                         const std::vector<size_t>& /*prepacked_buffer_sizes*/,
+                                         /*out*/ bool& used_saved_buffers) {
+  used_saved_buffers = false;
+  return Status::OK();
+}
+
+template <>
+Status Gemm<float>::UseSavedPrePackedBuffers(const Tensor& tensor, int input_idx,
+                                             std::vector<BufferUniquePtr>& prepacked_buffers,
+                                             const std::vector<size_t>& prepacked_buffer_sizes,
+                                             /*out*/ bool& used_saved_buffers) {
+  used_saved_buffers = false;
+
+  if (input_idx == 1) {
+    used_saved_buffers = GemmUseSavedPackedBFp32(tensor, trans_B_ != CblasNoTrans, prepacked_buffers,
+                                                 prepacked_buffer_sizes, packed_b_, b_shape_);
+  }
+  return Status::OK();
+}
+
 template <typename T>
 void Gemm<T>::ComputeActivation(T* y_data, size_t y_size, concurrency::ThreadPool* thread_pool) const {
   if (activation_) {
@@ -301,4 +454,75 @@ Status Gemm<float>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+template <>
+Status Gemm<MLFloat16>::Compute(OpKernelContext* context) const {
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  const auto* A = context->Input<Tensor>(0);
+  const auto* B = packed_b_ ? nullptr : context->Input<Tensor>(1);
+  const auto* C = context->Input<Tensor>(2);
+
+  // Bias could be missing. Treat as scalar 0 if that is the case.
+  GemmHelper helper(A->Shape(), trans_A_ != CblasNoTrans, B ? B->Shape() : b_shape_, trans_B_ != CblasNoTrans,
+                    C != nullptr ? C->Shape() : TensorShape({}));
+
+  if (!helper.State().IsOK())
+    return helper.State();
+
+  int64_t M = helper.M();
+  int64_t N = helper.N();
+  int64_t K = helper.K();
+
+  auto Y = context->Output(0, {M, N});
+
+  // if input is empty tensor, return as nothing need to be calculated and we've set the shape for the output
+  if (M == 0 || N == 0)
+    return Status::OK();
+
+  // Matrix B is consumed as half precision by the MLAS kernel. Matrix A, the
+  // bias and the output are widened to single precision in scratch buffers.
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+  const size_t a_size = static_cast<size_t>(M * K);
+  const size_t y_size = static_cast<size_t>(M * N);
+  auto a_buffer = BufferUniquePtr(alloc->Alloc(SafeInt<size_t>(a_size) * sizeof(float)), BufferDeleter(alloc));
+  auto y_buffer = BufferUniquePtr(alloc->Alloc(SafeInt<size_t>(y_size) * sizeof(float)), BufferDeleter(alloc));
+  float* a_data = static_cast<float*>(a_buffer.get());
+  float* y_data = static_cast<float*>(y_buffer.get());
+
+  GemmConvertHalfToFloat(A->Data<MLFloat16>(), a_data, a_size);
+
+  BufferUniquePtr c_buffer;
+  const float* c_data = nullptr;
+  const TensorShape* c_shape = C != nullptr ? &C->Shape() : nullptr;
+  if (C != nullptr && beta_ != 0) {
+    const size_t c_size = static_cast<size_t>(C->Shape().Size());
+    c_buffer = BufferUniquePtr(alloc->Alloc(SafeInt<size_t>(c_size) * sizeof(float)), BufferDeleter(alloc));
+    GemmConvertHalfToFloat(C->Data<MLFloat16>(), static_cast<float*>(c_buffer.get()), c_size);
+    c_data = static_cast<const float*>(c_buffer.get());
+  }
+
+  GemmBroadcastBias(M, N, beta_, c_data, c_shape, y_data);
+
+  MLAS_HALF_GEMM_DATA_PARAMS data;
+  data.A = a_data;
+  data.lda = static_cast<size_t>(trans_A_ != CblasNoTrans ? M : K);
+  data.B = B ? static_cast<const void*>(B->Data<MLFloat16>()) : packed_b_.get();
+  data.ldb = static_cast<size_t>(trans_B_ != CblasNoTrans ? K : N);
+  data.C = y_data;
+  data.ldc = static_cast<size_t>(N);
+  data.alpha = alpha_;
+  data.beta = c_data != nullptr ? beta_ : 0.0f;
+  data.BIsPacked = B == nullptr;
+
+  MlasHalfGemmBatch(trans_A_, trans_B_,
+                    static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K),
+                    &data, 1, thread_pool);
+
+  GemmConvertFloatToHalf(y_data, Y->MutableData<MLFloat16>(), y_size);
+
+  return Status::OK();
+}
+
 }  // namespace onnxruntime
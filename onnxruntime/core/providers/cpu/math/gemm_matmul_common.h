@@ -14,4 +14,26 @@ bool GemmPackBFp32(AllocatorPtr& alloc,
                    size_t& packed_b_size,
                    TensorShape& b_shape);
 
+// Use a matrix B that GemmPackBFp32 packed when the model was saved. Returns false
+// if the saved buffer doesn't have the size GemmPackBFp32 produces for tensor_b.
+bool GemmUseSavedPackedBFp32(const Tensor& tensor_b,
+                             bool trans_b,
+                             std::vector<BufferUniquePtr>& prepacked_buffers,
+                             const std::vector<size_t>& prepacked_buffer_sizes,
+                             BufferUniquePtr& packed_b,
+                             TensorShape& b_shape);
+
+// Pack a half precision matrix B for MlasHalfGemmBatch. Matrix B stays half
+// precision in the packed buffer and is widened inside the MLAS kernel.
+bool GemmPackBFp16(AllocatorPtr& alloc,
+                   const Tensor& tensor_b,
+                   bool trans_b,
+                   BufferUniquePtr& packed_b,
+                   size_t& packed_b_size,
+                   TensorShape& b_shape);
+
+void GemmConvertHalfToFloat(const MLFloat16* src, float* dst, size_t count);
+
+void GemmConvertFloatToHalf(const float* src, MLFloat16* dst, size_t count);
+
 };  // namespace onnxruntime
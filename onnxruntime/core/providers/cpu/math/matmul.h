@@ -32,6 +32,11 @@ class MatMul<float> final : public OpKernel {
                                    int input_idx,
                                    /*out*/ bool& used_shared_buffers) override;
 
+  Status UseSavedPrePackedBuffers(const Tensor& tensor, int input_idx,
+                                  std::vector<BufferUniquePtr>& prepacked_buffers,
+                                  const std::vector<size_t>& prepacked_buffer_sizes,
+                                  /*out*/ bool& used_saved_buffers) override;
+
   Status Compute(OpKernelContext* context) const override;
 
  private:
@@ -44,4 +49,24 @@ class MatMul<float> final : public OpKernel {
   int64_t trans_b_attr_;
 };
 
+template <>
+class MatMul<MLFloat16> final : public OpKernel {
+ public:
+  MatMul(const OpKernelInfo& info) : OpKernel(info) {}
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  TensorShape b_shape_;
+  BufferUniquePtr packed_b_;
+};
+
 }  // namespace onnxruntime
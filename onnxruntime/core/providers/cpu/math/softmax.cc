@@ -163,7 +163,7 @@ Status Softmax<T>::ComputeImplOpset13(const Tensor& input, Tensor& output, size_
     Tensor temp_input(input.DataType(), TensorShape(transposed_input_dims), alloc);
 
     // Perform the transpose
-    ORT_RETURN_IF_ERROR(TransposeBase::DoTranspose(permutation, input, temp_input));
+    ORT_RETURN_IF_ERROR(TransposeBase::DoTranspose(permutation, input, temp_input, nullptr, thread_pool));
     transposed_input = std::move(temp_input);
 
     // Allocate memory for the intermediate output
@@ -185,7 +185,8 @@ Status Softmax<T>::ComputeImplOpset13(const Tensor& input, Tensor& output, size_
       reverse_permutation[permutation[i]] = i;
     }
     // Perform the transpose to get the axes back to the original ordering
-    ORT_RETURN_IF_ERROR(TransposeBase::DoTranspose(reverse_permutation, intermediate_output, output));
+    ORT_RETURN_IF_ERROR(TransposeBase::DoTranspose(reverse_permutation, intermediate_output, output, nullptr,
+                                                   thread_pool));
   }
 
   return Status::OK();
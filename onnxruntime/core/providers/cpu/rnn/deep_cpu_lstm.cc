@@ -218,6 +218,39 @@ Status DeepCpuLstmOp::TryPackWeights(const Tensor& weights, PackedWeights& packe
   return Status::OK();
 }
 
+bool DeepCpuLstmOp::TryUseSavedWeights(const Tensor& weights, std::vector<BufferUniquePtr>& prepacked_buffers,
+                                       const std::vector<size_t>& prepacked_buffer_sizes,
+                                       PackedWeights& packed_weights) {
+  const auto& shape = weights.Shape();
+  if (shape.NumDimensions() != 3 || prepacked_buffers.size() != 1) {
+    return false;
+  }
+
+  const size_t N = static_cast<size_t>(shape[1]);
+  const size_t K = static_cast<size_t>(shape[2]);
+
+  if ((shape[0] != num_directions_) || (N != static_cast<size_t>(hidden_size_ * 4))) {
+    return false;
+  }
+
+  // the buffer must have the layout TryPackWeights() produces on this CPU
+  const size_t packed_weights_size = MlasGemmPackBSize(N, K);
+  if (packed_weights_size == 0) {
+    return false;
+  }
+
+  size_t packed_weights_data_size = SafeInt<size_t>(packed_weights_size) * num_directions_;
+  if (prepacked_buffer_sizes[0] != packed_weights_data_size) {
+    return false;
+  }
+
+  packed_weights.buffer_ = std::move(prepacked_buffers[0]);
+  packed_weights.buffer_size_ = packed_weights_data_size;
+  packed_weights.weights_size_ = packed_weights_size;
+  packed_weights.shape_ = shape;
+  return true;
+}
+
 static void UseSharedPrePackedBuffersImpl(std::vector<BufferUniquePtr>& prepacked_buffers,
                                           rnn::detail::PackedWeights& packed_tensor) {
   packed_tensor.buffer_ = std::move(prepacked_buffers[0]);
@@ -267,6 +300,23 @@ Status DeepCpuLstmOp::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& pr
   return Status::OK();
 }
 
+Status DeepCpuLstmOp::UseSavedPrePackedBuffers(const Tensor& tensor, int input_idx,
+                                               std::vector<BufferUniquePtr>& prepacked_buffers,
+                                               const std::vector<size_t>& prepacked_buffer_sizes,
+                                               /*out*/ bool& used_saved_buffers) {
+  used_saved_buffers = false;
+
+  if (tensor.IsDataType<float>()) {
+    if (input_idx == 1) {
+      used_saved_buffers = TryUseSavedWeights(tensor, prepacked_buffers, prepacked_buffer_sizes, packed_W_);
+    } else if (input_idx == 2) {
+      used_saved_buffers = TryUseSavedWeights(tensor, prepacked_buffers, prepacked_buffer_sizes, packed_R_);
+    }
+  }
+
+  return Status::OK();
+}
+
 Status DeepCpuLstmOp::Compute(OpKernelContext* context) const {
   const Tensor& X = *context->Input<Tensor>(0);  // inputs. [seq_length, batch_size, input_size]
 
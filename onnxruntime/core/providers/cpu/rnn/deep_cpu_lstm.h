@@ -26,6 +26,11 @@ class DeepCpuLstmOp final : public OpKernel, public LSTMBase {
                                    int input_idx,
                                    /*out*/ bool& used_shared_buffers) override;
 
+  Status UseSavedPrePackedBuffers(const Tensor& tensor, int input_idx,
+                                  std::vector<BufferUniquePtr>& prepacked_buffers,
+                                  const std::vector<size_t>& prepacked_buffer_sizes,
+                                  /*out*/ bool& used_saved_buffers) override;
+
   Status Compute(OpKernelContext* context) const override;
 
   ~DeepCpuLstmOp() override = default;
@@ -34,6 +39,10 @@ class DeepCpuLstmOp final : public OpKernel, public LSTMBase {
   Status TryPackWeights(const Tensor& weights, rnn::detail::PackedWeights& packed_weights,
                         bool& is_packed, AllocatorPtr& alloc);
 
+  bool TryUseSavedWeights(const Tensor& weights, std::vector<BufferUniquePtr>& prepacked_buffers,
+                          const std::vector<size_t>& prepacked_buffer_sizes,
+                          rnn::detail::PackedWeights& packed_weights);
+
   template <typename T>
   Status ComputeImpl(OpKernelContext& context) const;
 
@@ -15,6 +15,8 @@
 #include "core/framework/data_types.h"
 #include "core/framework/element_type_lists.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/cpu/tensor/utils.h"
 #include "core/providers/op_kernel_type_control.h"
 #include "core/util/math_cpuonly.h"
@@ -22,10 +24,6 @@
 #include "Eigen/src/Core/arch/Default/BFloat16.h"
 #include "Eigen/src/Core/arch/Default/Half.h"
 
-#if defined(_M_AMD64) && !defined(_M_ARM64EC)
-#include "core/mlas/inc/mlas.h"
-#endif
-
 namespace onnxruntime {
 
 namespace op_kernel_type_control {
@@ -171,19 +169,35 @@ struct EigenCastType<BFloat16> {
   using type = Eigen::bfloat16;
 };
 
+// splits an element-wise cast of `count` elements over the operator thread pool.
+// cast_range(first, last) converts the elements in [first, last).
+template <typename SrcType, typename DstType, typename CastRangeFn>
+void ParallelCast(const OpKernelContext& context, std::ptrdiff_t count, double cost_per_element,
+                  CastRangeFn&& cast_range) {
+  concurrency::ThreadPool::TryParallelFor(
+      context.GetOperatorThreadPool(), count,
+      TensorOpCost{static_cast<double>(sizeof(SrcType)), static_cast<double>(sizeof(DstType)), cost_per_element},
+      cast_range);
+}
+
 // generic tensor X -> Y
 template <typename SrcType, typename DstType, typename Enable = void>
 struct TensorCaster {
-  void Cast(const OpKernelContext&, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
     using SrcEigenCastType = typename EigenCastType<SrcType>::type;
     using DstEigenCastType = typename EigenCastType<DstType>::type;
 
     const std::ptrdiff_t shape_size = gsl::narrow<std::ptrdiff_t>(shape.Size());
-    const auto in_vector =
-        ConstEigenVectorMap<SrcEigenCastType>(reinterpret_cast<const SrcEigenCastType*>(in.Data<SrcType>()), shape_size);
-    auto out_vector =
-        EigenVectorMap<DstEigenCastType>(reinterpret_cast<DstEigenCastType*>(out.MutableData<DstType>()), shape_size);
-    out_vector = in_vector.template cast<DstEigenCastType>();
+    const auto* in_data = reinterpret_cast<const SrcEigenCastType*>(in.Data<SrcType>());
+    auto* out_data = reinterpret_cast<DstEigenCastType*>(out.MutableData<DstType>());
+
+    ParallelCast<SrcType, DstType>(
+        context, shape_size, 2.0,
+        [in_data, out_data](std::ptrdiff_t first, std::ptrdiff_t last) {
+          const auto in_vector = ConstEigenVectorMap<SrcEigenCastType>(in_data + first, last - first);
+          auto out_vector = EigenVectorMap<DstEigenCastType>(out_data + first, last - first);
+          out_vector = in_vector.template cast<DstEigenCastType>();
+        });
   }
 };
 
@@ -213,18 +227,65 @@ struct TensorCaster<std::string, DstType> {
   }
 };
 
-#if defined(_M_AMD64) && !defined(_M_ARM64EC)
-// specializations to use optimized and Windows x64-specific
-// MlasConvertHalfToFloatBuffer() routine for MLFloat16 -> float conversion
+// specializations that use the vectorized MLAS conversion routines
+
+template <typename SrcType, typename DstType, typename MlasSrcType, typename MlasDstType>
+void CastWithMlasRoutine(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out,
+                         void(MLASCALL* routine)(const MlasSrcType*, MlasDstType*, size_t)) {
+  const auto* in_data = reinterpret_cast<const MlasSrcType*>(in.Data<SrcType>());
+  auto* out_data = reinterpret_cast<MlasDstType*>(out.MutableData<DstType>());
+  ParallelCast<SrcType, DstType>(
+      context, gsl::narrow<std::ptrdiff_t>(shape.Size()), 1.0,
+      [in_data, out_data, routine](std::ptrdiff_t first, std::ptrdiff_t last) {
+        routine(in_data + first, out_data + first, static_cast<size_t>(last - first));
+      });
+}
 
 // tensor MLFloat16 -> float
 template <>
 struct TensorCaster<MLFloat16, float> {
-  void Cast(const OpKernelContext&, const TensorShape& shape, const Tensor& in, Tensor& out) const {
-    auto out_data = out.MutableData<float>();
-    auto in_data = in.Data<MLFloat16>();
-    const size_t shape_size = gsl::narrow<size_t>(shape.Size());
-    MlasConvertHalfToFloatBuffer(&in_data[0].val, out_data, shape_size);
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    CastWithMlasRoutine<MLFloat16, float>(context, shape, in, out, MlasConvertHalfToFloatBuffer);
+  }
+};
+
+// tensor float -> MLFloat16
+template <>
+struct TensorCaster<float, MLFloat16> {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    CastWithMlasRoutine<float, MLFloat16>(context, shape, in, out, MlasConvertFloatToHalfBuffer);
+  }
+};
+
+// tensor BFloat16 -> float
+template <>
+struct TensorCaster<BFloat16, float> {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    CastWithMlasRoutine<BFloat16, float>(context, shape, in, out, MlasConvertBFloat16ToFloatBuffer);
+  }
+};
+
+// tensor float -> BFloat16
+template <>
+struct TensorCaster<float, BFloat16> {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    CastWithMlasRoutine<float, BFloat16>(context, shape, in, out, MlasConvertFloatToBFloat16Buffer);
+  }
+};
+
+// tensor int32_t -> float
+template <>
+struct TensorCaster<int32_t, float> {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    CastWithMlasRoutine<int32_t, float>(context, shape, in, out, MlasConvertInt32ToFloatBuffer);
+  }
+};
+
+// tensor float -> int32_t
+template <>
+struct TensorCaster<float, int32_t> {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    CastWithMlasRoutine<float, int32_t>(context, shape, in, out, MlasConvertFloatToInt32Buffer);
   }
 };
 
@@ -260,7 +321,6 @@ struct TensorCaster<MLFloat16, std::string> {
     CastMLFloat16ThroughFloatTensor<std::string>(context, shape, in, out);
   }
 };
-#endif
 
 class Cast final : public OpKernel {
  public:
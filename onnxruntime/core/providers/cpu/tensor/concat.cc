@@ -251,28 +251,18 @@ std::vector<int64_t> StridesForStack(const std::vector<int64_t>& full_strides, u
 // This method computes the output tensor for Concat/ConcatFromSequence ops
 Status ConcatBase::ComputeImpl(Prepare& p, OpKernelContext* ctx) const {
   int input_count = static_cast<int>(p.inputs.size());
-  int64_t initial_output_offset = 0;  // initial offset for each input
+  std::vector<int64_t> initial_output_offsets(input_count);  // initial offset for each input
 
   auto output_strides_full = StridesForTensor(*p.output_tensor);
   // Note that output_strides_full is only used later when is_stack_ is true, so it's safe to move
   auto output_strides_for_copy = is_stack_ ? StridesForStack(output_strides_full, p.axis) : std::move(output_strides_full);
 
+  int64_t initial_output_offset = 0;
+  int64_t max_input_num_elements = 0;
   for (int input_index = 0; input_index < input_count; input_index++) {
     const auto& prep = p.inputs[input_index];
-
-    // no data in this tensor - so skip it
-    if (prep.num_elements == 0)
-      continue;
-
-    // parallel copy the data across
-    auto status = DispatchStridedCopy<EnabledDataTypes>(ctx->GetOperatorThreadPool(),
-                                                        *p.output_tensor,
-                                                        initial_output_offset,
-                                                        output_strides_for_copy,
-                                                        prep.tensor->Shape(),
-                                                        *prep.tensor,
-                                                        StridesForTensor(*prep.tensor));
-    ORT_RETURN_IF_ERROR(status);
+    initial_output_offsets[input_index] = initial_output_offset;
+    max_input_num_elements = std::max(max_input_num_elements, prep.num_elements);
 
     // advance along the axis that we are concatenating on (by the size of the axis of the tensor that we just copied)
     if (is_stack_) {
@@ -282,6 +272,50 @@ Status ConcatBase::ComputeImpl(Prepare& p, OpKernelContext* ctx) const {
     }
   }
 
+  auto copy_input = [&p, &initial_output_offsets, &output_strides_for_copy](int input_index,
+                                                                          concurrency::ThreadPool* thread_pool) {
+    const auto& prep = p.inputs[input_index];
+
+    // no data in this tensor - so skip it
+    if (prep.num_elements == 0)
+      return Status::OK();
+
+    return DispatchStridedCopy<EnabledDataTypes>(thread_pool,
+                                                 *p.output_tensor,
+                                                 initial_output_offsets[input_index],
+                                                 output_strides_for_copy,
+                                                 prep.tensor->Shape(),
+                                                 *prep.tensor,
+                                                 StridesForTensor(*prep.tensor));
+  };
+
+  // The copy of each input is split across the thread pool, but the copies of small inputs are too cheap to be
+  // split. When all of the inputs are small, copy different inputs in parallel instead.
+  constexpr int64_t kMaxBytesToCopyInputsInParallel = 64 * 1024;
+  const auto element_size = static_cast<int64_t>(p.output_tensor->DataType()->Size());
+  if (input_count > 1 && max_input_num_elements * element_size <= kMaxBytesToCopyInputsInParallel) {
+    std::vector<Status> statuses(input_count);
+    const double average_input_num_elements = static_cast<double>(p.output_num_elements) / input_count;
+    concurrency::ThreadPool::TryParallelFor(
+        ctx->GetOperatorThreadPool(), input_count,
+        TensorOpCost{average_input_num_elements * element_size, average_input_num_elements * element_size,
+                     average_input_num_elements},
+        [&copy_input, &statuses](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t input_index = first; input_index < last; input_index++) {
+            statuses[input_index] = copy_input(static_cast<int>(input_index), nullptr);
+          }
+        });
+
+    for (const auto& status : statuses) {
+      ORT_RETURN_IF_ERROR(status);
+    }
+  } else {
+    for (int input_index = 0; input_index < input_count; input_index++) {
+      // parallel copy the data across
+      ORT_RETURN_IF_ERROR(copy_input(input_index, ctx->GetOperatorThreadPool()));
+    }
+  }
+
   return Status::OK();
 }
 
@@ -129,8 +129,10 @@ void StridedCopy(concurrency::ThreadPool* thread_pool,
   }
 
   if (num_iterations <= 1) {
-    // scalar edge case
-    dst[0] = src[0];
+    // empty and scalar edge cases
+    if (num_iterations == 1) {
+      dst[0] = src[0];
+    }
     return;
   }
 
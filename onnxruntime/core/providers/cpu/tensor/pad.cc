@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/tensor/pad.h"
 
+#include "core/platform/threadpool.h"
 #include "core/providers/cpu/tensor/utils.h"
 #include "core/providers/op_kernel_type_control.h"
 #include "core/providers/op_kernel_type_control_utils.h"
@@ -124,29 +125,6 @@ ONNX_CPU_OPERATOR_KERNEL(
             BuildKernelDefConstraintsFromTypeList<EnabledPad13Types>()),
     Pad);
 
-// This is the general padding method to n-dimensionally do edge or reflection padding (based on the inputDelta values)
-template <typename T>
-static void PadAxis(T* output, T* input, ptrdiff_t input_delta, ptrdiff_t input_pitch,
-                    size_t block_size, size_t block_count) {
-  for (size_t block_index = 0; block_index < block_count; block_index++) {
-    for (size_t i = 0; i < block_size; i++) {
-      *output++ = *input;
-      input += input_delta;
-    }
-    input += input_pitch;
-  }
-}
-
-// These are optimizations of PadAxis. The inner loop is removed since the innermost axis has a blockSize of 1,
-// and inputPitch and inputDelta are just a single value added each iteration.
-template <typename T>
-static void PadInnermostAxis(T* output, T* input, ptrdiff_t input_delta, size_t block_count) {
-  for (size_t block_index = 0; block_index < block_count; block_index++) {
-    *output++ = *input;
-    input += input_delta;
-  }
-}
-
 // For constant padding, there is no input, just a size to write the constant to
 template <typename T>
 static void PadAxisConstant(T* output, T constant, size_t size) {
@@ -164,6 +142,26 @@ static void PadAxisConstant(T* output, T constant, size_t size) {
   }
 }
 
+// Maps an index along an axis of the output, relative to the start of the input data that is copied, to the index of
+// the input value it takes for 'edge' or 'reflect' padding. `extent` is the number of input values along the axis.
+static int64_t MapPadIndex(int64_t index, int64_t extent, Mode mode) {
+  if (index >= 0 && index < extent) {
+    return index;
+  }
+
+  if (mode == Mode::Edge || extent == 1) {
+    return index < 0 ? 0 : extent - 1;
+  }
+
+  // reflect without repeating the edge value, which makes the mapping periodic
+  const int64_t period = 2 * (extent - 1);
+  index %= period;
+  if (index < 0) {
+    index += period;
+  }
+  return index < extent ? index : period - index;
+}
+
 Status PadBase::HandleDimValueZero(const Mode& mode, const TensorShape& input_shape, TensorShape& output_shape) {
   switch (mode) {
     case Mode::Constant: {
@@ -318,131 +316,95 @@ static Status PadImpl(OpKernelContext* ctx,
     return PadInputWithDimValueOfZero(ctx, mode, orig_input_shape, output_dims, value);
   }
 
-  TensorShape input_shape(reshaped_input_dims);
-  SliceIterator<T> input(input_tensor, input_shape, input_starts, input_extents, {});
-
   // output_shape need to keep original.
   TensorShape output_shape(output_dims);
   auto& output_tensor = *ctx->Output(0, output_shape);
-  auto* output = reinterpret_cast<T*>(output_tensor.MutableDataRaw());
 
-  TensorPitches output_pitches(reshaped_output_dims);
-  size_t alignSkip = 0;  // Amount to skip to align to where the next input tensor data needs to be written
+  // output tensor's size is 0 (negative pads removed all the data), nothing to fill
+  if (output_shape.Size() == 0) {
+    return Status::OK();
+  }
 
-  // Initial skip, sum up the begin padding on each axis
-  for (size_t i = 0; i < new_dims_count; i++)
-    alignSkip += reshaped_pad[i] * output_pitches[i];
+  if (mode != Mode::Constant) {
+    for (size_t i = 0; i < new_dims_count; i++) {
+      ORT_RETURN_IF_NOT(input_extents[i] > 0,
+                        "Cannot use 'edge' or 'reflect' mode to pad a dimension that is empty after slicing.");
+    }
+  }
 
-  ExtentAxisCounters input_counters(input_extents);
+  // Each row of the innermost (flattened) output axis is produced independently: rows that are padding along an
+  // outer axis are filled with the constant or copied from the input row that edge/reflect padding maps them to,
+  // and the remaining rows copy an input row and pad it along the innermost axis. This lets the rows be split
+  // across the thread pool.
+  const T* input = reinterpret_cast<const T*>(input_tensor.DataRaw());
+  auto* output = reinterpret_cast<T*>(output_tensor.MutableDataRaw());
 
-  switch (mode) {
-    case Mode::Constant:
-      // Loop over the output tensor, writing out padding between the blocks of copied data
-      // On loop entry, 'pad' is already set to the first continuous block of padding, and
-      // after every pass through the inner loop it gets set to the next continuous pad size.
-      while (input_counters) {
-        output += alignSkip;
-        {
-          T* axisStart = output;
-          output = input.CopyInnermostAxisSolitaryInnerStep(output);
-
-          int64_t prePad = reshaped_pad[inner_axis];
-          int64_t postPad = reshaped_pad[inner_axis + new_dims_count];
-          PadAxisConstant(axisStart - prePad, value, prePad);
-          PadAxisConstant(output, value, postPad);
-          output += postPad;
-          alignSkip = prePad;
-        }
-        // Calculate the size of the next block of padding (skipping over the innermost axis since that's already done)
-        while (input_counters.Increment()) {
-          ptrdiff_t inner_pitch = output_pitches[input_counters.Axis()];
-          T* axisStart = output - inner_pitch * input_extents[input_counters.Axis()];
-          int64_t prePad = reshaped_pad[input_counters.Axis()];
-          int64_t postPad = reshaped_pad[input_counters.Axis() + new_dims_count];
-          PadAxisConstant(axisStart - prePad * inner_pitch, value, prePad * inner_pitch);
-          PadAxisConstant(output, value, postPad * inner_pitch);
-          output += inner_pitch * postPad;
-          alignSkip += inner_pitch * prePad;
+  TensorPitches input_pitches(reshaped_input_dims);
+  const int64_t output_row_size = reshaped_output_dims[inner_axis];
+  const int64_t row_count = TensorShape(reshaped_output_dims).SizeToDimension(inner_axis);
+
+  const int64_t inner_pre_pad = reshaped_pad[inner_axis];
+  const int64_t inner_post_pad = reshaped_pad[inner_axis + new_dims_count];
+  const int64_t inner_extent = input_extents[inner_axis];
+
+  // the innermost axis is padded in blocks of the flattened axes that have no padding
+  const int64_t block_size = static_cast<int64_t>(inner_no_pad_size);
+  const int64_t extent_blocks = inner_extent / block_size;
+  const int64_t pre_pad_blocks = inner_pre_pad / block_size;
+  const int64_t post_pad_blocks = inner_post_pad / block_size;
+
+  auto pad_rows = [&](std::ptrdiff_t first_row, std::ptrdiff_t last_row) {
+    for (std::ptrdiff_t row = first_row; row < last_row; ++row) {
+      T* output_row = output + row * output_row_size;
+
+      // find the input row to copy from, or that this is a row of constant padding
+      bool is_constant_row = false;
+      int64_t input_offset = input_starts[inner_axis];
+      int64_t remaining_row = row;
+      for (size_t axis = inner_axis; axis-- > 0;) {
+        int64_t index = remaining_row % reshaped_output_dims[axis] - reshaped_pad[axis];
+        remaining_row /= reshaped_output_dims[axis];
+        if (index < 0 || index >= input_extents[axis]) {
+          if (mode == Mode::Constant) {
+            is_constant_row = true;
+            break;
+          }
+          index = MapPadIndex(index, input_extents[axis], mode);
         }
+        input_offset += (input_starts[axis] + index) * input_pitches[axis];
       }
-      break;
 
-    case Mode::Edge:
-      // Loop over the output tensor, writing out padding between the blocks of copied data
-      // On loop entry, 'pad' is already set to the first continuous block of padding, and
-      // after every pass through the inner loop it gets set to the next continuous pad size.
-      while (input_counters) {
-        output += alignSkip;
-        {
-          T* axisStart = output;
-          output = input.CopyInnermostAxisSolitaryInnerStep(output);
-
-          int64_t prePad = reshaped_pad[inner_axis];
-          int64_t postPad = reshaped_pad[inner_axis + new_dims_count];
-          if (inner_no_pad_size == 1) {
-            PadAxisConstant(axisStart - prePad, *axisStart, prePad);
-            PadAxisConstant(output, *(output - 1), postPad);
-          } else {
-            // When inner_most axis(es) do not need pad, above PadAxisConstant() do not fit for Edge mode.
-            // Also general loop below after handling first pad axis with non-pad axis works fine.
-            PadAxis(axisStart - prePad, axisStart, 1, -ptrdiff_t(inner_no_pad_size), inner_no_pad_size, pads[inner_axis]);
-            PadAxis(output, output - inner_no_pad_size, 1, -ptrdiff_t(inner_no_pad_size), inner_no_pad_size, pads[inner_axis + data_rank]);
-          }
-          output += postPad;
-          alignSkip = prePad;
-        }
-        // Calculate the size of the next block of padding (skipping over the innermost axis since that's already done)
-        while (input_counters.Increment()) {
-          ptrdiff_t inner_pitch = output_pitches[input_counters.Axis()];
-          T* axisStart = output - inner_pitch * input_extents[input_counters.Axis()];
-          int64_t prePad = reshaped_pad[input_counters.Axis()];
-          int64_t postPad = reshaped_pad[input_counters.Axis() + new_dims_count];
-          PadAxis(axisStart - prePad * inner_pitch, axisStart, 1, -inner_pitch, inner_pitch, prePad);
-          PadAxis(output, output - inner_pitch, 1, -inner_pitch, inner_pitch, postPad);
-          output += inner_pitch * postPad;
-          alignSkip += inner_pitch * prePad;
-        }
+      if (is_constant_row) {
+        PadAxisConstant(output_row, value, static_cast<size_t>(output_row_size));
+        continue;
       }
-      break;
 
-    case Mode::Reflect:
-      // Loop over the output tensor, writing out padding between the blocks of copied data
-      // On loop entry, 'pad' is already set to the first continuous block of padding, and
-      // after every pass through the inner loop it gets set to the next continuous pad size.
-      while (input_counters) {
-        output += alignSkip;
-        {
-          T* axisStart = output;
-          output = input.CopyInnermostAxisSolitaryInnerStep(output);
-
-          int64_t prePad = reshaped_pad[inner_axis];
-          int64_t postPad = reshaped_pad[inner_axis + new_dims_count];
-          if (inner_no_pad_size == 1) {
-            PadInnermostAxis(axisStart - prePad, axisStart + prePad, -1 /* inputDelta */, prePad);
-            PadInnermostAxis(output, output - 2, -1 /* inputDelta */, postPad);
-          } else {
-            // When inner_most axis(es) do not need pad, Above PadInnermostAxis() do not fit for Reflect mode.
-            PadAxis(axisStart - prePad, axisStart + prePad, 1, -ptrdiff_t(inner_no_pad_size * 2), inner_no_pad_size, pads[inner_axis]);
-            PadAxis(output, output - 2 * inner_no_pad_size, 1, -ptrdiff_t(inner_no_pad_size * 2), inner_no_pad_size, pads[inner_axis + data_rank]);
-          }
-          output += postPad;
-          alignSkip = prePad;
+      const T* input_row = input + input_offset;
+      std::copy_n(input_row, inner_extent, output_row + inner_pre_pad);
+
+      if (mode == Mode::Constant) {
+        PadAxisConstant(output_row, value, static_cast<size_t>(inner_pre_pad));
+        PadAxisConstant(output_row + inner_pre_pad + inner_extent, value, static_cast<size_t>(inner_post_pad));
+      } else {
+        for (int64_t block = 0; block < pre_pad_blocks; ++block) {
+          const int64_t input_block = MapPadIndex(block - pre_pad_blocks, extent_blocks, mode);
+          std::copy_n(input_row + input_block * block_size, block_size, output_row + block * block_size);
         }
-        // Calculate the size of the next block of padding (skipping over the innermost axis since that's already done)
-        while (input_counters.Increment()) {
-          ptrdiff_t inner_pitch = output_pitches[input_counters.Axis()];
-          T* axisStart = output - inner_pitch * input_extents[input_counters.Axis()];
-          int64_t prePad = reshaped_pad[input_counters.Axis()];
-          int64_t postPad = reshaped_pad[input_counters.Axis() + new_dims_count];
-          PadAxis(axisStart - prePad * inner_pitch, axisStart + prePad * inner_pitch, 1, -inner_pitch * 2,
-                  inner_pitch, prePad);
-          PadAxis(output, output - 2 * inner_pitch, 1, -inner_pitch * 2, inner_pitch, postPad);
-          output += inner_pitch * postPad;
-          alignSkip += inner_pitch * prePad;
+        T* post_pad_output = output_row + inner_pre_pad + inner_extent;
+        for (int64_t block = 0; block < post_pad_blocks; ++block) {
+          const int64_t input_block = MapPadIndex(extent_blocks + block, extent_blocks, mode);
+          std::copy_n(input_row + input_block * block_size, block_size, post_pad_output + block * block_size);
         }
       }
-      break;
-  }
+    }
+  };
+
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), row_count,
+      TensorOpCost{static_cast<double>(inner_extent * sizeof(T)),
+                   static_cast<double>(output_row_size * sizeof(T)),
+                   static_cast<double>(output_row_size)},
+      pad_rows);
 
   return Status::OK();
 }
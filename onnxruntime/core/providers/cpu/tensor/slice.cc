@@ -8,6 +8,7 @@
 
 #include "core/framework/element_type_lists.h"
 #include "core/providers/common.h"
+#include "core/providers/cpu/tensor/copy.h"
 #include "core/providers/cpu/tensor/slice_helper.h"
 #include "core/providers/cpu/tensor/utils.h"
 #include "core/providers/op_kernel_type_control.h"
@@ -211,41 +212,29 @@ static Status SliceImpl(OpKernelContext* ctx,
   if (output_shape.Size() == 0)
     return Status::OK();
 
-  // use MutableDataRaw as actual data type in tensor may not match as we templatize on data size
-  T* output = reinterpret_cast<T*>(output_tensor.MutableDataRaw());
-  const auto* output_end = output + output_tensor.Shape().Size();
-
-  auto create_output = [&output, &output_end](SliceIterator<T>& slice_input_iterator) {
-    if (slice_input_iterator.SolitaryInnerStep()) {
-      while (output < output_end) {
-        output = slice_input_iterator.CopyInnermostAxisSolitaryInnerStep(output);
-      }
-    } else {
-      while (output < output_end) {
-        output = slice_input_iterator.CopyInnermostAxisNonSolitaryInnerStep(output);
-      }
-    }
-
-    ORT_ENFORCE(output == output_end);
-  };
-
-  if (compute_metadata.p_flattened_output_dims_) {
-    // if we have flattened output dims we need to also flatten the input dims.
-    // as we're combining the innermost dims and keeping all values we can just copy the size of the last dim
-    std::vector<int64_t> flattened_input_dims(input_tensor.Shape().GetDims());
-    flattened_input_dims.resize(compute_metadata.p_flattened_output_dims_->size());
-    flattened_input_dims.back() = compute_metadata.p_flattened_output_dims_->back();
-    TensorShape input_shape(std::move(flattened_input_dims));
-
-    auto input_iterator2 = SliceIterator<T>(input_tensor, input_shape, compute_metadata.starts_,
-                                            *compute_metadata.p_flattened_output_dims_, compute_metadata.steps_);
-    create_output(input_iterator2);
-  } else {
-    auto input_iterator2 = SliceIterator<T>(input_tensor, compute_metadata.starts_, compute_metadata.output_dims_,
-                                            compute_metadata.steps_);
-    create_output(input_iterator2);
+  // the slice is a strided copy that starts at the first selected input element,
+  // with the stride of each axis scaled by the step for that axis.
+  // FlattenOutputDims drops the starts and steps of the combined innermost axes, which are 0 and 1 respectively.
+  // StridedCopy combines those axes itself, so the unflattened shapes are used here.
+  const std::vector<int64_t> input_strides = StridesForTensor(input_tensor);
+  std::vector<int64_t> slice_strides(input_strides.size());
+  std::ptrdiff_t input_offset = 0;
+  const size_t num_sliced_axes = compute_metadata.starts_.size();
+  for (size_t i = 0, end = input_strides.size(); i < end; ++i) {
+    const int64_t start = i < num_sliced_axes ? compute_metadata.starts_[i] : 0;
+    const int64_t step = i < num_sliced_axes ? compute_metadata.steps_[i] : 1;
+    input_offset += start * input_strides[i];
+    slice_strides[i] = input_strides[i] * step;
   }
 
+  // use DataRaw/MutableDataRaw as actual data type in tensor may not match as we templatize on data size
+  StridedCopy<T>(ctx->GetOperatorThreadPool(),
+                 reinterpret_cast<T*>(output_tensor.MutableDataRaw()),
+                 StridesForTensor(output_tensor),
+                 output_shape,
+                 reinterpret_cast<const T*>(input_tensor.DataRaw()) + input_offset,
+                 slice_strides);
+
   return Status::OK();
 }
 
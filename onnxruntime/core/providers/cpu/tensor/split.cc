@@ -6,6 +6,7 @@
 #include "gsl/gsl"
 
 #include "core/providers/common.h"
+#include "core/providers/cpu/tensor/copy.h"
 #include "core/providers/op_kernel_type_control.h"
 #include "core/providers/op_kernel_type_control_utils.h"
 #include "core/util/math.h"
@@ -129,17 +130,6 @@ Status Split::Compute(OpKernelContext* context) const {
   return status;
 }
 
-template <typename T>
-inline void copy_data(const T* src, T* dst, size_t count) {
-  memcpy(dst, src, count * sizeof(T));
-}
-
-template <>
-inline void copy_data<std::string>(const std::string* src, std::string* dst, size_t count) {
-  const std::string* end = src + count;
-  std::copy(src, end, dst);
-}
-
 template <typename T>
 Status Split::ComputeImpl(OpKernelContext& context, const Tensor& input) const {
   if (!utils::HasType<EnabledSplitDataTypes, T>()) {
@@ -187,16 +177,15 @@ Status Split::ComputeImpl(OpKernelContext& context, const Tensor& input) const {
     Tensor* output = context.Output(i, TensorShape{output_dimensions});
     T* output_data = output->template MutableData<T>();
 
-    ::onnxruntime::math::CopyMatrix<T>(
-        before_dims,                                       // M
-        split_size * after_dims_excluding_split,           // N
-        static_cast<const T*>(input_data + input_offset),  // A
-        after_dims_including_split_axis,                   // lda
-        static_cast<T*>(output_data),                      // B
-        split_size * after_dims_excluding_split,           // ldb
-        [](const T* src, T* dst, size_t count) {
-          copy_data<T>(src, dst, count);
-        });
+    // copy the [before_dims, split_size * after_dims_excluding_split] block for this output out of the input,
+    // where each input row has after_dims_including_split_axis values
+    if (output->Shape().Size() > 0) {
+      const int64_t output_row_size = static_cast<int64_t>(split_size) * after_dims_excluding_split;
+      StridedCopy<T>(context.GetOperatorThreadPool(),
+                     output_data, {output_row_size, 1},
+                     TensorShape{before_dims, output_row_size},
+                     input_data + input_offset, {after_dims_including_split_axis, 1});
+    }
 
     input_offset += split_size * after_dims_excluding_split;  // offset by the N data we used in this iteration
   }
@@ -10,6 +10,9 @@
 #endif
 
 #include "gsl/gsl"
+#include "core/common/type_list.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/tensor/copy.h"
 #include "core/providers/cpu/tensor/tile.h"
 #include "core/providers/cpu/tensor/utils.h"
 
@@ -21,6 +24,12 @@ using namespace ::onnxruntime::common;
 
 namespace onnxruntime {
 
+namespace {
+// the data types registered for the kernel. they are copied based on the element size.
+using TileDataTypes = TypeList<float, double, int8_t, int16_t, int32_t, int64_t,
+                               uint8_t, uint16_t, uint32_t, uint64_t, bool>;
+}  // namespace
+
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Tile,
     6,
@@ -56,49 +65,6 @@ ONNX_CPU_OPERATOR_KERNEL(
         .TypeConstraint("T1", DataTypeImpl::GetTensorType<int64_t>()),
     Tile);
 
-Status TileCoreForFixedSizeTypes(const Tensor& input_tensor, Tensor& output_tensor, const int64_t* repeats, TensorAxisCounters& input_counters, const TensorPitches& output_pitches, size_t element_size) {
-  const auto& input_shape = input_tensor.Shape().GetDims();
-  const size_t dimension_count = input_shape.size();
-
-  const auto* input = reinterpret_cast<const uint8_t*>(input_tensor.DataRaw());
-  auto* output = reinterpret_cast<uint8_t*>(output_tensor.MutableDataRaw());
-
-  // some helper variables that will be used along the way
-  size_t block_size = 0;
-  int64_t num_repeats = 0;
-  const uint8_t* copy = nullptr;
-  const int64_t innermost_dim = input_shape[dimension_count - 1];
-
-  while (input_counters) {
-    // Copy the input data over
-    block_size = innermost_dim * element_size;
-    memcpy(output, input, block_size);
-    output += block_size;
-    input += block_size;
-
-    // Tile data for the innermost axis
-    copy = output - block_size;
-    num_repeats = repeats[dimension_count - 1] - 1;
-    for (int64_t repeat = 0; repeat < num_repeats; ++repeat) {
-      memcpy(output, copy, block_size);
-      output += block_size;
-    }
-
-    // Tile data for other axes
-    while (input_counters.Increment()) {
-      ptrdiff_t pitch = output_pitches[input_counters.Axis()] * input_shape[input_counters.Axis()];
-      block_size = pitch * element_size;
-      copy = output - block_size;
-      num_repeats = repeats[input_counters.Axis()] - 1;
-      for (int64_t repeat = 0; repeat < num_repeats; ++repeat) {
-        memcpy(output, copy, block_size);
-        output += block_size;
-      }
-    }
-  }
-  return Status::OK();
-}
-
 namespace TileOp {
 // Find the first non-1 repeat and check the input shape to the left of that dimension:
 // 1) If the dim values to the left are all 1s (or don't exist), then the tiling logic is essentially copying the input buffer
@@ -193,74 +159,59 @@ Status Tile::Compute(OpKernelContext* ctx) const {
     // For now, it shouldn't throw in the enforce as the kernel doesn't claim string support
     ORT_ENFORCE(!input_tensor.IsDataType<std::string>(), "Tile doesn't support string type yet");
 
-    int8_t* output_data_casted = reinterpret_cast<int8_t*>(output_tensor.MutableDataRaw());
-    const int8_t* input_data_casted = reinterpret_cast<const int8_t*>(input_tensor.DataRaw());
-    const void* input_data_raw = input_tensor.DataRaw();
-
-    if (!is_batched_memcpy) {
-      size_t copy_bytes = input_tensor.SizeInBytes();
-      // TODO: Add multi-threading logic if num_of_copies_per_batch is large enough
-      for (size_t i = 0; i < num_of_copies_per_batch; ++i) {
-        memcpy(static_cast<void*>(output_data_casted), input_data_raw, copy_bytes);
-        output_data_casted += copy_bytes;
-      }
-    } else {
-      size_t copy_bytes = num_of_elements_per_batch * input_tensor.DataType()->Size();
-      size_t batch_count = static_cast<size_t>(input_tensor.Shape()[0]);  // The tensor is atleast 1-D- this is safe
-
-      // TODO: Multi-thread if needed
-      for (size_t batch = 0; batch < batch_count; ++batch) {
-        for (size_t i = 0; i < num_of_copies_per_batch; ++i) {
-          memcpy(static_cast<void*>(output_data_casted), static_cast<const void*>(input_data_casted), copy_bytes);
-          output_data_casted += copy_bytes;
-        }
-        input_data_casted += copy_bytes;
-      }
-
-      // Now account for batch dim repeat
-      if (num_of_batch_copies > 1) {
-        // reset some values
-        output_data_casted = reinterpret_cast<int8_t*>(output_tensor.MutableDataRaw());
-        copy_bytes *= num_of_copies_per_batch * batch_count;
-        int8_t* copy_ptr = output_data_casted + copy_bytes;
-
-        for (size_t i = 1; i < num_of_batch_copies; ++i) {
-          memcpy(static_cast<void*>(copy_ptr), static_cast<const void*>(output_data_casted), copy_bytes);
-          copy_ptr += copy_bytes;
-        }
-      }
+    auto* output_data = reinterpret_cast<int8_t*>(output_tensor.MutableDataRaw());
+    const auto* input_data = reinterpret_cast<const int8_t*>(input_tensor.DataRaw());
+    const size_t element_size = input_tensor.DataType()->Size();
+
+    // the output is a sequence of blocks that are each a copy of the input (or of one batch of it),
+    // so the blocks can be copied in parallel
+    size_t block_elements = static_cast<size_t>(input_shape.Size());
+    size_t block_count = num_of_copies_per_batch;
+    size_t batch_count = 1;
+    if (is_batched_memcpy) {
+      block_elements = num_of_elements_per_batch;
+      batch_count = static_cast<size_t>(input_shape[0]);  // The tensor is atleast 1-D- this is safe
+      block_count = num_of_batch_copies * batch_count * num_of_copies_per_batch;
     }
 
+    const size_t block_bytes = block_elements * element_size;
+    concurrency::ThreadPool::TryParallelFor(
+        ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(block_count),
+        TensorOpCost{static_cast<double>(block_bytes), static_cast<double>(block_bytes),
+                     static_cast<double>(block_elements)},
+        [output_data, input_data, block_bytes, batch_count, num_of_copies_per_batch](std::ptrdiff_t first,
+                                                                                     std::ptrdiff_t last) {
+          for (std::ptrdiff_t block = first; block < last; ++block) {
+            const size_t batch = (static_cast<size_t>(block) / num_of_copies_per_batch) % batch_count;
+            memcpy(output_data + block * block_bytes, input_data + batch * block_bytes, block_bytes);
+          }
+        });
+
     return Status::OK();
   }
 
-  TensorAxisCounters input_counters(input_tensor);
-  TensorPitches output_pitches(output_tensor);
-
-  static_assert(sizeof(float) == sizeof(int32_t), "Float and Int32 are of different sizes");
-  static_assert(sizeof(double) == sizeof(int64_t), "Double and Int64 are of different sizes");
-
-  if (input_tensor.IsDataType<float>() ||
-      input_tensor.IsDataType<int32_t>() ||
-      input_tensor.IsDataType<uint32_t>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(float));
-
-  if (input_tensor.IsDataType<double>() || input_tensor.IsDataType<int64_t>() ||
-      input_tensor.IsDataType<uint64_t>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(double));
-
-  else if (input_tensor.IsDataType<int8_t>() ||
-           input_tensor.IsDataType<uint8_t>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(int8_t));
-
-  if (input_tensor.IsDataType<int16_t>() || input_tensor.IsDataType<uint16_t>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(int16_t));
+  // General case: view the output as [repeats[0], input_shape[0], repeats[1], input_shape[1], ...] and copy
+  // the input into it with a stride of 0 for each repeat axis.
+  std::vector<int64_t> copy_dims;
+  std::vector<int64_t> output_strides;
+  std::vector<int64_t> input_strides;
+  copy_dims.reserve(2 * input_rank);
+  output_strides.reserve(2 * input_rank);
+  input_strides.reserve(2 * input_rank);
+
+  const std::vector<int64_t> output_pitches = StridesForTensor(output_tensor);
+  const std::vector<int64_t> input_pitches = StridesForTensor(input_tensor);
+  for (size_t axis = 0; axis < input_rank; axis++) {
+    copy_dims.push_back(repeats[axis]);
+    output_strides.push_back(input_shape[axis] * output_pitches[axis]);
+    input_strides.push_back(0);
 
-  else if (input_tensor.IsDataType<bool>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(bool));
+    copy_dims.push_back(input_shape[axis]);
+    output_strides.push_back(output_pitches[axis]);
+    input_strides.push_back(input_pitches[axis]);
+  }
 
-  // TODO: Support 'string' and 'float16' types for completeness
-  else
-    ORT_THROW("Tile doesn't have an implementation yet for the type: ", input_tensor.DataType());
+  return DispatchStridedCopy<TileDataTypes>(ctx->GetOperatorThreadPool(), output_tensor, 0, output_strides,
+                                            TensorShape(copy_dims), input_tensor, input_strides);
 }
 }  // namespace onnxruntime
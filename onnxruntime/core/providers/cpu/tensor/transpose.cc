@@ -6,6 +6,7 @@
 #include "core/framework/element_type_lists.h"
 #include "core/framework/utils.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/op_kernel_type_control.h"
 #include "core/providers/op_kernel_type_control_utils.h"
 #include "utils.h"
@@ -118,13 +119,6 @@ static inline void IncrementIndexAndComputeOffset(MultiIndex& mindex, const T*&
 
 // DoTransposeSingleBlock: specialization of DoTranspose for the num_blocks=1 case.
 // copies source tensor to target, transposing elements.
-static inline void DoTransposeSingleBlock(size_t num_elts_in_block, const void* source, void* target,
-                                          size_t element_size) {
-  size_t blocksize = num_elts_in_block * element_size;
-  // copy
-  memcpy(target, source, blocksize);
-}
-
 static inline void DoTransposeSingleBlock(size_t num_elts_in_block, const std::string* source, std::string* target) {
   const std::string* end = source + num_elts_in_block;
   std::copy(source, end, target);
@@ -132,22 +126,6 @@ static inline void DoTransposeSingleBlock(size_t num_elts_in_block, const std::s
 
 // DoTranspose: copies source tensor to target, transposing elements.
 // The stride vector indicates the transposition.
-static void DoTransposeImpl(int64_t num_axes, const std::vector<int64_t>& target_dims,
-                            size_t num_blocks, size_t num_elts_in_block, const std::vector<size_t>& stride,
-                            const uint8_t* source, uint8_t* target, size_t element_size) {
-  size_t blocksize = num_elts_in_block * element_size;
-  MultiIndex mindex;
-  IncrementIndexAndComputeOffsetSetup(mindex, num_axes, target_dims, stride, element_size);
-
-  const uint8_t* local_source = source;
-  for (size_t i = 0; i < num_blocks; ++i) {
-    ORT_ENFORCE((local_source >= source) && (local_source < source + num_blocks * blocksize));
-    memcpy(target, local_source, blocksize);
-    IncrementIndexAndComputeOffset(mindex, local_source);
-    target += blocksize;
-  }
-}
-
 static void DoTransposeImpl(int64_t num_axes, const std::vector<int64_t>& target_dims,
                             size_t num_blocks, size_t num_elts_in_block, const std::vector<size_t>& stride,
                             const std::string* source, std::string* target) {
@@ -238,15 +216,17 @@ static void DoTransposeEltWise(int64_t num_axes, const std::vector<int64_t>& tar
 }
 
 //  `input_shape_override` overrides the shape of `input` for compute purposes.
-static Status DoUntypedTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
-                                 const TensorShape* input_shape_override = nullptr) {
+static Status DoStringTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
+                                const TensorShape* input_shape_override = nullptr) {
+  constexpr bool string_enabled = utils::HasType<EnabledDataTypes, std::string>();
+  if (!string_enabled) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Transpose of std::string is not supported in this build.");
+  }
+
   const auto& input_shape = input_shape_override ? *input_shape_override : input.Shape();
   const auto& input_dims = input_shape.GetDims();
   auto rank = input_shape.NumDimensions();
 
-  const auto element_size = input.DataType()->Size();
-  const bool is_string_type = input.IsDataTypeString();
-
   std::vector<size_t> stride(rank);
   for (size_t i = 0; i < rank; i++) {
     size_t inpdim = permutations[i];
@@ -274,380 +254,315 @@ static Status DoUntypedTranspose(const std::vector<size_t>& permutations, const
     }
   }
 
-  Status status = Status::OK();
-
-  if (is_string_type) {
-    constexpr bool string_enabled = utils::HasType<EnabledDataTypes, std::string>();
-
-    if (string_enabled) {
-      const auto* input_data = input.template Data<std::string>();
-      auto* output_data = output.template MutableData<std::string>();
-      if (1 == prefix_blocksize) {
-        DoTransposeSingleBlock(suffix_blocksize, input_data, output_data);
-      } else if (1 == suffix_blocksize) {
-        DoTransposeEltWise(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, stride,
-                           input_data, output_data);
-      } else {
-        DoTransposeImpl(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, suffix_blocksize, stride,
-                        input_data, output_data);
-      }
-    } else {
-      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Transpose of std::string is not supported in this build.");
-    }
+  const auto* input_data = input.template Data<std::string>();
+  auto* output_data = output.template MutableData<std::string>();
+  if (1 == prefix_blocksize) {
+    DoTransposeSingleBlock(suffix_blocksize, input_data, output_data);
+  } else if (1 == suffix_blocksize) {
+    DoTransposeEltWise(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, stride,
+                       input_data, output_data);
   } else {
-    const auto* input_data = reinterpret_cast<const uint8_t*>(input.DataRaw());
-    auto* output_data = reinterpret_cast<uint8_t*>(output.MutableDataRaw());
-    if (1 == prefix_blocksize) {
-      DoTransposeSingleBlock(suffix_blocksize, input_data, output_data, element_size);
-    } else if (1 == suffix_blocksize) {
-      // this may return a failed status if the data size is not supported in this build
-      status = DoTransposeEltWise(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, stride,
-                                  input_data, output_data, element_size);
-    } else {
-      DoTransposeImpl(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, suffix_blocksize, stride,
-                      input_data, output_data, element_size);
-    }
+    DoTransposeImpl(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, suffix_blocksize, stride,
+                    input_data, output_data);
   }
 
-  return status;
+  return Status::OK();
 }
 
 /*
-Optimizations for moving a single axis either inwards or outwards.
-
-If moving outwards we can use a single reader and multiple writers. The number of writers is equal to the value of
-the axis being moved.
+Transpose of the tensors of fixed size types, for any permutation.
 
-  e.g. if the input is NHWC with shape {N, 300, 300, 3}, we can transpose to NCHW by reading once and having
-       one writer for each of the 3 channels at a different offset in the output, updating the offset for each item
-       in the batch of N.
+The axes of size 1 are dropped, and the axes that are adjacent in both the input and the output are merged.
+  e.g. NCHW -> NHWC with the permutation {0, 2, 3, 1} becomes the transpose of a {N, C, H*W} tensor with the
+       permutation {0, 2, 1}.
 
-Similarly if one axis is moving inwards we can use a single writer and multiple readers. The number of readers is equal
-to the value of the axis being moved.
+If the innermost input axis stays innermost, the output is made of blocks of contiguous input elements. Blocks of 2, 4
+or 8 bytes are treated as single elements of a larger type, e.g. the attention transpose {0, 2, 1, 3} of a float
+tensor of shape {B, S, N, 2}, and larger blocks are copied with memcpy.
 
-  e.g. if the input is NCHW with shape {N, 3, 300, 300}, we can transpose to NHWC by writing once using one reader for
-       each of the 3 channels at a different offset in the input, updating the read offset for each item in the batch
-       of N.
+Otherwise the innermost output axis and the innermost input axis span 2D planes, which are transposed in tiles of
+kTransposeTileSize x kTransposeTileSize elements so the reads and the writes of a tile stay in the cache. The tiles
+use the MLAS SIMD kernels for 1 and 4 byte elements.
 
-This can be generalized for any input where only one axis is being moved, with the block size for each read/write
-being dependent on which axis is moving, what direction it's moving in, and where it's moving to.
-
-We use simple pointer arithmetic if the size of each read/write is a power of 2 and between 8 and 64 bits.
-We use memcpy if the block size is larger.
-
-We fall back to the default implementation in all other cases, and if the input is std::string.
+The blocks or tiles are split between the threads of the thread pool.
 */
 
 namespace {
 
-template <typename T>
-struct has_mlas_transpose : std::false_type {};
+// Number of elements along each of the two axes of a tile.
+constexpr int64_t kTransposeTileSize = 64;
 
-template <>
-struct has_mlas_transpose<uint8_t> : std::true_type {};
+// The dims and input strides of the output axes, after dropping and merging axes.
+struct CollapsedTranspose {
+  std::vector<int64_t> dims;
+  std::vector<int64_t> input_strides;  // in elements
+  size_t element_size;
+};
 
-template <>
-struct has_mlas_transpose<uint32_t> : std::true_type {};
+CollapsedTranspose CollapseTransposeAxes(const std::vector<size_t>& permutations,
+                                         const std::vector<int64_t>& input_dims, size_t element_size) {
+  const size_t rank = input_dims.size();
+  std::vector<int64_t> strides(rank);
+  int64_t stride = 1;
+  for (size_t i = rank; i-- > 0;) {
+    strides[i] = stride;
+    stride *= input_dims[i];
+  }
 
-// moving a single axis outwards where the read/write size is a power of 2 and between 8 and 64 bits.
-template <typename T>
-typename std::enable_if<!has_mlas_transpose<T>::value, void>::type
-SimpleTransposeSingleAxisOutwards(const T* input_data, T* output_data,
-                                  int64_t num_loops, int64_t num_writers,
-                                  int64_t writes_per_loop, int64_t writes_per_writer_per_loop) {
-  const T* end;
-  for (int64_t l = 0; l < num_loops; ++l) {
-    T* output_for_first_writer = output_data;
-
-    for (auto wwpl = 0; wwpl < writes_per_writer_per_loop; ++wwpl) {
-      T* output_for_current_writer = output_for_first_writer;
-
-      end = input_data + num_writers;
-      for (; input_data != end;) {
-        *output_for_current_writer = *input_data++;
-
-        // skip to output position for next writer
-        output_for_current_writer += writes_per_writer_per_loop;
-      }
+  CollapsedTranspose collapsed;
+  collapsed.element_size = element_size;
+  for (size_t i = 0; i < rank; ++i) {
+    const size_t axis = permutations[i];
+    if (input_dims[axis] == 1) {
+      continue;
+    }
 
-      ++output_for_first_writer;
+    if (!collapsed.dims.empty() && collapsed.input_strides.back() == input_dims[axis] * strides[axis]) {
+      // the axis is also the next one in the input, so merge it into the previous axis
+      collapsed.dims.back() *= input_dims[axis];
+      collapsed.input_strides.back() = strides[axis];
+    } else {
+      collapsed.dims.push_back(input_dims[axis]);
+      collapsed.input_strides.push_back(strides[axis]);
     }
+  }
 
-    output_data += writes_per_loop;
+  // treat small blocks of contiguous elements as single elements. the input strides of all the other axes are
+  // multiples of the block size as they are outside of the innermost input axis.
+  if (collapsed.dims.size() > 1 && collapsed.input_strides.back() == 1) {
+    const int64_t block_elements = collapsed.dims.back();
+    const size_t block_size = static_cast<size_t>(block_elements) * element_size;
+    if (block_size == 2 || block_size == 4 || block_size == 8) {
+      collapsed.dims.pop_back();
+      collapsed.input_strides.pop_back();
+      for (auto& input_stride : collapsed.input_strides) {
+        input_stride /= block_elements;
+      }
+
+      collapsed.element_size = block_size;
+    }
   }
+
+  return collapsed;
 }
 
-template <typename T>
-typename std::enable_if<has_mlas_transpose<T>::value, void>::type
-SimpleTransposeSingleAxisOutwards(const T* input_data, T* output_data,
-                                  int64_t num_loops, int64_t num_writers,
-                                  int64_t writes_per_loop, int64_t writes_per_writer_per_loop) {
-  for (int64_t l = 0; l < num_loops; ++l) {
-    MlasTranspose(input_data,
-                  output_data,
-                  static_cast<size_t>(writes_per_writer_per_loop),
-                  static_cast<size_t>(num_writers));
-    input_data += writes_per_loop;
-    output_data += writes_per_loop;
+// Walks the units of work of a transpose in order, tracking their offsets in the input and the output.
+class TransposeUnitIterator {
+ public:
+  TransposeUnitIterator(const std::vector<int64_t>& dims, const std::vector<int64_t>& input_strides,
+                        const std::vector<int64_t>& output_strides, int64_t first)
+      : dims_(dims), input_strides_(input_strides), output_strides_(output_strides), index_(dims.size()) {
+    for (size_t i = dims.size(); i-- > 0;) {
+      index_[i] = first % dims[i];
+      first /= dims[i];
+      input_offset_ += index_[i] * input_strides[i];
+      output_offset_ += index_[i] * output_strides[i];
+    }
   }
-}
 
-//  `input_shape_override` overrides the shape of `input` for compute purposes.
-void TransposeSingleAxisOutwards(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
-                                 int64_t from, int64_t to, const TensorShape* input_shape_override = nullptr) {
-  ORT_UNUSED_PARAMETER(permutations);
+  void Next() {
+    for (size_t i = dims_.size(); i-- > 0;) {
+      input_offset_ += input_strides_[i];
+      output_offset_ += output_strides_[i];
+      if (++index_[i] < dims_[i]) {
+        return;
+      }
 
-  const auto& input_shape = input_shape_override ? *input_shape_override : input.Shape();
-  const auto& input_dims = input_shape.GetDims();
+      input_offset_ -= dims_[i] * input_strides_[i];
+      output_offset_ -= dims_[i] * output_strides_[i];
+      index_[i] = 0;
+    }
+  }
 
-  const auto element_size = input.DataType()->Size();
+  const std::vector<int64_t>& Index() const { return index_; }
+  int64_t InputOffset() const { return input_offset_; }
+  int64_t OutputOffset() const { return output_offset_; }
+
+ private:
+  const std::vector<int64_t>& dims_;
+  const std::vector<int64_t>& input_strides_;
+  const std::vector<int64_t>& output_strides_;
+  std::vector<int64_t> index_;
+  int64_t input_offset_ = 0;
+  int64_t output_offset_ = 0;
+};
 
-  const auto* input_data = reinterpret_cast<const uint8_t*>(input.DataRaw());
-  auto* output_data = reinterpret_cast<uint8_t*>(output.MutableDataRaw());
+template <typename T>
+struct has_mlas_transpose : std::false_type {};
 
-  auto num_loops = input_shape.SizeToDimension(to);
-  auto num_writers = input_dims[from];
-  auto block_size = input_shape.SizeFromDimension(from + 1);
-  auto writes_per_loop = int64_t(input_shape.Size() / num_loops / block_size);
-  auto writes_per_writer_per_loop = int64_t(writes_per_loop / num_writers);
-  const int64_t bytes_per_write = block_size * element_size;
-
-  switch (bytes_per_write) {
-    case (sizeof(uint8_t)): {
-      SimpleTransposeSingleAxisOutwards(input_data, output_data,
-                                        num_loops, num_writers, writes_per_loop, writes_per_writer_per_loop);
-      break;
-    }
-    case (sizeof(uint16_t)): {
-      SimpleTransposeSingleAxisOutwards(reinterpret_cast<const uint16_t*>(input_data),
-                                        reinterpret_cast<uint16_t*>(output_data),
-                                        num_loops, num_writers, writes_per_loop, writes_per_writer_per_loop);
-      break;
-    }
-    case (sizeof(uint32_t)): {
-      SimpleTransposeSingleAxisOutwards(reinterpret_cast<const uint32_t*>(input_data),
-                                        reinterpret_cast<uint32_t*>(output_data),
-                                        num_loops, num_writers, writes_per_loop, writes_per_writer_per_loop);
-      break;
-    }
-    case (sizeof(uint64_t)): {
-      SimpleTransposeSingleAxisOutwards(reinterpret_cast<const uint64_t*>(input_data),
-                                        reinterpret_cast<uint64_t*>(output_data),
-                                        num_loops, num_writers, writes_per_loop, writes_per_writer_per_loop);
-      break;
-    }
-    default: {
-      // we need to use memcpy for each block
-      for (int64_t l = 0; l < num_loops; ++l) {
-        uint8_t* output_for_first_writer = output_data;
-
-        for (auto wwpl = 0; wwpl < writes_per_writer_per_loop; ++wwpl) {
-          uint8_t* output_for_current_writer = output_for_first_writer;
-
-          for (int64_t w = 0; w < num_writers; ++w) {
-            memcpy(output_for_current_writer, input_data, bytes_per_write);
-            // skip to output position for next writer
-            output_for_current_writer += (writes_per_writer_per_loop * bytes_per_write);
-            input_data += bytes_per_write;
-          }
-
-          output_for_first_writer += bytes_per_write;
-        }
+template <>
+struct has_mlas_transpose<uint8_t> : std::true_type {};
 
-        output_data += writes_per_loop * bytes_per_write;
-      }
-    }
-  }
-}
+template <>
+struct has_mlas_transpose<uint32_t> : std::true_type {};
 
+// transposes a tile of `rows` rows of `cols` contiguous elements in the input into `cols` rows of `rows` contiguous
+// elements in the output.
 template <typename T>
 typename std::enable_if<!has_mlas_transpose<T>::value, void>::type
-SimpleTransposeSingleAxisInwards(const T* input_data, T* output_data,
-                                 int64_t num_loops, int64_t num_readers,
-                                 int64_t reads_per_loop, int64_t reads_per_reader_per_loop) {
-  T* end;
-  for (int64_t l = 0; l < num_loops; ++l) {
-    const T* input_for_first_reader = input_data;
-
-    for (auto rrpl = 0; rrpl < reads_per_reader_per_loop; ++rrpl) {
-      const T* input_for_current_reader = input_for_first_reader;
-
-      end = output_data + num_readers;
-      for (; output_data != end;) {
-        *output_data++ = *input_for_current_reader;
-        // skip to input position for next reader
-        input_for_current_reader += reads_per_reader_per_loop;
-      }
-
-      ++input_for_first_reader;
+TransposeTile(const T* input, int64_t input_stride, T* output, int64_t output_stride, int64_t rows, int64_t cols) {
+  for (int64_t r = 0; r < rows; ++r) {
+    const T* input_row = input + r * input_stride;
+    T* output_col = output + r;
+    for (int64_t c = 0; c < cols; ++c) {
+      output_col[c * output_stride] = input_row[c];
     }
-
-    input_data += reads_per_loop;
   }
 }
 
 template <typename T>
 typename std::enable_if<has_mlas_transpose<T>::value, void>::type
-SimpleTransposeSingleAxisInwards(const T* input_data, T* output_data,
-                                 int64_t num_loops, int64_t num_readers,
-                                 int64_t reads_per_loop, int64_t reads_per_reader_per_loop) {
-  for (int64_t l = 0; l < num_loops; ++l) {
-    MlasTranspose(input_data,
-                  output_data,
-                  static_cast<size_t>(num_readers),
-                  static_cast<size_t>(reads_per_reader_per_loop));
-    input_data += reads_per_loop;
-    output_data += reads_per_loop;
-  }
+TransposeTile(const T* input, int64_t input_stride, T* output, int64_t output_stride, int64_t rows, int64_t cols) {
+  MlasTranspose(input, static_cast<size_t>(input_stride), output, static_cast<size_t>(output_stride),
+                static_cast<size_t>(rows), static_cast<size_t>(cols));
 }
 
-// moving a single axis inwards where the read/write size is a power of 2 and between 8 and 64 bits.
-//  `input_shape_override` overrides the shape of `input` for compute purposes.
-void TransposeSingleAxisInwards(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
-                                int64_t from, int64_t to, const TensorShape* input_shape_override = nullptr) {
-  ORT_UNUSED_PARAMETER(permutations);
-
-  const auto& input_shape = input_shape_override ? *input_shape_override : input.Shape();
-  const auto& input_dims = input_shape.GetDims();
-
-  const auto element_size = input.DataType()->Size();
-
-  const auto* input_data = reinterpret_cast<const uint8_t*>(input.DataRaw());
-  auto* output_data = reinterpret_cast<uint8_t*>(output.MutableDataRaw());
+template <typename T>
+void TransposeTiles(const CollapsedTranspose& collapsed, const T* input_data, T* output_data,
+                    concurrency::ThreadPool* tp) {
+  const auto& dims = collapsed.dims;
+  const size_t rank = dims.size();
+
+  std::vector<int64_t> output_strides(rank);
+  int64_t output_stride = 1;
+  for (size_t i = rank; i-- > 0;) {
+    output_strides[i] = output_stride;
+    output_stride *= dims[i];
+  }
 
-  auto num_loops = input_shape.SizeToDimension(from);
-  auto num_readers = input_dims[from];
-  auto block_size = input_shape.SizeFromDimension(to + 1);
-  auto reads_per_loop = int64_t(input_shape.Size() / num_loops / block_size);
-  auto reads_per_reader_per_loop = int64_t(reads_per_loop / num_readers);
-  const int64_t bytes_per_read = block_size * element_size;
-
-  switch (bytes_per_read) {
-    case (sizeof(uint8_t)): {
-      SimpleTransposeSingleAxisInwards(input_data, output_data,
-                                       num_loops, num_readers, reads_per_loop, reads_per_reader_per_loop);
-      break;
-    }
-    case (sizeof(uint16_t)): {
-      SimpleTransposeSingleAxisInwards(reinterpret_cast<const uint16_t*>(input_data),
-                                       reinterpret_cast<uint16_t*>(output_data),
-                                       num_loops, num_readers, reads_per_loop, reads_per_reader_per_loop);
-      break;
-    }
-    case (sizeof(uint32_t)): {
-      SimpleTransposeSingleAxisInwards(reinterpret_cast<const uint32_t*>(input_data),
-                                       reinterpret_cast<uint32_t*>(output_data),
-                                       num_loops, num_readers, reads_per_loop, reads_per_reader_per_loop);
-      break;
+  // the plane of the innermost output axis, the rows of a tile, and the innermost input axis, the columns of a tile.
+  const size_t row_axis = rank - 1;
+  const auto col_axis = static_cast<size_t>(std::find(collapsed.input_strides.cbegin(),
+                                                      collapsed.input_strides.cend(), int64_t{1}) -
+                                            collapsed.input_strides.cbegin());
+  ORT_ENFORCE(col_axis < row_axis, "The innermost input axis was not found.");
+
+  const int64_t num_rows = dims[row_axis];
+  const int64_t num_cols = dims[col_axis];
+  const int64_t row_input_stride = collapsed.input_strides[row_axis];
+  const int64_t col_output_stride = output_strides[col_axis];
+
+  // the units are the tiles of the planes for every index of the other axes.
+  std::vector<int64_t> unit_dims;
+  std::vector<int64_t> unit_input_strides;
+  std::vector<int64_t> unit_output_strides;
+  for (size_t i = 0; i < rank; ++i) {
+    if (i != row_axis && i != col_axis) {
+      unit_dims.push_back(dims[i]);
+      unit_input_strides.push_back(collapsed.input_strides[i]);
+      unit_output_strides.push_back(output_strides[i]);
     }
-    case (sizeof(uint64_t)): {
-      SimpleTransposeSingleAxisInwards(reinterpret_cast<const uint64_t*>(input_data),
-                                       reinterpret_cast<uint64_t*>(output_data),
-                                       num_loops, num_readers, reads_per_loop, reads_per_reader_per_loop);
-      break;
-    }
-    default: {
-      // we need to use memcpy for each block
-      for (int64_t l = 0; l < num_loops; ++l) {
-        const uint8_t* input_for_first_reader = input_data;
-
-        for (auto rrpl = 0; rrpl < reads_per_reader_per_loop; ++rrpl) {
-          const uint8_t* input_for_current_reader = input_for_first_reader;
+  }
 
-          for (int64_t r = 0; r < num_readers; ++r) {
-            memcpy(output_data, input_for_current_reader, bytes_per_read);
-            output_data += bytes_per_read;
+  unit_dims.push_back((num_rows + kTransposeTileSize - 1) / kTransposeTileSize);
+  unit_input_strides.push_back(kTransposeTileSize * row_input_stride);
+  unit_output_strides.push_back(kTransposeTileSize);
+  unit_dims.push_back((num_cols + kTransposeTileSize - 1) / kTransposeTileSize);
+  unit_input_strides.push_back(kTransposeTileSize);
+  unit_output_strides.push_back(kTransposeTileSize * col_output_stride);
 
-            // skip to input position for next reader
-            input_for_current_reader += (reads_per_reader_per_loop * bytes_per_read);
-          }
+  int64_t num_units = 1;
+  for (auto unit_dim : unit_dims) {
+    num_units *= unit_dim;
+  }
 
-          input_for_first_reader += bytes_per_read;
+  const double tile_elements = static_cast<double>(std::min(num_rows, kTransposeTileSize) *
+                                                   std::min(num_cols, kTransposeTileSize));
+  const TensorOpCost cost{tile_elements * sizeof(T), tile_elements * sizeof(T), tile_elements};
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_units), cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        TransposeUnitIterator it(unit_dims, unit_input_strides, unit_output_strides, first);
+        for (std::ptrdiff_t unit = first; unit < last; ++unit) {
+          const int64_t row_tile = it.Index()[unit_dims.size() - 2];
+          const int64_t col_tile = it.Index()[unit_dims.size() - 1];
+          TransposeTile(input_data + it.InputOffset(), row_input_stride,
+                        output_data + it.OutputOffset(), col_output_stride,
+                        std::min(kTransposeTileSize, num_rows - row_tile * kTransposeTileSize),
+                        std::min(kTransposeTileSize, num_cols - col_tile * kTransposeTileSize));
+          it.Next();
         }
+      });
+}
 
-        input_data += reads_per_loop * bytes_per_read;
-      }
-    }
+void TransposeBlocks(const CollapsedTranspose& collapsed, const uint8_t* input_data, uint8_t* output_data,
+                     concurrency::ThreadPool* tp) {
+  const auto& dims = collapsed.dims;
+  const size_t rank = dims.size();
+  const size_t element_size = collapsed.element_size;
+  const size_t block_size = static_cast<size_t>(dims.back()) * element_size;
+
+  // the units are the blocks of the innermost axis, for every index of the other axes.
+  std::vector<int64_t> unit_dims(dims.cbegin(), dims.cend() - 1);
+  std::vector<int64_t> unit_input_strides(rank - 1);
+  std::vector<int64_t> unit_output_strides(rank - 1);
+  int64_t output_stride = static_cast<int64_t>(block_size);
+  for (size_t i = rank - 1; i-- > 0;) {
+    unit_input_strides[i] = collapsed.input_strides[i] * static_cast<int64_t>(element_size);
+    unit_output_strides[i] = output_stride;
+    output_stride *= dims[i];
   }
+
+  const int64_t num_units = output_stride / static_cast<int64_t>(block_size);
+  const TensorOpCost cost{static_cast<double>(block_size), static_cast<double>(block_size),
+                          static_cast<double>(block_size) / 16};
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_units), cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        TransposeUnitIterator it(unit_dims, unit_input_strides, unit_output_strides, first);
+        for (std::ptrdiff_t unit = first; unit < last; ++unit) {
+          memcpy(output_data + it.OutputOffset(), input_data + it.InputOffset(), block_size);
+          it.Next();
+        }
+      });
 }
 
 //  `input_shape_override` overrides the shape of `input` for compute purposes.
-void SingleAxisTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
-                         size_t from, size_t to, const TensorShape* input_shape_override = nullptr) {
-  if (from > to) {
-    TransposeSingleAxisOutwards(permutations, input, output, from, to, input_shape_override);
-  } else {
-    TransposeSingleAxisInwards(permutations, input, output, from, to, input_shape_override);
+Status DoFixedSizeTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
+                            const TensorShape* input_shape_override, concurrency::ThreadPool* tp) {
+  const auto& input_shape = input_shape_override ? *input_shape_override : input.Shape();
+  if (input_shape.Size() == 0) {
+    return Status::OK();
   }
-}
 
-bool IsMovingSingleAxis(const std::vector<size_t>& permutations, size_t& from, size_t& to) {
-  // if a single axis moved to an outer dimension, the values should be one lower than the index until the slot the
-  // axis was moved from, and equal to the index after that.
-  // e.g. axis 3 moves out to 1 would be: 0, 3, 1, 2, 4
-  auto check_moved_outwards = [&permutations](size_t cur, size_t moved_from) {
-    // we start processing with the slot after the moved one, so the expected value is one less than the index
-    size_t expected = cur - 1;
-    for (size_t end = permutations.size(); cur < end; ++cur) {
-      if (permutations[cur] != expected) {
-        return false;
-      }
-
-      // we are at the slot the axis moved from, so do an additional increment before checking the next value
-      if (cur == moved_from) {
-        ++expected;
-      }
-
-      ++expected;
-    }
+  const auto* input_data = reinterpret_cast<const uint8_t*>(input.DataRaw());
+  auto* output_data = reinterpret_cast<uint8_t*>(output.MutableDataRaw());
 
-    return true;
-  };
-
-  // if a single axis moved to an inner dimension, the values should be one higher than the index until the slot the
-  // axis was moved to, and equal to the index after that.
-  // e.g. axis 1 moves inwards to 3 would be: 0, 2, 3, 1, 4
-  auto check_moved_inwards = [&permutations](size_t cur, size_t& moved_to) {
-    size_t started_at = cur;
-    size_t expected = cur + 1;
-    moved_to = std::numeric_limits<size_t>::max();
-
-    for (size_t end = permutations.size(); cur < end; ++cur) {
-      if (permutations[cur] != expected) {
-        // if a single axis moved it must have come from the location we started at
-        if (started_at != permutations[cur]) {
-          return false;
-        }
+  const auto collapsed = CollapseTransposeAxes(permutations, input_shape.GetDims(), input.DataType()->Size());
 
-        moved_to = cur;
-      } else {
-        ++expected;
-      }
-    }
+  if (collapsed.dims.size() <= 1) {
+    // the order of the elements doesn't change
+    memcpy(output_data, input_data, static_cast<size_t>(input_shape.Size()) * input.DataType()->Size());
+    return Status::OK();
+  }
 
-    return moved_to != std::numeric_limits<size_t>::max();
-  };
-
-  bool single_axis_moved = false;
-  // check axis moving outwards (earlier entry in permutations)
-  for (size_t i = 0, end = permutations.size(); i < end; ++i) {
-    size_t axis = permutations[i];
-
-    if (axis != i) {
-      if (check_moved_outwards(i + 1, axis)) {
-        single_axis_moved = true;
-        to = i;
-        from = axis;
-      } else if (check_moved_inwards(i, to)) {
-        single_axis_moved = true;
-        from = i;
-      }
+  if (collapsed.input_strides.back() == 1) {
+    TransposeBlocks(collapsed, input_data, output_data, tp);
+    return Status::OK();
+  }
 
+  switch (collapsed.element_size) {
+    case sizeof(uint8_t):
+      TransposeTiles(collapsed, input_data, output_data, tp);
       break;
-    }
+    case sizeof(uint16_t):
+      TransposeTiles(collapsed, reinterpret_cast<const uint16_t*>(input_data),
+                     reinterpret_cast<uint16_t*>(output_data), tp);
+      break;
+    case sizeof(uint32_t):
+      TransposeTiles(collapsed, reinterpret_cast<const uint32_t*>(input_data),
+                     reinterpret_cast<uint32_t*>(output_data), tp);
+      break;
+    case sizeof(uint64_t):
+      TransposeTiles(collapsed, reinterpret_cast<const uint64_t*>(input_data),
+                     reinterpret_cast<uint64_t*>(output_data), tp);
+      break;
+    default:
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Transpose of element size not supported. Size=",
+                             collapsed.element_size);
   }
 
-  return single_axis_moved;
+  return Status::OK();
 }
 
 }  // namespace
@@ -668,7 +583,7 @@ bool IsTransposeReshape(const std::vector<size_t>& perm, const std::vector<int64
 
 //`input_shape_override` overrides the shape of `input` for compute purposes.
 Status TransposeBase::DoTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
-                                  const TensorShape* input_shape_override) {
+                                  const TensorShape* input_shape_override, concurrency::ThreadPool* tp) {
   Status status = Status::OK();
 
   auto input_type = input.DataType();
@@ -686,14 +601,10 @@ Status TransposeBase::DoTranspose(const std::vector<size_t>& permutations, const
       return Status::OK();
     }
 
-    size_t from = 0, to = 0;
-    bool moving_single_axis = IsMovingSingleAxis(permutations, from, to);
-
-    if (moving_single_axis && !input.IsDataTypeString()) {
-      SingleAxisTranspose(permutations, input, output, from, to, input_shape_override);
+    if (input.IsDataTypeString()) {
+      status = DoStringTranspose(permutations, input, output, input_shape_override);
     } else {
-      // fall back to default implementation
-      status = DoUntypedTranspose(permutations, input, output, input_shape_override);
+      status = DoFixedSizeTranspose(permutations, input, output, input_shape_override, tp);
     }
   }
 
@@ -721,24 +632,7 @@ Status Transpose::Compute(OpKernelContext* ctx) const {
   if (output_shape.Size() == 0)
     return Status::OK();
 
-  if (IsTransposeReshape(*p_perm, input_dims)) {
-    // As long as the dims with values > 1 stay in the same order, it's a reshape.
-    // Example: Shape=(1,1,1024,4096) -> perm=(2,0,3,1).
-    CopyCpuTensor(&X, &Y);
-    return Status::OK();
-  }
-
-  size_t from = 0, to = 0;
-  bool moving_single_axis = IsMovingSingleAxis(*p_perm, from, to);
-
-  if (moving_single_axis && !X.IsDataTypeString()) {
-    SingleAxisTranspose(*p_perm, X, Y, from, to);
-  } else {
-    // fall back to default implementation
-    status = DoUntypedTranspose(*p_perm, X, Y);
-  }
-
-  return status;
+  return DoTranspose(*p_perm, X, Y, nullptr, ctx->GetOperatorThreadPool());
 }
 
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
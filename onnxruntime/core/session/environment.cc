@@ -136,6 +136,9 @@ Status Environment::CreateAndRegisterAllocator(const OrtMemoryInfo& mem_info, co
     int initial_chunk_size_bytes = -1;
     int max_dead_bytes_per_chunk = -1;
     int initial_growth_chunk_size_bytes = -1;
+    int thread_cache_max_chunks_per_bin = -1;
+    int use_huge_pages = -1;
+    int numa_node = -1;
 
     // override with values from the user supplied arena_cfg object
     if (arena_cfg) {
@@ -152,10 +155,16 @@ Status Environment::CreateAndRegisterAllocator(const OrtMemoryInfo& mem_info, co
       initial_chunk_size_bytes = arena_cfg->initial_chunk_size_bytes;
       max_dead_bytes_per_chunk = arena_cfg->max_dead_bytes_per_chunk;
       initial_growth_chunk_size_bytes = arena_cfg->initial_growth_chunk_size_bytes;
+      thread_cache_max_chunks_per_bin = arena_cfg->thread_cache_max_chunks_per_bin;
+      use_huge_pages = arena_cfg->use_huge_pages;
+      numa_node = arena_cfg->numa_node;
     }
 
     OrtArenaCfg l_arena_cfg{max_mem, arena_extend_strategy, initial_chunk_size_bytes, max_dead_bytes_per_chunk,
                             initial_growth_chunk_size_bytes};
+    l_arena_cfg.thread_cache_max_chunks_per_bin = thread_cache_max_chunks_per_bin;
+    l_arena_cfg.use_huge_pages = use_huge_pages;
+    l_arena_cfg.numa_node = numa_node;
     AllocatorCreationInfo alloc_creation_info{
         [mem_info](int) { return std::make_unique<TAllocator>(mem_info); },
         0,
@@ -179,7 +179,8 @@ std::atomic<uint32_t> InferenceSession::global_session_id_{1};
 // Version 2 - add serialization/deserialization of sparse_initializer
 // Version 3 - add `graph_doc_string` to Model
 // Version 4 - update kernel def hashing to not depend on ordering of type constraint types (NOT BACKWARDS COMPATIBLE)
-static constexpr const char* kOrtModelVersion = "4";
+// Version 5 - add `prepacked_weights` to SessionState
+static constexpr const char* kOrtModelVersion = "5";
 
 #if defined(ENABLE_ORT_FORMAT_LOAD)
 // Check if the given ort model version is supported in this build
@@ -187,6 +188,7 @@ static bool IsOrtModelVersionSupported(const std::string& ort_model_version) {
   // The ort model versions we will support in this build
   // This may contain more versions than the kOrtModelVersion, based on the compatibilities
   static const std::unordered_set<std::string> kSupportedOrtModelVersions{
+      std::string("4"),
       std::string(kOrtModelVersion),
   };
 
@@ -323,7 +325,10 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
       thread_pool_ =
           concurrency::CreateThreadPool(&Env::Default(), to, concurrency::ThreadPoolType::INTRA_OP);
     }
-    if (session_options_.execution_mode == ExecutionMode::ORT_PARALLEL) {
+    // The dataflow executor runs the nodes on the intra-op thread pool.
+    const bool use_dataflow_executor =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseDataflowExecutor, "0") == "1";
+    if (session_options_.execution_mode == ExecutionMode::ORT_PARALLEL && !use_dataflow_executor) {
       bool allow_inter_op_spinning =
           session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigAllowInterOpSpinning, "1") == "1";
       OrtThreadPoolParams to = session_options_.inter_op_param;
@@ -361,6 +366,16 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
     StartProfiling(session_options_.profile_file_prefix);
   }
 
+  size_t sampled_profiling_interval = 0;
+  ORT_ENFORCE(TryParseStringWithClassicLocale(
+                  session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigSampledProfilingInterval,
+                                                                     "0"),
+                  sampled_profiling_interval),
+              "Invalid value for ", kOrtSessionOptionsConfigSampledProfilingInterval);
+  if (sampled_profiling_interval > 0) {
+    session_profiler_.EnableSampling(sampled_profiling_interval);
+  }
+
   telemetry_ = {};
   allocator_manager_ = std::make_shared<onnxruntime::AllocatorManager>();
 }
@@ -969,11 +984,24 @@ template <typename T>
 static Status LoadOrtModelBytes(const std::basic_string<T>& model_uri,
                                 std::basic_string<ORTCHAR_T>& model_location,
                                 gsl::span<const uint8_t>& bytes,
-                                std::vector<uint8_t>& bytes_data_holder) {
+                                std::vector<uint8_t>& bytes_data_holder,
+                                Env::MappedMemoryPtr* mapped_bytes = nullptr) {
   size_t num_bytes = 0;
   model_location = ToWideString(model_uri);
   ORT_RETURN_IF_ERROR(Env::Default().GetFileLength(model_location.c_str(), num_bytes));
 
+  // if requested, map the file into memory so the bytes are backed by the page cache, which is shared by all the
+  // processes using the model. fall back to reading the file if that fails, e.g. as the platform doesn't support it.
+  if (mapped_bytes != nullptr) {
+    Status status = Env::Default().MapFileIntoMemory(model_location.c_str(), 0, num_bytes, *mapped_bytes);
+    if (status.IsOK() && *mapped_bytes) {
+      bytes = gsl::span<const uint8_t>(reinterpret_cast<const uint8_t*>(mapped_bytes->get()), num_bytes);
+      return Status::OK();
+    }
+
+    mapped_bytes->reset();
+  }
+
   bytes_data_holder.resize(num_bytes);
 
   std::ifstream bytes_stream(model_uri, std::ifstream::in | std::ifstream::binary);
@@ -993,9 +1021,20 @@ static Status LoadOrtModelBytes(const std::basic_string<T>& model_uri,
 Status InferenceSession::LoadOrtModel(const std::string& model_uri) {
   return LoadOrtModel(
       [&]() {
+        const bool initializers_in_place =
+            GetSessionOptions().config_options.GetConfigOrDefault(
+                kOrtSessionOptionsConfigUseOrtFormatInitializersInPlace, "0") == "1";
         ORT_RETURN_IF_ERROR(
             LoadOrtModelBytes(model_uri, model_location_,
-                              ort_format_model_bytes_, ort_format_model_bytes_data_holder_));
+                              ort_format_model_bytes_, ort_format_model_bytes_data_holder_,
+                              initializers_in_place ? &ort_format_model_mapped_bytes_ : nullptr));
+
+        if (initializers_in_place && !ort_format_model_mapped_bytes_) {
+          LOGS(*session_logger_, WARNING) << "Failed to memory map the ORT format model. "
+                                          << "The initializers will be copied from the model.";
+        }
+
+        use_ort_format_model_bytes_for_initializers_ = bool(ort_format_model_mapped_bytes_);
         return Status::OK();
       });
 }
@@ -1004,9 +1043,20 @@ Status InferenceSession::LoadOrtModel(const std::string& model_uri) {
 Status InferenceSession::LoadOrtModel(const std::wstring& model_uri) {
   return LoadOrtModel(
       [&]() {
+        const bool initializers_in_place =
+            GetSessionOptions().config_options.GetConfigOrDefault(
+                kOrtSessionOptionsConfigUseOrtFormatInitializersInPlace, "0") == "1";
         ORT_RETURN_IF_ERROR(
             LoadOrtModelBytes(model_uri, model_location_,
-                              ort_format_model_bytes_, ort_format_model_bytes_data_holder_));
+                              ort_format_model_bytes_, ort_format_model_bytes_data_holder_,
+                              initializers_in_place ? &ort_format_model_mapped_bytes_ : nullptr));
+
+        if (initializers_in_place && !ort_format_model_mapped_bytes_) {
+          LOGS(*session_logger_, WARNING) << "Failed to memory map the ORT format model. "
+                                          << "The initializers will be copied from the model.";
+        }
+
+        use_ort_format_model_bytes_for_initializers_ = bool(ort_format_model_mapped_bytes_);
         return Status::OK();
       });
 }
@@ -1024,8 +1074,12 @@ Status InferenceSession::LoadOrtModel(const void* model_data, int model_data_len
       ort_format_model_bytes_ = gsl::span<const uint8_t>(ort_format_model_bytes_data_holder_.data(), model_data_len);
     } else {
       // Use the model_data directly to reduce memory consumption
-      // This will require the model_data to be alive until the InferenceSession is initialized
+      // This will require the model_data to be alive until the InferenceSession is initialized, or until it is
+      // destroyed if the initializers use the model_data in place
       ort_format_model_bytes_ = gsl::span<const uint8_t>(reinterpret_cast<const uint8_t*>(model_data), model_data_len);
+      use_ort_format_model_bytes_for_initializers_ =
+          GetSessionOptions().config_options.GetConfigOrDefault(
+              kOrtSessionOptionsConfigUseOrtFormatInitializersInPlace, "0") == "1";
     }
     return Status::OK();
   });
@@ -1067,15 +1121,23 @@ Status InferenceSession::LoadOrtModel(std::function<Status()> load_ort_format_mo
   const auto* fbs_model = fbs_session->model();
   ORT_RETURN_IF(nullptr == fbs_model, "Missing Model. Invalid ORT format model.");
 
+  // the initializers can only refer to the data in the bytes once they are registered.
+  if (use_ort_format_model_bytes_for_initializers_) {
+    ort_format_model_bytes_range_ = std::make_unique<utils::ExternalDataInMemoryRange>(
+        ort_format_model_bytes_.data(), ort_format_model_bytes_.size());
+  }
+
   // need to go from unique_ptr to shared_ptr when moving into model_
   std::unique_ptr<Model> tmp_model;
 #if !defined(ORT_MINIMAL_BUILD)
   ORT_RETURN_IF_ERROR(Model::LoadFromOrtFormat(*fbs_model,
                                                HasLocalSchema() ? &custom_schema_registries_ : nullptr,
+                                               use_ort_format_model_bytes_for_initializers_,
                                                *session_logger_, tmp_model));
 
 #else
-  ORT_RETURN_IF_ERROR(Model::LoadFromOrtFormat(*fbs_model, *session_logger_, tmp_model));
+  ORT_RETURN_IF_ERROR(Model::LoadFromOrtFormat(*fbs_model, use_ort_format_model_bytes_for_initializers_,
+                                               *session_logger_, tmp_model));
 #endif
 
   ORT_RETURN_IF_ERROR(SaveModelMetadata(*tmp_model));
@@ -1432,11 +1494,15 @@ common::Status InferenceSession::Initialize() {
     }
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
+    if (auto* sampled_profiler = session_profiler_.GetSampledProfiler()) {
+      session_state_->RegisterOpTypesForSampling(*sampled_profiler);
+    }
+
     session_state_->ResolveMemoryPatternFlag();
     is_inited_ = true;
 
-    // we don't directly use the ORT format bytes currently, so free those now
-    // TODO, we may need to keep the bytes if we are using the offset directly in the initializers
+    // the initializers have been created, so free the ORT format bytes now. if the initializers use the bytes in
+    // place, they are either memory mapped and kept alive by ort_format_model_mapped_bytes_ or owned by the caller.
     ort_format_model_bytes_ = gsl::span<const uint8_t>();
     std::vector<uint8_t>().swap(ort_format_model_bytes_data_holder_);
 
@@ -20,6 +20,7 @@
 #include "core/optimizer/graph_transformer_level.h"
 #include "core/optimizer/graph_transformer_mgr.h"
 #include "core/optimizer/insert_cast_transformer.h"
+#include "core/platform/env.h"
 #include "core/framework/session_options.h"
 #include "core/framework/allocatormgr.h"
 #ifdef ENABLE_LANGUAGE_INTEROP_OPS
@@ -57,6 +58,10 @@ namespace logging {
 class LoggingManager;
 }
 
+namespace utils {
+class ExternalDataInMemoryRange;
+}
+
 /**
   * Pre-defined and custom metadata about the model.
   */
@@ -478,6 +483,19 @@ class InferenceSession {
   /// convenience pointer to logger. should always be the same as session_state_.Logger();
   const logging::Logger* session_logger_;
 
+#if defined(ENABLE_ORT_FORMAT_LOAD)
+  // Memory mapping of an ORT format model file, which backs ort_format_model_bytes_ when the initializers use the
+  // model bytes in place. Declared before the model and the session state so that it outlives the tensors using it.
+  Env::MappedMemoryPtr ort_format_model_mapped_bytes_;
+
+  // Whether the initializers of an ORT format model can use the data in ort_format_model_bytes_ in place, which
+  // requires the bytes to stay valid until the session is destroyed.
+  bool use_ort_format_model_bytes_for_initializers_ = false;
+
+  // Registers ort_format_model_bytes_ as the memory the initializers can refer to, if they use the bytes in place.
+  std::unique_ptr<utils::ExternalDataInMemoryRange> ort_format_model_bytes_range_;
+#endif
+
   // The model served by this inference session instance.
   // Currently this has to be a shared ptr because the Model::Load method
   // returns a shared_ptr only. Ideally factory functions should always return
@@ -717,9 +735,9 @@ class InferenceSession {
   //   We store them currently in the ort_format_model_bytes_data_holder_ to make the Load + Initialize
   //   behave the same way as for an ONNX model, as we need some of the bytes for the Load (create the Model)
   //   and some for the Initialize (create SessionState).
-  // Short term we free them after Initialize.
-  // Longer term we may want to directly refer to offsets in this buffer for initializers so we don't need to copy
-  // those into new OrtValue instances, at which point we won't free them until the InferenceSession goes away.
+  // We free them after Initialize, unless the session config option "session.use_ort_format_initializers_in_place"
+  // is set to "1" and the bytes are memory mapped from the model file or used directly, in which case the
+  // initializers refer to offsets in this buffer instead of copying those into new OrtValue instances.
   gsl::span<const uint8_t> ort_format_model_bytes_;
 
   // This holds the actual model data
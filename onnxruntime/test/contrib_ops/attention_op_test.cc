@@ -816,6 +816,135 @@ TEST(AttentionTest, AttentionPastStateBatch1) {
                    use_past_state, past_sequence_length, &past_data, &present_data);
 }
 
+TEST(AttentionTest, AttentionPastStateSharedBuffer) {
+  // Same as AttentionPastStateBatch1, but past and present have 5 rows of which the first 3 are valid.
+  int batch_size = 1;
+  int sequence_length = 1;
+  int hidden_size = 4;
+  int number_of_heads = 2;
+  int head_size = hidden_size / number_of_heads;
+  int past_sequence_length = 3;
+  int max_sequence_length = 5;
+
+  std::vector<float> input_data = {
+      -0.019333266f, -0.21813886f, 0.16212955f, -0.015626367f};
+
+  std::vector<float> weight_data = {
+      -0.4738484025001526f,
+      -0.2613658607006073f,
+      -0.0978037416934967f,
+      -0.34988933801651f,
+      0.2243240624666214f,
+      -0.0429205559194088f,
+      0.418695330619812f,
+      0.17441125214099884f,
+      -0.18825532495975494f,
+      0.18357256054878235f,
+      -0.5806483626365662f,
+      -0.02251487597823143f,
+
+      0.08742205798625946f,
+      0.14734269678592682f,
+      0.2387014478445053f,
+      0.2884027063846588f,
+      0.6490834355354309f,
+      0.16965825855731964f,
+      -0.06346885114908218f,
+      0.4073973298072815f,
+      -0.03070945478975773f,
+      0.4110257923603058f,
+      0.07896808534860611f,
+      0.16783113777637482f,
+
+      0.0038893644232302904f,
+      0.06946629285812378f,
+      0.36680519580841064f,
+      -0.07261059433221817f,
+      -0.14960581064224243f,
+      0.020944256335496902f,
+      -0.09378612786531448f,
+      -0.1336742341518402f,
+      0.06061394885182381f,
+      0.2205914407968521f,
+      -0.03519909828901291f,
+      -0.18405692279338837f,
+
+      0.22149960696697235f,
+      -0.1884360909461975f,
+      -0.014074507169425488f,
+      0.4252440333366394f,
+      0.24987126886844635f,
+      -0.31396418809890747f,
+      0.14036843180656433f,
+      0.2854192554950714f,
+      0.09709841012954712f,
+      0.09935075044631958f,
+      -0.012154420837759972f,
+      0.2575816512107849f};
+
+  std::vector<float> bias_data = {
+      0.4803391396999359f,
+      -0.5254325866699219f,
+      -0.42926454544067383f,
+      -0.2059524953365326f,
+      -0.12773379683494568f,
+      -0.09542735666036606f,
+      -0.35286077857017517f,
+      -0.07646317780017853f,
+      -0.04590314254164696f,
+      -0.03752850368618965f,
+      -0.013764488510787487f,
+      -0.18478283286094666f};
+
+  std::vector<float> output_data = {
+      0.20141591f, 0.43005896f, 0.35745093f, 0.19957167f};
+
+  std::vector<float> past_data = {
+      0.55445826f, 0.10127074f, 0.71770734f, 0.15915526f, 0.13913247f, 0.77447522f, 0.66044068f, 0.27559045f, 0.35731629f, 0.62033528f, 0.24354559f, 0.22859341f,
+      0.45075402f, 0.85365993f, 0.097346395f, 0.28859729f, 0.26926181f, 0.65922296f, 0.8177433f, 0.4212271f, 0.34352475f, 0.059609573f, 0.46556228f, 0.7226882f};
+
+  std::vector<float> present_data = {
+      0.55445826f, 0.10127074f, 0.71770734f, 0.15915526f, 0.13913247f, 0.77447522f, -0.30182117f, -0.12330482f, 0.66044068f, 0.27559045f, 0.35731629f, 0.62033528f, 0.24354559f, 0.22859341f, -0.36450946f, -0.19483691f,
+      0.45075402f, 0.85365993f, 0.097346395f, 0.28859729f, 0.26926181f, 0.65922296f, -0.027254611f, -0.096526355f, 0.8177433f, 0.4212271f, 0.34352475f, 0.059609573f, 0.46556228f, 0.7226882f, -0.025281552f, -0.25482416f};
+
+  // Pad each head of past and present to max_sequence_length rows. The rows after the valid ones are not read,
+  // and present is past with the new row written in place.
+  const float padding = 9.0f;
+  std::vector<float> shared_past_data;
+  std::vector<float> shared_present_data;
+  for (int i = 0; i < 2 * batch_size * number_of_heads; i++) {
+    auto past_begin = past_data.begin() + i * past_sequence_length * head_size;
+    shared_past_data.insert(shared_past_data.end(), past_begin, past_begin + past_sequence_length * head_size);
+    shared_past_data.insert(shared_past_data.end(), (max_sequence_length - past_sequence_length) * head_size, padding);
+
+    auto present_begin = present_data.begin() + i * (past_sequence_length + sequence_length) * head_size;
+    shared_present_data.insert(shared_present_data.end(), present_begin,
+                               present_begin + (past_sequence_length + sequence_length) * head_size);
+    shared_present_data.insert(shared_present_data.end(),
+                               (max_sequence_length - past_sequence_length - sequence_length) * head_size, padding);
+  }
+
+  std::vector<int64_t> past_dims = {2, batch_size, number_of_heads, max_sequence_length, head_size};
+
+  OpTester tester("Attention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", static_cast<int64_t>(number_of_heads));
+  tester.AddAttribute<int64_t>("unidirectional", static_cast<int64_t>(1));
+  tester.AddAttribute<int64_t>("past_present_share_buffer", static_cast<int64_t>(1));
+  tester.AddInput<float>("input", {batch_size, sequence_length, hidden_size}, input_data);
+  tester.AddInput<float>("weight", {hidden_size, 3 * hidden_size}, weight_data);
+  tester.AddInput<float>("bias", {3 * hidden_size}, bias_data);
+  tester.AddOptionalInputEdge<int32_t>();
+  tester.AddInput<float>("past", past_dims, shared_past_data);
+  tester.AddOptionalInputEdge<float>();
+  tester.AddInput<int32_t>("past_sequence_length", {1}, {past_sequence_length});
+  tester.AddOutput<float>("output", {batch_size, sequence_length, hidden_size}, output_data);
+  tester.AddOutput<float>("present", past_dims, shared_present_data);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 TEST(AttentionTest, AttentionPastStateBatch2) {
   int batch_size = 2;
   int sequence_length = 1;
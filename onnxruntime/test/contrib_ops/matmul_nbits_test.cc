@@ -0,0 +1,183 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+// Quantizes a [K, N] float matrix column by column into 4-bit blocks in the
+// MatMulNBits input format and returns the dequantized matrix for reference.
+void QuantizeBlockwise4Bits(const std::vector<float>& b_data, int64_t K, int64_t N, int64_t block_size,
+                            std::vector<uint8_t>& quant_b, std::vector<float>& scales,
+                            std::vector<uint8_t>& zero_points, std::vector<float>& dequant_b) {
+  const int64_t block_count_k = (K + block_size - 1) / block_size;
+  const int64_t zero_point_stride = (block_count_k + 1) / 2;
+
+  quant_b.assign(static_cast<size_t>(N * block_count_k * block_size / 2), 0);
+  scales.assign(static_cast<size_t>(N * block_count_k), 0.0f);
+  zero_points.assign(static_cast<size_t>(N * zero_point_stride), 0);
+  dequant_b.assign(static_cast<size_t>(K * N), 0.0f);
+
+  for (int64_t n = 0; n < N; n++) {
+    for (int64_t kb = 0; kb < block_count_k; kb++) {
+      const int64_t k_begin = kb * block_size;
+      const int64_t k_end = std::min(K, k_begin + block_size);
+
+      float min_value = 0.0f;
+      float max_value = 0.0f;
+      for (int64_t k = k_begin; k < k_end; k++) {
+        min_value = std::min(min_value, b_data[k * N + n]);
+        max_value = std::max(max_value, b_data[k * N + n]);
+      }
+
+      const float scale = (max_value - min_value) / 15.0f;
+      const float reciprocal_scale = scale != 0.0f ? 1.0f / scale : 0.0f;
+      const uint8_t zero_point = static_cast<uint8_t>(
+          std::min(15.0f, std::max(0.0f, std::round(-min_value * reciprocal_scale))));
+
+      scales[n * block_count_k + kb] = scale;
+      zero_points[n * zero_point_stride + kb / 2] |= static_cast<uint8_t>(zero_point << ((kb & 1) * 4));
+
+      for (int64_t k = k_begin; k < k_end; k++) {
+        const int64_t kk = k - k_begin;
+        const float q_value = std::round(b_data[k * N + n] * reciprocal_scale) + zero_point;
+        const uint8_t q = static_cast<uint8_t>(std::min(15.0f, std::max(0.0f, q_value)));
+
+        quant_b[(n * block_count_k + kb) * (block_size / 2) + kk / 2] |= static_cast<uint8_t>(q << ((kk & 1) * 4));
+        dequant_b[k * N + n] = (static_cast<float>(q) - static_cast<float>(zero_point)) * scale;
+      }
+    }
+  }
+}
+
+void RunMatMulNBitsTest(int64_t M, int64_t N, int64_t K, int64_t block_size,
+                        bool has_zero_points, bool is_b_constant) {
+  RandomValueGenerator random{1234};
+  std::vector<float> a_data = random.Gaussian<float>({M, K}, 0.0f, 0.25f);
+  std::vector<float> b_data = random.Gaussian<float>({K, N}, 0.0f, 0.25f);
+
+  std::vector<uint8_t> quant_b;
+  std::vector<float> scales;
+  std::vector<uint8_t> zero_points;
+  std::vector<float> dequant_b;
+  QuantizeBlockwise4Bits(b_data, K, N, block_size, quant_b, scales, zero_points, dequant_b);
+
+  // Without explicit zero points the operator uses 8, so requantize around it.
+  if (!has_zero_points) {
+    const int64_t block_count_k = (K + block_size - 1) / block_size;
+    const int64_t zero_point_stride = (block_count_k + 1) / 2;
+    for (int64_t n = 0; n < N; n++) {
+      for (int64_t k = 0; k < K; k++) {
+        const int64_t kb = k / block_size;
+        const int64_t kk = k % block_size;
+        const uint8_t zp = (zero_points[n * zero_point_stride + kb / 2] >> ((kb & 1) * 4)) & 0x0F;
+        uint8_t& packed = quant_b[(n * block_count_k + kb) * (block_size / 2) + kk / 2];
+        const int q = (packed >> ((kk & 1) * 4)) & 0x0F;
+        const int requant = std::min(15, std::max(0, q - zp + 8));
+        packed = static_cast<uint8_t>((packed & ~(0x0F << ((kk & 1) * 4))) | (requant << ((kk & 1) * 4)));
+        dequant_b[k * N + n] = static_cast<float>(requant - 8) * scales[n * block_count_k + kb];
+      }
+    }
+  }
+
+  std::vector<float> expected_y(static_cast<size_t>(M * N), 0.0f);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      float sum = 0.0f;
+      for (int64_t k = 0; k < K; k++) {
+        sum += a_data[m * K + k] * dequant_b[k * N + n];
+      }
+      expected_y[m * N + n] = sum;
+    }
+  }
+
+  const int64_t block_count_k = (K + block_size - 1) / block_size;
+
+  OpTester test("MatMulNBits", 1, kMSDomain);
+  test.AddAttribute<int64_t>("K", K);
+  test.AddAttribute<int64_t>("N", N);
+  test.AddAttribute<int64_t>("block_size", block_size);
+  test.AddAttribute<int64_t>("bits", 4);
+  test.AddInput<float>("A", {M, K}, a_data);
+  test.AddInput<uint8_t>("B", {N, block_count_k, block_size / 2}, quant_b, is_b_constant);
+  test.AddInput<float>("scales", {N * block_count_k}, scales, is_b_constant);
+  if (has_zero_points) {
+    test.AddInput<uint8_t>("zero_points", {N * ((block_count_k + 1) / 2)}, zero_points, is_b_constant);
+  }
+  test.AddOutput<float>("Y", {M, N}, expected_y);
+  test.SetOutputAbsErr("Y", 1e-4f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+}  // namespace
+
+TEST(MatMulNBits, Float32) {
+  for (int64_t M : {1, 2, 17}) {
+    for (int64_t N : {1, 16, 37}) {
+      for (int64_t K : {16, 40, 256}) {
+        for (int64_t block_size : {16, 32, 64, 128}) {
+          RunMatMulNBitsTest(M, N, K, block_size, true, true);
+          RunMatMulNBitsTest(M, N, K, block_size, false, true);
+        }
+      }
+    }
+  }
+}
+
+TEST(MatMulNBits, Float32_NonConstantB) {
+  RunMatMulNBitsTest(3, 40, 96, 32, true, false);
+  RunMatMulNBitsTest(5, 17, 300, 64, false, false);
+}
+
+TEST(MatMulNBits, Float32_3DInput) {
+  RandomValueGenerator random{1234};
+  const int64_t K = 32;
+  const int64_t N = 16;
+  const int64_t block_size = 32;
+
+  std::vector<float> a_data = random.Gaussian<float>({2, 3, K}, 0.0f, 0.25f);
+  std::vector<float> b_data = random.Gaussian<float>({K, N}, 0.0f, 0.25f);
+
+  std::vector<uint8_t> quant_b;
+  std::vector<float> scales;
+  std::vector<uint8_t> zero_points;
+  std::vector<float> dequant_b;
+  QuantizeBlockwise4Bits(b_data, K, N, block_size, quant_b, scales, zero_points, dequant_b);
+
+  std::vector<float> expected_y(static_cast<size_t>(6 * N), 0.0f);
+  for (int64_t m = 0; m < 6; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      for (int64_t k = 0; k < K; k++) {
+        expected_y[m * N + n] += a_data[m * K + k] * dequant_b[k * N + n];
+      }
+    }
+  }
+
+  OpTester test("MatMulNBits", 1, kMSDomain);
+  test.AddAttribute<int64_t>("K", K);
+  test.AddAttribute<int64_t>("N", N);
+  test.AddAttribute<int64_t>("block_size", block_size);
+  test.AddInput<float>("A", {2, 3, K}, a_data);
+  test.AddInput<uint8_t>("B", {N, 1, block_size / 2}, quant_b, true);
+  test.AddInput<float>("scales", {N}, scales, true);
+  test.AddInput<uint8_t>("zero_points", {N}, zero_points, true);
+  test.AddOutput<float>("Y", {2, 3, N}, expected_y);
+  test.SetOutputAbsErr("Y", 1e-4f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -6,6 +6,8 @@
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
+#include <cmath>
+
 namespace onnxruntime {
 namespace test {
 
@@ -62,6 +64,58 @@ static void TestRadix2DFTFloat(bool is_onesided) {
   test.Run();
 }
 
+// Computes the expected output of a DFT of a batch of real or complex signals with a double precision naive DFT.
+static std::vector<float> ComputeNaiveDFT(const std::vector<float>& input, int64_t batch_size, int64_t number_of_samples,
+                                          bool is_complex, int64_t dft_output_size) {
+  const double pi = 3.14159265358979323846;
+  const int64_t components = is_complex ? 2 : 1;
+
+  std::vector<float> output;
+  for (int64_t b = 0; b < batch_size; b++) {
+    const float* signal = input.data() + b * number_of_samples * components;
+    for (int64_t k = 0; k < dft_output_size; k++) {
+      double real = 0;
+      double imag = 0;
+      for (int64_t j = 0; j < number_of_samples; j++) {
+        const double angle = -2 * pi * static_cast<double>((k * j) % number_of_samples) / number_of_samples;
+        const double x_real = signal[j * components];
+        const double x_imag = is_complex ? signal[j * components + 1] : 0.0;
+        real += x_real * std::cos(angle) - x_imag * std::sin(angle);
+        imag += x_real * std::sin(angle) + x_imag * std::cos(angle);
+      }
+      output.push_back(static_cast<float>(real));
+      output.push_back(static_cast<float>(imag));
+    }
+  }
+  return output;
+}
+
+// Covers the mixed radix, Bluestein and real input paths of the FFT over a batch of signals.
+static void TestMixedRadixDFTFloat(int64_t number_of_samples, bool is_complex, bool is_onesided) {
+  OpTester test("DFT", 1, onnxruntime::kMSExperimentalDomain);
+
+  const int64_t batch_size = 3;
+  std::vector<int64_t> shape = {batch_size, number_of_samples};
+  if (is_complex) {
+    shape.push_back(2);
+  }
+
+  std::vector<float> input(static_cast<size_t>(batch_size * number_of_samples * (is_complex ? 2 : 1)));
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = std::sin(0.37f * static_cast<float>(i)) + 0.25f * std::cos(1.9f * static_cast<float>(i));
+  }
+
+  const int64_t dft_output_size = is_onesided ? (1 + (number_of_samples >> 1)) : number_of_samples;
+  std::vector<float> expected_output =
+      ComputeNaiveDFT(input, batch_size, number_of_samples, is_complex, dft_output_size);
+
+  test.AddInput<float>("input", shape, input);
+  test.AddAttribute<int64_t>("onesided", static_cast<int64_t>(is_onesided));
+  test.AddOutput<float>("output", {batch_size, dft_output_size, 2}, expected_output);
+  test.SetOutputAbsErr("output", 1e-3f);
+  test.Run();
+}
+
 TEST(MLSignalOpTest, DFTFloat) {
   TestNaiveDFTFloat(false);
   TestNaiveDFTFloat(true);
@@ -69,6 +123,17 @@ TEST(MLSignalOpTest, DFTFloat) {
   TestRadix2DFTFloat(true);
 }
 
+TEST(MLSignalOpTest, MixedRadixDFTFloat) {
+  for (bool is_onesided : {false, true}) {
+    // 400 = 4 * 4 * 5 * 5 and 30 = 2 * 3 * 5 run as mixed radix FFTs, 401 and 7 are primes that use Bluestein's
+    // algorithm. The even real signals use the real input FFT.
+    TestMixedRadixDFTFloat(400, false, is_onesided);
+    TestMixedRadixDFTFloat(401, false, is_onesided);
+    TestMixedRadixDFTFloat(30, true, is_onesided);
+    TestMixedRadixDFTFloat(7, true, is_onesided);
+  }
+}
+
 TEST(MLSignalOpTest, IDFTFloat) {
   OpTester test("IDFT", 1, onnxruntime::kMSExperimentalDomain);
   
@@ -95,6 +160,36 @@ TEST(MLSignalOpTest, IDFTFloat) {
   test.Run();
 }
 
+// Transforms the spectra of a batch of real signals back with IDFT, which must reproduce the signals.
+static void TestMixedRadixIDFTRoundTripFloat(int64_t number_of_samples) {
+  OpTester test("IDFT", 1, onnxruntime::kMSExperimentalDomain);
+
+  const int64_t batch_size = 2;
+  std::vector<float> signal(static_cast<size_t>(batch_size * number_of_samples));
+  for (size_t i = 0; i < signal.size(); i++) {
+    signal[i] = std::sin(0.37f * static_cast<float>(i)) + 0.25f * std::cos(1.9f * static_cast<float>(i));
+  }
+
+  std::vector<float> spectra = ComputeNaiveDFT(signal, batch_size, number_of_samples, false, number_of_samples);
+
+  std::vector<float> expected_output;
+  for (float value : signal) {
+    expected_output.push_back(value);
+    expected_output.push_back(0.0f);
+  }
+
+  test.AddInput<float>("input", {batch_size, number_of_samples, 2}, spectra);
+  test.AddOutput<float>("output", {batch_size, number_of_samples, 2}, expected_output);
+  test.SetOutputAbsErr("output", 1e-4f);
+  test.Run();
+}
+
+TEST(MLSignalOpTest, MixedRadixIDFTFloat) {
+  // 400 runs as a mixed radix FFT and 401 uses Bluestein's algorithm.
+  TestMixedRadixIDFTRoundTripFloat(400);
+  TestMixedRadixIDFTRoundTripFloat(401);
+}
+
 TEST(MLSignalOpTest, STFTFloat) {
   OpTester test("STFT", 1, onnxruntime::kMSExperimentalDomain);
 
@@ -120,6 +215,64 @@ TEST(MLSignalOpTest, STFTFloat) {
   test.Run();
 }
 
+// Runs STFT with 400 sample frames and a Hann window over a batch of signals, and compares each frame with a double
+// precision naive DFT of the windowed frame.
+static void TestSTFT400Float(bool is_complex) {
+  OpTester test("STFT", 1, onnxruntime::kMSExperimentalDomain);
+
+  const int64_t batch_size = 2;
+  const int64_t signal_size = 1200;
+  const int64_t frame_length = 400;
+  const int64_t frame_step = 160;
+  const int64_t n_dfts = (signal_size - frame_length) / frame_step + 1;
+  const int64_t dft_output_size = (frame_length >> 1) + 1;
+  const int64_t components = is_complex ? 2 : 1;
+
+  std::vector<float> signal(static_cast<size_t>(batch_size * signal_size * components));
+  for (size_t i = 0; i < signal.size(); i++) {
+    signal[i] = std::sin(0.37f * static_cast<float>(i)) + 0.25f * std::cos(1.9f * static_cast<float>(i));
+  }
+
+  const double pi = 3.14159265358979323846;
+  std::vector<float> window(static_cast<size_t>(frame_length));
+  for (size_t i = 0; i < window.size(); i++) {
+    window[i] = static_cast<float>(0.5 - 0.5 * std::cos(2 * pi * i / frame_length));
+  }
+
+  std::vector<float> expected_output;
+  for (int64_t b = 0; b < batch_size; b++) {
+    for (int64_t f = 0; f < n_dfts; f++) {
+      std::vector<float> frame;
+      for (int64_t j = 0; j < frame_length; j++) {
+        for (int64_t c = 0; c < components; c++) {
+          frame.push_back(signal[((b * signal_size) + f * frame_step + j) * components + c] * window[j]);
+        }
+      }
+      std::vector<float> spectrum = ComputeNaiveDFT(frame, 1, frame_length, is_complex, dft_output_size);
+      expected_output.insert(expected_output.end(), spectrum.begin(), spectrum.end());
+    }
+  }
+
+  std::vector<int64_t> signal_shape = {batch_size, signal_size};
+  if (is_complex) {
+    signal_shape.push_back(2);
+  }
+
+  test.AddInput<float>("signal", signal_shape, signal);
+  test.AddInput<float>("window", {frame_length}, window);
+  test.AddInput<int64_t>("frame_length", {}, {frame_length});
+  test.AddInput<int64_t>("frame_step", {}, {frame_step});
+  test.AddOutput<float>("output", {batch_size, n_dfts, dft_output_size, 2}, expected_output);
+  test.SetOutputAbsErr("output", 1e-3f);
+  test.Run();
+}
+
+TEST(MLSignalOpTest, STFT400Float) {
+  // real signals take the real input FFT of the 4 * 4 * 5 * 5 mixed radix plan, complex signals the complex plan.
+  TestSTFT400Float(false);
+  TestSTFT400Float(true);
+}
+
 TEST(MLSignalOpTest, HannWindowFloat) {
   OpTester test("HannWindow", 1, onnxruntime::kMSExperimentalDomain);
 
@@ -146,8 +146,13 @@ class SequentialPlannerTestContext : public ISequentialPlannerContext {
     return (shape_map_->end() != iter) ? iter->second : nullptr;
   }
 
+  ExecutionOrder GetExecutionOrder() const override { return execution_order_; }
+
+  void SetExecutionOrder(ExecutionOrder execution_order) { execution_order_ = execution_order; }
+
  private:
   ShapeMap* shape_map_;
+  ExecutionOrder execution_order_ = ExecutionOrder::DEFAULT;
 };
 
 class PlannerTest : public ::testing::Test {
@@ -176,6 +181,7 @@ class PlannerTest : public ::testing::Test {
   profiling::Profiler profiler_;
   std::unique_ptr<SessionState> state_;
   ShapeMap shape_map_;
+  ExecutionOrder execution_order_ = ExecutionOrder::DEFAULT;
   std::unique_ptr<SequentialExecutionPlan> plan_;
 
  public:
@@ -247,6 +253,8 @@ class PlannerTest : public ::testing::Test {
 
   void SetShape(std::string& name, TensorShapeProto* shape) { shape_map_[Arg(name)] = shape; }
 
+  void SetExecutionOrder(ExecutionOrder execution_order) { execution_order_ = execution_order; }
+
   void SetShape(std::initializer_list<std::pair<std::string&, TensorShapeProto*>> shapes) {
     for (auto& pair : shapes) {
       SetShape(pair.first, pair.second);
@@ -276,6 +284,7 @@ class PlannerTest : public ::testing::Test {
 
     EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
     SequentialPlannerTestContext test_context(&shape_map_);
+    test_context.SetExecutionOrder(execution_order_);
 
     status = SequentialPlanner::CreatePlan(nullptr, GraphViewer(graph_), outer_scope_node_args, execution_providers_,
                                            kernel_create_info_map, {}, {}, state_->GetOrtValueNameIdxMap(), test_context,
@@ -351,6 +360,42 @@ TEST_F(PlannerTest, ChainTest) {
   CheckFreed(3, {"X"});
 }
 
+// MemoryEfficientOrderTest: Check that the large intermediate tensor of one branch is freed before the large
+// output of the other branch is produced.
+TEST_F(PlannerTest, MemoryEfficientOrderTest) {
+  // tensor variables:
+  std::string X("X"), A("A"), A1("A1"), B("B"), B1("B1");
+
+  // graph structure:
+  auto* node_a = AddNormalNode(X, A);    // A: large temporary
+  auto* node_a1 = AddNormalNode(A, A1);  // A1: small output
+  auto* node_b = AddNormalNode(X, B);    // B: small temporary
+  auto* node_b1 = AddNormalNode(B, B1);  // B1: large output
+
+  // simulate shape-inference results:
+  Shape small_shape{1, 1};
+  Shape large_shape{1, 1024};
+  SetShape({{X, &small_shape.value}, {A, &large_shape.value}, {A1, &small_shape.value},
+            {B, &small_shape.value}, {B1, &large_shape.value}});
+
+  // the default order runs the B branch first, so A is allocated while B1 is alive.
+  SetExecutionOrder(ExecutionOrder::MEMORY_EFFICIENT);
+  CreatePlan();
+
+  std::vector<NodeIndex> order;
+  for (const auto& step : GetPlan().execution_plan) {
+    order.push_back(step.node_index);
+  }
+
+  EXPECT_EQ(order, (std::vector<NodeIndex>{node_b->Index(), node_a->Index(), node_a1->Index(), node_b1->Index()}));
+
+  // B and A are freed by their consumers
+  CheckFreed(0, {});
+  CheckFreed(1, {});
+  CheckFreed(2, {A});
+  CheckFreed(3, {B});
+}
+
 /* InputOutputTest: Test that:
 (a) All inputs are classified as kPreExisting,
 (b) All outer scope node args are classified as kPreExisting,
@@ -3,6 +3,7 @@
 
 #include "core/framework/allocatormgr.h"
 #include "core/framework/allocator.h"
+#include "core/framework/region_allocator.h"
 
 #include "test_utils.h"
 #include "gtest/gtest.h"
@@ -101,5 +102,70 @@ TEST(AllocatorTest, TestOverflowChecks) {
   EXPECT_TRUE(IAllocator::CalcMemSizeForArrayWithAlignment<kAllocAlignment>(num_elements, element_size - (kAllocAlignment / num_elements), &size));
   EXPECT_FALSE(IAllocator::CalcMemSizeForArrayWithAlignment<kAllocAlignment>(num_elements, element_size, &size));
 }
+
+TEST(AllocatorTest, RegionAllocatorTest) {
+  auto cpu_allocator = std::make_shared<CPUAllocator>();
+  auto region = std::make_shared<RegionAllocator>(cpu_allocator, 1024);
+  EXPECT_EQ(region->Info(), cpu_allocator->Info());
+  EXPECT_EQ(region->Alloc(0), nullptr);
+
+  // allocations are bumped from the first block, keeping the arena alignment.
+  char* a = static_cast<char*>(region->Alloc(10));
+  char* b = static_cast<char*>(region->Alloc(300));
+  ASSERT_NE(a, nullptr);
+  EXPECT_EQ(b, a + kAllocAlignment);
+  memset(a, 1, 10);
+  memset(b, 2, 300);
+
+  // freeing the most recent allocation rolls the region back, freeing any other allocation doesn't.
+  region->Free(b);
+  char* c = static_cast<char*>(region->Alloc(100));
+  EXPECT_EQ(c, b);
+  region->Free(a);
+  char* d = static_cast<char*>(region->Alloc(100));
+  EXPECT_EQ(d, c + kAllocAlignment);
+  EXPECT_EQ(region->PeakBytesInUse(), 3 * kAllocAlignment);
+
+  // an allocation that doesn't fit in the block starts a new one.
+  char* e = static_cast<char*>(region->Alloc(4096));
+  ASSERT_NE(e, nullptr);
+  memset(e, 3, 4096);
+  EXPECT_EQ(region->PeakBytesInUse(), 1024 + 4096u);
+
+  // reserved memory bypasses the region and is freed immediately.
+  void* f = region->Reserve(100);
+  ASSERT_NE(f, nullptr);
+  region->Free(f);
+
+  auto buffer = IAllocator::MakeUniquePtr<float>(region, 16);
+  ASSERT_NE(buffer, nullptr);
+  buffer.reset();
+}
+
+TEST(AllocatorTest, ArenaWithHugePagesTest) {
+  OrtArenaCfg arena_cfg;
+  arena_cfg.initial_chunk_size_bytes = 2 * 1024 * 1024;
+  arena_cfg.use_huge_pages = 1;
+  arena_cfg.numa_node = 0;
+
+  AllocatorCreationInfo info{[](int) { return std::make_unique<CPUAllocator>(); }, 0, true, arena_cfg};
+  auto allocator = CreateAllocator(info);
+  ASSERT_NE(allocator, nullptr);
+  EXPECT_EQ(allocator->Info().alloc_type, OrtArenaAllocator);
+
+  // the first region of the arena is mapped from the OS, and later requests extend the arena with new regions.
+  std::vector<void*> ptrs;
+  for (size_t size : {1024, 1024 * 1024, 3 * 1024 * 1024}) {
+    void* p = allocator->Alloc(size);
+    ASSERT_NE(p, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % kAllocAlignment, 0u);
+    memset(p, 1, size);
+    ptrs.push_back(p);
+  }
+
+  for (void* p : ptrs) {
+    allocator->Free(p);
+  }
+}
 }  // namespace test
 }  // namespace onnxruntime
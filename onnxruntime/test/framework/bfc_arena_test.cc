@@ -2,9 +2,12 @@
 // Licensed under the MIT License.
 
 #include "core/framework/bfc_arena.h"
+#include "test/util/include/asserts.h"
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 #include <cstdlib>
+#include <cstring>
+#include <thread>
 
 namespace onnxruntime {
 namespace test {
@@ -298,5 +301,172 @@ TEST(BFCArenaTest, TestBackoffDoesntHang) {
   BFCArena a(std::unique_ptr<IAllocator>(new BadAllocator()), 10 * 1024 * 1024);
   EXPECT_THROW(a.Alloc(1024), OnnxRuntimeException) << "Arena should be unable to allocate memory";
 }
+
+TEST(BFCArenaTest, ThreadCache) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30,
+             BFCArena::DEFAULT_ARENA_EXTEND_STRATEGY,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
+             BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
+             4);
+
+  void* t1 = a.Alloc(1000);
+  EXPECT_EQ(1000u, a.RequestedSize(t1));
+  a.Free(t1);
+
+  // The freed chunk is handed out again from the thread cache.
+  void* t2 = a.Alloc(900);
+  EXPECT_EQ(t1, t2);
+  EXPECT_EQ(900u, a.RequestedSize(t2));
+  EXPECT_EQ(1024u, a.AllocatedSize(t2));
+  a.Free(t2);
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_allocs, 2);
+  EXPECT_EQ(stats.num_thread_cache_hits, 1);
+  EXPECT_EQ(stats.num_thread_cache_misses, 1);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 1024);
+  EXPECT_EQ(stats.bytes_in_use, 1024);
+
+  // Allocations too large for the thread caches go to the bins directly.
+  void* large = a.Alloc(4 * 1024 * 1024);
+  a.Free(large);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_allocs, 3);
+  EXPECT_EQ(stats.num_thread_cache_misses, 1);
+
+  // Overflowing a bin of the cache returns chunks to the arena.
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 16; ++i) {
+    ptrs.push_back(a.Alloc(300));
+  }
+  for (void* p : ptrs) {
+    a.Free(p);
+  }
+  a.GetStats(&stats);
+  EXPECT_LE(stats.bytes_in_thread_caches, (4 + 4) * 512);
+
+  // Shrinking returns all cached chunks to the arena.
+  ASSERT_STATUS_OK(a.Shrink());
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 0);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+}
+
+TEST(BFCArenaTest, ThreadCacheFreeOnOtherThread) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30,
+             BFCArena::DEFAULT_ARENA_EXTEND_STRATEGY,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
+             BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
+             4);
+
+  // Allocate on a thread that exits before the chunks are freed, one of them
+  // reused from the cache of the thread.
+  std::vector<void*> ptrs;
+  std::thread producer([&a, &ptrs]() {
+    a.Free(a.Alloc(2048));
+    for (int i = 0; i < 8; ++i) {
+      ptrs.push_back(a.Alloc(2048));
+    }
+  });
+  producer.join();
+
+  EXPECT_EQ(2048u, a.RequestedSize(ptrs[0]));
+  for (void* p : ptrs) {
+    a.Free(p);
+  }
+
+  ASSERT_STATUS_OK(a.Shrink());
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_allocs, 9);
+  EXPECT_EQ(stats.num_thread_cache_hits, 1);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+}
+
+TEST(BFCArenaTest, ThreadCacheRequestsFromOtherThreads) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30,
+             BFCArena::DEFAULT_ARENA_EXTEND_STRATEGY,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
+             BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
+             4);
+
+  // A chunk freed on another thread stays in use until the owning thread
+  // takes it back on its next allocation, which then reuses it.
+  void* t1 = a.Alloc(1000);
+  std::thread([&a, t1]() { a.Free(t1); }).join();
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 1024);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 0);
+
+  void* t2 = a.Alloc(900);
+  EXPECT_EQ(t1, t2);
+  size_t requested_size = 0;
+  std::thread([&a, t2, &requested_size]() { requested_size = a.RequestedSize(t2); }).join();
+  EXPECT_EQ(900u, requested_size);
+
+  // Shrinking on another thread has the owning thread return its free chunks
+  // on its next allocation.
+  a.Free(t2);
+  std::thread([&a]() { ASSERT_STATUS_OK(a.Shrink()); }).join();
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 1024);
+
+  void* t3 = a.Alloc(300);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 0);
+  EXPECT_EQ(stats.num_thread_cache_hits, 1);
+  a.Free(t3);
+}
+
+TEST(BFCArenaTest, ThreadCacheConcurrentAllocations) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30,
+             BFCArena::DEFAULT_ARENA_EXTEND_STRATEGY,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
+             BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
+             8);
+
+  constexpr int kNumThreads = 8;
+  constexpr int kNumIterations = 2000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&a, t]() {
+      std::vector<void*> ptrs;
+      for (int i = 0; i < kNumIterations; ++i) {
+        size_t size = 64 + 256 * ((i * 7 + t) % 16);
+        void* p = a.Alloc(size);
+        memset(p, t, size);
+        ptrs.push_back(p);
+        if (ptrs.size() == 4) {
+          for (void* q : ptrs) {
+            a.Free(q);
+          }
+          ptrs.clear();
+        }
+      }
+      for (void* q : ptrs) {
+        a.Free(q);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_allocs, kNumThreads * kNumIterations);
+  EXPECT_GT(stats.num_thread_cache_hits, 0);
+  EXPECT_EQ(stats.bytes_in_use, stats.bytes_in_thread_caches);
+
+  ASSERT_STATUS_OK(a.Shrink());
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+}
 }  // namespace test
 }  // namespace onnxruntime
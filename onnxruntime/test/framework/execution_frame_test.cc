@@ -7,6 +7,7 @@
 #include "core/graph/model.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test_utils.h"
 #include "test/test_environment.h"
 #include "test/framework/TestAllocatorManager.h"
@@ -37,6 +38,91 @@ class ExecutionFrameTest : public ::testing::Test {
   concurrency::ThreadPool tp_;
   ExecutionFrameTest() : tp_(&onnxruntime::Env::Default(), ThreadOptions(), ORT_TSTR("ExecutionFrameTest"), 2, true) {
   }
+
+  // Builds the graph X -> Relu -> T -> Relu -> Y, where X is of type input_type, and the SessionState for it on the
+  // CPU execution provider. The SessionState is finalized by FinalizeReluChain.
+  void CreateReluChain(const TypeProto& input_type) {
+    const std::unordered_map<std::string, int> domain_to_version{{kOnnxDomain, 12}};
+    model_ = std::make_unique<onnxruntime::Model>("test", false, ModelMetaData(), PathString(),
+                                                  IOnnxRuntimeOpSchemaRegistryList(), domain_to_version,
+                                                  std::vector<ONNX_NAMESPACE::FunctionProto>{},
+                                                  DefaultLoggingManager().DefaultLogger());
+    onnxruntime::Graph& graph = model_->MainGraph();
+    TypeProto tensor_float;
+    tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    onnxruntime::NodeArg input_def("X", &input_type), relu_out_def("T", &tensor_float),
+        output_def("Y", &tensor_float);
+
+    graph.AddNode("node1", "Relu", "Relu operator", ArgMap{&input_def}, ArgMap{&relu_out_def})
+        .SetExecutionProviderType(kCpuExecutionProvider);
+    graph.AddNode("node2", "Relu", "Relu operator", ArgMap{&relu_out_def}, ArgMap{&output_def})
+        .SetExecutionProviderType(kCpuExecutionProvider);
+    ASSERT_STATUS_OK(graph.Resolve());
+
+    auto cpu_xp = CreateCPUExecutionProvider();
+    auto xp_type = cpu_xp->Type();
+    ASSERT_STATUS_OK(execution_providers_.Add(xp_type, std::move(cpu_xp)));
+    ASSERT_STATUS_OK(kernel_registry_manager_.RegisterKernels(execution_providers_));
+    cpu_allocator_ = execution_providers_.Get(xp_type)->GetAllocator(0, OrtMemTypeDefault);
+
+    state_ = std::make_unique<SessionState>(graph, execution_providers_, true, &tp_, nullptr, dtm_,
+                                            DefaultLoggingManager().DefaultLogger(), profiler_);
+  }
+
+  Status FinalizeReluChain(const SessionOptions& so) {
+    ORT_RETURN_IF_ERROR(state_->FinalizeSessionState(ORT_TSTR(""), kernel_registry_manager_, so));
+
+    const OrtValueNameIdxMap& mlvalue_name_idx_map = state_->GetOrtValueNameIdxMap();
+    ORT_RETURN_IF_ERROR(mlvalue_name_idx_map.GetIdx("X", x_idx_));
+    ORT_RETURN_IF_ERROR(mlvalue_name_idx_map.GetIdx("T", t_idx_));
+    return mlvalue_name_idx_map.GetIdx("Y", y_idx_);
+  }
+
+  // Runs the relu chain with the given input shape, and returns whether the frame had to trace a new memory pattern.
+  bool RunReluChainMemPattern(const std::vector<int64_t>& dims) {
+    OrtValue x_value;
+    CreateMLValue<float>(cpu_allocator_, dims, std::vector<float>(TensorShape(dims).Size(), 1.0f), &x_value);
+
+    vector<OrtValue> outputs;
+    ExecutionFrame frame({x_idx_}, {x_value}, {y_idx_}, outputs, {}, *state_);
+    OrtValue& t_value = *frame.GetMutableNodeInputOrOutputMLValue(t_idx_);
+    EXPECT_STATUS_OK(frame.AllocateMLValueTensorSelfOwnBuffer(t_value, t_idx_, DataTypeImpl::GetType<float>(),
+                                                              cpu_allocator_->Info(), TensorShape(dims)));
+    if (!frame.HasMemoryPatternPlanner()) {
+      return false;
+    }
+
+    auto pattern = std::make_unique<MemoryPatternGroup>();
+    EXPECT_STATUS_OK(frame.GeneratePatterns(pattern.get()));
+    EXPECT_STATUS_OK(state_->UpdateMemoryPatternGroupCache({std::cref(x_value.Get<Tensor>().Shape())}, {x_idx_},
+                                                           std::move(pattern)));
+    return true;
+  }
+
+  // Returns the size of the block of T in the memory pattern for the given input shape, or 0 if there is no pattern.
+  size_t GetReluChainMemPatternBlockSize(const std::vector<int64_t>& dims,
+                                         std::unordered_map<int, TensorShape>& inferred_shapes) {
+    const TensorShape shape(dims);
+    auto mem_patterns = state_->GetMemoryPatternGroup({std::cref(shape)}, {x_idx_}, inferred_shapes);
+    if (!mem_patterns) {
+      return 0;
+    }
+
+    const auto* pattern = mem_patterns->GetPatterns(cpu_allocator_->Info());
+    const auto* block = pattern != nullptr ? pattern->GetBlock(t_idx_) : nullptr;
+    return block != nullptr ? block->size_ : 0;
+  }
+
+  std::unique_ptr<onnxruntime::Model> model_;
+  ExecutionProviders execution_providers_;
+  KernelRegistryManager kernel_registry_manager_;
+  DataTransferManager dtm_;
+  profiling::Profiler profiler_;
+  std::unique_ptr<SessionState> state_;
+  AllocatorPtr cpu_allocator_;
+  int x_idx_ = -1;
+  int t_idx_ = -1;
+  int y_idx_ = -1;
 };
 
 TEST_F(ExecutionFrameTest, TensorAllocationTest) {
@@ -307,6 +393,148 @@ TEST_F(ExecutionFrameTest, MemPatternTest) {
   ASSERT_EQ(p->GetBlock(4)->offset_, kAllocAlignment);
 }
 
+TEST_F(ExecutionFrameTest, RunRegionAllocatorTest) {
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  ASSERT_NO_FATAL_FAILURE(CreateReluChain(tensor_float));
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigUseRunRegionAllocator, "1"));
+  ASSERT_STATUS_OK(FinalizeReluChain(so));
+  ASSERT_TRUE(state_->GetUseRunRegionAllocator());
+
+  const auto& memory_info = cpu_allocator_->Info();
+
+  OrtValue x_value;
+  CreateMLValue<float>(cpu_allocator_, std::vector<int64_t>{2, 3}, std::vector<float>(6, 1.0f), &x_value);
+
+  {
+    vector<OrtValue> outputs;
+    ExecutionFrame frame({x_idx_}, {x_value}, {y_idx_}, outputs, {}, *state_);
+
+    // the temp space allocator of the frame is a region over the session allocator.
+    AllocatorPtr temp_allocator = frame.GetTempSpaceAllocator(memory_info);
+    ASSERT_NE(temp_allocator, nullptr);
+    ASSERT_NE(temp_allocator, cpu_allocator_);
+    ASSERT_EQ(temp_allocator->Info(), memory_info);
+
+    // the intermediate value is allocated from the region, followed by the scratch buffer.
+    OrtValue& t_value = *frame.GetMutableNodeInputOrOutputMLValue(t_idx_);
+    ASSERT_STATUS_OK(frame.AllocateMLValueTensorSelfOwnBuffer(t_value, t_idx_, DataTypeImpl::GetType<float>(),
+                                                              memory_info, TensorShape({2, 3})));
+    const char* t_data = static_cast<const char*>(t_value.Get<Tensor>().DataRaw());
+
+    void* scratch = temp_allocator->Alloc(100);
+    ASSERT_EQ(scratch, t_data + kAllocAlignment);
+    temp_allocator->Free(scratch);
+
+    // freeing the most recent allocation makes its memory available again.
+    scratch = temp_allocator->Alloc(200);
+    ASSERT_EQ(scratch, t_data + kAllocAlignment);
+    temp_allocator->Free(scratch);
+
+    // graph outputs are never allocated from the region.
+    OrtValue& y_value = *frame.GetMutableNodeInputOrOutputMLValue(y_idx_);
+    ASSERT_STATUS_OK(frame.AllocateMLValueTensorSelfOwnBuffer(y_value, y_idx_, DataTypeImpl::GetType<float>(),
+                                                              memory_info, TensorShape({2, 3})));
+    ASSERT_NE(y_value.Get<Tensor>().DataRaw(), static_cast<const void*>(t_data + kAllocAlignment));
+  }
+
+  // the peak usage of the region sizes the region of the next Run.
+  ASSERT_EQ(state_->GetRunRegionBlockSize(memory_info), 2 * kAllocAlignment);
+}
+
+TEST_F(ExecutionFrameTest, MemPatternShapeBucketsTest) {
+  // the input has no shape in the model, so all of its dims are symbolic.
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  ASSERT_NO_FATAL_FAILURE(CreateReluChain(tensor_float));
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigMemoryPatternShapeBuckets, "4,8"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigMemoryPatternCacheCapacity, "1"));
+  ASSERT_STATUS_OK(FinalizeReluChain(so));
+
+  // the shapes in the model can't be resolved from the input, so the patterns are traced. a pattern traced for
+  // smaller shapes of a bucket is only used for the same shapes.
+  ASSERT_TRUE(RunReluChainMemPattern({2, 3}));
+  ASSERT_FALSE(RunReluChainMemPattern({2, 3}));
+  ASSERT_TRUE(RunReluChainMemPattern({3, 4}));
+
+  // the pattern traced for the upper bound of the bucket is used for all of its shapes.
+  ASSERT_TRUE(RunReluChainMemPattern({4, 4}));
+  ASSERT_FALSE(RunReluChainMemPattern({4, 4}));
+  ASSERT_FALSE(RunReluChainMemPattern({1, 3}));
+  ASSERT_FALSE(RunReluChainMemPattern({2, 3}));
+
+  // dims above the last bucket are kept as is.
+  ASSERT_TRUE(RunReluChainMemPattern({9, 4}));
+  ASSERT_FALSE(RunReluChainMemPattern({9, 4}));
+  ASSERT_TRUE(RunReluChainMemPattern({10, 4}));
+
+  // the cache holds a single pattern, so the pattern of the first bucket was evicted.
+  ASSERT_TRUE(RunReluChainMemPattern({4, 4}));
+}
+
+TEST_F(ExecutionFrameTest, MemPatternShapeBucketsFixedDimsTest) {
+  // the input has the shape [3, S], where 3 is not the upper bound of a bucket.
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  auto* shape = tensor_float.mutable_tensor_type()->mutable_shape();
+  shape->add_dim()->set_dim_value(3);
+  shape->add_dim()->set_dim_param("S");
+  ASSERT_NO_FATAL_FAILURE(CreateReluChain(tensor_float));
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigMemoryPatternShapeBuckets, "4,64"));
+  ASSERT_STATUS_OK(FinalizeReluChain(so));
+
+  // the pattern is planned for the upper bound [3, 64], the fixed dim isn't rounded.
+  std::unordered_map<int, TensorShape> inferred_shapes;
+  ASSERT_EQ(GetReluChainMemPatternBlockSize({3, 5}, inferred_shapes), 3 * 64 * sizeof(float));
+  ASSERT_TRUE(inferred_shapes.empty());
+
+  // the shapes inferred for the upper bound only hold for the upper bound.
+  ASSERT_EQ(GetReluChainMemPatternBlockSize({3, 64}, inferred_shapes), 3 * 64 * sizeof(float));
+  ASSERT_EQ(inferred_shapes[t_idx_], TensorShape({3, 64}));
+
+  // the next bucket of the symbolic dim has its own pattern.
+  ASSERT_EQ(GetReluChainMemPatternBlockSize({3, 3}, inferred_shapes), kAllocAlignment);
+}
+
+TEST_F(ExecutionFrameTest, MemPatternShapeBucketsSmallerThenLargerTest) {
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  auto* shape = tensor_float.mutable_tensor_type()->mutable_shape();
+  shape->add_dim()->set_dim_param("S");
+  ASSERT_NO_FATAL_FAILURE(CreateReluChain(tensor_float));
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigMemoryPatternShapeBuckets, "1024"));
+  ASSERT_STATUS_OK(FinalizeReluChain(so));
+
+  // neither Run traces a pattern, as the pattern planned for the first, smaller shape of the bucket is planned for
+  // its upper bound, and fits the larger shape.
+  ASSERT_FALSE(RunReluChainMemPattern({10}));
+  ASSERT_FALSE(RunReluChainMemPattern({500}));
+
+  std::unordered_map<int, TensorShape> inferred_shapes;
+  ASSERT_EQ(GetReluChainMemPatternBlockSize({500}, inferred_shapes), 1024 * sizeof(float));
+}
+
+TEST_F(ExecutionFrameTest, MemPatternShapeBucketsInvalidConfigTest) {
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  ASSERT_NO_FATAL_FAILURE(CreateReluChain(tensor_float));
+
+  // the bucket upper bounds must be ascending.
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigMemoryPatternShapeBuckets, "64,32"));
+  auto status = FinalizeReluChain(so);
+  ASSERT_FALSE(status.IsOK());
+  EXPECT_THAT(status.ErrorMessage(), testing::HasSubstr(kOrtSessionOptionsConfigMemoryPatternShapeBuckets));
+}
+
 #ifdef ENABLE_TRAINING
 TEST_F(ExecutionFrameTest, MemPatternWithExternalOutputsTest) {
   auto cpu_xp = CreateCPUExecutionProvider();
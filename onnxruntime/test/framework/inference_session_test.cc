@@ -732,6 +732,117 @@ TEST(InferenceSessionTests, CheckRunProfilerStartTime) {
   ASSERT_TRUE(before_start_time <= profiling_start_time && profiling_start_time <= after_start_time);
 }
 
+TEST(InferenceSessionTests, CheckSampledProfiler) {
+  SessionOptions so;
+
+  so.session_logid = "CheckSampledProfiler";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigSampledProfilingInterval, "2"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  const auto* sampled_profiler = session_object.GetProfiling().GetSampledProfiler();
+  ASSERT_NE(sampled_profiler, nullptr);
+
+  RunOptions run_options;
+  run_options.run_tag = "RunTag";
+
+  // the 1st and 3rd runs are sampled
+  for (int i = 0; i < 3; ++i) {
+    RunModel(session_object, run_options);
+  }
+
+  auto stats = sampled_profiler->GetStats();
+  ASSERT_EQ(stats.size(), 1u);
+  EXPECT_EQ(stats[0].op_type, "Mul");
+  EXPECT_EQ(stats[0].count, 2u);
+
+  uint64_t bucket_count = 0;
+  for (auto count : stats[0].buckets) {
+    bucket_count += count;
+  }
+  EXPECT_EQ(bucket_count, 2u);
+
+  std::string json = sampled_profiler->GetStatsAsJson();
+  EXPECT_NE(json.find("\"sampled_executions\" : 2"), std::string::npos);
+  EXPECT_NE(json.find("\"op_type\" : \"Mul\""), std::string::npos);
+}
+
+TEST(InferenceSessionTests, CheckSampledProfilerWithSubgraph) {
+  // the main graph computes Neg(input_0), and its If node adds input_0 to that in both branches.
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  ONNX_NAMESPACE::TypeProto bool_tensor;
+  bool_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_BOOL);
+  bool_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+  ONNX_NAMESPACE::GraphProto branch_proto;
+  {
+    onnxruntime::Model model("branch", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                             {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
+    auto& graph = model.MainGraph();
+    auto& input_0 = graph.GetOrCreateNodeArg("input_0", &float_tensor);
+    auto& neg_0 = graph.GetOrCreateNodeArg("neg_0", &float_tensor);
+    graph.AddOuterScopeNodeArg("input_0");
+    graph.AddOuterScopeNodeArg("neg_0");
+    auto& branch_output = graph.GetOrCreateNodeArg("branch_output", &float_tensor);
+    graph.AddNode("add_0", "Add", "add node in branch", {&neg_0, &input_0}, {&branch_output});
+    ASSERT_STATUS_OK(graph.Resolve());
+    branch_proto = graph.ToGraphProto();
+  }
+
+  onnxruntime::Model model("main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+  auto& input_0 = graph.GetOrCreateNodeArg("input_0", &float_tensor);
+  auto& input_1 = graph.GetOrCreateNodeArg("input_1", &bool_tensor);
+  auto& neg_0 = graph.GetOrCreateNodeArg("neg_0", &float_tensor);
+  auto& output_0 = graph.GetOrCreateNodeArg("output_0", &float_tensor);
+  graph.AddNode("neg_0", "Neg", "neg node in main graph", {&input_0}, {&neg_0});
+  auto& if_node = graph.AddNode("if_0", "If", "if node in main graph", {&input_1}, {&output_0});
+  if_node.AddAttribute("then_branch", branch_proto);
+  if_node.AddAttribute("else_branch", branch_proto);
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string model_data;
+  model.ToProto().SerializeToString(&model_data);
+
+  SessionOptions so;
+  so.session_logid = "CheckSampledProfilerWithSubgraph";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigSampledProfilingInterval, "2"));
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(model_data.data(), static_cast<int>(model_data.size())));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  auto allocator = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  OrtValue input_0_value;
+  CreateMLValue<float>(allocator, {1}, {1.0f}, &input_0_value);
+  OrtValue input_1_value;
+  CreateMLValue<bool>(allocator, {1}, {true}, &input_1_value);
+  NameMLValMap feeds{{"input_0", input_0_value}, {"input_1", input_1_value}};
+
+  // the main graph and the branch are each sampled in their 1st and 3rd executions, although their executions
+  // alternate.
+  RunOptions run_options;
+  std::vector<std::string> output_names{"output_0"};
+  for (int i = 0; i < 3; ++i) {
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(run_options, feeds, output_names, &fetches));
+  }
+
+  auto stats = session_object.GetProfiling().GetSampledProfiler()->GetStats();
+  std::map<std::string, uint64_t> counts;
+  for (const auto& op_type_stats : stats) {
+    counts[op_type_stats.op_type] = op_type_stats.count;
+  }
+
+  EXPECT_EQ(counts["Neg"], 2u);
+  EXPECT_EQ(counts["If"], 2u);
+  EXPECT_EQ(counts["Add"], 2u);
+}
+
 TEST(InferenceSessionTests, MultipleSessionsNoTimeout) {
   SessionOptions session_options;
 
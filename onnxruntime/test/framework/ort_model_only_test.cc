@@ -10,6 +10,7 @@
 #include "core/session/inference_session.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/graph/model.h"
+#include "core/graph/graph_flatbuffers_utils.h"
 #include "test/test_environment.h"
 #include "test_utils.h"
 #include "test/util/include/asserts.h"
@@ -363,6 +364,205 @@ TEST(OrtModelOnlyTests, MetadataSerialization) {
   SaveAndCompareModels("testdata/model_with_metadata.onnx", ort_file);
 }
 
+#ifndef ENABLE_TRAINING
+// test that the pre-packed weights saved in the ORT format model are used instead of pre-packing the initializers
+TEST(OrtModelOnlyTests, SerializePrePackedWeights) {
+  const std::basic_string<ORTCHAR_T> ort_file = ORT_TSTR("testdata/mnist.onnx.prepacked.test_output.ort");
+
+  SessionOptions so;
+  so.session_logid = "SerializePrePackedWeights";
+  so.optimized_model_filepath = ort_file;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigSaveModelFormat, "ORT"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigSavePrePackedWeights, "1"));
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load("testdata/mnist.onnx"));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  const size_t number_of_prepacks = session_object.GetSessionState().GetNumberOfPrepacksCounter();
+  ASSERT_GT(number_of_prepacks, static_cast<size_t>(0));
+
+  OrtValue ml_value;
+  vector<float> data(28 * 28);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(i % 17) / 17.f;
+  }
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {1, 1, 28, 28}, data,
+                       &ml_value);
+  NameMLValMap feeds{{"Input3", ml_value}};
+  std::vector<std::string> output_names{"Plus214_Output_0"};
+
+  std::vector<OrtValue> expected_fetches;
+  ASSERT_STATUS_OK(session_object.Run(feeds, output_names, &expected_fetches));
+
+  SessionOptions so2;
+  so2.session_logid = "LoadPrePackedWeights";
+  ASSERT_STATUS_OK(so2.config_options.AddConfigEntry(kOrtSessionOptionsConfigLoadModelFormat, "ORT"));
+  InferenceSessionWrapper session_object2{so2, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object2.Load(ort_file));
+  ASSERT_STATUS_OK(session_object2.Initialize());
+
+  // the same weights are pre-packed, and the ones of the kernels that support it come from the model
+  const auto& session_state2 = session_object2.GetSessionState();
+  ASSERT_EQ(session_state2.GetNumberOfPrepacksCounter(), number_of_prepacks);
+  ASSERT_GT(session_state2.GetUsedSavedPrePackedWeightCounter(), static_cast<size_t>(0));
+
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session_object2.Run(feeds, output_names, &fetches));
+  CompareTensors(expected_fetches[0], fetches[0]);
+}
+#endif
+
+// test that the initializers of an ORT format model use the data in the model bytes in place
+TEST(OrtModelOnlyTests, UseOrtFormatInitializersInPlace) {
+  const std::basic_string<ORTCHAR_T> ort_file = ORT_TSTR("testdata/mnist.onnx.in_place.test_output.ort");
+
+  SessionOptions so;
+  so.session_logid = "SaveForInitializersInPlace";
+  so.optimized_model_filepath = ort_file;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigSaveModelFormat, "ORT"));
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load("testdata/mnist.onnx"));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  OrtValue ml_value;
+  vector<float> data(28 * 28);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(i % 13) / 13.f;
+  }
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {1, 1, 28, 28}, data,
+                       &ml_value);
+  NameMLValMap feeds{{"Input3", ml_value}};
+  std::vector<std::string> output_names{"Plus214_Output_0"};
+
+  std::vector<OrtValue> expected_fetches;
+  ASSERT_STATUS_OK(session_object.Run(feeds, output_names, &expected_fetches));
+
+  // load from the file, which is memory mapped where supported
+  {
+    SessionOptions so2;
+    so2.session_logid = "LoadMappedInitializersInPlace";
+    ASSERT_STATUS_OK(so2.config_options.AddConfigEntry(kOrtSessionOptionsConfigLoadModelFormat, "ORT"));
+    ASSERT_STATUS_OK(so2.config_options.AddConfigEntry(kOrtSessionOptionsConfigUseOrtFormatInitializersInPlace, "1"));
+    InferenceSessionWrapper session_object2{so2, GetEnvironment()};
+    ASSERT_STATUS_OK(session_object2.Load(ort_file));
+    ASSERT_STATUS_OK(session_object2.Initialize());
+
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object2.Run(feeds, output_names, &fetches));
+    CompareTensors(expected_fetches[0], fetches[0]);
+  }
+
+  // load from a buffer that is used directly, so we can check the initializers point into it.
+  // the buffer needs the same alignment as a memory mapped file for the raw data to be aligned.
+  {
+    size_t num_bytes = 0;
+    ASSERT_STATUS_OK(Env::Default().GetFileLength(ort_file.c_str(), num_bytes));
+    const size_t alignment = experimental::utils::kInitializerRawDataAlignment;
+    std::vector<uint8_t> buffer(num_bytes + alignment);
+    auto* bytes = reinterpret_cast<uint8_t*>(
+        (reinterpret_cast<uintptr_t>(buffer.data()) + alignment - 1) & ~(uintptr_t{alignment} - 1));
+    std::ifstream bytes_stream(ort_file, std::ifstream::in | std::ifstream::binary);
+    bytes_stream.read(reinterpret_cast<char*>(bytes), num_bytes);
+    ASSERT_TRUE(bytes_stream);
+
+    SessionOptions so3;
+    so3.session_logid = "LoadBufferInitializersInPlace";
+    ASSERT_STATUS_OK(so3.config_options.AddConfigEntry(kOrtSessionOptionsConfigLoadModelFormat, "ORT"));
+    ASSERT_STATUS_OK(so3.config_options.AddConfigEntry(kOrtSessionOptionsConfigUseORTModelBytesDirectly, "1"));
+    ASSERT_STATUS_OK(so3.config_options.AddConfigEntry(kOrtSessionOptionsConfigUseOrtFormatInitializersInPlace, "1"));
+    InferenceSessionWrapper session_object3{so3, GetEnvironment()};
+    ASSERT_STATUS_OK(session_object3.Load(bytes, static_cast<int>(num_bytes)));
+    ASSERT_STATUS_OK(session_object3.Initialize());
+
+    size_t num_in_place = 0;
+    for (const auto& entry : session_object3.GetSessionState().GetInitializedTensors()) {
+      const auto* tensor_data = static_cast<const uint8_t*>(entry.second.Get<Tensor>().DataRaw());
+      if (tensor_data >= bytes && tensor_data < bytes + num_bytes) {
+        ++num_in_place;
+      }
+    }
+    ASSERT_GT(num_in_place, static_cast<size_t>(0));
+
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object3.Run(feeds, output_names, &fetches));
+    CompareTensors(expected_fetches[0], fetches[0]);
+  }
+}
+
+// test that the execution plan saved in the ORT format model is used if the session options match
+TEST(OrtModelOnlyTests, SerializeExecutionPlan) {
+  const std::basic_string<ORTCHAR_T> ort_file = ORT_TSTR("testdata/mnist.onnx.execution_plan.test_output.ort");
+
+  SessionOptions so;
+  so.session_logid = "SerializeExecutionPlan";
+  so.optimized_model_filepath = ort_file;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigSaveModelFormat, "ORT"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigSaveExecutionPlan, "1"));
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load("testdata/mnist.onnx"));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  OrtValue ml_value;
+  vector<float> data(28 * 28);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(i % 11) / 11.f;
+  }
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {1, 1, 28, 28}, data,
+                       &ml_value);
+  NameMLValMap feeds{{"Input3", ml_value}};
+  std::vector<std::string> output_names{"Plus214_Output_0"};
+
+  std::vector<OrtValue> expected_fetches;
+  ASSERT_STATUS_OK(session_object.Run(feeds, output_names, &expected_fetches));
+
+  const auto& plan = *session_object.GetSessionState().GetExecutionPlan();
+
+  SessionOptions so2;
+  so2.session_logid = "LoadExecutionPlan";
+  ASSERT_STATUS_OK(so2.config_options.AddConfigEntry(kOrtSessionOptionsConfigLoadModelFormat, "ORT"));
+  InferenceSessionWrapper session_object2{so2, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object2.Load(ort_file));
+  ASSERT_STATUS_OK(session_object2.Initialize());
+
+  const auto& session_state2 = session_object2.GetSessionState();
+  ASSERT_TRUE(session_state2.UsedSavedExecutionPlan());
+
+  const auto& plan2 = *session_state2.GetExecutionPlan();
+  ASSERT_EQ(plan2.allocation_plan.size(), plan.allocation_plan.size());
+  for (size_t i = 0; i < plan.allocation_plan.size(); ++i) {
+    EXPECT_EQ(plan2.allocation_plan[i].alloc_kind, plan.allocation_plan[i].alloc_kind);
+    EXPECT_EQ(plan2.allocation_plan[i].reused_buffer, plan.allocation_plan[i].reused_buffer);
+    EXPECT_EQ(plan2.allocation_plan[i].location, plan.allocation_plan[i].location);
+    EXPECT_EQ(plan2.allocation_plan[i].value_type, plan.allocation_plan[i].value_type);
+  }
+  ASSERT_EQ(plan2.execution_plan.size(), plan.execution_plan.size());
+  for (size_t i = 0; i < plan.execution_plan.size(); ++i) {
+    EXPECT_EQ(plan2.execution_plan[i].node_index, plan.execution_plan[i].node_index);
+  }
+  EXPECT_EQ(plan2.to_be_freed, plan.to_be_freed);
+
+  // the input shape is fixed, so the first Run uses the saved memory pattern
+  for (int i = 0; i < 2; ++i) {
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object2.Run(feeds, output_names, &fetches));
+    CompareTensors(expected_fetches[0], fetches[0]);
+  }
+
+  // the plan is created again if the memory reuse setting differs
+  SessionOptions so3;
+  so3.session_logid = "IgnoreExecutionPlan";
+  so3.enable_mem_reuse = false;
+  ASSERT_STATUS_OK(so3.config_options.AddConfigEntry(kOrtSessionOptionsConfigLoadModelFormat, "ORT"));
+  InferenceSessionWrapper session_object3{so3, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object3.Load(ort_file));
+  ASSERT_STATUS_OK(session_object3.Initialize());
+  ASSERT_FALSE(session_object3.GetSessionState().UsedSavedExecutionPlan());
+
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session_object3.Run(feeds, output_names, &fetches));
+  CompareTensors(expected_fetches[0], fetches[0]);
+}
+
 #if !defined(DISABLE_ML_OPS)
 TEST(OrtModelOnlyTests, SerializeToOrtFormatMLOps) {
   const std::basic_string<ORTCHAR_T> ort_file =
@@ -1,11 +1,18 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <thread>
+
 #include "core/framework/data_types.h"
 #include "core/framework/op_kernel.h"
+#include "core/graph/model.h"
 #include "test/providers/provider_test_utils.h"
 #include "test_utils.h"
 #include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 #include "gtest/gtest.h"
 
@@ -117,6 +124,70 @@ TEST(ParallelExecutor, TestStatusPropagation) {
   }
 }
 
+// Test kernel that doubles the input after waiting for another instance of it to be running, so two of them
+// only both see a peer if they run concurrently.
+struct WaitForPeerOp {
+  static constexpr const char* OpName = "WaitForPeerOp";
+  static constexpr const char* OpDomain = "testing";
+
+  static std::atomic<int> num_running;
+  static std::atomic<int> num_saw_peer;
+
+  static ONNX_NAMESPACE::OpSchema OpSchema() {
+    ONNX_NAMESPACE::OpSchema schema;
+    schema.SetDoc("Wait for a peer to be running and double the input.")
+        .SetName(OpName)
+        .SetDomain(OpDomain)
+        .SinceVersion(10)
+        .Input(0, "X", "Input.", "T", OpSchema::Single)
+        .Output(0, "Y", "Input times two.", "T", OpSchema::Single)
+        .TypeConstraint("T", {"tensor(int64)"}, "Type of the input and output");
+    return schema;
+  }
+
+  class OpKernelImpl final : public OpKernel {
+   public:
+    OpKernelImpl(const OpKernelInfo& info) : OpKernel{info} {}
+
+    Status Compute(OpKernelContext* ctx) const override {
+      num_running.fetch_add(1);
+      // give up after a while so that running the nodes one at a time fails the test rather than hangs it
+      const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+      while (num_running.load() < 2 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+
+      if (num_running.load() >= 2) {
+        num_saw_peer.fetch_add(1);
+      }
+
+      const Tensor& X = *ctx->Input<Tensor>(0);
+      Tensor& Y = *ctx->Output(0, X.Shape());
+      const auto* x = X.Data<int64_t>();
+      auto* y = Y.MutableData<int64_t>();
+      for (int64_t i = 0, size = X.Shape().Size(); i < size; ++i) {
+        y[i] = x[i] * 2;
+      }
+
+      return Status::OK();
+    }
+  };
+
+  static KernelDefBuilder KernelDef() {
+    KernelDefBuilder def;
+    def.SetName(OpName)
+        .SetDomain(OpDomain)
+        .SinceVersion(10)
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<int64_t>())
+        .Provider(onnxruntime::kCpuExecutionProvider);
+
+    return def;
+  }
+};
+
+std::atomic<int> WaitForPeerOp::num_running{0};
+std::atomic<int> WaitForPeerOp::num_saw_peer{0};
+
 class ParallelExecutorThreadPoolTest : public testing::TestWithParam<int> {
 };
 
@@ -145,5 +216,128 @@ TEST_P(ParallelExecutorThreadPoolTest, TestNullInterOpThreadPool) {
 
 INSTANTIATE_TEST_SUITE_P(ParallelExecutorThreadPoolTests, ParallelExecutorThreadPoolTest,
                         testing::Values(1, 0));
+
+class DataflowExecutorThreadPoolTest : public testing::TestWithParam<int> {
+};
+
+// test that the status from TestOp is correctly returned when the nodes run on the intra-op thread pool,
+// including when it has a single thread and execution falls back to sequential.
+TEST_P(DataflowExecutorThreadPoolTest, TestStatusPropagation) {
+  auto registry = std::make_shared<CustomRegistry>();
+  std::vector<OpSchema> schemas{TestOp::OpSchema()};
+  Status status;
+  ASSERT_TRUE((status = registry->RegisterOpSet(schemas, TestOp::OpDomain, 10, 11)).IsOK()) << status;
+  KernelCreateFn kernel_create_fn = [](const OpKernelInfo& info) { return new typename TestOp::OpKernelImpl(info); };
+  auto kernel_def = TestOp::KernelDef();
+  ASSERT_TRUE((status = registry->RegisterCustomKernel(kernel_def, kernel_create_fn)).IsOK()) << status;
+
+  onnxruntime::SessionOptions so;
+  so.session_logid = "TestOp";
+  so.execution_mode = ExecutionMode::ORT_PARALLEL;
+  so.intra_op_param.thread_pool_size = GetParam();
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigUseDataflowExecutor, "1"));
+
+  {  // test success
+    OpTester tester{"TestOp", 10, TestOp::OpDomain};
+    tester.AddCustomOpRegistry(registry);
+
+    tester.AddInput<int64_t>("action", {1}, {/*success*/ 0});
+    tester.AddOutput<int64_t>("action_out", {1}, {0});
+    tester.Run(so, OpTester::ExpectResult::kExpectSuccess, {}, {kTensorrtExecutionProvider}, nullptr, nullptr);
+  }
+
+  {  // test failure
+    OpTester tester{"TestOp", 10, TestOp::OpDomain};
+    tester.AddCustomOpRegistry(registry);
+
+    tester.AddInput<int64_t>("action", {1}, {/*failure*/ 1});
+    tester.AddOutput<int64_t>("action_out", {1}, {0});
+    tester.Run(so, OpTester::ExpectResult::kExpectFailure, "Action was 1", {kTensorrtExecutionProvider}, nullptr,
+               nullptr);
+  }
+
+  {  // test exception
+    OpTester tester{"TestOp", 10, TestOp::OpDomain};
+    tester.AddCustomOpRegistry(registry);
+
+    tester.AddInput<int64_t>("action", {1}, {/*exception*/ 2});
+    tester.AddOutput<int64_t>("action_out", {1}, {0});
+    tester.Run(so, OpTester::ExpectResult::kExpectFailure, "Throwing as action was 2", {kTensorrtExecutionProvider},
+               nullptr, nullptr);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(DataflowExecutorThreadPoolTests, DataflowExecutorThreadPoolTest,
+                         testing::Values(1, 4));
+
+// test that the dataflow executor runs independent branches concurrently and returns the outputs of both
+TEST(DataflowExecutor, TestIndependentBranchesOverlap) {
+  auto registry = std::make_shared<CustomRegistry>();
+  std::vector<OpSchema> schemas{WaitForPeerOp::OpSchema()};
+  ASSERT_STATUS_OK(registry->RegisterOpSet(schemas, WaitForPeerOp::OpDomain, 10, 11));
+  KernelCreateFn kernel_create_fn = [](const OpKernelInfo& info) {
+    return new typename WaitForPeerOp::OpKernelImpl(info);
+  };
+  auto kernel_def = WaitForPeerOp::KernelDef();
+  ASSERT_STATUS_OK(registry->RegisterCustomKernel(kernel_def, kernel_create_fn));
+
+  SessionOptions so;
+  so.session_logid = "DataflowExecutor.TestIndependentBranchesOverlap";
+  so.execution_mode = ExecutionMode::ORT_PARALLEL;
+  so.intra_op_param.thread_pool_size = 4;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigUseDataflowExecutor, "1"));
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.RegisterCustomRegistry(registry));
+
+  // two branches that share no nodes: X0 -> Y0 and X1 -> Y1
+  IOnnxRuntimeOpSchemaRegistryList custom_schema_registries = {registry->GetOpschemaRegistry()};
+  std::unordered_map<std::string, int> domain_to_version = {{WaitForPeerOp::OpDomain, 10}};
+  Model model("DataflowExecutorTest", false, ModelMetaData(), PathString(), custom_schema_registries,
+              domain_to_version, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_type(*DataTypeImpl::GetTensorType<int64_t>()->GetTypeProto());
+  tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  for (int i = 0; i < 2; ++i) {
+    auto& input_arg = graph.GetOrCreateNodeArg("X" + std::to_string(i), &tensor_type);
+    auto& output_arg = graph.GetOrCreateNodeArg("Y" + std::to_string(i), &tensor_type);
+    graph.AddNode("node_" + std::to_string(i), WaitForPeerOp::OpName, "", {&input_arg}, {&output_arg}, nullptr,
+                  WaitForPeerOp::OpDomain);
+  }
+
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string serialized_model;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&serialized_model));
+  std::stringstream sstr(serialized_model);
+  ASSERT_STATUS_OK(session_object.Load(sstr));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  auto allocator = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  OrtValue x0;
+  OrtValue x1;
+  CreateMLValue<int64_t>(allocator, {2}, {1, 2}, &x0);
+  CreateMLValue<int64_t>(allocator, {2}, {3, 4}, &x1);
+  NameMLValMap feeds{{"X0", x0}, {"X1", x1}};
+
+  WaitForPeerOp::num_running = 0;
+  WaitForPeerOp::num_saw_peer = 0;
+
+  RunOptions run_options;
+  std::vector<std::string> output_names{"Y0", "Y1"};
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session_object.Run(run_options, feeds, output_names, &fetches));
+
+  EXPECT_EQ(WaitForPeerOp::num_saw_peer.load(), 2);
+
+  ASSERT_EQ(fetches.size(), 2u);
+  const std::vector<int64_t> expected_y0{2, 4};
+  const std::vector<int64_t> expected_y1{6, 8};
+  const auto& y0 = fetches[0].Get<Tensor>();
+  const auto& y1 = fetches[1].Get<Tensor>();
+  EXPECT_EQ(std::vector<int64_t>(y0.Data<int64_t>(), y0.Data<int64_t>() + y0.Shape().Size()), expected_y0);
+  EXPECT_EQ(std::vector<int64_t>(y1.Data<int64_t>(), y1.Data<int64_t>() + y1.Shape().Size()), expected_y1);
+}
 }  // namespace test
 }  // namespace onnxruntime
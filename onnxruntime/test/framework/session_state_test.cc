@@ -772,6 +772,89 @@ TEST(SessionStateTest, SharedInitalizersWithPrePackingTest) {
   }
 }
 
+// the weights of many nodes using the same initializer are pre-packed in parallel, and the initializer is released
+// once all of them are packed
+TEST(SessionStateTest, ParallelPrePackingTest) {
+  for (const bool disable_parallel_initialization : {false, true}) {
+    OrtThreadPoolParams to;
+    to.thread_pool_size = 4;
+    auto tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(), to, concurrency::ThreadPoolType::INTRA_OP);
+    ONNX_OPERATOR_SCHEMA(PrePackingTest)
+        .SetDoc("Faking Node for PrePacking")
+        .Input(0, "Input_0", "input 0", "tensor(float)")
+        .Input(1, "Input_1", "input 1", "tensor(float)")
+        .Output(0, "output_0", "docstr for output_0.", "tensor(float)");
+
+    ExecutionProviders execution_providers;
+    auto cpu_execution_provider = std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo(false));
+    ASSERT_STATUS_OK(execution_providers.Add(kCpuExecutionProvider, std::move(cpu_execution_provider)));
+
+    DataTransferManager dtm;
+    profiling::Profiler profiler;
+
+    std::unordered_map<std::string, int> domain_to_version;
+    domain_to_version[kOnnxDomain] = 11;
+    Model model("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                DefaultLoggingManager().DefaultLogger());
+    Graph& graph = model.MainGraph();
+
+    TypeProto type;
+    type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    constexpr int num_nodes = 64;
+    auto& input_arg = graph.GetOrCreateNodeArg("input", &type);
+    auto& weight_arg = graph.GetOrCreateNodeArg("weight", &type);
+    for (int i = 0; i < num_nodes; ++i) {
+      auto& output_arg = graph.GetOrCreateNodeArg("output_" + std::to_string(i), &type);
+      graph.AddNode("node_" + std::to_string(i), "PrePackingTest", "node", {&input_arg, &weight_arg}, {&output_arg});
+    }
+
+    ONNX_NAMESPACE::TensorProto tensor;
+    tensor.add_dims(1);
+    tensor.add_float_data(1.0f);
+    tensor.set_data_type(TensorProto_DataType_FLOAT);
+    tensor.set_name("weight");
+    graph.AddInitializedTensor(tensor);
+    ASSERT_STATUS_OK(graph.Resolve());
+
+    SessionState session_state(graph,
+                               execution_providers,
+                               true, /*enable_mem_pattern*/
+                               tp.get(),
+                               nullptr, /*inter_op_thread_pool*/
+                               dtm,
+                               DefaultLoggingManager().DefaultLogger(),
+                               profiler);
+
+    KernelRegistryManager kernel_registry_manager;
+    ASSERT_STATUS_OK(kernel_registry_manager.RegisterKernels(execution_providers));
+    std::shared_ptr<KernelRegistry> kernel_registry = std::make_shared<KernelRegistry>();
+    auto kernel_def = KernelDefBuilder().SetName("PrePackingTest").Provider(kCpuExecutionProvider).SinceVersion(1).Build();
+    ASSERT_STATUS_OK(kernel_registry->Register(
+        KernelCreateInfo(std::move(kernel_def),
+                         [](const OpKernelInfo& info) -> OpKernel* { return new PrePackingTestOpKernel(info); })));
+    kernel_registry_manager.RegisterKernelRegistry(kernel_registry);
+
+    PlaceAllNodesToCPUEP(graph);
+
+    SessionOptions sess_options;
+    sess_options.config_options.configurations[kOrtSessionOptionsConfigDisableParallelInitialization] =
+        disable_parallel_initialization ? "1" : "0";
+    ASSERT_STATUS_OK(session_state.FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
+                                                        kernel_registry_manager,
+                                                        sess_options));
+
+    ASSERT_EQ(session_state.GetNumberOfPrepacksCounter(), static_cast<size_t>(num_nodes));
+    ASSERT_TRUE(session_state.GetConstantInitializedTensors().empty());
+    for (const auto& node : graph.Nodes()) {
+      const auto* kernel = static_cast<const PrePackingTestOpKernel*>(session_state.GetKernel(node.Index()));
+      ASSERT_EQ(kernel->prepack_calls_count, 1);
+    }
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(SessionStateTests,
                          SessionStatePrepackingTest,
                          testing::Values(PrepackingTestParam{false, false},
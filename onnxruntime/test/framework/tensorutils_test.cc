@@ -334,5 +334,43 @@ TEST(TensorProtoUtilsTest, ConstantTensorProtoWithExternalData) {
   TestConstantNodeConversionWithExternalData<float>(TensorProto_DataType_FLOAT);
   TestConstantNodeConversionWithExternalData<double>(TensorProto_DataType_DOUBLE);
 }
+
+TEST(TensorProtoUtilsTest, UnpackTensorWithExternalDataInMemory) {
+  const std::vector<float> data{1.f, 2.f, 3.f, 4.f};
+  const size_t data_length = data.size() * sizeof(float);
+  Path model_path;
+
+  TensorProto tp;
+  tp.set_data_type(TensorProto_DataType_FLOAT);
+  tp.add_dims(static_cast<int64_t>(data.size()));
+  utils::SetExternalDataInMemory(tp, data.data(), data_length);
+  ASSERT_TRUE(utils::HasExternalDataInMemory(tp));
+
+  // the in-memory location is rejected for memory that isn't registered, as a model could set it.
+  std::vector<float> val(data.size());
+  auto st = utils::UnpackTensor(tp, model_path, val.data(), val.size());
+  ASSERT_FALSE(st.IsOK());
+  EXPECT_THAT(st.ErrorMessage(), testing::HasSubstr("is reserved"));
+
+  {
+    utils::ExternalDataInMemoryRange range(data.data(), data_length);
+    ASSERT_STATUS_OK(utils::UnpackTensor(tp, model_path, val.data(), val.size()));
+    EXPECT_EQ(val, data);
+
+    // data beyond the registered range isn't read.
+    TensorProto tp_beyond_range;
+    tp_beyond_range.set_data_type(TensorProto_DataType_FLOAT);
+    tp_beyond_range.add_dims(static_cast<int64_t>(data.size()));
+    utils::SetExternalDataInMemory(tp_beyond_range, data.data() + 1, data_length);
+    const void* data_in_memory = nullptr;
+    size_t data_in_memory_length = 0;
+    EXPECT_FALSE(utils::GetExternalDataInMemory(tp_beyond_range, data_in_memory, data_in_memory_length));
+  }
+
+  // the range is unregistered with the ExternalDataInMemoryRange.
+  const void* data_in_memory = nullptr;
+  size_t data_in_memory_length = 0;
+  EXPECT_FALSE(utils::GetExternalDataInMemory(tp, data_in_memory, data_in_memory_length));
+}
 }  // namespace test
 }  // namespace onnxruntime
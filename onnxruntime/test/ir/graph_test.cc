@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include <iostream>
+#include "core/framework/tensorprotoutils.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
 #include "core/graph/op.h"
@@ -1356,6 +1357,27 @@ TEST_F(GraphTest, UnusedSparseInitializerIsIgnored) {
   auto& graph_proto = graph2.ToGraphProto();
   ASSERT_TRUE(graph_proto.sparse_initializer().empty());
 }
+
+TEST_F(GraphTest, SparseInitializerWithExternalDataInMemoryIsRejected) {
+  // a model can't make ORT read memory through the location ORT uses for the data it holds in memory.
+  const std::vector<float>& values = sparse_details::values;
+  ModelProto model_proto;
+  {
+    Model model("SparseInitializerWithExternalDataInMemoryIsRejected", false, *logger_);
+    model_proto = model.ToProto();
+    auto* m_graph = model_proto.mutable_graph();
+    ConstructASimpleAddGraph(*m_graph, nullptr);
+    auto* m_sparse_initializer = m_graph->add_sparse_initializer();
+    ConstructSparseTensor("sparse_initializer_in_memory", *m_sparse_initializer);
+    utils::SetExternalDataInMemory(*m_sparse_initializer->mutable_values(), values.data(),
+                                   values.size() * sizeof(float));
+  }
+
+  std::shared_ptr<onnxruntime::Model> p_tmp_model;
+  auto status = onnxruntime::Model::Load(model_proto, p_tmp_model, nullptr, *logger_);
+  ASSERT_FALSE(status.IsOK());
+  EXPECT_THAT(status.ErrorMessage(), testing::HasSubstr("external data location"));
+}
 #endif  // !defined(DISABLE_SPARSE_TENSORS)
 
 TEST_F(GraphTest, GraphConstruction_CheckIsNotAcyclic) {
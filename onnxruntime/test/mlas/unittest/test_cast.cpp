@@ -0,0 +1,189 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+#include <cstring>
+
+class MlasCastTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<unsigned short> BufferInput16;
+  MatrixGuardBuffer<unsigned short> BufferOutput16;
+  MatrixGuardBuffer<float> BufferFloat;
+  MatrixGuardBuffer<int32_t> BufferInt32;
+
+  static float FloatFromBits(uint32_t bits) {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  static uint32_t BitsFromFloat(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+  }
+
+  void TestHalfRoundTrip(size_t N) {
+    unsigned short* Input = BufferInput16.GetBuffer(N);
+    unsigned short* Output = BufferOutput16.GetBuffer(N);
+    float* Intermediate = BufferFloat.GetBuffer(N);
+
+    std::default_random_engine generator(static_cast<unsigned>(N));
+    std::uniform_int_distribution<unsigned> distribution(0, 0xFFFF);
+
+    for (size_t n = 0; n < N; n++) {
+      Input[n] = static_cast<unsigned short>(distribution(generator));
+    }
+
+    MlasConvertHalfToFloatBuffer(Input, Intermediate, N);
+    MlasConvertFloatToHalfBuffer(Intermediate, Output, N);
+
+    for (size_t n = 0; n < N; n++) {
+      bool IsNaN = (Input[n] & 0x7C00) == 0x7C00 && (Input[n] & 0x03FF) != 0;
+      if (IsNaN) {
+        ASSERT_TRUE(std::isnan(Intermediate[n])) << " @" << n << " of " << N << ", input: " << Input[n];
+        ASSERT_TRUE((Output[n] & 0x7C00) == 0x7C00 && (Output[n] & 0x03FF) != 0)
+            << " @" << n << " of " << N << ", got: " << Output[n];
+      } else {
+        ASSERT_EQ(Output[n], Input[n]) << " @" << n << " of " << N << ", intermediate: " << Intermediate[n];
+      }
+    }
+  }
+
+  void TestHalfRounding(size_t N) {
+    float* Input = BufferFloat.GetBuffer(N);
+    unsigned short* Output = BufferOutput16.GetBuffer(N);
+
+    //
+    // Build values that lie exactly halfway between two half precision
+    // values, which must round to the one with an even mantissa, along with
+    // values that overflow or underflow the half precision range.
+    //
+
+    static const struct {
+      float Value;
+      unsigned short Expected;
+    } Cases[] = {
+        {1.0f + 1.0f / 2048.0f, 0x3C00},
+        {1.0f + 3.0f / 2048.0f, 0x3C02},
+        {-2.0f - 1.0f / 1024.0f, 0xC000},
+        {65504.0f, 0x7BFF},
+        {65520.0f, 0x7C00},
+        {1.0e10f, 0x7C00},
+        {-1.0e10f, 0xFC00},
+        {5.9604644775390625e-8f, 0x0001},
+        {2.98023223876953125e-8f, 0x0000},
+        {-0.0f, 0x8000},
+    };
+
+    constexpr size_t CaseCount = sizeof(Cases) / sizeof(Cases[0]);
+
+    for (size_t n = 0; n < N; n++) {
+      Input[n] = Cases[n % CaseCount].Value;
+    }
+
+    MlasConvertFloatToHalfBuffer(Input, Output, N);
+
+    for (size_t n = 0; n < N; n++) {
+      ASSERT_EQ(Output[n], Cases[n % CaseCount].Expected) << " @" << n << " of " << N << ", input: " << Input[n];
+    }
+  }
+
+  void TestBFloat16(size_t N) {
+    unsigned short* Input = BufferInput16.GetBuffer(N);
+    unsigned short* Output = BufferOutput16.GetBuffer(N);
+    float* Intermediate = BufferFloat.GetBuffer(N);
+
+    std::default_random_engine generator(static_cast<unsigned>(N));
+    std::uniform_int_distribution<unsigned> distribution(0, 0xFFFF);
+
+    for (size_t n = 0; n < N; n++) {
+      Input[n] = static_cast<unsigned short>(distribution(generator));
+    }
+
+    MlasConvertBFloat16ToFloatBuffer(Input, Intermediate, N);
+
+    for (size_t n = 0; n < N; n++) {
+      ASSERT_EQ(BitsFromFloat(Intermediate[n]), uint32_t(Input[n]) << 16) << " @" << n << " of " << N;
+    }
+
+    //
+    // Perturb the low bits of each value to exercise round to nearest even.
+    //
+
+    for (size_t n = 0; n < N; n++) {
+      uint32_t LowBits = static_cast<uint32_t>(distribution(generator));
+      Intermediate[n] = FloatFromBits(BitsFromFloat(Intermediate[n]) | LowBits);
+    }
+
+    MlasConvertFloatToBFloat16Buffer(Intermediate, Output, N);
+
+    for (size_t n = 0; n < N; n++) {
+      uint32_t Bits = BitsFromFloat(Intermediate[n]);
+      if (std::isnan(Intermediate[n])) {
+        ASSERT_TRUE((Output[n] & 0x7F80) == 0x7F80 && (Output[n] & 0x007F) != 0)
+            << " @" << n << " of " << N << ", got: " << Output[n];
+        continue;
+      }
+      uint32_t Remainder = Bits & 0xFFFF;
+      uint32_t Expected = Bits >> 16;
+      if (Remainder > 0x8000 || (Remainder == 0x8000 && (Expected & 1) != 0)) {
+        Expected += 1;
+      }
+      ASSERT_EQ(Output[n], static_cast<unsigned short>(Expected)) << " @" << n << " of " << N << ", bits: " << Bits;
+    }
+  }
+
+  void TestInt32(size_t N) {
+    int32_t* Integers = BufferInt32.GetBuffer(N);
+    float* Floats = BufferFloat.GetBuffer(N);
+
+    std::default_random_engine generator(static_cast<unsigned>(N));
+    std::uniform_int_distribution<int32_t> distribution(-(1 << 24), 1 << 24);
+
+    for (size_t n = 0; n < N; n++) {
+      Integers[n] = distribution(generator);
+    }
+
+    MlasConvertInt32ToFloatBuffer(Integers, Floats, N);
+
+    for (size_t n = 0; n < N; n++) {
+      ASSERT_EQ(Floats[n], static_cast<float>(Integers[n])) << " @" << n << " of " << N;
+    }
+
+    for (size_t n = 0; n < N; n++) {
+      Floats[n] = Floats[n] / 8.0f;
+    }
+
+    MlasConvertFloatToInt32Buffer(Floats, Integers, N);
+
+    for (size_t n = 0; n < N; n++) {
+      ASSERT_EQ(Integers[n], static_cast<int32_t>(Floats[n])) << " @" << n << " of " << N << ", input: " << Floats[n];
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("Cast");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t n = 1; n < 128; n++) {
+      TestHalfRoundTrip(n);
+      TestHalfRounding(n);
+      TestBFloat16(n);
+      TestInt32(n);
+    }
+    TestHalfRoundTrip(65536);
+    TestBFloat16(65536);
+  }
+};
+
+template <> MlasCastTest* MlasTestFixture<MlasCastTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  // no long execute needed
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasCastTest>::RegisterShortExecute() : 0;
+});
@@ -0,0 +1,148 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasFlashAttentionTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferQ;
+  MatrixGuardBuffer<float> BufferK;
+  MatrixGuardBuffer<float> BufferV;
+  MatrixGuardBuffer<float> BufferMask;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  // MaskRows is 0 for no mask, 1 for a mask row broadcast to every query, or
+  // SequenceLength for a full mask.
+  void Test(size_t BatchSize, size_t SequenceLength, size_t KVSequenceLength,
+            size_t HeadSizeQK, size_t HeadSizeV, size_t MaskRows, bool Causal) {
+    const float* Q = BufferQ.GetBuffer(BatchSize * SequenceLength * HeadSizeQK);
+    const float* K = BufferK.GetBuffer(BatchSize * KVSequenceLength * HeadSizeQK);
+    const float* V = BufferV.GetBuffer(BatchSize * KVSequenceLength * HeadSizeV);
+    float* Mask = BufferMask.GetBuffer(std::max(MaskRows, size_t(1)) * KVSequenceLength);
+    float* Output = BufferOutput.GetBuffer(BatchSize * SequenceLength * HeadSizeV);
+    float* OutputReference = BufferOutputReference.GetBuffer(BatchSize * SequenceLength * HeadSizeV);
+
+    // Mask out every third key like a padding mask would.
+    for (size_t i = 0; i < std::max(MaskRows, size_t(1)) * KVSequenceLength; i++) {
+      Mask[i] = (i % 3 == 2) ? -10000.0f : 0.0f;
+    }
+
+    const float Scale = 1.0f / std::sqrt(float(HeadSizeQK));
+
+    // The output of all heads is interleaved like the BxSxNxH layout of the
+    // attention operator.
+    std::vector<MLAS_ATTENTION_DATA_PARAMS> Data(BatchSize);
+    for (size_t b = 0; b < BatchSize; b++) {
+      Data[b].Q = Q + b * SequenceLength * HeadSizeQK;
+      Data[b].ldq = HeadSizeQK;
+      Data[b].K = K + b * KVSequenceLength * HeadSizeQK;
+      Data[b].ldk = HeadSizeQK;
+      Data[b].V = V + b * KVSequenceLength * HeadSizeV;
+      Data[b].ldv = HeadSizeV;
+      Data[b].Output = Output + b * HeadSizeV;
+      Data[b].ldo = BatchSize * HeadSizeV;
+      Data[b].Mask = (MaskRows > 0) ? Mask : nullptr;
+      Data[b].ldm = (MaskRows > 1) ? KVSequenceLength : 0;
+    }
+
+    std::fill_n(Output, BatchSize * SequenceLength * HeadSizeV, -0.5f);
+
+    MlasFlashAttention(SequenceLength, KVSequenceLength, HeadSizeQK, HeadSizeV, Scale, Causal,
+                       Data.data(), BatchSize, threadpool_);
+
+    for (size_t b = 0; b < BatchSize; b++) {
+      ReferenceAttention(SequenceLength, KVSequenceLength, HeadSizeQK, HeadSizeV, Scale, Causal, Data[b],
+                         OutputReference + b * HeadSizeV);
+    }
+
+    for (size_t f = 0; f < BatchSize * SequenceLength * HeadSizeV; f++) {
+      ASSERT_TRUE(CloseEnough(Output[f], OutputReference[f]))
+          << "@" << f << ", Batch=" << BatchSize << ", S=" << SequenceLength << ", S*=" << KVSequenceLength
+          << ", HQK=" << HeadSizeQK << ", HV=" << HeadSizeV << ", MaskRows=" << MaskRows << ", Causal=" << Causal;
+    }
+  }
+
+  static void ReferenceAttention(size_t SequenceLength, size_t KVSequenceLength,
+                                 size_t HeadSizeQK, size_t HeadSizeV, float Scale, bool Causal,
+                                 const MLAS_ATTENTION_DATA_PARAMS& Data, float* Output) {
+    const size_t PastLength = KVSequenceLength - SequenceLength;
+    std::vector<double> Scores(KVSequenceLength);
+
+    for (size_t i = 0; i < SequenceLength; i++) {
+      const size_t CountKV = Causal ? std::min(KVSequenceLength, PastLength + i + 1) : KVSequenceLength;
+
+      double Maximum = -std::numeric_limits<double>::infinity();
+      for (size_t j = 0; j < CountKV; j++) {
+        double sum = 0.0;
+        for (size_t h = 0; h < HeadSizeQK; h++) {
+          sum += double(Data.Q[i * Data.ldq + h]) * double(Data.K[j * Data.ldk + h]);
+        }
+        sum *= Scale;
+        if (Data.Mask != nullptr) {
+          sum += Data.Mask[i * Data.ldm + j];
+        }
+        Scores[j] = sum;
+        Maximum = std::max(Maximum, sum);
+      }
+
+      double Sum = 0.0;
+      for (size_t j = 0; j < CountKV; j++) {
+        Scores[j] = std::exp(Scores[j] - Maximum);
+        Sum += Scores[j];
+      }
+
+      for (size_t h = 0; h < HeadSizeV; h++) {
+        double sum = 0.0;
+        for (size_t j = 0; j < CountKV; j++) {
+          sum += Scores[j] * double(Data.V[j * Data.ldv + h]);
+        }
+        Output[i * Data.ldo + h] = float(sum / Sum);
+      }
+    }
+  }
+
+  static bool CloseEnough(float actual, float expected) {
+    return std::abs(actual - expected) <= 1e-4f * std::max(1.0f, std::abs(expected));
+  }
+
+ public:
+  MlasFlashAttentionTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("FlashAttention") +
+                                          (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t MaskRows : {0, 1}) {
+      for (bool Causal : {false, true}) {
+        for (size_t S : {1, 5, 32, 33, 70}) {
+          Test(2, S, S, 16, 16, MaskRows, Causal);
+          Test(3, S, S + 7, 24, 8, MaskRows, Causal);
+        }
+        Test(1, 1, 300, 64, 64, MaskRows, Causal);
+        Test(4, 130, 259, 32, 40, MaskRows, Causal);
+      }
+    }
+    Test(2, 45, 45, 16, 16, 45, false);
+    Test(2, 45, 60, 16, 16, 45, true);
+  }
+};
+
+template <> MlasFlashAttentionTest<false>* MlasTestFixture<MlasFlashAttentionTest<false>>::mlas_tester(nullptr);
+template <> MlasFlashAttentionTest<true>* MlasTestFixture<MlasFlashAttentionTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasFlashAttentionTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasFlashAttentionTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
@@ -0,0 +1,160 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+#include <cmath>
+
+template <bool Packed, bool Threaded>
+class MlasHalfGemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<uint16_t> BufferB;
+  MatrixGuardBuffer<uint8_t> BufferBPacked;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  //
+  // The test values are small integers, so a truncating conversion is exact.
+  //
+
+  static uint16_t HalfFromInteger(int Value) {
+    uint16_t Sign = (Value < 0) ? 0x8000 : 0;
+    uint32_t Magnitude = static_cast<uint32_t>(Value < 0 ? -Value : Value);
+    if (Magnitude == 0) {
+      return Sign;
+    }
+    uint32_t Exponent = 0;
+    while ((Magnitude >> (Exponent + 1)) != 0) {
+      Exponent++;
+    }
+    uint32_t Mantissa = (Magnitude << (10 - Exponent)) & 0x3FF;
+    return static_cast<uint16_t>(Sign | ((Exponent + 15) << 10) | Mantissa);
+  }
+
+  void Test(CBLAS_TRANSPOSE TransA, CBLAS_TRANSPOSE TransB, size_t M, size_t N, size_t K, float alpha, float beta) {
+    const float* A = BufferA.GetBuffer(K * M);
+    uint16_t* B = BufferB.GetBuffer(N * K);
+    float* C = BufferC.GetBuffer(N * M);
+    float* CReference = BufferCReference.GetBuffer(N * M);
+
+    for (size_t i = 0; i < N * K; i++) {
+      B[i] = HalfFromInteger(static_cast<int>(i % 7) - 3);
+    }
+
+    std::fill_n(C, M * N, -0.5f);
+    std::fill_n(CReference, M * N, -0.5f);
+
+    const size_t lda = (TransA == CblasNoTrans) ? K : M;
+    const size_t ldb = (TransB == CblasNoTrans) ? N : K;
+
+    MLAS_HALF_GEMM_DATA_PARAMS Data;
+    Data.A = A;
+    Data.lda = lda;
+    Data.C = C;
+    Data.ldc = N;
+    Data.alpha = alpha;
+    Data.beta = beta;
+
+    if (Packed) {
+      size_t PackedBSize = MlasHalfGemmPackBSize(N, K);
+      void* PackedB = BufferBPacked.GetBuffer(PackedBSize, true);
+      MlasHalfGemmPackB(TransB, N, K, B, ldb, PackedB);
+      Data.B = PackedB;
+      Data.BIsPacked = true;
+    } else {
+      Data.B = B;
+      Data.ldb = ldb;
+    }
+
+    MlasHalfGemmBatch(TransA, TransB, M, N, K, &Data, 1, threadpool_);
+
+    ReferenceGemm(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, CReference, N);
+
+    for (size_t m = 0, f = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++, f++) {
+        ASSERT_TRUE(CloseEnough(C[f], CReference[f]))
+            << "@[" << m << "x" << n << "], "
+            << "Trans=" << TransA << "/" << TransB << " "
+            << "M=" << M << ", N=" << N << ", K=" << K << ", "
+            << "alpha=" << alpha << ", beta=" << beta;
+      }
+    }
+  }
+
+  static float HalfToFloat(uint16_t Value) {
+    const int Exponent = (Value >> 10) & 0x1F;
+    const int Mantissa = Value & 0x3FF;
+    float Magnitude = (Exponent == 0) ? std::ldexp(float(Mantissa), -24)
+                                      : std::ldexp(float(Mantissa | 0x400), Exponent - 25);
+    return (Value & 0x8000) ? -Magnitude : Magnitude;
+  }
+
+  void ReferenceGemm(CBLAS_TRANSPOSE TransA, CBLAS_TRANSPOSE TransB, size_t M, size_t N, size_t K,
+                     float alpha, const float* A, size_t lda, const uint16_t* B, size_t ldb,
+                     float beta, float* C, size_t ldc) {
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        double sum = 0.0;
+        for (size_t k = 0; k < K; k++) {
+          float a = (TransA == CblasNoTrans) ? A[m * lda + k] : A[k * lda + m];
+          float b = HalfToFloat((TransB == CblasNoTrans) ? B[k * ldb + n] : B[n * ldb + k]);
+          sum += double(a) * double(b);
+        }
+        C[m * ldc + n] = float(sum * alpha + double(C[m * ldc + n]) * beta);
+      }
+    }
+  }
+
+  static bool CloseEnough(float actual, float expected) {
+    return std::abs(actual - expected) <= 1e-4f * std::max(1.0f, std::abs(expected));
+  }
+
+ public:
+  MlasHalfGemmTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("HalfGemm") +
+                                          (Packed ? "_Packed" : "_NoPack") +
+                                          (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    static const CBLAS_TRANSPOSE Transposes[] = {CblasNoTrans, CblasTrans};
+
+    for (CBLAS_TRANSPOSE TransA : Transposes) {
+      for (CBLAS_TRANSPOSE TransB : Transposes) {
+        for (size_t M = 1; M <= 14; M++) {
+          for (size_t N : {1, 7, 16, 17, 33, 130}) {
+            for (size_t K : {1, 3, 16, 31, 129}) {
+              Test(TransA, TransB, M, N, K, 1.0f, 0.0f);
+            }
+          }
+        }
+        Test(TransA, TransB, 37, 291, 300, 1.0f, 1.0f);
+        Test(TransA, TransB, 19, 67, 513, 0.5f, -1.5f);
+        Test(TransA, TransB, 1, 4096, 257, 2.0f, 0.0f);
+      }
+    }
+  }
+};
+
+template <> MlasHalfGemmTest<false, false>* MlasTestFixture<MlasHalfGemmTest<false, false>>::mlas_tester(nullptr);
+template <> MlasHalfGemmTest<true, false>* MlasTestFixture<MlasHalfGemmTest<true, false>>::mlas_tester(nullptr);
+template <> MlasHalfGemmTest<false, true>* MlasTestFixture<MlasHalfGemmTest<false, true>>::mlas_tester(nullptr);
+template <> MlasHalfGemmTest<true, true>* MlasTestFixture<MlasHalfGemmTest<true, true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasHalfGemmTest<false, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasHalfGemmTest<true, false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasHalfGemmTest<false, true>>::RegisterShortExecute();
+      count += MlasDirectShortExecuteTests<MlasHalfGemmTest<true, true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
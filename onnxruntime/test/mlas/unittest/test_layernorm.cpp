@@ -0,0 +1,179 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasLayerNormTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferSkip;
+  MatrixGuardBuffer<float> BufferSkipBias;
+  MatrixGuardBuffer<float> BufferScale;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  MatrixGuardBuffer<float> BufferMean;
+  MatrixGuardBuffer<float> BufferInvStdDev;
+  MLAS_THREADPOOL* threadpool_;
+
+  static constexpr float Epsilon = 1e-5f;
+
+  static void Fill(float* Buffer, size_t Count, float MinimumValue, float MaximumValue, unsigned Seed) {
+    std::default_random_engine generator(Seed);
+    std::uniform_real_distribution<float> distribution(MinimumValue, MaximumValue);
+
+    for (size_t i = 0; i < Count; i++) {
+      Buffer[i] = distribution(generator);
+    }
+  }
+
+  static void ReferenceLayerNorm(const float* Input,
+                                 const float* Skip,
+                                 const float* SkipBias,
+                                 const float* Scale,
+                                 const float* Bias,
+                                 float* Output,
+                                 float* Mean,
+                                 float* InvStdDev,
+                                 size_t N,
+                                 size_t D,
+                                 bool Simplified) {
+    std::vector<double> Values(D);
+
+    for (size_t n = 0; n < N; n++) {
+      double Sum = 0.0;
+
+      for (size_t d = 0; d < D; d++) {
+        double Value = Input[n * D + d];
+        if (Skip != nullptr) {
+          Value += Skip[n * D + d];
+          if (SkipBias != nullptr) {
+            Value += SkipBias[d];
+          }
+        }
+        Values[d] = Value;
+        Sum += Value;
+      }
+
+      double RowMean = Simplified ? 0.0 : Sum / D;
+      double Variance = 0.0;
+
+      for (size_t d = 0; d < D; d++) {
+        Variance += (Values[d] - RowMean) * (Values[d] - RowMean);
+      }
+
+      double RowInvStdDev = 1.0 / std::sqrt(Variance / D + Epsilon);
+
+      for (size_t d = 0; d < D; d++) {
+        double Value = (Values[d] - RowMean) * RowInvStdDev * Scale[d];
+        if (Bias != nullptr) {
+          Value += Bias[d];
+        }
+        Output[n * D + d] = float(Value);
+      }
+
+      Mean[n] = float(RowMean);
+      InvStdDev[n] = float(RowInvStdDev);
+    }
+  }
+
+  static void Check(const float* Actual, const float* Expected, size_t Count, const char* What, size_t N, size_t D) {
+    constexpr float AbsoluteTolerance = 1e-4f;
+    constexpr float RelativeTolerance = 1e-4f;
+
+    for (size_t i = 0; i < Count; i++) {
+      float diff = std::fabs(Actual[i] - Expected[i]);
+      ASSERT_TRUE(diff <= AbsoluteTolerance || diff <= std::fabs(Expected[i]) * RelativeTolerance)
+          << What << " difference " << N << "/" << D << " @" << i
+          << ", got: " << Actual[i] << ", expecting: " << Expected[i];
+    }
+  }
+
+  void Test(size_t N, size_t D, float MinimumValue, float MaximumValue) {
+    float* Input = BufferInput.GetBuffer(N * D);
+    float* Skip = BufferSkip.GetBuffer(N * D);
+    float* SkipBias = BufferSkipBias.GetBuffer(D);
+    float* Scale = BufferScale.GetBuffer(D);
+    float* Bias = BufferBias.GetBuffer(D);
+    float* Output = BufferOutput.GetBuffer(N * D);
+    float* OutputReference = BufferOutputReference.GetBuffer(N * D);
+    float* Mean = BufferMean.GetBuffer(N * 2);
+    float* InvStdDev = BufferInvStdDev.GetBuffer(N * 2);
+
+    unsigned Seed = static_cast<unsigned>(N * D);
+
+    Fill(Input, N * D, MinimumValue, MaximumValue, Seed);
+    Fill(Skip, N * D, -1.f, 1.f, Seed + 1);
+    Fill(SkipBias, D, -1.f, 1.f, Seed + 2);
+    Fill(Scale, D, -2.f, 2.f, Seed + 3);
+    Fill(Bias, D, -1.f, 1.f, Seed + 4);
+
+    //
+    // The reference mean and inverse standard deviation are stored after
+    // the values produced by the library.
+    //
+
+    for (int Simplified = 0; Simplified < 2; Simplified++) {
+      for (int HasBias = 0; HasBias < 2; HasBias++) {
+        const float* BiasOrNull = (HasBias && !Simplified) ? Bias : nullptr;
+
+        MlasComputeLayerNorm(Input, Scale, BiasOrNull, Output, Mean, InvStdDev, N, D, Epsilon,
+                             Simplified != 0, threadpool_);
+        ReferenceLayerNorm(Input, nullptr, nullptr, Scale, BiasOrNull, OutputReference, Mean + N, InvStdDev + N,
+                           N, D, Simplified != 0);
+
+        Check(Output, OutputReference, N * D, Simplified ? "SimplifiedLayerNorm" : "LayerNorm", N, D);
+        Check(Mean, Mean + N, N, "Mean", N, D);
+        Check(InvStdDev, InvStdDev + N, N, "InvStdDev", N, D);
+      }
+    }
+
+    for (int HasSkipBias = 0; HasSkipBias < 2; HasSkipBias++) {
+      for (int HasBias = 0; HasBias < 2; HasBias++) {
+        const float* SkipBiasOrNull = HasSkipBias ? SkipBias : nullptr;
+        const float* BiasOrNull = HasBias ? Bias : nullptr;
+
+        MlasComputeSkipLayerNorm(Input, Skip, SkipBiasOrNull, Scale, BiasOrNull, Output, N, D, Epsilon,
+                                 threadpool_);
+        ReferenceLayerNorm(Input, Skip, SkipBiasOrNull, Scale, BiasOrNull, OutputReference, Mean, InvStdDev,
+                           N, D, false);
+
+        Check(Output, OutputReference, N * D, "SkipLayerNorm", N, D);
+      }
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "LayerNorm_Threaded" : "LayerNorm_SingleThread");
+    return suite_name.c_str();
+  }
+
+  MlasLayerNormTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void ExecuteShort(void) override {
+    for (size_t d = 1; d < 128; d++) {
+      Test(1, d, -10.f, 10.f);
+    }
+
+    Test(3, 128, 20.f, 30.f);
+    Test(63, 95, -150.f, 190.f);
+    Test(16, 768, -2.f, 2.f);
+    Test(7, 1024, 10.f, 12.f);
+  }
+};
+
+template <> MlasLayerNormTest<false>* MlasTestFixture<MlasLayerNormTest<false>>::mlas_tester(nullptr);
+template <> MlasLayerNormTest<true>* MlasTestFixture<MlasLayerNormTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasLayerNormTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasLayerNormTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
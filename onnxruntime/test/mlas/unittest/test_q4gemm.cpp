@@ -0,0 +1,141 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasQ4GemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<uint8_t> BufferQuantB;
+  MatrixGuardBuffer<float> BufferScales;
+  MatrixGuardBuffer<uint8_t> BufferZeroPoints;
+  MatrixGuardBuffer<uint8_t> BufferPackedB;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  void Test(size_t M, size_t N, size_t K, size_t BlockSize, bool WithZeroPoints, bool WithBias) {
+    const size_t BlockCountK = (K + BlockSize - 1) / BlockSize;
+    const size_t ZeroPointStride = (BlockCountK + 1) / 2;
+
+    const float* A = BufferA.GetBuffer(K * M);
+    uint8_t* QuantB = BufferQuantB.GetBuffer(N * BlockCountK * BlockSize / 2);
+    float* Scales = BufferScales.GetBuffer(N * BlockCountK);
+    uint8_t* ZeroPoints = BufferZeroPoints.GetBuffer(N * ZeroPointStride);
+    const float* Bias = WithBias ? BufferBias.GetBuffer(N) : nullptr;
+    float* C = BufferC.GetBuffer(N * M);
+    float* CReference = BufferCReference.GetBuffer(N * M);
+
+    for (size_t i = 0; i < N * BlockCountK * BlockSize / 2; i++) {
+      QuantB[i] = static_cast<uint8_t>((i * 37 + 11) & 0xFF);
+    }
+    for (size_t i = 0; i < N * BlockCountK; i++) {
+      Scales[i] = 0.125f * static_cast<float>((i % 5) + 1);
+    }
+    for (size_t i = 0; i < N * ZeroPointStride; i++) {
+      ZeroPoints[i] = static_cast<uint8_t>((i * 29 + 3) & 0xFF);
+    }
+
+    std::fill_n(C, M * N, -0.5f);
+
+    const uint8_t* zp = WithZeroPoints ? ZeroPoints : nullptr;
+
+    size_t PackedBSize = MlasQ4GemmPackBSize(N, K, BlockSize);
+    ASSERT_NE(PackedBSize, size_t(0));
+    void* PackedB = BufferPackedB.GetBuffer(PackedBSize, true);
+    MlasQ4GemmPackB(N, K, BlockSize, QuantB, Scales, zp, PackedB);
+
+    MLAS_Q4GEMM_DATA_PARAMS Data;
+    Data.A = A;
+    Data.lda = K;
+    Data.PackedB = PackedB;
+    Data.C = C;
+    Data.ldc = N;
+    Data.Bias = Bias;
+
+    MlasQ4GemmBatch(M, N, K, BlockSize, &Data, 1, threadpool_);
+
+    ReferenceQ4Gemm(M, N, K, BlockSize, A, QuantB, Scales, zp, Bias, CReference);
+
+    for (size_t m = 0, f = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++, f++) {
+        ASSERT_TRUE(CloseEnough(C[f], CReference[f]))
+            << "@[" << m << "x" << n << "], "
+            << "M=" << M << ", N=" << N << ", K=" << K << ", BlockSize=" << BlockSize
+            << ", ZeroPoints=" << WithZeroPoints << ", Bias=" << WithBias;
+      }
+    }
+  }
+
+  static void ReferenceQ4Gemm(size_t M, size_t N, size_t K, size_t BlockSize,
+                              const float* A, const uint8_t* QuantB, const float* Scales,
+                              const uint8_t* ZeroPoints, const float* Bias, float* C) {
+    const size_t BlockCountK = (K + BlockSize - 1) / BlockSize;
+    const size_t ZeroPointStride = (BlockCountK + 1) / 2;
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        double sum = (Bias != nullptr) ? double(Bias[n]) : 0.0;
+        for (size_t k = 0; k < K; k++) {
+          const size_t kb = k / BlockSize;
+          const size_t kk = k % BlockSize;
+          const uint8_t Packed = QuantB[(n * BlockCountK + kb) * (BlockSize / 2) + kk / 2];
+          const int q = (kk & 1) ? (Packed >> 4) : (Packed & 0x0F);
+          int zp = 8;
+          if (ZeroPoints != nullptr) {
+            const uint8_t PackedZeroPoint = ZeroPoints[n * ZeroPointStride + kb / 2];
+            zp = (kb & 1) ? (PackedZeroPoint >> 4) : (PackedZeroPoint & 0x0F);
+          }
+          const double b = double(q - zp) * double(Scales[n * BlockCountK + kb]);
+          sum += double(A[m * K + k]) * b;
+        }
+        C[m * N + n] = float(sum);
+      }
+    }
+  }
+
+  static bool CloseEnough(float actual, float expected) {
+    return std::abs(actual - expected) <= 1e-4f * std::max(1.0f, std::abs(expected));
+  }
+
+ public:
+  MlasQ4GemmTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("Q4Gemm") +
+                                          (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t BlockSize : {16, 32, 64, 128}) {
+      for (size_t M : {1, 2, 3, 4, 5, 9, 13}) {
+        for (size_t N : {1, 15, 16, 33, 80}) {
+          for (size_t K : {1, 16, 31, 130}) {
+            Test(M, N, K, BlockSize, true, false);
+          }
+        }
+      }
+      Test(1, 4096, 256, BlockSize, false, true);
+      Test(17, 291, 513, BlockSize, true, true);
+      Test(64, 96, 1024, BlockSize, false, false);
+    }
+    Test(3, 70, 600, 256, true, true);
+  }
+};
+
+template <> MlasQ4GemmTest<false>* MlasTestFixture<MlasQ4GemmTest<false>>::mlas_tester(nullptr);
+template <> MlasQ4GemmTest<true>* MlasTestFixture<MlasQ4GemmTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasQ4GemmTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasQ4GemmTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
@@ -22,6 +22,29 @@ class MlasTransposeTest : public MlasTestBase {
     ASSERT_EQ(memcmp(Output, OutputReference, M * N * sizeof(ElementType)), 0) << " [" << M << "," << N << "]";
   }
 
+  void
+  TestStrided(size_t M, size_t N, size_t ldInput, size_t ldOutput) {
+    ElementType* Input = BufferInput.GetBuffer(M * ldInput);
+    ElementType* Output = BufferOutput.GetBuffer(N * ldOutput);
+    ElementType* OutputReference = BufferOutputReference.GetBuffer(N * ldOutput);
+
+    for (size_t i = 0; i < M * ldInput; i++) {
+      Input[i] = static_cast<ElementType>(i * 7 + 3);
+    }
+    std::fill_n(Output, N * ldOutput, ElementType(0));
+    std::fill_n(OutputReference, N * ldOutput, ElementType(0));
+
+    MlasTranspose(Input, ldInput, Output, ldOutput, M, N);
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        OutputReference[n * ldOutput + m] = Input[m * ldInput + n];
+      }
+    }
+
+    ASSERT_EQ(memcmp(Output, OutputReference, N * ldOutput * sizeof(ElementType)), 0)
+        << " [" << M << "," << N << "," << ldInput << "," << ldOutput << "]";
+  }
+
   void ReferenceTranspose(const ElementType* Input, ElementType* Output, size_t M, size_t N) {
     for (size_t m = 0; m < M; m++) {
       for (size_t n = 0; n < N; n++) {
@@ -40,6 +63,7 @@ class MlasTransposeTest : public MlasTestBase {
     for (size_t m = 1; m <= 32; m++) {
       for (size_t n = 1; n <= 32; n++) {
         Test(m, n);
+        TestStrided(m, n, n + 3, m + 5);
       }
     }
   }
@@ -26,6 +26,8 @@ OrtEnv* env = nullptr;
 
 using namespace onnxruntime;
 
+void RegisterOpBenchmarks();
+
 static void BM_CPUAllocator(benchmark::State& state) {
   AllocatorPtr cpu_allocator = std::make_shared<CPUAllocator>();
   const size_t len = state.range(0);
@@ -79,6 +81,7 @@ int main(int argc, char** argv) {
   if (::benchmark::ReportUnrecognizedArguments(argc, argv))
     return -1;
   ORT_ABORT_ON_ERROR(g_ort->CreateEnv(ORT_LOGGING_LEVEL_ERROR, "test", &env));
+  RegisterOpBenchmarks();
   ::benchmark::RunSpecifiedBenchmarks();
   g_ort->ReleaseEnv(env);
   return 0;
@@ -0,0 +1,317 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// Benchmarks of single operators on the CPU EP. Each case builds a model with one node, and runs it in a session
+// for each intra-op thread count, so the numbers include the overhead a kernel has in a real model.
+// The benchmarks are named 'BM_Op/<op type>/<case>/threads:<n>'. Use the Google Benchmark options to select and
+// record them, e.g.
+//   onnxruntime_benchmark --benchmark_filter=BM_Op/Softmax --benchmark_out=ops.json --benchmark_out_format=json
+// The JSON output of two builds can be compared with tools/compare.py of Google Benchmark to find the operators that
+// regressed.
+
+#include <benchmark/benchmark.h>
+#include <core/graph/model.h>
+#include <core/session/onnxruntime_cxx_api.h>
+#include <core/session/ort_env.h>
+#include <onnx/defs/attr_proto_util.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+extern OrtEnv* env;
+
+using namespace onnxruntime;
+using namespace ONNX_NAMESPACE;
+
+namespace {
+
+// An input of the benchmarked node. Constant inputs are added to the model as initializers, the others are graph
+// inputs that are fed with random values.
+struct OpInput {
+  TensorProto tensor;
+  bool is_constant;
+};
+
+struct OpCase {
+  std::string op_type;
+  std::string domain;
+  std::string name;
+  std::vector<AttributeProto> attributes;
+  std::vector<OpInput> inputs;
+  size_t num_outputs;
+};
+
+OpInput Input(const std::vector<int64_t>& dims) {
+  OpInput input{TensorProto(), false};
+  input.tensor.set_data_type(TensorProto_DataType_FLOAT);
+  for (int64_t dim : dims) {
+    input.tensor.add_dims(dim);
+  }
+
+  return input;
+}
+
+OpInput Int64Constant(const std::vector<int64_t>& dims, const std::vector<int64_t>& values) {
+  OpInput input{TensorProto(), true};
+  input.tensor.set_data_type(TensorProto_DataType_INT64);
+  for (int64_t dim : dims) {
+    input.tensor.add_dims(dim);
+  }
+
+  for (int64_t value : values) {
+    input.tensor.add_int64_data(value);
+  }
+
+  return input;
+}
+
+// A float constant of the given shape. The values are random, unless they are given.
+OpInput FloatConstant(const std::vector<int64_t>& dims, const std::vector<float>& values = {}) {
+  OpInput input{TensorProto(), true};
+  input.tensor.set_data_type(TensorProto_DataType_FLOAT);
+  int64_t size = 1;
+  for (int64_t dim : dims) {
+    input.tensor.add_dims(dim);
+    size *= dim;
+  }
+
+  if (!values.empty()) {
+    for (float value : values) {
+      input.tensor.add_float_data(value);
+    }
+  } else {
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    for (int64_t i = 0; i < size; ++i) {
+      input.tensor.add_float_data(dist(gen));
+    }
+  }
+
+  return input;
+}
+
+// The indices for a Gather from a dim of the given size
+OpInput GatherIndices(const std::vector<int64_t>& dims, int64_t dim_size) {
+  int64_t size = 1;
+  for (int64_t dim : dims) {
+    size *= dim;
+  }
+
+  std::vector<int64_t> values(static_cast<size_t>(size));
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<int64_t> dist(0, dim_size - 1);
+  for (auto& value : values) {
+    value = dist(gen);
+  }
+
+  return Int64Constant(dims, values);
+}
+
+std::string DimsToString(const std::vector<int64_t>& dims) {
+  std::string name;
+  for (int64_t dim : dims) {
+    name += (name.empty() ? "" : "x") + std::to_string(dim);
+  }
+
+  return name;
+}
+
+std::vector<OpCase> GetOpCases() {
+  std::vector<OpCase> cases;
+
+  // the shapes of typical activations: [batch * sequence, hidden] and [batch, heads, sequence, sequence]
+  for (const auto& dims : std::vector<std::vector<int64_t>>{{128, 768}, {8, 12, 128, 128}, {64, 1000}}) {
+    cases.push_back({"Softmax", kOnnxDomain, DimsToString(dims),
+                     {MakeAttribute("axis", static_cast<int64_t>(dims.size() - 1))}, {Input(dims)}, 1});
+    cases.push_back({"ReduceSum", kOnnxDomain, DimsToString(dims),
+                     {MakeAttribute("axes", std::vector<int64_t>{-1})}, {Input(dims)}, 1});
+    cases.push_back({"ReduceMean", kOnnxDomain, DimsToString(dims),
+                     {MakeAttribute("axes", std::vector<int64_t>{-1})}, {Input(dims)}, 1});
+    cases.push_back({"ReduceMax", kOnnxDomain, DimsToString(dims),
+                     {MakeAttribute("axes", std::vector<int64_t>{-1})}, {Input(dims)}, 1});
+    cases.push_back({"TopK", kOnnxDomain, DimsToString(dims), {},
+                     {Input(dims), Int64Constant({1}, {5})}, 2});
+  }
+
+  for (const auto& dims : std::vector<std::vector<int64_t>>{{1, 128, 768}, {8, 128, 768}, {8, 512, 1024}}) {
+    const int64_t hidden_size = dims.back();
+    cases.push_back({"LayerNormalization", kOnnxDomain, DimsToString(dims),
+                     {MakeAttribute("axis", static_cast<int64_t>(-1)), MakeAttribute("epsilon", 1e-5f)},
+                     {Input(dims), FloatConstant({hidden_size}), FloatConstant({hidden_size})}, 1});
+    cases.push_back({"SkipLayerNormalization", kMSDomain, DimsToString(dims),
+                     {MakeAttribute("epsilon", 1e-5f)},
+                     {Input(dims), Input(dims), FloatConstant({hidden_size}), FloatConstant({hidden_size})}, 1});
+    cases.push_back({"Gelu", kMSDomain, DimsToString(dims), {}, {Input(dims)}, 1});
+    cases.push_back({"Attention", kMSDomain, DimsToString(dims),
+                     {MakeAttribute("num_heads", hidden_size / 64)},
+                     {Input(dims), FloatConstant({hidden_size, 3 * hidden_size}), FloatConstant({3 * hidden_size})},
+                     1});
+    cases.push_back({"MatMul", kOnnxDomain, DimsToString(dims), {},
+                     {Input(dims), FloatConstant({hidden_size, hidden_size})}, 1});
+    cases.push_back({"Gather", kOnnxDomain, DimsToString(dims), {},
+                     {Input({8192, hidden_size}), GatherIndices({dims[0], dims[1]}, 8192)}, 1});
+    cases.push_back({"Concat", kOnnxDomain, DimsToString(dims), {MakeAttribute("axis", static_cast<int64_t>(-1))},
+                     {Input(dims), Input(dims)}, 1});
+    cases.push_back({"Split", kOnnxDomain, DimsToString(dims), {MakeAttribute("axis", static_cast<int64_t>(-1))},
+                     {Input({dims[0], dims[1], 3 * hidden_size})}, 3});
+    cases.push_back({"Slice", kOnnxDomain, DimsToString(dims), {},
+                     {Input(dims), Int64Constant({1}, {1}), Int64Constant({1}, {-1}), Int64Constant({1}, {1})}, 1});
+    cases.push_back({"Pad", kOnnxDomain, DimsToString(dims), {},
+                     {Input(dims), Int64Constant({6}, {0, 1, 0, 0, 1, 0})}, 1});
+    cases.push_back({"Tile", kOnnxDomain, DimsToString(dims), {},
+                     {Input(dims), Int64Constant({3}, {1, 2, 1})}, 1});
+    cases.push_back({"Cast", kOnnxDomain, DimsToString(dims),
+                     {MakeAttribute("to", static_cast<int64_t>(TensorProto_DataType_FLOAT16))}, {Input(dims)}, 1});
+  }
+
+  // the transposes of multi-head attention and of a matrix
+  for (const auto& dims : std::vector<std::vector<int64_t>>{{8, 128, 12, 64}, {8, 512, 16, 64}}) {
+    cases.push_back({"Transpose", kOnnxDomain, DimsToString(dims),
+                     {MakeAttribute("perm", std::vector<int64_t>{0, 2, 1, 3})}, {Input(dims)}, 1});
+  }
+
+  cases.push_back({"Transpose", kOnnxDomain, "1024x1024", {}, {Input({1024, 1024})}, 1});
+
+  for (const auto& dims : std::vector<std::vector<int64_t>>{{1, 64, 56, 56}, {1, 256, 28, 28}}) {
+    for (const char* mode : {"nearest", "linear"}) {
+      cases.push_back({"Resize", kOnnxDomain, std::string(mode) + "/" + DimsToString(dims),
+                       {MakeAttribute("mode", std::string(mode))},
+                       {Input(dims), FloatConstant({0}, {}), FloatConstant({4}, {1.0f, 1.0f, 2.0f, 2.0f})}, 1});
+    }
+  }
+
+  return cases;
+}
+
+// Creates the serialized model with one node for the case.
+std::string CreateModel(const OpCase& op_case) {
+  auto logger = env->GetLoggingManager()->CreateLogger("test");
+  std::unordered_map<std::string, int> domain_to_version{{kOnnxDomain, 12}, {kMSDomain, 1}};
+  Model model("op_benchmark", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              domain_to_version, {}, *logger);
+  Graph& graph = model.MainGraph();
+
+  std::vector<NodeArg*> input_args;
+  for (size_t i = 0; i < op_case.inputs.size(); ++i) {
+    const auto& input = op_case.inputs[i];
+    const std::string name = "input_" + std::to_string(i);
+
+    TypeProto type;
+    type.mutable_tensor_type()->set_elem_type(input.tensor.data_type());
+    for (int64_t dim : input.tensor.dims()) {
+      type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+    }
+
+    if (input.is_constant) {
+      TensorProto initializer(input.tensor);
+      initializer.set_name(name);
+      graph.AddInitializedTensor(initializer);
+    }
+
+    input_args.push_back(&graph.GetOrCreateNodeArg(name, &type));
+  }
+
+  std::vector<NodeArg*> output_args;
+  for (size_t i = 0; i < op_case.num_outputs; ++i) {
+    output_args.push_back(&graph.GetOrCreateNodeArg("output_" + std::to_string(i), nullptr));
+  }
+
+  std::unordered_map<std::string, AttributeProto> attributes;
+  for (const AttributeProto& attribute : op_case.attributes) {
+    attributes[attribute.name()] = attribute;
+  }
+
+  graph.AddNode("node", op_case.op_type, "", input_args, output_args, &attributes, op_case.domain);
+  ORT_THROW_IF_ERROR(graph.Resolve());
+  return model.ToProto().SerializeAsString();
+}
+
+void BM_Op(benchmark::State& state, const OpCase& op_case) {
+  ORT_TRY {
+    const std::string model_data = CreateModel(op_case);
+
+    Ort::Unowned<Ort::Env> ort_env{env};
+    Ort::SessionOptions session_options;
+    session_options.SetIntraOpNumThreads(static_cast<int>(state.range(0)));
+    // keep the node as is
+    session_options.SetGraphOptimizationLevel(ORT_DISABLE_ALL);
+    Ort::Session session{ort_env, model_data.data(), model_data.size(), session_options};
+
+    auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+    std::vector<std::string> input_names;
+    std::vector<std::vector<float>> input_data;
+    std::vector<Ort::Value> inputs;
+    for (size_t i = 0; i < op_case.inputs.size(); ++i) {
+      const auto& input = op_case.inputs[i];
+      if (input.is_constant) {
+        continue;
+      }
+
+      const std::vector<int64_t> dims(input.tensor.dims().begin(), input.tensor.dims().end());
+      int64_t size = 1;
+      for (int64_t dim : dims) {
+        size *= dim;
+      }
+
+      input_data.emplace_back(static_cast<size_t>(size));
+      std::generate(input_data.back().begin(), input_data.back().end(), [&]() { return dist(gen); });
+      inputs.push_back(Ort::Value::CreateTensor<float>(memory_info, input_data.back().data(),
+                                                       input_data.back().size(), dims.data(), dims.size()));
+      input_names.push_back("input_" + std::to_string(i));
+    }
+
+    std::vector<std::string> output_names;
+    for (size_t i = 0; i < op_case.num_outputs; ++i) {
+      output_names.push_back("output_" + std::to_string(i));
+    }
+
+    std::vector<const char*> input_name_ptrs;
+    for (const auto& name : input_names) {
+      input_name_ptrs.push_back(name.c_str());
+    }
+
+    std::vector<const char*> output_name_ptrs;
+    for (const auto& name : output_names) {
+      output_name_ptrs.push_back(name.c_str());
+    }
+
+    Ort::RunOptions run_options;
+    for (auto _ : state) {
+      auto outputs = session.Run(run_options, input_name_ptrs.data(), inputs.data(), inputs.size(),
+                                 output_name_ptrs.data(), output_name_ptrs.size());
+      benchmark::DoNotOptimize(outputs);
+    }
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      state.SkipWithError(ex.what());
+    });
+  }
+}
+
+}  // namespace
+
+// Registers a benchmark for each case and intra-op thread count. It needs to be called before running the benchmarks.
+void RegisterOpBenchmarks() {
+  std::vector<int64_t> thread_counts{1, 2, 4};
+  const int64_t hardware_threads = static_cast<int64_t>(std::thread::hardware_concurrency());
+  if (hardware_threads > thread_counts.back()) {
+    thread_counts.push_back(hardware_threads);
+  }
+
+  for (const OpCase& op_case : GetOpCases()) {
+    const std::string name = "BM_Op/" + op_case.op_type + "/" + op_case.name;
+    auto* op_benchmark = benchmark::RegisterBenchmark(name.c_str(), BM_Op, op_case);
+    op_benchmark->ArgName("threads")->UseRealTime()->Unit(benchmark::TimeUnit::kMicrosecond);
+    for (int64_t thread_count : thread_counts) {
+      op_benchmark->Arg(thread_count);
+    }
+  }
+}
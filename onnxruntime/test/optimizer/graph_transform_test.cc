@@ -511,6 +511,126 @@ TEST_F(GraphTransformationTests, ConstantFoldingAShapeNodeDeepInTheGraph) {
   ASSERT_TRUE(op_to_count.size() == 0);
 }
 
+TEST_F(GraphTransformationTests, ConstantFoldingMaxOutputSize) {
+  TypeProto float_tensor_type;
+  float_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  TypeProto int64_tensor_type;
+  int64_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+  int64_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+  // ConstantOfShape produces a constant of 4096 bytes that ReduceSum reduces to a scalar
+  auto fold = [&](size_t max_output_size_in_bytes, std::map<std::string, int>& op_to_count,
+                  bool& has_large_initializer) {
+    Model model("ConstantFoldingMaxOutputSize", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {}, *logger_);
+    auto& graph = model.MainGraph();
+
+    TensorProto shape_tensor;
+    shape_tensor.set_name("shape");
+    shape_tensor.set_data_type(TensorProto_DataType_INT64);
+    shape_tensor.add_dims(1);
+    shape_tensor.add_int64_data(1024);
+    graph.AddInitializedTensor(shape_tensor);
+
+    TensorProto value_tensor;
+    value_tensor.set_data_type(TensorProto_DataType_FLOAT);
+    value_tensor.add_dims(1);
+    value_tensor.add_float_data(1.f);
+
+    auto& shape_arg = graph.GetOrCreateNodeArg("shape", &int64_tensor_type);
+    auto& large_arg = graph.GetOrCreateNodeArg("large", &float_tensor_type);
+    auto& sum_arg = graph.GetOrCreateNodeArg("sum", &float_tensor_type);
+    auto& input_arg = graph.GetOrCreateNodeArg("input", &float_tensor_type);
+    auto& output_arg = graph.GetOrCreateNodeArg("output", &float_tensor_type);
+
+    auto& constant_of_shape = graph.AddNode("constant_of_shape", "ConstantOfShape", "", {&shape_arg}, {&large_arg});
+    constant_of_shape.AddAttribute("value", value_tensor);
+    auto& reduce_sum = graph.AddNode("reduce_sum", "ReduceSum", "", {&large_arg}, {&sum_arg});
+    reduce_sum.AddAttribute("keepdims", static_cast<int64_t>(0));
+    graph.AddNode("add", "Add", "", {&input_arg, &sum_arg}, {&output_arg});
+
+    ASSERT_STATUS_OK(graph.Resolve());
+
+    std::unique_ptr<CPUExecutionProvider> e =
+        std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo());
+    onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+    ASSERT_STATUS_OK(graph_transformation_mgr.Register(
+        std::make_unique<ConstantFolding>(*e.get(), false /*skip_dequantize_linear*/,
+                                          std::unordered_set<std::string>{}, std::unordered_set<std::string>{},
+                                          max_output_size_in_bytes),
+        TransformerLevel::Level1));
+    ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+    op_to_count = CountOpsInGraph(graph);
+    const TensorProto* large_initializer = nullptr;
+    has_large_initializer = graph.GetInitializedTensor("large", large_initializer);
+  };
+
+  std::map<std::string, int> op_to_count;
+  bool has_large_initializer = true;
+
+  // without a limit both nodes are folded, and the intermediate value isn't added to the model
+  fold(0, op_to_count, has_large_initializer);
+  ASSERT_TRUE(op_to_count["ConstantOfShape"] == 0);
+  ASSERT_TRUE(op_to_count["ReduceSum"] == 0);
+  ASSERT_TRUE(op_to_count["Add"] == 1);
+  ASSERT_FALSE(has_large_initializer);
+
+  // the output of ConstantOfShape exceeds the limit, so neither node is folded
+  fold(1024, op_to_count, has_large_initializer);
+  ASSERT_TRUE(op_to_count["ConstantOfShape"] == 1);
+  ASSERT_TRUE(op_to_count["ReduceSum"] == 1);
+  ASSERT_TRUE(op_to_count["Add"] == 1);
+  ASSERT_FALSE(has_large_initializer);
+}
+
+TEST_F(GraphTransformationTests, ConstantFoldingGatherOfShapeWithSymbolicDims) {
+  Model model("ConstantFoldingGatherOfShapeWithSymbolicDims", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {}, *logger_);
+  auto& graph = model.MainGraph();
+
+  TensorProto indices_tensor;
+  indices_tensor.set_name("indices");
+  indices_tensor.set_data_type(TensorProto_DataType_INT64);
+  indices_tensor.add_int64_data(1);
+  graph.AddInitializedTensor(indices_tensor);
+
+  // only the first dim of the input is symbolic
+  TypeProto input_type;
+  input_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(256);
+  TypeProto int64_tensor_type;
+  int64_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+
+  auto& input_arg = graph.GetOrCreateNodeArg("input", &input_type);
+  auto& shape_arg = graph.GetOrCreateNodeArg("shape", &int64_tensor_type);
+  auto& indices_arg = graph.GetOrCreateNodeArg("indices", &int64_tensor_type);
+  auto& dim_arg = graph.GetOrCreateNodeArg("dim", &int64_tensor_type);
+
+  graph.AddNode("shape", "Shape", "", {&input_arg}, {&shape_arg});
+  graph.AddNode("gather", "Gather", "", {&shape_arg, &indices_arg}, {&dim_arg});
+  graph.SetInputs({&input_arg});
+  graph.SetOutputs({&dim_arg});
+
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::unique_ptr<CPUExecutionProvider> e =
+      std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo());
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(
+      std::make_unique<ConstantFolding>(*e.get(), false /*skip_dequantize_linear*/), TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_TRUE(op_to_count["Shape"] == 0);
+  ASSERT_TRUE(op_to_count["Gather"] == 0);
+
+  const TensorProto* dim_initializer = nullptr;
+  ASSERT_TRUE(graph.GetInitializedTensor("dim", dim_initializer));
+  Initializer dim{*dim_initializer, graph.ModelPath()};
+  ASSERT_EQ(dim.size(), 1);
+  ASSERT_EQ(*dim.data<int64_t>(), 256);
+}
+
 // Check transformations in the case of a subgraph with constant inputs.
 TEST_F(GraphTransformationTests, SubgraphWithConstantInputs) {
   auto model_uri = MODEL_FOLDER "constant-subgraph.onnx";
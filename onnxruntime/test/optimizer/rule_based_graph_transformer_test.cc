@@ -10,6 +10,7 @@
 #include "core/graph/model.h"
 #include "core/optimizer/graph_transformer.h"
 #include "core/optimizer/graph_transformer_mgr.h"
+#include "core/optimizer/rewrite_rule.h"
 #include "dummy_graph_transformer.h"
 #include "test/framework/test_utils.h"
 #include "test/test_environment.h"
@@ -59,6 +60,80 @@ TEST(RuleBasedGraphTransformerTest, TestCompatibleProviders) {
   ASSERT_TRUE(dummy_rule1_ptr->IsRewriteRuleInvoked());
 }
 
+// Rewrite rule that counts the nodes it is checked against, but never applies
+class CountingRewriteRule : public RewriteRule {
+ public:
+  CountingRewriteRule() noexcept : RewriteRule("CountingRule") {}
+
+  size_t NodesChecked() const { return nodes_checked_; }
+
+  std::vector<std::string> TargetOpTypes() const noexcept override {
+    return std::vector<std::string>();
+  }
+
+ private:
+  mutable size_t nodes_checked_ = 0;
+
+  bool SatisfyCondition(const Graph& /*graph*/, const Node& /*node*/, const logging::Logger& /*logger*/) const override {
+    ++nodes_checked_;
+    return false;
+  }
+
+  Status Apply(Graph& /*graph*/, Node& /*node*/, RewriteRuleEffect& /*rule_effect*/,
+               const logging::Logger& /*logger*/) const override {
+    return Status::OK();
+  }
+};
+
+TEST(RuleBasedGraphTransformerTest, TestOnlyAffectedNodesAreRevisited) {
+  auto model_uri = ORT_TSTR("testdata/transform/fusion/fuse-conv-bn-mul-add-unsqueeze.onnx");
+  const auto& logger = DefaultLoggingManager().DefaultLogger();
+
+  std::shared_ptr<Model> model;
+  ASSERT_STATUS_OK(Model::Load(model_uri, model, nullptr, logger));
+  Graph& graph = model->MainGraph();
+
+  auto counting_rule = std::make_unique<CountingRewriteRule>();
+  const auto* counting_rule_ptr = counting_rule.get();
+  RuleBasedGraphTransformer graph_transformer("CountingTransformer");
+  ASSERT_STATUS_OK(graph_transformer.Register(std::move(counting_rule)));
+
+  // all the nodes are checked the first time
+  bool modified = false;
+  ASSERT_STATUS_OK(graph_transformer.Apply(graph, modified, logger));
+  ASSERT_FALSE(modified);
+  ASSERT_EQ(counting_rule_ptr->NodesChecked(), static_cast<size_t>(graph.NumberOfNodes()));
+
+  // nothing is checked if the graph wasn't modified
+  ASSERT_STATUS_OK(graph_transformer.Apply(graph, modified, logger));
+  ASSERT_EQ(counting_rule_ptr->NodesChecked(), static_cast<size_t>(graph.NumberOfNodes()));
+
+  // only the modified node and its neighbors are checked after a change
+  Node* node_to_modify = nullptr;
+  for (auto& node : graph.Nodes()) {
+    if (node_to_modify == nullptr ||
+        node.GetInputEdgesCount() + node.GetOutputEdgesCount() <
+            node_to_modify->GetInputEdgesCount() + node_to_modify->GetOutputEdgesCount()) {
+      node_to_modify = &node;
+    }
+  }
+
+  ASSERT_NE(node_to_modify, nullptr);
+  const uint64_t stamp = graph.ModificationStamp();
+  node_to_modify->AddAttribute("test_attribute", static_cast<int64_t>(1));
+  ASSERT_GT(graph.ModificationStamp(), stamp);
+
+  const auto affected_nodes = graph.GetNodesAffectedSince(stamp);
+  ASSERT_EQ(affected_nodes.size(),
+            1 + node_to_modify->GetInputEdgesCount() + node_to_modify->GetOutputEdgesCount());
+  ASSERT_EQ(affected_nodes.count(node_to_modify->Index()), static_cast<size_t>(1));
+  ASSERT_LT(affected_nodes.size(), static_cast<size_t>(graph.NumberOfNodes()));
+
+  const size_t nodes_checked_before = counting_rule_ptr->NodesChecked();
+  ASSERT_STATUS_OK(graph_transformer.Apply(graph, modified, logger));
+  ASSERT_EQ(counting_rule_ptr->NodesChecked() - nodes_checked_before, affected_nodes.size());
+}
+
 TEST(RuleBasedGraphTransformerTest, TestSettingStepsInGraphTransformerManager) {
   // steps provided at object construction time
   onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
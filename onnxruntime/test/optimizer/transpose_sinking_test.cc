@@ -0,0 +1,213 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+
+namespace onnxruntime {
+namespace test {
+
+static NodeArg* AddTransposeNode(ModelTestBuilder& builder, NodeArg* input_arg, const std::vector<int64_t>& perm,
+                                 NodeArg* output_arg = nullptr) {
+  if (output_arg == nullptr) {
+    output_arg = builder.MakeIntermediate();
+  }
+  builder.AddNode("Transpose", {input_arg}, {output_arg}).AddAttribute("perm", perm);
+  return output_arg;
+}
+
+static const std::vector<int64_t> kNchwToNhwc = {0, 2, 3, 1};
+static const std::vector<int64_t> kNhwcToNchw = {0, 3, 1, 2};
+
+TEST(TransposeSinkingTests, CancelThroughUnaryOps) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({1, 3, 5, 7}, -1.f, 1.f);
+    auto* relu_output_arg = builder.MakeIntermediate();
+    auto* sigmoid_output_arg = builder.MakeIntermediate();
+
+    auto* transpose_output_arg = AddTransposeNode(builder, input_arg, kNchwToNhwc);
+    builder.AddNode("Relu", {transpose_output_arg}, {relu_output_arg});
+    builder.AddNode("Sigmoid", {relu_output_arg}, {sigmoid_output_arg});
+    AddTransposeNode(builder, sigmoid_output_arg, kNhwcToNchw, builder.MakeOutput());
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Transpose"], 0);
+    EXPECT_EQ(op_to_count["Relu"], 1);
+    EXPECT_EQ(op_to_count["Sigmoid"], 1);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level1);
+}
+
+TEST(TransposeSinkingTests, MergeToSingleTranspose) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({1, 3, 5, 7}, -1.f, 1.f);
+    auto* relu_output_arg = builder.MakeIntermediate();
+
+    auto* transpose_output_arg = AddTransposeNode(builder, input_arg, kNchwToNhwc);
+    builder.AddNode("Relu", {transpose_output_arg}, {relu_output_arg});
+    AddTransposeNode(builder, relu_output_arg, {0, 2, 3, 1}, builder.MakeOutput());
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Transpose"], 1);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level1);
+}
+
+TEST(TransposeSinkingTests, BroadcastWithConstant) {
+  auto test_case = [&](const std::vector<int64_t>& constant_shape) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>({1, 3, 5, 7}, -1.f, 1.f);
+      auto* constant_arg = builder.MakeInitializer<float>(constant_shape, -1.f, 1.f);
+      auto* add_output_arg = builder.MakeIntermediate();
+
+      auto* transpose_output_arg = AddTransposeNode(builder, input_arg, kNchwToNhwc);
+      builder.AddNode("Add", {transpose_output_arg, constant_arg}, {add_output_arg});
+      AddTransposeNode(builder, add_output_arg, kNhwcToNchw, builder.MakeOutput());
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      // the Transpose of the constant is folded
+      EXPECT_EQ(op_to_count["Transpose"], 0);
+      EXPECT_EQ(op_to_count["Add"], 1);
+    };
+
+    TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level1);
+  };
+
+  test_case({});
+  test_case({3});
+  test_case({7, 3});
+  test_case({1, 5, 7, 3});
+}
+
+TEST(TransposeSinkingTests, BinaryOpWithTransposedInputs) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input1_arg = builder.MakeInput<float>({1, 3, 5, 7}, -1.f, 1.f);
+    auto* input2_arg = builder.MakeInput<float>({1, 3, 5, 7}, -1.f, 1.f);
+    auto* mul_output_arg = builder.MakeIntermediate();
+
+    auto* transpose1_output_arg = AddTransposeNode(builder, input1_arg, kNchwToNhwc);
+    auto* transpose2_output_arg = AddTransposeNode(builder, input2_arg, kNchwToNhwc);
+    builder.AddNode("Mul", {transpose1_output_arg, transpose2_output_arg}, {mul_output_arg});
+    AddTransposeNode(builder, mul_output_arg, kNhwcToNchw, builder.MakeOutput());
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Transpose"], 0);
+    EXPECT_EQ(op_to_count["Mul"], 1);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level1);
+}
+
+TEST(TransposeSinkingTests, BinaryOpWithGraphInputIsNotChanged) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input1_arg = builder.MakeInput<float>({1, 3, 5, 7}, -1.f, 1.f);
+    auto* input2_arg = builder.MakeInput<float>({1, 5, 7, 3}, -1.f, 1.f);
+    auto* add_output_arg = builder.MakeIntermediate();
+
+    auto* transpose_output_arg = AddTransposeNode(builder, input1_arg, kNchwToNhwc);
+    builder.AddNode("Add", {transpose_output_arg, input2_arg}, {add_output_arg});
+    AddTransposeNode(builder, add_output_arg, kNhwcToNchw, builder.MakeOutput());
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Transpose"], 2);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level1);
+}
+
+TEST(TransposeSinkingTests, Concat) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input1_arg = builder.MakeInput<float>({1, 3, 5, 7}, -1.f, 1.f);
+    auto* input2_arg = builder.MakeInput<float>({1, 2, 5, 7}, -1.f, 1.f);
+    auto* constant_arg = builder.MakeInitializer<float>({1, 5, 7, 4}, -1.f, 1.f);
+    auto* concat_output_arg = builder.MakeIntermediate();
+
+    auto* transpose1_output_arg = AddTransposeNode(builder, input1_arg, kNchwToNhwc);
+    auto* transpose2_output_arg = AddTransposeNode(builder, input2_arg, kNchwToNhwc);
+    builder.AddNode("Concat", {transpose1_output_arg, constant_arg, transpose2_output_arg}, {concat_output_arg})
+        .AddAttribute("axis", static_cast<int64_t>(-1));
+    AddTransposeNode(builder, concat_output_arg, kNhwcToNchw, builder.MakeOutput());
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Transpose"], 0);
+    EXPECT_EQ(op_to_count["Concat"], 1);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level1);
+}
+
+TEST(TransposeSinkingTests, Reduce) {
+  auto test_case = [&](const std::vector<int64_t>& axes, int64_t keepdims, int expected_transposes) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>({2, 3, 5, 7}, -1.f, 1.f);
+      auto* reduce_output_arg = builder.MakeIntermediate();
+      auto* relu_output_arg = builder.MakeOutput();
+
+      auto* transpose_output_arg = AddTransposeNode(builder, input_arg, kNchwToNhwc);
+      Node& reduce_node = builder.AddNode("ReduceMean", {transpose_output_arg}, {reduce_output_arg});
+      reduce_node.AddAttribute("axes", axes);
+      reduce_node.AddAttribute("keepdims", keepdims);
+      builder.AddNode("Relu", {reduce_output_arg}, {relu_output_arg});
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["Transpose"], expected_transposes);
+    };
+
+    TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level1);
+  };
+
+  // the Transpose ends up after the Relu, unless the dims left after the reduction are in the same order
+  test_case({1, 2}, 1, 1);
+  test_case({1, 2}, 0, 0);
+  test_case({-1}, 0, 0);
+  test_case({1}, 0, 1);
+}
+
+TEST(TransposeSinkingTests, PadAndSlice) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({1, 3, 5, 7}, -1.f, 1.f);
+    auto* pads_arg = builder.Make1DInitializer<int64_t>({0, 1, 2, 0, 0, 3, 4, 0});
+    auto* starts_arg = builder.Make1DInitializer<int64_t>({1, 2});
+    auto* ends_arg = builder.Make1DInitializer<int64_t>({5, -1});
+    auto* axes_arg = builder.Make1DInitializer<int64_t>({1, 2});
+    auto* pad_output_arg = builder.MakeIntermediate();
+    auto* slice_output_arg = builder.MakeIntermediate();
+
+    auto* transpose_output_arg = AddTransposeNode(builder, input_arg, kNchwToNhwc);
+    builder.AddNode("Pad", {transpose_output_arg, pads_arg}, {pad_output_arg});
+    builder.AddNode("Slice", {pad_output_arg, starts_arg, ends_arg, axes_arg}, {slice_output_arg});
+    AddTransposeNode(builder, slice_output_arg, kNhwcToNchw, builder.MakeOutput());
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["Transpose"], 0);
+    EXPECT_EQ(op_to_count["Pad"], 1);
+    EXPECT_EQ(op_to_count["Slice"], 1);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level1);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -27,12 +27,18 @@ namespace perftest {
   printf(
       "perf_test [options...] model_path [result_file]\n"
       "Options:\n"
-      "\t-m [test_mode]: Specifies the test mode. Value could be 'duration' or 'times'.\n"
+      "\t-m [test_mode]: Specifies the test mode. Value could be 'duration', 'times' or 'load'.\n"
       "\t\tProvide 'duration' to run the test for a fix duration, and 'times' to repeated for a certain times. \n"
+      "\t\tProvide 'load' to drive one session with the clients given by -c for the duration given by -t, and report\n"
+      "\t\tthe latency distribution and the load over time.\n"
       "\t-M: Disable memory pattern.\n"
       "\t-A: Disable memory arena\n"
       "\t-I: Generate tensor input binding (Free dimensions are treated as 1.)\n"
       "\t-c [parallel runs]: Specifies the (max) number of runs to invoke simultaneously. Default:1.\n"
+      "\t-Q [queries_per_second]: [load mode] Issue requests at this rate whether or not the previous ones completed (open loop).\n"
+      "\t\tThe requests are served by the -c clients, and their latency includes the time they wait for a free client.\n"
+      "\t\tDefault:0, each client issues its next request once the previous one completed (closed loop).\n"
+      "\t-T [seconds]: [load mode] Specifies the interval of the reports of the load over time. Default:1.\n"
       "\t-e [cpu|cuda|dnnl|tensorrt|openvino|nuphar|dml|acl]: Specifies the provider 'cpu','cuda','dnnl','tensorrt', "
       "'openvino', 'nuphar', 'dml', 'acl', 'nnapi' or 'coreml'. "
       "Default:'cpu'.\n"
@@ -107,7 +113,7 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
 
 /*static*/ bool CommandLineParser::ParseArguments(PerformanceTestConfig& test_config, int argc, ORTCHAR_T* argv[]) {
   int ch;
-  while ((ch = getopt(argc, argv, ORT_TSTR("b:m:e:r:t:p:x:y:c:d:o:u:i:f:F:AMPIvhsqz"))) != -1) {
+  while ((ch = getopt(argc, argv, ORT_TSTR("b:m:e:r:t:p:x:y:c:d:o:u:i:f:F:Q:T:AMPIvhsqz"))) != -1) {
     switch (ch) {
       case 'f': {
         std::basic_string<ORTCHAR_T> dim_name;
@@ -132,6 +138,8 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
           test_config.run_config.test_mode = TestMode::kFixDurationMode;
         } else if (!CompareCString(optarg, ORT_TSTR("times"))) {
           test_config.run_config.test_mode = TestMode::KFixRepeatedTimesMode;
+        } else if (!CompareCString(optarg, ORT_TSTR("load"))) {
+          test_config.run_config.test_mode = TestMode::kLoadMode;
         } else {
           return false;
         }
@@ -188,7 +196,10 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
         if (test_config.run_config.repeated_times <= 0) {
           return false;
         }
-        test_config.run_config.test_mode = TestMode::kFixDurationMode;
+        // the load mode runs for a fixed duration too
+        if (test_config.run_config.test_mode != TestMode::kLoadMode) {
+          test_config.run_config.test_mode = TestMode::kFixDurationMode;
+        }
         break;
       case 's':
         test_config.run_config.f_dump_statistics = true;
@@ -218,6 +229,20 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
           return false;
         }
         break;
+      case 'Q':
+        test_config.run_config.target_qps = static_cast<size_t>(OrtStrtol<PATH_CHAR_TYPE>(optarg, nullptr));
+        if (test_config.run_config.target_qps <= 0) {
+          return false;
+        }
+        test_config.run_config.test_mode = TestMode::kLoadMode;
+        break;
+      case 'T':
+        test_config.run_config.load_report_interval_in_seconds =
+            static_cast<size_t>(OrtStrtol<PATH_CHAR_TYPE>(optarg, nullptr));
+        if (test_config.run_config.load_report_interval_in_seconds <= 0) {
+          return false;
+        }
+        break;
       case 'o': {
         int tmp = static_cast<int>(OrtStrtol<PATH_CHAR_TYPE>(optarg, nullptr));
         switch (tmp) {
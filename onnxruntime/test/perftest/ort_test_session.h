@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <core/platform/ort_mutex.h>
 #include <core/session/onnxruntime_cxx_api.h>
 #include <random>
 #include "test_configuration.h"
@@ -40,6 +41,7 @@ class OnnxRuntimeTestSession : public TestSession {
   Ort::Session session_{nullptr};
   std::mt19937 rand_engine_;
   std::uniform_int_distribution<int> dist_;
+  OrtMutex rand_mutex_;
   std::vector<std::vector<Ort::Value>> test_inputs_;
   std::vector<std::string> output_names_;
   // The same size with output_names_.
@@ -7,7 +7,9 @@
 #endif
 
 #include "performance_runner.h"
+#include <iomanip>
 #include <iostream>
+#include <thread>
 
 #include "TestCase.h"
 #include "TFModelInfo.h"
@@ -120,6 +122,9 @@ Status PerformanceRunner::Run() {
     case TestMode::KFixRepeatedTimesMode:
       ORT_RETURN_IF_ERROR(RepeatedTimesTest());
       break;
+    case TestMode::kLoadMode:
+      ORT_RETURN_IF_ERROR(RunLoadTest());
+      break;
     default:
       return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "unknown test mode.");
   }
@@ -231,6 +236,156 @@ Status PerformanceRunner::ForkJoinRepeat() {
   return Status::OK();
 }
 
+// Gets the latency at the given fraction of the sorted latencies
+static double GetPercentile(const std::vector<double>& sorted_latencies, double fraction) {
+  size_t index = static_cast<size_t>(sorted_latencies.size() * fraction);
+  return sorted_latencies[std::min(index, sorted_latencies.size() - 1)];
+}
+
+static void PrintLatencyHistogram(const std::vector<double>& sorted_latencies) {
+  // buckets whose upper bounds double from 0.1 ms
+  std::cout << "Latency histogram:\n";
+  double upper_bound = 0.0001;
+  auto bucket_begin = sorted_latencies.cbegin();
+  while (bucket_begin != sorted_latencies.cend()) {
+    auto bucket_end = std::upper_bound(bucket_begin, sorted_latencies.cend(), upper_bound);
+    const auto count = static_cast<size_t>(bucket_end - bucket_begin);
+    if (count > 0) {
+      std::cout << "  <= " << std::setw(10) << upper_bound * 1000 << " ms: " << std::setw(10) << count << " ("
+                << 100.0 * count / sorted_latencies.size() << " %)\n";
+    }
+
+    bucket_begin = bucket_end;
+    upper_bound *= 2;
+  }
+}
+
+Status PerformanceRunner::RunLoadTest() {
+  using Clock = std::chrono::high_resolution_clock;
+  const auto& run_config = performance_test_config_.run_config;
+  const size_t num_clients = run_config.concurrent_session_runs;
+  const bool open_loop = run_config.target_qps > 0;
+
+  const auto start = Clock::now();
+  const auto end = start + std::chrono::seconds(run_config.duration_in_seconds);
+  const std::chrono::duration<double> request_interval(open_loop ? 1.0 / run_config.target_qps : 0.0);
+
+  std::atomic<size_t> next_request{0};
+  std::atomic<bool> failed{false};
+  std::vector<double> client_cpu_times(num_clients);
+  std::vector<double> client_wall_times(num_clients);
+
+  auto run_client = [&](size_t client) {
+    const double cpu_time_start = utils::GetCurrentThreadCPUTimeInSeconds();
+    const auto wall_time_start = Clock::now();
+    while (!failed) {
+      // in the open loop a request is due at a fixed time, and its latency includes the time it waited for a client
+      auto request_start = Clock::now();
+      if (open_loop) {
+        request_start = start + std::chrono::duration_cast<Clock::duration>(request_interval * next_request++);
+        if (request_start >= end) {
+          break;
+        }
+
+        std::this_thread::sleep_until(request_start);
+      } else if (request_start >= end) {
+        break;
+      }
+
+      ORT_TRY {
+        session_->Run();
+      }
+      ORT_CATCH(const std::exception& ex) {
+        ORT_HANDLE_EXCEPTION([&]() {
+          std::cerr << "PerformanceRunner::RunLoadTest caught exception: " << ex.what() << std::endl;
+          failed = true;
+        });
+      }
+
+      if (failed) {
+        break;
+      }
+
+      const std::chrono::duration<double> latency = Clock::now() - request_start;
+      std::lock_guard<OrtMutex> guard(results_mutex_);
+      performance_result_.time_costs.emplace_back(latency.count());
+      performance_result_.total_time_cost += latency.count();
+    }
+
+    client_cpu_times[client] = utils::GetCurrentThreadCPUTimeInSeconds() - cpu_time_start;
+    client_wall_times[client] = std::chrono::duration<double>(Clock::now() - wall_time_start).count();
+  };
+
+  std::vector<std::thread> clients;
+  for (size_t client = 0; client < num_clients; ++client) {
+    clients.emplace_back(run_client, client);
+  }
+
+  // report the load of each interval while the clients run
+  std::cout << (open_loop ? "Open loop at " + std::to_string(run_config.target_qps) + " requests/s"
+                          : std::string("Closed loop"))
+            << " with " << num_clients << " clients for " << run_config.duration_in_seconds << " s\n"
+            << "Time (s), Requests/s, P50 latency (ms), P99 latency (ms), Avg CPU usage (%), Working set (bytes)"
+            << std::endl;
+
+  std::unique_ptr<utils::ICPUUsage> p_ICPUUsage = utils::CreateICPUUsage();
+  const std::chrono::seconds report_interval(run_config.load_report_interval_in_seconds);
+  size_t reported_requests = 0;
+  for (auto report_time = start + report_interval; report_time <= end && !failed; report_time += report_interval) {
+    std::this_thread::sleep_until(report_time);
+
+    std::vector<double> latencies;
+    {
+      std::lock_guard<OrtMutex> guard(results_mutex_);
+      latencies.assign(performance_result_.time_costs.cbegin() + reported_requests,
+                       performance_result_.time_costs.cend());
+      reported_requests = performance_result_.time_costs.size();
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    std::cout << std::chrono::duration<double>(report_time - start).count() << ", "
+              << latencies.size() / static_cast<double>(run_config.load_report_interval_in_seconds) << ", "
+              << (latencies.empty() ? 0.0 : GetPercentile(latencies, 0.5) * 1000) << ", "
+              << (latencies.empty() ? 0.0 : GetPercentile(latencies, 0.99) * 1000) << ", "
+              << p_ICPUUsage->GetUsage() << ", "
+              << utils::GetCurrentWorkingSetSize() << std::endl;
+    p_ICPUUsage->Reset();
+  }
+
+  for (auto& client : clients) {
+    client.join();
+  }
+
+  if (failed) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "PerformanceRunner::RunLoadTest failed to run the session.");
+  }
+
+  std::vector<double> sorted_latencies = performance_result_.time_costs;
+  if (sorted_latencies.empty()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "PerformanceRunner::RunLoadTest didn't complete any request.");
+  }
+
+  std::sort(sorted_latencies.begin(), sorted_latencies.end());
+  const std::chrono::duration<double> run_time = Clock::now() - start;
+  std::cout << "Achieved requests/s: " << sorted_latencies.size() / run_time.count() << "\n"
+            << "P50 Latency: " << GetPercentile(sorted_latencies, 0.5) << " s\n"
+            << "P90 Latency: " << GetPercentile(sorted_latencies, 0.9) << " s\n"
+            << "P99 Latency: " << GetPercentile(sorted_latencies, 0.99) << " s\n"
+            << "P999 Latency: " << GetPercentile(sorted_latencies, 0.999) << " s\n";
+  PrintLatencyHistogram(sorted_latencies);
+
+  // this doesn't include the work of the intra-op threads of the session, which is part of the CPU usage above
+  std::cout << "CPU usage of the client threads:\n";
+  for (size_t client = 0; client < num_clients; ++client) {
+    std::cout << "  client " << client << ": "
+              << (client_wall_times[client] > 0 ? 100.0 * client_cpu_times[client] / client_wall_times[client] : 0.0)
+              << " %\n";
+  }
+
+  std::cout << std::flush;
+  return Status::OK();
+}
+
 static std::unique_ptr<TestModelInfo> CreateModelInfo(const PerformanceTestConfig& performance_test_config_) {
   if (CompareCString(performance_test_config_.backend.c_str(), ORT_TSTR("ort")) == 0) {
     const auto& file_path = performance_test_config_.model_info.model_file_path;
@@ -88,6 +88,9 @@ class PerformanceRunner {
   Status RepeatedTimesTest();
   Status ForkJoinRepeat();
   Status RunParallelDuration();
+  // Runs the session from concurrent clients for a fixed duration, in a closed loop or at a target rate,
+  // and reports the load over time and the latency distribution.
+  Status RunLoadTest();
 
   inline Status RunFixDuration() {
     while (performance_result_.total_time_cost < performance_test_config_.run_config.duration_in_seconds) {
@@ -4,9 +4,12 @@
 #include "test/perftest/utils.h"
 
 #include <cstddef>
+#include <fstream>
 
 #include <sys/times.h>
 #include <sys/resource.h>
+#include <time.h>
+#include <unistd.h>
 
 #include "core/platform/env.h"
 
@@ -20,6 +23,29 @@ std::size_t GetPeakWorkingSetSize() {
   return static_cast<size_t>(rusage.ru_maxrss * 1024L);
 }
 
+std::size_t GetCurrentWorkingSetSize() {
+#if defined(__linux__)
+  // the second field is the number of resident pages
+  std::ifstream statm("/proc/self/statm");
+  size_t total_pages = 0;
+  size_t resident_pages = 0;
+  if (statm >> total_pages >> resident_pages) {
+    return resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  }
+#endif
+
+  return GetPeakWorkingSetSize();
+}
+
+double GetCurrentThreadCPUTimeInSeconds() {
+  struct timespec time_spec;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time_spec) != 0) {
+    return 0;
+  }
+
+  return static_cast<double>(time_spec.tv_sec) + static_cast<double>(time_spec.tv_nsec) / 1e9;
+}
+
 class CPUUsage : public ICPUUsage {
  public:
   CPUUsage() {
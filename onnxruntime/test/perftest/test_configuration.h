@@ -15,7 +15,8 @@ namespace perftest {
 
 enum class TestMode : std::uint8_t {
   kFixDurationMode = 0,
-  KFixRepeatedTimesMode
+  KFixRepeatedTimesMode,
+  kLoadMode
 };
 
 enum class Platform : std::uint8_t {
@@ -41,6 +42,9 @@ struct RunConfig {
   size_t repeated_times{1000};
   size_t duration_in_seconds{600};
   size_t concurrent_session_runs{1};
+  // requests per second issued in load mode. 0 means each client issues its next request once the previous completed.
+  size_t target_qps{0};
+  size_t load_report_interval_in_seconds{1};
   bool f_dump_statistics{false};
   bool f_verbose{false};
   bool enable_memory_pattern{true};
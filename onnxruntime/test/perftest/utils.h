@@ -11,6 +11,11 @@ namespace utils {
 
 size_t GetPeakWorkingSetSize();
 
+size_t GetCurrentWorkingSetSize();
+
+// CPU time (user and kernel) used by the calling thread so far
+double GetCurrentThreadCPUTimeInSeconds();
+
 class ICPUUsage {
  public:
   virtual ~ICPUUsage() = default;
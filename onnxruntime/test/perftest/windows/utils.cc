@@ -22,6 +22,32 @@ size_t GetPeakWorkingSetSize() {
   return 0;
 }
 
+size_t GetCurrentWorkingSetSize() {
+  PROCESS_MEMORY_COUNTERS pmc;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+    return pmc.WorkingSetSize;
+  }
+
+  return 0;
+}
+
+static std::uint64_t FILETIMEToUInt64(const FILETIME& ft) {
+  LARGE_INTEGER value;
+  value.LowPart = ft.dwLowDateTime;
+  value.HighPart = ft.dwHighDateTime;
+  return value.QuadPart;
+}
+
+double GetCurrentThreadCPUTimeInSeconds() {
+  FILETIME creation_ft, exit_ft, kernel_ft, user_ft;
+  if (!GetThreadTimes(GetCurrentThread(), &creation_ft, &exit_ft, &kernel_ft, &user_ft)) {
+    return 0;
+  }
+
+  // FILETIME counts 100 nanosecond intervals
+  return static_cast<double>(FILETIMEToUInt64(kernel_ft) + FILETIMEToUInt64(user_ft)) / 1e7;
+}
+
 static std::uint64_t SubtractFILETIME(const FILETIME& ft_a, const FILETIME& ft_b) {
   LARGE_INTEGER a, b;
   a.LowPart = ft_a.dwLowDateTime;
@@ -3,6 +3,7 @@
 
 #include "core/platform/env.h"
 
+#include <algorithm>
 #include <fstream>
 
 #include "gtest/gtest.h"
@@ -33,5 +34,31 @@ TEST(PlatformEnvTest, DirectoryCreationAndDeletion) {
   ASSERT_FALSE(env.FolderExists(root_dir));
 }
 
+TEST(PlatformEnvTest, AllocatePages) {
+  const auto& env = Env::Default();
+
+  for (bool use_huge_pages : {false, true}) {
+    for (int numa_node : {-1, 0}) {
+      // huge pages and NUMA binding fall back to regular memory where they aren't supported.
+      const size_t requested_size = 3 * 1024 * 1024 + 1;
+      size_t size = requested_size;
+      char* p = static_cast<char*>(env.AllocatePages(size, use_huge_pages, numa_node));
+      ASSERT_NE(p, nullptr);
+      EXPECT_GE(size, requested_size);
+      EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % 4096, 0u);
+
+      // the memory is zero-initialized and writable up to the mapped size.
+      EXPECT_EQ(p[0], 0);
+      EXPECT_EQ(p[size - 1], 0);
+      std::fill_n(p, size, static_cast<char>(1));
+
+      env.FreePages(p, size);
+    }
+  }
+
+  size_t size = 0;
+  EXPECT_EQ(env.AllocatePages(size, false, -1), nullptr);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -44,8 +44,6 @@ TEST(GemmOpTest, GemmNoTrans_double) {
   TestGemmNoTrans<double>();
 }
 
-// Only CUDA kernel has float 16 support
-#if defined(USE_CUDA) || defined(USE_ROCM)
 TEST(GemmOpTest, GemmNoTrans_f16) {
 #ifdef USE_CUDA
   int min_cuda_architecture = 530;
@@ -83,7 +81,30 @@ TEST(GemmOpTest, GemmNoTrans_f16) {
   test.AddOutput<MLFloat16>("Y", {2, 3}, f_Y);
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});  //TensorRT: fp16 is not supported
 }
-#endif
+
+TEST(GemmOpTest, GemmTransB_f16_Initializer) {
+  OpTester test("Gemm", 13);
+
+  test.AddAttribute("transA", (int64_t)0);
+  test.AddAttribute("transB", (int64_t)1);
+  test.AddAttribute("alpha", 0.5f);
+  test.AddAttribute("beta", 2.0f);
+
+  // B is an initializer so the CPU kernel pre-packs it in half precision
+  test.AddInput<MLFloat16>("A", {2, 4}, FloatsToMLFloat16s({1.0f, 2.0f, 3.0f, 4.0f,
+                                                            -1.0f, -2.0f, -3.0f, -4.0f}));
+  test.AddInput<MLFloat16>("B", {3, 4}, FloatsToMLFloat16s({1.0f, 1.0f, 1.0f, 1.0f,
+                                                            2.0f, 2.0f, 2.0f, 2.0f,
+                                                            -1.0f, 0.0f, 1.0f, 2.0f}),
+                           true);
+  test.AddInput<MLFloat16>("C", {3}, FloatsToMLFloat16s({1.0f, 2.0f, 3.0f}));
+  test.AddOutput<MLFloat16>("Y", {2, 3}, FloatsToMLFloat16s({7.0f, 14.0f, 11.0f,
+                                                             -3.0f, -6.0f, 1.0f}));
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
 
 template <typename T>
 void TestGemmBroadcast() {
@@ -162,6 +162,37 @@ TEST(MathOpTest, MatMulUint64Type) {
   RunMatMulTest<uint64_t>(9);
 }
 
+// The CPU kernel keeps B in half precision and widens it inside the MLAS kernel
+void RunMatMulFloat16Test(int32_t opset_version, bool is_b_constant) {
+  std::vector<float> common_input_vals{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+  for (auto t : GenerateTestCases<float>()) {
+    OpTester test("MatMul", opset_version);
+
+    int64_t size0 = TensorShape::ReinterpretBaseType(t.input0_dims).SizeHelper(0, t.input0_dims.size());
+    std::vector<float> input0_vals(common_input_vals.cbegin(), common_input_vals.cbegin() + size0);
+    test.AddInput<MLFloat16>("A", t.input0_dims, FloatsToMLFloat16s(input0_vals));
+
+    int64_t size1 = TensorShape::ReinterpretBaseType(t.input1_dims).SizeHelper(0, t.input1_dims.size());
+    std::vector<float> input1_vals(common_input_vals.cbegin(), common_input_vals.cbegin() + size1);
+    test.AddInput<MLFloat16>("B", t.input1_dims, FloatsToMLFloat16s(input1_vals), is_b_constant);
+
+    test.AddOutput<MLFloat16>("Y", t.expected_dims, FloatsToMLFloat16s(t.expected_vals));
+
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+  }
+}
+
+TEST(MathOpTest, MatMulFloat16Type) {
+  RunMatMulFloat16Test(9, false);
+  RunMatMulFloat16Test(13, false);
+}
+
+TEST(MathOpTest, MatMulFloat16TypeInitializer) {
+  RunMatMulFloat16Test(13, true);
+}
+
 #ifndef ENABLE_TRAINING  // Prepacking is enabled only on non-training builds
 TEST(MathOpTest, MatMulSharedPrepackedWeights) {
   OpTester test("MatMul");
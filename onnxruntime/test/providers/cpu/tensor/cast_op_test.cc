@@ -130,6 +130,46 @@ TEST(CastOpTest, NonStringTypes) {
       CastNonStringTester{});
 }
 
+// casts tensors large enough to be split over the thread pool, with a size that is not a multiple of any vector width
+struct CastLargeTensorTester {
+  template <typename SrcType, typename DstType>
+  void operator()(const std::pair<SrcType, DstType>&) {
+    SCOPED_TRACE(
+        onnxruntime::MakeString(
+            "Cast from type ", utils::ToTensorProtoElementType<SrcType>(),
+            " to type ", utils::ToTensorProtoElementType<DstType>()));
+
+    const TensorShape shape{3, 1031, 67};
+    const size_t size = gsl::narrow<size_t>(shape.Size());
+
+    // values with at most 8 significant bits are exactly representable by all of the tested types
+    std::vector<float> input_float_values(size);
+    for (size_t i = 0; i < size; ++i) {
+      input_float_values[i] = (static_cast<float>(i % 511) - 255.0f) / 4.0f;
+    }
+
+    auto input_buffer = std::make_unique<SrcType[]>(size);
+    auto input_span = gsl::make_span<SrcType>(input_buffer.get(), size);
+    CastSpan<float, SrcType>(gsl::make_span(input_float_values), input_span);
+
+    auto output_buffer = std::make_unique<DstType[]>(size);
+    auto output_span = gsl::make_span<DstType>(output_buffer.get(), size);
+    CastSpan<SrcType, DstType>(input_span, output_span);
+
+    TestCastOp<SrcType, DstType>(input_span, output_span, shape.GetDims());
+  }
+};
+
+TEST(CastOpTest, LargeTensors) {
+  boost::mp11::mp_for_each<
+      boost::mp11::mp_list<
+          std::pair<float, MLFloat16>, std::pair<MLFloat16, float>,
+          std::pair<float, BFloat16>, std::pair<BFloat16, float>,
+          std::pair<int32_t, float>, std::pair<float, int32_t>,
+          std::pair<MLFloat16, int64_t>, std::pair<double, float>>>(
+      CastLargeTensorTester{});
+}
+
 TEST(CastOpTest, FromString) {
   const std::vector<int64_t> shape{2, 2, 2};
   const std::vector<std::string> string_data = {"-inf", "+INF", "0.9767611", "0.28280696",
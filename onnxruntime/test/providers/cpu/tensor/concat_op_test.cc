@@ -424,5 +424,36 @@ TEST(ConcatOpTest, Concat4D_2) {
   test.Run();
 }
 
+// many small inputs, which are copied in parallel with each other
+TEST(ConcatOpTest, Concat3D_ManySmallInputs) {
+  OpTester test("Concat");
+  test.AddAttribute("axis", int64_t{1});
+
+  constexpr int64_t input_count = 40, outer_size = 3, inner_size = 16;
+  std::vector<std::vector<float>> inputs;
+  int64_t output_axis_size = 0;
+  for (int64_t input_index = 0; input_index < input_count; ++input_index) {
+    const int64_t axis_size = input_index % 4;  // includes empty inputs
+    std::vector<float> input(static_cast<size_t>(outer_size * axis_size * inner_size));
+    for (size_t i = 0; i < input.size(); ++i) {
+      input[i] = static_cast<float>(input_index * 1000 + static_cast<int64_t>(i));
+    }
+    test.AddInput<float>(("input" + std::to_string(input_index)).c_str(), {outer_size, axis_size, inner_size}, input);
+    inputs.push_back(std::move(input));
+    output_axis_size += axis_size;
+  }
+
+  std::vector<float> output;
+  for (int64_t outer = 0; outer < outer_size; ++outer) {
+    for (const auto& input : inputs) {
+      const size_t row_size = input.size() / outer_size;
+      output.insert(output.end(), input.begin() + outer * row_size, input.begin() + (outer + 1) * row_size);
+    }
+  }
+
+  test.AddOutput<float>("concat_result", {outer_size, output_axis_size, inner_size}, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
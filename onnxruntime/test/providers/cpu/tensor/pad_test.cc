@@ -779,5 +779,66 @@ TEST(PadOpTest, BoolType) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
 }
 
+// reference implementation of Pad that maps each output element back to the input
+static std::vector<float> ReferencePad(const std::vector<int64_t>& input_dims, const std::vector<float>& input,
+                                       const std::vector<int64_t>& pads, float value, const std::string& mode,
+                                       std::vector<int64_t>& output_dims) {
+  const size_t rank = input_dims.size();
+  output_dims.resize(rank);
+  for (size_t i = 0; i < rank; ++i) {
+    output_dims[i] = input_dims[i] + pads[i] + pads[i + rank];
+  }
+
+  const TensorShape output_shape(output_dims);
+  std::vector<float> output(static_cast<size_t>(output_shape.Size()));
+  for (int64_t output_index = 0; output_index < output_shape.Size(); ++output_index) {
+    int64_t input_index = 0;
+    int64_t remaining = output_index;
+    int64_t input_pitch = 1;
+    bool is_constant = false;
+    for (size_t axis = rank; axis-- > 0;) {
+      int64_t index = remaining % output_dims[axis] - pads[axis];
+      remaining /= output_dims[axis];
+      if (index < 0 || index >= input_dims[axis]) {
+        if (mode == "constant") {
+          is_constant = true;
+        } else if (mode == "edge") {
+          index = index < 0 ? 0 : input_dims[axis] - 1;
+        } else {
+          index = index < 0 ? -index : 2 * (input_dims[axis] - 1) - index;
+        }
+      }
+      input_index += index * input_pitch;
+      input_pitch *= input_dims[axis];
+    }
+    output[static_cast<size_t>(output_index)] = is_constant ? value : input[static_cast<size_t>(input_index)];
+  }
+
+  return output;
+}
+
+// inputs large enough for the rows of the output to be split across the thread pool
+TEST(PadOpTest, LargeInputs) {
+  const std::vector<int64_t> input_dims{2, 3, 64, 61};
+  std::vector<float> input(static_cast<size_t>(TensorShape(input_dims).Size()));
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<float>(i);
+  }
+
+  const std::vector<std::vector<int64_t>> all_pads{
+      {0, 0, 3, 2, 0, 0, 2, 4},  // inner and outer axes
+      {1, 2, 0, 0, 1, 0, 0, 0},  // outer axes only
+      {0, 0, 0, 5, 0, 0, 0, 3},  // innermost axis only
+  };
+
+  for (const std::string mode : {"constant", "edge", "reflect"}) {
+    for (const auto& pads : all_pads) {
+      std::vector<int64_t> output_dims;
+      const std::vector<float> output = ReferencePad(input_dims, input, pads, -1.0f, mode, output_dims);
+      RunOnnxOpsetTypedTest<float, 13>(input_dims, input, pads, -1.0f, output_dims, output, mode);
+    }
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -604,5 +604,28 @@ TEST(SliceTest, Slice5D_SubsetOfAxes_Flatten2Dims_OffsetInput) {
                       {-5.f, -6.f, -7.f, -8.f},
                       true);
 }
+
+// input large enough for the copy to be split across the thread pool, with both positive and negative steps
+TEST(SliceTest, Slice3D_LargeInput_Steps) {
+  const std::vector<int64_t> input_dims{8, 130, 257};
+  std::vector<float> input(8 * 130 * 257);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<float>(i);
+  }
+
+  // slice [1:7:2, 120:3:-1, 5:250]
+  const std::vector<int64_t> output_dims{3, 117, 245};
+  std::vector<float> output;
+  output.reserve(3 * 117 * 245);
+  for (int64_t i = 1; i < 7; i += 2) {
+    for (int64_t j = 120; j > 3; --j) {
+      for (int64_t k = 5; k < 250; ++k) {
+        output.push_back(input[static_cast<size_t>((i * 130 + j) * 257 + k)]);
+      }
+    }
+  }
+
+  RunSliceTest<float>(input_dims, input, {1, 120, 5}, {7, 3, 250}, {0, 1, 2}, {2, -1, 1}, output_dims, output, true);
+}
 }  // namespace test
 }  // namespace onnxruntime
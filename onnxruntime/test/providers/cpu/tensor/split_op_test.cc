@@ -640,5 +640,32 @@ TEST(SplitOperatorTest, MissingOptionalInputAdded) {
   RunTest<float>(axis, {}, input, outputs, false, false, true, false, {}, false);
 }
 
+// input large enough for the copy of each output to be split across the thread pool
+TEST(SplitOperatorTest, LargeInputAxis1UnequalSplit) {
+  const int64_t axis = 1;
+  const std::vector<int64_t> split_sizes{100, 17, 183};
+  const int64_t outer_size = 6, axis_size = 300, inner_size = 100;
+
+  std::vector<float> input_data(static_cast<size_t>(outer_size * axis_size * inner_size));
+  for (size_t i = 0; i < input_data.size(); ++i) {
+    input_data[i] = static_cast<float>(i);
+  }
+
+  std::vector<ShapeAndFloatData> outputs;
+  int64_t axis_offset = 0;
+  for (int64_t split_size : split_sizes) {
+    std::vector<float> output_data;
+    for (int64_t outer = 0; outer < outer_size; ++outer) {
+      const auto* begin = input_data.data() + (outer * axis_size + axis_offset) * inner_size;
+      output_data.insert(output_data.end(), begin, begin + split_size * inner_size);
+    }
+    outputs.push_back({{outer_size, split_size, inner_size}, output_data});
+    axis_offset += split_size;
+  }
+
+  ShapeAndFloatData input = {{outer_size, axis_size, inner_size}, input_data};
+  RunTest<float>(axis, split_sizes, input, outputs);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
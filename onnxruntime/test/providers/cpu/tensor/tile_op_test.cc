@@ -151,5 +151,48 @@ TEST(TensorOpTest, TileUint64Type) {
 TEST(TensorOpTest, TileBoolType) {
   RunTestWrapper<bool>();
 }
+
+// inputs large enough for the copies to be split across the thread pool
+TEST(TensorOpTest, TileLargeInputs) {
+  auto run_test = [](const std::vector<int64_t>& input_dims, const std::vector<int64_t>& repeats) {
+    const TensorShape input_shape(input_dims);
+    std::vector<int32_t> input(static_cast<size_t>(input_shape.Size()));
+    for (size_t i = 0; i < input.size(); ++i) {
+      input[i] = static_cast<int32_t>(i);
+    }
+
+    std::vector<int64_t> output_dims(input_dims);
+    for (size_t axis = 0; axis < output_dims.size(); ++axis) {
+      output_dims[axis] *= repeats[axis];
+    }
+
+    const TensorShape output_shape(output_dims);
+    std::vector<int32_t> output(static_cast<size_t>(output_shape.Size()));
+    for (int64_t output_index = 0; output_index < output_shape.Size(); ++output_index) {
+      int64_t input_index = 0;
+      int64_t remaining = output_index;
+      int64_t input_pitch = 1;
+      for (size_t axis = output_dims.size(); axis-- > 0;) {
+        input_index += (remaining % output_dims[axis] % input_dims[axis]) * input_pitch;
+        remaining /= output_dims[axis];
+        input_pitch *= input_dims[axis];
+      }
+      output[static_cast<size_t>(output_index)] = input[static_cast<size_t>(input_index)];
+    }
+
+    OpTester test("Tile");
+    test.AddInput<int32_t>("input", input_dims, input);
+    test.AddInput<int64_t>("repeats", {static_cast<int64_t>(repeats.size())}, repeats);
+    test.AddOutput<int32_t>("output", output_dims, output);
+    test.Run();
+  };
+
+  // general case
+  run_test({3, 40, 33}, {2, 3, 4});
+  // copies of the input buffer
+  run_test({1, 150, 100}, {5, 2, 1});
+  // batched copies of the input buffer
+  run_test({3, 1, 10000}, {2, 7, 1});
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -595,6 +595,59 @@ TEST(TransposeOpTest, DoTransposeEltWise) {
   }
 }
 
+// Transposes with an expected output computed element by element, for shapes large enough to be split into several
+// tiles and several units of work for the thread pool.
+template <typename T>
+static void TransposeLargeTest(const std::vector<int64_t>& input_shape, const std::vector<int64_t>& perm) {
+  const size_t rank = input_shape.size();
+  const int64_t size = TensorShape(input_shape).Size();
+
+  std::vector<T> input_vals(static_cast<size_t>(size));
+  for (int64_t i = 0; i < size; ++i) {
+    input_vals[i] = static_cast<T>(i % 127);
+  }
+
+  std::vector<int64_t> input_strides(rank);
+  std::vector<int64_t> expected_shape(rank);
+  for (size_t i = 0; i < rank; ++i) {
+    input_strides[i] = TensorShape(input_shape).SizeFromDimension(i + 1);
+    expected_shape[i] = input_shape[perm[i]];
+  }
+
+  std::vector<T> expected_vals(static_cast<size_t>(size));
+  for (int64_t i = 0; i < size; ++i) {
+    int64_t remaining = i;
+    int64_t input_offset = 0;
+    for (size_t axis = rank; axis-- > 0;) {
+      input_offset += (remaining % expected_shape[axis]) * input_strides[perm[axis]];
+      remaining /= expected_shape[axis];
+    }
+
+    expected_vals[i] = input_vals[input_offset];
+  }
+
+  OpTester test("Transpose");
+  test.AddAttribute("perm", perm);
+  test.AddInput<T>("X", input_shape, input_vals);
+  test.AddOutput<T>("Y", expected_shape, expected_vals);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
+TEST(TransposeOpTest, LargeTransposes) {
+  // attention reshapes, with contiguous blocks of 64 elements and of 2 elements merged into one 8 byte element
+  TransposeLargeTest<float>({2, 70, 3, 64}, {0, 2, 1, 3});
+  TransposeLargeTest<float>({2, 70, 3, 2}, {0, 2, 1, 3});
+  // NCHW <-> NHWC, with partial tiles
+  TransposeLargeTest<float>({2, 67, 9, 15}, {0, 2, 3, 1});
+  TransposeLargeTest<float>({2, 9, 15, 67}, {0, 3, 1, 2});
+  TransposeLargeTest<uint8_t>({2, 67, 9, 15}, {0, 2, 3, 1});
+  TransposeLargeTest<int16_t>({2, 67, 9, 15}, {0, 2, 3, 1});
+  TransposeLargeTest<double>({2, 9, 15, 67}, {0, 3, 1, 2});
+  // general permutations, with axes of size 1
+  TransposeLargeTest<float>({3, 1, 70, 5, 66}, {4, 2, 1, 0, 3});
+  TransposeLargeTest<int8_t>({3, 70, 1, 5, 66}, {2, 4, 0, 3, 1});
+}
+
 #if USE_CUDA
 constexpr const char* kGpuExecutionProvider = kCudaExecutionProvider;
 #elif USE_ROCM
@@ -455,15 +455,15 @@ Status MegatronTransformer::TransformGPT2MLP(Graph& graph, bool& modified,
   }
 
   NodeArg& a_weight_partition_arg = graph_utils::AddInitializer(graph, a_weight_initializer_partition);
-  graph_utils::ReplaceNodeInput(node, 1, a_weight_partition_arg);
+  graph_utils::ReplaceNodeInput(graph, node, 1, a_weight_partition_arg);
   updated_weight_names_.insert({a_weight_arg->Name(), a_weight_partition_arg.Name()});
 
   NodeArg& a_bias_partition_arg = graph_utils::AddInitializer(graph, a_bias_initializer_partition);
-  graph_utils::ReplaceNodeInput(add_node, 1, a_bias_partition_arg);
+  graph_utils::ReplaceNodeInput(graph, add_node, 1, a_bias_partition_arg);
   updated_weight_names_.insert({b_weight_arg->Name(), a_bias_partition_arg.Name()});
 
   NodeArg& b_weight_partition_arg = graph_utils::AddInitializer(graph, b_weight_initializer_partition);
-  graph_utils::ReplaceNodeInput(matmul2_node, 1, b_weight_partition_arg);
+  graph_utils::ReplaceNodeInput(graph, matmul2_node, 1, b_weight_partition_arg);
   updated_weight_names_.insert({a_bias_arg->Name(), b_weight_partition_arg.Name()});
 
   graph.RemoveInitializedTensor(a_weight_arg->Name());
@@ -481,7 +481,7 @@ Status MegatronTransformer::TransformGPT2MLP(Graph& graph, bool& modified,
   mlp_f_node.SetExecutionProviderType(node.GetExecutionProviderType());
   const Node::EdgeEnd* edge = graph_utils::GetInputEdge(node, 0);
   if (nullptr == edge) {  // handle input/initializer
-    graph_utils::ReplaceNodeInput(node, 0, *(mlp_f_node.MutableOutputDefs()[0]));
+    graph_utils::ReplaceNodeInput(graph, node, 0, *(mlp_f_node.MutableOutputDefs()[0]));
   } else {
     auto input_node = const_cast<Node*>(&edge->GetNode());
     graph_utils::ReplaceDownstreamNodeInput(graph, *input_node, edge->GetDstArgIndex(), mlp_f_node, 0);
@@ -602,15 +602,15 @@ Status MegatronTransformer::TransformBARTMLP(Graph& graph, bool& modified,
   }
 
   NodeArg& dense_wi_weight_partition_arg = graph_utils::AddInitializer(graph, dense_wi_weight_initializer_partition);
-  graph_utils::ReplaceNodeInput(*second_op, 0, dense_wi_weight_partition_arg);
+  graph_utils::ReplaceNodeInput(graph, *second_op, 0, dense_wi_weight_partition_arg);
   updated_weight_names_.insert({dense_wi_weight_arg->Name(), dense_wi_weight_partition_arg.Name()});
 
   NodeArg& dense_wi_bias_partition_arg = graph_utils::AddInitializer(graph, dense_wi_bias_initializer_partition);
-  graph_utils::ReplaceNodeInput(biasgelu_node, 1, dense_wi_bias_partition_arg);
+  graph_utils::ReplaceNodeInput(graph, biasgelu_node, 1, dense_wi_bias_partition_arg);
   updated_weight_names_.insert({dense_wi_bias_arg->Name(), dense_wi_bias_partition_arg.Name()});
 
   NodeArg& dense_wo_weight_partition_arg = graph_utils::AddInitializer(graph, dense_wo_weight_initializer_partition);
-  graph_utils::ReplaceNodeInput(*transpose_op_ptr, 0, dense_wo_weight_partition_arg);
+  graph_utils::ReplaceNodeInput(graph, *transpose_op_ptr, 0, dense_wo_weight_partition_arg);
   updated_weight_names_.insert({dense_wo_weight_arg->Name(), dense_wo_weight_partition_arg.Name()});
 
   graph.RemoveInitializedTensor(dense_wi_weight_arg->Name());
@@ -633,7 +633,7 @@ Status MegatronTransformer::TransformBARTMLP(Graph& graph, bool& modified,
   mlp_f_node.SetExecutionProviderType(node.GetExecutionProviderType());
   const Node::EdgeEnd* edge = graph_utils::GetInputEdge(node, 0);
   if (nullptr == edge) {  // handle input/initializer
-    graph_utils::ReplaceNodeInput(node, 0, *(mlp_f_node.MutableOutputDefs()[0]));
+    graph_utils::ReplaceNodeInput(graph, node, 0, *(mlp_f_node.MutableOutputDefs()[0]));
   } else {
     auto input_node = const_cast<Node*>(&edge->GetNode());
     graph_utils::ReplaceDownstreamNodeInput(graph, *input_node, edge->GetSrcArgIndex(), mlp_f_node, 0);
@@ -816,15 +816,15 @@ Status MegatronTransformer::TransformGPT2Attention(Graph& graph, bool& modified,
 
   // Replace by the partition weights.
   NodeArg& qkv_weight_partition_arg = graph_utils::AddInitializer(graph, qkv_weight_initializer_partition);
-  graph_utils::ReplaceNodeInput(node, 1, qkv_weight_partition_arg);
+  graph_utils::ReplaceNodeInput(graph, node, 1, qkv_weight_partition_arg);
   updated_weight_names_.insert({qkv_weight_arg->Name(), qkv_weight_partition_arg.Name()});
 
   NodeArg& qkv_bias_partition_arg = graph_utils::AddInitializer(graph, qkv_bias_initializer_partition);
-  graph_utils::ReplaceNodeInput(add_node, 1, qkv_bias_partition_arg);
+  graph_utils::ReplaceNodeInput(graph, add_node, 1, qkv_bias_partition_arg);
   updated_weight_names_.insert({qkv_bias_arg->Name(), qkv_bias_partition_arg.Name()});
 
   NodeArg& dense_weight_partition_arg = graph_utils::AddInitializer(graph, dense_weight_initializer_partition);
-  graph_utils::ReplaceNodeInput(matmul_node, 1, dense_weight_partition_arg);
+  graph_utils::ReplaceNodeInput(graph, matmul_node, 1, dense_weight_partition_arg);
   updated_weight_names_.insert({dense_weight_arg->Name(), dense_weight_partition_arg.Name()});
 
   graph.RemoveInitializedTensor(qkv_weight_arg->Name());
@@ -851,7 +851,7 @@ Status MegatronTransformer::TransformGPT2Attention(Graph& graph, bool& modified,
     val_partition[2] /= horizontal_parallel_size_;
     tensor_partition.set_raw_data(val_partition.data(), size * sizeof(int64_t));
     NodeArg& node_arg_partition = graph_utils::AddInitializer(graph, tensor_partition);
-    graph_utils::ReplaceNodeInput(*node_ptr, 1, node_arg_partition);
+    graph_utils::ReplaceNodeInput(graph, *node_ptr, 1, node_arg_partition);
     graph.RemoveInitializedTensor(shape_arg->Name());
   }
 
@@ -871,7 +871,7 @@ Status MegatronTransformer::TransformGPT2Attention(Graph& graph, bool& modified,
   sa_f_node.SetExecutionProviderType(node.GetExecutionProviderType());
   const Node::EdgeEnd* edge = graph_utils::GetInputEdge(node, 0);
   if (nullptr == edge) {  // handle input/initializer
-    graph_utils::ReplaceNodeInput(node, 0, *(sa_f_node.MutableOutputDefs()[0]));
+    graph_utils::ReplaceNodeInput(graph, node, 0, *(sa_f_node.MutableOutputDefs()[0]));
   } else {
     auto input_node = const_cast<Node*>(&edge->GetNode());
     graph_utils::ReplaceDownstreamNodeInput(graph, *input_node, edge->GetDstArgIndex(), sa_f_node, 0);
@@ -1132,7 +1132,7 @@ Status MegatronTransformer::TransformBARTAttention(Graph& graph, bool& modified,
   for (auto trans_ptr : weight_transpose_node_ptrs) {
     auto weight_name = trans_ptr->MutableInputDefs()[0]->Name();
     NodeArg& qkv_weight_partition_arg = graph_utils::AddInitializer(graph, qkv_weight_initializer_partitions[i]);
-    graph_utils::ReplaceNodeInput(*trans_ptr, 0, qkv_weight_partition_arg);
+    graph_utils::ReplaceNodeInput(graph, *trans_ptr, 0, qkv_weight_partition_arg);
     graph.RemoveInitializedTensor(weight_name);
     updated_weight_names_.insert({weight_name, qkv_weight_partition_arg.Name()});
     i++;
@@ -1141,14 +1141,14 @@ Status MegatronTransformer::TransformBARTAttention(Graph& graph, bool& modified,
   for (auto add_ptr : bias_add_node_ptrs) {
     auto bias_name = add_ptr->MutableInputDefs()[1]->Name();
     NodeArg& qkv_bias_partition_arg = graph_utils::AddInitializer(graph, qkv_bias_initializer_partitions[i]);
-    graph_utils::ReplaceNodeInput(*add_ptr, 1, qkv_bias_partition_arg);
+    graph_utils::ReplaceNodeInput(graph, *add_ptr, 1, qkv_bias_partition_arg);
     graph.RemoveInitializedTensor(bias_name);
     updated_weight_names_.insert({bias_name, qkv_bias_partition_arg.Name()});
     i++;
   }
 
   NodeArg& dense_weight_partition_arg = graph_utils::AddInitializer(graph, dense_weight_initializer_partition);
-  graph_utils::ReplaceNodeInput(*last_transpose, 0, dense_weight_partition_arg);
+  graph_utils::ReplaceNodeInput(graph, *last_transpose, 0, dense_weight_partition_arg);
   graph.RemoveInitializedTensor(dense_weight_arg->Name());
   updated_weight_names_.insert({dense_weight_arg->Name(), dense_weight_partition_arg.Name()});
 
@@ -1179,7 +1179,7 @@ Status MegatronTransformer::TransformBARTAttention(Graph& graph, bool& modified,
     val_partition[idx] /= horizontal_parallel_size_;
     tensor_partition.set_raw_data(val_partition.data(), size * sizeof(int64_t));
     NodeArg& node_arg_partition = graph_utils::AddInitializer(graph, tensor_partition);
-    graph_utils::ReplaceNodeInput(*node_ptr, 1, node_arg_partition);
+    graph_utils::ReplaceNodeInput(graph, *node_ptr, 1, node_arg_partition);
     graph.RemoveInitializedTensor(shape_arg->Name());
   }
 
@@ -1212,10 +1212,10 @@ Status MegatronTransformer::TransformBARTAttention(Graph& graph, bool& modified,
                                     sa_f_input_defs,
                                     {&sa_f_out_arg}, {}, kMSDomain);
     sa_f_node.SetExecutionProviderType(k_matmul_ptr->GetExecutionProviderType());
-    graph_utils::ReplaceNodeInput(*k_matmul_ptr, 0, *(sa_f_node.MutableOutputDefs()[0]));
-    graph_utils::ReplaceNodeInput(*v_matmul_ptr, 0, *(sa_f_node.MutableOutputDefs()[0]));
+    graph_utils::ReplaceNodeInput(graph, *k_matmul_ptr, 0, *(sa_f_node.MutableOutputDefs()[0]));
+    graph_utils::ReplaceNodeInput(graph, *v_matmul_ptr, 0, *(sa_f_node.MutableOutputDefs()[0]));
     if (shared_same_input) {
-      graph_utils::ReplaceNodeInput(*q_matmul_ptr, 0, *(sa_f_node.MutableOutputDefs()[0]));
+      graph_utils::ReplaceNodeInput(graph, *q_matmul_ptr, 0, *(sa_f_node.MutableOutputDefs()[0]));
     }
     new_consumer_nodes.push_back(&sa_f_node);
   }
@@ -1243,7 +1243,7 @@ Status MegatronTransformer::TransformBARTAttention(Graph& graph, bool& modified,
                                         {&q_sa_f_out_arg}, {}, kMSDomain);
       q_sa_f_node.SetExecutionProviderType(q_matmul_ptr->GetExecutionProviderType());
 
-      graph_utils::ReplaceNodeInput(*q_matmul_ptr, 0, *(q_sa_f_node.MutableOutputDefs()[0]));
+      graph_utils::ReplaceNodeInput(graph, *q_matmul_ptr, 0, *(q_sa_f_node.MutableOutputDefs()[0]));
       q_new_consumer_nodes.push_back(&q_sa_f_node);
       graph.UpdateConsumerNodes(q_prev_input_node_ptr->Name(), q_new_consumer_nodes);
       // todo: need update the consumer node for the input_node as well.